@@ -111,7 +111,11 @@ static  const  FS_CFG  App_FS_Cfg = {
     APP_CFG_FS_DIR_CNT,             /* DirCnt           */
     APP_CFG_FS_BUF_CNT,             /* BufCnt           */
     APP_CFG_FS_DEV_DRV_CNT,         /* DevDrvCnt        */
-    APP_CFG_FS_MAX_SEC_SIZE         /* MaxSecSize       */
+    APP_CFG_FS_MAX_SEC_SIZE,        /* MaxSecSize       */
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    APP_CFG_FS_ASYNC_REQ_CNT,       /* AsyncReqCnt      */
+    APP_CFG_FS_ASYNC_TASK_CNT       /* AsyncTaskCnt     */
+#endif
 };
 
 
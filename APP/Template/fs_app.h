@@ -294,6 +294,30 @@ CPU_BOOLEAN  App_FS_Init(void);
 #endif
 
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+                                                                /* Async file request count.                            */
+#ifndef  APP_CFG_FS_ASYNC_REQ_CNT
+#error  "APP_CFG_FS_ASYNC_REQ_CNT                 not #define'd in 'app_cfg.h'          "
+#error  "                                   [MUST be >= 1]                              "
+
+#elif   (APP_CFG_FS_ASYNC_REQ_CNT < 1u)
+#error  "APP_CFG_FS_ASYNC_REQ_CNT           illegally #define'd in 'app_cfg.h'          "
+#error  "                                   [MUST be >= 1]                              "
+#endif
+
+
+                                                                /* Async file request worker task count.                */
+#ifndef  APP_CFG_FS_ASYNC_TASK_CNT
+#error  "APP_CFG_FS_ASYNC_TASK_CNT                not #define'd in 'app_cfg.h'          "
+#error  "                                   [MUST be >= 1]                              "
+
+#elif   (APP_CFG_FS_ASYNC_TASK_CNT < 1u)
+#error  "APP_CFG_FS_ASYNC_TASK_CNT          illegally #define'd in 'app_cfg.h'          "
+#error  "                                   [MUST be >= 1]                              "
+#endif
+#endif
+
+
                                                                 /* ------------- IDE DRIVER CONFIGURATION ------------- */
 #ifndef  APP_CFG_FS_IDE_EN
 #error  "APP_CFG_FS_IDE_EN                        not #define'd in 'app_cfg.h'          "
@@ -56,6 +56,8 @@
 #define  APP_CFG_FS_DEV_DRV_CNT      3                          /* Maximum number of different device drivers.          */
 #define  APP_CFG_FS_WORKING_DIR_CNT  5                          /* Maximum number of active working directories.        */
 #define  APP_CFG_FS_MAX_SEC_SIZE     512                        /* Maximum sector size supported.                       */
+#define  APP_CFG_FS_ASYNC_REQ_CNT    8                          /* Maximum number of pending async file requests.       */
+#define  APP_CFG_FS_ASYNC_TASK_CNT   2                          /* Number of async file request worker tasks.           */
 
 #define  APP_CFG_FS_IDE_EN           DEF_DISABLED               /* Enable/disable the IDE\CF initialization.            */
 #define  APP_CFG_FS_MSC_EN           DEF_DISABLED               /* Enable/disable the MSC initialization.               */
@@ -101,6 +101,20 @@
 *          (13) Configure FS_CFG_BUF_ALIGN_OCTETS to set the minimum buffer alignement required in
 *               octets. This configuration will be applied to filesystem buffers only. Application
 *               buffers allocated in the application are not verified for alignment.
+*
+*          (14) Configure FS_CFG_VOL_LOCK_SHARED_EN to enable/disable shared volume locking :
+*               (a) When ENABLED,  reads from files opened without write access lock the volume shared,
+*                   so that several tasks may read files on the same volume concurrently.  Accesses
+*                   to the device itself remain serialized.  File lock functionality MUST be enabled.
+*               (b) When DISABLED, every operation locks the volume exclusively.
+*
+*          (15) Configure FS_CFG_FILE_ASYNC_EN to enable/disable asynchronous file requests :
+*               (a) When ENABLED,  file reads, writes, flushes & closes may be submitted to worker tasks
+*                   & completed through a callback or by waiting on the request.  The number of requests
+*                   & of worker tasks is configured in 'FS_CFG'.  An OS port MUST be present.  File
+*                   buffers may then be assigned in stream mode, in which full buffer halves are written
+*                   by the worker tasks (see 'FSFile_BufAssign()').
+*               (b) When DISABLED, every file operation is performed by the calling task.
 *********************************************************************************************************
 */
 
@@ -179,6 +193,18 @@
 #define  FS_CFG_BUF_ALIGN_OCTETS                 sizeof(CPU_DATA)
 
 
+                                                                /* Config shared volume locking (see Note #14) :        */
+#define  FS_CFG_VOL_LOCK_SHARED_EN               DEF_DISABLED
+                                                                /*   DEF_DISABLED   Volume always locked exclusively.   */
+                                                                /*   DEF_ENABLED    File reads lock volume shared.      */
+
+
+                                                                /* Config async file requests (see Note #15) :          */
+#define  FS_CFG_FILE_ASYNC_EN                    DEF_DISABLED
+                                                                /*   DEF_DISABLED   Files accessed by caller only.      */
+                                                                /*   DEF_ENABLED    File req's serviced by workers.     */
+
+
 /*
 *********************************************************************************************************
 *                             FILE SYSTEM NAME RESTRICTION CONFIGURATION
@@ -354,6 +380,56 @@
 *               (a) When ENABLED,  volume integrity can     be checked.  If enabled, FS_FAT_CFG_VOL_CHK_MAX_LEVELS
 *                   is the maximum number of directory levels that will be checked.
 *               (b) When DISABLED, volume integrity can NOT be checked.
+*
+*           (7) Configure FS_FAT_CFG_ENTRY_COMMIT_EN to enable/disable grouped directory entry updates :
+*               (a) When ENABLED,  the directory entries of files written without FS_FILE_ACCESS_MODE_CACHED
+*                   may be updated together, once per commit interval set with
+*                   'FS_FAT_EntryCommitIntervalSet()' or upon 'FS_FAT_EntryCommit()'.
+*               (b) When DISABLED, the directory entry of such a file is updated on each write.
+*
+*           (8) Configure FS_FAT_CFG_JOURNAL_TX_EN to enable/disable journal transactions :
+*               (a) When ENABLED,  several operations may share one journal checkpoint, either between
+*                   'FS_FAT_JournalTxBegin()' & 'FS_FAT_JournalTxCommit()' or within the window set
+*                   with 'FS_FAT_JournalTxWindowSet()'.
+*               (b) When DISABLED, the journal is checkpointed after each operation.
+*
+*           (9) Configure FS_FAT_CFG_JOURNAL_STAGE_EN to enable/disable the journal staging buffer :
+*               (a) When ENABLED,  journal logs are gathered in a sector buffer of each volume & the
+*                   journal sector is written only before a FAT or directory sector is written.
+*               (b) When DISABLED, each journal log is written through a volume buffer.
+*
+*          (10) Configure FS_FAT_CFG_JOURNAL_DEV_EN to enable/disable journal placement on another device :
+*               (a) When ENABLED,  'FS_FAT_JournalOpenDev()' may place the journal of a volume on sectors of
+*                   another device, e.g., a small NOR flash or FRAM.  FS_FAT_CFG_JOURNAL_STAGE_EN MUST be
+*                   enabled.
+*               (b) When DISABLED, the journal is always a file on the journaled volume.
+*
+*          (11) Configure FS_FAT_CFG_JOURNAL_ORDERED_EN to enable/disable ordered data mode :
+*               (a) When ENABLED,  file data written into newly exposed space reaches the device before the
+*                   journal checkpoint committing the new file size, by issuing a device write barrier
+*                   before that checkpoint.
+*               (b) When DISABLED, the journal only protects metadata; the data of a file extended before a
+*                   power loss may be lost even though the new file size is kept.
+*
+*          (12) Configure FS_FAT_CFG_VOL_DIRTY_EN to enable/disable the clean shutdown bit of FAT16 & FAT32
+*               volumes :
+*               (a) When ENABLED,  the bit in FAT entry 1 is cleared on the first write after a volume is
+*                   mounted & set again when the volume is closed or 'FS_FAT_VolSync()' is called.
+*                   'FS_FAT_VolDirtyGet()' tells whether the volume was cleanly unmounted & the free
+*                   cluster count kept in the FAT32 FSINFO sector is trusted if it was.
+*               (b) When DISABLED, the bit is never modified.
+*
+*          (13) Configure FS_FAT_CFG_SEC_CLR_BUF_SIZE with the size, in octets, of a zero-filled buffer shared
+*               by all volumes, from which large areas (e.g., the FATs & root directory while formatting)
+*               are cleared with multi-sector writes.  If 0, such areas are cleared one buffer at a time.
+*               (a) The buffer is allocated from the heap at initialization & is NEVER freed; enable it
+*                   only if formatting speed matters on devices that cannot discard sectors.
+*
+*          (14) Configure FS_FAT_CFG_FMT_ALIGN_EN to enable/disable erase block alignment when formatting :
+*               (a) When ENABLED,  the reserved area is extended so that the data area starts on a boundary
+*                   of the erase block or allocation unit reported by the device (FS_DEV_IO_CTRL_ALIGN_GET);
+*                   clusters are then aligned to erase blocks if either size is a multiple of the other.
+*               (b) When DISABLED, the reserved area size is taken from the format configuration only.
 *********************************************************************************************************
 */
                                                                 /* Configure Long File Name support   (see Note #1) :   */
@@ -395,6 +471,52 @@
                                                                 /* Configure max levels chk'd (see Note #6).            */
 #define  FS_FAT_CFG_VOL_CHK_MAX_LEVELS                    20u
 
+
+                                                                /* Configure dir entry commit support (see Note #7) :   */
+#define  FS_FAT_CFG_ENTRY_COMMIT_EN              DEF_DISABLED
+                                                                /*   DEF_DISABLED   Entry commit NOT supported.         */
+                                                                /*   DEF_ENABLED    Entry commit     supported.         */
+
+
+                                                                /* Configure journal transaction support (see Note #8) :*/
+#define  FS_FAT_CFG_JOURNAL_TX_EN                DEF_DISABLED
+                                                                /*   DEF_DISABLED   Journal tx NOT supported.           */
+                                                                /*   DEF_ENABLED    Journal tx     supported.           */
+
+
+                                                                /* Configure journal staging buf (see Note #9) :        */
+#define  FS_FAT_CFG_JOURNAL_STAGE_EN             DEF_DISABLED
+                                                                /*   DEF_DISABLED   Journal staging buf NOT used.       */
+                                                                /*   DEF_ENABLED    Journal staging buf     used.       */
+
+
+                                                                /* Configure journal dev support (see Note #10) :       */
+#define  FS_FAT_CFG_JOURNAL_DEV_EN               DEF_DISABLED
+                                                                /*   DEF_DISABLED   Journal on other dev NOT supported. */
+                                                                /*   DEF_ENABLED    Journal on other dev     supported. */
+
+
+                                                                /* Configure ordered data mode (see Note #11) :         */
+#define  FS_FAT_CFG_JOURNAL_ORDERED_EN           DEF_DISABLED
+                                                                /*   DEF_DISABLED   Ordered data mode NOT used.         */
+                                                                /*   DEF_ENABLED    Ordered data mode     used.         */
+
+
+                                                                /* Configure clean shutdown bit (see Note #12) :        */
+#define  FS_FAT_CFG_VOL_DIRTY_EN                 DEF_DISABLED
+                                                                /*   DEF_DISABLED   Clean shutdown bit NOT used.        */
+                                                                /*   DEF_ENABLED    Clean shutdown bit     used.        */
+
+
+                                                                /* Configure sec clr buf size (see Note #13).           */
+#define  FS_FAT_CFG_SEC_CLR_BUF_SIZE                       0u
+
+
+                                                                /* Configure fmt alignment (see Note #14) :             */
+#define  FS_FAT_CFG_FMT_ALIGN_EN                 DEF_DISABLED
+                                                                /*   DEF_DISABLED   Data area NOT aligned.              */
+                                                                /*   DEF_ENABLED    Data area     aligned.              */
+
 /*
 *********************************************************************************************************
 *                           FILE SYSTEM SD/MMC DEVICE DRIVER CONFIGURATION
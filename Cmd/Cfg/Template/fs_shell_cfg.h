@@ -45,11 +45,18 @@
 *               operations.
 *
 *           (2) Enable/disable the FS shell command.
+*
+*           (3) Defines the length of the buffer through which fs_cp copies files.  The buffer is allocated
+*               on the stack of the task executing the command.  A larger buffer moves more sectors per
+*               device access; if asynchronous file requests are enabled, the buffer is split in two
+*               halves so that reads & writes overlap (see 'FSEntry_CopyEx()  Note #3').
 *********************************************************************************************************
 */
 
 #define  FS_SHELL_CFG_BUF_LEN                            512u   /* Cfg buf len          (see Note #1).                  */
 
+#define  FS_SHELL_CFG_CP_BUF_LEN                        2048u   /* Cfg fs_cp buf len    (see Note #3).                  */
+
 #define  FS_SHELL_CFG_CMD_CAT_EN                 DEF_ENABLED    /* En/dis fs_cat.       (see Note #2).                  */
 #define  FS_SHELL_CFG_CMD_CD_EN                  DEF_ENABLED    /* En/dis fs_cd.        ( "   "   " ).                  */
 #define  FS_SHELL_CFG_CMD_CP_EN                  DEF_ENABLED    /* En/dis fs_cp.        ( "   "   " ).                  */
@@ -51,6 +51,7 @@
 #define  FS_SHELL_NEW_LINE                      (CPU_CHAR *)"\r\n"
 #define  FS_SHELL_EMPTY_STR                     (CPU_CHAR *)""
 #define  FS_SHELL_STR_HELP                      (CPU_CHAR *)"-h"
+#define  FS_SHELL_STR_RECURSIVE                 (CPU_CHAR *)"-r"
 #define  FS_SHELL_STR_PATH_SEP                  (CPU_CHAR *)"\\"
 #define  FS_SHELL_STR_QUOTE                     (CPU_CHAR *)"\'"
 #define  FS_SHELL_OUT_STR_LEN                               2u * FS_CFG_MAX_VOL_NAME_LEN + 50u
@@ -104,7 +105,7 @@
 #define  FS_SHELL_ARG_ERR_MV                    (CPU_CHAR *)"fs_mv: usage: fs_mv [source] [dest]\r\n              fs_mv [source] [dir]"
 #define  FS_SHELL_ARG_ERR_OD                    (CPU_CHAR *)"fs_od: usage: fs_od [file]"
 #define  FS_SHELL_ARG_ERR_PWD                   (CPU_CHAR *)"fs_pwd: usage: fs_pwd"
-#define  FS_SHELL_ARG_ERR_RM                    (CPU_CHAR *)"fs_rm: usage: fs_rm [file]"
+#define  FS_SHELL_ARG_ERR_RM                    (CPU_CHAR *)"fs_rm: usage: fs_rm [file]\r\n              fs_rm -r [entry]"
 #define  FS_SHELL_ARG_ERR_RMDIR                 (CPU_CHAR *)"fs_rmdir: usage: fs_rmdir [dir]"
 #define  FS_SHELL_ARG_ERR_TOUCH                 (CPU_CHAR *)"fs_touch: usage: fs_touch [file]"
 #define  FS_SHELL_ARG_ERR_UMOUNT                (CPU_CHAR *)"fs_umount: usage: fs_umount [vol]"
@@ -128,7 +129,7 @@
 #define  FS_SHELL_CMD_EXP_MV                    (CPU_CHAR *)"              Rename [source] to [dest] or move [source] to [dir]."
 #define  FS_SHELL_CMD_EXP_OD                    (CPU_CHAR *)"              Dump [file] to standard output in specified format."
 #define  FS_SHELL_CMD_EXP_PWD                   (CPU_CHAR *)"               Print the current working directory."
-#define  FS_SHELL_CMD_EXP_RM                    (CPU_CHAR *)"              Remove [file]."
+#define  FS_SHELL_CMD_EXP_RM                    (CPU_CHAR *)"              Remove [file], or [entry] & all entries in its tree (-r)."
 #define  FS_SHELL_CMD_EXP_RMDIR                 (CPU_CHAR *)"                 Remove [dir], if it is empty."
 #define  FS_SHELL_CMD_EXP_TOUCH                 (CPU_CHAR *)"                 Change file access and modification times."
 #define  FS_SHELL_CMD_EXP_UMOUNT                (CPU_CHAR *)"                  Unmount [vol]."
@@ -798,6 +799,9 @@ static  CPU_INT16S  FSShell_cd (CPU_INT16U        argc,
 *                       directory and the second argument must be an existing directory.  The contents of
 *                       'source_file' will be copied to a file with name formed by concatenating
 *                       'dest_dir', a path separator character and the final component of 'source_file'.
+*
+*               (3) The file is copied by 'FSEntry_CopyEx()' through a buffer of FS_SHELL_CFG_CP_BUF_LEN
+*                   octets.
 *********************************************************************************************************
 */
 
@@ -822,6 +826,7 @@ static  CPU_INT16S  FSShell_cp (CPU_INT16U        argc,
 #endif
     CPU_SIZE_T    len_dest;
     CPU_SIZE_T    len_src_name;
+    CPU_INT08U    cp_buf[FS_SHELL_CFG_CP_BUF_LEN];
 
 
                                                                 /* ------------------ CHK ARGUMENTS ------------------- */
@@ -934,10 +939,12 @@ static  CPU_INT16S  FSShell_cp (CPU_INT16U        argc,
         return (SHELL_EXEC_ERR);
     }
 
-    FSEntry_Copy( file_path_src,
-                  file_path_dest,
-                  DEF_YES,
-                 &err);
+    FSEntry_CopyEx( file_path_src,                              /* Copy file (see Note #3).                             */
+                    file_path_dest,
+                    DEF_YES,
+                    cp_buf,
+                    sizeof(cp_buf),
+                   &err);
     if (err != FS_ERR_NONE) {
         FSShell_PrintErr(FS_SHELL_ERR_CANNOT_COPY, file_path_src, out_fnct, p_cmd_param);
         return (SHELL_EXEC_ERR);
@@ -2188,11 +2195,16 @@ static  CPU_INT16S  FSShell_pwd (CPU_INT16U        argc,
 *
 * Caller(s)   : Shell, in response to command execution.
 *
-* Note(s)     : (1) (a) Usage(s)    : fs_rm [entry]
+* Note(s)     : (1) (a) Usage(s)    : fs_rm [file]
 *
-*                   (b) Argument(s) : File or directory path.
+*                                     fs_rm -r [entry]
+*
+*                   (b) Argument(s) : File path, or (with '-r') file or directory path.
 *
 *                   (c) Output      : none.
+*
+*               (2) With '-r', a directory & every entry in its tree are removed in a single pass
+*                   (see 'FSEntry_DelTree()').
 *********************************************************************************************************
 */
 
@@ -2211,6 +2223,8 @@ static  CPU_INT16S  FSShell_rm (CPU_INT16U        argc,
 #else
     CPU_CHAR     *file_path;
 #endif
+    CPU_CHAR     *entry_path;
+    CPU_BOOLEAN   recursive;
     FS_ERR        err_fs;
 
 
@@ -2223,11 +2237,21 @@ static  CPU_INT16S  FSShell_rm (CPU_INT16U        argc,
         }
     }
 
-    if (argc != 2u) {
+    recursive = DEF_NO;
+    if (argc == 3u) {
+        if (Str_Cmp_N(argv[1], FS_SHELL_STR_RECURSIVE, 3u) == 0) {
+            recursive = DEF_YES;                                /* See Note #2.                                         */
+        }
+    }
+
+    if ((argc      != 2u) &&
+        (recursive == DEF_NO)) {
         FSShell_PrintErr(FS_SHELL_ARG_ERR_RM, (CPU_CHAR *)0, out_fnct, p_cmd_param);
         return (SHELL_EXEC_ERR);
     }
 
+    entry_path = (recursive == DEF_YES) ? argv[2] : argv[1];
+
 #if (FS_CFG_WORKING_DIR_EN == DEF_DISABLED)
     if (p_cmd_param == (SHELL_CMD_PARAM *)0) {
         return (SHELL_EXEC_ERR);
@@ -2241,35 +2265,48 @@ static  CPU_INT16S  FSShell_rm (CPU_INT16U        argc,
                                                                 /* ------------------- FORM FILE PATH ----------------- */
 #if (FS_CFG_WORKING_DIR_EN == DEF_DISABLED)
     Mem_Clr(file_path, sizeof(file_path));
-    formed = FSShell_FormValidPath(p_cwd_path, argv[1], file_path);
+    formed = FSShell_FormValidPath(p_cwd_path, entry_path, file_path);
     if (formed == DEF_FALSE) {
-        FSShell_PrintErr(FS_SHELL_ERR_ILLEGAL_PATH, argv[1], out_fnct, p_cmd_param);
+        FSShell_PrintErr(FS_SHELL_ERR_ILLEGAL_PATH, entry_path, out_fnct, p_cmd_param);
         return (SHELL_EXEC_ERR);
     }
 #else
-    file_path = argv[1];
+    file_path = entry_path;
 #endif
 
                                                                 /* ---------------------- CHK PATH -------------------- */
-                                                                /* DIR       : May not be dir.                          */
+                                                                /* DIR       : May not be dir (unless '-r').            */
                                                                 /* ROOT_DIR  : May not be root dir.                     */
                                                                 /* EXIST     : Must exist.                              */
                                                                 /* READ_ONLY : May be rd-only or not.                   */
                                                                 /* DEV_EXIST : Must exist.                              */
-    attrib = FSShell_MatchAttrib(file_path,
-                                                                                  FS_SHELL_ATTRIB_EXIST | FS_SHELL_ATTRIB_READ_ONLY | FS_SHELL_ATTRIB_DEV_EXIST,
-                                 FS_SHELL_ATTRIB_DIR | FS_SHELL_ATTRIB_ROOT_DIR |                         FS_SHELL_ATTRIB_READ_ONLY,
-                                 out_fnct,
-                                 p_cmd_param);
+    if (recursive == DEF_YES) {
+        attrib = FSShell_MatchAttrib(file_path,
+                                     FS_SHELL_ATTRIB_DIR |                            FS_SHELL_ATTRIB_EXIST | FS_SHELL_ATTRIB_READ_ONLY | FS_SHELL_ATTRIB_DEV_EXIST,
+                                     FS_SHELL_ATTRIB_DIR | FS_SHELL_ATTRIB_ROOT_DIR |                         FS_SHELL_ATTRIB_READ_ONLY,
+                                     out_fnct,
+                                     p_cmd_param);
+    } else {
+        attrib = FSShell_MatchAttrib(file_path,
+                                                                                      FS_SHELL_ATTRIB_EXIST | FS_SHELL_ATTRIB_READ_ONLY | FS_SHELL_ATTRIB_DEV_EXIST,
+                                     FS_SHELL_ATTRIB_DIR | FS_SHELL_ATTRIB_ROOT_DIR |                         FS_SHELL_ATTRIB_READ_ONLY,
+                                     out_fnct,
+                                     p_cmd_param);
+    }
 
     if (attrib == 0u) {
         return (SHELL_EXEC_ERR);
     }
 
                                                                 /* -------------------- REMOVE FILE ------------------- */
-    FSEntry_Del( file_path,
-                 FS_ENTRY_TYPE_ANY,
-                &err_fs);
+    if (recursive == DEF_YES) {
+        FSEntry_DelTree( file_path,                             /* See Note #2.                                         */
+                        &err_fs);
+    } else {
+        FSEntry_Del( file_path,
+                     FS_ENTRY_TYPE_ANY,
+                    &err_fs);
+    }
 
     if (err_fs != FS_ERR_NONE) {
         FSShell_PrintErr(FS_SHELL_ERR_CANNOT_REMOVE, file_path, out_fnct, p_cmd_param);
@@ -123,6 +123,17 @@ CPU_BOOLEAN  FSShell_Init(void);
 
 
 
+#ifndef  FS_SHELL_CFG_CP_BUF_LEN
+#error  "FS_SHELL_CFG_CP_BUF_LEN               not #define'd in 'fs_shell_cfg.h'"
+#error  "                                [MUST be >=   512]                     "
+
+#elif   (FS_SHELL_CFG_CP_BUF_LEN <                512u)
+#error  "FS_SHELL_CFG_CP_BUF_LEN         illegally #define'd in 'fs_shell_cfg.h'"
+#error  "                                [MUST be >=   512]                     "
+#endif
+
+
+
 #ifndef  FS_SHELL_CFG_CMD_CAT_EN
 #error  "FS_SHELL_CFG_CMD_CAT_EN               not #define'd in 'fs_shell_cfg.h'"
 #error  "                                [MUST be DEF_DISABLED]                 "
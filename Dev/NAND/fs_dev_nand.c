@@ -2251,8 +2251,12 @@ FS_NAND_INTERN  void  FS_NAND_Query (FS_DEV       *p_dev,
 *                   (j) FS_DEV_IO_CTRL_PHY_RD_PAGE       Read  physical device page.
 *                   (k) FS_DEV_IO_CTRL_PHY_WR_PAGE       Write physical device page.
 *                   (l) FS_DEV_IO_CTRL_PHY_ERASE_BLK     Erase physical device block.
+*                   (m) FS_DEV_IO_CTRL_ALIGN_GET         Get number of sectors per block.
 *
 *                   Not all of these operations are valid for all devices.
+*
+*               (3) Logical sectors are mapped to blocks by groups of one block; writes aligned to that
+*                   size fill whole update blocks & reduce the number of block merges.
 *********************************************************************************************************
 */
 
@@ -2280,6 +2284,7 @@ FS_NAND_INTERN  void  FS_NAND_IO_Ctrl (FS_DEV      *p_dev,
         case FS_DEV_IO_CTRL_WR_SEC         :
         case FS_DEV_IO_CTRL_PHY_ERASE_BLK  :
         case FS_DEV_IO_CTRL_NAND_DUMP      :
+        case FS_DEV_IO_CTRL_ALIGN_GET      :
              if (p_data == DEF_NULL) {
                 *p_err = FS_ERR_NULL_PTR;
                  return;
@@ -2359,6 +2364,11 @@ FS_NAND_INTERN  void  FS_NAND_IO_Ctrl (FS_DEV      *p_dev,
              break;
 
 
+        case FS_DEV_IO_CTRL_ALIGN_GET:                          /* Get nbr of sec per blk (see Note #3).                */
+            *(FS_SEC_QTY *)p_data = (FS_SEC_QTY)p_nand_data->NbrSecPerBlk;
+             break;
+
+
         case FS_DEV_IO_CTRL_REFRESH:                            /* Refresh dev.                                         */
              if (p_nand_data->Fmtd == DEF_YES) {
                 *p_err = FS_ERR_NONE;
@@ -609,8 +609,21 @@ static  void  FSDev_RAM_Query (FS_DEV       *p_dev,
 *                   (k) FS_DEV_IO_CTRL_PHY_WR_PAGE       Write physical device page.   [*]
 *                   (l) FS_DEV_IO_CTRL_PHY_ERASE_BLK     Erase physical device block.  [*]
 *                   (m) FS_DEV_IO_CTRL_PHY_ERASE_CHIP    Erase physical device.        [*]
+*                   (n) FS_DEV_IO_CTRL_ADDR_GET          Get memory address of device.
+*                   (o) FS_DEV_IO_CTRL_BARRIER           Order device writes.
+*                   (p) FS_DEV_IO_CTRL_SEC_DISCARD       Discard sectors.
 *
 *                           [*] NOT SUPPORTED
+*
+*               (3) The RAM disk sectors are stored consecutively from the disk pointer passed in the
+*                   device configuration, so the disk may be accessed directly in memory (see
+*                  'FSDev_AddrGetLocked()  Note #2').
+*
+*               (4) RAM disk writes are complete when 'FSDev_RAM_Wr()' returns, so they are always
+*                   ordered.
+*
+*               (5) Discarded sectors are cleared, so that they read back as zeros (see 'fs_dev.c
+*                   FSDev_DiscardLocked()  Note #2').  The sector range was validated by the caller.
 *********************************************************************************************************
 */
 
@@ -619,13 +632,41 @@ static  void  FSDev_RAM_IO_Ctrl (FS_DEV      *p_dev,
                                  void        *p_data,
                                  FS_ERR      *p_err)
 {
-   (void)p_dev;                                                 /*lint --e{550} Suppress "Symbol not accessed".         */
-   (void)opt;
-   (void)p_data;
+    FS_DEV_RAM_DATA   *p_ram_data;
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    FS_DEV_SEC_RANGE  *p_range;
+#endif
 
 
                                                                 /* ------------------ PERFORM I/O CTL ----------------- */
-   *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+    switch (opt) {
+        case FS_DEV_IO_CTRL_ADDR_GET:                           /* ------------ GET DISK ADDR (see Note #3) ----------- */
+             p_ram_data       = (FS_DEV_RAM_DATA *)p_dev->DataPtr;
+           *(void **)p_data   =  p_ram_data->DiskPtr;
+            *p_err            =  FS_ERR_NONE;
+             break;
+
+
+        case FS_DEV_IO_CTRL_BARRIER:                            /* -------------- ORDER WRS (see Note #4) ------------- */
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+        case FS_DEV_IO_CTRL_SEC_DISCARD:                        /* ------------- DISCARD SECS (see Note #5) ----------- */
+             p_ram_data = (FS_DEV_RAM_DATA  *)p_dev->DataPtr;
+             p_range    = (FS_DEV_SEC_RANGE *)p_data;
+             Mem_Clr((void     *)((CPU_INT08U *)p_ram_data->DiskPtr + ((CPU_SIZE_T)p_range->Start * p_ram_data->SecSize)),
+                     (CPU_SIZE_T)((CPU_SIZE_T)p_range->Cnt * p_ram_data->SecSize));
+            *p_err      =  FS_ERR_NONE;
+             break;
+#endif
+
+
+        default:
+            *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+             break;
+    }
 }
 
 
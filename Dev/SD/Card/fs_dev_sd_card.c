@@ -96,6 +96,7 @@
 #define  FS_DEV_SD_CARD_RETRIES_DATA                       5u
 
 #define  FS_DEV_SD_CARD_TIMEOUT_CMD_ms                  1000u
+#define  FS_DEV_SD_CARD_TIMEOUT_ERASE_ms                 250u   /* Erase timeout, per erase unit.                       */
 
 #define  FS_DEV_SD_CARD_RCA_DFLT                      0x0001u
 
@@ -573,6 +574,13 @@ static  CPU_INT08U            FSDev_SD_Card_SetBusWidth      (FS_DEV_SD_CARD_DAT
                                                                 /* Stop transmission.                                   */
 static  CPU_BOOLEAN           FSDev_SD_Card_Stop             (FS_DEV_SD_CARD_DATA          *p_sd_card_data);
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+                                                                /* Erase blks.                                          */
+static  CPU_BOOLEAN           FSDev_SD_Card_Erase            (FS_DEV_SD_CARD_DATA          *p_sd_card_data,
+                                                              FS_SEC_NBR                    start,
+                                                              FS_SEC_QTY                    cnt);
+#endif
+
                                                                 /* Sel card.                                            */
 static  CPU_BOOLEAN           FSDev_SD_Card_Sel              (FS_DEV_SD_CARD_DATA          *p_sd_card_data,
                                                               CPU_BOOLEAN                   sel);
@@ -1409,12 +1417,21 @@ static  void  FSDev_SD_Card_Query (FS_DEV       *p_dev,
 *                   (n) FS_DEV_IO_CTRL_SD_QUERY          Get info about SD/MMC card.
 *                   (o) FS_DEV_IO_CTRL_SD_RD_CID         Read SD/MMC card Card ID register.
 *                   (p) FS_DEV_IO_CTRL_SD_RD_CSD         Read SD/MMC card Card-Specific Data register.
+*                   (q) FS_DEV_IO_CTRL_ALIGN_GET         Get allocation unit size, or erase unit size
+*                                                        if unknown (see 'fs_dev_sd.c
+*                                                        FSDev_SD_ParseSDStatus()  Note #2').
+*                   (r) FS_DEV_IO_CTRL_SEC_DISCARD       Discard sectors (see Note #4).
 *
 *                           [*] NOT SUPPORTED
 *
 *               (3) Card selection does NOT need to occur prior to reading the CID or CSD registers;
 *                   indeed, the card must NOT be selected (e.g., it must be in the 'stby' state).  See
 *                   also 'FSDev_SD_Card_SendCID()  Note #3a' & 'FSDev_SD_Card_SendCSD()  Note #3'.
+*
+*               (4) Sectors are discarded by erasing the blocks.  Discarded sectors MUST read back as
+*                   zeros, so the operation is supported ONLY by SD cards whose SCR reports that erased
+*                   blocks read as zeros (see 'fs_dev_sd.c  FSDev_SD_ParseSCR()  Note #2'); otherwise,
+*                   FS_ERR_DEV_INVALID_IO_CTRL is returned & the caller clears the sectors itself.
 *********************************************************************************************************
 */
 
@@ -1426,6 +1443,9 @@ static  void  FSDev_SD_Card_IO_Ctrl (FS_DEV      *p_dev,
     FS_DEV_SD_INFO       *p_sd_info;
     FS_DEV_SD_INFO       *p_sd_info_ctrl;
     FS_DEV_SD_CARD_DATA  *p_sd_card_data;
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    FS_DEV_SEC_RANGE     *p_range;
+#endif
     CPU_BOOLEAN           ok;
     CPU_BOOLEAN           chngd;
     CPU_BOOLEAN          *p_chngd;
@@ -1459,6 +1479,9 @@ static  void  FSDev_SD_Card_IO_Ctrl (FS_DEV      *p_dev,
 
              p_sd_info_ctrl->BlkSize      = p_sd_info->BlkSize;
              p_sd_info_ctrl->NbrBlks      = p_sd_info->NbrBlks;
+             p_sd_info_ctrl->EraseSize    = p_sd_info->EraseSize;
+             p_sd_info_ctrl->EraseZero    = p_sd_info->EraseZero;
+             p_sd_info_ctrl->AU_Size      = p_sd_info->AU_Size;
              p_sd_info_ctrl->ClkFreq      = p_sd_info->ClkFreq;
              p_sd_info_ctrl->Timeout      = p_sd_info->Timeout;
              p_sd_info_ctrl->CardType     = p_sd_info->CardType;
@@ -1473,6 +1496,27 @@ static  void  FSDev_SD_Card_IO_Ctrl (FS_DEV      *p_dev,
              break;
 
 
+        case FS_DEV_IO_CTRL_ALIGN_GET:                          /* ---------------- GET ERASE UNIT SIZE --------------- */
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
+             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
+                *p_err = FS_ERR_NULL_PTR;
+                 return;
+             }
+#endif
+                                                                /* Validate dev init.                                   */
+             p_sd_card_data  = (FS_DEV_SD_CARD_DATA *)p_dev->DataPtr;
+             if (p_sd_card_data->Init == DEF_NO) {
+                 *p_err = FS_ERR_DEV_NOT_PRESENT;
+                  return;
+             }
+
+             p_sd_info = &p_sd_card_data->Info;                 /* AU size, else erase unit size.                       */
+            *(FS_SEC_QTY *)p_data = (p_sd_info->AU_Size > 0u) ? (FS_SEC_QTY)p_sd_info->AU_Size
+                                                              : (FS_SEC_QTY)p_sd_info->EraseSize;
+            *p_err = FS_ERR_NONE;
+             break;
+
+
         case FS_DEV_IO_CTRL_SD_RD_CID:                          /* --------------- READ CARD ID REGISTER -------------- */
 #if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
              if (p_data == (void *)0) {                                 /* Validate data ptr.                           */
@@ -1530,6 +1574,47 @@ static  void  FSDev_SD_Card_IO_Ctrl (FS_DEV      *p_dev,
              break;
 
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+        case FS_DEV_IO_CTRL_SEC_DISCARD:                        /* ------------- DISCARD SECS (see Note #4) ----------- */
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
+             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
+                *p_err = FS_ERR_NULL_PTR;
+                 return;
+             }
+#endif
+                                                                /* Validate dev init.                                   */
+             p_sd_card_data  = (FS_DEV_SD_CARD_DATA *)p_dev->DataPtr;
+             if (p_sd_card_data->Init == DEF_NO) {
+                 *p_err = FS_ERR_DEV_NOT_PRESENT;
+                  return;
+             }
+                                                                /* Chk erased blks rd as zeros.                         */
+             if (p_sd_card_data->Info.EraseZero == DEF_NO) {
+                *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+                 return;
+             }
+
+             p_range = (FS_DEV_SEC_RANGE *)p_data;
+             FSDev_SD_Card_BSP_Lock(p_sd_card_data->UnitNbr);           /* Acquire bus lock.                            */
+             ok = FSDev_SD_Card_Sel(p_sd_card_data, DEF_YES);
+             if (ok == DEF_OK) {
+                 ok = FSDev_SD_Card_Erase(p_sd_card_data,               /* Erase blks.                                  */
+                                          p_range->Start,
+                                          p_range->Cnt);
+             }
+             FSDev_SD_Card_BSP_Unlock(p_sd_card_data->UnitNbr);         /* Release bus lock.                            */
+
+             if (ok != DEF_OK) {
+                 FS_DEV_SD_CARD_ERR_WR_CTR_INC(p_sd_card_data);
+                *p_err = FS_ERR_DEV_IO;
+                 return;
+             }
+
+            *p_err = FS_ERR_NONE;
+             break;
+#endif
+
+
                                                                 /* --------------- UNSUPPORTED I/O CTRL --------------- */
         case FS_DEV_IO_CTRL_LOW_FMT:
         case FS_DEV_IO_CTRL_LOW_UNMOUNT:
@@ -1652,6 +1737,8 @@ static  CPU_BOOLEAN  FSDev_SD_Card_Refresh (FS_DEV_SD_CARD_DATA  *p_sd_card_data
     CPU_INT32U       rca;
     CPU_INT08U       csd[FS_DEV_SD_CSD_REG_LEN];
     CPU_INT08U       cid[FS_DEV_SD_CID_REG_LEN];
+    CPU_INT08U       scr[FS_DEV_SD_CID_SCR_LEN];
+    CPU_INT08U       sd_status[FS_DEV_SD_SD_STATUS_LEN];
     CPU_INT32U       resp1;
     CPU_INT32U       resp6;
     CPU_INT08U       width;
@@ -1873,6 +1960,28 @@ static  CPU_BOOLEAN  FSDev_SD_Card_Refresh (FS_DEV_SD_CARD_DATA  *p_sd_card_data
     p_sd_card_data->BusWidth = width;
 
 
+
+                                                                /* ------------ RD SCR REG & SD STATUS (SD) ----------- */
+    if ((card_type == FS_DEV_SD_CARDTYPE_SD_V1_X) ||
+        (card_type == FS_DEV_SD_CARDTYPE_SD_V2_0) ||
+        (card_type == FS_DEV_SD_CARDTYPE_SD_V2_0_HC)) {
+        ok = FSDev_SD_Card_SendSCR(p_sd_card_data, &scr[0]);
+        if (ok == DEF_OK) {
+            ok = FSDev_SD_ParseSCR(scr, p_sd_info);             /* Parse SCR info.                                      */
+        }
+        if (ok != DEF_OK) {                                     /* SCR is optional info; erase is then NOT used.        */
+            FS_TRACE_DBG(("FSDev_SD_Card_Refresh(): Failed to read SCR.\r\n"));
+        }
+
+        ok = FSDev_SD_Card_SendSDStatus(p_sd_card_data, &sd_status[0]);
+        if (ok == DEF_OK) {
+            FSDev_SD_ParseSDStatus(sd_status, p_sd_info);       /* Parse SD status info.                                */
+        } else {                                                /* AU size is optional info; erase size is then used.   */
+            FS_TRACE_DBG(("FSDev_SD_Card_Refresh(): Failed to read SD status.\r\n"));
+        }
+    }
+
+
                                                                 /* --------------- READ EXT_CSD (MMC-HC) -------------- */
     if(card_type == FS_DEV_SD_CARDTYPE_MMC_HC) {
         p_buf = FSBuf_Get(DEF_NULL);
@@ -2657,7 +2766,7 @@ static  CPU_BOOLEAN  FSDev_SD_Card_SendSCR (FS_DEV_SD_CARD_DATA  *p_sd_card_data
         return (DEF_FAIL);
     }
 
-    ok = FSDev_SD_Card_RdData( p_sd_card_data,                  /* Perform ACMD13 & rd data.                            */
+    ok = FSDev_SD_Card_RdData( p_sd_card_data,                  /* Perform ACMD51 & rd data.                            */
                               (FS_DEV_SD_ACMD_SEND_SCR + 64u),
                                0u,
                                p_dest,
@@ -2714,11 +2823,11 @@ static  CPU_BOOLEAN  FSDev_SD_Card_SendSDStatus (FS_DEV_SD_CARD_DATA  *p_sd_card
         return (DEF_FAIL);
     }
 
-    ok = FSDev_SD_Card_RdData( p_sd_card_data,                  /* Perform ACMD51 & rd data.                            */
+    ok = FSDev_SD_Card_RdData( p_sd_card_data,                  /* Perform ACMD13 & rd data.                            */
                               (FS_DEV_SD_ACMD_SD_STATUS + 64u),
                                0u,
                                p_dest,
-                               64u,
+                               FS_DEV_SD_SD_STATUS_LEN,
                                1u);
     return (ok);
 }
@@ -2935,6 +3044,114 @@ static  CPU_BOOLEAN  FSDev_SD_Card_Stop (FS_DEV_SD_CARD_DATA  *p_sd_card_data)
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FSDev_SD_Card_Erase()
+*
+* Description : Erase blocks.
+*
+* Argument(s) : p_sd_card_data  Pointer to SD card data.
+*
+*               start           First block to erase.
+*
+*               cnt             Number of blocks to erase.
+*
+* Return(s)   : DEF_OK,   if blocks were erased.
+*               DEF_FAIL, otherwise.
+*
+* Note(s)     : (1) The card MUST have been already selected.
+*
+*               (2) The erase sequence is defined in [Ref 1], Section 4.3.5 :  CMD32 & CMD33 set the
+*                   address of the first & last write blocks to erase & CMD38 erases them.  As for
+*                   reads & writes, standard-capacity cards receive byte addresses & high-capacity
+*                   cards receive block numbers.
+*
+*               (3) The card remains in the 'prg' state until the erase completes.  The timeout is
+*                   derived from the number of erase units in the range, allowing
+*                   FS_DEV_SD_CARD_TIMEOUT_ERASE_ms per erase unit ([Ref 1], Section 4.14).
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  CPU_BOOLEAN  FSDev_SD_Card_Erase (FS_DEV_SD_CARD_DATA  *p_sd_card_data,
+                                          FS_SEC_NBR            start,
+                                          FS_SEC_QTY            cnt)
+{
+    CPU_INT32U       start_addr;
+    CPU_INT32U       end_addr;
+    CPU_INT32U       resp1;
+    CPU_INT32U       erase_units;
+    CPU_INT32U       retries;
+    CPU_BOOLEAN      ok;
+    FS_DEV_SD_INFO  *p_sd_info;
+
+
+    if (cnt == 0u) {
+        return (DEF_OK);
+    }
+
+    p_sd_info  = &p_sd_card_data->Info;
+                                                                /* See Note #2.                                         */
+    start_addr = (p_sd_info->HighCapacity == DEF_YES) ?  start              : ( start              * FS_DEV_SD_BLK_SIZE);
+    end_addr   = (p_sd_info->HighCapacity == DEF_YES) ? (start + cnt - 1u) : ((start + cnt - 1u) * FS_DEV_SD_BLK_SIZE);
+
+    ok = FSDev_SD_Card_WaitWhileBusy(p_sd_card_data);
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+
+                                                                /* ------------------ SET ERASE RANGE ----------------- */
+    ok = FSDev_SD_Card_CmdRShort( p_sd_card_data,               /* Perform CMD32 (R1 resp).                             */
+                                  FS_DEV_SD_CMD_ERASE_WR_BLK_START,
+                                  start_addr,
+                                 &resp1);
+    if ((ok != DEF_OK) || ((resp1 & FS_DEV_SD_CARD_R1_ERR_ANY) != 0u)) {
+        FS_TRACE_DBG(("FSDev_SD_Card_Erase(): Failed to set erase start: resp = 0x%08X.\r\n", resp1));
+        return (DEF_FAIL);
+    }
+
+    ok = FSDev_SD_Card_CmdRShort( p_sd_card_data,               /* Perform CMD33 (R1 resp).                             */
+                                  FS_DEV_SD_CMD_ERASE_WR_BLK_END,
+                                  end_addr,
+                                 &resp1);
+    if ((ok != DEF_OK) || ((resp1 & FS_DEV_SD_CARD_R1_ERR_ANY) != 0u)) {
+        FS_TRACE_DBG(("FSDev_SD_Card_Erase(): Failed to set erase end: resp = 0x%08X.\r\n", resp1));
+        return (DEF_FAIL);
+    }
+
+                                                                /* --------------------- ERASE BLKS ------------------- */
+    ok = FSDev_SD_Card_CmdRShort( p_sd_card_data,               /* Perform CMD38 (R1b resp).                            */
+                                  FS_DEV_SD_CMD_ERASE,
+                                  0u,
+                                 &resp1);
+    if ((ok != DEF_OK) ||
+        ((resp1 & (FS_DEV_SD_CARD_R1_ERR_ANY | FS_DEV_SD_CARD_R1_WP_ERASE_SKIP | FS_DEV_SD_CARD_R1_ERASE_RESET)) != 0u)) {
+        FS_TRACE_DBG(("FSDev_SD_Card_Erase(): Failed to erase: resp = 0x%08X.\r\n", resp1));
+        return (DEF_FAIL);
+    }
+
+                                                                /* ----------- WAIT UNTIL ERASE IS COMPLETE ----------- */
+                                                                /* Calc timeout (see Note #3).                          */
+    erase_units = (p_sd_info->EraseSize > 0u) ? (((cnt - 1u) / p_sd_info->EraseSize) + 2u) : 1u;
+    retries     = (erase_units * FS_DEV_SD_CARD_TIMEOUT_ERASE_ms) / 2u;
+
+    ok = FSDev_SD_Card_WaitWhileBusy(p_sd_card_data);
+    while ((ok != DEF_OK) && (retries > 0u)) {
+        FS_OS_Dly_ms(2u);
+        ok = FSDev_SD_Card_WaitWhileBusy(p_sd_card_data);
+        retries--;
+    }
+
+    if (ok != DEF_OK) {
+        FS_TRACE_DBG(("FSDev_SD_Card_Erase(): Card did not become rdy after erase.\r\n"));
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FSDev_SD_Card_Sel()
@@ -410,6 +410,11 @@ static  CPU_BOOLEAN          FSDev_SD_SPI_WrDataMulti      (FS_DEV_SD_SPI_DATA
                                                             CPU_INT08U                   *p_src,
                                                             CPU_INT32U                    size,
                                                             CPU_INT32U                    cnt);
+
+                                                                /* Erase blks.                                          */
+static  CPU_BOOLEAN          FSDev_SD_SPI_Erase            (FS_DEV_SD_SPI_DATA           *p_sd_spi_data,
+                                                            FS_SEC_NBR                    start,
+                                                            FS_SEC_QTY                    cnt);
 #endif
 
 
@@ -420,6 +425,14 @@ static  CPU_BOOLEAN          FSDev_SD_SPI_SendCID          (FS_DEV_SD_SPI_DATA
 
                                                                 /* Get CSD reg.                                         */
 static  CPU_BOOLEAN          FSDev_SD_SPI_SendCSD          (FS_DEV_SD_SPI_DATA           *p_sd_spi_data,
+                                                            CPU_INT08U                   *p_dest);
+
+                                                                /* Get SCR reg.                                         */
+static  CPU_BOOLEAN          FSDev_SD_SPI_SendSCR          (FS_DEV_SD_SPI_DATA           *p_sd_spi_data,
+                                                            CPU_INT08U                   *p_dest);
+
+                                                                /* Get SD status.                                       */
+static  CPU_BOOLEAN          FSDev_SD_SPI_SendSDStatus     (FS_DEV_SD_SPI_DATA           *p_sd_spi_data,
                                                             CPU_INT08U                   *p_dest);
 
 
@@ -1146,8 +1159,17 @@ static  void  FSDev_SD_SPI_Query (FS_DEV       *p_dev,
 *                   (n) FS_DEV_IO_CTRL_SD_QUERY          Get info about SD/MMC card.
 *                   (o) FS_DEV_IO_CTRL_SD_RD_CID         Read SD/MMC card Card ID register.
 *                   (p) FS_DEV_IO_CTRL_SD_RD_CSD         Read SD/MMC card Card-Specific Data register.
+*                   (q) FS_DEV_IO_CTRL_ALIGN_GET         Get allocation unit size, or erase unit size
+*                                                        if unknown (see 'fs_dev_sd.c
+*                                                        FSDev_SD_ParseSDStatus()  Note #2').
+*                   (r) FS_DEV_IO_CTRL_SEC_DISCARD       Discard sectors (see Note #3).
 *
 *                           [*] NOT SUPPORTED
+*
+*               (3) Sectors are discarded by erasing the blocks.  Discarded sectors MUST read back as
+*                   zeros, so the operation is supported ONLY by SD cards whose SCR reports that erased
+*                   blocks read as zeros (see 'fs_dev_sd.c  FSDev_SD_ParseSCR()  Note #2'); otherwise,
+*                   FS_ERR_DEV_INVALID_IO_CTRL is returned & the caller clears the sectors itself.
 *********************************************************************************************************
 */
 
@@ -1159,6 +1181,9 @@ static  void  FSDev_SD_SPI_IO_Ctrl (FS_DEV      *p_dev,
     FS_DEV_SD_INFO      *p_sd_info;
     FS_DEV_SD_INFO      *p_sd_info_ctrl;
     FS_DEV_SD_SPI_DATA  *p_sd_spi_data;
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    FS_DEV_SEC_RANGE    *p_range;
+#endif
     CPU_BOOLEAN          ok;
     CPU_BOOLEAN          chngd;
     CPU_BOOLEAN         *p_chngd;
@@ -1190,6 +1215,9 @@ static  void  FSDev_SD_SPI_IO_Ctrl (FS_DEV      *p_dev,
 
              p_sd_info_ctrl->BlkSize      = p_sd_info->BlkSize;
              p_sd_info_ctrl->NbrBlks      = p_sd_info->NbrBlks;
+             p_sd_info_ctrl->EraseSize    = p_sd_info->EraseSize;
+             p_sd_info_ctrl->EraseZero    = p_sd_info->EraseZero;
+             p_sd_info_ctrl->AU_Size      = p_sd_info->AU_Size;
              p_sd_info_ctrl->ClkFreq      = p_sd_info->ClkFreq;
              p_sd_info_ctrl->Timeout      = p_sd_info->Timeout;
              p_sd_info_ctrl->CardType     = p_sd_info->CardType;
@@ -1204,6 +1232,25 @@ static  void  FSDev_SD_SPI_IO_Ctrl (FS_DEV      *p_dev,
              break;
 
 
+        case FS_DEV_IO_CTRL_ALIGN_GET:                          /* ---------------- GET ERASE UNIT SIZE --------------- */
+             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
+                *p_err = FS_ERR_NULL_PTR;
+                 return;
+             }
+                                                                /* Validate dev init.                                   */
+             p_sd_spi_data  = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
+             if (p_sd_spi_data->Init == DEF_NO) {
+                 *p_err = FS_ERR_DEV_NOT_PRESENT;
+                  return;
+             }
+
+             p_sd_info = &p_sd_spi_data->Info;                  /* AU size, else erase unit size.                       */
+            *(FS_SEC_QTY *)p_data = (p_sd_info->AU_Size > 0u) ? (FS_SEC_QTY)p_sd_info->AU_Size
+                                                              : (FS_SEC_QTY)p_sd_info->EraseSize;
+            *p_err = FS_ERR_NONE;
+             break;
+
+
         case FS_DEV_IO_CTRL_SD_RD_CID:                          /* --------------- READ CARD ID REGISTER -------------- */
              if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
                 *p_err = FS_ERR_NULL_PTR;
@@ -1258,6 +1305,42 @@ static  void  FSDev_SD_SPI_IO_Ctrl (FS_DEV      *p_dev,
              break;
 
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+        case FS_DEV_IO_CTRL_SEC_DISCARD:                        /* ------------- DISCARD SECS (see Note #3) ----------- */
+             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
+                *p_err = FS_ERR_NULL_PTR;
+                 return;
+             }
+                                                                /* Validate dev init.                                   */
+             p_sd_spi_data  = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
+             if (p_sd_spi_data->Init == DEF_NO) {
+                 *p_err = FS_ERR_DEV_NOT_PRESENT;
+                  return;
+             }
+                                                                /* Chk erased blks rd as zeros.                         */
+             if (p_sd_spi_data->Info.EraseZero == DEF_NO) {
+                *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+                 return;
+             }
+                                                                /* Erase blks.                                          */
+             p_range = (FS_DEV_SEC_RANGE *)p_data;
+             FSDev_SD_SPI_BSP_SPI.Lock(p_sd_spi_data->UnitNbr);
+             ok = FSDev_SD_SPI_Erase(p_sd_spi_data,
+                                     p_range->Start,
+                                     p_range->Cnt);
+             FSDev_SD_SPI_BSP_SPI.Unlock(p_sd_spi_data->UnitNbr);
+
+             if (ok != DEF_OK) {
+                 FS_DEV_SD_SPI_ERR_WR_CTR_INC(p_sd_spi_data);
+                *p_err = FS_ERR_DEV_IO;
+                 return;
+             }
+
+            *p_err = FS_ERR_NONE;
+             break;
+#endif
+
+
         case FS_DEV_IO_CTRL_LOW_FMT:                            /* --------------- UNSUPPORTED I/O CTRL --------------- */
         case FS_DEV_IO_CTRL_LOW_UNMOUNT:
         case FS_DEV_IO_CTRL_LOW_MOUNT:
@@ -1360,6 +1443,7 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_Refresh (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
     CPU_INT08U       card_type;
     CPU_INT08U       resp_r1;
     CPU_INT08U       resp_reg[16];
+    CPU_INT08U       sd_status[FS_DEV_SD_SD_STATUS_LEN];
     CPU_INT08U       retries;
     CPU_BOOLEAN      ok;
     CPU_BOOLEAN      init_prev;
@@ -1520,6 +1604,30 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_Refresh (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
 
 
 
+                                                                /* ------------ RD SCR REG & SD STATUS (SD) ----------- */
+    if ((card_type == FS_DEV_SD_CARDTYPE_SD_V1_X) ||
+        (card_type == FS_DEV_SD_CARDTYPE_SD_V2_0) ||
+        (card_type == FS_DEV_SD_CARDTYPE_SD_V2_0_HC)) {
+        ok = FSDev_SD_SPI_SendSCR( p_sd_spi_data,
+                                  &resp_reg[0]);
+        if (ok == DEF_OK) {
+            ok = FSDev_SD_ParseSCR(resp_reg, p_sd_info);        /* Parse SCR info.                                      */
+        }
+        if (ok != DEF_OK) {                                     /* SCR is optional info; erase is then NOT used.        */
+            FS_TRACE_DBG(("FSDev_SD_SPI_Refresh(): Failed to read SCR.\r\n"));
+        }
+
+        ok = FSDev_SD_SPI_SendSDStatus( p_sd_spi_data,
+                                       &sd_status[0]);
+        if (ok == DEF_OK) {
+            FSDev_SD_ParseSDStatus(sd_status, p_sd_info);       /* Parse SD status info.                                */
+        } else {                                                /* AU size is optional info; erase size is then used.   */
+            FS_TRACE_DBG(("FSDev_SD_SPI_Refresh(): Failed to read SD status.\r\n"));
+        }
+    }
+
+
+
 
 #if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)                   /* -------------- ENABLE CRC VERIFICATION ------------- */
     resp_r1 = FSDev_SD_SPI_CmdR1(p_sd_spi_data,
@@ -2282,6 +2390,120 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_dat
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                        FSDev_SD_SPI_Erase()
+*
+* Description : Erase blocks.
+*
+* Argument(s) : p_sd_spi_data   Pointer to SD SPI data.
+*
+*               start           First block to erase.
+*
+*               cnt             Number of blocks to erase.
+*
+* Return(s)   : DEF_OK,   if blocks were erased.
+*               DEF_FAIL, otherwise.
+*
+* Note(s)     : (1) The erase sequence is defined in [Ref 1], Section 4.3.5 :  CMD32 & CMD33 set the
+*                   address of the first & last write blocks to erase & CMD38 erases them.  As for
+*                   reads & writes, standard-capacity cards receive byte addresses & high-capacity
+*                   cards receive block numbers.
+*
+*               (2) The card holds the busy token until the erase completes.  One busy wait is allowed
+*                   per erase unit in the range ([Ref 1], Section 4.14).
+*
+*               (3) The erase status bits are returned in the second byte of the R2 response to CMD13
+*                   ([Ref 1], Section 7.3.2.3).
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  CPU_BOOLEAN  FSDev_SD_SPI_Erase (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
+                                         FS_SEC_NBR           start,
+                                         FS_SEC_QTY           cnt)
+{
+    CPU_INT32U       start_addr;
+    CPU_INT32U       end_addr;
+    CPU_INT32U       erase_units;
+    CPU_INT08U       resp_r1;
+    CPU_INT08U       resp_r2;
+    CPU_INT08U       resp;
+    FS_DEV_SD_INFO  *p_sd_info;
+
+
+    if (cnt == 0u) {
+        return (DEF_OK);
+    }
+
+    p_sd_info  = &p_sd_spi_data->Info;
+                                                                /* See Note #1.                                         */
+    start_addr = (p_sd_info->HighCapacity == DEF_YES) ?  start              : ( start              * FS_DEV_SD_BLK_SIZE);
+    end_addr   = (p_sd_info->HighCapacity == DEF_YES) ? (start + cnt - 1u) : ((start + cnt - 1u) * FS_DEV_SD_BLK_SIZE);
+
+                                                                /* ------------------ SET ERASE RANGE ----------------- */
+    resp_r1 = FSDev_SD_SPI_CmdR1(p_sd_spi_data,                 /* Perform CMD32.                                       */
+                                 FS_DEV_SD_CMD_ERASE_WR_BLK_START,
+                                 start_addr);
+    if (resp_r1 != FS_DEV_SD_SPI_R1_NONE) {
+        FS_TRACE_DBG(("FSDev_SD_SPI_Erase(): Failed to set erase start: error: %02X.\r\n", resp_r1));
+        return (DEF_FAIL);
+    }
+
+    resp_r1 = FSDev_SD_SPI_CmdR1(p_sd_spi_data,                 /* Perform CMD33.                                       */
+                                 FS_DEV_SD_CMD_ERASE_WR_BLK_END,
+                                 end_addr);
+    if (resp_r1 != FS_DEV_SD_SPI_R1_NONE) {
+        FS_TRACE_DBG(("FSDev_SD_SPI_Erase(): Failed to set erase end: error: %02X.\r\n", resp_r1));
+        return (DEF_FAIL);
+    }
+
+                                                                /* --------------------- ERASE BLKS ------------------- */
+    FS_DEV_SD_SPI_ENTER(p_sd_spi_data->UnitNbr);                /* 'Enter' SPI access.                                  */
+
+    resp_r1 = FSDev_SD_SPI_Cmd(p_sd_spi_data,                   /* Perform CMD38.                                       */
+                               FS_DEV_SD_CMD_ERASE,
+                               0u);
+    if (resp_r1 != FS_DEV_SD_SPI_R1_NONE) {
+        FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);             /* 'Exit' SPI access.                                   */
+        FS_TRACE_DBG(("FSDev_SD_SPI_Erase(): Failed to erase: error: %02X.\r\n", resp_r1));
+        return (DEF_FAIL);
+    }
+                                                                /* Wait while busy token rx'd (see Note #2).            */
+    erase_units = (p_sd_info->EraseSize > 0u) ? (((cnt - 1u) / p_sd_info->EraseSize) + 2u) : 1u;
+    resp        =  FSDev_SD_SPI_WaitWhileBusy(p_sd_spi_data->UnitNbr);
+    while ((resp != FS_DEV_SD_SPI_RESP_EMPTY) && (erase_units > 1u)) {
+        resp = FSDev_SD_SPI_WaitWhileBusy(p_sd_spi_data->UnitNbr);
+        erase_units--;
+    }
+
+    FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);                 /* 'Exit' SPI access.                                   */
+
+    if (resp != FS_DEV_SD_SPI_RESP_EMPTY) {
+        FS_TRACE_DBG(("FSDev_SD_SPI_Erase(): Failed to erase: card busy timed out.\r\n"));
+        return (DEF_FAIL);
+    }
+
+                                                                /* -------------- CHK STATUS (see Note #3) ------------ */
+    FS_DEV_SD_SPI_ENTER(p_sd_spi_data->UnitNbr);                /* 'Enter' SPI access.                                  */
+    resp_r1 = FSDev_SD_SPI_Cmd(p_sd_spi_data,                   /* Perform CMD13.                                       */
+                               FS_DEV_SD_CMD_SEND_STATUS,
+                               0u);
+    resp_r2 = FSDev_SD_SPI_RdByte(p_sd_spi_data->UnitNbr);
+    FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);                 /* 'Exit' SPI access.                                   */
+
+    if ((resp_r1 != FS_DEV_SD_SPI_R1_NONE) ||
+        ((resp_r2 & (FS_DEV_SD_SPI_R2_WP_ERASE_SKIP | FS_DEV_SD_SPI_R2_ERROR    | FS_DEV_SD_SPI_R2_CC_ERROR |
+                     FS_DEV_SD_SPI_R2_ERASE_PARAM   | FS_DEV_SD_SPI_R2_OUT_OF_RANGE)) != 0u)) {
+        FS_TRACE_DBG(("FSDev_SD_SPI_Erase(): Failed to erase: status: %02X %02X.\r\n", resp_r1, resp_r2));
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                       FSDev_SD_SPI_SendCID()
@@ -2356,6 +2578,142 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_SendCSD (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FSDev_SD_SPI_SendSCR()
+*
+* Description : Get SD CARD Configuration Register (SCR) from card.
+*
+* Argument(s) : p_sd_spi_data   Pointer to SD SPI data.
+*
+*               p_dest          Pointer to 8-byte buffer that will receive SD CARD Configuration Register.
+*
+* Return(s)   : DEF_OK   if the data was read.
+*               DEF_FAIL otherwise.
+*
+* Note(s)     : (1) The SCR register is present ONLY on SD cards.  The register is defined in [Ref 1],
+*                   Section 5.6.
+*
+*               (2) In SPI mode, ACMD51 returns a R1 response followed by a data block, like CMD9.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FSDev_SD_SPI_SendSCR (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
+                                           CPU_INT08U          *p_dest)
+{
+    CPU_INT08U   resp_r1;
+    CPU_BOOLEAN  ok;
+
+
+    resp_r1 = FSDev_SD_SPI_CmdR1(p_sd_spi_data,                 /* Next cmd is app cmd.                                 */
+                                 FS_DEV_SD_CMD_APP_CMD,
+                                 0u);
+    if (resp_r1 != FS_DEV_SD_SPI_R1_NONE) {
+        return (DEF_FAIL);
+    }
+
+    ok = FSDev_SD_SPI_RdData(p_sd_spi_data,                     /* Perform ACMD51 & rd data (see Note #2).              */
+                             FS_DEV_SD_ACMD_SEND_SCR,
+                             0u,
+                             p_dest,
+                             FS_DEV_SD_CID_SCR_LEN);
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FSDev_SD_SPI_SendSDStatus()
+*
+* Description : Get SD status from card.
+*
+* Argument(s) : p_sd_spi_data   Pointer to SD SPI data.
+*
+*               p_dest          Pointer to 64-byte buffer that will receive the SD status.
+*
+* Return(s)   : DEF_OK   if the data was read.
+*               DEF_FAIL otherwise.
+*
+* Note(s)     : (1) The SD status is present ONLY on SD cards.  The information format is defined in
+*                   [Ref 1], Section 4.10.2.
+*
+*               (2) In SPI mode, ACMD13 returns a R2 response (a R1 response followed by a second status
+*                   byte) before the data block ([Ref 1], Section 7.3.1.3).
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FSDev_SD_SPI_SendSDStatus (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
+                                                CPU_INT08U          *p_dest)
+{
+    CPU_INT08U  crc_buf[2];
+#if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
+    CPU_INT16U  crc;
+    CPU_INT16U  crc_chk;
+#endif
+    CPU_INT08U  resp_r1;
+    CPU_INT08U  resp_r2;
+    CPU_INT08U  token;
+
+
+    resp_r1 = FSDev_SD_SPI_CmdR1(p_sd_spi_data,                 /* Next cmd is app cmd.                                 */
+                                 FS_DEV_SD_CMD_APP_CMD,
+                                 0u);
+    if (resp_r1 != FS_DEV_SD_SPI_R1_NONE) {
+        return (DEF_FAIL);
+    }
+
+    FS_DEV_SD_SPI_ENTER(p_sd_spi_data->UnitNbr);                /* 'Enter' SPI access.                                  */
+
+    resp_r1 = FSDev_SD_SPI_Cmd(p_sd_spi_data,                   /* Perform ACMD13 (see Note #2).                        */
+                               FS_DEV_SD_ACMD_SD_STATUS,
+                               0u);
+
+    if (resp_r1 != FS_DEV_SD_SPI_R1_NONE) {
+        FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);             /* 'Exit' SPI access.                                   */
+        FS_TRACE_DBG(("FSDev_SD_SPI_SendSDStatus(): Failed to rd card: cmd err: %02X.\r\n", resp_r1));
+        return (DEF_FAIL);
+    }
+
+    resp_r2 = FSDev_SD_SPI_RdByte(p_sd_spi_data->UnitNbr);      /* Rd 2nd resp byte.                                    */
+    if (resp_r2 != FS_DEV_SD_SPI_R1_NONE) {
+        FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);             /* 'Exit' SPI access.                                   */
+        FS_TRACE_DBG(("FSDev_SD_SPI_SendSDStatus(): Failed to rd card: status err: %02X.\r\n", resp_r2));
+        return (DEF_FAIL);
+    }
+
+    token = FSDev_SD_SPI_WaitForStart(p_sd_spi_data->UnitNbr);  /* Wait for start token of data block.                  */
+
+    if (token != FS_DEV_SD_SPI_TOKEN_START_BLK) {
+        FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);             /* 'Exit' SPI access.                                   */
+        FS_TRACE_DBG(("FSDev_SD_SPI_SendSDStatus(): Failed to rd card: start token not received.\r\n"));
+        return (DEF_FAIL);
+    }
+
+    FSDev_SD_SPI_BSP_SPI.Rd(p_sd_spi_data->UnitNbr,             /* Rd SD status.                                        */
+                            p_dest,
+                            FS_DEV_SD_SD_STATUS_LEN);
+
+    FSDev_SD_SPI_BSP_SPI.Rd( p_sd_spi_data->UnitNbr,            /* Rd CRC ...                                           */
+                            &crc_buf[0],
+                             2u);
+
+#if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
+    crc     = MEM_VAL_GET_INT16U_BIG((void *)&crc_buf[0]);      /* ... & chk CRC.                                       */
+    crc_chk = FSDev_SD_ChkSumCalc_16Bit(p_dest, FS_DEV_SD_SD_STATUS_LEN);
+
+    if (crc != crc_chk) {
+        FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);             /* 'Exit' SPI access.                                   */
+        FS_TRACE_DBG(("FSDev_SD_SPI_SendSDStatus(): CRC chk failed: %02X != %02X.\r\n", crc, crc_chk));
+        return (DEF_FAIL);
+    }
+#endif
+
+    FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);                 /* 'Exit' SPI access.                                   */
+    return (DEF_OK);
+}
+
+
 /*
 *********************************************************************************************************
 *                                        FSDev_SD_SPI_RdByte()
@@ -145,6 +145,24 @@ static  const  CPU_INT32U  FSDev_SD_TranSpdValue[]   = {         0u,
                                                                 70u,
                                                                 80u};
 
+                                                                /* Converts SD status AU_SIZE field to 512-octet secs.  */
+static  const  CPU_INT32U  FSDev_SD_AU_Size[]        = {         0u,
+                                                                32u,
+                                                                64u,
+                                                               128u,
+                                                               256u,
+                                                               512u,
+                                                              1024u,
+                                                              2048u,
+                                                              4096u,
+                                                              8192u,
+                                                             16384u,
+                                                             24576u,
+                                                             32768u,
+                                                             49152u,
+                                                             65536u,
+                                                            131072u};
+
 #if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
 static  const  CRC_MODEL_16  FSDev_SD_ModelCRC16     = {
     0x1021u,
@@ -230,6 +248,16 @@ static  const  CRC_MODEL_16  FSDev_SD_ModelCRC16     = {
 *
 *               (4) According to [Ref 1], Section 4.6.2.1-2, the timeouts for high-capacity SD cards
 *                   should be fixed; consequently, TSAC & NSAC should not be consulted.
+*
+*               (5) The erase unit size is calculated from write blocks :
+*
+*                   (a) For SD cards, it is SECTOR_SIZE + 1 write blocks ([Ref 1], Section 5.3.2); the
+*                       field is fixed to 64 kB for high capacity cards.
+*
+*                   (b) For MMC cards, it is (ERASE_GRP_SIZE + 1) * (ERASE_GRP_MULT + 1) write blocks
+*                       ([Ref 2], Section 8.3).
+*
+*                   If the write block length is invalid, the erase unit size is unknown (0).
 *********************************************************************************************************
 */
 
@@ -247,6 +275,8 @@ CPU_BOOLEAN  FSDev_SD_ParseCSD (CPU_INT08U       csd[],
     CPU_INT08U  taac;
     CPU_INT32U  taac_time;
     CPU_INT08U  rd_bl_len;
+    CPU_INT08U  wr_bl_len;
+    CPU_INT32U  erase_size;
     CPU_INT08U  tran_spd;
     CPU_INT08U  tran_spd_unit;
 
@@ -292,6 +322,28 @@ CPU_BOOLEAN  FSDev_SD_ParseCSD (CPU_INT08U       csd[],
 
 
 
+                                                                /* ----------- CALC ERASE SIZE (see Note #5) ---------- */
+    wr_bl_len = (CPU_INT08U)(((csd[12] & 0x03u) << 2)           /* Get wr blk len exp.                                  */
+                          |  ((csd[13] & 0xC0u) >> 6));
+
+    if ((card_type == FS_DEV_SD_CARDTYPE_MMC) ||
+        (card_type == FS_DEV_SD_CARDTYPE_MMC_HC)) {
+        erase_size = ((((CPU_INT32U)csd[10] & 0x7Cu) >> 2) + 1u)        /* Get erase grp size ...                       */
+                   * (((((CPU_INT32U)csd[10] & 0x03u) << 3)             /* ... * erase grp mult.                        */
+                   |   (((CPU_INT32U)csd[11] & 0xE0u) >> 5)) + 1u);
+    } else {
+        erase_size = ((((CPU_INT32U)csd[10] & 0x3Fu) << 1)              /* Get erase sec size.                          */
+                   |   (((CPU_INT32U)csd[11] & 0x80u) >> 7)) + 1u;
+    }
+
+    if ((wr_bl_len >= 9u) && (wr_bl_len <= 11u)) {
+        p_sd_info->EraseSize = (erase_size << wr_bl_len) / FS_DEV_SD_BLK_SIZE;
+    } else {
+        p_sd_info->EraseSize = 0u;
+    }
+
+
+
                                                                 /* ------------------- CALC CLK SPD ------------------- */
     taac                = csd[1];                               /* TAAC data access time.                               */
     taac_time           = FSDev_SD_TAAC_TimeUnit[taac & 0x07u];
@@ -417,6 +469,83 @@ CPU_BOOLEAN  FSDev_SD_ParseCID (CPU_INT08U       cid[],
 
 
 
+/*
+*********************************************************************************************************
+*                                         FSDev_SD_ParseSCR()
+*
+* Description : Parse SCR data.
+*
+* Argument(s) : scr         Array holding SCR data.
+*
+*               p_sd_info   Pointer to struct into which SCR data will be parsed.
+*
+* Return(s)   : DEF_OK   if the SCR could be parsed.
+*               DEF_FAIL if the SCR was illegal.
+*
+* Note(s)     : (1) The SCR register is present ONLY on SD cards.  The structure of the SCR is defined in
+*                   [Ref 1], Section 5.6; only SCR_STRUCTURE 0 (version 1.0) is defined.
+*
+*               (2) The content of erased write blocks is given by DATA_STAT_AFTER_ERASE (bit 55) :  if it
+*                   is clear, erased blocks read back as zeros ([Ref 1], Section 4.3.5).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FSDev_SD_ParseSCR (CPU_INT08U       scr[],
+                                FS_DEV_SD_INFO  *p_sd_info)
+{
+    CPU_INT08U  scr_struct;
+
+
+    scr_struct = (scr[0] & 0xF0u) >> 4;                         /* Chk SCR struct (see Note #1).                        */
+    if (scr_struct != 0u) {
+        p_sd_info->EraseZero = DEF_NO;
+        return (DEF_FAIL);
+    }
+                                                                /* Get erased data state (see Note #2).                 */
+    p_sd_info->EraseZero = (DEF_BIT_IS_CLR(scr[1], DEF_BIT_07) == DEF_YES) ? DEF_YES : DEF_NO;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FSDev_SD_ParseSDStatus()
+*
+* Description : Parse SD status data.
+*
+* Argument(s) : sd_status   Array holding 64-octet SD status.
+*
+*               p_sd_info   Pointer to struct into which SD status data will be parsed.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The SD status is present ONLY on SD cards.  The information format is defined in
+*                   [Ref 1], Section 4.10.2.
+*
+*               (2) The allocation unit (AU) size is given by AU_SIZE (bits 431:428); 0 means that the
+*                   size is not defined.  Values above 9 (4 MB) are defined ONLY by version 3.00 & later
+*                   of the specification.
+*
+*                   An AU is the unit the card manages internally; writes that do not span whole AUs
+*                   are slower.  Since it is usually larger than the erase sector size given in the CSD
+*                   (fixed to 64 kB for high capacity cards, see 'FSDev_SD_ParseCSD()  Note #5a'), it is
+*                   the preferred boundary for the file system layout.
+*********************************************************************************************************
+*/
+
+void  FSDev_SD_ParseSDStatus (CPU_INT08U       sd_status[],
+                              FS_DEV_SD_INFO  *p_sd_info)
+{
+    CPU_INT08U  au_size;
+
+
+    au_size            = (sd_status[10] & 0xF0u) >> 4;          /* Get AU size (see Note #2).                           */
+    p_sd_info->AU_Size =  FSDev_SD_AU_Size[au_size];
+}
+
+
+
 /*
 *********************************************************************************************************
 *                                     FSDev_SD_ChkSumCalc_7Bit()
@@ -558,6 +687,9 @@ void  FSDev_SD_TraceInfo (FS_DEV_SD_INFO  *p_sd_info)
 
     FS_TRACE_INFO(("               Blk Size       : %d bytes\r\n", p_sd_info->BlkSize));
     FS_TRACE_INFO(("               # Blks         : %d\r\n",       p_sd_info->NbrBlks));
+    FS_TRACE_INFO(("               Erase Size     : %d secs\r\n",  p_sd_info->EraseSize));
+    FS_TRACE_INFO(("               Erase Zero     : %s\r\n",      (p_sd_info->EraseZero == DEF_YES) ? "yes" : "no"));
+    FS_TRACE_INFO(("               AU Size        : %d secs\r\n",  p_sd_info->AU_Size));
     FS_TRACE_INFO(("               Max Clk        : %d Hz\r\n",    p_sd_info->ClkFreq));
     FS_TRACE_INFO(("               Manufacturer ID: 0x%02X\r\n",   p_sd_info->ManufID));
     FS_TRACE_INFO(("               OEM/App ID     : 0x%04X\r\n",   p_sd_info->OEM_ID));
@@ -587,6 +719,9 @@ void  FSDev_SD_ClrInfo (FS_DEV_SD_INFO  *p_sd_info)
 {
     p_sd_info->BlkSize      = 0u;
     p_sd_info->NbrBlks      = 0u;
+    p_sd_info->EraseSize    = 0u;
+    p_sd_info->EraseZero    = DEF_NO;
+    p_sd_info->AU_Size      = 0u;
     p_sd_info->ClkFreq      = 0u;
     p_sd_info->Timeout      = 0u;
     p_sd_info->CardType     = FS_DEV_SD_CARDTYPE_NONE;
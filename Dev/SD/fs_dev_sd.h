@@ -100,6 +100,7 @@
 #define  FS_DEV_SD_DSR_REG_LEN                             2u   /* Length of DSR register, in bytes.                    */
 #define  FS_DEV_SD_CID_SCR_LEN                             8u   /* Length of SCR register, in bytes.                    */
 #define  FS_DEV_SD_CID_EXT_CSD_LEN                       512u   /* Length of extended CSD register, in bytes.           */
+#define  FS_DEV_SD_SD_STATUS_LEN                          64u   /* Length of SD status, in bytes.                       */
 
 #define  FS_DEV_SD_DFLT_CLK_SPD                       400000u   /* Dflt clk spd, in Hz.                                 */
 
@@ -413,6 +414,9 @@
 typedef  struct  fs_dev_sd_info {
     CPU_INT32U   BlkSize;                                       /* Block size, in octets (typically 512).               */
     CPU_INT32U   NbrBlks;                                       /* Capacity of device, in blocks.                       */
+    CPU_INT32U   EraseSize;                                     /* Erase unit size, in 512-octet secs (0 if unknown).   */
+    CPU_BOOLEAN  EraseZero;                                     /* Erased blks rd as zeros (SD only, from SCR).         */
+    CPU_INT32U   AU_Size;                                       /* Alloc unit size, in 512-octet secs (0 if unknown).   */
     CPU_INT32U   ClkFreq;                                       /* Max supported clock freq, in Hz.                     */
     CPU_INT32U   Timeout;                                       /* Communication timeout, in cycles.                    */
     CPU_INT08U   CardType;                                      /* Card type.                                           */
@@ -454,6 +458,12 @@ CPU_BOOLEAN  FSDev_SD_ParseCID        (CPU_INT08U       cid[],      /* Parse CID
                                        FS_DEV_SD_INFO  *p_sd_info,
                                        CPU_INT08U       card_type);
 
+CPU_BOOLEAN  FSDev_SD_ParseSCR        (CPU_INT08U       scr[],      /* Parse SCR.                                       */
+                                       FS_DEV_SD_INFO  *p_sd_info);
+
+void         FSDev_SD_ParseSDStatus   (CPU_INT08U       sd_status[],/* Parse SD status.                                 */
+                                       FS_DEV_SD_INFO  *p_sd_info);
+
 CPU_INT08U   FSDev_SD_ChkSumCalc_7Bit (CPU_INT08U      *p_data,     /* Calculate 7-bit CRC.                             */
                                        CPU_INT32U       size);
 
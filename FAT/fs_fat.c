@@ -49,6 +49,7 @@
 #include  "../Source/fs_cfg_fs.h"
 #include  "../Source/fs_def.h"
 #include  "../Source/fs_dev.h"
+#include  "../Source/fs_dir.h"
 #include  "../Source/fs_file.h"
 #include  "../Source/fs_partition.h"
 #include  "../Source/fs_sys.h"
@@ -101,12 +102,15 @@
 
 #define  FS_FAT_MAX_NBR_CLUS_FAT12                      4084u
 #define  FS_FAT_MAX_NBR_CLUS_FAT16                     65524u
+#define  FS_FAT_MAX_NBR_CLUS_FAT32                 268435445u
 #define  FS_FAT_CLUS_NBR_TOLERANCE                        16u
 #define  FS_FAT_MAX_SIZE_HUGE_FAT16                 33554432u   /*  32 MBytes                                           */
 
 #define  FS_FAT_MAX_SIZE_FAT12                       4394304u   /*   4 Mbytes                                           */
 #define  FS_FAT_MAX_SIZE_FAT16                     536870912u   /* 512 Mbytes                                           */
 
+#define  FS_FAT_DEL_TREE_LVL_MAX                           8u   /* Max nbr of dir lvls whose pos is saved in tree walk. */
+
 
 /*
 *********************************************************************************************************
@@ -121,6 +125,23 @@
 #define  FS_FAT_FAT12_CLUS_FREE                       0x0000u
 
 
+/*
+*********************************************************************************************************
+*                                       CLEAN SHUTDOWN BIT DEFINES
+*
+* Note(s) : (1) FAT16 & FAT32 volumes keep a clean shutdown bit in FAT entry 1, set when the volume was
+*               cleanly unmounted.  FAT12 volumes have no such bit.
+*********************************************************************************************************
+*/
+
+#define  FS_FAT_FAT16_CLUS1_CLN_SHUT                  0x8000u
+#define  FS_FAT_FAT32_CLUS1_CLN_SHUT              0x08000000u
+
+#define  FS_FAT_VOL_DIRTY_STATE_CLEAN                     0u    /* Bit set   on media.                                  */
+#define  FS_FAT_VOL_DIRTY_STATE_DIRTY                     1u    /* Bit clr'd on media.                                  */
+#define  FS_FAT_VOL_DIRTY_STATE_CLR                       2u    /* Bit being set.                                       */
+
+
 /*
 *********************************************************************************************************
 *                                         DIRECTORY ENTRY DEFINES
@@ -165,6 +186,22 @@
 #define  FS_FAT_FSI_TRAILSIG                      0xAA550000u
 
 
+/*
+*********************************************************************************************************
+*                                       VOLUME CHECK MAP DEFINES
+*
+* Note(s) : (1) The cluster usage map built by 'FS_FAT_VolChkMap()' holds two bits per cluster, starting
+*               with the first data cluster.
+*********************************************************************************************************
+*/
+
+#define  FS_FAT_VOL_CHK_MAP_USED                 DEF_BIT_00     /* Clus alloc'd in FAT.                                 */
+#define  FS_FAT_VOL_CHK_MAP_REF                  DEF_BIT_01     /* Clus linked from another clus or claimed by entry.   */
+
+#define  FS_FAT_VOL_CHK_MAP_GET(p_map, clus)         ((CPU_INT08U)((((CPU_INT08U *)(p_map))[((clus) - FS_FAT_MIN_CLUS_NBR) / 4u] >> ((((clus) - FS_FAT_MIN_CLUS_NBR) % 4u) * 2u)) & 0x03u))
+#define  FS_FAT_VOL_CHK_MAP_SET(p_map, clus, bits)   (((CPU_INT08U *)(p_map))[((clus) - FS_FAT_MIN_CLUS_NBR) / 4u] |= (CPU_INT08U)((bits) << ((((clus) - FS_FAT_MIN_CLUS_NBR) % 4u) * 2u)))
+
+
 /*
 *********************************************************************************************************
 *                                          LOCAL DATA TYPES
@@ -246,7 +283,11 @@ static  const  FS_FAT_TBL_ENTRY  FS_FAT_TblFAT32[7]   = {{     66600u,  0u},
 *********************************************************************************************************
 */
 
-static  MEM_POOL  FS_FAT_DataPool;
+static  MEM_POOL     FS_FAT_DataPool;
+
+#if ((FS_CFG_RD_ONLY_EN == DEF_DISABLED) && (FS_FAT_CFG_SEC_CLR_BUF_SIZE > 0u))
+static  CPU_INT08U  *FS_FAT_SecClrBufPtr;                       /* Shared zero buf (see 'FS_FAT_SecClr()  Note #1').    */
+#endif
 
 
 /*
@@ -274,6 +315,36 @@ static  void  FS_FAT_ChkFile            (FS_VOL            *p_vol,          /* C
 static  void  FS_FAT_ChkDir             (FS_VOL            *p_vol,          /* Chk dir  integrity.                          */
                                          FS_FAT_FILE_DATA  *p_entry_data,
                                          FS_ERR            *p_err);
+
+static  void  FS_FAT_VolChkWalk         (FS_VOL               *p_vol,    /* Walk dir tree & chk entries.              */
+                                         FS_BUF               *p_buf,
+                                         CPU_INT08U           *p_map,
+                                         CPU_BOOLEAN           repair,
+                                         FS_FAT_VOL_CHK_INFO  *p_info,
+                                         FS_ERR               *p_err);
+
+static  FS_FAT_CLUS_NBR  FS_FAT_VolChkMapFAT   (FS_VOL               *p_vol,   /* Build clus usage map from FAT.        */
+                                                FS_BUF               *p_buf,
+                                                CPU_INT08U           *p_map,
+                                                CPU_BOOLEAN           repair,
+                                                FS_FAT_VOL_CHK_INFO  *p_info,
+                                                FS_ERR               *p_err);
+
+static  CPU_BOOLEAN      FS_FAT_VolChkMapEntry (FS_VOL               *p_vol,   /* Claim entry clus in map.              */
+                                                FS_BUF               *p_buf,
+                                                CPU_INT08U           *p_map,
+                                                FS_FAT_FILE_DATA     *p_entry_data,
+                                                CPU_BOOLEAN           dir,
+                                                CPU_BOOLEAN           repair,
+                                                FS_FAT_VOL_CHK_INFO  *p_info,
+                                                FS_ERR               *p_err);
+
+static  FS_FAT_CLUS_NBR  FS_FAT_VolChkMapLost  (FS_VOL               *p_vol,   /* Find lost clus chains.                */
+                                                FS_BUF               *p_buf,
+                                                CPU_INT08U           *p_map,
+                                                CPU_BOOLEAN           repair,
+                                                FS_FAT_VOL_CHK_INFO  *p_info,
+                                                FS_ERR               *p_err);
 #endif
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
@@ -282,12 +353,37 @@ static  void  FS_FAT_GetSysCfg          (FS_SEC_SIZE        sec_size,       /* G
                                          FS_FAT_SYS_CFG    *p_sys_cfg,
                                          FS_ERR            *p_err);
 
+#if (FS_FAT_CFG_FMT_ALIGN_EN == DEF_ENABLED)
+static  void  FS_FAT_FmtAlignClus       (FS_FAT_SYS_CFG    *p_sys_cfg,      /* Align clus size for fmt.                     */
+                                         FS_SEC_QTY         size,
+                                         FS_SEC_QTY         align_size);
+
+static  void  FS_FAT_FmtAlign           (FS_VOL            *p_vol,          /* Align data area for fmt.                     */
+                                         FS_FAT_SYS_CFG    *p_sys_cfg,
+                                         FS_FAT_SEC_NBR     meta_size,
+                                         FS_SEC_QTY         size,
+                                         FS_SEC_QTY         align_size);
+#endif
+
 static  void  FS_FAT_LowDirFirstClusAdd (FS_VOL            *p_vol,          /* Add 1st clus to dir.                         */
                                          FS_FAT_FILE_DATA  *p_entry_data,
                                          FS_BUF            *p_buf,
                                          FS_FAT_SEC_NBR     dir_parent_sec,
                                          FS_ERR            *p_err);
 
+static  void  FS_FAT_LowTreeEntryDel    (FS_VOL            *p_vol,          /* Del entry found in tree walk.                */
+                                         FS_BUF            *p_buf_dir,
+                                         FS_BUF            *p_buf_fat,
+                                         FS_FAT_DIR_POS    *p_dir_start_pos,
+                                         FS_FAT_DIR_POS    *p_dir_end_pos,
+                                         FS_FAT_CLUS_NBR    file_first_clus,
+                                         FS_ERR            *p_err);
+
+static  void  FS_FAT_LowTreeCkpt        (FS_VOL            *p_vol,          /* Commit tree walk del's.                      */
+                                         FS_BUF            *p_buf_dir,
+                                         FS_BUF            *p_buf_fat,
+                                         FS_ERR            *p_err);
+
 #endif
 
 static  void  FS_FAT_DataSrch           (FS_VOL            *p_vol,          /* Find file in data.                           */
@@ -305,6 +401,16 @@ static  void  FS_FAT_FileDataInit       (FS_FAT_FILE_DATA  *p_entry_data,   /* I
 
 static  void  FS_FAT_DataClr            (FS_FAT_DATA       *p_fat_data);    /* Clr FAT info struct.                         */
 
+#if (FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED)
+static  void  FS_FAT_VolDirtyRd         (FS_VOL            *p_vol,          /* Rd clean shutdown bit & FSINFO.              */
+                                         FS_ERR            *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_VolDirtyClr        (FS_VOL            *p_vol,          /* Set clean shutdown bit & wr FSINFO.          */
+                                         FS_ERR            *p_err);
+#endif
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -331,16 +437,9 @@ static  void  FS_FAT_DataClr            (FS_FAT_DATA       *p_fat_data);    /* C
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) (a) The "dot" entry should have ...
-*                       (1) ... a size of zero ...
-*                       (2) ... & the cluster number of the directory.
-*
-*                   (b) The "dot dot" entry should have ...
-*                       (1) ... a size of zero ...
-*                       (2) ... & the cluster number of the parent directory, if not in the root directory
-*                                        OR          of zero,                 if     in the root directory.
+* Note(s)     : (1) Each file & directory is checked by following its cluster chain (see 'FS_FAT_VolChkWalk()').
 *
-*               (2) #### Check for cross-linked files & lost clusters.
+*               (2) Cross-linked files & lost clusters are found by 'FS_FAT_VolChkMap()'.
 *********************************************************************************************************
 */
 
@@ -348,33 +447,9 @@ static  void  FS_FAT_DataClr            (FS_FAT_DATA       *p_fat_data);    /* C
 void  FS_FAT_VolChk (CPU_CHAR  *name_vol,
                      FS_ERR    *p_err)
 {
-    FS_BUF            *p_buf;
-    CPU_INT08U        *p_dir_entry;
-    FS_FAT_DATA       *p_fat_data;
-    CPU_BOOLEAN        dir;
-    FS_FAT_CLUS_NBR    dir_clus;
-    FS_FAT_CLUS_NBR    dir_clus_tmp;
-    CPU_BOOLEAN        done;
-    CPU_INT16S         dot;
-    CPU_INT16S         dot_dot;
-    CPU_INT08U         fat_attrib;
-    CPU_INT08U         i;
-    CPU_INT08U         level;
-    FS_FAT_DIR_POS     pos;
-    FS_FAT_DIR_POS     end_pos;
-    CPU_BOOLEAN        valid;
-    FS_VOL            *p_vol;
-    CPU_CHAR           name[FS_FAT_MAX_FILE_NAME_LEN + 1u];
-    FS_FAT_SEC_NBR     sec_nbr_stk[FS_FAT_CFG_VOL_CHK_MAX_LEVELS];
-    FS_SEC_SIZE        sec_pos_stk[FS_FAT_CFG_VOL_CHK_MAX_LEVELS];
-    FS_FAT_CLUS_NBR    dir_clus_stk[FS_FAT_CFG_VOL_CHK_MAX_LEVELS];
-    FS_FAT_FILE_DATA   fat_file_data;
-#if  defined(FS_FAT_LFN_MODULE_PRESENT) && \
-            (FS_CFG_UTF8_EN == DEF_ENABLED)
-    CPU_WCHAR          name_utf8[FS_FAT_MAX_FILE_NAME_LEN + 1u];
-    CPU_WCHAR         *p_name_utf8;
-    CPU_SIZE_T         len;
-#endif
+    FS_BUF               *p_buf;
+    FS_VOL               *p_vol;
+    FS_FAT_VOL_CHK_INFO   info;
 
 
 #if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
@@ -402,252 +477,421 @@ void  FS_FAT_VolChk (CPU_CHAR  *name_vol,
         return;
     }
 
-    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
 
-    pos.SecNbr = p_fat_data->RootDirStart;                      /* Start in root dir.                                   */
-    pos.SecPos = 0u;
-    dir_clus   = 0u;
-    level      = 0u;
-    done       = DEF_NO;
+                                                                /* ---------------- CHK FILES & DIRS ------------------ */
+    FS_FAT_ClusChainHintClr(p_vol);                             /* Invalidate clus chain end hints.                     */
+    Mem_Clr((void *)&info, sizeof(info));
+    FS_FAT_VolChkWalk( p_vol,                                   /* See Note #1.                                         */
+                       p_buf,
+                       DEF_NULL,
+                       DEF_YES,
+                      &info,
+                       p_err);
+    if (*p_err == FS_ERR_NONE) {
+        FSBuf_Flush(p_buf, p_err);
+    }
 
+    FSBuf_Free(p_buf);
+    FSVol_ReleaseUnlock(p_vol);
+}
+#endif
 
 
-    while (done == DEF_NO) {
-                                                                /* ------------------ FIND DIR ENTRY ------------------ */
-#if  defined(FS_FAT_LFN_MODULE_PRESENT) && \
-            (FS_CFG_UTF8_EN == DEF_ENABLED)
-        FS_FAT_FN_API_Active.NextDirEntryGet(         p_vol,
-                                                      p_buf,
-                                             (void *)&name_utf8[0],
-                                                     &pos,
-                                                     &end_pos,
-                                                      p_err);
+/*
+*********************************************************************************************************
+*                                         FS_FAT_VolChkMap()
+*
+* Description : Check the cluster allocation of a volume using a cluster usage map.
+*
+* Argument(s) : name_vol    Volume name.
+*
+*               p_map       Pointer to work buffer that will receive the cluster usage map.
+*
+*               map_size    Size of work buffer, in octets (see Note #2).
+*
+*               repair      Indicates whether errors should be repaired :
+*
+*                               DEF_YES, errors are repaired (see Note #4).
+*                               DEF_NO,  errors are only reported.
+*
+*               p_info      Pointer to structure that will receive the check results.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              Volume checked (see Note #5).
+*                               FS_ERR_NAME_NULL         Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_NULL_PTR          Argument 'p_info'   passed a NULL pointer.
+*                               FS_ERR_MEM_ALLOC         Work buffer too small (see Note #2).
+*                               FS_ERR_VOL_NOT_OPEN      Volume not open.
+*                               FS_ERR_VOL_NOT_MOUNTED   Volume not mounted.
+*                               FS_ERR_VOL_FILES_OPEN    Files open on volume (see Note #4c).
+*                               FS_ERR_BUF_NONE_AVAIL    No buffers available.
+*                               FS_ERR_DEV               Device error.
+*
+*                               FS_ERR_VOL_JOURNAL_NOT_STOPPED    Journaling not stopped (see Note #4d).
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The volume is checked in three steps :
+*
+*                   (a) The FAT is read once, sequentially, to build a map holding, for each cluster,
+*                       whether it is allocated & whether it is linked from another cluster.  A cluster
+*                       linked from two clusters is cross-linked.  A link to an invalid or free cluster is
+*                       a link error.  Clusters of allocated chains that no other cluster links to are the
+*                       chain heads.
+*
+*                   (b) The directory tree is walked once.  The first cluster of each entry MUST be a
+*                       chain head; it is then marked as owned.  An entry pointing to a free cluster or to
+*                       a cluster already linked or owned is an entry error or a cross-link.
+*
+*                   (c) Chain heads left unowned are lost chains.
+*
+*                   No cluster chain is followed, except those of directories (to read their entries) &
+*                   of lost chains, so the FAT is not read again for each file.
+*
+*               (2) The map holds two bits per cluster.  The number of clusters is returned in
+*                   'p_info->ClusCnt' even if the work buffer is too small, so that the caller may size
+*                   the buffer with FS_FAT_VOL_CHK_MAP_SIZE().
+*
+*               (3) The free & bad cluster counts of the volume are set from the map.  The cached free
+*                   count is reported as wrong in 'p_info->ClusFreeCntErr' if it did not match.
+*
+*               (4) When errors are repaired :
+*
+*                   (a) A link error or a cross-link in the FAT is cut by ending the linking chain; an
+*                       entry error or a cross-linked entry is cleared, like an entry holding an invalid
+*                       cluster (see 'FS_FAT_VolChkWalk()').  The file size of a cut chain is not
+*                       corrected; see 'FS_FAT_VolChk()'.
+*
+*                   (b) Lost chains are freed.  Lost chains are NOT searched if a directory was nested too
+*                       deep to be walked, since its clusters would be seen as lost.
+*
+*                   (c) No file may be open on the volume, since the clusters allocated to an open file
+*                       may not yet be linked from its directory entry.  The cluster chain end hints of
+*                       closed files are cleared, since a repair may cut or free any chain.
+*
+*                   (d) Journaling MUST be stopped (see 'fs_fat_journal.c  FS_FAT_JournalStop()').  A cut
+*                       in the FAT ends a chain whose remaining clusters belong to another chain, which no
+*                       journal log can revert or complete.  If repairs were journaled, a failure during
+*                       the check would revert the entry repairs but keep the FAT cuts.
+*
+*               (5) A chain forming a loop with no head is not detected.
+*
+*               (6) A volume found dirty when mounted may be marked clean again once fully checked, with
+*                   errors repaired or none found (see 'FS_FAT_VolSync()  Note #2').
+*********************************************************************************************************
+*/
 
-                                                                /* Conversion from wide char to reg char                */
-        p_name_utf8 = &name_utf8[0];
-        len         = WC_StrToMB(             &name[0],
-                                              &p_name_utf8,
-                                 (CPU_SIZE_T)  FS_FAT_MAX_FILE_NAME_LEN);
+#if (FS_FAT_CFG_VOL_CHK_EN == DEF_ENABLED)
+void  FS_FAT_VolChkMap (CPU_CHAR             *name_vol,
+                        void                 *p_map,
+                        CPU_SIZE_T            map_size,
+                        CPU_BOOLEAN           repair,
+                        FS_FAT_VOL_CHK_INFO  *p_info,
+                        FS_ERR               *p_err)
+{
+    FS_BUF           *p_buf_dir;
+    FS_BUF           *p_buf_fat;
+    FS_VOL           *p_vol;
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   clus_free_cnt;
+    FS_FAT_CLUS_NBR   root_clus;
+    CPU_INT08U        state;
 
-        if (len == (CPU_SIZE_T)-1) {
-           *p_err = FS_ERR_ENTRY_CORRUPT;
-            FSVol_ReleaseUnlock(p_vol);
-            return;
-        }
-#else
-        FS_FAT_FN_API_Active.NextDirEntryGet(         p_vol,
-                                                      p_buf,
-                                             (void *)&name[0],
-                                                     &pos,
-                                                     &end_pos,
-                                                      p_err);
 
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == (CPU_CHAR *)0) {                            /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+    if (p_info == (FS_FAT_VOL_CHK_INFO *)0) {                   /* Validate info ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
 #endif
 
+#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)
+    repair = DEF_NO;
+#endif
 
+    Mem_Clr((void *)p_info, sizeof(FS_FAT_VOL_CHK_INFO));
 
-        switch (*p_err) {
-            case FS_ERR_EOF:                                    /* ----------------- END OF DIRECTORY ----------------- */
-                 if (level == 0) {                              /* If in root dir ...                                   */
-                     done  = DEF_YES;                           /* ... no more entries to process.                      */
-                    *p_err = FS_ERR_NONE;                       /* Make sure No error is returned when no more entries  */
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol MUST be mounted.                                 */
+    if (p_vol == (FS_VOL *)0) {
+        return;
+    }
 
-                 } else {                                       /* Otherwise ...                                        */
-                     level--;                                   /* ... move to parent dir.                              */
+    if ((repair        == DEF_YES) &&                           /* See Note #4c.                                        */
+        (p_vol->FileCnt != 0u)) {
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_VOL_FILES_OPEN;
+        return;
+    }
 
-                     pos.SecNbr = sec_nbr_stk[level];
-                     pos.SecPos = sec_pos_stk[level];
-                     dir_clus   = dir_clus_stk[level];
-                 }
-                 break;
+    p_fat_data      = (FS_FAT_DATA *)p_vol->DataPtr;
+#ifdef FS_FAT_JOURNAL_MODULE_PRESENT
+    if ((repair == DEF_YES) &&                                  /* See Note #4d.                                        */
+        (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START) == DEF_YES)) {
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_VOL_JOURNAL_NOT_STOPPED;
+        return;
+    }
+#endif
+    p_info->ClusCnt =  p_fat_data->MaxClusNbr - FS_FAT_MIN_CLUS_NBR;
+    if ((p_map    == DEF_NULL) ||                               /* Chk work buf size (see Note #2).                     */
+        (map_size <  FS_FAT_VOL_CHK_MAP_SIZE(p_info->ClusCnt))) {
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+    Mem_Clr(p_map, FS_FAT_VOL_CHK_MAP_SIZE(p_info->ClusCnt));
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    if (repair == DEF_YES) {                                    /* Invalidate clus chain end hints (see Note #4c).      */
+        FS_FAT_ClusChainHintClr(p_vol);
+    }
+#endif
+
+
+                                                                /* ------------------ PREPARE FOR CHK ----------------- */
+    p_buf_dir = FSBuf_Get(p_vol);
+    if (p_buf_dir == (FS_BUF *)0) {
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
+    p_buf_fat = FSBuf_Get(p_vol);
+    if (p_buf_fat == (FS_BUF *)0) {
+        FSBuf_Free(p_buf_dir);
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
 
 
+                                                                /* ------------- MAP FAT (see Note #1a) --------------- */
+    clus_free_cnt = FS_FAT_VolChkMapFAT(p_vol,
+                                        p_buf_fat,
+                                        (CPU_INT08U *)p_map,
+                                        repair,
+                                        p_info,
+                                        p_err);
+    if (*p_err == FS_ERR_NONE) {
+        FSBuf_Flush(p_buf_fat, p_err);
+    }
 
 
-            case FS_ERR_NONE:                                   /* ---------------- DIR ENTRY DIR FOUND --------------- */
-                 p_dir_entry = (CPU_INT08U *)p_buf->DataPtr + end_pos.SecPos;
-                 fat_attrib  = MEM_VAL_GET_INT08U_LITTLE(p_dir_entry + FS_FAT_DIRENT_OFF_ATTR);
+                                                                /* ---------- WALK DIR TREE (see Note #1b) ------------ */
+    if (*p_err == FS_ERR_NONE) {
+        if (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT32) {    /* Root dir clus is owned by the vol.                   */
+            root_clus = FS_FAT_SEC_TO_CLUS(p_fat_data, p_fat_data->RootDirStart);
+            state     = FS_FAT_VOL_CHK_MAP_GET(p_map, root_clus);
+            if (DEF_BIT_IS_SET(state, FS_FAT_VOL_CHK_MAP_REF) == DEF_YES) {
+                FS_TRACE_INFO(("FS_FAT_VolChkMap(): Root dir clus linked from another clus.\r\n"));
+                p_info->CrossLinkCnt++;
+            }
+            FS_FAT_VOL_CHK_MAP_SET(p_map, root_clus, FS_FAT_VOL_CHK_MAP_REF);
+        }
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-                 fat_file_data.DirStartSec    = pos.SecNbr;
-                 fat_file_data.DirStartSecPos = pos.SecPos;
-                 fat_file_data.DirEndSec      = end_pos.SecNbr;
-                 fat_file_data.DirEndSecPos   = end_pos.SecPos;
-                 fat_file_data.Attrib         = fat_attrib;
-                 fat_file_data.FileFirstClus  = FS_FAT_DIRENT_CLUS_NBR_GET(p_dir_entry);
-                 fat_file_data.FileSize       = MEM_VAL_GET_INT32U_LITTLE(p_dir_entry + FS_FAT_DIRENT_OFF_FILESIZE);
-#endif
+        FS_FAT_VolChkWalk(p_vol,
+                          p_buf_dir,
+                          (CPU_INT08U *)p_map,
+                          repair,
+                          p_info,
+                          p_err);
+    }
+    if (*p_err == FS_ERR_NONE) {
+        FSBuf_Flush(p_buf_dir, p_err);
+    }
 
-                 dir = DEF_BIT_IS_SET(fat_attrib, FS_FAT_DIRENT_ATTR_DIRECTORY);
-                 if (dir == DEF_YES) {                          /* If dir ...                                           */
-                                                                /* ... srch files in dir.                               */
-                     FS_TRACE_DBG(("FS_FAT_VolChk(): Found dir  "));
-                     for (i = 0u; i < level; i++) {
-                         FS_TRACE_DBG(("  "));
-                     }
-                     FS_TRACE_DBG(("%s\r\n", name));
 
-                     dot = Str_Cmp_N(name, (CPU_CHAR *)".", FS_CFG_MAX_PATH_NAME_LEN);
-                     if (dot == 0) {                            /* "Dot" entry (see Note #1a).                         */
-                         dir_clus_tmp = fat_file_data.FileFirstClus;
-                         if (level == 0u) {
-                             FS_TRACE_INFO(("FS_FAT_VolChk(): \".\" entry in root dir.\r\n"));
-                         } else {
-                             if (dir_clus_tmp != dir_clus) {    /* If clus nbr bad ...                                  */
-                                 FS_TRACE_INFO(("FS_FAT_VolChk(): \".\" entry of dir in root dir with invalid clus nbr: %d (!= %d).\r\n", dir_clus_tmp, dir_clus));
+                                                                /* ------------ FIND LOST CHAINS (see Note #1c) ------- */
+    if (*p_err == FS_ERR_NONE) {
+        clus_free_cnt += FS_FAT_VolChkMapLost(p_vol,
+                                              p_buf_fat,
+                                              (CPU_INT08U *)p_map,
+                                              repair,
+                                              p_info,
+                                              p_err);
+    }
+    if (*p_err == FS_ERR_NONE) {
+        FSBuf_Flush(p_buf_fat, p_err);
+    }
 
-                                                                /* ... correct clus nbr.                                */
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-                                 fat_file_data.FileFirstClus = dir_clus;
-                                 fat_file_data.FileSize      = 0u;
 
-                                 FS_FAT_LowEntryUpdate( p_vol,
-                                                        p_buf,
-                                                       &fat_file_data,
-                                                        DEF_YES,
-                                                        p_err);
-                                     if (*p_err == FS_ERR_DEV) {
-                                         FSBuf_Free(p_buf);
-                                         FSVol_ReleaseUnlock(p_vol);
-                                         return;
-                                     }
+                                                                /* --------- UPDATE FREE CLUS CNT (see Note #3) ------- */
+    if (*p_err == FS_ERR_NONE) {
+        if ((p_fat_data->QueryInfoValid   == DEF_YES) &&
+            (p_fat_data->QueryFreeClusCnt != clus_free_cnt)) {
+            FS_TRACE_INFO(("FS_FAT_VolChkMap(): Free clus cnt %d (!= %d).\r\n", p_fat_data->QueryFreeClusCnt, clus_free_cnt));
+            p_info->ClusFreeCntErr = DEF_YES;
+        }
+        p_fat_data->QueryInfoValid   = DEF_YES;
+        p_fat_data->QueryBadClusCnt  = p_info->ClusBadCnt;
+        p_fat_data->QueryFreeClusCnt = clus_free_cnt;
+        p_info->ClusFreeCnt          = clus_free_cnt;
+
+#if (FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED)                    /* Vol chk'd (see Note #6).                             */
+        if ((*p_err            == FS_ERR_NONE) &&
+            (p_info->DirSkipCnt == 0u)         &&
+           ((repair            == DEF_YES)     ||
+            ((p_info->LinkErrCnt + p_info->CrossLinkCnt + p_info->LostChainCnt + p_info->EntryErrCnt) == 0u))) {
+            p_fat_data->VolChkReqd = DEF_NO;
+        }
 #endif
-                             }
-                         }
+    }
 
-                         pos.SecNbr = end_pos.SecNbr;           /* Move to next entry.                                  */
-                         pos.SecPos = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
+    FSBuf_Free(p_buf_fat);
+    FSBuf_Free(p_buf_dir);
+    FSVol_ReleaseUnlock(p_vol);
+}
+#endif
 
 
-                     } else {
-                         dot_dot = Str_Cmp_N(name, (CPU_CHAR *)"..", FS_CFG_MAX_PATH_NAME_LEN);
-                         if (dot_dot == 0) {                    /* "Dot dot" entry (see Note #1b).                      */
-                             dir_clus_tmp = fat_file_data.FileFirstClus;
-                             if (level == 0u) {
-                                 FS_TRACE_INFO(("FS_FAT_VolChk(): \"..\" entry in root dir.\r\n"));
-                             } else {
-                                                                /* If clus nbr bad ...                                  */
-                                 if (dir_clus_tmp != dir_clus_stk[level - 1]) {
-                                     FS_TRACE_INFO(("FS_FAT_VolChk(): \"..\" entry of dir in root dir with invalid clus nbr: %d (!= %d).\r\n", dir_clus_tmp, dir_clus_stk[level - 1]));
-
-                                                                /* ... correct clus nbr.                                */
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-                                     fat_file_data.FileFirstClus = dir_clus_stk[level - 1u];
-                                     fat_file_data.FileSize      = 0u;
-
-                                     FS_FAT_LowEntryUpdate( p_vol,
-                                                            p_buf,
-                                                           &fat_file_data,
-                                                            DEF_YES,
-                                                            p_err);
-                                     if (*p_err == FS_ERR_DEV) {
-                                         FSBuf_Free(p_buf);
-                                         FSVol_ReleaseUnlock(p_vol);
-                                         return;
-                                     }
-#endif
-                                 }
-                             }
-
-                             pos.SecNbr = end_pos.SecNbr;       /* Move to next entry.                                  */
-                             pos.SecPos = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
-
-
-                         } else {                               /* Dir.                                                 */
-                             if (level < FS_FAT_CFG_VOL_CHK_MAX_LEVELS) {
-                                 sec_nbr_stk[level]  = end_pos.SecNbr;
-                                 sec_pos_stk[level]  = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
-                                 dir_clus_stk[level] = dir_clus;
-
-                                 level++;
-
-                                 dir_clus            = fat_file_data.FileFirstClus;
-                                 pos.SecNbr          = FS_FAT_CLUS_TO_SEC(p_fat_data, dir_clus);
-                                 pos.SecPos          = 0u;
+/*
+*********************************************************************************************************
+*                                        FS_FAT_VolDirtyGet()
+*
+* Description : Get whether a volume was dirty when mounted.
+*
+* Argument(s) : name_vol    Volume name.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              Volume state gotten.
+*                               FS_ERR_NAME_NULL         Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_VOL_NOT_OPEN      Volume not open.
+*                               FS_ERR_VOL_NOT_MOUNTED   Volume not mounted.
+*
+* Return(s)   : DEF_YES, if the volume was NOT cleanly unmounted (see Note #1).
+*
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) A FAT16 or FAT32 volume is clean if the clean shutdown bit in FAT entry 1 was set when
+*                   the volume was mounted.  FAT12 volumes have no such bit & are always reported as dirty.
+*
+*               (2) On a clean volume, the file system may be trusted without check.  The free cluster
+*                   count & next free cluster kept in the FAT32 FSINFO sector are then used, so that the
+*                   free space of the volume is known without reading the FAT.
+*
+*               (3) On a dirty volume, the volume should be checked with 'FS_FAT_VolChkMap()', unless its
+*                   journal was replayed.
+*********************************************************************************************************
+*/
 
-                                 valid               = FS_FAT_IS_VALID_CLUS(p_fat_data, dir_clus);
-                                 if (valid == DEF_NO) {         /* If clus not valid ...                                */
-                                     FS_TRACE_INFO(("FS_FAT_VolChk(): Dir clus nbr invalid.\r\n"));
+#if (FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED)
+CPU_BOOLEAN  FS_FAT_VolDirtyGet (CPU_CHAR  *name_vol,
+                                 FS_ERR    *p_err)
+{
+    FS_VOL       *p_vol;
+    FS_FAT_DATA  *p_fat_data;
+    CPU_BOOLEAN   dirty;
 
-                                                                /* ... clr clus nbr  ...                                */
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-                                     fat_file_data.FileFirstClus = 0u;
-                                     fat_file_data.FileSize      = 0u;
 
-                                     FS_FAT_LowEntryUpdate( p_vol,
-                                                            p_buf,
-                                                           &fat_file_data,
-                                                            DEF_YES,
-                                                            p_err);
-                                     if (*p_err == FS_ERR_DEV) {
-                                         FSBuf_Free(p_buf);
-                                         FSVol_ReleaseUnlock(p_vol);
-                                         return;
-                                     }
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(DEF_YES);
+    }
+    if (name_vol == (CPU_CHAR *)0) {                            /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return (DEF_YES);
+    }
 #endif
 
-                                     level--;                   /* ... & move to next entry.                            */
-                                     pos.SecNbr = sec_nbr_stk[level];
-                                     pos.SecPos = sec_pos_stk[level];
-                                     dir_clus   = dir_clus_stk[level];
-
-
-                                 } else {                       /* Chk dir.                                             */
-                                     FS_FAT_ChkDir( p_vol,
-                                                   &fat_file_data,
-                                                    p_err);
-                                     if (*p_err == FS_ERR_DEV) {
-                                         FSBuf_Free(p_buf);
-                                         FSVol_ReleaseUnlock(p_vol);
-                                         return;
-                                     }
-                                 }
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol MUST be mounted.                                 */
+    (void)p_err;                                               /* Err ignored. Ret val chk'd instead.                  */
+    if (p_vol == (FS_VOL *)0) {
+        return (DEF_YES);
+    }
 
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    dirty      =  p_fat_data->VolDirtyOpen;
 
-                             } else {                           /* Nesting too deep.                                    */
-                                 FS_TRACE_DBG(("FS_FAT_VolChk(): Nesting too deep.\r\n"));
-                                 pos.SecNbr = end_pos.SecNbr;   /* Move to next entry.                                  */
-                                 pos.SecPos = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
-                             }
-                         }
-                     }
+    FSVol_ReleaseUnlock(p_vol);
+   *p_err = FS_ERR_NONE;
 
+    return (dirty);
+}
+#endif
 
 
-                                                                /* --------------- DIR ENTRY FILE FOUND --------------- */
-                 } else {                                       /* If file ...                                          */
-                     FS_TRACE_DBG(("FS_FAT_VolChk(): Found file "));
-                     for (i = 0u; i < level; i++) {
-                         FS_TRACE_DBG(("  "));
-                     }
-                     FS_TRACE_DBG(("%s\r\n", name));
+/*
+*********************************************************************************************************
+*                                          FS_FAT_VolSync()
+*
+* Description : Mark a volume clean.
+*
+* Argument(s) : name_vol    Volume name.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              Volume marked clean (see Note #2).
+*                               FS_ERR_NAME_NULL         Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_VOL_NOT_OPEN      Volume not open.
+*                               FS_ERR_VOL_NOT_MOUNTED   Volume not mounted.
+*                               FS_ERR_VOL_FILES_OPEN    Files open on volume (see Note #3).
+*                               FS_ERR_BUF_NONE_AVAIL    No buffers available.
+*                               FS_ERR_DEV               Device error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The clean shutdown bit in FAT entry 1 is set, as when the volume is closed, after all
+*                   cached sectors & the FAT32 FSINFO sector were written.  It is cleared again on the next
+*                   write to the volume.
+*
+*               (2) A volume found dirty when mounted is left dirty until it is checked with
+*                   'FS_FAT_VolChkMap()' or its journal is replayed, so that a crash is never hidden.
+*
+*               (3) No file may be open on the volume, since the clusters allocated to an open file may not
+*                   yet be linked from its directory entry.
+*********************************************************************************************************
+*/
 
-                     FS_FAT_ChkFile( p_vol,                     /* ... chk file.                                        */
-                                    &fat_file_data,
-                                     p_err);
+#if ((FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED) && (FS_CFG_RD_ONLY_EN == DEF_DISABLED))
+void  FS_FAT_VolSync (CPU_CHAR  *name_vol,
+                      FS_ERR    *p_err)
+{
+    FS_VOL  *p_vol;
 
-                     if (*p_err == FS_ERR_DEV) {
-                         FSBuf_Free(p_buf);
-                         FSVol_ReleaseUnlock(p_vol);
-                         return;
-                     }
 
-                     pos.SecNbr = end_pos.SecNbr;               /* Move to next entry.                                  */
-                     pos.SecPos = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
-                 }
-                 break;
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == (CPU_CHAR *)0) {                            /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+#endif
 
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol MUST be mounted.                                 */
+    (void)p_err;                                               /* Err ignored. Ret val chk'd instead.                  */
+    if (p_vol == (FS_VOL *)0) {
+        return;
+    }
 
+    if (p_vol->FileCnt != 0u) {                                 /* See Note #3.                                         */
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_VOL_FILES_OPEN;
+        return;
+    }
 
-            case FS_ERR_DEV:                                    /* ---------------------- DEV ERR --------------------- */
-            default:
-                 done = DEF_YES;
-                 break;
-        }
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)                   /* ---------------- COMMIT JOURNAL TX ----------------- */
+    FS_FAT_JournalTxFlush(p_vol, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        FSVol_ReleaseUnlock(p_vol);
+        return;
     }
+#endif
+
+    FS_FAT_VolDirtyClr(p_vol, p_err);                           /* Mark vol clean (see Notes #1 & #2).                  */
 
-    FSBuf_Flush(p_buf, p_err);
-    FSBuf_Free(p_buf);
     FSVol_ReleaseUnlock(p_vol);
 }
 #endif
@@ -931,6 +1175,8 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainDel (FS_VOL           *p_vol,
     }
 #endif
 
+    FS_FAT_ClusChainHintClr(p_vol);                             /* Invalidate clus chain end hints.                     */
+
                                                                 /* ------------------ JOURNAL ENTER ------------------- */
 #ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
     if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_REPLAY) == DEF_NO) {
@@ -1093,6 +1339,8 @@ void  FS_FAT_ClusChainReverseDel (FS_VOL           *p_vol,
     }
 #endif
 
+    FS_FAT_ClusChainHintClr(p_vol);                             /* Invalidate clus chain end hints.                     */
+
                                                                 /* ------------------- FREE CLUS'S -------------------- */
     do {
                                                                 /* Find chain end.                                      */
@@ -1415,6 +1663,137 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainReverseFollow (FS_VOL           *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                      FS_FAT_ClusChainHintGet()
+*
+* Description : Get the end of a cluster chain, as recorded when a file was last closed.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+*               first_clus  First cluster of the chain.
+*
+*               p_clus_cnt  Pointer to variable that will receive the number of clusters in the chain.
+*
+* Return(s)   : Last cluster of the chain, if a hint is recorded for the chain.
+*               0,                         otherwise.
+*
+* Note(s)     : (1) A hint records the last cluster & the cluster count of the chain of a file that was
+*                   closed, so that the chain need not be followed again when the file is reopened (see
+*                   'fs_fat_file.c  FS_FAT_FileOpen()  Note #5').
+*
+*               (2) A chain can only shrink or be replaced once some of its clusters are freed.  Every
+*                   hint is therefore cleared whenever clusters are freed (see 'FS_FAT_ClusChainHintClr()'),
+*                   & a chain found in the table is known to be intact.
+*********************************************************************************************************
+*/
+
+FS_FAT_CLUS_NBR  FS_FAT_ClusChainHintGet (FS_VOL           *p_vol,
+                                          FS_FAT_CLUS_NBR   first_clus,
+                                          FS_FAT_CLUS_NBR  *p_clus_cnt)
+{
+    FS_FAT_DATA             *p_fat_data;
+    FS_FAT_CLUS_CHAIN_HINT  *p_hint;
+    CPU_INT08U               ix;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    for (ix = 0u; ix < FS_FAT_CLUS_CHAIN_HINT_CNT; ix++) {
+        p_hint = &p_fat_data->ChainHintTbl[ix];
+        if ((p_hint->FirstClus == first_clus) &&
+            (first_clus        != 0u)) {
+           *p_clus_cnt = p_hint->ClusCnt;
+            return (p_hint->LastClus);
+        }
+    }
+
+   *p_clus_cnt = 0u;
+    return (0u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FS_FAT_ClusChainHintSet()
+*
+* Description : Record the end of a cluster chain.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+*               first_clus  First cluster of the chain.
+*
+*               last_clus   Last  cluster of the chain.
+*
+*               clus_cnt    Number of clusters in the chain.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The hint for the same chain is replaced, if any.  Otherwise, hints are replaced in
+*                   round-robin order.
+*********************************************************************************************************
+*/
+
+void  FS_FAT_ClusChainHintSet (FS_VOL           *p_vol,
+                               FS_FAT_CLUS_NBR   first_clus,
+                               FS_FAT_CLUS_NBR   last_clus,
+                               FS_FAT_CLUS_NBR   clus_cnt)
+{
+    FS_FAT_DATA             *p_fat_data;
+    FS_FAT_CLUS_CHAIN_HINT  *p_hint;
+    CPU_INT08U               ix;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    ix = 0u;                                                    /* Find hint for same chain ...                         */
+    while ((ix                                   <  FS_FAT_CLUS_CHAIN_HINT_CNT) &&
+           (p_fat_data->ChainHintTbl[ix].FirstClus != first_clus)) {
+        ix++;
+    }
+    if (ix == FS_FAT_CLUS_CHAIN_HINT_CNT) {                     /* ... or replace oldest hint.                          */
+        ix                      = p_fat_data->ChainHintIx;
+        p_fat_data->ChainHintIx = (CPU_INT08U)((ix + 1u) % FS_FAT_CLUS_CHAIN_HINT_CNT);
+    }
+
+    p_hint            = &p_fat_data->ChainHintTbl[ix];
+    p_hint->FirstClus =  first_clus;
+    p_hint->LastClus  =  last_clus;
+    p_hint->ClusCnt   =  clus_cnt;
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FS_FAT_ClusChainHintClr()
+*
+* Description : Clear all cluster chain end hints of a volume.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) MUST be called before clusters are freed (see 'FS_FAT_ClusChainHintGet()  Note #2').
+*********************************************************************************************************
+*/
+
+void  FS_FAT_ClusChainHintClr (FS_VOL  *p_vol)
+{
+    FS_FAT_DATA  *p_fat_data;
+    CPU_INT08U    ix;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    for (ix = 0u; ix < FS_FAT_CLUS_CHAIN_HINT_CNT; ix++) {
+        p_fat_data->ChainHintTbl[ix].FirstClus = 0u;
+        p_fat_data->ChainHintTbl[ix].LastClus  = 0u;
+        p_fat_data->ChainHintTbl[ix].ClusCnt   = 0u;
+    }
+    p_fat_data->ChainHintIx = 0u;
+}
+
+
 /*
 *********************************************************************************************************
 *                                       FS_FAT_ClusFreeFind()
@@ -1916,29 +2295,150 @@ void  FS_FAT_Query (FS_VOL       *p_vol,
 
 /*
 *********************************************************************************************************
-*                                        FS_FAT_MakeBootSec()
+*                                        FS_FAT_VolDirtySet()
 *
-* Description : Make boot sector.
+* Description : Mark a volume dirty before a sector is written.
 *
-* Argument(s) : p_temp              Pointer to temporary buffer.
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
 *
-*               p_sys_cfg           Pointer to format configuration information.
+*               p_src       Pointer to source buffer, or DEF_NULL if no sector is written.
 *
-*               sec_size            Sector size, in octets.
+*               start       Start sector of write.
 *
-*               size                Size of volume in sectors.
+*               cnt         Number of sectors to write.
 *
-*               fat_size            Size of one FAT in sectors.
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
 *
-*               partition_start     partition start: number of sectors from the MBR
+*                               FS_ERR_NONE              Volume marked dirty.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) See 'FS_FAT_VolFmt() Note #6'.
+* Note(s)     : (1) On the first write after the volume was mounted or marked clean, the clean shutdown bit
+*                   in FAT entry 1 is cleared & a write barrier issued, so that the volume is known to be
+*                   dirty on the medium before any other sector is modified.
 *
-*               (2) See 'FS_FAT_VolFmt() Note #7'.
+*               (2) Once the volume is dirty, a write of the first FAT sector, possibly from a buffer read
+*                   before the bit was cleared, is patched so that it never sets the bit again.
 *
-*               (3) Avoid 'Excessive shift value' or 'Constant expression evaluates to 0' warning.
+*               (3) While the volume is being marked clean (see 'FS_FAT_VolDirtyClr()'), sectors are
+*                   written unchanged.
+*********************************************************************************************************
+*/
+
+#if ((FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED) && (FS_CFG_RD_ONLY_EN == DEF_DISABLED))
+void  FS_FAT_VolDirtySet (FS_VOL      *p_vol,
+                          void        *p_src,
+                          FS_SEC_NBR   start,
+                          FS_SEC_QTY   cnt,
+                          FS_ERR      *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_BUF           *p_buf;
+    FS_FAT_CLUS_NBR   val;
+    CPU_INT08U       *p_entry;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+   *p_err      =  FS_ERR_NONE;
+
+    if ((p_fat_data == (FS_FAT_DATA *)0) ||                     /* Vol being fmt'd, no sec wr'n ...                     */
+        (cnt        == 0u)) {
+        return;
+    }
+    if (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT12) {        /* ... or no clean shutdown bit.                        */
+        return;
+    }
+
+    switch (p_fat_data->VolDirtyState) {
+        case FS_FAT_VOL_DIRTY_STATE_CLEAN:                      /* -------------- MARK DIRTY (see Note #1) ------------ */
+             p_buf = FSBuf_Get(p_vol);
+             if (p_buf == (FS_BUF *)0) {
+                *p_err = FS_ERR_BUF_NONE_AVAIL;
+                 return;
+             }
+                                                                /* Set state first: FAT sec wr below is patched.        */
+             p_fat_data->VolDirtyState = FS_FAT_VOL_DIRTY_STATE_DIRTY;
+
+             val = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol, p_buf, 1u, p_err);
+             if (*p_err == FS_ERR_NONE) {
+                 if (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT16) {
+                     val &= ~(FS_FAT_CLUS_NBR)FS_FAT_FAT16_CLUS1_CLN_SHUT;
+                 } else {
+                     val &= ~(FS_FAT_CLUS_NBR)FS_FAT_FAT32_CLUS1_CLN_SHUT;
+                 }
+                 p_fat_data->FAT_TypeAPI_Ptr->ClusValWr(p_vol, p_buf, 1u, val, p_err);
+             }
+             if (*p_err == FS_ERR_NONE) {
+                 FSBuf_Flush(p_buf, p_err);
+             }
+             FSBuf_Free(p_buf);
+
+             if (*p_err == FS_ERR_NONE) {
+                 FSVol_BarrierLocked(p_vol, p_err);             /* Vol dirty on media before sec is wr'n.               */
+             }
+             if (*p_err != FS_ERR_NONE) {
+                 p_fat_data->VolDirtyState = FS_FAT_VOL_DIRTY_STATE_CLEAN;
+             }
+             break;
+
+
+        case FS_FAT_VOL_DIRTY_STATE_DIRTY:                      /* ----------- PATCH FAT SEC (see Note #2) ------------ */
+             if ((p_src                                       != DEF_NULL) &&
+                 ((FS_SEC_NBR)p_fat_data->FAT1_Start          >= start)    &&
+                 ((FS_SEC_NBR)p_fat_data->FAT1_Start - start  <  cnt)) {
+                 p_entry = (CPU_INT08U *)p_src + ((FS_SEC_NBR)p_fat_data->FAT1_Start - start) * p_fat_data->SecSize;
+                 if (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT16) {
+                     p_entry += FS_FAT_FAT16_ENTRY_NBR_OCTETS;
+                     val      = MEM_VAL_GET_INT16U_LITTLE((void *)p_entry);
+                     val     &= ~(FS_FAT_CLUS_NBR)FS_FAT_FAT16_CLUS1_CLN_SHUT;
+                     MEM_VAL_SET_INT16U_LITTLE((void *)p_entry, val);
+                 } else {
+                     p_entry += FS_FAT_FAT32_ENTRY_NBR_OCTETS;
+                     val      = MEM_VAL_GET_INT32U_LITTLE((void *)p_entry);
+                     val     &= ~(FS_FAT_CLUS_NBR)FS_FAT_FAT32_CLUS1_CLN_SHUT;
+                     MEM_VAL_SET_INT32U_LITTLE((void *)p_entry, val);
+                 }
+             }
+             break;
+
+
+        case FS_FAT_VOL_DIRTY_STATE_CLR:                        /* See Note #3.                                         */
+        default:
+             break;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_MakeBootSec()
+*
+* Description : Make boot sector.
+*
+* Argument(s) : p_temp              Pointer to temporary buffer.
+*
+*               p_sys_cfg           Pointer to format configuration information.
+*
+*               sec_size            Sector size, in octets.
+*
+*               size                Size of volume in sectors.
+*
+*               fat_size            Size of one FAT in sectors.
+*
+*               partition_start     partition start: number of sectors from the MBR
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FS_FAT_VolFmt() Note #6'.
+*
+*               (2) See 'FS_FAT_VolFmt() Note #7'.
+*
+*               (3) Avoid 'Excessive shift value' or 'Constant expression evaluates to 0' warning.
 *********************************************************************************************************
 */
 
@@ -2073,7 +2573,8 @@ void  FS_FAT_MakeBootSec (void            *p_temp,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The sector clear buffer is zeroed once & never written afterwards; it is shared by all
+*                   volumes (see 'FS_FAT_SecClr()  Note #1').
 *********************************************************************************************************
 */
 
@@ -2104,6 +2605,24 @@ void  FS_FAT_ModuleInit (FS_QTY   vol_cnt,
 
 
 
+#if ((FS_CFG_RD_ONLY_EN == DEF_DISABLED) && (FS_FAT_CFG_SEC_CLR_BUF_SIZE > 0u))
+                                                                /* ---------------- ALLOC SEC CLR BUF ----------------- */
+    FS_FAT_SecClrBufPtr = (CPU_INT08U *)Mem_HeapAlloc((CPU_SIZE_T)FS_FAT_CFG_SEC_CLR_BUF_SIZE,
+                                                      (CPU_SIZE_T)FS_CFG_BUF_ALIGN_OCTETS,
+                                                                 &octets_reqd,
+                                                                 &pool_err);
+    if (FS_FAT_SecClrBufPtr == DEF_NULL) {
+       *p_err = FS_ERR_MEM_ALLOC;
+        FS_TRACE_INFO(("FS_FAT_ModuleInit(): Could not alloc mem for sec clr buf: %d octets req'd.\r\n", octets_reqd));
+        return;
+    }
+
+    Mem_Clr((void     *)FS_FAT_SecClrBufPtr,                    /* See Note #1.                                         */
+            (CPU_SIZE_T)FS_FAT_CFG_SEC_CLR_BUF_SIZE);
+#endif
+
+
+
                                                                 /* --------------- INIT FAT FILE MODULE --------------- */
     FS_FAT_FileModuleInit(file_cnt,
                           p_err);
@@ -2152,7 +2671,13 @@ void  FS_FAT_ModuleInit (FS_QTY   vol_cnt,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The file system lock MUST be held to release the FAT data back to the FAT data pool.
+* Note(s)     : (1) The file system lock 'FS_OS_LOCK_ID_VOL' MUST be held to release the FAT data back
+*                   to the FAT data pool.
+*
+*               (2) Operations pending in a journal transaction are committed, unless the device changed.
+*                   Otherwise, they would be reverted when the volume is next mounted.
+*
+*               (3) The volume is marked clean, unless the device changed (see 'FS_FAT_VolSync()  Note #2').
 *********************************************************************************************************
 */
 
@@ -2163,6 +2688,20 @@ void  FS_FAT_VolClose (FS_VOL  *p_vol)
     LIB_ERR       pool_err;
 
 
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)                   /* ---------------- COMMIT JOURNAL TX ----------------- */
+    if (p_vol->RefreshCnt == p_vol->DevPtr->RefreshCnt) {       /* See Note #2.                                         */
+        FS_FAT_JournalTxFlush(p_vol, &err);
+        (void)err;                                             /* Vol closed regardless.                               */
+    }
+#endif
+
+#if ((FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED) && (FS_CFG_RD_ONLY_EN == DEF_DISABLED))
+    if (p_vol->RefreshCnt == p_vol->DevPtr->RefreshCnt) {       /* ------------ MARK VOL CLEAN (see Note #3) ---------- */
+        FS_FAT_VolDirtyClr(p_vol, &err);
+        (void)err;                                             /* Vol closed regardless.                               */
+    }
+#endif
+
                                                                 /* ----------------- FREE JOURNAL DATA ---------------- */
 #ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
     FS_FAT_JournalExit(p_vol, &err);                            /* Free journal data.                                   */
@@ -2176,7 +2715,7 @@ void  FS_FAT_VolClose (FS_VOL  *p_vol)
                                                                 /* ------------------- FREE FAT DATA ------------------ */
     p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
 
-    FS_OS_Lock(&err);                                           /* Acquire FS lock (see Note #1).                       */
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, &err);                        /* Acquire FS lock (see Note #1).                       */
     if (err != FS_ERR_NONE) {
         return;
     }
@@ -2184,7 +2723,7 @@ void  FS_FAT_VolClose (FS_VOL  *p_vol)
     Mem_PoolBlkFree(        &FS_FAT_DataPool,                   /* Free FAT data.                                       */
                     (void *) p_fat_data,
                             &pool_err);
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
 
     if (pool_err != LIB_MEM_ERR_NONE) {
         CPU_SW_EXCEPTION(;);                                    /* Fatal err.                                           */
@@ -2194,6 +2733,36 @@ void  FS_FAT_VolClose (FS_VOL  *p_vol)
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FS_FAT_VolClusSizeGet()
+*
+* Description : Get cluster size of a volume.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : Cluster size, in octets, if volume has a FAT file system.
+*               0,                       otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+FS_SEC_SIZE  FS_FAT_VolClusSizeGet (FS_VOL  *p_vol)
+{
+    FS_FAT_DATA  *p_fat_data;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    if (p_fat_data == (FS_FAT_DATA *)0) {
+        return (0u);
+    }
+
+    return (p_fat_data->ClusSize_octet);
+}
+
+
 /*
 *********************************************************************************************************
 *                                           FS_FAT_VolFmt()
@@ -2360,6 +2929,19 @@ void  FS_FAT_VolClose (FS_VOL  *p_vol)
 *                   incorrectly modified.
 *
 *               (8) Avoid 'Excessive shift value' or 'Constant expression evaluates to 0' warning.
+*
+*               (9) The FATs & root directory are contiguous.  If the device can discard these sectors so
+*                   that they read back as zeros, they are not written; otherwise, they are cleared with
+*                   multi-sector writes (see 'FS_FAT_SecClr()  Note #1').
+*
+*              (10) If the device reports an erase block or allocation unit size :
+*
+*                   (a) The reserved area is extended so that the data area starts on a boundary (see
+*                       'FS_FAT_FmtAlign()').
+*
+*                   (b) The default cluster size is adjusted so that clusters do not straddle boundaries
+*                       (see 'FS_FAT_FmtAlignClus()').  A cluster size given in 'p_sys_cfg' is always used
+*                       as is, even if clusters then straddle boundaries.
 *********************************************************************************************************
 */
 
@@ -2384,6 +2966,12 @@ void  FS_FAT_VolFmt (FS_VOL       *p_vol,
     CPU_INT32U         val;
     FS_FAT_SEC_NBR     data_sec_start;
     CPU_INT32U         clus_number;
+    FS_FAT_SEC_NBR     root_clr_size;
+    CPU_BOOLEAN        sec_clr;
+#if (FS_FAT_CFG_FMT_ALIGN_EN == DEF_ENABLED)
+    FS_SEC_QTY         align_size;
+    FS_ERR             align_err;
+#endif
 #if (FS_CFG_PARTITION_EN == DEF_ENABLED)
     CPU_INT08U         partition_type;
     FS_ERR             err_tmp;
@@ -2505,6 +3093,15 @@ void  FS_FAT_VolFmt (FS_VOL       *p_vol,
     }
 
     root_dir_size = (((FS_FAT_SEC_NBR)sys_cfg.RootDirEntryCnt * FS_FAT_SIZE_DIR_ENTRY) + (sec_size - 1u)) / sec_size;
+
+#if (FS_FAT_CFG_FMT_ALIGN_EN == DEF_ENABLED)                    /* Get erase blk size (see Note #10).                   */
+    align_size = FSDev_AlignGetLocked(p_vol->DevPtr, &align_err);
+    if (p_sys_cfg == (FS_FAT_SYS_CFG *)0) {                     /* Align dflt clus size only (see Note #10b).           */
+        FS_FAT_FmtAlignClus(&sys_cfg,
+                             size,
+                             align_size);
+    }
+#endif
     if(size <= root_dir_size + sys_cfg.RsvdAreaSize) {
         FS_TRACE_DBG(("FS_FAT_VolFmt(): Invalid clus number.\r\n"));
        *p_err = FS_ERR_VOL_INVALID_SYS;
@@ -2527,6 +3124,14 @@ void  FS_FAT_VolFmt (FS_VOL       *p_vol,
                                                                                    FS_PARTITION_TYPE_FAT16_16_32MB;
 #endif
 
+#if (FS_FAT_CFG_FMT_ALIGN_EN == DEF_ENABLED)
+             FS_FAT_FmtAlign( p_vol,                            /* Align data area (see Note #10a).                     */
+                             &sys_cfg,
+                              (fat_size * sys_cfg.NbrFATs) + root_dir_size,
+                              size,
+                              align_size);
+#endif
+
                                                                 /* Calc start sec nbr's.                                */
              rsvd_sec_start     = 0u;
              fat1_sec_start     = rsvd_sec_start + sys_cfg.RsvdAreaSize;
@@ -2608,6 +3213,14 @@ void  FS_FAT_VolFmt (FS_VOL       *p_vol,
                                                                 /* FAT32 type                                           */
              partition_type     = FS_PARTITION_TYPE_FAT32_LBA;
 #endif
+#if (FS_FAT_CFG_FMT_ALIGN_EN == DEF_ENABLED)
+             FS_FAT_FmtAlign( p_vol,                            /* Align data area (see Note #10a).                     */
+                             &sys_cfg,
+                              (fat_size * sys_cfg.NbrFATs) + root_dir_size,
+                              size,
+                              align_size);
+#endif
+
                                                                 /* Calc start sec nbr's.                                */
              rsvd_sec_start     = 0u;
              fat1_sec_start     = rsvd_sec_start + sys_cfg.RsvdAreaSize;
@@ -2694,6 +3307,14 @@ void  FS_FAT_VolFmt (FS_VOL       *p_vol,
              partition_type     = FS_PARTITION_TYPE_FAT12_CHS;
 #endif
 
+#if (FS_FAT_CFG_FMT_ALIGN_EN == DEF_ENABLED)
+             FS_FAT_FmtAlign( p_vol,                            /* Align data area (see Note #10a).                     */
+                             &sys_cfg,
+                              (fat_size * sys_cfg.NbrFATs) + root_dir_size,
+                              size,
+                              align_size);
+#endif
+
                                                                 /* Calc start sec nbr's.                                */
              rsvd_sec_start     = 0u;
              fat1_sec_start     = rsvd_sec_start + sys_cfg.RsvdAreaSize;
@@ -2760,10 +3381,39 @@ void  FS_FAT_VolFmt (FS_VOL       *p_vol,
              return;
     }
 
+                                                                /* ------------- DISCARD FATs & ROOT DIR -------------- */
+    if (sys_cfg.FAT_Type == FS_FAT_FAT_TYPE_FAT32) {
+        root_clr_size = sys_cfg.ClusSize;                       /* Root dir clus.                                       */
+    } else {
+        root_clr_size = root_dir_size;
+    }
+
+    FSVol_DiscardLocked(              p_vol,                    /* See Note #9.                                         */
+                        (FS_SEC_NBR)  fat1_sec_start,
+                        (FS_SEC_QTY)((root_dir_sec_start - fat1_sec_start) + root_clr_size),
+                                      p_err);
+    switch (*p_err) {
+        case FS_ERR_NONE:                                       /* Secs rd back as zeros, no clr needed.                */
+             sec_clr = DEF_NO;
+             break;
+
+
+        case FS_ERR_DEV_INVALID_IO_CTRL:                        /* Discard not supported, clr secs.                     */
+             sec_clr = DEF_YES;
+             break;
+
+
+        default:
+            *p_err = FS_ERR_DEV;
+             FSBuf_Free(p_buf);
+             return;
+    }
+
                                                                 /* --------------------- CLR FATs --------------------- */
     fat_ix      = 0u;
     fat_sec_cur = fat1_sec_start;
-    while (fat_ix < sys_cfg.NbrFATs) {                          /* Clr each FAT.                                        */
+    while ((sec_clr == DEF_YES) &&                              /* Clr each FAT.                                        */
+           (fat_ix  <  sys_cfg.NbrFATs)) {
         FS_FAT_SecClr(p_vol,
                       p_buf->DataPtr,
                       fat_sec_cur,
@@ -2784,6 +3434,7 @@ void  FS_FAT_VolFmt (FS_VOL       *p_vol,
 
 
                                                                 /* ----------------- WR FIRST FAT SEC ----------------- */
+    Mem_Clr(p_buf->DataPtr, (CPU_SIZE_T)sec_size);
     switch (sys_cfg.FAT_Type) {                                 /* Set first entries of FAT.                            */
         case FS_FAT_FAT_TYPE_FAT12:
              val = 0x00FF8F00u | FS_FAT_BPB_MEDIA_FIXED;        /* See Note #8.                                         */
@@ -2875,28 +3526,20 @@ void  FS_FAT_VolFmt (FS_VOL       *p_vol,
 #endif
 
                                                                 /* ------------------- CLR ROOT DIR ------------------- */
-    if (sys_cfg.FAT_Type == FS_FAT_FAT_TYPE_FAT32) {
-        FS_FAT_SecClr(p_vol,                                    /* Clr root dir clus.                                   */
-                      p_buf->DataPtr,
-                      root_dir_sec_start,
-                      sys_cfg.ClusSize,
-                      sec_size,
-                      FS_VOL_SEC_TYPE_DIR,
-                      p_err);
-    } else {
-        FS_FAT_SecClr(p_vol,                                    /* Clr root dir.                                        */
+    if (sec_clr == DEF_YES) {
+        FS_FAT_SecClr(p_vol,                                    /* Clr root dir (clus).                                 */
                       p_buf->DataPtr,
                       root_dir_sec_start,
-                      root_dir_size,
+                      root_clr_size,
                       sec_size,
                       FS_VOL_SEC_TYPE_DIR,
                       p_err);
-    }
 
-    if (*p_err != FS_ERR_NONE) {
-        *p_err  = FS_ERR_DEV;
-         FSBuf_Free(p_buf);
-         return;
+        if (*p_err != FS_ERR_NONE) {
+            *p_err  = FS_ERR_DEV;
+             FSBuf_Free(p_buf);
+             return;
+        }
     }
 
     FSBuf_Flush(p_buf, p_err);
@@ -3040,7 +3683,11 @@ void  FS_FAT_VolLabelSet (FS_VOL    *p_vol,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The file system lock MUST be held to get the FAT data from the FAT data pool.
+* Note(s)     : (1) The file system lock 'FS_OS_LOCK_ID_VOL' MUST be held to get the FAT data from the
+*                   FAT data pool.
+*
+*               (2) The clean shutdown bit is read before the journal is opened, since the first write to
+*                   the volume clears it (see 'FS_FAT_VolDirtyGet()').
 *********************************************************************************************************
 */
 
@@ -3090,7 +3737,7 @@ void  FS_FAT_VolOpen (FS_VOL  *p_vol,
     }
 
                                                                 /* ------------------ ALLOC FAT DATA ------------------ */
-    FS_OS_Lock(p_err);                                          /* Acquire FS lock (see Note #1).                       */
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);                       /* Acquire FS lock (see Note #1).                       */
     if (*p_err != FS_ERR_NONE) {
         FSBuf_Free(p_buf);
         return;
@@ -3100,7 +3747,7 @@ void  FS_FAT_VolOpen (FS_VOL  *p_vol,
                                                 sizeof(FS_FAT_DATA),
                                                &pool_err);
     (void)pool_err;                                            /* Err ignored. Ret val chk'd instead.                  */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
 
     if (p_fat_data == (FS_FAT_DATA *)0) {
         FSBuf_Free(p_buf);
@@ -3117,26 +3764,40 @@ void  FS_FAT_VolOpen (FS_VOL  *p_vol,
     FSBuf_Free(p_buf);
 
     if (*p_err != FS_ERR_NONE) {                                /* If fat param's NOT valid ...                         */
-        FS_OS_Lock(&err_tmp);
+        FS_OS_Lock(FS_OS_LOCK_ID_VOL, &err_tmp);
         Mem_PoolBlkFree(        &FS_FAT_DataPool,               /* ... free FAT data        ...                         */
                         (void *) p_fat_data,
                                 &pool_err);
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
         return;                                                 /* ... & rtn.                                           */
     }
 
                                                                 /* ------------------ ALLOC FAT DATA ------------------ */
     p_vol->DataPtr = (void *)p_fat_data;                        /* Save FAT data in vol.                                */
 
+#if (FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED)
+    FS_FAT_VolDirtyRd(p_vol, p_err);                            /* Rd clean shutdown bit (see Note #2).                 */
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_OS_Lock(FS_OS_LOCK_ID_VOL, &err_tmp);
+        Mem_PoolBlkFree(        &FS_FAT_DataPool,               /* ... & free FAT data.                                 */
+                        (void *) p_fat_data,
+                                &pool_err);
+        FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
+        p_vol->DataPtr = (void *)0;
+        return;
+    }
+#endif
+
 #ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
     FS_FAT_JournalInit(p_vol, p_err);                           /* Init journal info.                                   */
 
     if (*p_err != FS_ERR_NONE) {
-        FS_OS_Lock(&err_tmp);
+        FS_OS_Lock(FS_OS_LOCK_ID_VOL, &err_tmp);
         Mem_PoolBlkFree(        &FS_FAT_DataPool,               /* ... & free FAT data.                                 */
                         (void *) p_fat_data,
                                 &pool_err);
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
         p_vol->DataPtr = (void *)0;
         return;
     }
@@ -4355,98 +5016,364 @@ void  FS_FAT_LowEntryDel (FS_VOL            *p_vol,
 
 /*
 *********************************************************************************************************
-*                                       FS_FAT_LowEntryRename()
+*                                      FS_FAT_LowEntryDelTree()
 *
-* Description : Rename entry (low-level).
+* Description : Delete entry &, if entry is a directory, every entry in its tree (low-level).
 *
-* Argument(s) : p_vol               Pointer to volume.
-*               ----------          Argument validated by caller.
+* Argument(s) : p_vol           Pointer to volume.
+*               ----------      Argument validated by caller.
 *
-*               p_buf               Pointer to temporary buffer.
-*               ----------          Argument validated by caller.
+*               p_entry_data    Pointer to FAT file information of the entry.
+*               ----------      Argument validated by caller.
 *
-*               p_entry_data_old    Pointer to FAT entry information for the old entry.
-*               ----------          Argument validated by caller.
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               ----------      Argument validated by caller.
 *
-*               p_entry_data_new    Pointer to FAT entry information for the new entry.
-*               ----------          Argument validated by caller.
+*                                   FS_ERR_NONE              Entry tree deleted.
+*                                   FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                                   FS_ERR_DEV               Device access error.
+*                                   FS_ERR_ENTRY_CORRUPT     File system entry is corrupt.
+*                                   FS_ERR_ENTRY_OPEN        Open entry found in tree.
 *
-*               exists              Indicates whether entry exists with new name :
+* Return(s)   : none.
 *
-*                                       DEF_NO,  entry with new name does NOT exist.
-*                                       DEF_YES, entry with new name does     exist.
+* Note(s)     : (1) The tree is walked once, depth first, without recursion or an explicit stack :
 *
-*               name_entry_new      New name of the entry.
-*               ----------          Argument validated by caller.
+*                   (a) Files are deleted as they are found.
 *
-*               p_err               Pointer to variable that will receive the return error code from this function :
-*               ----------          Argument validated by caller.
+*                   (b) When a sub-directory is found, its entries are deleted first.  Once it is
+*                       empty, the walk resumes in its parent; the emptied sub-directory is then deleted
+*                       when it is found again.
 *
-*                                       FS_ERR_NONE                 Entry renamed.
-*                                       FS_ERR_DEV                  Device access error.
-*                                       FS_ERR_DEV_FULL             Device is full (space could not be allocated).
-*                                       FS_ERR_DIR_FULL             Directory is full (space could not be allocated).
-*                                       FS_ERR_ENTRIES_TYPE_DIFF    Paths do not both specify files
-*                                                                       OR directories.
+*                   (c) The position of the entry of each sub-directory descended into, & the cluster of
+*                       its parent, are saved for the first FS_FAT_DEL_TREE_LVL_MAX levels of the tree.
+*                       The walk resumes in such a parent at the saved position.  Deeper in the tree, the
+*                       parent is found from the dot dot entry & is scanned again from the start.
 *
-* Return(s)   : none.
+*                   Since entries are only ever deleted, each directory sector is rewritten in place.
 *
-* Note(s)     : (1) If entry is a directory, a file with the directory name is created & then updated
-*                   with the attributes of a directory.
+*               (2) Two buffers are used so that directory sectors & FAT sectors stay buffered across
+*                   entries, so that the directory entries of a parent & the FAT entries of freed
+*                   cluster chains sharing a FAT sector are written once rather than once per entry.
+*
+*                   (a) If journaling is started, the journal is checkpointed once the entries of a
+*                       directory have been deleted, or earlier if half of the journal is used (see
+*                       'fs_fat_journal.c  FS_FAT_JournalCkptDue()').  The deletions of a directory's
+*                       entries thus form a single journal transaction.  Each entry deletion is
+*                       nevertheless either fully completed or not performed at all when the journal is
+*                       replayed (see 'fs_fat_journal.c  FS_FAT_JournalTxBegin()  Note #2').  An
+*                       interrupted tree deletion leaves a partially deleted, consistent tree.
+*
+*               (3) If an open file or directory is found in the tree, the walk stops; the entries
+*                   deleted before it remain deleted.
 *********************************************************************************************************
 */
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-void  FS_FAT_LowEntryRename (FS_VOL            *p_vol,
-                             FS_BUF            *p_buf,
-                             FS_FAT_FILE_DATA  *p_entry_data_old,
-                             FS_FAT_FILE_DATA  *p_entry_data_new,
-                             CPU_BOOLEAN        exists,
-                             CPU_CHAR          *name_entry_new,
-                             FS_ERR            *p_err)
+void  FS_FAT_LowEntryDelTree (FS_VOL            *p_vol,
+                              FS_FAT_FILE_DATA  *p_entry_data,
+                              FS_ERR            *p_err)
 {
-    FS_FAT_DIR_POS   dir_end_old;
-    FS_FAT_SEC_NBR   dir_first_sec;
-    FS_FAT_DIR_POS   dir_start_old;
-    FS_FAT_DIR_POS   dir_start_new;
-    FS_FAT_DIR_POS   dir_end_new;
-    FS_FAT_CLUS_NBR  target_entry_first_clus;
-    FS_FAT_DATA     *p_fat_data;
-
+    FS_FAT_DIR_POS     dir_end_pos;
+    FS_FAT_DIR_POS     dir_start_pos;
+    FS_FAT_CLUS_NBR    dir_clus;
+    FS_FAT_CLUS_NBR    dir_parent_clus;
+    FS_FAT_CLUS_NBR    dir_empty_clus;
+    FS_FAT_CLUS_NBR    entry_clus;
+    FS_FAT_DIR_POS     lvl_pos[FS_FAT_DEL_TREE_LVL_MAX];
+    FS_FAT_CLUS_NBR    lvl_clus[FS_FAT_DEL_TREE_LVL_MAX];
+    CPU_INT16U         lvl;
+    CPU_INT08U         attrib;
+    CPU_BOOLEAN        is_dir;
+    CPU_BOOLEAN        is_open;
+    CPU_BOOLEAN        descend;
+    CPU_BOOLEAN        done;
+    CPU_BOOLEAN        resume;
+    CPU_BOOLEAN        valid;
+    CPU_INT08U        *p_dir_entry;
+    FS_BUF            *p_buf_dir;
+    FS_BUF            *p_buf_fat;
+    FS_FAT_DATA       *p_fat_data;
+    FS_ERR             err;
 
-    p_fat_data = (FS_FAT_DATA  *)p_vol->DataPtr;
 
-                                                                /* ------------ REM TARGET ENTRY IF NEEDED ------------ */
-    if (exists == DEF_YES) {
-        target_entry_first_clus = p_entry_data_new->FileFirstClus;
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
 
-        dir_start_new.SecNbr    = p_entry_data_new->DirStartSec;
-        dir_start_new.SecPos    = p_entry_data_new->DirStartSecPos;
-        dir_end_new.SecNbr      = p_entry_data_new->DirEndSec;
-        dir_end_new.SecPos      = p_entry_data_new->DirEndSecPos;
+                                                                /* --------------------- GET BUFS --------------------- */
+    p_buf_dir = FSBuf_Get(p_vol);
+    if (p_buf_dir == (FS_BUF *)0) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
 
-        FS_FAT_FN_API_Active.DirEntryDel(p_vol,
-                                         p_buf,
-                                        &dir_start_new,
-                                        &dir_end_new,
-                                         p_err);
-        if (*p_err != FS_ERR_NONE) {
-            return;
-        }
-    } else {
-        target_entry_first_clus = 0u;
+    p_buf_fat = FSBuf_Get(p_vol);                               /* See Note #2.                                         */
+    if (p_buf_fat == (FS_BUF *)0) {                             /* Share dir buf if no other buf avail.                 */
+        p_buf_fat = p_buf_dir;
     }
 
 
-                                                                /* ----------------- CREATE NEW ENTRY ----------------- */
-    dir_first_sec = p_entry_data_new->DirFirstSec;
+                                                                /* ------------------- DEL DIR TREE ------------------- */
+   *p_err           = FS_ERR_NONE;
+    is_dir          = DEF_BIT_IS_SET(p_entry_data->Attrib, FS_FAT_DIRENT_ATTR_DIRECTORY);
+    done            = (is_dir == DEF_YES) ? DEF_NO : DEF_YES;
+    dir_clus        = p_entry_data->FileFirstClus;
+    dir_parent_clus = 0u;
+    dir_empty_clus  = 0u;
+    lvl             = 0u;
+    resume          = DEF_NO;
 
-    FS_FAT_LowEntryCreate(p_vol,
-                          p_buf,
-                          p_entry_data_new,
-                          name_entry_new,
-                          dir_first_sec,
-                          DEF_NO,
+    while (done == DEF_NO) {                                    /* See Note #1.                                         */
+        valid = FS_FAT_IS_VALID_CLUS(p_fat_data, dir_clus);
+        if (valid == DEF_NO) {
+            FS_TRACE_DBG(("FS_FAT_LowEntryDelTree(): Invalid dir clus: %d\n", dir_clus));
+           *p_err = FS_ERR_ENTRY_CORRUPT;
+            break;
+        }
+
+        if (resume == DEF_NO) {                                 /* Scan dir from start ...                              */
+            dir_start_pos.SecNbr = FS_FAT_CLUS_TO_SEC(p_fat_data, dir_clus);
+            dir_start_pos.SecPos = 0u;
+            dir_parent_clus      = 0u;
+        }                                                       /* ... or from saved pos (see Note #1c).                */
+        resume  = DEF_NO;
+        descend = DEF_NO;
+
+        while ((*p_err  == FS_ERR_NONE) &&
+               (descend == DEF_NO)) {
+            FS_FAT_FN_API_Active.NextDirEntryGet(        p_vol,
+                                                         p_buf_dir,
+                                                 (void *)0,
+                                                        &dir_start_pos,
+                                                        &dir_end_pos,
+                                                         p_err);
+            if (*p_err != FS_ERR_NONE) {
+                break;
+            }
+
+            p_dir_entry = (CPU_INT08U *)p_buf_dir->DataPtr + dir_end_pos.SecPos;
+            attrib      =  MEM_VAL_GET_INT08U_LITTLE((void *)(p_dir_entry + FS_FAT_DIRENT_OFF_ATTR));
+            is_dir      =  DEF_BIT_IS_SET(attrib, FS_FAT_DIRENT_ATTR_DIRECTORY);
+            entry_clus  =  FS_FAT_DIRENT_CLUS_NBR_GET(p_dir_entry);
+            if ((p_fat_data->FAT_Type == 12u) ||
+                (p_fat_data->FAT_Type == 16u)) {
+                entry_clus &= DEF_INT_16U_MAX_VAL;              /* Discard FstCluHI on FAT12/16 vol.                    */
+            }
+
+            if (p_dir_entry[0] == (CPU_INT08U)ASCII_CHAR_FULL_STOP) {
+                if (p_dir_entry[1] == (CPU_INT08U)ASCII_CHAR_FULL_STOP) {
+                    dir_parent_clus = entry_clus;               /* Dot dot entry holds parent dir clus (see Note #1b).  */
+                }
+
+            } else if ((is_dir     == DEF_YES) &&
+                       (entry_clus != dir_empty_clus)) {
+                                                                /* Descend into non-empty sub-dir.                      */
+#ifdef  FS_DIR_MODULE_PRESENT
+                is_open = FSDir_IsOpenAt(p_vol, entry_clus);
+                if (is_open == DEF_YES) {
+                    FS_TRACE_DBG(("FS_FAT_LowEntryDelTree(): Dir open in tree.\r\n"));
+                   *p_err = FS_ERR_ENTRY_OPEN;
+                    break;
+                }
+#endif
+                if (lvl < FS_FAT_DEL_TREE_LVL_MAX) {            /* Save pos of sub-dir entry (see Note #1c).            */
+                    lvl_clus[lvl]        = dir_clus;
+                    lvl_pos[lvl].SecNbr  = dir_start_pos.SecNbr;
+                    lvl_pos[lvl].SecPos  = dir_start_pos.SecPos;
+                }
+                lvl++;
+                dir_clus = entry_clus;
+                descend  = DEF_YES;
+
+            } else {
+                if (is_dir == DEF_NO) {                         /* Del file (see Note #1a) ...                          */
+                    is_open = FSFile_IsOpenAt(p_vol, dir_end_pos.SecNbr, dir_end_pos.SecPos);
+                    if (is_open == DEF_YES) {
+                        FS_TRACE_DBG(("FS_FAT_LowEntryDelTree(): File open in tree.\r\n"));
+                       *p_err = FS_ERR_ENTRY_OPEN;
+                        break;
+                    }
+                } else {                                        /* ... or emptied sub-dir (see Note #1b).               */
+                    dir_empty_clus = 0u;
+                }
+
+                FS_FAT_LowTreeEntryDel( p_vol,
+                                        p_buf_dir,
+                                        p_buf_fat,
+                                       &dir_start_pos,
+                                       &dir_end_pos,
+                                        entry_clus,
+                                        p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    break;
+                }
+            }
+
+            dir_start_pos.SecNbr = dir_end_pos.SecNbr;          /* Continue srch after SFN entry.                       */
+            dir_start_pos.SecPos = dir_end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
+        }
+
+        if (*p_err == FS_ERR_EOF) {                             /* Dir is empty.                                        */
+           *p_err = FS_ERR_NONE;
+            if (lvl == 0u) {
+                done = DEF_YES;
+
+            } else {
+                FS_FAT_LowTreeCkpt(p_vol,                       /* Commit dir's entry deletions (see Note #2a).         */
+                                   p_buf_dir,
+                                   p_buf_fat,
+                                   p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    break;
+                }
+                                                                /* Resume walk in parent dir (see Note #1b).            */
+                lvl--;
+                dir_empty_clus = dir_clus;
+                if (lvl < FS_FAT_DEL_TREE_LVL_MAX) {
+                    dir_clus             = lvl_clus[lvl];
+                    dir_start_pos.SecNbr = lvl_pos[lvl].SecNbr;
+                    dir_start_pos.SecPos = lvl_pos[lvl].SecPos;
+                    resume               = DEF_YES;
+                } else {
+                    dir_clus             = dir_parent_clus;
+                }
+            }
+        } else if (*p_err != FS_ERR_NONE) {
+            done = DEF_YES;
+        } else {
+            ;
+        }
+    }
+
+
+                                                                /* --------------------- DEL ENTRY -------------------- */
+    if (*p_err == FS_ERR_NONE) {
+        dir_start_pos.SecNbr = p_entry_data->DirStartSec;
+        dir_start_pos.SecPos = p_entry_data->DirStartSecPos;
+        dir_end_pos.SecNbr   = p_entry_data->DirEndSec;
+        dir_end_pos.SecPos   = p_entry_data->DirEndSecPos;
+
+        FS_FAT_LowTreeEntryDel( p_vol,
+                                p_buf_dir,
+                                p_buf_fat,
+                               &dir_start_pos,
+                               &dir_end_pos,
+                                p_entry_data->FileFirstClus,
+                                p_err);
+    }
+
+
+                                                                /* -------------------- FREE BUFS --------------------- */
+    if (p_buf_fat != p_buf_dir) {
+        FSBuf_Flush(p_buf_fat, &err);
+        if (*p_err == FS_ERR_NONE) {
+           *p_err = err;
+        }
+        FSBuf_Free(p_buf_fat);
+    }
+
+    FSBuf_Flush(p_buf_dir, &err);
+    if (*p_err == FS_ERR_NONE) {
+       *p_err = err;
+    }
+    FSBuf_Free(p_buf_dir);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_LowEntryRename()
+*
+* Description : Rename entry (low-level).
+*
+* Argument(s) : p_vol               Pointer to volume.
+*               ----------          Argument validated by caller.
+*
+*               p_buf               Pointer to temporary buffer.
+*               ----------          Argument validated by caller.
+*
+*               p_entry_data_old    Pointer to FAT entry information for the old entry.
+*               ----------          Argument validated by caller.
+*
+*               p_entry_data_new    Pointer to FAT entry information for the new entry.
+*               ----------          Argument validated by caller.
+*
+*               exists              Indicates whether entry exists with new name :
+*
+*                                       DEF_NO,  entry with new name does NOT exist.
+*                                       DEF_YES, entry with new name does     exist.
+*
+*               name_entry_new      New name of the entry.
+*               ----------          Argument validated by caller.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*               ----------          Argument validated by caller.
+*
+*                                       FS_ERR_NONE                 Entry renamed.
+*                                       FS_ERR_DEV                  Device access error.
+*                                       FS_ERR_DEV_FULL             Device is full (space could not be allocated).
+*                                       FS_ERR_DIR_FULL             Directory is full (space could not be allocated).
+*                                       FS_ERR_ENTRIES_TYPE_DIFF    Paths do not both specify files
+*                                                                       OR directories.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) If entry is a directory, a file with the directory name is created & then updated
+*                   with the attributes of a directory.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FS_FAT_LowEntryRename (FS_VOL            *p_vol,
+                             FS_BUF            *p_buf,
+                             FS_FAT_FILE_DATA  *p_entry_data_old,
+                             FS_FAT_FILE_DATA  *p_entry_data_new,
+                             CPU_BOOLEAN        exists,
+                             CPU_CHAR          *name_entry_new,
+                             FS_ERR            *p_err)
+{
+    FS_FAT_DIR_POS   dir_end_old;
+    FS_FAT_SEC_NBR   dir_first_sec;
+    FS_FAT_DIR_POS   dir_start_old;
+    FS_FAT_DIR_POS   dir_start_new;
+    FS_FAT_DIR_POS   dir_end_new;
+    FS_FAT_CLUS_NBR  target_entry_first_clus;
+    FS_FAT_DATA     *p_fat_data;
+
+
+    p_fat_data = (FS_FAT_DATA  *)p_vol->DataPtr;
+
+                                                                /* ------------ REM TARGET ENTRY IF NEEDED ------------ */
+    if (exists == DEF_YES) {
+        target_entry_first_clus = p_entry_data_new->FileFirstClus;
+
+        dir_start_new.SecNbr    = p_entry_data_new->DirStartSec;
+        dir_start_new.SecPos    = p_entry_data_new->DirStartSecPos;
+        dir_end_new.SecNbr      = p_entry_data_new->DirEndSec;
+        dir_end_new.SecPos      = p_entry_data_new->DirEndSecPos;
+
+        FS_FAT_FN_API_Active.DirEntryDel(p_vol,
+                                         p_buf,
+                                        &dir_start_new,
+                                        &dir_end_new,
+                                         p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+    } else {
+        target_entry_first_clus = 0u;
+    }
+
+
+                                                                /* ----------------- CREATE NEW ENTRY ----------------- */
+    dir_first_sec = p_entry_data_new->DirFirstSec;
+
+    FS_FAT_LowEntryCreate(p_vol,
+                          p_buf,
+                          p_entry_data_new,
+                          name_entry_new,
+                          dir_first_sec,
+                          DEF_NO,
                           p_err);
     if (*p_err != FS_ERR_NONE) {                                /* If entry could not be created ...                    */
         return;                                                 /* ... rtn err.                                         */
@@ -4844,7 +5771,11 @@ void  FS_FAT_DateTimeParse (CLK_TS_SEC   *p_ts,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) If the shared sector clear buffer holds more sectors than the temporary buffer, the
+*                   sectors are cleared from it with multi-sector writes (see 'fs_cfg.h  FAT SYSTEM
+*                   CONFIGURATION  Note #13').
+*
+*               (2) The temporary buffer is cleared in any case; callers rely on it being zeroed on return.
 *********************************************************************************************************
 */
 
@@ -4857,21 +5788,31 @@ void  FS_FAT_SecClr (FS_VOL          *p_vol,
                      FS_FLAGS         sec_type,
                      FS_ERR          *p_err)
 {
-    FS_FAT_SEC_NBR  cnt_rem;
-    FS_FAT_SEC_NBR  cnt_clr;
-    FS_FAT_SEC_NBR  sec_per_buf;
+    FS_FAT_SEC_NBR   cnt_rem;
+    FS_FAT_SEC_NBR   cnt_clr;
+    FS_FAT_SEC_NBR   sec_per_buf;
+    void            *p_src;
 
 
-    Mem_Clr(p_temp, FS_MaxSecSizeGet());
+    Mem_Clr(p_temp, FS_MaxSecSizeGet());                        /* See Note #2.                                         */
 
     cnt_rem     = cnt;
+    p_src       = p_temp;
     sec_per_buf = FS_MaxSecSizeGet() / sec_size;
 
+#if (FS_FAT_CFG_SEC_CLR_BUF_SIZE > 0u)
+                                                                /* Clr from shared zero buf (see Note #1).              */
+    if ((FS_FAT_CFG_SEC_CLR_BUF_SIZE / sec_size) > sec_per_buf) {
+        p_src       = (void *)FS_FAT_SecClrBufPtr;
+        sec_per_buf = FS_FAT_CFG_SEC_CLR_BUF_SIZE / sec_size;
+    }
+#endif
+
     while (cnt_rem > 0u) {
         cnt_clr = (cnt_rem > sec_per_buf) ? sec_per_buf : cnt_rem;
 
         FSVol_WrLockedEx(            p_vol,
-                                     p_temp,
+                                     p_src,
                          (FS_SEC_NBR)start,
                          (FS_SEC_QTY)cnt_clr,
                                      sec_type,
@@ -5194,128 +6135,892 @@ static  void  FS_FAT_ChkBootSec (FS_FAT_DATA  *p_fat_data,
              p_fat_data->ClusSizeLog2_octet = FSUtil_Log2(clus_size_octet);
              break;
 
-        default:
-             FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid bytes/clus: %d\n", clus_size_octet));
-            *p_err = FS_ERR_VOL_INVALID_SYS;
-             return;
-    }
+        default:
+             FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid bytes/clus: %d\n", clus_size_octet));
+            *p_err = FS_ERR_VOL_INVALID_SYS;
+             return;
+    }
+
+    p_fat_data->NbrFATs = MEM_VAL_GET_INT08U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_NUMFATS));
+    switch (p_fat_data->NbrFATs) {
+        case 1:
+        case 2:
+             break;
+
+        default:
+             FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid nbr FATs: %d\n", p_fat_data->NbrFATs));
+            *p_err = FS_ERR_VOL_INVALID_SYS;
+             return;
+    }
+                                                                /* Size of reserved area.                               */
+    p_fat_data->RsvdSize    = (FS_FAT_SEC_NBR)MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_RSVDSECCNT));
+    p_fat_data->FAT1_Start  =  p_fat_data->RsvdSize;            /* Sec nbr of 1st FAT.                                  */
+
+                                                                /* Size of each FAT.                                    */
+    fat_size                = (FS_FAT_SEC_NBR)MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_FATSZ16));
+    if (fat_size           ==  0u) {
+        fat_size            = (FS_FAT_SEC_NBR)MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_FAT32_OFF_FATSZ32));
+    }
+    p_fat_data->FAT_Size    =  fat_size;
+
+                                                                /* Size of root dir (see Notes #2b).                    */
+    root_cnt                =  MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_ROOTENTCNT));
+    p_fat_data->RootDirSize =  FS_UTIL_DIV_PWR2((((FS_FAT_SEC_NBR)root_cnt * 32u) + ((FS_FAT_SEC_NBR)p_fat_data->SecSize - 1u)), p_fat_data->SecSizeLog2);
+
+                                                                /* Sec nbr's of 2nd FAT, root dir, data.                */
+    if (p_fat_data->NbrFATs      == 2u) {
+        p_fat_data->FAT2_Start   =  p_fat_data->RsvdSize +  p_fat_data->FAT_Size;
+        p_fat_data->RootDirStart =  p_fat_data->RsvdSize + (p_fat_data->FAT_Size * 2u);
+        p_fat_data->DataStart    =  p_fat_data->RsvdSize + (p_fat_data->FAT_Size * 2u) + p_fat_data->RootDirSize;
+    } else {
+        p_fat_data->FAT2_Start   =  0u;
+        p_fat_data->RootDirStart =  p_fat_data->RsvdSize + (p_fat_data->FAT_Size * 1u);
+        p_fat_data->DataStart    =  p_fat_data->RsvdSize + (p_fat_data->FAT_Size * 1u) + p_fat_data->RootDirSize;
+    }
+
+                                                                /* Size of vol (see Notes #2a).                         */
+    vol_size                = (CPU_INT32U)MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_TOTSEC16));
+    if (vol_size           == 0u) {
+        vol_size            = MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_TOTSEC32));
+    }
+    p_fat_data->VolSize     = vol_size;
+
+                                                                /* Size of data area (see Notes #2c).                   */
+    p_fat_data->DataSize    = (p_fat_data->VolSize - (p_fat_data->RsvdSize + ((FS_FAT_SEC_NBR)p_fat_data->NbrFATs * p_fat_data->FAT_Size))) - p_fat_data->RootDirSize;
+    p_fat_data->NextClusNbr =  2u;                              /* Next clus to alloc.                                  */
+                                                                /* See Notes #2c3.                                      */
+    clus_cnt                =  (FS_FAT_CLUS_NBR)FS_UTIL_DIV_PWR2(p_fat_data->DataSize, p_fat_data->ClusSizeLog2_sec);
+
+
+
+                                                                /* --------------------- CHK FAT12 -------------------- */
+    if (clus_cnt                   <=  FS_FAT_MAX_NBR_CLUS_FAT12) {
+#if (FS_FAT_CFG_FAT12_EN == DEF_ENABLED)
+        p_fat_data->FAT_Type        =  FS_FAT_FAT_TYPE_FAT12;
+        p_fat_data->FAT_TypeAPI_Ptr = &FS_FAT_FAT12_API;
+        clus_cnt_max_fat            = ((FS_FAT_CLUS_NBR)p_fat_data->FAT_Size * (FS_FAT_CLUS_NBR)p_fat_data->SecSize * 2u) / 3u;
+        p_fat_data->MaxClusNbr      =  DEF_MIN(clus_cnt + FS_FAT_MIN_CLUS_NBR, clus_cnt_max_fat + FS_FAT_MIN_CLUS_NBR);
+#else
+        FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid file sys: FAT12\n"));
+       *p_err = FS_ERR_VOL_INVALID_SYS;
+        return;
+#endif
+
+
+                                                                /* --------------------- CHK FAT16 -------------------- */
+    } else if (clus_cnt            <=  FS_FAT_MAX_NBR_CLUS_FAT16) {
+#if (FS_FAT_CFG_FAT16_EN == DEF_ENABLED)
+        p_fat_data->FAT_Type        =  FS_FAT_FAT_TYPE_FAT16;
+        p_fat_data->FAT_TypeAPI_Ptr = &FS_FAT_FAT16_API;
+        clus_cnt_max_fat            = (FS_FAT_CLUS_NBR)p_fat_data->FAT_Size * ((FS_FAT_CLUS_NBR)p_fat_data->SecSize / FS_FAT_FAT16_ENTRY_NBR_OCTETS);
+        p_fat_data->MaxClusNbr      =  DEF_MIN(clus_cnt + FS_FAT_MIN_CLUS_NBR, clus_cnt_max_fat + FS_FAT_MIN_CLUS_NBR);
+#else
+        FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid file sys: FAT16\n"));
+       *p_err = FS_ERR_VOL_INVALID_SYS;
+        return;
+#endif
+
+
+                                                                /* --------------------- CHK FAT32 -------------------- */
+    } else {
+#if (FS_FAT_CFG_FAT32_EN == DEF_ENABLED)
+        p_fat_data->FAT_Type        =  FS_FAT_FAT_TYPE_FAT32;
+        p_fat_data->FAT_TypeAPI_Ptr = &FS_FAT_FAT32_API;
+        clus_cnt_max_fat            = (FS_FAT_CLUS_NBR)p_fat_data->FAT_Size * ((FS_FAT_CLUS_NBR)p_fat_data->SecSize / FS_FAT_FAT32_ENTRY_NBR_OCTETS);
+        p_fat_data->MaxClusNbr      = DEF_MIN(clus_cnt + FS_FAT_MIN_CLUS_NBR, clus_cnt_max_fat + FS_FAT_MIN_CLUS_NBR);
+
+                                                                /* Get root dir clus nbr.                               */
+        clus_nbr                    = MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_FAT32_OFF_ROOTCLUS));
+        valid                       = FS_FAT_IS_VALID_CLUS(p_fat_data, clus_nbr);
+        if (valid == DEF_NO) {
+            FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid FAT32 root dir clus: %d\n", clus_nbr));
+           *p_err = FS_ERR_VOL_INVALID_SYS;
+            return;
+        }
+        p_fat_data->RootDirStart     = FS_FAT_CLUS_TO_SEC(p_fat_data, clus_nbr);
+                                                                /* Get FSINFO sec nbr.                                  */
+        sec_nbr                      = MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_FAT32_OFF_FSINFO));
+        if (sec_nbr != 0u) {
+            p_fat_data->FS_InfoStart = (FS_FAT_SEC_NBR)sec_nbr;
+        }
+                                                                /* Get BKBOOT sec nbr.                                  */
+        sec_nbr                      = MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_FAT32_OFF_BKBOOTSEC));
+        if (sec_nbr != 0u) {
+            p_fat_data->BPB_BkStart  = (FS_FAT_SEC_NBR)sec_nbr;
+        }
+#else
+        FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid file sys: FAT32\n"));
+       *p_err = FS_ERR_VOL_INVALID_SYS;
+        return;
+#endif
+    }
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_FAT_VolChkWalk()
+*
+* Description : Walk the directory tree of a volume & check each file & directory.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               ----------  Argument validated by caller.
+*
+*               p_map       Pointer to cluster usage map, or DEF_NULL (see Note #2).
+*
+*               repair      Indicates whether errors should be repaired.
+*
+*               p_info      Pointer to structure that will receive the check results.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE              Directory tree walked.
+*                               FS_ERR_ENTRY_CORRUPT     Entry name could not be converted.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffers available.
+*                               FS_ERR_DEV               Device error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) (a) The "dot" entry should have ...
+*                       (1) ... a size of zero ...
+*                       (2) ... & the cluster number of the directory.
+*
+*                   (b) The "dot dot" entry should have ...
+*                       (1) ... a size of zero ...
+*                       (2) ... & the cluster number of the parent directory, if not in the root directory
+*                                        OR          of zero,                 if     in the root directory.
+*
+*               (2) (a) If no map is given, the cluster chain of each file & directory is followed &
+*                       checked (see 'FS_FAT_ChkFile()' & 'FS_FAT_ChkDir()').
+*
+*                   (b) If a map is given, the first cluster of each file & directory is claimed in the
+*                       map (see 'FS_FAT_VolChkMapEntry()').  A directory whose first cluster cannot be
+*                       claimed is not entered, so that a directory linked into its own subtree is not
+*                       walked forever.
+*
+*               (3) Directories nested deeper than FS_FAT_CFG_VOL_CHK_MAX_LEVELS are not entered.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_VOL_CHK_EN == DEF_ENABLED)
+static  void  FS_FAT_VolChkWalk (FS_VOL               *p_vol,
+                                 FS_BUF               *p_buf,
+                                 CPU_INT08U           *p_map,
+                                 CPU_BOOLEAN           repair,
+                                 FS_FAT_VOL_CHK_INFO  *p_info,
+                                 FS_ERR               *p_err)
+{
+    CPU_INT08U        *p_dir_entry;
+    FS_FAT_DATA       *p_fat_data;
+    CPU_BOOLEAN        dir;
+    FS_FAT_CLUS_NBR    dir_clus;
+    FS_FAT_CLUS_NBR    dir_clus_tmp;
+    CPU_BOOLEAN        done;
+    CPU_INT16S         dot;
+    CPU_INT16S         dot_dot;
+    CPU_INT08U         fat_attrib;
+    CPU_INT08U         i;
+    CPU_INT08U         level;
+    FS_FAT_DIR_POS     pos;
+    FS_FAT_DIR_POS     end_pos;
+    CPU_BOOLEAN        valid;
+    CPU_CHAR           name[FS_FAT_MAX_FILE_NAME_LEN + 1u];
+    FS_FAT_SEC_NBR     sec_nbr_stk[FS_FAT_CFG_VOL_CHK_MAX_LEVELS];
+    FS_SEC_SIZE        sec_pos_stk[FS_FAT_CFG_VOL_CHK_MAX_LEVELS];
+    FS_FAT_CLUS_NBR    dir_clus_stk[FS_FAT_CFG_VOL_CHK_MAX_LEVELS];
+    FS_FAT_FILE_DATA   fat_file_data;
+#if  defined(FS_FAT_LFN_MODULE_PRESENT) && \
+            (FS_CFG_UTF8_EN == DEF_ENABLED)
+    CPU_WCHAR          name_utf8[FS_FAT_MAX_FILE_NAME_LEN + 1u];
+    CPU_WCHAR         *p_name_utf8;
+    CPU_SIZE_T         len;
+#endif
+
+
+#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)
+    (void)repair;
+#endif
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    pos.SecNbr = p_fat_data->RootDirStart;                      /* Start in root dir.                                   */
+    pos.SecPos = 0u;
+    dir_clus   = 0u;
+    level      = 0u;
+    done       = DEF_NO;
+
+
+
+    while (done == DEF_NO) {
+                                                                /* ------------------ FIND DIR ENTRY ------------------ */
+#if  defined(FS_FAT_LFN_MODULE_PRESENT) && \
+            (FS_CFG_UTF8_EN == DEF_ENABLED)
+        FS_FAT_FN_API_Active.NextDirEntryGet(         p_vol,
+                                                      p_buf,
+                                             (void *)&name_utf8[0],
+                                                     &pos,
+                                                     &end_pos,
+                                                      p_err);
+
+        if (*p_err == FS_ERR_NONE) {                            /* Conversion from wide char to reg char                */
+            p_name_utf8 = &name_utf8[0];
+            len         = WC_StrToMB(             &name[0],
+                                                  &p_name_utf8,
+                                     (CPU_SIZE_T)  FS_FAT_MAX_FILE_NAME_LEN);
+
+            if (len == (CPU_SIZE_T)-1) {
+               *p_err = FS_ERR_ENTRY_CORRUPT;
+                return;
+            }
+        }
+#else
+        FS_FAT_FN_API_Active.NextDirEntryGet(         p_vol,
+                                                      p_buf,
+                                             (void *)&name[0],
+                                                     &pos,
+                                                     &end_pos,
+                                                      p_err);
+
+#endif
+
+
+
+        switch (*p_err) {
+            case FS_ERR_EOF:                                    /* ----------------- END OF DIRECTORY ----------------- */
+                 if (level == 0) {                              /* If in root dir ...                                   */
+                     done  = DEF_YES;                           /* ... no more entries to process.                      */
+                    *p_err = FS_ERR_NONE;                       /* Make sure No error is returned when no more entries  */
+
+                 } else {                                       /* Otherwise ...                                        */
+                     level--;                                   /* ... move to parent dir.                              */
+
+                     pos.SecNbr = sec_nbr_stk[level];
+                     pos.SecPos = sec_pos_stk[level];
+                     dir_clus   = dir_clus_stk[level];
+                 }
+                 break;
+
+
+
+
+            case FS_ERR_NONE:                                   /* ---------------- DIR ENTRY DIR FOUND --------------- */
+                 p_dir_entry = (CPU_INT08U *)p_buf->DataPtr + end_pos.SecPos;
+                 fat_attrib  = MEM_VAL_GET_INT08U_LITTLE(p_dir_entry + FS_FAT_DIRENT_OFF_ATTR);
+
+                 fat_file_data.DirStartSec    = pos.SecNbr;
+                 fat_file_data.DirStartSecPos = pos.SecPos;
+                 fat_file_data.DirEndSec      = end_pos.SecNbr;
+                 fat_file_data.DirEndSecPos   = end_pos.SecPos;
+                 fat_file_data.Attrib         = fat_attrib;
+                 fat_file_data.FileFirstClus  = FS_FAT_DIRENT_CLUS_NBR_GET(p_dir_entry);
+                 fat_file_data.FileSize       = MEM_VAL_GET_INT32U_LITTLE(p_dir_entry + FS_FAT_DIRENT_OFF_FILESIZE);
+
+                 dir = DEF_BIT_IS_SET(fat_attrib, FS_FAT_DIRENT_ATTR_DIRECTORY);
+                 if (dir == DEF_YES) {                          /* If dir ...                                           */
+                                                                /* ... srch files in dir.                               */
+                     FS_TRACE_DBG(("FS_FAT_VolChk(): Found dir  "));
+                     for (i = 0u; i < level; i++) {
+                         FS_TRACE_DBG(("  "));
+                     }
+                     FS_TRACE_DBG(("%s\r\n", name));
+
+                     dot = Str_Cmp_N(name, (CPU_CHAR *)".", FS_CFG_MAX_PATH_NAME_LEN);
+                     if (dot == 0) {                            /* "Dot" entry (see Note #1a).                         */
+                         dir_clus_tmp = fat_file_data.FileFirstClus;
+                         if (level == 0u) {
+                             FS_TRACE_INFO(("FS_FAT_VolChk(): \".\" entry in root dir.\r\n"));
+                         } else {
+                             if (dir_clus_tmp != dir_clus) {    /* If clus nbr bad ...                                  */
+                                 FS_TRACE_INFO(("FS_FAT_VolChk(): \".\" entry of dir in root dir with invalid clus nbr: %d (!= %d).\r\n", dir_clus_tmp, dir_clus));
+                                 p_info->EntryErrCnt++;
+
+                                                                /* ... correct clus nbr.                                */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+                                 if (repair == DEF_YES) {
+                                     fat_file_data.FileFirstClus = dir_clus;
+                                     fat_file_data.FileSize      = 0u;
+
+                                     FS_FAT_LowEntryUpdate( p_vol,
+                                                            p_buf,
+                                                           &fat_file_data,
+                                                            DEF_YES,
+                                                            p_err);
+                                     if (*p_err == FS_ERR_DEV) {
+                                         return;
+                                     }
+                                 }
+#endif
+                             }
+                         }
+
+                         pos.SecNbr = end_pos.SecNbr;           /* Move to next entry.                                  */
+                         pos.SecPos = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
+
+
+                     } else {
+                         dot_dot = Str_Cmp_N(name, (CPU_CHAR *)"..", FS_CFG_MAX_PATH_NAME_LEN);
+                         if (dot_dot == 0) {                    /* "Dot dot" entry (see Note #1b).                      */
+                             dir_clus_tmp = fat_file_data.FileFirstClus;
+                             if (level == 0u) {
+                                 FS_TRACE_INFO(("FS_FAT_VolChk(): \"..\" entry in root dir.\r\n"));
+                             } else {
+                                                                /* If clus nbr bad ...                                  */
+                                 if (dir_clus_tmp != dir_clus_stk[level - 1]) {
+                                     FS_TRACE_INFO(("FS_FAT_VolChk(): \"..\" entry of dir in root dir with invalid clus nbr: %d (!= %d).\r\n", dir_clus_tmp, dir_clus_stk[level - 1]));
+                                     p_info->EntryErrCnt++;
+
+                                                                /* ... correct clus nbr.                                */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+                                     if (repair == DEF_YES) {
+                                         fat_file_data.FileFirstClus = dir_clus_stk[level - 1u];
+                                         fat_file_data.FileSize      = 0u;
+
+                                         FS_FAT_LowEntryUpdate( p_vol,
+                                                                p_buf,
+                                                               &fat_file_data,
+                                                                DEF_YES,
+                                                                p_err);
+                                         if (*p_err == FS_ERR_DEV) {
+                                             return;
+                                         }
+                                     }
+#endif
+                                 }
+                             }
+
+                             pos.SecNbr = end_pos.SecNbr;       /* Move to next entry.                                  */
+                             pos.SecPos = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
+
+
+                         } else {                               /* Dir.                                                 */
+                             p_info->DirCnt++;
+                             if (level < FS_FAT_CFG_VOL_CHK_MAX_LEVELS) {
+                                 sec_nbr_stk[level]  = end_pos.SecNbr;
+                                 sec_pos_stk[level]  = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
+                                 dir_clus_stk[level] = dir_clus;
+
+                                 level++;
+
+                                 dir_clus            = fat_file_data.FileFirstClus;
+                                 pos.SecNbr          = FS_FAT_CLUS_TO_SEC(p_fat_data, dir_clus);
+                                 pos.SecPos          = 0u;
+
+                                 if (p_map == DEF_NULL) {
+                                     valid = FS_FAT_IS_VALID_CLUS(p_fat_data, dir_clus);
+                                     if (valid == DEF_NO) {     /* If clus not valid ...                                */
+                                         FS_TRACE_INFO(("FS_FAT_VolChk(): Dir clus nbr invalid.\r\n"));
+                                         p_info->EntryErrCnt++;
+
+                                                                /* ... clr clus nbr.                                    */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+                                         if (repair == DEF_YES) {
+                                             fat_file_data.FileFirstClus = 0u;
+                                             fat_file_data.FileSize      = 0u;
+
+                                             FS_FAT_LowEntryUpdate( p_vol,
+                                                                    p_buf,
+                                                                   &fat_file_data,
+                                                                    DEF_YES,
+                                                                    p_err);
+                                         }
+#endif
+                                     } else {                   /* Chk dir (see Note #2a).                              */
+                                         FS_FAT_ChkDir( p_vol,
+                                                       &fat_file_data,
+                                                        p_err);
+                                     }
+                                 } else {                       /* Claim dir clus (see Note #2b).                       */
+                                     valid = FS_FAT_VolChkMapEntry( p_vol,
+                                                                    p_buf,
+                                                                    p_map,
+                                                                   &fat_file_data,
+                                                                    DEF_YES,
+                                                                    repair,
+                                                                    p_info,
+                                                                    p_err);
+                                 }
+                                 if (*p_err == FS_ERR_DEV) {
+                                     return;
+                                 }
+
+                                 if (valid == DEF_NO) {         /* If dir not entered, move to next entry.              */
+                                     level--;
+                                     pos.SecNbr = sec_nbr_stk[level];
+                                     pos.SecPos = sec_pos_stk[level];
+                                     dir_clus   = dir_clus_stk[level];
+                                 }
+
+
+                             } else {                           /* Nesting too deep (see Note #3).                      */
+                                 FS_TRACE_DBG(("FS_FAT_VolChk(): Nesting too deep.\r\n"));
+                                 p_info->DirSkipCnt++;
+                                 if (p_map != DEF_NULL) {
+                                     (void)FS_FAT_VolChkMapEntry( p_vol,
+                                                                  p_buf,
+                                                                  p_map,
+                                                                 &fat_file_data,
+                                                                  DEF_YES,
+                                                                  repair,
+                                                                  p_info,
+                                                                  p_err);
+                                     if (*p_err == FS_ERR_DEV) {
+                                         return;
+                                     }
+                                 }
+                                 pos.SecNbr = end_pos.SecNbr;   /* Move to next entry.                                  */
+                                 pos.SecPos = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
+                             }
+                         }
+                     }
+
+
+
+                                                                /* --------------- DIR ENTRY FILE FOUND --------------- */
+                 } else {                                       /* If file ...                                          */
+                     FS_TRACE_DBG(("FS_FAT_VolChk(): Found file "));
+                     for (i = 0u; i < level; i++) {
+                         FS_TRACE_DBG(("  "));
+                     }
+                     FS_TRACE_DBG(("%s\r\n", name));
+
+                     p_info->FileCnt++;
+                     if (p_map == DEF_NULL) {
+                         FS_FAT_ChkFile( p_vol,                 /* ... chk file (see Note #2a) ...                      */
+                                        &fat_file_data,
+                                         p_err);
+                     } else {
+                         (void)FS_FAT_VolChkMapEntry( p_vol,    /* ... or claim file clus (see Note #2b).               */
+                                                      p_buf,
+                                                      p_map,
+                                                     &fat_file_data,
+                                                      DEF_NO,
+                                                      repair,
+                                                      p_info,
+                                                      p_err);
+                     }
+                     if (*p_err == FS_ERR_DEV) {
+                         return;
+                     }
+
+                     pos.SecNbr = end_pos.SecNbr;               /* Move to next entry.                                  */
+                     pos.SecPos = end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
+                 }
+                 break;
+
+
+
+            case FS_ERR_DEV:                                    /* ---------------------- DEV ERR --------------------- */
+            default:
+                 done = DEF_YES;
+                 break;
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_VolChkMapFAT()
+*
+* Description : Build the cluster usage map of a volume from its FAT.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               ----------  Argument validated by caller.
+*
+*               p_map       Pointer to cleared cluster usage map.
+*               ----------  Argument validated by caller.
+*
+*               repair      Indicates whether errors should be repaired.
+*
+*               p_info      Pointer to structure that will receive the check results.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE    Map built.
+*                               FS_ERR_DEV     Device error.
+*
+* Return(s)   : Number of free clusters.
+*
+* Note(s)     : (1) Each allocated cluster is marked as used; each cluster linked from an allocated cluster
+*                   is marked as referenced.  A link to a cluster already referenced is a cross-link; a
+*                   link to an invalid cluster is a link error.  Either is repaired by making the linking
+*                   cluster EOF.
+*
+*               (2) A bad cluster is marked as referenced so that it is not seen as a chain head.
+*
+*               (3) A link to a cluster found free is only known once the whole FAT has been read.  The
+*                   FAT is read a second time to cut these links only if any exists & errors must be
+*                   repaired.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_VOL_CHK_EN == DEF_ENABLED)
+static  FS_FAT_CLUS_NBR  FS_FAT_VolChkMapFAT (FS_VOL               *p_vol,
+                                              FS_BUF               *p_buf,
+                                              CPU_INT08U           *p_map,
+                                              CPU_BOOLEAN           repair,
+                                              FS_FAT_VOL_CHK_INFO  *p_info,
+                                              FS_ERR               *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   clus;
+    FS_FAT_CLUS_NBR   clus_next;
+    FS_FAT_CLUS_NBR   clus_free_cnt;
+    FS_FAT_CLUS_NBR   link_free_cnt;
+    CPU_INT08U        state;
+    CPU_BOOLEAN       cut;
+    CPU_BOOLEAN       valid;
+
+
+#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)
+    (void)repair;
+#endif
+
+    p_fat_data    = (FS_FAT_DATA *)p_vol->DataPtr;
+    clus_free_cnt =  0u;
+   *p_err         =  FS_ERR_NONE;
+
+                                                                /* ----------------- MARK USED & REF'D ---------------- */
+    for (clus = FS_FAT_MIN_CLUS_NBR; clus < p_fat_data->MaxClusNbr; clus++) {
+        clus_next = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol,
+                                                           p_buf,
+                                                           clus,
+                                                           p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (0u);
+        }
+
+        if (clus_next == p_fat_data->FAT_TypeAPI_Ptr->ClusFree) {
+            clus_free_cnt++;
+
+        } else if (clus_next == p_fat_data->FAT_TypeAPI_Ptr->ClusBad) {
+            p_info->ClusBadCnt++;                               /* See Note #2.                                         */
+            FS_FAT_VOL_CHK_MAP_SET(p_map, clus, FS_FAT_VOL_CHK_MAP_USED | FS_FAT_VOL_CHK_MAP_REF);
+
+        } else {
+            FS_FAT_VOL_CHK_MAP_SET(p_map, clus, FS_FAT_VOL_CHK_MAP_USED);
+            cut = DEF_NO;
+            if (clus_next < p_fat_data->FAT_TypeAPI_Ptr->ClusEOF) {
+                valid = FS_FAT_IS_VALID_CLUS(p_fat_data, clus_next);
+                if (valid == DEF_NO) {                          /* Link to invalid clus (see Note #1).                  */
+                    FS_TRACE_INFO(("FS_FAT_VolChkMap(): Invalid clus %d linked from clus %d.\r\n", clus_next, clus));
+                    p_info->LinkErrCnt++;
+                    cut = DEF_YES;
+
+                } else {
+                    state = FS_FAT_VOL_CHK_MAP_GET(p_map, clus_next);
+                    if (DEF_BIT_IS_SET(state, FS_FAT_VOL_CHK_MAP_REF) == DEF_YES) {
+                        FS_TRACE_INFO(("FS_FAT_VolChkMap(): Clus %d cross-linked from clus %d.\r\n", clus_next, clus));
+                        p_info->CrossLinkCnt++;                 /* Cross-link (see Note #1).                            */
+                        cut = DEF_YES;
+                    } else {
+                        FS_FAT_VOL_CHK_MAP_SET(p_map, clus_next, FS_FAT_VOL_CHK_MAP_REF);
+                    }
+                }
+            }
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+            if ((cut    == DEF_YES) &&
+                (repair == DEF_YES)) {
+                p_fat_data->FAT_TypeAPI_Ptr->ClusValWr(p_vol,
+                                                       p_buf,
+                                                       clus,
+                                                       p_fat_data->FAT_TypeAPI_Ptr->ClusEOF,
+                                                       p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    return (0u);
+                }
+            }
+#else
+            (void)cut;
+#endif
+        }
+    }
+
+
+                                                                /* ---------- FIND LINKS TO FREE CLUS'S --------------- */
+    link_free_cnt = 0u;
+    for (clus = FS_FAT_MIN_CLUS_NBR; clus < p_fat_data->MaxClusNbr; clus++) {
+        state = FS_FAT_VOL_CHK_MAP_GET(p_map, clus);
+        if (state == FS_FAT_VOL_CHK_MAP_REF) {                  /* Ref'd but not used (see Note #3).                    */
+            FS_TRACE_INFO(("FS_FAT_VolChkMap(): Free clus %d linked to chain.\r\n", clus));
+            link_free_cnt++;
+        }
+    }
+    p_info->LinkErrCnt += link_free_cnt;
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    if ((link_free_cnt != 0u) &&
+        (repair        == DEF_YES)) {
+        for (clus = FS_FAT_MIN_CLUS_NBR; clus < p_fat_data->MaxClusNbr; clus++) {
+            state = FS_FAT_VOL_CHK_MAP_GET(p_map, clus);
+            if ((state & FS_FAT_VOL_CHK_MAP_USED) == 0u) {
+                continue;
+            }
+            clus_next = FS_FAT_ClusNextGet(p_vol, p_buf, clus, p_err);
+            if (*p_err != FS_ERR_NONE) {                        /* EOF, bad or cut clus.                                */
+                if (*p_err == FS_ERR_DEV) {
+                    return (0u);
+                }
+               *p_err = FS_ERR_NONE;
+                continue;
+            }
+            state = FS_FAT_VOL_CHK_MAP_GET(p_map, clus_next);
+            if (state == FS_FAT_VOL_CHK_MAP_REF) {
+                p_fat_data->FAT_TypeAPI_Ptr->ClusValWr(p_vol,
+                                                       p_buf,
+                                                       clus,
+                                                       p_fat_data->FAT_TypeAPI_Ptr->ClusEOF,
+                                                       p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    return (0u);
+                }
+            }
+        }
+    }
+#endif
+
+    return (clus_free_cnt);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_VolChkMapEntry()
+*
+* Description : Claim the first cluster of a file or directory in the cluster usage map.
+*
+* Argument(s) : p_vol           Pointer to volume.
+*               ----------      Argument validated by caller.
+*
+*               p_buf           Pointer to temporary buffer.
+*               ----------      Argument validated by caller.
+*
+*               p_map           Pointer to cluster usage map.
+*               ----------      Argument validated by caller.
+*
+*               p_entry_data    Pointer to FAT entry data.
+*               ----------      Argument validated by caller.
+*
+*               dir             Indicates whether the entry is a directory.
+*
+*               repair          Indicates whether errors should be repaired.
+*
+*               p_info          Pointer to structure that will receive the check results.
+*               ----------      Argument validated by caller.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               ----------      Argument validated by caller.
+*
+*                                   FS_ERR_NONE    Entry checked.
+*                                   FS_ERR_DEV     Device error.
+*
+* Return(s)   : DEF_YES, if the first cluster was claimed.
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) The first cluster MUST be the head of an allocated chain, i.e., used & neither linked
+*                   from another cluster nor claimed by another entry.  An empty file has no first cluster.
+*
+*               (2) An entry whose first cluster cannot be claimed is cleared, since the chain belongs to
+*                   another entry or to no chain at all.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_VOL_CHK_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  FS_FAT_VolChkMapEntry (FS_VOL               *p_vol,
+                                            FS_BUF               *p_buf,
+                                            CPU_INT08U           *p_map,
+                                            FS_FAT_FILE_DATA     *p_entry_data,
+                                            CPU_BOOLEAN           dir,
+                                            CPU_BOOLEAN           repair,
+                                            FS_FAT_VOL_CHK_INFO  *p_info,
+                                            FS_ERR               *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   clus;
+    CPU_INT08U        state;
+    CPU_BOOLEAN       valid;
 
-    p_fat_data->NbrFATs = MEM_VAL_GET_INT08U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_NUMFATS));
-    switch (p_fat_data->NbrFATs) {
-        case 1:
-        case 2:
-             break;
 
-        default:
-             FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid nbr FATs: %d\n", p_fat_data->NbrFATs));
-            *p_err = FS_ERR_VOL_INVALID_SYS;
-             return;
-    }
-                                                                /* Size of reserved area.                               */
-    p_fat_data->RsvdSize    = (FS_FAT_SEC_NBR)MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_RSVDSECCNT));
-    p_fat_data->FAT1_Start  =  p_fat_data->RsvdSize;            /* Sec nbr of 1st FAT.                                  */
+#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)
+    (void)p_buf;
+    (void)repair;
+#endif
 
-                                                                /* Size of each FAT.                                    */
-    fat_size                = (FS_FAT_SEC_NBR)MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_FATSZ16));
-    if (fat_size           ==  0u) {
-        fat_size            = (FS_FAT_SEC_NBR)MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_FAT32_OFF_FATSZ32));
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    clus       =  p_entry_data->FileFirstClus;
+   *p_err      =  FS_ERR_NONE;
+
+    if ((clus == 0u) &&                                         /* Empty file (see Note #1).                            */
+        (dir  == DEF_NO)) {
+        return (DEF_YES);
     }
-    p_fat_data->FAT_Size    =  fat_size;
 
-                                                                /* Size of root dir (see Notes #2b).                    */
-    root_cnt                =  MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_ROOTENTCNT));
-    p_fat_data->RootDirSize =  FS_UTIL_DIV_PWR2((((FS_FAT_SEC_NBR)root_cnt * 32u) + ((FS_FAT_SEC_NBR)p_fat_data->SecSize - 1u)), p_fat_data->SecSizeLog2);
+    valid = FS_FAT_IS_VALID_CLUS(p_fat_data, clus);
+    if (valid == DEF_NO) {
+        FS_TRACE_INFO(("FS_FAT_VolChkMap(): Entry clus nbr invalid: %d.\r\n", clus));
+        p_info->EntryErrCnt++;
 
-                                                                /* Sec nbr's of 2nd FAT, root dir, data.                */
-    if (p_fat_data->NbrFATs      == 2u) {
-        p_fat_data->FAT2_Start   =  p_fat_data->RsvdSize +  p_fat_data->FAT_Size;
-        p_fat_data->RootDirStart =  p_fat_data->RsvdSize + (p_fat_data->FAT_Size * 2u);
-        p_fat_data->DataStart    =  p_fat_data->RsvdSize + (p_fat_data->FAT_Size * 2u) + p_fat_data->RootDirSize;
     } else {
-        p_fat_data->FAT2_Start   =  0u;
-        p_fat_data->RootDirStart =  p_fat_data->RsvdSize + (p_fat_data->FAT_Size * 1u);
-        p_fat_data->DataStart    =  p_fat_data->RsvdSize + (p_fat_data->FAT_Size * 1u) + p_fat_data->RootDirSize;
+        state = FS_FAT_VOL_CHK_MAP_GET(p_map, clus);
+        if (DEF_BIT_IS_CLR(state, FS_FAT_VOL_CHK_MAP_USED) == DEF_YES) {
+            FS_TRACE_INFO(("FS_FAT_VolChkMap(): Entry clus %d free.\r\n", clus));
+            p_info->EntryErrCnt++;
+            valid = DEF_NO;
+
+        } else if (DEF_BIT_IS_SET(state, FS_FAT_VOL_CHK_MAP_REF) == DEF_YES) {
+            FS_TRACE_INFO(("FS_FAT_VolChkMap(): Entry clus %d cross-linked.\r\n", clus));
+            p_info->CrossLinkCnt++;
+            valid = DEF_NO;
+
+        } else {
+            FS_FAT_VOL_CHK_MAP_SET(p_map, clus, FS_FAT_VOL_CHK_MAP_REF);
+        }
     }
 
-                                                                /* Size of vol (see Notes #2a).                         */
-    vol_size                = (CPU_INT32U)MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_TOTSEC16));
-    if (vol_size           == 0u) {
-        vol_size            = MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_OFF_TOTSEC32));
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    if ((valid  == DEF_NO) &&                                   /* Clr entry (see Note #2).                             */
+        (repair == DEF_YES)) {
+        p_entry_data->FileFirstClus = 0u;
+        p_entry_data->FileSize      = 0u;
+
+        FS_FAT_LowEntryUpdate(p_vol,
+                              p_buf,
+                              p_entry_data,
+                              DEF_YES,
+                              p_err);
     }
-    p_fat_data->VolSize     = vol_size;
+#endif
 
-                                                                /* Size of data area (see Notes #2c).                   */
-    p_fat_data->DataSize    = (p_fat_data->VolSize - (p_fat_data->RsvdSize + ((FS_FAT_SEC_NBR)p_fat_data->NbrFATs * p_fat_data->FAT_Size))) - p_fat_data->RootDirSize;
-    p_fat_data->NextClusNbr =  2u;                              /* Next clus to alloc.                                  */
-                                                                /* See Notes #2c3.                                      */
-    clus_cnt                =  (FS_FAT_CLUS_NBR)FS_UTIL_DIV_PWR2(p_fat_data->DataSize, p_fat_data->ClusSizeLog2_sec);
+    return (valid);
+}
+#endif
 
 
+/*
+*********************************************************************************************************
+*                                       FS_FAT_VolChkMapLost()
+*
+* Description : Find the lost cluster chains of a volume.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               ----------  Argument validated by caller.
+*
+*               p_map       Pointer to cluster usage map, with the clusters of all entries claimed.
+*               ----------  Argument validated by caller.
+*
+*               repair      Indicates whether errors should be repaired.
+*
+*               p_info      Pointer to structure that will receive the check results.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE    Lost chains found.
+*                               FS_ERR_DEV     Device error.
+*
+* Return(s)   : Number of clusters freed.
+*
+* Note(s)     : (1) A used cluster neither linked from another cluster nor claimed by an entry is the head
+*                   of a lost chain.  Lost chains are freed if errors must be repaired; otherwise, their
+*                   length is counted.
+*
+*               (2) Lost chains cannot be told apart from the chains of directories nested too deep to be
+*                   walked; none is then searched.
+*********************************************************************************************************
+*/
 
-                                                                /* --------------------- CHK FAT12 -------------------- */
-    if (clus_cnt                   <=  FS_FAT_MAX_NBR_CLUS_FAT12) {
-#if (FS_FAT_CFG_FAT12_EN == DEF_ENABLED)
-        p_fat_data->FAT_Type        =  FS_FAT_FAT_TYPE_FAT12;
-        p_fat_data->FAT_TypeAPI_Ptr = &FS_FAT_FAT12_API;
-        clus_cnt_max_fat            = ((FS_FAT_CLUS_NBR)p_fat_data->FAT_Size * (FS_FAT_CLUS_NBR)p_fat_data->SecSize * 2u) / 3u;
-        p_fat_data->MaxClusNbr      =  DEF_MIN(clus_cnt + FS_FAT_MIN_CLUS_NBR, clus_cnt_max_fat + FS_FAT_MIN_CLUS_NBR);
-#else
-        FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid file sys: FAT12\n"));
-       *p_err = FS_ERR_VOL_INVALID_SYS;
-        return;
-#endif
+#if (FS_FAT_CFG_VOL_CHK_EN == DEF_ENABLED)
+static  FS_FAT_CLUS_NBR  FS_FAT_VolChkMapLost (FS_VOL               *p_vol,
+                                               FS_BUF               *p_buf,
+                                               CPU_INT08U           *p_map,
+                                               CPU_BOOLEAN           repair,
+                                               FS_FAT_VOL_CHK_INFO  *p_info,
+                                               FS_ERR               *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   clus;
+    FS_FAT_CLUS_NBR   clus_cur;
+    FS_FAT_CLUS_NBR   clus_cnt;
+    FS_FAT_CLUS_NBR   clus_free_cnt;
+    CPU_INT08U        state;
 
 
-                                                                /* --------------------- CHK FAT16 -------------------- */
-    } else if (clus_cnt            <=  FS_FAT_MAX_NBR_CLUS_FAT16) {
-#if (FS_FAT_CFG_FAT16_EN == DEF_ENABLED)
-        p_fat_data->FAT_Type        =  FS_FAT_FAT_TYPE_FAT16;
-        p_fat_data->FAT_TypeAPI_Ptr = &FS_FAT_FAT16_API;
-        clus_cnt_max_fat            = (FS_FAT_CLUS_NBR)p_fat_data->FAT_Size * ((FS_FAT_CLUS_NBR)p_fat_data->SecSize / FS_FAT_FAT16_ENTRY_NBR_OCTETS);
-        p_fat_data->MaxClusNbr      =  DEF_MIN(clus_cnt + FS_FAT_MIN_CLUS_NBR, clus_cnt_max_fat + FS_FAT_MIN_CLUS_NBR);
-#else
-        FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid file sys: FAT16\n"));
-       *p_err = FS_ERR_VOL_INVALID_SYS;
-        return;
+#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)
+    (void)repair;
 #endif
 
+    p_fat_data    = (FS_FAT_DATA *)p_vol->DataPtr;
+    clus_free_cnt =  0u;
+   *p_err         =  FS_ERR_NONE;
 
-                                                                /* --------------------- CHK FAT32 -------------------- */
-    } else {
-#if (FS_FAT_CFG_FAT32_EN == DEF_ENABLED)
-        p_fat_data->FAT_Type        =  FS_FAT_FAT_TYPE_FAT32;
-        p_fat_data->FAT_TypeAPI_Ptr = &FS_FAT_FAT32_API;
-        clus_cnt_max_fat            = (FS_FAT_CLUS_NBR)p_fat_data->FAT_Size * ((FS_FAT_CLUS_NBR)p_fat_data->SecSize / FS_FAT_FAT32_ENTRY_NBR_OCTETS);
-        p_fat_data->MaxClusNbr      = DEF_MIN(clus_cnt + FS_FAT_MIN_CLUS_NBR, clus_cnt_max_fat + FS_FAT_MIN_CLUS_NBR);
+    if (p_info->DirSkipCnt != 0u) {                             /* See Note #2.                                         */
+        FS_TRACE_INFO(("FS_FAT_VolChkMap(): Dirs nested too deep; lost chains not srch'd.\r\n"));
+        return (0u);
+    }
 
-                                                                /* Get root dir clus nbr.                               */
-        clus_nbr                    = MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_FAT32_OFF_ROOTCLUS));
-        valid                       = FS_FAT_IS_VALID_CLUS(p_fat_data, clus_nbr);
-        if (valid == DEF_NO) {
-            FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid FAT32 root dir clus: %d\n", clus_nbr));
-           *p_err = FS_ERR_VOL_INVALID_SYS;
-            return;
-        }
-        p_fat_data->RootDirStart     = FS_FAT_CLUS_TO_SEC(p_fat_data, clus_nbr);
-                                                                /* Get FSINFO sec nbr.                                  */
-        sec_nbr                      = MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_FAT32_OFF_FSINFO));
-        if (sec_nbr != 0u) {
-            p_fat_data->FS_InfoStart = (FS_FAT_SEC_NBR)sec_nbr;
+    for (clus = FS_FAT_MIN_CLUS_NBR; clus < p_fat_data->MaxClusNbr; clus++) {
+        state = FS_FAT_VOL_CHK_MAP_GET(p_map, clus);
+        if (state != FS_FAT_VOL_CHK_MAP_USED) {                 /* If not head of lost chain ...                        */
+            continue;                                           /* ... move to next clus.                               */
         }
-                                                                /* Get BKBOOT sec nbr.                                  */
-        sec_nbr                      = MEM_VAL_GET_INT16U_LITTLE((void *)(p_temp_08 + FS_FAT_BPB_FAT32_OFF_BKBOOTSEC));
-        if (sec_nbr != 0u) {
-            p_fat_data->BPB_BkStart  = (FS_FAT_SEC_NBR)sec_nbr;
+
+        FS_TRACE_INFO(("FS_FAT_VolChkMap(): Lost chain starting at clus %d.\r\n", clus));
+        p_info->LostChainCnt++;
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+        if (repair == DEF_YES) {                                /* Free chain ...                                       */
+            clus_cnt = FS_FAT_ClusChainDel(p_vol,
+                                           p_buf,
+                                           clus,
+                                           DEF_YES,
+                                           p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return (clus_free_cnt);
+            }
+            p_info->LostClusCnt += clus_cnt;
+            clus_free_cnt       += clus_cnt;
+            continue;
         }
-#else
-        FS_TRACE_DBG(("FS_FAT_ChkBootSec(): Invalid file sys: FAT32\n"));
-       *p_err = FS_ERR_VOL_INVALID_SYS;
-        return;
 #endif
+
+        clus_cur = clus;                                        /* ... or cnt clus's in chain.                          */
+        clus_cnt = 1u;
+        while (clus_cnt < p_info->ClusCnt) {
+            clus_cur = FS_FAT_ClusNextGet(p_vol, p_buf, clus_cur, p_err);
+            if (*p_err != FS_ERR_NONE) {
+                break;
+            }
+            clus_cnt++;
+        }
+        if (*p_err == FS_ERR_DEV) {
+            return (clus_free_cnt);
+        }
+       *p_err               = FS_ERR_NONE;
+        p_info->LostClusCnt += clus_cnt;
     }
 
-   *p_err = FS_ERR_NONE;
+    return (clus_free_cnt);
 }
+#endif
 
 
 /*
@@ -5849,6 +7554,160 @@ static  void  FS_FAT_GetSysCfg  (FS_SEC_SIZE      sec_size,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                        FS_FAT_FmtAlignClus()
+*
+* Description : Adjust the default cluster size of a volume being formatted so that clusters do not
+*               straddle erase block or allocation unit boundaries.
+*
+* Argument(s) : p_sys_cfg   Pointer to format configuration.
+*               ----------  Argument validated by caller.
+*
+*               size        Size of volume, in sectors.
+*
+*               align_size  Erase block or allocation unit size, in sectors (see 'FS_FAT_FmtAlign()
+*                           Note #1').
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) A cluster that is a multiple or a divisor of the erase block size never straddles a
+*                   boundary once the data area is aligned.  Otherwise, the cluster size is halved until
+*                   it divides the erase block size; since the cluster size is a power of 2, this ends
+*                   at 1 sector at the latest.
+*
+*               (2) The cluster size is NOT changed if the resulting number of clusters would exceed the
+*                   maximum for the FAT type.  The cluster count is over-estimated from the volume size
+*                   less the reserved area.
+*********************************************************************************************************
+*/
+
+#if ((FS_CFG_RD_ONLY_EN == DEF_DISABLED) && (FS_FAT_CFG_FMT_ALIGN_EN == DEF_ENABLED))
+static  void  FS_FAT_FmtAlignClus (FS_FAT_SYS_CFG  *p_sys_cfg,
+                                   FS_SEC_QTY       size,
+                                   FS_SEC_QTY       align_size)
+{
+    FS_FAT_SEC_NBR   clus_size;
+    FS_FAT_CLUS_NBR  clus_cnt;
+    FS_FAT_CLUS_NBR  clus_cnt_max;
+
+
+    if (align_size <= 1u) {                                     /* Size not reported.                                   */
+        return;
+    }
+
+    clus_size = p_sys_cfg->ClusSize;
+    if (((align_size % clus_size)  == 0u) ||                    /* Clus size already aligned (see Note #1).             */
+        ((clus_size  % align_size) == 0u)) {
+        return;
+    }
+
+    while ((align_size % clus_size) != 0u) {                    /* Halve clus size until it divides erase blk size.     */
+        clus_size /= 2u;
+    }
+
+    switch (p_sys_cfg->FAT_Type) {                              /* Chk clus cnt (see Note #2).                          */
+        case FS_FAT_FAT_TYPE_FAT12:
+             clus_cnt_max = FS_FAT_MAX_NBR_CLUS_FAT12;
+             break;
+
+        case FS_FAT_FAT_TYPE_FAT16:
+             clus_cnt_max = FS_FAT_MAX_NBR_CLUS_FAT16;
+             break;
+
+        case FS_FAT_FAT_TYPE_FAT32:
+        default:
+             clus_cnt_max = FS_FAT_MAX_NBR_CLUS_FAT32;
+             break;
+    }
+
+    clus_cnt = (size - DEF_MIN(size, p_sys_cfg->RsvdAreaSize)) / clus_size;
+    if (clus_cnt > clus_cnt_max) {
+        FS_TRACE_DBG(("FS_FAT_FmtAlignClus(): Clus size %d not aligned to erase blk size %d: %d clus.\r\n", p_sys_cfg->ClusSize, align_size, clus_cnt));
+        return;
+    }
+
+    FS_TRACE_DBG(("FS_FAT_FmtAlignClus(): Clus size %d reduced to %d for erase blk size %d.\r\n", p_sys_cfg->ClusSize, clus_size, align_size));
+    p_sys_cfg->ClusSize = (FS_SEC_QTY)clus_size;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          FS_FAT_FmtAlign()
+*
+* Description : Extend the reserved area of a volume being formatted so that its data area starts on an
+*               erase block or allocation unit boundary.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_sys_cfg   Pointer to format configuration.
+*               ----------  Argument validated by caller.
+*
+*               meta_size   Number of sectors of the FATs & root directory.
+*
+*               size        Size of volume, in sectors.
+*
+*               align_size  Erase block or allocation unit size, in sectors (see Note #1).
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The boundary is a device sector number, so the partition start is included.  No
+*                   alignment is done if the device does not report the size (0).
+*
+*               (2) The FAT size is not recalculated; the FATs MAY have extra entries (see 'FS_FAT_VolFmt()
+*                   Note #5').
+*
+*               (3) Clusters start on erase block boundaries only if the cluster size is a multiple or a
+*                   divisor of the erase block size, which 'FS_FAT_FmtAlignClus()' ensures for the default
+*                   cluster size whenever the FAT type allows it; otherwise, only the first data sector is
+*                   aligned.
+*
+*               (4) The data area is not aligned if the reserved area size would not fit in the 16-bit
+*                   BPB_RsvdSecCnt field, if no data sector would be left or if too few clusters would be
+*                   left for the FAT type.
+*********************************************************************************************************
+*/
+
+#if ((FS_CFG_RD_ONLY_EN == DEF_DISABLED) && (FS_FAT_CFG_FMT_ALIGN_EN == DEF_ENABLED))
+static  void  FS_FAT_FmtAlign (FS_VOL          *p_vol,
+                               FS_FAT_SYS_CFG  *p_sys_cfg,
+                               FS_FAT_SEC_NBR   meta_size,
+                               FS_SEC_QTY       size,
+                               FS_SEC_QTY       align_size)
+{
+    FS_FAT_SEC_NBR   data_sec_start;
+    FS_FAT_SEC_NBR   pad;
+    FS_FAT_CLUS_NBR  clus_cnt;
+
+
+    if (align_size <= 1u) {                                     /* Size not reported (see Note #1).                     */
+        return;
+    }
+
+    data_sec_start = (FS_FAT_SEC_NBR)p_vol->PartitionStart + p_sys_cfg->RsvdAreaSize + meta_size;
+    pad            = (align_size - (data_sec_start % align_size)) % align_size;
+
+    if ((p_sys_cfg->RsvdAreaSize + pad             >  DEF_INT_16U_MAX_VAL) ||   /* See Note #4.                     */
+        (p_sys_cfg->RsvdAreaSize + meta_size + pad >= size)) {
+        FS_TRACE_DBG(("FS_FAT_FmtAlign(): Cannot align data area.\r\n"));
+        return;
+    }
+
+    clus_cnt = (size - (p_sys_cfg->RsvdAreaSize + meta_size + pad)) / p_sys_cfg->ClusSize;
+    if (((p_sys_cfg->FAT_Type == FS_FAT_FAT_TYPE_FAT32) && (clus_cnt <= FS_FAT_MAX_NBR_CLUS_FAT16)) ||
+        ((p_sys_cfg->FAT_Type == FS_FAT_FAT_TYPE_FAT16) && (clus_cnt <= FS_FAT_MAX_NBR_CLUS_FAT12))) {
+        FS_TRACE_DBG(("FS_FAT_FmtAlign(): Cannot align data area: %d clus left.\r\n", clus_cnt));
+        return;
+    }
+
+    p_sys_cfg->RsvdAreaSize += pad;                             /* Extend rsvd area.                                    */
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                          FS_FAT_DataSrch()
@@ -6041,6 +7900,186 @@ static  void  FS_FAT_DataSrch (FS_VOL          *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                      FS_FAT_LowTreeEntryDel()
+*
+* Description : Delete entry found while walking a directory tree.
+*
+* Argument(s) : p_vol               Pointer to volume.
+*               ----------          Argument validated by caller.
+*
+*               p_buf_dir           Pointer to temporary buffer used for directory sectors.
+*               ----------          Argument validated by caller.
+*
+*               p_buf_fat           Pointer to temporary buffer used for FAT sectors.
+*               ----------          Argument validated by caller.
+*
+*               p_dir_start_pos     Pointer to position of the entry's first directory entry.
+*               ----------          Argument validated by caller.
+*
+*               p_dir_end_pos       Pointer to position of the entry's last directory entry.
+*               ----------          Argument validated by caller.
+*
+*               file_first_clus     First cluster of the entry.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*               ----------          Argument validated by caller.
+*
+*                                       FS_ERR_NONE             Entry deleted.
+*                                       FS_ERR_DEV              Device access error.
+*                                       FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The journal is checkpointed before the entries of the directory have all been deleted
+*                   only if half of the journal is used (see 'FS_FAT_LowEntryDelTree()  Note #2a').
+*
+*               (2) A cluster chain deletion is completed when the journal is replayed, & the logs preceding
+*                   it are then kept (see 'fs_fat_journal.c  FS_FAT_JournalReplay()  Note #3').  The
+*                   deletions of the entries preceding it in the same journal transaction MUST thus be
+*                   written to the device before it is logged.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_LowTreeEntryDel (FS_VOL           *p_vol,
+                                      FS_BUF           *p_buf_dir,
+                                      FS_BUF           *p_buf_fat,
+                                      FS_FAT_DIR_POS   *p_dir_start_pos,
+                                      FS_FAT_DIR_POS   *p_dir_end_pos,
+                                      FS_FAT_CLUS_NBR   file_first_clus,
+                                      FS_ERR           *p_err)
+{
+    FS_FAT_DATA  *p_fat_data;
+    CPU_BOOLEAN   valid;
+#ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
+    CPU_BOOLEAN   due;
+#endif
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+                                                                /* ------------------- DEL DIR ENTRY ------------------ */
+    FS_FAT_FN_API_Active.DirEntryDel(p_vol,
+                                     p_buf_dir,
+                                     p_dir_start_pos,
+                                     p_dir_end_pos,
+                                     p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+                                                                /* ------------------- DEL CLUS CHAIN ----------------- */
+    valid = FS_FAT_IS_VALID_CLUS(p_fat_data, file_first_clus);
+    if (valid == DEF_YES) {
+#ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
+        if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START) == DEF_YES) {
+            if (p_buf_fat != p_buf_dir) {                       /* See Note #2.                                         */
+                FSBuf_Flush(p_buf_fat, p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    return;
+                }
+            }
+            FSBuf_Flush(p_buf_dir, p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+        }
+#endif
+        (void)FS_FAT_ClusChainDel(p_vol,
+                                  p_buf_fat,
+                                  file_first_clus,
+                                  DEF_YES,
+                                  p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+    }
+
+                                                                /* -------------------- CLR JOURNAL ------------------- */
+#ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
+    due = FS_FAT_JournalCkptDue(p_vol);                         /* See Note #1.                                         */
+    if (due == DEF_YES) {
+        FS_FAT_LowTreeCkpt(p_vol,
+                           p_buf_dir,
+                           p_buf_fat,
+                           p_err);
+    }
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_LowTreeCkpt()
+*
+* Description : Commit entries deleted while walking a directory tree.
+*
+* Argument(s) : p_vol           Pointer to volume.
+*               ----------      Argument validated by caller.
+*
+*               p_buf_dir       Pointer to temporary buffer used for directory sectors.
+*               ----------      Argument validated by caller.
+*
+*               p_buf_fat       Pointer to temporary buffer used for FAT sectors.
+*               ----------      Argument validated by caller.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               ----------      Argument validated by caller.
+*
+*                                   FS_ERR_NONE    Deletions committed, or journaling not started.
+*
+*                                   ---------------RETURNED BY FS_FAT_JournalClrReset()---------------
+*                                   See FS_FAT_JournalClrReset() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FS_FAT_LowEntryDelTree()  Note #2a'.  Both buffers are flushed before the journal
+*                   is checkpointed, so that no deletion is committed before it is written to the device.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_LowTreeCkpt (FS_VOL  *p_vol,
+                                  FS_BUF  *p_buf_dir,
+                                  FS_BUF  *p_buf_fat,
+                                  FS_ERR  *p_err)
+{
+#ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
+    FS_FAT_DATA  *p_fat_data;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START) == DEF_NO) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    if (p_buf_fat != p_buf_dir) {                               /* See Note #1.                                         */
+        FSBuf_Flush(p_buf_fat, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+    }
+
+    FSBuf_Flush(p_buf_dir, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    FS_FAT_JournalClrReset(p_vol, p_buf_dir, p_err);
+#else
+   (void)p_vol;                                                 /*lint --e{550} Suppress "Symbol not accessed".         */
+   (void)p_buf_dir;
+   (void)p_buf_fat;
+   *p_err = FS_ERR_NONE;
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                        FS_FAT_FileDataClr()
@@ -6079,6 +8118,11 @@ static  void  FS_FAT_FileDataClr (FS_FAT_FILE_DATA  *p_entry_data)
     p_entry_data->DateWr         = 0u;
     p_entry_data->TimeWr         = 0u;
     p_entry_data->DateAccess     = 0u;
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+    p_entry_data->CommitPend     = DEF_NO;
+    p_entry_data->CommitNextPtr  = (FS_FAT_FILE_DATA *)0;
+#endif
 }
 
 
@@ -6130,6 +8174,9 @@ static  void  FS_FAT_FileDataInit (FS_FAT_FILE_DATA *p_entry_data,
 
 static  void  FS_FAT_DataClr (FS_FAT_DATA  *p_fat_data)
 {
+    CPU_INT08U  ix;
+
+
     p_fat_data->RsvdSize           =  0u;
     p_fat_data->FAT_Size           =  0u;
     p_fat_data->RootDirSize        =  0u;
@@ -6161,6 +8208,25 @@ static  void  FS_FAT_DataClr (FS_FAT_DATA  *p_fat_data)
     p_fat_data->QueryBadClusCnt    =  0u;
     p_fat_data->QueryFreeClusCnt   =  0u;
 
+    for (ix = 0u; ix < FS_FAT_CLUS_CHAIN_HINT_CNT; ix++) {
+        p_fat_data->ChainHintTbl[ix].FirstClus = 0u;
+        p_fat_data->ChainHintTbl[ix].LastClus  = 0u;
+        p_fat_data->ChainHintTbl[ix].ClusCnt   = 0u;
+    }
+    p_fat_data->ChainHintIx        =  0u;
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN    == DEF_ENABLED)
+    p_fat_data->CommitInterval     =  0u;
+    p_fat_data->CommitTS           =  0u;
+    p_fat_data->CommitListPtr      = (FS_FAT_FILE_DATA *)0;
+#endif
+
+#if (FS_FAT_CFG_VOL_DIRTY_EN      == DEF_ENABLED)
+    p_fat_data->VolDirtyState      =  FS_FAT_VOL_DIRTY_STATE_CLEAN;
+    p_fat_data->VolDirtyOpen       =  DEF_NO;
+    p_fat_data->VolChkReqd         =  DEF_NO;
+#endif
+
 #if (FS_CFG_CTR_STAT_EN            == DEF_ENABLED)
     p_fat_data->StatAllocClusCtr   =  0u;
     p_fat_data->StatFreeClusCtr    =  0u;
@@ -6168,6 +8234,229 @@ static  void  FS_FAT_DataClr (FS_FAT_DATA  *p_fat_data)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         FS_FAT_VolDirtyRd()
+*
+* Description : Read clean shutdown bit of a volume & trust the FSINFO sector of a clean FAT32 volume.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE              Clean shutdown bit read.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) FAT12 volumes have no clean shutdown bit & are always seen as dirty.
+*
+*               (2) FSINFO holds no bad cluster count.  The volume is assumed to have none, as when it was
+*                   formatted.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED)
+static  void  FS_FAT_VolDirtyRd (FS_VOL  *p_vol,
+                                 FS_ERR  *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_BUF           *p_buf;
+    CPU_INT08U       *p_temp_08;
+    FS_FAT_CLUS_NBR   val;
+    FS_FAT_CLUS_NBR   free_cnt;
+    FS_FAT_CLUS_NBR   nxt_free;
+    CPU_BOOLEAN       dirty;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    if (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT12) {        /* See Note #1.                                         */
+        p_fat_data->VolDirtyOpen = DEF_YES;
+        p_fat_data->VolChkReqd   = DEF_YES;
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    p_buf = FSBuf_Get(p_vol);
+    if (p_buf == (FS_BUF *)0) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
+
+                                                                /* --------------- RD CLEAN SHUTDOWN BIT -------------- */
+    val = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol, p_buf, 1u, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        FSBuf_Free(p_buf);
+        return;
+    }
+
+    if (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT16) {
+        dirty = DEF_BIT_IS_CLR(val, FS_FAT_FAT16_CLUS1_CLN_SHUT);
+    } else {
+        dirty = DEF_BIT_IS_CLR(val, FS_FAT_FAT32_CLUS1_CLN_SHUT);
+    }
+    p_fat_data->VolDirtyState = (dirty == DEF_YES) ? FS_FAT_VOL_DIRTY_STATE_DIRTY : FS_FAT_VOL_DIRTY_STATE_CLEAN;
+    p_fat_data->VolDirtyOpen  =  dirty;
+    p_fat_data->VolChkReqd    =  dirty;
+
+                                                                /* --------------- RD FSINFO (see Note #2) ------------ */
+    if ((dirty                    == DEF_NO)                &&
+        (p_fat_data->FAT_Type     == FS_FAT_FAT_TYPE_FAT32) &&
+        (p_fat_data->FS_InfoStart != 0u)) {
+        FSBuf_Set(p_buf,
+                  p_fat_data->FS_InfoStart,
+                  FS_VOL_SEC_TYPE_MGMT,
+                  DEF_YES,
+                  p_err);
+
+        p_temp_08 = (CPU_INT08U *)p_buf->DataPtr;
+        if ((*p_err == FS_ERR_NONE) &&                          /* FSINFO ignored if unreadable or invalid.             */
+            (MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_LEADSIG))  == FS_FAT_FSI_LEADSIG)  &&
+            (MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_STRUCSIG)) == FS_FAT_FSI_STRUCSIG) &&
+            (MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_TRAILSIG)) == FS_FAT_FSI_TRAILSIG)) {
+            free_cnt = (FS_FAT_CLUS_NBR)MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_FREE_COUNT));
+            nxt_free = (FS_FAT_CLUS_NBR)MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_NXT_FREE));
+
+            if (free_cnt <= p_fat_data->MaxClusNbr - FS_FAT_MIN_CLUS_NBR) {
+                p_fat_data->QueryInfoValid   = DEF_YES;         /* Trust free clus cnt.                                 */
+                p_fat_data->QueryBadClusCnt  = 0u;
+                p_fat_data->QueryFreeClusCnt = free_cnt;
+            }
+            if ((nxt_free >= FS_FAT_MIN_CLUS_NBR) &&
+                (nxt_free <  p_fat_data->MaxClusNbr)) {
+                p_fat_data->NextClusNbr = nxt_free;             /* Trust next free clus hint.                           */
+            }
+        }
+    }
+
+    FSBuf_Free(p_buf);
+
+    FS_TRACE_INFO(("FS_FAT_VolDirtyRd(): Vol %s.\r\n", (dirty == DEF_YES) ? "dirty" : "clean"));
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_VolDirtyClr()
+*
+* Description : Mark a volume clean.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE              Volume marked clean, or left dirty (see Note #1).
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The volume is left dirty if it was dirty when mounted & was neither checked nor
+*                   replayed (see 'FS_FAT_VolSync()  Note #2').
+*
+*               (2) The free cluster count & next free cluster of a FAT32 volume are written to FSINFO.  The
+*                   free cluster count is written as unknown if it was never computed.
+*
+*               (3) All other sectors reach the medium before the clean shutdown bit is set, which is the
+*                   last sector written.
+*********************************************************************************************************
+*/
+
+#if ((FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED) && (FS_CFG_RD_ONLY_EN == DEF_DISABLED))
+static  void  FS_FAT_VolDirtyClr (FS_VOL  *p_vol,
+                                  FS_ERR  *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_BUF           *p_buf;
+    CPU_INT08U       *p_temp_08;
+    FS_FAT_CLUS_NBR   val;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+   *p_err      =  FS_ERR_NONE;
+
+    if ((p_fat_data->VolDirtyState != FS_FAT_VOL_DIRTY_STATE_DIRTY) ||
+        (p_fat_data->VolChkReqd    == DEF_YES)) {               /* See Note #1.                                         */
+        return;
+    }
+
+    p_buf = FSBuf_Get(p_vol);
+    if (p_buf == (FS_BUF *)0) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
+
+                                                                /* ---------------- WR FSINFO (see Note #2) ----------- */
+    if ((p_fat_data->FAT_Type     == FS_FAT_FAT_TYPE_FAT32) &&
+        (p_fat_data->FS_InfoStart != 0u)) {
+        FSBuf_Set(p_buf,
+                  p_fat_data->FS_InfoStart,
+                  FS_VOL_SEC_TYPE_MGMT,
+                  DEF_YES,
+                  p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSBuf_Free(p_buf);
+            return;
+        }
+
+        p_temp_08 = (CPU_INT08U *)p_buf->DataPtr;
+        if ((MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_LEADSIG))  == FS_FAT_FSI_LEADSIG)  &&
+            (MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_STRUCSIG)) == FS_FAT_FSI_STRUCSIG) &&
+            (MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_TRAILSIG)) == FS_FAT_FSI_TRAILSIG)) {
+            val = (p_fat_data->QueryInfoValid == DEF_YES) ? p_fat_data->QueryFreeClusCnt : DEF_INT_32U_MAX_VAL;
+            MEM_VAL_SET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_FREE_COUNT), val);
+            MEM_VAL_SET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_NXT_FREE),   p_fat_data->NextClusNbr);
+            FSBuf_MarkDirty(p_buf, p_err);
+            if (*p_err == FS_ERR_NONE) {
+                FSBuf_Flush(p_buf, p_err);
+            }
+            if (*p_err != FS_ERR_NONE) {
+                FSBuf_Free(p_buf);
+                return;
+            }
+        }
+    }
+
+    FSVol_BarrierLocked(p_vol, p_err);                          /* All other secs on media (see Note #3).               */
+    if (*p_err != FS_ERR_NONE) {
+        FSBuf_Free(p_buf);
+        return;
+    }
+
+                                                                /* --------------- SET CLEAN SHUTDOWN BIT ------------- */
+    p_fat_data->VolDirtyState = FS_FAT_VOL_DIRTY_STATE_CLR;     /* FAT sec wr'n unchanged.                              */
+
+    val = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol, p_buf, 1u, p_err);
+    if (*p_err == FS_ERR_NONE) {
+        if (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT16) {
+            val |= FS_FAT_FAT16_CLUS1_CLN_SHUT;
+        } else {
+            val |= FS_FAT_FAT32_CLUS1_CLN_SHUT;
+        }
+        p_fat_data->FAT_TypeAPI_Ptr->ClusValWr(p_vol, p_buf, 1u, val, p_err);
+    }
+    if (*p_err == FS_ERR_NONE) {
+        FSBuf_Flush(p_buf, p_err);
+    }
+    FSBuf_Free(p_buf);
+
+    if (*p_err == FS_ERR_NONE) {
+        FSVol_BarrierLocked(p_vol, p_err);
+    }
+
+    p_fat_data->VolDirtyState = (*p_err == FS_ERR_NONE) ? FS_FAT_VOL_DIRTY_STATE_CLEAN : FS_FAT_VOL_DIRTY_STATE_DIRTY;
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
@@ -131,6 +131,8 @@
 
 #define  FS_FAT_VOL_LABEL_LEN                             11u
 
+#define  FS_FAT_CLUS_CHAIN_HINT_CNT                        4u   /* Nbr of clus chain end hints kept per vol.            */
+
 /*
 *********************************************************************************************************
 *                                      BOOT SECTOR & BPB DEFINES
@@ -271,6 +273,8 @@
 #define  FS_FAT_JOURNAL_STATE_OPEN               DEF_BIT_01
 #define  FS_FAT_JOURNAL_STATE_START              DEF_BIT_02
 #define  FS_FAT_JOURNAL_STATE_REPLAY             DEF_BIT_03
+#define  FS_FAT_JOURNAL_STATE_TX_PEND            DEF_BIT_04
+#define  FS_FAT_JOURNAL_STATE_DATA_PEND          DEF_BIT_05
 
 /*
 *********************************************************************************************************
@@ -336,6 +340,8 @@ struct  fs_fat_file_data {
     FS_FAT_CLUS_NBR           FileFirstClus;                    /* Clus nbr of first file clus.                         */
     FS_FAT_SEC_NBR            FileCurSec;                       /* Sec  nbr of cur   file sec.                          */
     FS_SEC_SIZE               FileCurSecPos;                    /* Pos      of cur   file pos in sec.                   */
+    FS_FAT_CLUS_NBR           FileLastClus;                     /* Clus nbr of last  file clus (0 if unknown).          */
+    FS_FAT_CLUS_NBR           FileClusCnt;                      /* Nbr of clus in file clus chain.                      */
 
     FS_FLAGS                  Attrib;                           /* File attrib.                                         */
     FS_FAT_DATE               DateCreate;                       /* File creation date.                                  */
@@ -343,9 +349,79 @@ struct  fs_fat_file_data {
     FS_FAT_DATE               DateAccess;                       /* File last access date.                               */
     FS_FAT_DATE               DateWr;                           /* File last wr  date.                                  */
     FS_FAT_TIME               TimeWr;                           /* File last wr  time.                                  */
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+    CPU_BOOLEAN               CommitPend;                       /* Dir entry update pending on vol commit list.         */
+    FS_FAT_FILE_DATA         *CommitNextPtr;                    /* Ptr to next file data on vol commit list.            */
+#endif
 };
 
 
+/*
+*********************************************************************************************************
+*                                  FAT CLUSTER CHAIN END HINT DATA TYPE
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_fat_clus_chain_hint {
+    FS_FAT_CLUS_NBR           FirstClus;                        /* Clus nbr of first clus in chain (0 if unused).       */
+    FS_FAT_CLUS_NBR           LastClus;                         /* Clus nbr of last  clus in chain.                     */
+    FS_FAT_CLUS_NBR           ClusCnt;                          /* Nbr of clus in chain.                                */
+} FS_FAT_CLUS_CHAIN_HINT;
+
+
+/*
+*********************************************************************************************************
+*                                   FAT JOURNAL REPLAY INFO DATA TYPE
+*
+* Note(s) : (1) Sector counts are taken from the volume statistics counters & are zero unless
+*               FS_CFG_CTR_STAT_EN is enabled.  Sectors of a journal placed on another device are not
+*               counted.
+*
+*           (2) The replay duration is measured with 'Clk_GetTS()' & is zero if no valid time stamp can
+*               be obtained.
+*********************************************************************************************************
+*/
+
+#ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
+typedef  struct  fs_fat_journal_replay_info {
+    CPU_INT32U                LogCnt;                           /* Nbr of logs replayed/reverted.                       */
+    FS_FAT_CLUS_NBR           ClusFreeCnt;                      /* Nbr of clus's free'd to complete a del.              */
+    FS_CTR                    SecRdCnt;                         /* Nbr of vol secs rd    (see Note #1).                 */
+    FS_CTR                    SecWrCnt;                         /* Nbr of vol secs wr'n  (see Note #1).                 */
+    CLK_TS_SEC                Dur_sec;                          /* Replay duration, in s (see Note #2).                 */
+} FS_FAT_JOURNAL_REPLAY_INFO;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    FAT VOLUME CHECK INFO DATA TYPE
+*
+* Note(s) : (1) See 'FS_FAT_VolChkMap()'.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_VOL_CHK_EN == DEF_ENABLED)
+typedef  struct  fs_fat_vol_chk_info {
+    FS_FAT_CLUS_NBR           ClusCnt;                          /* Nbr of clus's in data area.                          */
+    FS_FAT_CLUS_NBR           ClusFreeCnt;                      /* Nbr of free clus's.                                  */
+    FS_FAT_CLUS_NBR           ClusBadCnt;                       /* Nbr of bad  clus's.                                  */
+    CPU_BOOLEAN               ClusFreeCntErr;                   /* Cached free clus cnt was wrong.                      */
+
+    FS_FAT_CLUS_NBR           LinkErrCnt;                       /* Nbr of links to invalid or free clus's.              */
+    FS_FAT_CLUS_NBR           CrossLinkCnt;                     /* Nbr of clus's claimed twice.                         */
+    FS_FAT_CLUS_NBR           LostChainCnt;                     /* Nbr of chains not claimed by any entry.              */
+    FS_FAT_CLUS_NBR           LostClusCnt;                      /* Nbr of clus's in lost chains.                        */
+    CPU_INT32U                EntryErrCnt;                      /* Nbr of entries with invalid clus nbr.                */
+
+    CPU_INT32U                FileCnt;                          /* Nbr of files walked.                                 */
+    CPU_INT32U                DirCnt;                           /* Nbr of dirs  found.                                  */
+    CPU_INT32U                DirSkipCnt;                       /* Nbr of dirs  nested too deep to be walked.           */
+} FS_FAT_VOL_CHK_INFO;
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FAT INFO DATA TYPE
@@ -384,9 +460,41 @@ struct  fs_fat_data {
     FS_FAT_CLUS_NBR           QueryBadClusCnt;                  /* Count of bad  clusters.                              */
     FS_FAT_CLUS_NBR           QueryFreeClusCnt;                 /* Count of free clusters.                              */
 
+    FS_FAT_CLUS_CHAIN_HINT    ChainHintTbl[FS_FAT_CLUS_CHAIN_HINT_CNT]; /* Clus chain ends of closed files.         */
+    CPU_INT08U                ChainHintIx;                      /* Ix of next hint to replace.                          */
+
+#if (FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED)
+    CPU_INT08U                VolDirtyState;                    /* State of clean shutdown bit on media.                */
+    CPU_BOOLEAN               VolDirtyOpen;                     /* Whether vol was dirty when opened.                   */
+    CPU_BOOLEAN               VolChkReqd;                       /* Whether vol must be chk'd before marked clean.       */
+#endif
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+    CPU_INT32U                CommitInterval;                   /* Dir entry commit interval (in s; 0 if none).         */
+    CLK_TS_SEC                CommitTS;                         /* Time stamp of last dir entry commit.                 */
+    FS_FAT_FILE_DATA         *CommitListPtr;                    /* Ptr to files with pending dir entry updates.         */
+#endif
+
 #ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
     CPU_INT08U                JournalState;
     FS_FAT_FILE_DATA         *JournalDataPtr;
+    FS_FAT_FILE_SIZE          JournalCkptPos;                   /* Journal pos following last checkpoint.               */
+    FS_FAT_JOURNAL_REPLAY_INFO  JournalReplayInfo;              /* Cost of last journal replay.                         */
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+    CPU_INT16U                JournalTxNestCnt;                 /* Nbr of explicit journal tx's begun.                  */
+    CPU_INT32U                JournalTxInterval;                /* Journal tx window (in s;      0 if none).            */
+    CPU_SIZE_T                JournalTxSize;                    /* Journal tx window (in octets; 0 if none).            */
+    CLK_TS_SEC                JournalTxTS;                      /* Time stamp of first op of pending journal tx.        */
+#endif
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+    CPU_INT08U               *JournalStageBufPtr;               /* Journal staging buf.                                 */
+    FS_FAT_SEC_NBR            JournalStageSec;                  /* Journal sec held in staging buf.                     */
+    CPU_INT08U                JournalStageState;                /* Staging buf state (see 'fs_buf.h  DEFINES').         */
+#endif
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+    FS_DEV                   *JournalDevPtr;                    /* Journal dev (NULL if journal file on vol).           */
+    FS_SEC_NBR                JournalDevStart;                  /* First journal sec on journal dev.                    */
+#endif
 #endif
 
 #if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
@@ -646,6 +754,23 @@ struct  fs_fat_data {
                                                        ((sec_nbr) <= (p_fat_data)->RootDirStart + (p_fat_data)->RootDirSize + (p_fat_data)->DataSize)) ? (DEF_YES) : (DEF_NO))
 
 
+/*
+*********************************************************************************************************
+*                                      FS_FAT_VOL_CHK_MAP_SIZE()
+*
+* Description : Get size of work buffer needed to check a volume with 'FS_FAT_VolChkMap()'.
+*
+* Argument(s) : clus_cnt    Number of clusters in data area of volume.
+*
+* Return(s)   : Size of work buffer, in octets.
+*
+* Note(s)     : (1) The cluster usage map holds two bits per cluster.
+*********************************************************************************************************
+*/
+
+#define  FS_FAT_VOL_CHK_MAP_SIZE(clus_cnt)           ((CPU_SIZE_T)(((clus_cnt) + 3u) / 4u))
+
+
 /*
 *********************************************************************************************************
 *                                         FUNCTION PROTOTYPES
@@ -655,6 +780,23 @@ struct  fs_fat_data {
 #if (FS_FAT_CFG_VOL_CHK_EN == DEF_ENABLED)
 void             FS_FAT_VolChk                 (CPU_CHAR          *name_vol,    /* Check file system on volume.         */
                                                 FS_ERR            *p_err);
+
+void             FS_FAT_VolChkMap              (CPU_CHAR             *name_vol, /* Check clus alloc on volume.          */
+                                                void                 *p_map,
+                                                CPU_SIZE_T            map_size,
+                                                CPU_BOOLEAN           repair,
+                                                FS_FAT_VOL_CHK_INFO  *p_info,
+                                                FS_ERR               *p_err);
+#endif
+
+#if (FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED)
+CPU_BOOLEAN      FS_FAT_VolDirtyGet            (CPU_CHAR          *name_vol,    /* Get whether vol was dirty at open.   */
+                                                FS_ERR            *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void             FS_FAT_VolSync                (CPU_CHAR          *name_vol,    /* Mark vol clean.                      */
+                                                FS_ERR            *p_err);
+#endif
 #endif
 
 /*
@@ -670,6 +812,8 @@ void             FS_FAT_ModuleInit             (FS_QTY             vol_cnt,
 
 void             FS_FAT_VolClose               (FS_VOL            *p_vol);      /* Close a volume.                      */
 
+FS_SEC_SIZE      FS_FAT_VolClusSizeGet         (FS_VOL            *p_vol);      /* Get cluster size.                    */
+
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
 void             FS_FAT_VolFmt                 (FS_VOL            *p_vol,       /* Create a volume.                     */
                                                 void              *p_sys_cfg,
@@ -752,6 +896,10 @@ void             FS_FAT_LowEntryDel            (FS_VOL            *p_vol,
                                                 FS_BUF            *p_buf,
                                                 FS_FAT_FILE_DATA  *p_entry_data,
                                                 FS_ERR            *p_err);
+
+void             FS_FAT_LowEntryDelTree        (FS_VOL            *p_vol,       /* Del entry tree (low-level).          */
+                                                FS_FAT_FILE_DATA  *p_entry_data,
+                                                FS_ERR            *p_err);
 #endif
 
 void             FS_FAT_LowEntryFind           (FS_VOL            *p_vol,       /* Find entry (low-level).              */
@@ -838,6 +986,17 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainReverseFollow (FS_VOL            *p_vol,
                                                 FS_FAT_CLUS_NBR    stop_clus,
                                                 FS_ERR            *p_err);
 
+FS_FAT_CLUS_NBR  FS_FAT_ClusChainHintGet       (FS_VOL            *p_vol,       /* Get cluster chain end hint.          */
+                                                FS_FAT_CLUS_NBR    first_clus,
+                                                FS_FAT_CLUS_NBR   *p_clus_cnt);
+
+void             FS_FAT_ClusChainHintSet       (FS_VOL            *p_vol,       /* Set cluster chain end hint.          */
+                                                FS_FAT_CLUS_NBR    first_clus,
+                                                FS_FAT_CLUS_NBR    last_clus,
+                                                FS_FAT_CLUS_NBR    clus_cnt);
+
+void             FS_FAT_ClusChainHintClr       (FS_VOL            *p_vol);      /* Clr all cluster chain end hints.     */
+
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
 FS_FAT_CLUS_NBR  FS_FAT_ClusFreeFind           (FS_VOL            *p_vol,       /* Find free cluster.                   */
                                                 FS_BUF            *p_buf,
@@ -874,6 +1033,14 @@ void             FS_FAT_Query                  (FS_VOL            *p_vol,
                                                 FS_SYS_INFO       *p_info,
                                                 FS_ERR            *p_err);
 
+#if ((FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED) && (FS_CFG_RD_ONLY_EN == DEF_DISABLED))
+void             FS_FAT_VolDirtySet            (FS_VOL            *p_vol,       /* Mark vol dirty before wr.            */
+                                                void              *p_src,
+                                                FS_SEC_NBR         start,
+                                                FS_SEC_QTY         cnt,
+                                                FS_ERR            *p_err);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -189,8 +189,8 @@ void  FS_FAT_DirModuleInit (FS_QTY   dir_cnt,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The file system lock MUST be held to free the directory data back to the directory
-*                   data pool.
+* Note(s)     : (1) The file system lock 'FS_OS_LOCK_ID_DIR' MUST be held to free the directory data
+*                   back to the directory data pool.
 *********************************************************************************************************
 */
 
@@ -206,7 +206,7 @@ void  FS_FAT_DirClose (FS_DIR  *p_dir)
 
 
                                                                 /* ------------------- FREE DIR DATA ------------------ */
-    FS_OS_Lock(&err);                                           /* Acquire FS lock (see Note #1).                       */
+    FS_OS_Lock(FS_OS_LOCK_ID_DIR, &err);                        /* Acquire FS lock (see Note #1).                       */
     if (err != FS_ERR_NONE) {
         CPU_SW_EXCEPTION(;);                                    /* Fatal err.                                           */
     }
@@ -218,7 +218,7 @@ void  FS_FAT_DirClose (FS_DIR  *p_dir)
         CPU_SW_EXCEPTION(;);                                    /* Fatal err.                                           */
     }
 
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DIR);
 }
 
 
@@ -245,8 +245,8 @@ void  FS_FAT_DirClose (FS_DIR  *p_dir)
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The file system lock MUST be held to get the directory data from the directory data
-*                   pool.
+* Note(s)     : (1) The file system lock 'FS_OS_LOCK_ID_DIR' MUST be held to get the directory data
+*                   from the directory data pool.
 *********************************************************************************************************
 */
 
@@ -259,7 +259,7 @@ void  FS_FAT_DirOpen (FS_DIR    *p_dir,
 
 
                                                                 /* ------------------ ALLOC DIR DATA ------------------ */
-    FS_OS_Lock(p_err);                                          /* Acquire FS lock (see Note #1).                       */
+    FS_OS_Lock(FS_OS_LOCK_ID_DIR, p_err);                       /* Acquire FS lock (see Note #1).                       */
     if (*p_err != FS_ERR_NONE) {
         return;
     }
@@ -269,7 +269,7 @@ void  FS_FAT_DirOpen (FS_DIR    *p_dir,
                                                     &pool_err);
 
     (void)pool_err;                                            /* Err ignored. Ret val chk'd instead.                  */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DIR);
 
     if (p_dir_data == DEF_NULL) {
         return;
@@ -452,6 +452,94 @@ void  FS_FAT_EntryDel (FS_VOL       *p_vol,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                        FS_FAT_EntryDelTree()
+*
+* Description : Delete a file, or a directory & every entry in its tree.
+*
+* Argument(s) : p_vol       Pointer to volume on which the entry resides.
+*
+*               name_entry  Name of the entry.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                      Entry deleted successfully.
+*                               FS_ERR_BUF_NONE_AVAIL            Buffer not available.
+*                               FS_ERR_DEV                       Device access error.
+*                               FS_ERR_ENTRY_CORRUPT             File system entry is corrupt.
+*                               FS_ERR_ENTRY_NOT_FOUND           File system entry NOT found.
+*                               FS_ERR_ENTRY_OPEN                Open entry found in tree.
+*                               FS_ERR_ENTRY_PARENT_NOT_FOUND    Entry parent NOT found.
+*                               FS_ERR_ENTRY_PARENT_NOT_DIR      Entry parent NOT a directory.
+*                               FS_ERR_NAME_INVALID              Invalid file name or path.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The entry is found without being deleted, so that a non-empty directory is not
+*                   rejected; 'FS_FAT_LowEntryDelTree()' then deletes the entry & its tree.
+*
+*               (2) If journaling is enabled & journaling started, logs will be written (from
+*                   'FS_FAT_LowEntryDelTree()') to the journal so that each entry in the tree is either
+*                   fully deleted or not deleted at all.
+*
+*                   (a) Since this is a top level action, the journal must be cleared once it is finished
+*                       or after an error occurs.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FS_FAT_EntryDelTree (FS_VOL       *p_vol,
+                           CPU_CHAR     *name_entry,
+                           FS_ERR       *p_err)
+{
+    FS_FAT_FILE_DATA  entry_data;
+#ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
+    FS_BUF           *p_buf;
+    FS_ERR            err;
+#endif
+
+                                                                /* -------------------- FIND ENTRY -------------------- */
+    FS_FAT_LowEntryFind( p_vol,                                 /* See Note #1.                                         */
+                        &entry_data,
+                         name_entry,
+                        (FS_FAT_MODE_RD | FS_FAT_MODE_FILE | FS_FAT_MODE_DIR),
+                         p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+
+                                                                /* ------------------- DEL ENTRY TREE ----------------- */
+    FS_FAT_LowEntryDelTree( p_vol,
+                           &entry_data,
+                            p_err);
+
+
+                                                                /* -------------------- CLR JOURNAL ------------------- */
+#ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
+    p_buf = FSBuf_Get(p_vol);                                   /* Get buf.                                             */
+    if (p_buf == DEF_NULL) {
+        if (*p_err == FS_ERR_NONE) {
+           *p_err = FS_ERR_BUF_NONE_AVAIL;
+        }
+        return;
+    }
+
+    FS_FAT_JournalClrReset(p_vol, p_buf, &err);                 /* Clr journal (see Note #2a).                          */
+    if (err == FS_ERR_NONE) {                                   /* Flush & free buf.                                    */
+        FSBuf_Flush(p_buf, &err);
+    }
+    FSBuf_Free(p_buf);
+
+    if (*p_err == FS_ERR_NONE) {
+       *p_err = err;
+    }
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FS_FAT_EntryQuery()
@@ -120,6 +120,10 @@ void      FS_FAT_EntryDel      (FS_VOL         *p_vol,          /* Delete a file
                                 CPU_CHAR       *name_entry,
                                 FS_FLAGS        entry_type,
                                 FS_ERR         *p_err);
+
+void      FS_FAT_EntryDelTree  (FS_VOL         *p_vol,          /* Delete a file or directory tree.                     */
+                                CPU_CHAR       *name_entry,
+                                FS_ERR         *p_err);
 #endif
 
 void      FS_FAT_EntryQuery    (FS_VOL         *p_vol,          /* Delete a file or directory.                          */
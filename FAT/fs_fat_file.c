@@ -116,6 +116,39 @@ static  MEM_POOL  FS_FAT_FileDataPool;
 *********************************************************************************************************
 */
 
+static  CPU_SIZE_T  FS_FAT_FileDataRd      (FS_VOL          *p_vol,        /* Rd file data from sec pos.                   */
+                                            FS_BUF          *p_buf,
+                                            FS_FILE_IOV     *p_iov,
+                                            CPU_SIZE_T       size,
+                                            FS_FAT_SEC_NBR  *p_sec_cur,
+                                            FS_FAT_SEC_NBR  *p_sec_cur_pos,
+                                            FS_ERR          *p_err);
+
+static  void        FS_FAT_FileIOV_Scatter (FS_FILE_IOV     *p_iov,        /* Copy data from buf into I/O vectors.         */
+                                            FS_QTY          *p_iov_ix,
+                                            CPU_SIZE_T      *p_iov_pos,
+                                            CPU_INT08U      *p_src_08,
+                                            CPU_SIZE_T       size);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void        FS_FAT_FileIOV_Gather  (FS_FILE_IOV     *p_iov,        /* Copy data from I/O vectors into buf.         */
+                                            FS_QTY          *p_iov_ix,
+                                            CPU_SIZE_T      *p_iov_pos,
+                                            CPU_INT08U      *p_dest_08,
+                                            CPU_SIZE_T       size);
+#endif
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+static  void        FS_FAT_EntryCommitAdd   (FS_VOL            *p_vol,     /* Add file to vol commit list.                 */
+                                             FS_BUF            *p_buf,
+                                             FS_FAT_FILE_DATA  *p_fat_file_data,
+                                             FS_ERR            *p_err);
+
+static  void        FS_FAT_EntryCommitLocked(FS_VOL            *p_vol,     /* Wr pending dir entries of vol.               */
+                                             FS_BUF            *p_buf,
+                                             FS_ERR            *p_err);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -124,6 +157,169 @@ static  MEM_POOL  FS_FAT_FileDataPool;
 */
 
 
+/*
+*********************************************************************************************************
+*                                        FS_FAT_EntryCommit()
+*
+* Description : Write the pending directory entry updates of all files open on a volume.
+*
+* Argument(s) : name_vol    Volume name.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                 Directory entries committed.
+*                               FS_ERR_NAME_NULL            Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_BUF_NONE_AVAIL       No buffer available.
+*                               FS_ERR_DEV                  Device access error.
+*                               FS_ERR_VOL_NOT_OPEN         Volume not open.
+*                               FS_ERR_VOL_NOT_MOUNTED      Volume not mounted.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Directory entry updates are deferred only while a commit interval is set (see
+*                   'FS_FAT_EntryCommitIntervalSet()').  The updates of entries located in the same
+*                   directory sector are merged into a single sector write.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+void  FS_FAT_EntryCommit (CPU_CHAR  *name_vol,
+                          FS_ERR    *p_err)
+{
+    FS_VOL  *p_vol;
+    FS_BUF  *p_buf;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------ VALIDATE ARGS ------------------- */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == (CPU_CHAR *)0) {                            /* Validate vol name ptr.                               */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+#endif
+
+                                                                /* ------------------ ACQUIRE VOL LOCK ---------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);
+    if (p_vol == (FS_VOL *)0) {
+        return;
+    }
+
+    p_buf = FSBuf_Get(p_vol);
+    if (p_buf == (FS_BUF *)0) {
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
+
+                                                                /* ----------------- COMMIT DIR ENTRIES --------------- */
+    FS_FAT_EntryCommitLocked(p_vol, p_buf, p_err);
+
+    FSBuf_Free(p_buf);
+    FSVol_ReleaseUnlock(p_vol);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   FS_FAT_EntryCommitIntervalSet()
+*
+* Description : Set the interval at which the directory entries of files written on a volume are committed.
+*
+* Argument(s) : name_vol        Volume name.
+*
+*               interval_sec    Commit interval, in seconds, OR
+*                               0, if directory entries should be updated upon each write.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE                 Commit interval set.
+*                                   FS_ERR_NAME_NULL            Argument 'name_vol' passed a NULL pointer.
+*                                   FS_ERR_BUF_NONE_AVAIL       No buffer available.
+*                                   FS_ERR_DEV                  Device access error.
+*                                   FS_ERR_VOL_NOT_OPEN         Volume not open.
+*                                   FS_ERR_VOL_NOT_MOUNTED      Volume not mounted.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) While a commit interval is set, a write to a file opened without
+*                   'FS_FILE_ACCESS_MODE_CACHED' does NOT update the file's directory entry.  Instead, the
+*                   file is placed on the volume commit list & the entries of all listed files are written,
+*                   sorted by directory sector, by the first write after the interval has elapsed, upon a
+*                   call to 'FS_FAT_EntryCommit()' or when a listed file is closed.  Each entry is written
+*                   with the date & time of the file's last write.
+*
+*               (2) Elapsed time is measured with 'Clk_GetTS()'.  If the time stamp cannot be obtained,
+*                   deferred entries are committed only as described in Note #1 other than by elapsed time.
+*
+*               (3) Until committed, the directory entry of a file deferred on the commit list holds its
+*                   previous size & date; a power failure loses the pending updates, as for a cached file.
+*
+*                   (a) If journaling is enabled, the writes of listed files are NOT checkpointed : their
+*                       logs are kept in the journal until the batch is committed, & the journal is then
+*                       checkpointed once for the whole batch.  A power failure before that checkpoint
+*                       reverts the cluster allocations of the batch, so that no cluster chain is lost.
+*
+*                   (b) Any other journal checkpoint, e.g., at the end of another operation on the volume,
+*                       first writes the entries of all listed files (see 'fs_fat_journal.c
+*                       FS_FAT_JournalCkptWr()  Note #5').  The batch is also committed once half of the
+*                       journal is used.
+*
+*               (4) The commit interval is cleared when the volume is mounted.  Pending updates are
+*                   committed before the new interval takes effect.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+void  FS_FAT_EntryCommitIntervalSet (CPU_CHAR    *name_vol,
+                                     CPU_INT32U   interval_sec,
+                                     FS_ERR      *p_err)
+{
+    FS_VOL       *p_vol;
+    FS_BUF       *p_buf;
+    FS_FAT_DATA  *p_fat_data;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------ VALIDATE ARGS ------------------- */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == (CPU_CHAR *)0) {                            /* Validate vol name ptr.                               */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+#endif
+
+                                                                /* ------------------ ACQUIRE VOL LOCK ---------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);
+    if (p_vol == (FS_VOL *)0) {
+        return;
+    }
+
+    p_buf = FSBuf_Get(p_vol);
+    if (p_buf == (FS_BUF *)0) {
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
+
+                                                                /* ------------- COMMIT PENDING DIR ENTRIES ----------- */
+    FS_FAT_EntryCommitLocked(p_vol, p_buf, p_err);              /* See Note #4.                                         */
+
+    FSBuf_Free(p_buf);
+
+    if (*p_err == FS_ERR_NONE) {                                /* ------------------- SET INTERVAL ------------------- */
+        p_fat_data                 = (FS_FAT_DATA *)p_vol->DataPtr;
+        p_fat_data->CommitInterval =  interval_sec;
+    }
+
+    FSVol_ReleaseUnlock(p_vol);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                       FS_FAT_FileModuleInit()
@@ -189,7 +385,17 @@ void  FS_FAT_FileModuleInit (FS_QTY   file_cnt,
 *                               FS_ERR_NULL_PTR    Argument 'p_buf' is a NULL pointer.
 * Return(s)   : none.
 *
-* Note(s)     : (1) The file system lock MUST be held to free the file data back to the file data pool.
+* Note(s)     : (1) The file system lock 'FS_OS_LOCK_ID_FILE' MUST be held to free the file data back
+*                   to the file data pool.
+*
+*               (2) If the end of the cluster chain of a file opened for writing is known, it is recorded
+*                   as a hint for the next open of the file (see 'FS_FAT_FileOpen()  Note #5').
+*
+*               (3) If the directory entry update of an uncached file is pending on the volume commit list
+*                   (see 'FS_FAT_EntryCommitIntervalSet()'), the whole list is committed now, since the
+*                   journal checkpoint that commits the file's writes commits those of all listed files.
+*                   The file is removed from the list only once its entry has been written.  Otherwise,
+*                   the file data is NOT freed, so that the entry is written by a later commit.
 *********************************************************************************************************
 */
 
@@ -207,7 +413,24 @@ void  FS_FAT_FileClose  (FS_FILE  *p_file,
     p_fat_file_data = (FS_FAT_FILE_DATA *)p_file->DataPtr;
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)                         /* ------------------ UPDATE DIR SEC ------------------ */
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+    if (p_fat_file_data->CommitPend == DEF_YES) {               /* Commit vol commit list (see Note #3).                */
+        p_buf = FSBuf_Get(p_file->VolPtr);
+        if (p_buf == (FS_BUF *)0) {
+           *p_err = FS_ERR_NULL_PTR;
+            return;
+        }
+
+        FS_FAT_EntryCommitLocked(p_file->VolPtr, p_buf, p_err);
+        FSBuf_Free(p_buf);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+    }
+    if (DEF_BIT_IS_SET(p_fat_file_data->Mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+#else
     if (DEF_BIT_IS_SET(p_fat_file_data->Mode, FS_FILE_ACCESS_MODE_CACHED | FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+#endif
         if (p_fat_file_data->UpdateReqd == DEF_YES) {
             p_buf = FSBuf_Get(p_file->VolPtr);
             if (p_buf == (FS_BUF *)0) {
@@ -223,13 +446,21 @@ void  FS_FAT_FileClose  (FS_FILE  *p_file,
             FSBuf_Flush(p_buf, p_err);
             FSBuf_Free(p_buf);
         }
+    }
+                                                                /* ------------------ SAVE CHAIN END ------------------ */
+    if ((DEF_BIT_IS_SET(p_fat_file_data->Mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) &&
+        (p_fat_file_data->FileLastClus != 0u)) {                /* See Note #2.                                         */
+        FS_FAT_ClusChainHintSet(p_file->VolPtr,
+                                p_fat_file_data->FileFirstClus,
+                                p_fat_file_data->FileLastClus,
+                                p_fat_file_data->FileClusCnt);
     }
 #endif
 
 
 
                                                                 /* ------------------ FREE FILE DATA ------------------ */
-    FS_OS_Lock(&err);                                           /* Acquire FS lock (see Note #1).                       */
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, &err);                       /* Acquire FS lock (see Note #1).                       */
     if (err != FS_ERR_NONE) {
        *p_err = err;
         return;
@@ -239,14 +470,150 @@ void  FS_FAT_FileClose  (FS_FILE  *p_file,
                     (void *) p_fat_file_data,
                             &pool_err);
     if (pool_err != LIB_MEM_ERR_NONE) {
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
        *p_err = FS_ERR_MEM_ALLOC;
         return;
     }
 
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_FAT_FileMap()
+*
+* Description : Get direct memory addresses of file data.
+*
+* Argument(s) : p_file          Pointer to a file.
+*               ------          Argument validated by caller.
+*
+*               pos             File position of first octet to map.
+*
+*               p_extent_tbl    Pointer to table that will receive the extents.
+*               ------------    Argument validated by caller.
+*
+*               extent_cnt      Number of entries in 'p_extent_tbl'.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE                   File mapped.
+*                                   FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                                   FS_ERR_DEV                    Device access error.
+*                                   FS_ERR_DEV_INVALID_IO_CTRL    Device data is NOT memory-mapped.
+*                                   FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
+*
+* Return(s)   : Number of extents obtained.
+*
+* Note(s)     : (1) Each extent covers a run of consecutive clusters of the file's cluster chain.  The
+*                   first extent starts at 'pos', which need not be cluster-aligned; the last extent
+*                   of the file ends at the end of the file.
+*
+*               (2) As in 'FS_FAT_FileRdAt()', only the first cluster & the size of the file are used.
+*********************************************************************************************************
+*/
+
+FS_QTY  FS_FAT_FileMap (FS_FILE         *p_file,
+                        FS_FILE_SIZE     pos,
+                        FS_FILE_EXTENT  *p_extent_tbl,
+                        FS_QTY           extent_cnt,
+                        FS_ERR          *p_err)
+{
+    FS_FAT_CLUS_NBR    clus;
+    FS_FAT_CLUS_NBR    clus_next;
+    FS_FAT_SEC_NBR     sec;
+    FS_FILE_SIZE       pos_clus;
+    FS_FILE_SIZE       size_rem;
+    CPU_SIZE_T         size;
+    FS_QTY             cnt;
+    CPU_INT08U        *p_addr;
+    FS_BUF            *p_buf;
+    FS_VOL            *p_vol;
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_fat_file_data;
+
+
+    p_vol           = p_file->VolPtr;
+    p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
+    p_fat_data      = (FS_FAT_DATA      *)(p_vol->DataPtr);
 
    *p_err = FS_ERR_NONE;
+                                                                /* If first sec zero (no data) or pos past EOF ...      */
+    if ((p_fat_file_data->FileFirstClus == 0u) ||
+        (pos                            >= p_fat_file_data->FileSize)) {
+        return (0u);                                            /* ... no extent.                                       */
+    }
+
+    p_buf = FSBuf_Get(p_vol);                                   /* Get FAT buf.                                         */
+    if (p_buf == (FS_BUF *)0) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return (0u);
+    }
+
+
+                                                                /* ------------------- FIND POS CLUS ------------------ */
+    clus = FS_FAT_ClusChainFollow(p_vol,
+                                  p_buf,
+                                  p_fat_file_data->FileFirstClus,
+                                  FS_UTIL_DIV_PWR2(pos, p_fat_data->ClusSizeLog2_octet),
+                                  DEF_NULL,
+                                  p_err);
+
+
+                                                                /* -------------------- MAP EXTENTS ------------------- */
+    cnt = 0u;
+    while ((*p_err == FS_ERR_NONE              ) &&
+           ( cnt    <  extent_cnt              ) &&
+           ( pos    <  p_fat_file_data->FileSize)) {
+        pos_clus = pos & (p_fat_data->ClusSize_octet - 1u);
+        sec      = FS_FAT_CLUS_TO_SEC(p_fat_data, clus)
+                 + FS_UTIL_DIV_PWR2(pos_clus, p_fat_data->SecSizeLog2);
+        p_addr   = (CPU_INT08U *)FSVol_AddrGetLocked(p_vol, sec, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            break;
+        }
+        p_addr  += pos & (p_fat_data->SecSize - 1u);
+
+        size_rem = p_fat_file_data->FileSize - pos;
+        size     = p_fat_data->ClusSize_octet - pos_clus;      /* Rem octets in first clus.                            */
+        while (size < size_rem) {                               /* Extend extent across consecutive clus's.             */
+            clus_next = FS_FAT_ClusNextGet(p_vol, p_buf, clus, p_err);
+            if (*p_err != FS_ERR_NONE) {
+                break;
+            }
+            if (clus_next != clus + 1u) {                       /* Next clus starts next extent.                        */
+                clus = clus_next;
+                break;
+            }
+            clus  = clus_next;
+            size += p_fat_data->ClusSize_octet;
+        }
+        if (*p_err != FS_ERR_NONE) {
+            break;
+        }
+        if (size > size_rem) {
+            size = (CPU_SIZE_T)size_rem;                        /* Last extent ends at EOF.                             */
+        }
+
+        p_extent_tbl[cnt].Pos     = pos;
+        p_extent_tbl[cnt].AddrPtr = (void *)p_addr;
+        p_extent_tbl[cnt].Size    = size;
+
+        pos += size;
+        cnt++;
+    }
+
+    FSBuf_Free(p_buf);
+
+    if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END_EARLY) ||          /* Chain shorter than file size.                        */
+        (*p_err == FS_ERR_SYS_CLUS_CHAIN_END      ) ||
+        (*p_err == FS_ERR_SYS_CLUS_INVALID        )) {
+        *p_err =  FS_ERR_ENTRY_CORRUPT;
+    }
+
+    return (cnt);
 }
 
 
@@ -280,7 +647,8 @@ void  FS_FAT_FileClose  (FS_FILE  *p_file,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The file system lock MUST be held to get the file data from the file data pool.
+* Note(s)     : (1) The file system lock 'FS_OS_LOCK_ID_FILE' MUST be held to get the file data from
+*                   the file data pool.
 *
 *               (2) (a) If long file names are NOT used :
 *
@@ -325,6 +693,10 @@ void  FS_FAT_FileClose  (FS_FILE  *p_file,
 *
 *                   (c) Since this is a top level action, the journal must be cleared once it is finished
 *                       or after an error occurs.
+*
+*               (5) The end of the file's cluster chain is taken from the hint recorded when the file was
+*                   last closed, if any (see 'FS_FAT_ClusChainHintGet()  Note #1'), so that a file that is
+*                   repeatedly reopened to be appended to is not followed to its end on every open.
 *********************************************************************************************************
 */
 
@@ -341,7 +713,7 @@ void  FS_FAT_FileOpen (FS_FILE   *p_file,
 
 
                                                                 /* ------------------ ALLOC FILE DATA ----------------- */
-    FS_OS_Lock(p_err);                                          /* Acquire FS lock (see Note #1).                       */
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, p_err);                      /* Acquire FS lock (see Note #1).                       */
     if (*p_err != FS_ERR_NONE) {
         return;
     }
@@ -350,7 +722,7 @@ void  FS_FAT_FileOpen (FS_FILE   *p_file,
                                                       sizeof(FS_FAT_FILE_DATA),
                                                      &pool_err);
     (void)pool_err;                                            /* Err ignored. Ret val chk'd instead.                  */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
 
 
     if (p_file_data == (FS_FAT_FILE_DATA *)0) {
@@ -361,7 +733,9 @@ void  FS_FAT_FileOpen (FS_FILE   *p_file,
 
 
                                                                 /* --------------------- OPEN FILE -------------------- */
-    p_file->DataPtr = (void *)p_file_data;
+    p_file->DataPtr           = (void *)p_file_data;
+    p_file_data->FileLastClus =  0u;
+    p_file_data->FileClusCnt  =  0u;
     FS_FAT_LowEntryFind( p_file->VolPtr,
                          p_file_data,
                          name_file,
@@ -373,6 +747,12 @@ void  FS_FAT_FileOpen (FS_FILE   *p_file,
          return;
     }
 
+#if (FS_CFG_CONCURRENT_ENTRIES_ACCESS_EN == DEF_DISABLED)
+    p_file_data->FileLastClus = FS_FAT_ClusChainHintGet( p_file->VolPtr,  /* Get chain end (see Note #5).           */
+                                                         p_file_data->FileFirstClus,
+                                                        &p_file_data->FileClusCnt);
+#endif
+
 #ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
     p_buf = FSBuf_Get(p_file->VolPtr);                          /* Get buf.                                             */
     if (p_buf == DEF_NULL) {
@@ -438,6 +818,10 @@ void  FS_FAT_FileOpen (FS_FILE   *p_file,
 *               (4) Position can only be set in the existing portion of a file. If the position is set
 *                   after the file size, the code must call FS_FAT_FileWr() instead to correctly
 *                   allocate clusters and fill data region with '0'.
+*
+*               (5) If the chain end is known (see 'FS_FAT_FileWrV()  Note #5') & the new position lies
+*                   in the last cluster of the chain, as when a file is appended to, the chain is NOT
+*                   followed.
 *********************************************************************************************************
 */
 
@@ -518,17 +902,22 @@ void  FS_FAT_FilePosSet (FS_FILE       *p_file,
 
 
     } else {                                                    /* ----- POS BEFORE LAST CLUS, NOT FIRST, NOT CUR ----- */
-                                                                /* Move to last known clus.                             */
-        clus = FS_FAT_ClusChainFollow(p_file->VolPtr,
-                                      p_buf,
-                                      p_fat_file_data->FileFirstClus,
-                                     (clus_cnt_new - 1u),
-                                      DEF_NULL,
-                                      p_err);
+        if ((p_fat_file_data->FileLastClus != 0u) &&            /* If pos in last clus of chain ...                     */
+            (p_fat_file_data->FileClusCnt  == clus_cnt_new)) {
+            clus = p_fat_file_data->FileLastClus;               /* ... use chain end (see Note #5).                     */
+
+        } else {                                                /* Move to last known clus.                             */
+            clus = FS_FAT_ClusChainFollow(p_file->VolPtr,
+                                          p_buf,
+                                          p_fat_file_data->FileFirstClus,
+                                         (clus_cnt_new - 1u),
+                                          DEF_NULL,
+                                          p_err);
 
-        if (*p_err != FS_ERR_NONE) {
-             FSBuf_Free(p_buf);
-             return;
+            if (*p_err != FS_ERR_NONE) {
+                 FSBuf_Free(p_buf);
+                 return;
+            }
         }
 
         sec_new = FS_FAT_CLUS_TO_SEC(p_fat_data, clus) + clus_pos_new_sec;
@@ -549,81 +938,251 @@ void  FS_FAT_FilePosSet (FS_FILE       *p_file,
 
 /*
 *********************************************************************************************************
-*                                         FS_FAT_FileQuery()
+*                                        FS_FAT_FilePrealloc()
 *
-* Description : Get information about a file.
+* Description : Allocate clusters to a file ahead of the writes that will use them.
 *
 * Argument(s) : p_file      Pointer to a file.
 *               ------      Argument validated by caller.
 *
-*               p_info      Pointer to structure that will receive the file information.
-*               ------      Pointer validated by caller.
+*               size        Number of octets the file's cluster chain must be able to hold.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                               FS_ERR_NONE              File information obtained successful.
+*                               FS_ERR_NONE              Clusters allocated successfully.
 *                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
 *                               FS_ERR_DEV               Device access error.
+*                               FS_ERR_DEV_FULL          Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT     File system entry is corrupt.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The file size & position are NOT changed.  Clusters already in the file's chain are
+*                   used by the writes that follow, which then need not allocate any (see
+*                   'FS_FAT_FileWrV()  Note #2').
+*
+*               (2) All missing clusters are allocated by a single call to 'FS_FAT_ClusChainAlloc()',
+*                   which takes free clusters in sequence, so the chain is contiguous as long as the free
+*                   space is.
+*
+*               (3) If the file had no cluster, the new first cluster is written to the dir entry right
+*                   away (or when the file is closed, if the file is cached) so that the clusters are
+*                   still reachable from the entry should the data never be written.
+*
+*               (4) Since this is a top level action, the journal must be cleared once it is finished.
 *********************************************************************************************************
 */
 
-void  FS_FAT_FileQuery (FS_FILE        *p_file,
-                        FS_ENTRY_INFO  *p_info,
-                        FS_ERR         *p_err)
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FS_FAT_FilePrealloc (FS_FILE       *p_file,
+                           FS_FILE_SIZE   size,
+                           FS_ERR        *p_err)
 {
-    FS_FLAGS           fat_attrib;
-    FS_FLAGS           fs_attrib;
-    FS_FAT_FILE_DATA  *p_fat_file_data;
+    FS_FAT_CLUS_NBR    clus_start;
+    FS_FAT_CLUS_NBR    clus_last;
+    FS_FAT_CLUS_NBR    clus_cnt;
+    FS_FAT_CLUS_NBR    clus_nbr;
+    FS_BUF            *p_buf;
     FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_fat_file_data;
 
 
-    p_fat_data      = (FS_FAT_DATA      *)(p_file->VolPtr->DataPtr);
     p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
-
-
-                                                                /* ------------------- FILE ATTRIB'S ------------------ */
-    fat_attrib = p_fat_file_data->Attrib;
-    fs_attrib  = 0u;
-    DEF_BIT_SET(fs_attrib, FS_ENTRY_ATTRIB_RD);
-    if (DEF_BIT_IS_CLR(fat_attrib, FS_FAT_DIRENT_ATTR_READ_ONLY) == DEF_YES) {
-        DEF_BIT_SET(fs_attrib, FS_ENTRY_ATTRIB_WR);             /* NOT read only.                                       */
-    }
-    if (DEF_BIT_IS_SET(fat_attrib, FS_FAT_DIRENT_ATTR_HIDDEN   ) == DEF_YES) {
-        DEF_BIT_SET(fs_attrib, FS_ENTRY_ATTRIB_HIDDEN);         /* Hidden.                                              */
-    }
-    if (DEF_BIT_IS_SET(fat_attrib, FS_FAT_DIRENT_ATTR_DIRECTORY) == DEF_YES) {
-        DEF_BIT_SET(fs_attrib, FS_ENTRY_ATTRIB_DIR);            /* Directory.                                           */
+    p_fat_data      = (FS_FAT_DATA      *)(p_file->VolPtr->DataPtr);
+                                                                /* Nbr of clus needed to hold size.                     */
+    clus_nbr = (size > 0u) ? (FS_UTIL_DIV_PWR2(size - 1u, p_fat_data->ClusSizeLog2_octet) + 1u) : (0u);
+    if (clus_nbr == 0u) {
+       *p_err = FS_ERR_NONE;
+        return;
     }
-    p_info->Attrib = fs_attrib;
-
 
+    p_buf = FSBuf_Get(p_file->VolPtr);
+    if (p_buf == (FS_BUF *)0) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
 
-                                                                /* --------------------- FILE SIZE -------------------- */
-    p_info->Size    =  p_fat_file_data->FileSize;               /* File size.                                           */
-    p_info->BlkSize =  p_fat_data->ClusSize_octet;              /* Blk size (bytes per clus) & nbr blks (nbr clus).     */
-    p_info->BlkCnt  = (p_fat_file_data->FileSize == 0u) ? (FS_UTIL_DIV_PWR2(p_fat_file_data->FileSize - 1u, p_fat_data->ClusSizeLog2_octet) + 1u) : (0u);
 
+                                                                /* ------------------ FIND CHAIN END ------------------ */
+    clus_last = 0u;
+    clus_cnt  = 0u;
+    if (p_fat_file_data->FileFirstClus != 0u) {
+        if (p_fat_file_data->FileLastClus != 0u) {              /* If chain end known ...                               */
+            clus_last = p_fat_file_data->FileLastClus;          /* ... chain len is known.                              */
+            clus_cnt  = p_fat_file_data->FileClusCnt;
 
+        } else {                                                /* Otherwise, follow clus chain until end.              */
+            clus_last = FS_FAT_ClusChainEndFind(p_file->VolPtr,
+                                                p_buf,
+                                                p_fat_file_data->FileFirstClus,
+                                               &clus_cnt,
+                                                p_err);
+            if (*p_err != FS_ERR_NONE) {
+                if (*p_err == FS_ERR_SYS_CLUS_INVALID) {
+                    *p_err = FS_ERR_ENTRY_CORRUPT;
+                }
+                FSBuf_Free(p_buf);
+                return;
+            }
+            clus_cnt++;                                         /* Cnt first clus.                                      */
+        }
+    }
 
-                                                                /* ----------------- FILE DATE & TIME ----------------- */
-    FS_FAT_DateTimeParse(&p_info->DateTimeCreate,               /* Creation date/time.                                  */
-                          p_fat_file_data->DateCreate,
-                          p_fat_file_data->TimeCreate);
+    if (clus_nbr <= clus_cnt) {                                 /* If chain already long enough ...                     */
+        FSBuf_Free(p_buf);
+       *p_err = FS_ERR_NONE;                                    /* ... nothing to do.                                   */
+        return;
+    }
 
-    FS_FAT_DateTimeParse(&p_info->DateTimeWr,                   /* Wr       date/time.                                  */
-                          p_fat_file_data->DateWr,
-                          p_fat_file_data->TimeWr);
 
-    FS_FAT_DateTimeParse(&p_info->DateAccess,                   /* Access   date.                                       */
-                          p_fat_file_data->DateAccess,
-                          0u);
+                                                                /* ------------------ ALLOC CLUS'S -------------------- */
+    clus_start = FS_FAT_ClusChainAlloc(p_file->VolPtr,          /* Alloc missing clus's (see Note #2).                  */
+                                       p_buf,
+                                       clus_last,
+                                       clus_nbr - clus_cnt,
+                                       p_err);
+    if (*p_err == FS_ERR_NONE) {
+        FSBuf_Flush(p_buf, p_err);
+    }
+    if (*p_err != FS_ERR_NONE) {
+        p_fat_file_data->FileLastClus = 0u;                     /* Chain end unknown after failed alloc.                */
+        FSBuf_Free(p_buf);
+        return;
+    }
 
-   *p_err = FS_ERR_NONE;
-}
+    if (clus_last == 0u) {                                      /* If new chain ...                                     */
+        clus_last = clus_start;
+                                                                /* ... set first clus & cur sec of file.                */
+        p_fat_file_data->FileFirstClus = clus_start;
+        p_fat_file_data->FileCurSec    = FS_FAT_CLUS_TO_SEC(p_fat_data, clus_start);
+        p_fat_file_data->FileCurSecPos = 0u;
+
+                                                                /* ... & update dir entry (see Note #3).                */
+        if (DEF_BIT_IS_CLR(p_fat_file_data->Mode, FS_FILE_ACCESS_MODE_CACHED) == DEF_YES) {
+            FS_FAT_LowEntryUpdate(p_file->VolPtr,
+                                  p_buf,
+                                  p_fat_file_data,
+                                  DEF_YES,
+                                  p_err);
+            if (*p_err != FS_ERR_NONE) {
+                FSBuf_Free(p_buf);
+                return;
+            }
+        } else {
+            p_fat_file_data->UpdateReqd = DEF_YES;
+        }
+    }
+
+#if (FS_CFG_CONCURRENT_ENTRIES_ACCESS_EN == DEF_DISABLED)
+                                                                /* Save chain end (see 'FS_FAT_FileWrV()  Note #5b').   */
+    clus_last = FS_FAT_ClusChainEndFind(p_file->VolPtr,
+                                        p_buf,
+                                        clus_last,
+                                        DEF_NULL,
+                                        p_err);
+    if (*p_err != FS_ERR_NONE) {
+        p_fat_file_data->FileLastClus = 0u;
+        FSBuf_Free(p_buf);
+        return;
+    }
+
+    p_fat_file_data->FileLastClus = clus_last;
+    p_fat_file_data->FileClusCnt  = clus_nbr;
+#endif
+
+
+                                                                /* -------------------- CLR JOURNAL ------------------- */
+#ifdef FS_FAT_JOURNAL_MODULE_PRESENT
+    FS_FAT_JournalClrReset(p_file->VolPtr, p_buf, p_err);       /* See Note #4.                                         */
+    if (*p_err != FS_ERR_NONE) {
+        FSBuf_Free(p_buf);
+        return;
+    }
+#endif
+
+    FSBuf_Flush(p_buf, p_err);
+    FSBuf_Free(p_buf);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FS_FAT_FileQuery()
+*
+* Description : Get information about a file.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_info      Pointer to structure that will receive the file information.
+*               ------      Pointer validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              File information obtained successful.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  FS_FAT_FileQuery (FS_FILE        *p_file,
+                        FS_ENTRY_INFO  *p_info,
+                        FS_ERR         *p_err)
+{
+    FS_FLAGS           fat_attrib;
+    FS_FLAGS           fs_attrib;
+    FS_FAT_FILE_DATA  *p_fat_file_data;
+    FS_FAT_DATA       *p_fat_data;
+
+
+    p_fat_data      = (FS_FAT_DATA      *)(p_file->VolPtr->DataPtr);
+    p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
+
+
+                                                                /* ------------------- FILE ATTRIB'S ------------------ */
+    fat_attrib = p_fat_file_data->Attrib;
+    fs_attrib  = 0u;
+    DEF_BIT_SET(fs_attrib, FS_ENTRY_ATTRIB_RD);
+    if (DEF_BIT_IS_CLR(fat_attrib, FS_FAT_DIRENT_ATTR_READ_ONLY) == DEF_YES) {
+        DEF_BIT_SET(fs_attrib, FS_ENTRY_ATTRIB_WR);             /* NOT read only.                                       */
+    }
+    if (DEF_BIT_IS_SET(fat_attrib, FS_FAT_DIRENT_ATTR_HIDDEN   ) == DEF_YES) {
+        DEF_BIT_SET(fs_attrib, FS_ENTRY_ATTRIB_HIDDEN);         /* Hidden.                                              */
+    }
+    if (DEF_BIT_IS_SET(fat_attrib, FS_FAT_DIRENT_ATTR_DIRECTORY) == DEF_YES) {
+        DEF_BIT_SET(fs_attrib, FS_ENTRY_ATTRIB_DIR);            /* Directory.                                           */
+    }
+    p_info->Attrib = fs_attrib;
+
+
+
+                                                                /* --------------------- FILE SIZE -------------------- */
+    p_info->Size    =  p_fat_file_data->FileSize;               /* File size.                                           */
+    p_info->BlkSize =  p_fat_data->ClusSize_octet;              /* Blk size (bytes per clus) & nbr blks (nbr clus).     */
+    p_info->BlkCnt  = (p_fat_file_data->FileSize == 0u) ? (FS_UTIL_DIV_PWR2(p_fat_file_data->FileSize - 1u, p_fat_data->ClusSizeLog2_octet) + 1u) : (0u);
+
+
+
+                                                                /* ----------------- FILE DATE & TIME ----------------- */
+    FS_FAT_DateTimeParse(&p_info->DateTimeCreate,               /* Creation date/time.                                  */
+                          p_fat_file_data->DateCreate,
+                          p_fat_file_data->TimeCreate);
+
+    FS_FAT_DateTimeParse(&p_info->DateTimeWr,                   /* Wr       date/time.                                  */
+                          p_fat_file_data->DateWr,
+                          p_fat_file_data->TimeWr);
+
+    FS_FAT_DateTimeParse(&p_info->DateAccess,                   /* Access   date.                                       */
+                          p_fat_file_data->DateAccess,
+                          0u);
+
+   *p_err = FS_ERR_NONE;
+}
 
 
 /*
@@ -654,6 +1213,8 @@ void  FS_FAT_FileQuery (FS_FILE        *p_file,
 *                   reaches the end of a sector.  In this case, 'FileCurSecPos' will equal the sector
 *                   size; such a condition MUST be checked at the beginning of any file read/write so
 *                   that the current sector number can be determined.
+*
+*               (2) The read is performed by 'FS_FAT_FileRdV()' with a single I/O vector.
 *********************************************************************************************************
 */
 
@@ -662,242 +1223,220 @@ CPU_SIZE_T  FS_FAT_FileRd (FS_FILE     *p_file,
                            CPU_SIZE_T   size,
                            FS_ERR      *p_err)
 {
-    FS_FAT_SEC_NBR     clus_cur_sec_rem;
-    FS_FAT_SEC_NBR     sec_cnt_rd;
-    FS_FAT_SEC_NBR     sec_cnt_rem;
+    FS_FILE_IOV  iov;
+    CPU_SIZE_T   size_rd;
+
+
+    iov.BufPtr = p_dest;
+    iov.Size   = size;
+
+    size_rd = FS_FAT_FileRdV(p_file, &iov, 1u, p_err);
+    return (size_rd);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_FAT_FileRdAt()
+*
+* Description : Read from a file at a given position, without changing the file position.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_dest      Pointer to destination buffer.
+*               ------      Argument validated by caller.
+*
+*               size        Number of octets to read.
+*
+*               pos         File position of first octet to read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              File read successful.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*                               FS_ERR_ENTRY_CORRUPT     File system entry corrupt.
+*
+* Return(s)   : Number of bytes read, if file read successful.
+*               0,                    otherwise.
+*
+* Note(s)     : (1) Only the first cluster & the size of the file are used.  The file's current sector
+*                   & position are neither read nor modified, so several positional reads of the same
+*                   file may be performed concurrently while the volume is locked in shared mode.
+*
+*               (2) The cluster chain is followed from the first cluster of the file up to the cluster
+*                   containing 'pos'.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FS_FAT_FileRdAt (FS_FILE       *p_file,
+                             void          *p_dest,
+                             CPU_SIZE_T     size,
+                             FS_FILE_SIZE   pos,
+                             FS_ERR        *p_err)
+{
+    FS_FAT_CLUS_NBR    clus;
     FS_FAT_SEC_NBR     sec_cur;
-    FS_FAT_SEC_NBR     sec_next;
     FS_FAT_SEC_NBR     sec_cur_pos;
     CPU_SIZE_T         size_rd;
-    CPU_SIZE_T         size_rem;
+    FS_FILE_IOV        iov;
     FS_BUF            *p_buf;
-    CPU_INT08U        *p_dest_08;
     FS_FAT_DATA       *p_fat_data;
     FS_FAT_FILE_DATA  *p_fat_file_data;
-    CPU_INT08U        *p_temp_08;
 
 
-                                                                /* ------------------ PREPARE FOR RD ------------------ */
-    p_buf = FSBuf_Get(p_file->VolPtr);                          /* Get rd buf.                                          */
-    if (p_buf == (FS_BUF *)0) {
-       *p_err = FS_ERR_BUF_NONE_AVAIL;
-        return (0u);
-    }
     p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
     p_fat_data      = (FS_FAT_DATA      *)(p_file->VolPtr->DataPtr);
-    p_dest_08       = (CPU_INT08U       *)(p_dest);
 
-                                                                /* If first sec zero (no data) or file pos past EOF ... */
-    if ((p_fat_file_data->FileFirstClus == 0u)                        ||
-        (p_fat_file_data->FilePos       >= p_fat_file_data->FileSize)) {
-        FSBuf_Free(p_buf);
-       *p_err           = FS_ERR_NONE;
+                                                                /* If first sec zero (no data) or pos past EOF ...      */
+    if ((p_fat_file_data->FileFirstClus == 0u) ||
+        (pos                            >= p_fat_file_data->FileSize)) {
+       *p_err = FS_ERR_NONE;
         return (0u);
     }
                                                                 /* Truncate file rd to file rem.                        */
-    if (size > (p_fat_file_data->FileSize - p_fat_file_data->FilePos)) {
-        size = (p_fat_file_data->FileSize - p_fat_file_data->FilePos);
+    if (size > (p_fat_file_data->FileSize - pos)) {
+        size = (p_fat_file_data->FileSize - pos);
     }
 
-    if (size == 0u) {
-        FSBuf_Free(p_buf);
-       *p_err           = FS_ERR_NONE;
+    p_buf = FSBuf_Get(p_file->VolPtr);                          /* Get rd buf.                                          */
+    if (p_buf == (FS_BUF *)0) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
         return (0u);
     }
 
-    size_rem         = size;
-    sec_cur          = p_fat_file_data->FileCurSec;
-    sec_cur_pos      = p_fat_file_data->FileCurSecPos;
-    clus_cur_sec_rem = FS_FAT_CLUS_SEC_REM(p_fat_data, sec_cur);
-
-    if (sec_cur_pos == p_fat_data->SecSize) {                   /* Sec pos at end of sec (so move to start of next).    */
-        sec_cur_pos = 0u;
-        sec_cur     = FS_FAT_SecNextGet(p_file->VolPtr,
-                                        p_buf,
-                                        sec_cur,
-                                        p_err);
 
-        if (*p_err != FS_ERR_NONE) {
-            if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END) ||
-                (*p_err == FS_ERR_SYS_CLUS_INVALID)) {
-                 *p_err =  FS_ERR_ENTRY_CORRUPT;
-            }
-            FSBuf_Free(p_buf);
-            return (0u);
+                                                                /* ------------------- FIND POS SEC ------------------- */
+    clus = FS_FAT_ClusChainFollow(p_file->VolPtr,               /* See Note #2.                                         */
+                                  p_buf,
+                                  p_fat_file_data->FileFirstClus,
+                                  FS_UTIL_DIV_PWR2(pos, p_fat_data->ClusSizeLog2_octet),
+                                  DEF_NULL,
+                                  p_err);
+    if (*p_err != FS_ERR_NONE) {
+        if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END_EARLY) ||
+            (*p_err == FS_ERR_SYS_CLUS_INVALID)) {
+             *p_err =  FS_ERR_ENTRY_CORRUPT;
         }
-
-        clus_cur_sec_rem = FS_FAT_CLUS_SEC_REM(p_fat_data, sec_cur);
+        FSBuf_Free(p_buf);
+        return (0u);
     }
 
+    sec_cur     = FS_FAT_CLUS_TO_SEC(p_fat_data, clus)
+                + FS_UTIL_DIV_PWR2(pos & (p_fat_data->ClusSize_octet - 1u), p_fat_data->SecSizeLog2);
+    sec_cur_pos = pos & (p_fat_data->SecSize - 1u);
 
 
-                                                                /* ------------- PARTIAL (INITIAL) SEC RD ------------- */
-    if (sec_cur_pos != 0u) {
-        FSVol_RdLockedEx(p_file->VolPtr,                        /* Rd full sec.                                         */
-                         p_buf->DataPtr,
-                         sec_cur,
-                         1u,
-                         FS_VOL_SEC_TYPE_FILE,
-                         p_err);
+                                                                /* ---------------------- RD DATA --------------------- */
+    iov.BufPtr = p_dest;
+    iov.Size   = size;
 
-        if (*p_err != FS_ERR_NONE) {
-            FSBuf_Free(p_buf);
-            p_fat_file_data->FileCurSec     = sec_cur;
-            p_fat_file_data->FileCurSecPos  = sec_cur_pos;
-            p_fat_file_data->FilePos       += size - size_rem;
-            return (size - size_rem);
-        }
+    size_rd = FS_FAT_FileDataRd(p_file->VolPtr,
+                                p_buf,
+                               &iov,
+                                size,
+                               &sec_cur,
+                               &sec_cur_pos,
+                                p_err);
 
-                                                                /* More rd octets that bytes in partial sec.            */
-        size_rd = DEF_MIN(size_rem, p_fat_data->SecSize - sec_cur_pos);
+    FSBuf_Free(p_buf);
 
-        p_temp_08 = (CPU_INT08U *)p_buf->DataPtr + sec_cur_pos;
-        Mem_Copy((void     *)p_dest_08,                         /* Copy partial sec data.                               */
-                 (void     *)p_temp_08,
-                 (CPU_SIZE_T)size_rd);
+    return (size_rd);
+}
 
-        size_rem    -= size_rd;
-        p_dest_08   += size_rd;
-        sec_cur_pos += size_rd;
-        clus_cur_sec_rem--;
 
-        if (size_rem > 0u) {                                    /* If more rd octets, get next sec nbr.                 */
-            sec_cur_pos = 0u;
-            sec_cur     = FS_FAT_SecNextGet(p_file->VolPtr,
-                                            p_buf,
-                                            sec_cur,
-                                            p_err);
+/*
+*********************************************************************************************************
+*                                          FS_FAT_FileRdV()
+*
+* Description : Read from a file into several buffers.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_iov       Pointer to array of I/O vectors describing destination buffers.
+*               -----       Argument validated by caller.
+*
+*               iov_cnt     Number of I/O vectors.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              File read successful.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*                               FS_ERR_ENTRY_CORRUPT     File system entry corrupt.
+*
+* Return(s)   : Number of bytes read, if file read successful.
+*               0,                    otherwise.
+*
+* Note(s)     : (1) See 'FS_FAT_FileRd()  Note #1'.
+*
+*               (2) See 'FS_FAT_FileDataRd()  Notes #3 & #4'.
+*********************************************************************************************************
+*/
 
-            if (*p_err != FS_ERR_NONE) {
-                if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END) ||
-                    (*p_err == FS_ERR_SYS_CLUS_INVALID)) {
-                     *p_err =  FS_ERR_ENTRY_CORRUPT;
-                }
-                FSBuf_Free(p_buf);
-                p_fat_file_data->FileCurSec     = sec_cur;
-                p_fat_file_data->FileCurSecPos  = sec_cur_pos;
-                p_fat_file_data->FilePos       += size - size_rem;
-                return (size - size_rem);
-            }
+CPU_SIZE_T  FS_FAT_FileRdV (FS_FILE      *p_file,
+                            FS_FILE_IOV  *p_iov,
+                            FS_QTY        iov_cnt,
+                            FS_ERR       *p_err)
+{
+    FS_FAT_SEC_NBR     sec_cur;
+    FS_FAT_SEC_NBR     sec_cur_pos;
+    CPU_SIZE_T         size;
+    CPU_SIZE_T         size_rd;
+    FS_QTY             iov_ix;
+    FS_BUF            *p_buf;
+    FS_FAT_FILE_DATA  *p_fat_file_data;
 
-            clus_cur_sec_rem = FS_FAT_CLUS_SEC_REM(p_fat_data, sec_cur);
-        }
+
+                                                                /* ------------------ PREPARE FOR RD ------------------ */
+    p_buf = FSBuf_Get(p_file->VolPtr);                          /* Get rd buf.                                          */
+    if (p_buf == (FS_BUF *)0) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return (0u);
     }
+    p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
 
-    sec_next = 0u;
+    size = 0u;                                                  /* Calc total rd size.                                  */
+    for (iov_ix = 0u; iov_ix < iov_cnt; iov_ix++) {
+        size += p_iov[iov_ix].Size;
+    }
 
-    while (size_rem > 0u) {
-        sec_cnt_rem = FS_UTIL_DIV_PWR2(size_rem, p_fat_data->SecSizeLog2);
-        if (sec_cnt_rem > 0u) {                                 /* ------------------- FULL SEC RDs ------------------- */
+                                                                /* If first sec zero (no data) or file pos past EOF ... */
+    if ((p_fat_file_data->FileFirstClus == 0u)                        ||
+        (p_fat_file_data->FilePos       >= p_fat_file_data->FileSize)) {
+        FSBuf_Free(p_buf);
+       *p_err           = FS_ERR_NONE;
+        return (0u);
+    }
+                                                                /* Truncate file rd to file rem.                        */
+    if (size > (p_fat_file_data->FileSize - p_fat_file_data->FilePos)) {
+        size = (p_fat_file_data->FileSize - p_fat_file_data->FilePos);
+    }
 
-            sec_cnt_rd = 0;
-            do {                                                /* Cnt the max nbr of continuous sec's.                 */
-                sec_cnt_rd += DEF_MIN(sec_cnt_rem - sec_cnt_rd, clus_cur_sec_rem);
-
-                if((sec_cnt_rem - sec_cnt_rd) > 0u) {
-                    sec_next = FS_FAT_SecNextGet(p_file->VolPtr,
-                                                 p_buf,
-                                                 sec_cur + sec_cnt_rd - 1,
-                                                 p_err);
-                    if (*p_err != FS_ERR_NONE) {
-                        if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END) ||
-                            (*p_err == FS_ERR_SYS_CLUS_INVALID)) {
-                             *p_err =  FS_ERR_ENTRY_CORRUPT;
-                        }
-                        FSBuf_Free(p_buf);
-                        p_fat_file_data->FileCurSec     = sec_cur;
-                        p_fat_file_data->FileCurSecPos  = sec_cur_pos;
-                        p_fat_file_data->FilePos       += size - size_rem;
-                        return (size - size_rem);
-                    }
-
-                    clus_cur_sec_rem = p_fat_data->ClusSize_sec;
-                }
-
-            } while (((sec_cnt_rem - sec_cnt_rd) >   0u) &&
-                      (sec_next                  == (sec_cur + sec_cnt_rd)));
-
-
-            FSVol_RdLockedEx(        p_file->VolPtr,            /* Rd full sec's.                                       */
-                             (void *)p_dest_08,
-                                     sec_cur,
-                                     sec_cnt_rd,
-                                     FS_VOL_SEC_TYPE_FILE,
-                                     p_err);
-
-            if (*p_err != FS_ERR_NONE) {
-                FSBuf_Free(p_buf);
-                p_fat_file_data->FileCurSec     = sec_cur;
-                p_fat_file_data->FileCurSecPos  = sec_cur_pos;
-                p_fat_file_data->FilePos       += size - size_rem;
-                return (size - size_rem);
-            }
-
-            size_rem   -= FS_UTIL_MULT_PWR2(sec_cnt_rd, p_fat_data->SecSizeLog2);
-            p_dest_08  += FS_UTIL_MULT_PWR2(sec_cnt_rd, p_fat_data->SecSizeLog2);
-            sec_cur    += sec_cnt_rd - 1u;
-
-            if((sec_cnt_rem - sec_cnt_rd) > 0u) {               /* Next clus is not contiguous.                         */
-                sec_cur     = sec_next;                         /* Set the next iter to start at next clus.             */
-                sec_cur_pos = 0u;
-            } else if (size_rem > 0u) {                         /* Partial sec left, fetch next sec ix for partial rd.  */
-                sec_cur_pos = 0u;
-                sec_cur     = FS_FAT_SecNextGet(p_file->VolPtr,
-                                                p_buf,
-                                                sec_cur,
-                                                p_err);
-                if (*p_err != FS_ERR_NONE) {
-                    if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END) ||
-                        (*p_err == FS_ERR_SYS_CLUS_INVALID)) {
-                         *p_err =  FS_ERR_ENTRY_CORRUPT;
-                    }
-                    FSBuf_Free(p_buf);
-                    p_fat_file_data->FileCurSec     = sec_cur;
-                    p_fat_file_data->FileCurSecPos  = sec_cur_pos;
-                    p_fat_file_data->FilePos       += size - size_rem;
-                    return (size - size_rem);
-                }
-            } else {
-                sec_cur_pos = p_fat_data->SecSize;
-            }
-
-
-        } else {                                                /* -------------- PARTIAL (FINAL) SEC RD -------------- */
-            FSVol_RdLockedEx(p_file->VolPtr,                    /* Rd full sec.                                         */
-                             p_buf->DataPtr,
-                             sec_cur,
-                             1u,
-                             FS_VOL_SEC_TYPE_FILE,
-                             p_err);
-
-            if (*p_err != FS_ERR_NONE) {
-                FSBuf_Free(p_buf);
-                p_fat_file_data->FileCurSec     = sec_cur;
-                p_fat_file_data->FileCurSecPos  = sec_cur_pos;
-                p_fat_file_data->FilePos       += size - size_rem;
-                return (size - size_rem);
-            }
+    sec_cur     = p_fat_file_data->FileCurSec;
+    sec_cur_pos = p_fat_file_data->FileCurSecPos;
 
-            Mem_Copy((void     *)p_dest_08,                     /* Copy partial sec data.                               */
-                     (void     *)p_buf->DataPtr,
-                     (CPU_SIZE_T)size_rem);
-            sec_cur_pos += size_rem;
-            size_rem     = 0u;
-        }
-    }
 
+                                                                /* ---------------------- RD DATA --------------------- */
+    size_rd = FS_FAT_FileDataRd(p_file->VolPtr,
+                                p_buf,
+                                p_iov,
+                                size,
+                               &sec_cur,
+                               &sec_cur_pos,
+                                p_err);
 
 
                                                                 /* ----------------- UPDATE FILE INFO ----------------- */
     p_fat_file_data->FileCurSec     = sec_cur;
     p_fat_file_data->FileCurSecPos  = sec_cur_pos;
-    p_fat_file_data->FilePos       += size;
+    p_fat_file_data->FilePos       += size_rd;
 
     FSBuf_Free(p_buf);
 
-   *p_err = FS_ERR_NONE;
-
-    return (size);
+    return (size_rd);
 }
 
 
@@ -931,6 +1470,10 @@ CPU_SIZE_T  FS_FAT_FileRd (FS_FILE     *p_file,
 *
 *                   (a) Since this is a top level action, the journal must be cleared once it is finished
 *                       or after an error occurs.
+*
+*               (3) Clusters may be freed from the file's cluster chain, so the chain end kept in the file
+*                   data (see 'FS_FAT_FileWrV()  Note #5') is discarded.  It is found again by the next write
+*                   that allocates.
 *********************************************************************************************************
 */
 
@@ -997,7 +1540,9 @@ void  FS_FAT_FileTruncate (FS_FILE       *p_file,
                             p_fat_file_data,
                             size,
                             p_err);
-
+                                                                /* Chain end unknown after truncation (see Note #3).    */
+    p_fat_file_data->FileLastClus = 0u;
+    p_fat_file_data->FileClusCnt  = 0u;
 
     if (*p_err != FS_ERR_NONE) {
         FSBuf_Free(p_buf);
@@ -1051,11 +1596,7 @@ void  FS_FAT_FileTruncate (FS_FILE       *p_file,
 *                   called. FS_FAT_JournalExitFileWr() can return an error code, however the first
 *                   error code to happen has priority over the second.
 *
-*               (3) The number of bytes used by the file prior to the write operation is used to
-*                   determine if the last sector of the write operation has to be read.
-*
-*               (4) The chain follow operation will overwrite the data stored in the buffer, so the
-*                   buffer MUST be flushed before this operation is performed.
+*               (3) The write is performed by 'FS_FAT_FileWrV()' with a single I/O vector.
 *********************************************************************************************************
 */
 
@@ -1064,6 +1605,176 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
                            void        *p_src,
                            CPU_SIZE_T   size,
                            FS_ERR      *p_err)
+{
+    FS_FILE_IOV  iov;
+    CPU_SIZE_T   size_wr;
+
+
+    iov.BufPtr = p_src;
+    iov.Size   = size;
+
+    size_wr = FS_FAT_FileWrV(p_file, &iov, 1u, p_err);
+    return (size_wr);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          FS_FAT_FileWrAt()
+*
+* Description : Write to a file at a given position, without changing the file position.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_src       Pointer to source buffer.
+*               -----       Argument validated by caller.
+*
+*               size        Number of octets to write.
+*
+*               pos         File position of first octet to write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE             File written successful.
+*                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
+*                               FS_ERR_DEV              Device access error.
+*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+*
+* Return(s)   : Number of bytes written, if file write successful.
+*               0,                       otherwise.
+*
+* Note(s)     : (1) 'pos' MUST NOT be greater than the file size.
+*
+*               (2) The file's current sector & position are saved before the write & restored after
+*                   it.  Since a write never frees clusters, the saved sector remains valid, unless the
+*                   file had no cluster before the write; in that case, the position is set again so
+*                   that the current sector lies in the newly allocated cluster chain.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T  FS_FAT_FileWrAt (FS_FILE       *p_file,
+                             void          *p_src,
+                             CPU_SIZE_T     size,
+                             FS_FILE_SIZE   pos,
+                             FS_ERR        *p_err)
+{
+    FS_FAT_CLUS_NBR    first_clus;
+    FS_FAT_FILE_SIZE   file_pos;
+    FS_FAT_SEC_NBR     sec_cur;
+    FS_FAT_SEC_NBR     sec_cur_pos;
+    CPU_SIZE_T         size_wr;
+    FS_FILE_IOV        iov;
+    FS_FAT_FILE_DATA  *p_fat_file_data;
+    FS_ERR             err;
+
+
+    p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
+
+                                                                /* Save cur pos (see Note #2).                          */
+    first_clus  = p_fat_file_data->FileFirstClus;
+    file_pos    = p_fat_file_data->FilePos;
+    sec_cur     = p_fat_file_data->FileCurSec;
+    sec_cur_pos = p_fat_file_data->FileCurSecPos;
+
+    FS_FAT_FilePosSet(p_file, pos, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+    iov.BufPtr = p_src;
+    iov.Size   = size;
+
+    size_wr = FS_FAT_FileWrV(p_file, &iov, 1u, p_err);
+
+                                                                /* Restore cur pos (see Note #2).                       */
+    if (first_clus != 0u) {
+        p_fat_file_data->FilePos       = file_pos;
+        p_fat_file_data->FileCurSec    = sec_cur;
+        p_fat_file_data->FileCurSecPos = sec_cur_pos;
+    } else {
+        FS_FAT_FilePosSet(p_file, file_pos, &err);
+        if (*p_err == FS_ERR_NONE) {
+           *p_err = err;
+        }
+    }
+
+    return (size_wr);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          FS_FAT_FileWrV()
+*
+* Description : Write to a file from several buffers.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_iov       Pointer to array of I/O vectors describing source buffers.
+*               -----       Argument validated by caller.
+*
+*               iov_cnt     Number of I/O vectors.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE             File written successful.
+*                               FS_ERR_DEV              Device access error.
+*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+*
+* Return(s)   : Number of bytes written, if file write successful.
+*               0,                       otherwise.
+*
+* Note(s)     : (1) See 'FS_FAT_FileWr()  Note #1'.
+*
+*               (2) The clusters needed for the whole vector are allocated at once, before any data is
+*                   written.
+*
+*               (3) Runs of whole sectors that fall within a single source buffer are written directly
+*                   from that buffer, merging contiguous sectors into one device access.  Other sectors
+*                   are gathered from the source buffers into a temporary buffer.  A partial sector is
+*                   read first only if it holds valid file data that will not be overwritten.
+*
+*               (4) The chain follow operation will overwrite the data stored in the buffer, so the
+*                   buffer MUST be flushed before this operation is performed.  Likewise, the buffer MUST
+*                   be invalidated before file data is copied into it.
+*
+*               (5) The last cluster & the cluster count of the file's chain are kept in the file data,
+*                   so that the chain need not be followed to its end on every write that allocates.
+*                   Appending to a file is then independent of the file size.
+*
+*                   (a) The current sector lies in the cluster holding the octet before the file position
+*                       (or in the first cluster, at position 0), so its index in the chain is computed
+*                       from the file position.
+*
+*                   (b) The chain end is saved the first time it is found.  If concurrent entry access is
+*                       enabled, another file may extend the chain, so the chain end is never saved.
+*
+*                   (c) Only the newly allocated clusters are followed to find the new chain end.
+*
+*               (6) If a commit interval is set on the volume, the directory entry of an uncached file is
+*                   updated with those of the other files on the volume commit list, once the interval has
+*                   elapsed.  Until then, the journal is NOT checkpointed, so that the write is committed
+*                   with its directory entry (see 'FS_FAT_EntryCommitIntervalSet()  Note #3a').
+*
+*               (7) In ordered data mode, data written past the old file size MUST reach the device before
+*                   the journal checkpoint that commits the new file size.  The volume is marked so that
+*                   a write barrier is issued before that checkpoint (see 'fs_fat_journal.c
+*                   FS_FAT_JournalCkptWr()  Note #4').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T  FS_FAT_FileWrV (FS_FILE      *p_file,
+                            FS_FILE_IOV  *p_iov,
+                            FS_QTY        iov_cnt,
+                            FS_ERR       *p_err)
 {
     FS_FAT_CLUS_NBR    clus_start;
     FS_FAT_CLUS_NBR    clus_cur;
@@ -1071,6 +1782,7 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
     FS_FAT_CLUS_NBR    clus_next;
     FS_FAT_CLUS_NBR    clus_nbr;
     FS_FAT_CLUS_NBR    clus_cnt;
+    FS_FAT_CLUS_NBR    clus_cur_ix;
     FS_FAT_SEC_NBR     clus_cur_sec_rem;
     FS_FAT_FILE_SIZE   file_pos;
     FS_FAT_SEC_NBR     sec_cnt_rem;
@@ -1079,13 +1791,16 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
     FS_FAT_SEC_NBR     sec_next;
     FS_FAT_SEC_NBR     sec_cur_pos;
     FS_FAT_FILE_SIZE   file_valid_size_rem;
+    CPU_SIZE_T         size;
     CPU_SIZE_T         size_avail_in_file;
     CPU_SIZE_T         size_alloc;
     CPU_SIZE_T         size_rem;
     CPU_SIZE_T         size_wr;
+    CPU_SIZE_T         iov_pos;
+    CPU_SIZE_T         iov_rem;
+    FS_QTY             iov_ix;
     FS_BUF            *p_buf;
     CPU_INT08U        *p_src_08;
-    CPU_INT08U        *p_temp_08;
     FS_FAT_DATA       *p_fat_data;
     FS_FAT_FILE_DATA  *p_fat_file_data;
 
@@ -1099,14 +1814,18 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
     }
     p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
     p_fat_data      = (FS_FAT_DATA      *)(p_file->VolPtr->DataPtr);
-    p_src_08        = (CPU_INT08U       *)(p_src);
+
+    size = 0u;                                                  /* Calc total wr size.                                  */
+    for (iov_ix = 0u; iov_ix < iov_cnt; iov_ix++) {
+        size += p_iov[iov_ix].Size;
+    }
 
 
                                                                 /* ----------------- ALLOC CLUS CHAIN ----------------- */
     sec_cur_pos = p_fat_file_data->FileCurSecPos;
     sec_cur     = p_fat_file_data->FileCurSec;
 
-                                                                /* Calc nbr of clus to alloc.                           */
+                                                                /* Calc nbr of clus to alloc (see Note #2).             */
     size_alloc  = size;
 
     if (p_fat_file_data->FileFirstClus != 0u) {
@@ -1132,20 +1851,33 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
                                                                 /* Add one partial clus if needed.                      */
     clus_nbr += ((size_alloc & (p_fat_data->ClusSize_octet - 1u)) != 0u) ? 1u : 0u;
 
-                                                                /* Follow clus chain until end.                         */
+                                                                /* Find clus chain end (see Note #5).                   */
     clus_prev = clus_cur;
     if (clus_prev != 0) {
-        clus_next = FS_FAT_ClusChainEndFind(p_file->VolPtr,
-                                            p_buf,
-                                            clus_prev,
-                                           &clus_cnt,
-                                            p_err);
-        if (*p_err != FS_ERR_NONE) {
-            if (*p_err == FS_ERR_SYS_CLUS_INVALID) {
-                *p_err = FS_ERR_ENTRY_CORRUPT;
+                                                                /* Ix of cur clus in chain (see Note #5a).              */
+        clus_cur_ix = (p_fat_file_data->FilePos > 0u) ? (FS_UTIL_DIV_PWR2(p_fat_file_data->FilePos - 1u, p_fat_data->ClusSizeLog2_octet) + 1u) : (1u);
+
+        if (p_fat_file_data->FileLastClus != 0u) {              /* If chain end known ...                               */
+            clus_next = p_fat_file_data->FileLastClus;          /* ... nbr of clus after cur clus is known.             */
+            clus_cnt  = p_fat_file_data->FileClusCnt - clus_cur_ix;
+
+        } else {                                                /* Otherwise, follow clus chain until end.              */
+            clus_next = FS_FAT_ClusChainEndFind(p_file->VolPtr,
+                                                p_buf,
+                                                clus_prev,
+                                               &clus_cnt,
+                                                p_err);
+            if (*p_err != FS_ERR_NONE) {
+                if (*p_err == FS_ERR_SYS_CLUS_INVALID) {
+                    *p_err = FS_ERR_ENTRY_CORRUPT;
+                }
+                FSBuf_Free(p_buf);
+                return (0u);
             }
-            FSBuf_Free(p_buf);
-            return (0u);
+#if (FS_CFG_CONCURRENT_ENTRIES_ACCESS_EN == DEF_DISABLED)
+            p_fat_file_data->FileLastClus = clus_next;          /* Save chain end (see Note #5b).                       */
+            p_fat_file_data->FileClusCnt  = clus_cur_ix + clus_cnt;
+#endif
         }
 
         if (clus_nbr > clus_cnt) {
@@ -1166,6 +1898,7 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
         FSBuf_Flush(p_buf, p_err);                              /* Flush buf (see Note #4).                             */
     }
     if (*p_err != FS_ERR_NONE) {
+        p_fat_file_data->FileLastClus = 0u;                     /* Chain end unknown after failed alloc.                */
         FSBuf_Free(p_buf);
         return (0u);
     }
@@ -1176,11 +1909,35 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
         sec_cur    = FS_FAT_CLUS_TO_SEC(p_fat_data, clus_cur);
 
         p_fat_file_data->FileFirstClus = clus_start;            /* ... set first clus of file.                          */
+#if (FS_CFG_CONCURRENT_ENTRIES_ACCESS_EN == DEF_DISABLED)
+        p_fat_file_data->FileLastClus  = clus_start;            /* ... & chain end (see Note #5b).                      */
+        p_fat_file_data->FileClusCnt   = 1u;
+        clus_nbr--;
+#endif
+    }
+                                                                /* Update chain end (see Note #5c).                     */
+    if ((p_fat_file_data->FileLastClus != 0u) &&
+        (clus_nbr                      >  0u)) {
+        clus_next = FS_FAT_ClusChainEndFind(p_file->VolPtr,
+                                            p_buf,
+                                            p_fat_file_data->FileLastClus,
+                                            DEF_NULL,
+                                            p_err);
+        if (*p_err != FS_ERR_NONE) {
+            p_fat_file_data->FileLastClus = 0u;
+            FSBuf_Free(p_buf);
+            return (0u);
+        }
+
+        p_fat_file_data->FileLastClus  = clus_next;
+        p_fat_file_data->FileClusCnt  += clus_nbr;
     }
 
 
                                                                 /* --------------------- WR DATA ---------------------- */
     size_rem = size;
+    iov_ix   = 0u;
+    iov_pos  = 0u;
                                                                 /* Set nb of bytes valid in file prior to wr.           */
     file_valid_size_rem = 0u;
     if (p_fat_file_data->FilePos < p_fat_file_data->FileSize) {
@@ -1188,119 +1945,45 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
                             - p_fat_file_data->FilePos;
     }
 
-
-                                                                /* ------------------ SKIP FULL SEC ------------------- */
-    if (sec_cur_pos == p_fat_data->SecSize) {                   /* Sec pos at end of sec (so move to start of next).    */
-        sec_cur_pos = 0u;
-        if (clus_cur_sec_rem == 1u) {
-            clus_cur = FS_FAT_ClusChainFollow(p_file->VolPtr,
-                                              p_buf,
-                                              clus_cur,
-                                              1u,
-                                              DEF_NULL,
-                                              p_err);
-
+    while (size_rem > 0u) {
+        if (sec_cur_pos == p_fat_data->SecSize) {               /* Sec pos at end of sec (so move to start of next).    */
+            sec_next = FS_FAT_SecNextGet(p_file->VolPtr,
+                                         p_buf,
+                                         sec_cur,
+                                         p_err);
             if (*p_err != FS_ERR_NONE) {
+                if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END) ||
+                    (*p_err == FS_ERR_SYS_CLUS_INVALID)) {
+                     *p_err =  FS_ERR_ENTRY_CORRUPT;
+                }
                 FSBuf_Free(p_buf);
                 return (0u);
             }
 
-            sec_cur          = FS_FAT_CLUS_TO_SEC(p_fat_data, clus_cur);
-            clus_cur_sec_rem = p_fat_data->ClusSize_sec;
-        } else {
-            sec_cur++;
-            clus_cur_sec_rem--;
-        }
-    }
-
-
-                                                                /* ------------------ PARTIAL SEC WR ------------------ */
-    if (sec_cur_pos != 0u) {
-        FSBuf_Flush(p_buf, p_err);
-        if (*p_err != FS_ERR_NONE) {
-            FSBuf_Free(p_buf);
-            return (0u);
-        }
-
-        FSVol_RdLockedEx(p_file->VolPtr,                        /* Rd full sec.                                         */
-                         p_buf->DataPtr,
-                         sec_cur,
-                         1u,
-                         FS_VOL_SEC_TYPE_FILE,
-                         p_err);
-
-        if (*p_err != FS_ERR_NONE) {
-            FSBuf_Free(p_buf);
-            return (0u);
-        }
-
-        size_wr = DEF_MIN(size_rem, p_fat_data->SecSize - sec_cur_pos);
-
-        p_temp_08 = (CPU_INT08U *)p_buf->DataPtr + sec_cur_pos;
-        Mem_Copy((void       *)p_temp_08,                       /* Copy data into buf.                                  */
-                 (void       *)p_src_08,
-                 (CPU_SIZE_T  )size_wr);
-
-        FSVol_WrLockedEx(p_file->VolPtr,                        /* Wr full sec.                                         */
-                         p_buf->DataPtr,
-                         sec_cur,
-                         1u,
-                         FS_VOL_SEC_TYPE_FILE,
-                         p_err);
-
-        if (*p_err != FS_ERR_NONE) {
-            FSBuf_Free(p_buf);
-            return (0u);
-        }
-
-        size_rem    -= size_wr;
-        p_src_08    += size_wr;
-        sec_cur_pos += size_wr;
-        clus_cur_sec_rem--;
-        if(size_wr > file_valid_size_rem) {
-            file_valid_size_rem  = 0u;
-        } else {
-            file_valid_size_rem -= size_wr;
+            sec_cur     = sec_next;
+            sec_cur_pos = 0u;
         }
 
-        if (size_rem > 0u) {                                    /* If more wr octets, get next sec nbr.                 */
-            if (clus_cur_sec_rem == 0u) {
-                clus_cur = FS_FAT_ClusChainFollow(p_file->VolPtr,
-                                                  p_buf,
-                                                  clus_cur,
-                                                  1u,
-                                                  0,
-                                                  p_err);
-                if (*p_err != FS_ERR_NONE) {
-                    FSBuf_Free(p_buf);
-                    return (0u);
-                }
-
-                sec_cur          = FS_FAT_CLUS_TO_SEC(p_fat_data, clus_cur);
-                clus_cur_sec_rem = p_fat_data->ClusSize_sec;
-                sec_cur_pos      = 0u;
-            } else {
-                sec_cur++;
-            }
+        while (iov_pos == p_iov[iov_ix].Size) {                 /* Skip consumed bufs.                                  */
+            iov_ix++;
+            iov_pos = 0u;
         }
-    }
-
-
-                                                                /* ------------------- FULL SEC WRs ------------------- */
-    sec_next = 0u;
-    while (size_rem > 0u) {
-        sec_cnt_rem = FS_UTIL_DIV_PWR2(size_rem, p_fat_data->SecSizeLog2);
-
-        if (sec_cnt_rem > 0u) {
-
-            sec_cnt_wr = 0;
+        iov_rem     = DEF_MIN(p_iov[iov_ix].Size - iov_pos, size_rem);
+        sec_cnt_rem = FS_UTIL_DIV_PWR2(iov_rem, p_fat_data->SecSizeLog2);
+
+        if ((sec_cur_pos == 0u) &&
+            (sec_cnt_rem >  0u)) {                              /* ------------------- FULL SEC WRs ------------------- */
+            p_src_08         = (CPU_INT08U *)p_iov[iov_ix].BufPtr + iov_pos;
+            clus_cur_sec_rem =  FS_FAT_CLUS_SEC_REM(p_fat_data, sec_cur);
+            sec_cnt_wr       =  0u;
+            sec_next         =  0u;
             do {                                                /* Cnt the max nbr of continuous sec's.                 */
                 sec_cnt_wr += DEF_MIN(sec_cnt_rem - sec_cnt_wr, clus_cur_sec_rem);
 
-                if((sec_cnt_rem - sec_cnt_wr) > 0u) {
+                if ((sec_cnt_rem - sec_cnt_wr) > 0u) {
                     sec_next = FS_FAT_SecNextGet(p_file->VolPtr,
                                                  p_buf,
-                                                 sec_cur + sec_cnt_wr - 1,
+                                                 sec_cur + sec_cnt_wr - 1u,
                                                  p_err);
                     if (*p_err != FS_ERR_NONE) {
                         FSBuf_Free(p_buf);
@@ -1314,48 +1997,42 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
                       (sec_next                  == (sec_cur + sec_cnt_wr)));
 
 
-            FSVol_WrLockedEx(        p_file->VolPtr,            /* Wr full sec's.                                       */
-                 (void *)p_src_08,
-                         sec_cur,
-                         sec_cnt_wr,
-                         FS_VOL_SEC_TYPE_FILE,
-                         p_err);
+            FSVol_WrLockedEx(        p_file->VolPtr,            /* Wr full sec's directly from buf (see Note #3).       */
+                             (void *)p_src_08,
+                                     sec_cur,
+                                     sec_cnt_wr,
+                                     FS_VOL_SEC_TYPE_FILE,
+                                     p_err);
 
             if (*p_err != FS_ERR_NONE) {
                 FSBuf_Free(p_buf);
                 return (0u);
             }
 
-            size_rem   -= FS_UTIL_MULT_PWR2(sec_cnt_wr, p_fat_data->SecSizeLog2);
-            p_src_08   += FS_UTIL_MULT_PWR2(sec_cnt_wr, p_fat_data->SecSizeLog2);
-            sec_cur    += sec_cnt_wr - 1u;
+            size_wr = FS_UTIL_MULT_PWR2(sec_cnt_wr, p_fat_data->SecSizeLog2);
 
-            if((sec_cnt_rem - sec_cnt_wr) > 0u) {               /* Next clus is not contiguous.                         */
+            if ((sec_cnt_rem - sec_cnt_wr) > 0u) {              /* Next clus is not contiguous.                         */
                 sec_cur     = sec_next;                         /* Set the next iter to start at next clus.             */
                 sec_cur_pos = 0u;
-            } else if (size_rem > 0u) {                         /* Partial sec left, fetch next sec ix for partial rd.  */
-                sec_cur_pos = 0u;
-                sec_cur     = FS_FAT_SecNextGet(p_file->VolPtr,
-                                                p_buf,
-                                                sec_cur,
-                                                p_err);
-                if (*p_err != FS_ERR_NONE) {
-                    FSBuf_Free(p_buf);
-                    return (0u);
-                }
             } else {
+                sec_cur    += sec_cnt_wr - 1u;
                 sec_cur_pos = p_fat_data->SecSize;
             }
 
-        } else {                                                /* -------------- PARTIAL (FINAL) SEC WR -------------- */
-            FSBuf_Flush(p_buf, p_err);
+            iov_pos += size_wr;
+
+        } else {                                                /* ------------------ PARTIAL SEC WR ------------------ */
+            size_wr = DEF_MIN(size_rem, p_fat_data->SecSize - sec_cur_pos);
+
+            FSBuf_Flush(p_buf, p_err);                          /* Invalidate buf (see Note #4).                        */
             if (*p_err != FS_ERR_NONE) {
                 FSBuf_Free(p_buf);
                 return (0u);
             }
-
-            if(file_valid_size_rem > 0u) {                     /* Rd only if there is valid data rem (See Note #3).     */
-                FSVol_RdLockedEx(p_file->VolPtr,               /* Rd full sec.                                          */
+                                                                /* Rd only if valid data is kept (see Note #3).         */
+            if ((sec_cur_pos != 0u) ||
+               ((size_wr < p_fat_data->SecSize) && (file_valid_size_rem > size_wr))) {
+                FSVol_RdLockedEx(p_file->VolPtr,                /* Rd full sec.                                         */
                                  p_buf->DataPtr,
                                  sec_cur,
                                  1u,
@@ -1367,18 +2044,18 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
                     return (0u);
                 }
 #if  (FS_CFG_DBG_MEM_CLR_EN == DEF_ENABLED)
-            } else {                                           /* Clr buf data.                                         */
+            } else {                                            /* Clr buf data.                                        */
                 Mem_Clr(p_buf->DataPtr, p_buf->Size);
             }
 #else
-        }
+            }
 #endif
 
-
-
-            Mem_Copy((void       *)p_buf->DataPtr,              /* Copy data into buf.                                  */
-                     (void       *)p_src_08,
-                     (CPU_SIZE_T  )size_rem);
+            FS_FAT_FileIOV_Gather(                 p_iov,       /* Copy data into buf (see Note #3).                    */
+                                                  &iov_ix,
+                                                  &iov_pos,
+                                  (CPU_INT08U *)p_buf->DataPtr + sec_cur_pos,
+                                                   size_wr);
 
             FSVol_WrLockedEx(p_file->VolPtr,                    /* Wr full sec.                                         */
                              p_buf->DataPtr,
@@ -1392,8 +2069,14 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
                 return (0u);
             }
 
-            sec_cur_pos = size_rem;
-            size_rem    = 0u;
+            sec_cur_pos += size_wr;
+        }
+
+        size_rem -= size_wr;
+        if (size_wr > file_valid_size_rem) {
+            file_valid_size_rem  = 0u;
+        } else {
+            file_valid_size_rem -= size_wr;
         }
     }
 
@@ -1407,15 +2090,33 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
 
     if (file_pos > p_fat_file_data->FileSize) {                 /* New file pos past old file size.                     */
         p_fat_file_data->FileSize = file_pos;
+#if (FS_FAT_CFG_JOURNAL_ORDERED_EN == DEF_ENABLED)              /* Order data before ckpt (see Note #7).                */
+        DEF_BIT_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_DATA_PEND);
+#endif
     }
 
                                                                 /* If file uncached ...                                 */
     if (DEF_BIT_IS_CLR(p_fat_file_data->Mode, FS_FILE_ACCESS_MODE_CACHED) == DEF_YES) {
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+        if (p_fat_data->CommitInterval != 0u) {                 /*                  ... & commit interval set ...       */
+            FS_FAT_EntryCommitAdd(p_file->VolPtr,               /*                  ... update dir entry at commit ...  */
+                                  p_buf,
+                                  p_fat_file_data,      /*                  ... (see Note #6).                  */
+                                  p_err);
+        } else {
+            FS_FAT_LowEntryUpdate(p_file->VolPtr,               /*                  ... update dir entry now.           */
+                                  p_buf,
+                                  p_fat_file_data,
+                                  DEF_YES,
+                                  p_err);
+        }
+#else
         FS_FAT_LowEntryUpdate(p_file->VolPtr,                   /*                  ... update dir entry now.           */
                               p_buf,
                               p_fat_file_data,
                               DEF_YES,
                               p_err);
+#endif
         if (*p_err != FS_ERR_NONE) {
             FSBuf_Free(p_buf);
             return (0u);
@@ -1428,7 +2129,13 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
 
                                                                 /* -------------------- CLR JOURNAL ------------------- */
 #ifdef FS_FAT_JOURNAL_MODULE_PRESENT
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+    if (p_fat_file_data->CommitPend == DEF_NO) {                /* Ckpt at commit if entry deferred (see Note #6).      */
+        FS_FAT_JournalClrReset(p_file->VolPtr, p_buf, p_err);
+    }
+#else
     FS_FAT_JournalClrReset(p_file->VolPtr, p_buf, p_err);
+#endif
     if (*p_err != FS_ERR_NONE) {
         FSBuf_Free(p_buf);
         return (0u);
@@ -1444,6 +2151,559 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
 #endif
 
 
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         FS_FAT_FileDataRd()
+*
+* Description : Read file data, starting at a sector position, into several buffers.
+*
+* Argument(s) : p_vol           Pointer to volume.
+*               -----           Argument validated by caller.
+*
+*               p_buf           Pointer to temporary buffer.
+*               -----           Argument validated by caller.
+*
+*               p_iov           Pointer to array of I/O vectors describing destination buffers.
+*               -----           Argument validated by caller.
+*
+*               size            Number of octets to read.
+*
+*               p_sec_cur       Pointer to variable that holds the current sector, and that will receive
+*               ---------       the current sector after the read.
+*
+*               p_sec_cur_pos   Pointer to variable that holds the position within the current sector,
+*               -------------   and that will receive the position within the current sector after the
+*                               read.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE              File data read successfully.
+*                                   FS_ERR_DEV               Device access error.
+*                                   FS_ERR_ENTRY_CORRUPT     File system entry corrupt.
+*
+* Return(s)   : Number of octets read.
+*
+* Note(s)     : (1) The caller MUST ensure that 'size' does not read past the end of the file & that the
+*                   I/O vectors hold at least 'size' octets.
+*
+*               (2) See 'FS_FAT_FileRd()  Note #1'.
+*
+*               (3) Runs of whole sectors that fall within a single destination buffer are read directly
+*                   into that buffer, merging contiguous sectors into one device access.  Other sectors
+*                   are read into the temporary buffer & scattered across the destination buffers.
+*
+*               (4) The temporary buffer is also used to follow the cluster chain, so it MUST be
+*                   invalidated before file data is read into it.
+*********************************************************************************************************
+*/
+
+static  CPU_SIZE_T  FS_FAT_FileDataRd (FS_VOL          *p_vol,
+                                       FS_BUF          *p_buf,
+                                       FS_FILE_IOV     *p_iov,
+                                       CPU_SIZE_T       size,
+                                       FS_FAT_SEC_NBR  *p_sec_cur,
+                                       FS_FAT_SEC_NBR  *p_sec_cur_pos,
+                                       FS_ERR          *p_err)
+{
+    FS_FAT_SEC_NBR   clus_cur_sec_rem;
+    FS_FAT_SEC_NBR   sec_cnt_rd;
+    FS_FAT_SEC_NBR   sec_cnt_rem;
+    FS_FAT_SEC_NBR   sec_cur;
+    FS_FAT_SEC_NBR   sec_next;
+    FS_FAT_SEC_NBR   sec_cur_pos;
+    CPU_SIZE_T       size_rd;
+    CPU_SIZE_T       size_rem;
+    CPU_SIZE_T       iov_pos;
+    CPU_SIZE_T       iov_rem;
+    FS_QTY           iov_ix;
+    CPU_INT08U      *p_dest_08;
+    FS_FAT_DATA     *p_fat_data;
+
+
+    p_fat_data  = (FS_FAT_DATA *)p_vol->DataPtr;
+    size_rem    =  size;
+    sec_cur     = *p_sec_cur;
+    sec_cur_pos = *p_sec_cur_pos;
+    iov_ix      =  0u;
+    iov_pos     =  0u;
+   *p_err       =  FS_ERR_NONE;
+
+    while ((size_rem > 0u) &&
+           (*p_err  == FS_ERR_NONE)) {
+        if (sec_cur_pos == p_fat_data->SecSize) {               /* Sec pos at end of sec (so move to start of next).    */
+            sec_next = FS_FAT_SecNextGet(p_vol,
+                                         p_buf,
+                                         sec_cur,
+                                         p_err);
+            if (*p_err != FS_ERR_NONE) {
+                break;
+            }
+
+            sec_cur     = sec_next;
+            sec_cur_pos = 0u;
+        }
+
+        while (iov_pos == p_iov[iov_ix].Size) {                 /* Skip filled bufs.                                    */
+            iov_ix++;
+            iov_pos = 0u;
+        }
+        iov_rem     = DEF_MIN(p_iov[iov_ix].Size - iov_pos, size_rem);
+        sec_cnt_rem = FS_UTIL_DIV_PWR2(iov_rem, p_fat_data->SecSizeLog2);
+
+        if ((sec_cur_pos == 0u) &&
+            (sec_cnt_rem >  0u)) {                              /* ------------------- FULL SEC RDs ------------------- */
+            p_dest_08        = (CPU_INT08U *)p_iov[iov_ix].BufPtr + iov_pos;
+            clus_cur_sec_rem =  FS_FAT_CLUS_SEC_REM(p_fat_data, sec_cur);
+            sec_cnt_rd       =  0u;
+            sec_next         =  0u;
+            do {                                                /* Cnt the max nbr of continuous sec's.                 */
+                sec_cnt_rd += DEF_MIN(sec_cnt_rem - sec_cnt_rd, clus_cur_sec_rem);
+
+                if ((sec_cnt_rem - sec_cnt_rd) > 0u) {
+                    sec_next = FS_FAT_SecNextGet(p_vol,
+                                                 p_buf,
+                                                 sec_cur + sec_cnt_rd - 1u,
+                                                 p_err);
+                    if (*p_err != FS_ERR_NONE) {
+                        break;
+                    }
+
+                    clus_cur_sec_rem = p_fat_data->ClusSize_sec;
+                }
+
+            } while (((sec_cnt_rem - sec_cnt_rd) >   0u) &&
+                      (sec_next                  == (sec_cur + sec_cnt_rd)));
+
+            if (*p_err != FS_ERR_NONE) {
+                break;
+            }
+
+            FSVol_RdLockedEx(        p_vol,                     /* Rd full sec's directly into buf (see Note #3).       */
+                             (void *)p_dest_08,
+                                     sec_cur,
+                                     sec_cnt_rd,
+                                     FS_VOL_SEC_TYPE_FILE,
+                                     p_err);
+            if (*p_err != FS_ERR_NONE) {
+                break;
+            }
+
+            size_rd   = FS_UTIL_MULT_PWR2(sec_cnt_rd, p_fat_data->SecSizeLog2);
+            size_rem -= size_rd;
+            iov_pos  += size_rd;
+
+            if ((sec_cnt_rem - sec_cnt_rd) > 0u) {              /* Next clus is not contiguous.                         */
+                sec_cur     = sec_next;                         /* Set the next iter to start at next clus.             */
+                sec_cur_pos = 0u;
+            } else {
+                sec_cur    += sec_cnt_rd - 1u;
+                sec_cur_pos = p_fat_data->SecSize;
+            }
+
+        } else {                                                /* ------------------ PARTIAL SEC RD ------------------ */
+            FSBuf_Flush(p_buf, p_err);                          /* Invalidate buf (see Note #4).                        */
+            if (*p_err != FS_ERR_NONE) {
+                break;
+            }
+
+            FSVol_RdLockedEx(p_vol,                             /* Rd full sec.                                         */
+                             p_buf->DataPtr,
+                             sec_cur,
+                             1u,
+                             FS_VOL_SEC_TYPE_FILE,
+                             p_err);
+            if (*p_err != FS_ERR_NONE) {
+                break;
+            }
+
+            size_rd = DEF_MIN(size_rem, p_fat_data->SecSize - sec_cur_pos);
+            FS_FAT_FileIOV_Scatter(                 p_iov,      /* Copy sec data across bufs (see Note #3).             */
+                                                   &iov_ix,
+                                                   &iov_pos,
+                                   (CPU_INT08U *)p_buf->DataPtr + sec_cur_pos,
+                                                    size_rd);
+
+            size_rem    -= size_rd;
+            sec_cur_pos += size_rd;
+        }
+    }
+
+    if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END) ||
+        (*p_err == FS_ERR_SYS_CLUS_INVALID)) {
+         *p_err =  FS_ERR_ENTRY_CORRUPT;
+    }
+
+   *p_sec_cur     = sec_cur;
+   *p_sec_cur_pos = sec_cur_pos;
+
+    return (size - size_rem);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FS_FAT_FileIOV_Scatter()
+*
+* Description : Copy data from a buffer into consecutive I/O vectors.
+*
+* Argument(s) : p_iov       Pointer to array of I/O vectors.
+*               -----       Argument validated by caller.
+*
+*               p_iov_ix    Pointer to index of current I/O vector.
+*               --------    Argument validated by caller.
+*
+*               p_iov_pos   Pointer to position within current I/O vector.
+*               ---------   Argument validated by caller.
+*
+*               p_src_08    Pointer to source buffer.
+*               --------    Argument validated by caller.
+*
+*               size        Number of octets to copy.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The caller MUST ensure that the I/O vectors have at least 'size' octets left.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_FileIOV_Scatter (FS_FILE_IOV  *p_iov,
+                                      FS_QTY       *p_iov_ix,
+                                      CPU_SIZE_T   *p_iov_pos,
+                                      CPU_INT08U   *p_src_08,
+                                      CPU_SIZE_T    size)
+{
+    FS_QTY       iov_ix;
+    CPU_SIZE_T   iov_pos;
+    CPU_SIZE_T   size_copy;
+    CPU_INT08U  *p_dest_08;
+
+
+    iov_ix  = *p_iov_ix;
+    iov_pos = *p_iov_pos;
+
+    while (size > 0u) {
+        if (iov_pos == p_iov[iov_ix].Size) {                    /* Move to next I/O vector.                             */
+            iov_ix++;
+            iov_pos = 0u;
+        } else {
+            size_copy = DEF_MIN(size, p_iov[iov_ix].Size - iov_pos);
+            p_dest_08 = (CPU_INT08U *)p_iov[iov_ix].BufPtr + iov_pos;
+            Mem_Copy((void *)p_dest_08,
+                     (void *)p_src_08,
+                             size_copy);
+
+            size     -= size_copy;
+            p_src_08 += size_copy;
+            iov_pos  += size_copy;
+        }
+    }
+
+   *p_iov_ix  = iov_ix;
+   *p_iov_pos = iov_pos;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_FileIOV_Gather()
+*
+* Description : Copy data from consecutive I/O vectors into a buffer.
+*
+* Argument(s) : p_iov       Pointer to array of I/O vectors.
+*               -----       Argument validated by caller.
+*
+*               p_iov_ix    Pointer to index of current I/O vector.
+*               --------    Argument validated by caller.
+*
+*               p_iov_pos   Pointer to position within current I/O vector.
+*               ---------   Argument validated by caller.
+*
+*               p_dest_08   Pointer to destination buffer.
+*               ---------   Argument validated by caller.
+*
+*               size        Number of octets to copy.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The caller MUST ensure that the I/O vectors have at least 'size' octets left.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_FileIOV_Gather (FS_FILE_IOV  *p_iov,
+                                     FS_QTY       *p_iov_ix,
+                                     CPU_SIZE_T   *p_iov_pos,
+                                     CPU_INT08U   *p_dest_08,
+                                     CPU_SIZE_T    size)
+{
+    FS_QTY       iov_ix;
+    CPU_SIZE_T   iov_pos;
+    CPU_SIZE_T   size_copy;
+    CPU_INT08U  *p_src_08;
+
+
+    iov_ix  = *p_iov_ix;
+    iov_pos = *p_iov_pos;
+
+    while (size > 0u) {
+        if (iov_pos == p_iov[iov_ix].Size) {                    /* Move to next I/O vector.                             */
+            iov_ix++;
+            iov_pos = 0u;
+        } else {
+            size_copy = DEF_MIN(size, p_iov[iov_ix].Size - iov_pos);
+            p_src_08  = (CPU_INT08U *)p_iov[iov_ix].BufPtr + iov_pos;
+            Mem_Copy((void *)p_dest_08,
+                     (void *)p_src_08,
+                             size_copy);
+
+            size      -= size_copy;
+            p_dest_08 += size_copy;
+            iov_pos   += size_copy;
+        }
+    }
+
+   *p_iov_ix  = iov_ix;
+   *p_iov_pos = iov_pos;
+}
+#endif
+
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_EntryCommitAdd()
+*
+* Description : Defer the directory entry update of a file to the next volume commit.
+*
+* Argument(s) : p_vol               Pointer to volume.
+*               -----               Argument validated by caller.
+*
+*               p_buf               Pointer to temporary buffer.
+*               -----               Argument validated by caller.
+*
+*               p_fat_file_data     Pointer to FAT file data.
+*               ---------------     Argument validated by caller.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       FS_ERR_NONE             File added to commit list.
+*                                       FS_ERR_DEV              Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The commit list is kept sorted by directory sector, so that a commit writes each
+*                   directory sector once, in ascending order.
+*
+*               (2) The date & time of the write are recorded now & written to the entry at commit.
+*
+*               (3) If the commit interval has elapsed, or if half of the journal is used by the logs of
+*                   the pending batch, all pending entries are written & the journal is checkpointed (see
+*                   'FS_FAT_EntryCommitIntervalSet()  Note #3').
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+static  void  FS_FAT_EntryCommitAdd (FS_VOL            *p_vol,
+                                     FS_BUF            *p_buf,
+                                     FS_FAT_FILE_DATA  *p_fat_file_data,
+                                     FS_ERR            *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_entry_prev;
+    FS_FAT_FILE_DATA  *p_entry;
+    CLK_DATE_TIME      stime;
+    CLK_TS_SEC         ts;
+    CPU_BOOLEAN        ok;
+    CPU_BOOLEAN        commit;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    p_fat_file_data->UpdateReqd = DEF_YES;
+                                                                /* ------------------ INSERT IN LIST ------------------ */
+    if (p_fat_file_data->CommitPend == DEF_NO) {                /* See Note #1.                                         */
+        p_entry_prev = (FS_FAT_FILE_DATA *)0;
+        p_entry      =  p_fat_data->CommitListPtr;
+        while ((p_entry           != (FS_FAT_FILE_DATA *)0) &&
+               (p_entry->DirEndSec <= p_fat_file_data->DirEndSec)) {
+            p_entry_prev = p_entry;
+            p_entry      = p_entry->CommitNextPtr;
+        }
+
+        p_fat_file_data->CommitNextPtr = p_entry;
+        if (p_entry_prev == (FS_FAT_FILE_DATA *)0) {
+            p_fat_data->CommitListPtr   = p_fat_file_data;
+        } else {
+            p_entry_prev->CommitNextPtr = p_fat_file_data;
+        }
+        p_fat_file_data->CommitPend = DEF_YES;
+    }
+
+                                                                /* ------------------ RECORD WR TIME ------------------ */
+    ok = Clk_GetDateTime(&stime);                               /* See Note #2.                                         */
+    if (ok == DEF_YES) {
+        p_fat_file_data->DateWr = FS_FAT_DateFmt(&stime);
+        p_fat_file_data->TimeWr = FS_FAT_TimeFmt(&stime);
+    } else {
+        p_fat_file_data->DateWr = 0u;
+        p_fat_file_data->TimeWr = 0u;
+    }
+
+                                                                /* ---------------- CHK COMMIT INTERVAL --------------- */
+    commit = DEF_NO;
+    ok     = Clk_GetTS(&ts);
+    if (ok == DEF_OK) {                                         /* If no time stamp, commit only on demand.             */
+        if ((CPU_INT32U)(ts - p_fat_data->CommitTS) >= p_fat_data->CommitInterval) {
+            commit = DEF_YES;
+        }
+    }
+#ifdef FS_FAT_JOURNAL_MODULE_PRESENT
+    if (commit == DEF_NO) {                                     /* Commit if journal half used (see Note #3).           */
+        commit = FS_FAT_JournalCkptDue(p_vol);
+    }
+#endif
+
+    if (commit == DEF_NO) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    FS_FAT_EntryCommitLocked(p_vol, p_buf, p_err);              /* See Note #3.                                         */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FS_FAT_EntryCommitLocked()
+*
+* Description : Write the directory entries of all files on the volume commit list & checkpoint the journal.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               -----       Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE    Directory entries written.
+*                               FS_ERR_DEV     Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The volume lock MUST be held.
+*
+*               (2) The journal is checkpointed once for the whole batch (see 'FS_FAT_EntryCommitIntervalSet()
+*                   Note #3a').
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+static  void  FS_FAT_EntryCommitLocked (FS_VOL  *p_vol,
+                                        FS_BUF  *p_buf,
+                                        FS_ERR  *p_err)
+{
+    FS_FAT_EntryCommitWr(p_vol, p_buf, p_err);                  /* Wr pending entries.                                  */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+#ifdef FS_FAT_JOURNAL_MODULE_PRESENT
+    FS_FAT_JournalClrReset(p_vol, p_buf, p_err);                /* Clr journal once for whole batch (see Note #2).      */
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_EntryCommitWr()
+*
+* Description : Write the directory entries of all files on the volume commit list.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               -----       Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE    Directory entries written.
+*                               FS_ERR_DEV     Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The volume lock MUST be held.
+*
+*               (2) Since the list is sorted by directory sector, 'FS_FAT_LowEntryUpdate()' finds the
+*                   directory sector of consecutive entries already in the buffer; each sector is written
+*                   once, when the buffer moves on to the next sector or is flushed.
+*
+*               (3) Each entry is written with the date & time recorded when the file was last written (see
+*                   'FS_FAT_EntryCommitAdd()  Note #2').
+*
+*               (4) A file is removed from the list only once its entry has been written.  On error, the
+*                   remaining files stay on the list, to be committed later.
+*
+*               (5) The journal is NOT checkpointed.  This function is also called before each journal
+*                   checkpoint (see 'fs_fat_journal.c  FS_FAT_JournalCkptWr()  Note #5').
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+void  FS_FAT_EntryCommitWr (FS_VOL  *p_vol,
+                            FS_BUF  *p_buf,
+                            FS_ERR  *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_entry;
+    CLK_TS_SEC         ts;
+    CPU_BOOLEAN        ok;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+   *p_err      =  FS_ERR_NONE;
+
+    p_entry = p_fat_data->CommitListPtr;
+    while (p_entry != (FS_FAT_FILE_DATA *)0) {                  /* Wr each pending entry (see Note #2).                 */
+        FS_FAT_LowEntryUpdate(p_vol,
+                              p_buf,
+                              p_entry,
+                              DEF_NO,                           /* Wr recorded date/time (see Note #3).                 */
+                              p_err);
+        if (*p_err != FS_ERR_NONE) {                            /* See Note #4.                                         */
+            return;
+        }
+
+        p_fat_data->CommitListPtr = p_entry->CommitNextPtr;
+        p_entry->CommitNextPtr    = (FS_FAT_FILE_DATA *)0;
+        p_entry->CommitPend       =  DEF_NO;
+        p_entry->UpdateReqd       =  DEF_NO;
+        p_entry                   =  p_fat_data->CommitListPtr;
+    }
+
+    FSBuf_Flush(p_buf, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    ok = Clk_GetTS(&ts);
+    if (ok == DEF_OK) {
+        p_fat_data->CommitTS = ts;
+    }
+}
+#endif
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
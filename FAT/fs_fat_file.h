@@ -101,6 +101,19 @@
 void          FS_FAT_FileModuleInit(FS_QTY          file_cnt,   /* Init FAT dir module.                                 */
                                     FS_ERR         *p_err);
 
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)
+void          FS_FAT_EntryCommit   (CPU_CHAR       *name_vol,   /* Wr pending dir entries of vol.                       */
+                                    FS_ERR         *p_err);
+
+void          FS_FAT_EntryCommitIntervalSet(CPU_CHAR   *name_vol,       /* Set dir entry commit interval of vol.        */
+                                            CPU_INT32U  interval_sec,
+                                            FS_ERR     *p_err);
+
+void          FS_FAT_EntryCommitWr (FS_VOL         *p_vol,      /* Wr dir entries on vol commit list.                   */
+                                    FS_BUF         *p_buf,
+                                    FS_ERR         *p_err);
+#endif
+
 /*
 *********************************************************************************************************
 *                                  SYSTEM DRIVER FUNCTION PROTOTYPES
@@ -110,6 +123,12 @@ void          FS_FAT_FileModuleInit(FS_QTY          file_cnt,   /* Init FAT dir
 void          FS_FAT_FileClose     (FS_FILE        *p_file,     /* Close a file.                                        */
                                     FS_ERR         *p_err);
 
+FS_QTY        FS_FAT_FileMap       (FS_FILE        *p_file,     /* Get direct mem addr's of file data.                  */
+                                    FS_FILE_SIZE    pos,
+                                    FS_FILE_EXTENT *p_extent_tbl,
+                                    FS_QTY          extent_cnt,
+                                    FS_ERR         *p_err);
+
 void          FS_FAT_FileOpen      (FS_FILE        *p_file,     /* Open a file.                                         */
                                     CPU_CHAR       *name_file,
                                     FS_ERR         *p_err);
@@ -118,6 +137,12 @@ void          FS_FAT_FilePosSet    (FS_FILE        *p_file,     /* Set file posi
                                     FS_FILE_SIZE    pos_new,
                                     FS_ERR         *p_err);
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void          FS_FAT_FilePrealloc  (FS_FILE        *p_file,     /* Alloc clus's to a file ahead of wr's.                */
+                                    FS_FILE_SIZE    size,
+                                    FS_ERR         *p_err);
+#endif
+
 void          FS_FAT_FileQuery     (FS_FILE        *p_file,     /* Get info about file.                                 */
                                     FS_ENTRY_INFO  *p_info,
                                     FS_ERR         *p_err);
@@ -127,6 +152,17 @@ CPU_SIZE_T    FS_FAT_FileRd        (FS_FILE        *p_file,     /* Read from a f
                                     CPU_SIZE_T      size,
                                     FS_ERR         *p_err);
 
+CPU_SIZE_T    FS_FAT_FileRdAt      (FS_FILE        *p_file,     /* Read from a file at a given position.                */
+                                    void           *p_dest,
+                                    CPU_SIZE_T      size,
+                                    FS_FILE_SIZE    pos,
+                                    FS_ERR         *p_err);
+
+CPU_SIZE_T    FS_FAT_FileRdV       (FS_FILE        *p_file,     /* Read from a file into several buffers.               */
+                                    FS_FILE_IOV    *p_iov,
+                                    FS_QTY          iov_cnt,
+                                    FS_ERR         *p_err);
+
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
 void          FS_FAT_FileTruncate  (FS_FILE        *p_file,     /* Truncate a file.                                     */
                                     FS_FILE_SIZE    size,
@@ -140,6 +176,21 @@ CPU_SIZE_T    FS_FAT_FileWr        (FS_FILE        *p_file,     /* Write to a fi
                                     FS_ERR         *p_err);
 #endif
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T    FS_FAT_FileWrAt      (FS_FILE        *p_file,     /* Write to a file at a given position.                 */
+                                    void           *p_src,
+                                    CPU_SIZE_T      size,
+                                    FS_FILE_SIZE    pos,
+                                    FS_ERR         *p_err);
+#endif
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T    FS_FAT_FileWrV       (FS_FILE        *p_file,     /* Write to a file from several buffers.                */
+                                    FS_FILE_IOV    *p_iov,
+                                    FS_QTY          iov_cnt,
+                                    FS_ERR         *p_err);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -50,6 +50,7 @@
 #include  "../Source/fs_file.h"
 #include  "../Source/fs_vol.h"
 #include  "fs_fat.h"
+#include  "fs_fat_file.h"
 #include  "fs_fat_journal.h"
 #include  "fs_fat_lfn.h"
 #include  "fs_fat_sfn.h"
@@ -77,11 +78,14 @@
 
 #define  FS_FAT_JOURNAL_MARK_ENTER                      0x6666u
 #define  FS_FAT_JOURNAL_MARK_ENTER_END                  0xDDDDu
+#define  FS_FAT_JOURNAL_MARK_SEC                        0x5A5Au
 
 #define  FS_FAT_JOURNAL_SIG_CLUS_CHAIN_ALLOC            0x0001u
 #define  FS_FAT_JOURNAL_SIG_CLUS_CHAIN_DEL              0x0002u
 #define  FS_FAT_JOURNAL_SIG_ENTRY_CREATE                0x0003u
 #define  FS_FAT_JOURNAL_SIG_ENTRY_UPDATE                0x0004u
+#define  FS_FAT_JOURNAL_SIG_CKPT                        0x0005u
+#define  FS_FAT_JOURNAL_SIG_CLUS_RANGE_DEL              0x0006u
 
 #define  FS_FAT_JOURNAL_LOG_MARK_SIZE                    2u
 #define  FS_FAT_JOURNAL_LOG_SIG_SIZE                     2u
@@ -89,8 +93,18 @@
 #define  FS_FAT_JOURNAL_LOG_CLUS_CHAIN_DEL_HEADER_SIZE  13u
 #define  FS_FAT_JOURNAL_LOG_ENTRY_CREATE_SIZE           22u
 #define  FS_FAT_JOURNAL_LOG_ENTRY_DEL_HEADER_SIZE       20u
+#define  FS_FAT_JOURNAL_LOG_CKPT_SIZE                    6u
+#define  FS_FAT_JOURNAL_LOG_CLUS_RANGE_DEL_HEADER_SIZE  11u
+#define  FS_FAT_JOURNAL_LOG_CLUS_RANGE_SIZE              8u
+
+#define  FS_FAT_JOURNAL_SEC_HDR_SIZE                     6u
 
 #define  FS_FAT_JOURNAL_MAX_DEL_MARKER_STEP_SIZE        1000u
+#define  FS_FAT_JOURNAL_MAX_DEL_RANGE_NBR                 16u
+
+#define  FS_FAT_JOURNAL_LOG_CLUS_RANGE_DEL_MAX_SIZE    (FS_FAT_JOURNAL_LOG_CLUS_RANGE_DEL_HEADER_SIZE                     + \
+                                                      FS_FAT_JOURNAL_LOG_MARK_SIZE                                      + \
+                                                     (FS_FAT_JOURNAL_MAX_DEL_RANGE_NBR * FS_FAT_JOURNAL_LOG_CLUS_RANGE_SIZE))
 
 #define  FS_FAT_JOURNAL_FILE_NAME                      "journal.jnl"
 
@@ -144,6 +158,34 @@ enum  FS_FAT_JOURNAL_CLUS_CHAIN_DEL_LOG_STRUCTURE {
 };
 
 
+                                                                /* ----------- CLUS RANGE DEL LOG STRUCTURE ----------- */
+enum  FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_STRUCTURE {
+    FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_ENTER_MARK_OFFSET       = 0u,
+    FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_SIG_OFFSET              = FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_ENTER_MARK_OFFSET
+                                                              + FS_FAT_JOURNAL_LOG_MARK_SIZE,
+
+    FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_START_CLUS_OFFSET       = FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_SIG_OFFSET
+                                                              + FS_FAT_JOURNAL_LOG_SIG_SIZE,
+
+    FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_DEL_FIRST_OFFSET        = FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_START_CLUS_OFFSET
+                                                              + sizeof(FS_FAT_CLUS_NBR),
+
+    FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_NBR_RANGE_OFFSET        = FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_DEL_FIRST_OFFSET
+                                                              + sizeof(CPU_BOOLEAN),
+
+    FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_RANGE_START_OFFSET      = FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_NBR_RANGE_OFFSET
+                                                              + sizeof(CPU_INT16U)
+};
+
+
+                                                                /* -------------- CLUS RANGE STRUCTURE ---------------- */
+enum  FS_FAT_JOURNAL_CLUS_RANGE_STRUCTURE {
+    FS_FAT_JOURNAL_CLUS_RANGE_FIRST_CLUS_OFFSET               = 0u,
+    FS_FAT_JOURNAL_CLUS_RANGE_CLUS_CNT_OFFSET                 = FS_FAT_JOURNAL_CLUS_RANGE_FIRST_CLUS_OFFSET
+                                                              + sizeof(FS_FAT_CLUS_NBR)
+};
+
+
                                                                 /* ------------ ENTRY CREATE LOG STRUCTURE ------------ */
 enum  FS_FAT_JOURNAL_ENTRY_CREATE_LOG_STRUCTURE {
     FS_FAT_JOURNAL_ENTRY_CREATE_LOG_ENTER_MARK_OFFSET         = 0u,
@@ -167,6 +209,25 @@ enum  FS_FAT_JOURNAL_ENTRY_CREATE_LOG_STRUCTURE {
 };
 
 
+                                                                /* ---------------- CKPT LOG STRUCTURE ---------------- */
+enum  FS_FAT_JOURNAL_CKPT_LOG_STRUCTURE {
+    FS_FAT_JOURNAL_CKPT_LOG_ENTER_MARK_OFFSET                 = 0u,
+    FS_FAT_JOURNAL_CKPT_LOG_SIG_OFFSET                        = FS_FAT_JOURNAL_CKPT_LOG_ENTER_MARK_OFFSET
+                                                              + FS_FAT_JOURNAL_LOG_MARK_SIZE,
+
+    FS_FAT_JOURNAL_CKPT_LOG_ENTER_END_MARK_OFFSET             = FS_FAT_JOURNAL_CKPT_LOG_SIG_OFFSET
+                                                              + FS_FAT_JOURNAL_LOG_SIG_SIZE
+};
+
+
+                                                                /* ---------------- SEC HEADER STRUCTURE -------------- */
+enum  FS_FAT_JOURNAL_SEC_HDR_STRUCTURE {
+    FS_FAT_JOURNAL_SEC_HDR_MARK_OFFSET                        = 0u,
+    FS_FAT_JOURNAL_SEC_HDR_POS_OFFSET                         = FS_FAT_JOURNAL_SEC_HDR_MARK_OFFSET
+                                                              + FS_FAT_JOURNAL_LOG_MARK_SIZE
+};
+
+
                                                                 /* ------------- ENTRY DEL LOG STRUCTURE -------------- */
 enum  FS_FAT_JOURNAL_ENTRY_DEL_LOG_STRUCTURE {
     FS_FAT_JOURNAL_ENTRY_DEL_LOG_ENTER_MARK_OFFSET            = 0u,
@@ -211,6 +272,9 @@ enum  FS_FAT_JOURNAL_ENTRY_DEL_LOG_STRUCTURE {
 */
 
 static  MEM_POOL  FS_FAT_JournalFileDataPool;
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+static  MEM_POOL  FS_FAT_JournalStageBufPool;
+#endif
 
 
 /*
@@ -231,17 +295,34 @@ static  void         FS_FAT_JournalFileCreate          (FS_VOL      *p_vol,
                                                         FS_ERR      *p_err);
 
                                                                                 /* --------- JOURNAL LOG FNCTS -------- */
-static  void         FS_FAT_JournalPeek                (FS_VOL      *p_vol,     /* Peek at next journal log.            */
-                                                        FS_BUF      *p_buf,
-                                                        void        *p_log,
-                                                        CPU_SIZE_T   pos,
-                                                        CPU_SIZE_T   len,
-                                                        FS_ERR      *p_err);
-
-static  void         FS_FAT_JournalPosSet              (FS_VOL      *p_vol,     /* Set journal file pos.                */
-                                                        FS_BUF      *p_buf,
-                                                        CPU_SIZE_T   pos,
-                                                        FS_ERR      *p_err);
+static  void         FS_FAT_JournalPeek                (FS_VOL            *p_vol, /* Peek at next journal log.          */
+                                                        FS_BUF            *p_buf,
+                                                        void              *p_log,
+                                                        FS_FAT_FILE_SIZE   pos,
+                                                        CPU_SIZE_T         len,
+                                                        FS_ERR            *p_err);
+
+static  void         FS_FAT_JournalPosSet              (FS_VOL            *p_vol, /* Set journal file pos.              */
+                                                        FS_BUF            *p_buf,
+                                                        FS_FAT_FILE_SIZE   pos,
+                                                        FS_ERR            *p_err);
+
+static  FS_FAT_FILE_SIZE  FS_FAT_JournalPosAdv         (FS_FAT_DATA       *p_fat_data, /* Adv journal pos.              */
+                                                        FS_FAT_FILE_SIZE   pos,
+                                                        CPU_SIZE_T         len);
+
+static  FS_FAT_SEC_NBR  FS_FAT_JournalSecFirstGet      (FS_FAT_DATA       *p_fat_data); /* Get first journal sec.     */
+
+static  FS_FAT_SEC_NBR  FS_FAT_JournalSecNextGet       (FS_VOL            *p_vol, /* Get next journal sec.              */
+                                                        FS_BUF            *p_buf,
+                                                        FS_FAT_SEC_NBR     sec,
+                                                        FS_FAT_FILE_SIZE   pos,
+                                                        FS_ERR            *p_err);
+
+static  CPU_INT08U  *FS_FAT_JournalSecGet              (FS_VOL            *p_vol, /* Get journal sec data.              */
+                                                        FS_BUF            *p_buf,
+                                                        FS_FAT_SEC_NBR     sec,
+                                                        FS_ERR            *p_err);
 
 static  void         FS_FAT_JournalRd                  (FS_VOL      *p_vol,     /* Rd data from log into buf.           */
                                                         FS_BUF      *p_buf,
@@ -263,17 +344,54 @@ static  void         FS_FAT_JournalWr                  (FS_VOL      *p_vol,
                                                         CPU_SIZE_T   len,
                                                         FS_ERR      *p_err);
 
-static  CPU_SIZE_T   FS_FAT_JournalReverseScan         (FS_VOL      *p_vol,     /* Reverse scan journal.                */
+static  FS_FAT_FILE_SIZE  FS_FAT_JournalReverseScan    (FS_VOL            *p_vol, /* Reverse scan journal.              */
+                                                        FS_BUF            *p_buf,
+                                                        FS_FAT_FILE_SIZE   start_pos,
+                                                        FS_FAT_FILE_SIZE   end_pos,
+                                                        CPU_INT08U        *p_pattern,
+                                                        CPU_SIZE_T         pattern_size,
+                                                        FS_ERR            *p_err);
+
+static  void         FS_FAT_JournalCkptWr              (FS_VOL      *p_vol,     /* Wr ckpt log.                         */
                                                         FS_BUF      *p_buf,
-                                                        CPU_SIZE_T   start_pos,
-                                                        CPU_INT08U  *p_pattern,
-                                                        CPU_SIZE_T   pattern_size,
                                                         FS_ERR      *p_err);
 
+static  void         FS_FAT_JournalCkptFlush           (FS_VOL      *p_vol,     /* Wr & flush ckpt log.                 */
+                                                        FS_ERR      *p_err);
+
+static  CPU_INT16U   FS_FAT_JournalClusRangeGet        (FS_VOL           *p_vol, /* Get clus ranges of clus chain.      */
+                                                        FS_BUF           *p_buf,
+                                                        FS_FAT_CLUS_NBR   start_clus,
+                                                        FS_FAT_CLUS_NBR   nbr_clus,
+                                                        CPU_INT08U       *p_range,
+                                                        FS_ERR           *p_err);
+
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)                                   /* --------- JOURNAL TX FNCTS --------- */
+static  CPU_BOOLEAN  FS_FAT_JournalTxDefer             (FS_VOL      *p_vol);    /* Chk if journal ckpt may be deferred. */
+#endif
+
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)                                /* ------ JOURNAL STAGING FNCTS ------- */
+static  void         FS_FAT_JournalStageRdWr           (FS_VOL          *p_vol, /* Rd/wr journal staging buf.           */
+                                                        FS_FAT_SEC_NBR   sec,
+                                                        CPU_BOOLEAN      wr,
+                                                        FS_ERR          *p_err);
+
+static  void         FS_FAT_JournalStageSet            (FS_VOL          *p_vol, /* Set journal staging buf.             */
+                                                        FS_FAT_SEC_NBR   sec,
+                                                        CPU_BOOLEAN      rd,
+                                                        FS_ERR          *p_err);
+#endif
+
                                                                                 /* ------- JOURNAL REPLAY FNCTS ------- */
 static  void         FS_FAT_JournalReplay              (FS_VOL      *p_vol,     /* Replay journal.                      */
                                                         FS_ERR      *p_err);
 
+static  CPU_BOOLEAN  FS_FAT_JournalSecScan             (FS_VOL            *p_vol, /* Find journal head & tail.          */
+                                                        FS_BUF            *p_buf,
+                                                        FS_FAT_FILE_SIZE  *p_head_pos,
+                                                        FS_FAT_FILE_SIZE  *p_tail_pos,
+                                                        FS_ERR            *p_err);
+
 static  void         FS_FAT_JournalRevertClusChainAlloc(FS_VOL      *p_vol,     /* Revert clus alloc.                   */
                                                         FS_BUF      *p_buf,
                                                         FS_ERR      *p_err);
@@ -282,6 +400,10 @@ static  void         FS_FAT_JournalReplayClusChainDel  (FS_VOL      *p_vol,
                                                         FS_BUF      *p_buf,
                                                         FS_ERR      *p_err);
 
+static  void         FS_FAT_JournalReplayClusRangeDel  (FS_VOL      *p_vol,     /* Complete clus range del.             */
+                                                        FS_BUF      *p_buf,
+                                                        FS_ERR      *p_err);
+
 static  void         FS_FAT_JournalRevertEntryCreate   (FS_VOL      *p_vol,     /* Revert dir entry creation.           */
                                                         FS_BUF      *p_buf,
                                                         FS_ERR      *p_err);
@@ -315,6 +437,8 @@ static  void         FS_FAT_JournalRevertEntryUpdate   (FS_VOL      *p_vol,
 *                               FS_ERR_NAME_NULL                   Argument 'name_vol' passed a NULL pointer.
 *                               FS_ERR_VOL_NOT_OPEN                Volume not open.
 *                               FS_ERR_VOL_JOURNAL_ALREADY_OPEN    Journal already open.
+*                               FS_ERR_VOL_JOURNAL_CFG_CHNGD       Old-format journal logs discarded (see
+*                                                                      Note #2).
 *                               FS_ERR_BUF_NONE_AVAIL              No buffer available.
 *                               FS_ERR_DEV                         Device access error.
 *
@@ -322,6 +446,10 @@ static  void         FS_FAT_JournalRevertEntryUpdate   (FS_VOL      *p_vol,
 *
 * Note(s)     : (1) If the journal file could not be read, it may have been only partially created.
 *                   It must be fully created, with the correct length & cleared data.
+*
+*               (2) Pending logs of a journal written in the old format can NOT be replayed & are
+*                   discarded (see 'FS_FAT_JournalReplay()  Note #7').  The journal is NOT opened : the
+*                   volume should be checked with 'FS_FAT_VolChk()' before the journal is opened again.
 *********************************************************************************************************
 */
 
@@ -371,6 +499,10 @@ void  FS_FAT_JournalOpen (CPU_CHAR  *name_vol,
         return;
     }
 
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+    p_fat_data->JournalStageState = FS_BUF_STATE_NONE;          /* Discard staged journal sec, if any.                  */
+#endif
+
     FS_FAT_LowEntryFind(p_vol,                                 /* Find journal file, if it exists.                     */
                         p_journal_data,
                         FS_FAT_JOURNAL_FILE_NAME,
@@ -456,10 +588,175 @@ void  FS_FAT_JournalOpen (CPU_CHAR  *name_vol,
     } else {
         DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN);
     }
-    DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START |
-                                          FS_FAT_JOURNAL_STATE_REPLAY);
+    DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START  |
+                                          FS_FAT_JOURNAL_STATE_REPLAY |
+                                          FS_FAT_JOURNAL_STATE_TX_PEND);
+    FSVol_ReleaseUnlock(p_vol);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_JournalOpenDev()
+*
+* Description : Open journal placed on another device, replaying contents to restore file system to safe
+*               state.
+*
+* Argument(s) : name_vol    Volume name.
+*
+*               name_dev    Name of device holding the journal.
+*
+*               start       First device sector of the journal.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                        Journal opened.
+*                               FS_ERR_NAME_NULL                   Argument 'name_vol'/'name_dev' passed a NULL
+*                                                                      pointer.
+*                               FS_ERR_VOL_NOT_OPEN                Volume not open.
+*                               FS_ERR_VOL_JOURNAL_ALREADY_OPEN    Journal already open.
+*                               FS_ERR_DEV_NOT_OPEN                Journal device not open.
+*                               FS_ERR_DEV_INVALID                 Journal device is the volume device.
+*                               FS_ERR_DEV_INVALID_SEC_SIZE        Journal device sector size differs from the
+*                                                                      volume sector size.
+*                               FS_ERR_DEV_INVALID_SIZE            Journal does not fit on the journal device.
+*
+*                               ------------------RETURNED BY FS_FAT_JournalReplay()-----------------
+*                               See FS_FAT_JournalReplay() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The journal occupies the FS_FAT_JOURNAL_FILE_LEN octets following sector 'start' of the
+*                   journal device, e.g., a small NOR flash or FRAM.  Journal writes then no longer compete
+*                   with the volume I/O.  These sectors MUST be dedicated to the journal of this volume :
+*                   they MUST NOT be part of any volume & the journal of another volume MUST NOT be
+*                   placed on them.  A region never written holds no valid journal sector & is used as an
+*                   empty journal.
+*
+*               (2) The journal device lock is acquired while the lock of the volume device is held.  The
+*                   journal device MUST NOT hold a volume whose journal is placed on the volume device.
+*
+*               (3) The journal is always written through the staging buffer (see 'fs_cfg.h  FILE SYSTEM FAT
+*                   CONFIGURATION  Note #10').  A journal file on the volume, if any, is left untouched.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+void  FS_FAT_JournalOpenDev (CPU_CHAR    *name_vol,
+                             CPU_CHAR    *name_dev,
+                             FS_SEC_NBR   start,
+                             FS_ERR      *p_err)
+{
+    FS_FAT_DATA   *p_fat_data;
+    FS_VOL        *p_vol;
+    FS_DEV        *p_dev;
+    FS_SEC_QTY     sec_cnt;
+    CPU_BOOLEAN    lock_success;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------- VALIDATE PTR & FILE SIZE ------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == DEF_NULL) {                                 /* Validate vol name ptr.                               */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+    if (name_dev == DEF_NULL) {                                 /* Validate dev name ptr.                               */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+    if (FS_UTIL_IS_PWR2(FS_FAT_JOURNAL_FILE_LEN) == DEF_NO) {   /* Validate journal file size.                          */
+        FS_TRACE_DBG(("FS_FAT_JournalOpenDev(): Journal file len must be a power of 2.\r\n"));
+       *p_err = FS_ERR_INVALID_CFG;
+        return;
+    }
+#endif
+
+
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol may NOT be unmounted.                            */
+    if (p_vol == DEF_NULL) {
+        return;
+    }
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+                                                                /* If journal is already open ...                       */
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_YES) {
+       *p_err = FS_ERR_VOL_JOURNAL_ALREADY_OPEN;                /* ... rtn err.                                         */
+        FSVol_ReleaseUnlock(p_vol);
+        return;
+    }
+
+
+                                                                /* ---------------- ACQUIRE JOURNAL DEV --------------- */
+    p_dev = FSDev_Acquire(name_dev);
+    if (p_dev == DEF_NULL) {
+       *p_err = FS_ERR_DEV_NOT_OPEN;
+        FSVol_ReleaseUnlock(p_vol);
+        return;
+    }
+
+    if (p_dev == p_vol->DevPtr) {                               /* Journal on vol dev MUST be a file.                   */
+       *p_err = FS_ERR_DEV_INVALID;
+        FSVol_ReleaseUnlock(p_vol);
+        FSDev_Release(p_dev);
+        return;
+    }
+
+    lock_success = FSDev_Lock(p_dev);                           /* See Note #2.                                         */
+    if (lock_success != DEF_YES) {
+       *p_err = FS_ERR_OS_LOCK;
+        FSVol_ReleaseUnlock(p_vol);
+        FSDev_Release(p_dev);
+        return;
+    }
+                                                                /* Validate journal dev sec size & size.                */
+    sec_cnt = (FS_SEC_QTY)FS_UTIL_DIV_PWR2(FS_FAT_JOURNAL_FILE_LEN, p_fat_data->SecSizeLog2);
+    if (p_dev->State != FS_DEV_STATE_LOW_FMT_VALID) {
+       *p_err = FS_ERR_DEV_NOT_OPEN;
+    } else if (p_dev->SecSize != p_fat_data->SecSize) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_SIZE;
+    } else if ((start            >  p_dev->Size) ||
+               (p_dev->Size - start < sec_cnt)) {
+       *p_err = FS_ERR_DEV_INVALID_SIZE;
+    } else {
+       *p_err = FS_ERR_NONE;
+    }
+    FSDev_Unlock(p_dev);
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_FAT_JournalOpenDev(): Journal cannot be placed on dev %s.\r\n", name_dev));
+        FSVol_ReleaseUnlock(p_vol);
+        FSDev_Release(p_dev);
+        return;
+    }
+
+
+                                                                /* ------------------ REPLAY JOURNAL ------------------ */
+    p_fat_data->JournalDevPtr     = p_dev;
+    p_fat_data->JournalDevStart   = start;
+    p_fat_data->JournalStageState = FS_BUF_STATE_NONE;          /* Discard staged journal sec, if any.                  */
+
+    DEF_BIT_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN);
+    FS_FAT_JournalReplay(p_vol, p_err);
+
+
+                                                                /* ------------------ JOURNAL OPENED ------------------ */
+    if (*p_err == FS_ERR_NONE) {
+        DEF_BIT_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN);
+    } else {
+        DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN);
+        p_fat_data->JournalStageState = FS_BUF_STATE_NONE;
+        p_fat_data->JournalDevPtr     = DEF_NULL;
+        FSDev_Release(p_dev);
+    }
+    DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START  |
+                                          FS_FAT_JOURNAL_STATE_REPLAY |
+                                          FS_FAT_JOURNAL_STATE_TX_PEND);
     FSVol_ReleaseUnlock(p_vol);
 }
+#endif
 
 
 /*
@@ -480,7 +777,8 @@ void  FS_FAT_JournalOpen (CPU_CHAR  *name_vol,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The reference to a journal device acquired by 'FS_FAT_JournalOpenDev()' is released.
+*                   Logs remaining in the staging buffer protect no pending write & are discarded.
 *********************************************************************************************************
 */
 
@@ -523,6 +821,13 @@ void  FS_FAT_JournalClose (CPU_CHAR  *name_vol,
         DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN  |
                                               FS_FAT_JOURNAL_STATE_START |
                                               FS_FAT_JOURNAL_STATE_REPLAY);
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+        if (p_fat_data->JournalDevPtr != DEF_NULL) {            /* Release journal dev (see Note #1).                   */
+            p_fat_data->JournalStageState = FS_BUF_STATE_NONE;
+            FSDev_Release(p_fat_data->JournalDevPtr);
+            p_fat_data->JournalDevPtr     = DEF_NULL;
+        }
+#endif
        *p_err = FS_ERR_NONE;
     }
 
@@ -612,11 +917,18 @@ void  FS_FAT_JournalStart (CPU_CHAR  *name_vol,
 *                               FS_ERR_VOL_JOURNAL_NOT_OPEN       Journal not open.
 *                               FS_ERR_VOL_JOURNAL_NOT_STARTED    Journaling not started.
 *
+*                               ----------------RETURNED BY FS_FAT_JournalCkptFlush()----------------
+*                               See FS_FAT_JournalCkptFlush() for additional return error codes.
+*
 * Return(s)   : none.
 *
 * Note(s)     : (1) Journaling should never be stopped unless volume is going to be closed. If FAT
 *                   operations are performed after journal is stopped and failure occurs, file system could
 *                   be left in an inconsistent state after volume remounting.
+*
+*               (2) Operations pending in an open journal transaction or on the volume directory entry
+*                   commit list (see 'fs_fat_file.c  FS_FAT_EntryCommitIntervalSet()  Note #3a') are
+*                   committed & any transaction still begun is ended.
 *********************************************************************************************************
 */
 
@@ -656,8 +968,13 @@ void  FS_FAT_JournalStop (CPU_CHAR  *name_vol,
        *p_err = FS_ERR_VOL_JOURNAL_NOT_STARTED;
 
     } else {
-        DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START);
-       *p_err = FS_ERR_NONE;
+        FS_FAT_JournalCkptFlush(p_vol, p_err);                  /* Commit pending ops (see Note #2).                    */
+        if (*p_err == FS_ERR_NONE) {
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+            p_fat_data->JournalTxNestCnt = 0u;
+#endif
+            DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START);
+        }
     }
 
 
@@ -668,394 +985,802 @@ void  FS_FAT_JournalStop (CPU_CHAR  *name_vol,
 
 /*
 *********************************************************************************************************
-*********************************************************************************************************
-*                                         INTERNAL FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
-
-/*
-*********************************************************************************************************
-*                                     FS_FAT_JournalModuleInit()
+*                                       FS_FAT_JournalTxBegin()
 *
-* Description : Initialize FAT Journal module.
+* Description : Begin a journal transaction on a volume.
 *
-* Argument(s) : vol_cnt     Number of volumes in use.
+* Argument(s) : name_vol    Volume name.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                               FS_ERR_NONE         Module initialized.
-*                               FS_ERR_MEM_ALLOC    Memory could not be allocated.
+*                               FS_ERR_NONE                       Journal transaction begun.
+*                               FS_ERR_NAME_NULL                  Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_VOL_NOT_OPEN               Volume not open.
+*                               FS_ERR_VOL_JOURNAL_NOT_OPEN       Journal not open.
+*                               FS_ERR_VOL_JOURNAL_NOT_STARTED    Journaling not started.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) Until the transaction is committed with 'FS_FAT_JournalTxCommit()', the journal is
+*                   NOT cleared at the end of each top level FAT operation.  The logs of all operations
+*                   performed on the volume, by any task, accumulate in the journal & are cleared at once
+*                   upon commit.  If a failure occurs before the commit, every operation of the
+*                   transaction is reverted when the journal is replayed.
+*
+*               (2) A top level operation deleting a cluster chain (e.g., file deletion or truncation)
+*                   cannot be reverted & is completed when the journal is replayed.  Operations performed
+*                   before it within the same transaction are then kept (see 'FS_FAT_JournalReplay()
+*                   Note #3').
+*
+*               (3) If more than half of the journal, or more than the window size set with
+*                   'FS_FAT_JournalTxWindowSet()', is filled, the operations performed so far are
+*                   committed early, so that the next operation may always be logged.
+*
+*               (4) Transactions may be nested.  The journal is checkpointed when the outermost transaction
+*                   is committed.
 *********************************************************************************************************
 */
 
-void  FS_FAT_JournalModuleInit (FS_QTY   vol_cnt,
-                                FS_ERR  *p_err)
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+void  FS_FAT_JournalTxBegin (CPU_CHAR  *name_vol,
+                             FS_ERR    *p_err)
 {
-    CPU_SIZE_T  octets_reqd;
-    LIB_ERR     pool_err;
+    FS_FAT_DATA  *p_fat_data;
+    FS_VOL       *p_vol;
 
 
-                                                                /* ----------- CREATE JOURNAL FILE DATA POOL ---------- */
-    Mem_PoolCreate(&FS_FAT_JournalFileDataPool,
-                    DEF_NULL,
-                    0,
-                    vol_cnt,
-                    sizeof(FS_FAT_FILE_DATA),
-                    sizeof(CPU_ALIGN),
-                   &octets_reqd,
-                   &pool_err);
-    if (pool_err != LIB_MEM_ERR_NONE) {
-       *p_err = FS_ERR_MEM_ALLOC;
-        FS_TRACE_INFO(("FS_FAT_JournalModuleInit(): Could not alloc mem for journal file info pool: %d octets req'd.\r\n", octets_reqd));
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE PTR ------------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == DEF_NULL) {                                 /* Validate vol name ptr.                               */
+       *p_err = FS_ERR_NAME_NULL;
         return;
     }
+#endif
 
-   *p_err = FS_ERR_NONE;
+
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol may NOT be unmounted.                            */
+    (void)p_err;                                               /* Err ignored. Ret val chk'd instead.                  */
+    if (p_vol == DEF_NULL) {
+        return;
+    }
+
+
+                                                                /* ---------------------- BEGIN TX -------------------- */
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_NO) {
+       *p_err = FS_ERR_VOL_JOURNAL_NOT_OPEN;
+
+    } else if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START) == DEF_NO) {
+       *p_err = FS_ERR_VOL_JOURNAL_NOT_STARTED;
+
+    } else {
+        p_fat_data->JournalTxNestCnt++;                         /* See Note #4.                                         */
+       *p_err = FS_ERR_NONE;
+    }
+
+
+                                                                /* ----------------- RELEASE VOL LOCK ----------------- */
+    FSVol_ReleaseUnlock(p_vol);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                        FS_FAT_JournalInit()
+*                                      FS_FAT_JournalTxCommit()
 *
-* Description : Initialize journal.
+* Description : Commit a journal transaction on a volume.
 *
-* Argument(s) : p_vol       Pointer to volume.
+* Argument(s) : name_vol    Volume name.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                               FS_ERR_NONE          Journal initialized.
-*                               FS_ERR_POOL_EMPTY    File info not available.
+*                               FS_ERR_NONE                       Journal transaction committed.
+*                               FS_ERR_NAME_NULL                  Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_VOL_NOT_OPEN               Volume not open.
+*                               FS_ERR_VOL_JOURNAL_NOT_OPEN       Journal not open.
+*                               FS_ERR_VOL_JOURNAL_NOT_STARTED    Journaling not started.
+*
+*                               -----------------RETURNED BY FS_FAT_JournalTxFlush()-----------------
+*                               See FS_FAT_JournalTxFlush() for additional return error codes.
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The file system lock MUST be held to get the journal file data from the journal file
-*                   data pool.
+* Note(s)     : (1) If no transaction has been begun, the operations pending in the window set with
+*                   'FS_FAT_JournalTxWindowSet()' are committed.
 *********************************************************************************************************
 */
 
-void  FS_FAT_JournalInit (FS_VOL  *p_vol,
-                          FS_ERR  *p_err)
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+void  FS_FAT_JournalTxCommit (CPU_CHAR  *name_vol,
+                              FS_ERR    *p_err)
 {
-    FS_FAT_FILE_DATA  *p_journal_data;
-    FS_FAT_DATA       *p_fat_data;
-    LIB_ERR            pool_err;
-
-
-    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
-
-
-                                                                /* ----------------- INIT JOURNAL DATA ---------------- */
-    DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN  |
-                                          FS_FAT_JOURNAL_STATE_START |
-                                          FS_FAT_JOURNAL_STATE_REPLAY);
-    p_fat_data->JournalDataPtr = DEF_NULL;
+    FS_FAT_DATA  *p_fat_data;
+    FS_VOL       *p_vol;
 
 
-                                                                /* -------------- ALLOC JOURNAL FILE DATA ------------- */
-    FS_OS_Lock(p_err);                                          /* Acquire FS lock (see Note #1).                       */
-    if (*p_err != FS_ERR_NONE) {
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE PTR ------------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == DEF_NULL) {                                 /* Validate vol name ptr.                               */
+       *p_err = FS_ERR_NAME_NULL;
         return;
     }
+#endif
 
-    p_journal_data = (FS_FAT_FILE_DATA *)Mem_PoolBlkGet(&FS_FAT_JournalFileDataPool,
-                                                         sizeof(FS_FAT_FILE_DATA),
-                                                        &pool_err);
-    (void)pool_err;                                            /* Err ignored. Ret val chk'd instead.                  */
 
-    FS_OS_Unlock();
-
-    if (p_journal_data == DEF_NULL) {
-       *p_err = FS_ERR_MEM_ALLOC;
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol may NOT be unmounted.                            */
+    (void)p_err;                                               /* Err ignored. Ret val chk'd instead.                  */
+    if (p_vol == DEF_NULL) {
         return;
     }
 
-    p_fat_data->JournalDataPtr = p_journal_data;
 
-   *p_err = FS_ERR_NONE;
+                                                                /* --------------------- COMMIT TX -------------------- */
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_NO) {
+       *p_err = FS_ERR_VOL_JOURNAL_NOT_OPEN;
+
+    } else if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START) == DEF_NO) {
+       *p_err = FS_ERR_VOL_JOURNAL_NOT_STARTED;
+
+    } else {
+        if (p_fat_data->JournalTxNestCnt > 0u) {
+            p_fat_data->JournalTxNestCnt--;
+        }
+        if (p_fat_data->JournalTxNestCnt == 0u) {               /* If outermost tx ...                                  */
+            FS_FAT_JournalTxFlush(p_vol, p_err);                /* ... checkpoint journal.                              */
+        } else {
+           *p_err = FS_ERR_NONE;
+        }
+    }
+
+
+                                                                /* ----------------- RELEASE VOL LOCK ----------------- */
+    FSVol_ReleaseUnlock(p_vol);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                        FS_FAT_JournalExit()
+*                                     FS_FAT_JournalTxWindowSet()
 *
-* Description : Free journal file data memory.
+* Description : Set the journal transaction window of a volume.
 *
-* Argument(s) : p_vol       Pointer to volume.
+* Argument(s) : name_vol        Volume name.
 *
-*               p_err       Pointer to variable that will receive the return error code from this function :
+*               interval_sec    Maximum time an operation may remain uncommitted, in seconds.
 *
-*                               FS_ERR_NONE    Journal exited.
+*               size            Maximum size of the logs of uncommitted operations, in octets.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE                    Journal transaction window set.
+*                                   FS_ERR_NAME_NULL               Argument 'name_vol' passed a NULL pointer.
+*                                   FS_ERR_VOL_NOT_OPEN            Volume not open.
+*                                   FS_ERR_VOL_JOURNAL_NOT_OPEN    Journal not open.
+*
+*                                   ---------------RETURNED BY FS_FAT_JournalTxFlush()---------------
+*                                   See FS_FAT_JournalTxFlush() for additional return error codes.
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The file system lock MUST be held to free the journal file data back to the journal
-*                   file data pool OR to free the journal buf back to the journal buf pool.
+* Note(s)     : (1) When either 'interval_sec' or 'size' is non-zero, consecutive top level FAT operations
+*                   share one journal checkpoint, as if performed in a transaction (see
+*                   'FS_FAT_JournalTxBegin()  Notes #1-3').  The journal is checkpointed at the end of the
+*                   first operation which finds that 'interval_sec' elapsed since the first pending
+*                   operation, or that 'size' octets of the journal are filled.  Setting both to zero
+*                   checkpoints the journal after each operation, which is the default.
+*
+*               (2) The window is only checked as operations complete.  The last operations performed
+*                   remain uncommitted until another operation is performed, until 'FS_FAT_JournalTxCommit()'
+*                   is called, or until journaling is stopped or the volume is closed.  These are reverted
+*                   if a failure occurs in the meantime.
+*
+*               (3) Time stamps are obtained from 'Clk_GetTS()'.  If no valid time stamp can be obtained,
+*                   the interval is ignored & the journal is checkpointed at the end of each operation, unless
+*                   a transaction is begun.
+*
+*               (4) Operations pending when this function is called are committed first.  The window is
+*                   reset to zero when the volume is mounted.
 *********************************************************************************************************
 */
 
-void  FS_FAT_JournalExit (FS_VOL  *p_vol,
-                          FS_ERR  *p_err)
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+void  FS_FAT_JournalTxWindowSet (CPU_CHAR    *name_vol,
+                                 CPU_INT32U   interval_sec,
+                                 CPU_SIZE_T   size,
+                                 FS_ERR      *p_err)
 {
-    FS_FAT_DATA       *p_fat_data;
-    FS_FAT_FILE_DATA  *p_journal_data;
-    LIB_ERR            pool_err;
+    FS_FAT_DATA  *p_fat_data;
+    FS_VOL       *p_vol;
 
 
-    FS_OS_Lock(p_err);                                          /* Acquire FS lock (see Note #1).                       */
-    if (*p_err != FS_ERR_NONE) {
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE PTR ------------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == DEF_NULL) {                                 /* Validate vol name ptr.                               */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+#endif
+
+
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol may NOT be unmounted.                            */
+    (void)p_err;                                               /* Err ignored. Ret val chk'd instead.                  */
+    if (p_vol == DEF_NULL) {
         return;
     }
 
+
+                                                                /* -------------------- SET WINDOW -------------------- */
     p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
 
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_NO) {
+       *p_err = FS_ERR_VOL_JOURNAL_NOT_OPEN;
 
-                                                                /* -------------- FREE JOURNAL FILE DATA -------------- */
-    p_journal_data =  p_fat_data->JournalDataPtr;               /* Free journal file data.                              */
-    if (p_journal_data != DEF_NULL) {
-        Mem_PoolBlkFree(        &FS_FAT_JournalFileDataPool,
-                        (void *) p_journal_data,
-                                &pool_err);
-        if (pool_err != LIB_MEM_ERR_NONE) {
-           *p_err = FS_ERR_MEM_ALLOC;
-        }
     } else {
-       *p_err = FS_ERR_VOL_JOURNAL_NOT_STARTED;
-        FS_OS_Unlock();
-        return;
+        FS_FAT_JournalTxFlush(p_vol, p_err);                    /* Commit pending ops (see Note #4).                    */
+        if (*p_err == FS_ERR_NONE) {
+            p_fat_data->JournalTxInterval = interval_sec;
+            p_fat_data->JournalTxSize     = size;
+        }
     }
 
-    FS_OS_Unlock();
+
+                                                                /* ----------------- RELEASE VOL LOCK ----------------- */
+    FSVol_ReleaseUnlock(p_vol);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                         FS_FAT_JournalClr()
-*
-* Description : Clear a portion of the journal.
-*
-* Argument(s) : p_vol   Pointer to volume.
-*
-*               p_buf   Pointer to temporary buffer.
-*
-*               p_err   Pointer to variable that will receive the return error code from this function :
+*                                    FS_FAT_JournalReplayInfoGet()
 *
-*                           FS_ERR_NONE                         Journal cleared.
-**                          FS_ERR_VOL_JOURNAL_FILE_INVALID     Journal file invalid.
+* Description : Get the cost of the last journal replay.
 *
-*                           -------------------RETURNED BY FSBuf_Set()-------------------
-*                           See FSBuf_Set() for additional return error codes.
+* Argument(s) : name_vol    Volume name.
 *
-*                           ---------------RETURNED BY FS_FAT_SecNextGet()---------------
-*                           See FS_FAT_SecNextGet() for additional return error codes.
+*               p_info      Pointer to structure that will receive the replay information.
 *
-*                           ----------------RETURNED BY FSBuf_MarkDirty()----------------
-*                           See FSBuf_MarkDirty() for additional return error codes.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                           --------------RETURNED BY FS_FAT_JournalSetPos()-------------
-*                           See FS_FAT_JournalSetPos() for additional return error codes.
+*                               FS_ERR_NONE                    Replay information obtained.
+*                               FS_ERR_NAME_NULL               Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_NULL_PTR                Argument 'p_info' passed a NULL pointer.
+*                               FS_ERR_VOL_NOT_OPEN            Volume not open.
+*                               FS_ERR_VOL_JOURNAL_NOT_OPEN    Journal not open.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The journal is replayed when it is opened.  The information describes that replay & is
+*                   all zero if the journal held no operation to replay or revert.
 *
+*               (2) See 'fs_fat.h  FAT JOURNAL REPLAY INFO DATA TYPE  Notes #1 & #2'.
 *********************************************************************************************************
 */
 
-void  FS_FAT_JournalClr (FS_VOL            *p_vol,
-                         FS_BUF            *p_buf,
-                         FS_FAT_FILE_SIZE   start_pos,
-                         FS_FAT_FILE_SIZE   len,
-                         FS_ERR            *p_err)
+void  FS_FAT_JournalReplayInfoGet (CPU_CHAR                    *name_vol,
+                                   FS_FAT_JOURNAL_REPLAY_INFO  *p_info,
+                                   FS_ERR                      *p_err)
 {
-    FS_FAT_DATA       *p_fat_data;
-    FS_FAT_FILE_DATA  *p_journal_data;
-    FS_FAT_SEC_NBR     first_sec;
-    FS_FAT_SEC_NBR     cur_sec;
-    FS_SEC_SIZE        cur_sec_pos;
-    FS_FAT_FILE_SIZE   rem_size;
-    FS_FAT_FILE_SIZE   wr_size;
-
-
-    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
-    p_journal_data =  p_fat_data->JournalDataPtr;
+    FS_FAT_DATA  *p_fat_data;
+    FS_VOL       *p_vol;
 
 
-                                                                /* ------------------- CHK JOURNAL -------------------- */
-    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_NO) {
-       *p_err = FS_ERR_NONE;
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE PTR ------------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == DEF_NULL) {                                 /* Validate vol name ptr.                               */
+       *p_err = FS_ERR_NAME_NULL;
         return;
     }
-
-    first_sec   =  FS_FAT_CLUS_TO_SEC(p_fat_data, p_journal_data->FileFirstClus);
-    cur_sec     =  first_sec + FS_UTIL_DIV_PWR2(start_pos, p_fat_data->SecSizeLog2);
-    cur_sec_pos = (start_pos & (p_fat_data->SecSize - 1u));
-    rem_size    =  len;
+    if (p_info == DEF_NULL) {                                   /* Validate info ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
+#endif
 
 
-                                                                /* ------------------- CLR JOURNAL -------------------- */
-    while (rem_size != 0u) {
-                                                                /* Update sizes.                                        */
-        wr_size   = DEF_MIN(p_fat_data->SecSize - cur_sec_pos, rem_size);
-        rem_size -= wr_size;
-                                                                /* Set buf.                                             */
-        FSBuf_Set(p_buf,
-                  cur_sec,
-                  FS_VOL_SEC_TYPE_FILE,
-                  DEF_YES,
-                  p_err);
-        if (*p_err != FS_ERR_NONE) {
-            return;
-        }
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol may NOT be unmounted.                            */
+    (void)p_err;                                               /* Err ignored. Ret val chk'd instead.                  */
+    if (p_vol == DEF_NULL) {
+        return;
+    }
 
-                                                                /* Clr buf.                                             */
-        Mem_Clr((void *)((CPU_INT08U *)p_buf->DataPtr + cur_sec_pos), (CPU_SIZE_T)wr_size);
 
-                                                                /* Mark buf dirty.                                      */
-        FSBuf_MarkDirty(p_buf, p_err);
-        if (*p_err != FS_ERR_NONE) {
-            return;
-        }
+                                                                /* -------------------- GET INFO ---------------------- */
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
 
-        if (rem_size != 0u) {                                   /* If sec to be cleared rem ...                         */
-            cur_sec = FS_FAT_SecNextGet(p_vol,                  /*                          ... get next sec.           */
-                                        p_buf,
-                                        cur_sec,
-                                        p_err);
-            if (*p_err != FS_ERR_NONE) {
-                *p_err = FS_ERR_VOL_JOURNAL_FILE_INVALID;
-                return;
-            }
-            cur_sec_pos = 0u;                                   /* Reset sec pos.                                        */
-        }
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_NO) {
+       *p_err = FS_ERR_VOL_JOURNAL_NOT_OPEN;
+    } else {
+       *p_info = p_fat_data->JournalReplayInfo;
+       *p_err  = FS_ERR_NONE;
     }
 
-    FS_TRACE_LOG(("FS_FAT_JournalClr(): %d octets cleared from position %d.\r\n", len, start_pos));
+
+                                                                /* ----------------- RELEASE VOL LOCK ----------------- */
+    FSVol_ReleaseUnlock(p_vol);
 }
 
 
 /*
 *********************************************************************************************************
-*                                      FS_FAT_JournalClrAllReset()
-*
-* Description : Clear entire journal and reset current position.
-*
-* Argument(s) : p_vol   Pointer to volume.
+*********************************************************************************************************
+*                                         INTERNAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                     FS_FAT_JournalModuleInit()
 *
-*               p_buf   Pointer to temporary buffer.
+* Description : Initialize FAT Journal module.
 *
-*               p_err   Pointer to variable that will receive the return error code from this function :
+* Argument(s) : vol_cnt     Number of volumes in use.
 *
-*                           --------------RETURNED BY FS_FAT_JournalPosSet()-------------
-*                           See FS_FAT_JournalPosSet() for additional return error codes.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                           ----------------RETURNED BY FS_FAT_JournalClr()--------------
-*                           See FS_FAT_JournalClr() for additional return error codes.
+*                               FS_ERR_NONE         Module initialized.
+*                               FS_ERR_MEM_ALLOC    Memory could not be allocated.
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) Journal is cleared from first to last sector. This allows the journal to be
-*                   atomically invalidated since a single sector clear will remove the first enter
-*                   mark. If this mark is not present, journal will not be replayed (see
-*                   FS_FAT_JournalReplay() notes).
-*
+* Note(s)     : none.
 *********************************************************************************************************
 */
 
-void  FS_FAT_JournalClrAllReset (FS_VOL  *p_vol,
-                                 FS_BUF  *p_buf,
-                                 FS_ERR  *p_err)
+void  FS_FAT_JournalModuleInit (FS_QTY   vol_cnt,
+                                FS_ERR  *p_err)
 {
-    FS_FAT_DATA       *p_fat_data;
-    FS_FAT_FILE_DATA  *p_journal_data;
+    CPU_SIZE_T  octets_reqd;
+    LIB_ERR     pool_err;
 
 
-    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
-    p_journal_data =  p_fat_data->JournalDataPtr;
+                                                                /* ----------- CREATE JOURNAL FILE DATA POOL ---------- */
+    Mem_PoolCreate(&FS_FAT_JournalFileDataPool,
+                    DEF_NULL,
+                    0,
+                    vol_cnt,
+                    sizeof(FS_FAT_FILE_DATA),
+                    sizeof(CPU_ALIGN),
+                   &octets_reqd,
+                   &pool_err);
+    if (pool_err != LIB_MEM_ERR_NONE) {
+       *p_err = FS_ERR_MEM_ALLOC;
+        FS_TRACE_INFO(("FS_FAT_JournalModuleInit(): Could not alloc mem for journal file info pool: %d octets req'd.\r\n", octets_reqd));
+        return;
+    }
 
-                                                                /* Clr entire journal (See Note #1)                     */
-    FS_FAT_JournalClr(p_vol,
-                      p_buf,
-                      0u,
-                      p_journal_data->FileSize,
-                      p_err);
-    if (*p_err != FS_ERR_NONE) {
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)                /* ---------- CREATE JOURNAL STAGING BUF POOL --------- */
+    Mem_PoolCreate(&FS_FAT_JournalStageBufPool,
+                    DEF_NULL,
+                    0,
+                    vol_cnt,
+                    FS_MaxSecSizeGet(),
+                    sizeof(CPU_ALIGN),
+                   &octets_reqd,
+                   &pool_err);
+    if (pool_err != LIB_MEM_ERR_NONE) {
+       *p_err = FS_ERR_MEM_ALLOC;
+        FS_TRACE_INFO(("FS_FAT_JournalModuleInit(): Could not alloc mem for journal staging buf pool: %d octets req'd.\r\n", octets_reqd));
         return;
     }
+#endif
 
-                                                                /* Reset current position.                              */
-    FS_FAT_JournalPosSet(p_vol,
-                         p_buf,
-                         0u,
-                         p_err);
+   *p_err = FS_ERR_NONE;
 }
 
 
 /*
 *********************************************************************************************************
-*                                        FS_FAT_JournalClrReset()
-*
-* Description : Clear journal up to current position and reset current position.
-*
-* Argument(s) : p_vol   Pointer to volume.
+*                                        FS_FAT_JournalInit()
 *
-*               p_buf   Pointer to temporary buffer.
+* Description : Initialize journal.
 *
-*               p_err   Pointer to variable that will receive the return error code from this function :
+* Argument(s) : p_vol       Pointer to volume.
 *
-*                           --------------RETURNED BY FS_FAT_JournalPosSet()-------------
-*                           See FS_FAT_JournalPosSet() for additional return error codes.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                           ----------------RETURNED BY FS_FAT_JournalClr()--------------
-*                           See FS_FAT_JournalClr() for additional return error codes..
+*                               FS_ERR_NONE          Journal initialized.
+*                               FS_ERR_POOL_EMPTY    File info not available.
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) Journal is cleared from first to last sector. This allows the journal to be
-*                   atomically invalidated since a single sector clear will remove the first enter
-*                   mark. If this mark is not present, journal will not be replayed (see
-*                   FS_FAT_JournalReplay() notes).
-*
+* Note(s)     : (1) The file system lock 'FS_OS_LOCK_ID_VOL' MUST be held to get the journal file data
+*                   from the journal file data pool & the journal staging buffer from the journal staging
+*                   buffer pool.
 *********************************************************************************************************
 */
 
-void  FS_FAT_JournalClrReset(FS_VOL  *p_vol,
-                             FS_BUF  *p_buf,
-                             FS_ERR  *p_err)
+void  FS_FAT_JournalInit (FS_VOL  *p_vol,
+                          FS_ERR  *p_err)
 {
-    FS_FAT_DATA       *p_fat_data;
     FS_FAT_FILE_DATA  *p_journal_data;
+    FS_FAT_DATA       *p_fat_data;
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+    CPU_INT08U        *p_stage_buf;
+#endif
+    LIB_ERR            pool_err;
 
 
-    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
-    p_journal_data =  p_fat_data->JournalDataPtr;
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
 
-                                                                /* Clr journal up to current position (See Note #1).    */
-    FS_FAT_JournalClr(p_vol,
-                      p_buf,
-                      0u,
-                      p_journal_data->FilePos,
-                      p_err);
+
+                                                                /* ----------------- INIT JOURNAL DATA ---------------- */
+    DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN   |
+                                          FS_FAT_JOURNAL_STATE_START  |
+                                          FS_FAT_JOURNAL_STATE_REPLAY |
+                                          FS_FAT_JOURNAL_STATE_TX_PEND);
+    p_fat_data->JournalDataPtr    = DEF_NULL;
+    p_fat_data->JournalCkptPos    = 0u;
+    Mem_Clr((void     *)&p_fat_data->JournalReplayInfo,
+            (CPU_SIZE_T) sizeof(FS_FAT_JOURNAL_REPLAY_INFO));
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+    p_fat_data->JournalTxNestCnt  = 0u;
+    p_fat_data->JournalTxInterval = 0u;
+    p_fat_data->JournalTxSize     = 0u;
+    p_fat_data->JournalTxTS       = 0u;
+#endif
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+    p_fat_data->JournalStageBufPtr = DEF_NULL;
+    p_fat_data->JournalStageSec    = 0u;
+    p_fat_data->JournalStageState  = FS_BUF_STATE_NONE;
+#endif
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+    p_fat_data->JournalDevPtr      = DEF_NULL;
+    p_fat_data->JournalDevStart    = 0u;
+#endif
+
+
+                                                                /* -------------- ALLOC JOURNAL FILE DATA ------------- */
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);                       /* Acquire FS lock (see Note #1).                       */
     if (*p_err != FS_ERR_NONE) {
         return;
     }
 
-                                                                /* Reset current position.                              */
-    FS_FAT_JournalPosSet(p_vol,
-                         p_buf,
-                         0u,
-                         p_err);
-}
+    p_journal_data = (FS_FAT_FILE_DATA *)Mem_PoolBlkGet(&FS_FAT_JournalFileDataPool,
+                                                         sizeof(FS_FAT_FILE_DATA),
+                                                        &pool_err);
+    (void)pool_err;                                            /* Err ignored. Ret val chk'd instead.                  */
 
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)                /* ------------- ALLOC JOURNAL STAGING BUF ------------ */
+    p_stage_buf = DEF_NULL;
+    if (p_journal_data != DEF_NULL) {
+        p_stage_buf = (CPU_INT08U *)Mem_PoolBlkGet(&FS_FAT_JournalStageBufPool,
+                                                    FS_MaxSecSizeGet(),
+                                                   &pool_err);
+        (void)pool_err;                                        /* Err ignored. Ret val chk'd instead.                  */
+
+        if (p_stage_buf == DEF_NULL) {                          /* If no staging buf, free journal file data.           */
+            Mem_PoolBlkFree(        &FS_FAT_JournalFileDataPool,
+                            (void *) p_journal_data,
+                                    &pool_err);
+            p_journal_data = DEF_NULL;
+        }
+    }
+#endif
 
-/*
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
+
+    if (p_journal_data == DEF_NULL) {
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    p_fat_data->JournalDataPtr     = p_journal_data;
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+    p_fat_data->JournalStageBufPtr = p_stage_buf;
+#endif
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_JournalExit()
+*
+* Description : Free journal file data memory.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE    Journal exited.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The file system lock 'FS_OS_LOCK_ID_VOL' MUST be held to free the journal file
+*                   data back to the journal file data pool OR to free the journal buf back to the
+*                   journal buf pool.
+*
+*               (2) Each top level operation writes the sectors it modifies before the journal is closed.
+*                   Logs remaining in the staging buffer protect no pending write & are discarded.
+*
+*               (3) The journal device reference is released before the file system lock is acquired,
+*                   since releasing it acquires the device module lock.
+*********************************************************************************************************
+*/
+
+void  FS_FAT_JournalExit (FS_VOL  *p_vol,
+                          FS_ERR  *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+    LIB_ERR            pool_err;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)                  /* ---------------- RELEASE JOURNAL DEV --------------- */
+    if (p_fat_data->JournalDevPtr != DEF_NULL) {                /* See Note #3.                                         */
+        FSDev_Release(p_fat_data->JournalDevPtr);
+        p_fat_data->JournalDevPtr = DEF_NULL;
+    }
+#endif
+
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);                       /* Acquire FS lock (see Note #1).                       */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)                /* ------------- FREE JOURNAL STAGING BUF ------------- */
+    if (p_fat_data->JournalStageBufPtr != DEF_NULL) {           /* Staged logs no longer needed (see Note #2).          */
+        Mem_PoolBlkFree(        &FS_FAT_JournalStageBufPool,
+                        (void *) p_fat_data->JournalStageBufPtr,
+                                &pool_err);
+        if (pool_err != LIB_MEM_ERR_NONE) {
+           *p_err = FS_ERR_MEM_ALLOC;
+        }
+        p_fat_data->JournalStageBufPtr = DEF_NULL;
+        p_fat_data->JournalStageState  = FS_BUF_STATE_NONE;
+    }
+#endif
+
+                                                                /* -------------- FREE JOURNAL FILE DATA -------------- */
+    p_journal_data =  p_fat_data->JournalDataPtr;               /* Free journal file data.                              */
+    if (p_journal_data != DEF_NULL) {
+        Mem_PoolBlkFree(        &FS_FAT_JournalFileDataPool,
+                        (void *) p_journal_data,
+                                &pool_err);
+        if (pool_err != LIB_MEM_ERR_NONE) {
+           *p_err = FS_ERR_MEM_ALLOC;
+        }
+    } else {
+       *p_err = FS_ERR_VOL_JOURNAL_NOT_STARTED;
+        FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
+        return;
+    }
+
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_JournalClrReset()
+*
+* Description : Checkpoint the journal, committing the logs appended since the last checkpoint.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_buf   Pointer to temporary buffer.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE    Journal checkpointed, or nothing to checkpoint.
+*
+*                           --------------RETURNED BY FS_FAT_JournalCkptWr()-------------
+*                           See FS_FAT_JournalCkptWr() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The journal is a circular log.  A top level operation is committed by appending a
+*                   checkpoint log after its own logs, rather than by clearing the journal.  Logs preceding
+*                   the last checkpoint are never replayed (see 'FS_FAT_JournalReplay()  Note #1').
+*
+*               (2) While a journal transaction is open, the checkpoint is deferred & the logs of the next
+*                   top level operation are appended to the journal (see 'FS_FAT_JournalTxBegin()
+*                   Note #1').
+*********************************************************************************************************
+*/
+
+void  FS_FAT_JournalClrReset(FS_VOL  *p_vol,
+                             FS_BUF  *p_buf,
+                             FS_ERR  *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+    CPU_BOOLEAN        defer;
+#endif
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
+
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_NO) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+    if (p_journal_data->FilePos == p_fat_data->JournalCkptPos) {
+       *p_err = FS_ERR_NONE;                                    /* No log since last ckpt.                              */
+        return;
+    }
+
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)                   /* Defer ckpt if tx open (see Note #2).                 */
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START) == DEF_YES) {
+        defer = FS_FAT_JournalTxDefer(p_vol);
+        if (defer == DEF_YES) {
+            DEF_BIT_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_TX_PEND);
+           *p_err = FS_ERR_NONE;
+            return;
+        }
+    }
+#endif
+
+    FS_FAT_JournalCkptWr(p_vol, p_buf, p_err);                  /* Wr ckpt (see Note #1).                               */
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+    if (*p_err == FS_ERR_NONE) {
+        DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_TX_PEND);
+    }
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_JournalTxFlush()
+*
+* Description : Commit operations pending in a journal transaction.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE    Pending operations committed.
+*
+*                           -------------RETURNED BY FS_FAT_JournalCkptFlush()-----------
+*                           See FS_FAT_JournalCkptFlush() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The volume lock MUST be held by the caller.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+void  FS_FAT_JournalTxFlush (FS_VOL  *p_vol,
+                             FS_ERR  *p_err)
+{
+    FS_FAT_DATA  *p_fat_data;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_TX_PEND) == DEF_NO) {
+       *p_err = FS_ERR_NONE;                                    /* No pending op.                                       */
+        return;
+    }
+
+    FS_FAT_JournalCkptFlush(p_vol, p_err);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_JournalCkptDue()
+*
+* Description : Check if the logs appended since the last checkpoint use half of the journal.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+* Return(s)   : DEF_YES, if the journal should be checkpointed.
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) Operations whose checkpoint is deferred (see 'fs_fat_file.c
+*                   FS_FAT_EntryCommitIntervalSet()  Note #3a') are committed once half of the journal is
+*                   used, so that the logs of the next top level operation always fit in the journal (see
+*                   also 'FS_FAT_JournalTxDefer()  Note #1').
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FS_FAT_JournalCkptDue (FS_VOL  *p_vol)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
+
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_NO) {
+        return (DEF_NO);
+    }
+
+    if ((p_journal_data->FilePos - p_fat_data->JournalCkptPos) >= (FS_FAT_JOURNAL_FILE_LEN / 2u)) {
+        return (DEF_YES);                                       /* See Note #1.                                         */
+    }
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FS_FAT_JournalStageFlush()
+*
+* Description : Write the journal sector held in the staging buffer, if modified.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE    Staged journal sector written, or none to write.
+*
+*                           -----------RETURNED BY FS_FAT_JournalStageRdWr()----------
+*                           See FS_FAT_JournalStageRdWr() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Called before every sector write to the volume (see 'fs_vol.c  FSVol_WrLockedEx()'), so
+*                   that journal logs always reach the device before the FAT & directory sectors they
+*                   protect.  The device lock MUST be held by the caller.
+*
+*               (2) The staging buffer is marked clean BEFORE the journal sector is written, since that
+*                   write calls this function again.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+void  FS_FAT_JournalStageFlush (FS_VOL  *p_vol,
+                                FS_ERR  *p_err)
+{
+    FS_FAT_DATA  *p_fat_data;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    if (p_fat_data == DEF_NULL) {                               /* Vol not open.                                        */
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    if (p_fat_data->JournalStageState != FS_BUF_STATE_DIRTY) {
+       *p_err = FS_ERR_NONE;                                    /* Nothing to wr.                                       */
+        return;
+    }
+
+    p_fat_data->JournalStageState = FS_BUF_STATE_USED;          /* Mark clean (see Note #2).                            */
+    FS_FAT_JournalStageRdWr(p_vol,                              /* Wr journal sec.                                      */
+                            p_fat_data->JournalStageSec,
+                            DEF_YES,
+                            p_err);
+    if (*p_err != FS_ERR_NONE) {
+        p_fat_data->JournalStageState = FS_BUF_STATE_DIRTY;
+    }
+}
+#endif
+
+
+/*
 *********************************************************************************************************
 *                                 FS_FAT_JournalEnterClusChainAlloc()
 *
@@ -1152,6 +1877,9 @@ void  FS_FAT_JournalEnterClusChainAlloc (FS_VOL           *p_vol,
 *                               ------------RETURNED BY FS_FAT_ClusChainFollow()--------------
 *                               See FS_FAT_ClusChainFollow() for additional return error codes.
 *
+*                               ----------RETURNED BY FS_FAT_JournalClusRangeGet()------------
+*                               See FS_FAT_JournalClusRangeGet() for additional return error codes.
+*
 *                               -----------------RETURNED BY FSBuf_Flush()--------------------
 *                               See FSBuf_Flush() for additional return error codes.
 *
@@ -1163,6 +1891,18 @@ void  FS_FAT_JournalEnterClusChainAlloc (FS_VOL           *p_vol,
 * Note(s)     : (1) A second buffer is used to prevent a single buffer from continuously switching between
 *                   journal sector(s) and cluster chain sector(s). If no second buffer is available, a
 *                   significant performance hit can be expected.
+*
+*               (2) The buffer may hold a modified FAT sector, which the second buffer would not see.  It
+*                   is written before the cluster chain is read through the second buffer.
+*
+*               (3) The free space left in the journal is bounded by the sector holding the last checkpoint
+*                   (see 'FS_FAT_JournalWr()  Note #4') & excludes the header of each sector to be written.
+*
+*               (4) A cluster chain made of at most FS_FAT_JOURNAL_MAX_DEL_RANGE_NBR ranges of contiguous
+*                   clusters is logged as a cluster range deletion log listing these ranges, so that the
+*                   deletion can be completed upon replay without following the chain (see
+*                   'FS_FAT_JournalReplayClusRangeDel()').  Otherwise, markers spread along the chain are
+*                   logged.
 *********************************************************************************************************
 */
 
@@ -1181,10 +1921,13 @@ void  FS_FAT_JournalEnterClusChainDel (FS_VOL           *p_vol,
     CPU_INT08U         marker_size;
     FS_SEC_SIZE        cur_sec_free_size;
     FS_SEC_SIZE        marker_log_size;
-    FS_SEC_SIZE        journal_free_size;
+    FS_FAT_FILE_SIZE   journal_free_size;
+    FS_FAT_FILE_SIZE   ckpt_sec_pos;
     FS_FAT_CLUS_NBR    cur_clus;
     FS_FAT_CLUS_NBR    next_clus;
-    CPU_INT08U         log[FS_FAT_JOURNAL_LOG_CLUS_CHAIN_DEL_HEADER_SIZE];
+    CPU_INT16U         nbr_range;
+    CPU_SIZE_T         log_size;
+    CPU_INT08U         log[FS_FAT_JOURNAL_LOG_CLUS_RANGE_DEL_MAX_SIZE];
 #if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
     CPU_INT32U         nbr_marker_chk;
 #endif
@@ -1205,12 +1948,74 @@ void  FS_FAT_JournalEnterClusChainDel (FS_VOL           *p_vol,
     }
 
 
+                                                                /* -------------------- GET 2ND BUF ------------------- */
+    FSBuf_Flush(p_buf, p_err);                                  /* Wr modified FAT sec, if any (see Note #2).           */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+                                                                /* Get 2nd buf if possible (see Note #1).               */
+    p_buf2 = FSBuf_Get(p_vol);
+    if (p_buf2 == DEF_NULL) {
+         FS_TRACE_DBG(("FS_FAT_JournalEnterClusChainDel(): Unable to allocate second buffer. Clus chain deletion log will be written with a performance hit.\r\n"));
+         p_buf2 = p_buf;
+    }
+
+
+                                                                /* ------- LOG CLUS RANGES, IF ANY (see Note #4) ------ */
+    nbr_range = FS_FAT_JournalClusRangeGet(p_vol,
+                                           p_buf2,
+                                           start_clus,
+                                           nbr_clus,
+                                          &log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_RANGE_START_OFFSET],
+                                           p_err);
+    if (*p_err != FS_ERR_NONE) {
+        if (p_buf2 != p_buf) {
+            FSBuf_Free(p_buf2);
+        }
+        return;
+    }
+
+    if (nbr_range != 0u) {                                      /* If chain fits in a few ranges, wr range log.         */
+        FS_TRACE_LOG(("FS_FAT_JournalEnterClusChainDel(): Wr'ing log (enter) for 0x%04X.\r\n", FS_FAT_JOURNAL_SIG_CLUS_RANGE_DEL));
+
+        log_size = FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_RANGE_START_OFFSET
+                 + ((CPU_SIZE_T)nbr_range * FS_FAT_JOURNAL_LOG_CLUS_RANGE_SIZE);
+        MEM_VAL_SET_INT16U_LITTLE((void *)&log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_ENTER_MARK_OFFSET], FS_FAT_JOURNAL_MARK_ENTER);
+        MEM_VAL_SET_INT16U_LITTLE((void *)&log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_SIG_OFFSET]       , FS_FAT_JOURNAL_SIG_CLUS_RANGE_DEL);
+        MEM_VAL_SET_INT32U_LITTLE((void *)&log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_START_CLUS_OFFSET], start_clus);
+        MEM_VAL_SET_INT08U_LITTLE((void *)&log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_DEL_FIRST_OFFSET] , del_first);
+        MEM_VAL_SET_INT16U_LITTLE((void *)&log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_NBR_RANGE_OFFSET] , nbr_range);
+        MEM_VAL_SET_INT16U_LITTLE((void *)&log[log_size]                                          , FS_FAT_JOURNAL_MARK_ENTER_END);
+
+        FS_FAT_JournalWr(p_vol,
+                         p_buf,
+                        &log[0],
+                         log_size + FS_FAT_JOURNAL_LOG_MARK_SIZE,
+                         p_err);
+
+        if (p_buf2 != p_buf) {
+            FSBuf_Free(p_buf2);
+        }
+        return;
+    }
+
+
                                                                 /* - COMPUTE MARKER STEP SIZE, MARKER CNT & LOG SIZE -- */
                                                                 /* Find free space size in cur sec and journal.         */
-    cur_sec_free_size = p_fat_data->SecSize - p_journal_data->FileCurSecPos;
-    journal_free_size = p_journal_data->FileSize - p_journal_data->FilePos;
+    if (p_journal_data->FileCurSecPos < FS_FAT_JOURNAL_SEC_HDR_SIZE) {
+        cur_sec_free_size = p_fat_data->SecSize - FS_FAT_JOURNAL_SEC_HDR_SIZE;
+    } else {
+        cur_sec_free_size = p_fat_data->SecSize - p_journal_data->FileCurSecPos;
+    }
+                                                                /* Free space ends at ckpt sec (see Note #3).           */
+    ckpt_sec_pos       =  p_fat_data->JournalCkptPos - 1u;
+    ckpt_sec_pos      -=  ckpt_sec_pos & (p_fat_data->SecSize - 1u);
+    journal_free_size  =  FS_FAT_JOURNAL_FILE_LEN - FS_FAT_JOURNAL_LOG_CKPT_SIZE - FS_FAT_JOURNAL_SEC_HDR_SIZE
+                       - (p_journal_data->FilePos - ckpt_sec_pos);
+    journal_free_size -=  FS_FAT_JOURNAL_SEC_HDR_SIZE
+                       * (FS_UTIL_DIV_PWR2(journal_free_size, p_fat_data->SecSizeLog2) + 1u);
     if (cur_sec_free_size <= (FS_FAT_JOURNAL_LOG_CLUS_CHAIN_DEL_HEADER_SIZE + FS_FAT_JOURNAL_LOG_MARK_SIZE)) {
-        marker_log_size = p_fat_data->SecSize + cur_sec_free_size       -
+        marker_log_size = p_fat_data->SecSize + cur_sec_free_size       - FS_FAT_JOURNAL_SEC_HDR_SIZE -
                          (FS_FAT_JOURNAL_LOG_CLUS_CHAIN_DEL_HEADER_SIZE +
                           FS_FAT_JOURNAL_LOG_MARK_SIZE);
     } else {
@@ -1222,7 +2027,7 @@ void  FS_FAT_JournalEnterClusChainDel (FS_VOL           *p_vol,
         marker_size = (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT32) ? 4u : 2u;
         marker_step = (((nbr_clus * marker_size) - 1u) / marker_log_size) + 1u;
                                                                 /* Log size increased until marker step is apporpriate. */
-        marker_log_size += p_fat_data->SecSize;
+        marker_log_size += p_fat_data->SecSize - FS_FAT_JOURNAL_SEC_HDR_SIZE;
     } while ((marker_step > FS_FAT_JOURNAL_MAX_DEL_MARKER_STEP_SIZE) &&
              (marker_log_size <= journal_free_size - (FS_FAT_JOURNAL_LOG_CLUS_CHAIN_DEL_HEADER_SIZE +
                                                       FS_FAT_JOURNAL_LOG_MARK_SIZE)));
@@ -1250,13 +2055,10 @@ void  FS_FAT_JournalEnterClusChainDel (FS_VOL           *p_vol,
                      FS_FAT_JOURNAL_LOG_CLUS_CHAIN_DEL_HEADER_SIZE,
                      p_err);
     if (*p_err != FS_ERR_NONE) {
-        return;
-    }
-                                                                /* Get 2nd buf if possible (see Note #1).               */
-    p_buf2 = FSBuf_Get(p_vol);
-    if (p_buf2 == DEF_NULL) {
-         FS_TRACE_DBG(("FS_FAT_JournalEnterClusChainDel(): Unable to allocate second buffer. Clus chain deletion log will be written with a performance hit.\r\n"));
-         p_buf2 = p_buf;
+        if (p_buf2 != p_buf) {
+            FSBuf_Free(p_buf2);
+        }
+        return;
     }
 
 #if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
@@ -1320,6 +2122,9 @@ void  FS_FAT_JournalEnterClusChainDel (FS_VOL           *p_vol,
         FS_TRACE_DBG(("FS_FAT_JournalEnterClusChainDel(): marker number mismatch:\r\n"));
         FS_TRACE_DBG(("FS_FAT_JournalEnterClusChainDel(): %d markers expected, %d markers logged.\r\n", nbr_marker, nbr_marker_chk));
        *p_err = FS_ERR_VOL_JOURNAL_MARKER_NBR_MISMATCH;
+        if (p_buf2 != p_buf) {
+            FSBuf_Free(p_buf2);
+        }
         return;
     }
 #endif
@@ -1453,6 +2258,10 @@ void  FS_FAT_JournalEnterEntryCreate (FS_VOL          *p_vol,
 *
 *               (2) The sector number gotten or allocated from the FAT should be valid. These checks are
 *                   effectively redundant.
+*
+*               (3) When the journal staging buffer is used, the journal no longer goes through the buffer
+*                   & the buffer may still hold a modified directory sector.  It is written before the
+*                   directory entries are read through the second buffer.
 *********************************************************************************************************
 */
 
@@ -1505,6 +2314,13 @@ void  FS_FAT_JournalEnterEntryUpdate (FS_VOL          *p_vol,
         return;
     }
 
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+    FSBuf_Flush(p_buf, p_err);                                  /* Wr modified dir sec, if any (see Note #3).           */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+#endif
+
 
                                                                 /* Get 2nd buf if possible (see Note #1).               */
     p_buf2 = FSBuf_Get(p_vol);
@@ -1775,6 +2591,15 @@ static  void  FS_FAT_JournalFileCreate (FS_VOL  *p_vol,
     }
     FSBuf_Flush(p_buf, p_err);
     FSBuf_Free(p_buf);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+                                                                /* ----------------- INIT JOURNAL POS ----------------- */
+    p_journal_data->FilePos       = 0u;
+    p_journal_data->FileCurSec    = FS_FAT_CLUS_TO_SEC(p_fat_data, p_journal_data->FileFirstClus);
+    p_journal_data->FileCurSecPos = 0u;
+    p_fat_data->JournalCkptPos    = 0u;
 }
 
 
@@ -1810,12 +2635,12 @@ static  void  FS_FAT_JournalFileCreate (FS_VOL  *p_vol,
 *********************************************************************************************************
 */
 
-static  void  FS_FAT_JournalPeek (FS_VOL      *p_vol,
-                                  FS_BUF      *p_buf,
-                                  void        *p_log,
-                                  CPU_SIZE_T   pos,
-                                  CPU_SIZE_T   len,
-                                  FS_ERR      *p_err)
+static  void  FS_FAT_JournalPeek (FS_VOL            *p_vol,
+                                  FS_BUF            *p_buf,
+                                  void              *p_log,
+                                  FS_FAT_FILE_SIZE   pos,
+                                  CPU_SIZE_T         len,
+                                  FS_ERR            *p_err)
 {
     FS_FAT_DATA       *p_fat_data;
     FS_FAT_FILE_DATA  *p_journal_data;
@@ -1869,472 +2694,1287 @@ static  void  FS_FAT_JournalPeek (FS_VOL      *p_vol,
 *
 * Argument(s) : p_vol   Pointer to volume.
 *
-*               pos     Journal file position to set.
+*               p_buf   Pointer to temporary buffer.
+*
+*               pos     Journal position to set.
 *
 *               p_err   Pointer to variable that will receive the return error code from this function :
 *
-*                           FS_ERR_NONE           Position set.
-*                           FS_ERR_INVALID_ARG    Position greater than file size.
+*                           FS_ERR_NONE    Position set.
 *
+*                           -----------RETURNED BY FS_FAT_JournalSecNextGet()-----------
+*                           See FS_FAT_JournalSecNextGet() for additional return error codes.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) Journal positions increase monotonically, wrapping around the journal file.  The file
+*                   position corresponding to a journal position is the journal position modulo the journal
+*                   file length.
 *********************************************************************************************************
 */
 
-static  void  FS_FAT_JournalPosSet (FS_VOL      *p_vol,
-                                    FS_BUF      *p_buf,
-                                    CPU_SIZE_T   pos,
-                                    FS_ERR      *p_err)
+static  void  FS_FAT_JournalPosSet (FS_VOL            *p_vol,
+                                    FS_BUF            *p_buf,
+                                    FS_FAT_FILE_SIZE   pos,
+                                    FS_ERR            *p_err)
 {
     FS_FAT_DATA       *p_fat_data;
     FS_FAT_FILE_DATA  *p_journal_data;
     FS_FAT_SEC_NBR     cur_sec;
-    FS_FAT_SEC_NBR     cur_sec_cnt;
-    FS_FAT_SEC_NBR     sec_cnt;
+    FS_FAT_SEC_NBR     cur_sec_ix;
     FS_FAT_SEC_NBR     sec_ix;
+    FS_FAT_SEC_NBR     ix;
 
 
-#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)                  /* --------------------- CHK ARGS --------------------- */
-    if (pos > FS_FAT_JOURNAL_FILE_LEN) {
-       *p_err = FS_ERR_INVALID_ARG;
-        return;
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
+
+                                                                /* ------------------- FIND SEC NBR ------------------- */
+                                                                /* See Note #1.                                         */
+    sec_ix     = FS_UTIL_DIV_PWR2(pos                     & (FS_FAT_JOURNAL_FILE_LEN - 1u), p_fat_data->SecSizeLog2);
+    cur_sec_ix = FS_UTIL_DIV_PWR2(p_journal_data->FilePos & (FS_FAT_JOURNAL_FILE_LEN - 1u), p_fat_data->SecSizeLog2);
+
+    if (sec_ix != cur_sec_ix) {                                 /* If new pos is not in cur sec ...                     */
+        cur_sec = FS_FAT_JournalSecFirstGet(p_fat_data);
+        for (ix = 0u; ix < sec_ix; ix++) {                      /* ... find new sec nbr ...                             */
+            cur_sec = FS_FAT_JournalSecNextGet(p_vol,
+                                               p_buf,
+                                               cur_sec,
+                                              (FS_FAT_FILE_SIZE)(ix + 1u) << p_fat_data->SecSizeLog2,
+                                               p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+        }
+    } else {
+        cur_sec = p_journal_data->FileCurSec;                   /* ... else do not change sec nbr.                      */
+    }
+
+                                                                /* --------------------- SET POS ---------------------- */
+    p_journal_data->FilePos       =  pos;
+    p_journal_data->FileCurSec    =  cur_sec;
+    p_journal_data->FileCurSecPos = (pos & (p_fat_data->SecSize - 1u));
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_JournalPosAdv()
+*
+* Description : Compute the journal position following a log.
+*
+* Argument(s) : p_fat_data  Pointer to FAT data.
+*
+*               pos         Journal position at which the log starts.
+*
+*               len         Size of the log in octets.
+*
+* Return(s)   : Journal position following the log.
+*
+* Note(s)     : (1) Each journal sector starts with a sector header, which logs skip (see
+*                   'FS_FAT_JournalWr()  Note #1').
+*********************************************************************************************************
+*/
+
+static  FS_FAT_FILE_SIZE  FS_FAT_JournalPosAdv (FS_FAT_DATA       *p_fat_data,
+                                                FS_FAT_FILE_SIZE   pos,
+                                                CPU_SIZE_T         len)
+{
+    FS_SEC_SIZE  sec_pos;
+    CPU_SIZE_T   size;
+
+
+    sec_pos = (FS_SEC_SIZE)(pos & (p_fat_data->SecSize - 1u));
+    while (len != 0u) {
+        if (sec_pos < FS_FAT_JOURNAL_SEC_HDR_SIZE) {            /* Skip sec header (see Note #1).                       */
+            pos     += FS_FAT_JOURNAL_SEC_HDR_SIZE - sec_pos;
+            sec_pos  = FS_FAT_JOURNAL_SEC_HDR_SIZE;
+        }
+        size     =  DEF_MIN((CPU_SIZE_T)(p_fat_data->SecSize - sec_pos), len);
+        pos     += (FS_FAT_FILE_SIZE)size;
+        len     -=  size;
+        sec_pos  = (FS_SEC_SIZE)((sec_pos + size) & (p_fat_data->SecSize - 1u));
+    }
+
+    return (pos);
+}
+
+/*
+*********************************************************************************************************
+*                                     FS_FAT_JournalSecFirstGet()
+*
+* Description : Get the first journal sector.
+*
+* Argument(s) : p_fat_data  Pointer to FAT data.
+*
+* Return(s)   : First journal sector, either on the volume or on the journal device.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  FS_FAT_SEC_NBR  FS_FAT_JournalSecFirstGet (FS_FAT_DATA  *p_fat_data)
+{
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+    if (p_fat_data->JournalDevPtr != DEF_NULL) {                /* If journal on other dev ...                          */
+        return ((FS_FAT_SEC_NBR)p_fat_data->JournalDevStart);   /* ... rtn first journal dev sec.                       */
+    }
+#endif
+
+    return (FS_FAT_CLUS_TO_SEC(p_fat_data, p_fat_data->JournalDataPtr->FileFirstClus));
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FS_FAT_JournalSecNextGet()
+*
+* Description : Get the journal sector following a journal sector.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_buf   Pointer to temporary buffer.
+*
+*               sec     Journal sector.
+*
+*               pos     Journal position at the start of the next sector.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE                        Next sector found.
+*                           FS_ERR_VOL_JOURNAL_FILE_INVALID    Journal file invalid.
+*
+* Return(s)   : Next journal sector.
+*
+* Note(s)     : (1) The journal is circular : the first journal file sector follows the last one.
+*
+*               (2) A journal placed on another device occupies consecutive sectors of that device (see
+*                   'FS_FAT_JournalOpenDev()').
+*********************************************************************************************************
+*/
+
+static  FS_FAT_SEC_NBR  FS_FAT_JournalSecNextGet (FS_VOL            *p_vol,
+                                                  FS_BUF            *p_buf,
+                                                  FS_FAT_SEC_NBR     sec,
+                                                  FS_FAT_FILE_SIZE   pos,
+                                                  FS_ERR            *p_err)
+{
+    FS_FAT_DATA     *p_fat_data;
+    FS_FAT_SEC_NBR   sec_next;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    if ((pos & (FS_FAT_JOURNAL_FILE_LEN - 1u)) == 0u) {         /* If journal file end reached, wrap (see Note #1).     */
+       *p_err = FS_ERR_NONE;
+        return (FS_FAT_JournalSecFirstGet(p_fat_data));
+    }
+
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+    if (p_fat_data->JournalDevPtr != DEF_NULL) {                /* Journal dev secs are contiguous (see Note #2).       */
+       *p_err = FS_ERR_NONE;
+        return (sec + 1u);
+    }
+#endif
+
+    sec_next = FS_FAT_SecNextGet(p_vol,
+                                 p_buf,
+                                 sec,
+                                 p_err);
+    if (*p_err != FS_ERR_NONE) {                                /* No next sec in file.                                 */
+       *p_err = FS_ERR_VOL_JOURNAL_FILE_INVALID;
+    }
+
+    return (sec_next);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_JournalSecGet()
+*
+* Description : Get the data of a journal sector.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_buf   Pointer to temporary buffer.
+*
+*               sec     Journal sector.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE    Journal sector read.
+*
+*                           ------------------RETURNED BY FSBuf_Set()-----------------
+*                           See FSBuf_Set() for additional return error codes.
+*
+*                           ------------RETURNED BY FS_FAT_JournalStageSet()----------
+*                           See FS_FAT_JournalStageSet() for additional return error codes.
+*
+* Return(s)   : Pointer to sector data, if NO error(s).
+*               Pointer to NULL,        otherwise.
+*
+* Note(s)     : (1) A journal sector held in the staging buffer may be newer than the one on the device
+*                   & is read from the staging buffer.
+*
+*               (2) Volume buffers only hold volume sectors.  The sectors of a journal placed on another
+*                   device are always read through the staging buffer.
+*
+*               (3) The returned data remains valid until 'p_buf' or the staging buffer is set to another
+*                   sector.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  *FS_FAT_JournalSecGet (FS_VOL          *p_vol,
+                                           FS_BUF          *p_buf,
+                                           FS_FAT_SEC_NBR   sec,
+                                           FS_ERR          *p_err)
+{
+#if ((FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED) || \
+     (FS_FAT_CFG_JOURNAL_DEV_EN   == DEF_ENABLED))
+    FS_FAT_DATA  *p_fat_data;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+#endif
+
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+    if ((p_fat_data->JournalStageState != FS_BUF_STATE_NONE) &&
+        (p_fat_data->JournalStageSec   == sec)) {               /* If sec is staged, rd staging buf (see Note #1).      */
+       *p_err = FS_ERR_NONE;
+        return (p_fat_data->JournalStageBufPtr);
+    }
+#endif
+
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+    if (p_fat_data->JournalDevPtr != DEF_NULL) {                /* If journal on other dev, rd through staging buf ...  */
+        FS_FAT_JournalStageSet(p_vol,                           /* ... (see Note #2).                                   */
+                               sec,
+                               DEF_YES,
+                               p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (DEF_NULL);
+        }
+        return (p_fat_data->JournalStageBufPtr);
     }
 #endif
 
-    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
-    p_journal_data =  p_fat_data->JournalDataPtr;
+    FSBuf_Set(p_buf,                                            /* Rd sec through buf.                                  */
+              sec,
+              FS_VOL_SEC_TYPE_FILE,
+              DEF_YES,
+              p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (DEF_NULL);
+    }
+
+    return ((CPU_INT08U *)p_buf->DataPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_JournalRd()
+*
+* Description : Read log from journal & increment file position.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_buf   Pointer to temporary buffer.
+*
+*               p_log   Pointer to buffer that will receive log data.
+*
+*               len     Size of data to be read in octets.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE             Log read from journal.
+*
+*                           -------------RETURNED BY FS_FAT_JournalSecGet()-----------
+*                           See FS_FAT_JournalSecGet() for additional return error codes.
+*
+*                           -----------RETURNED BY FS_FAT_JournalSecNextGet()---------
+*                           See FS_FAT_JournalSecNextGet() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FS_FAT_JournalWr()  Notes #1 & #3'.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_JournalRd (FS_VOL      *p_vol,
+                                FS_BUF      *p_buf,
+                                void        *p_log,
+                                CPU_SIZE_T   len,
+                                FS_ERR      *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+    FS_FAT_FILE_SIZE   pos;
+    CPU_SIZE_T         rd_size;
+    CPU_SIZE_T         rem_size;
+    FS_SEC_SIZE        cur_sec_pos;
+    FS_FAT_SEC_NBR     cur_sec;
+    CPU_INT08U        *p_src;
+    CPU_INT08U        *p_dest;
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
+
+    rem_size    = len;
+    p_dest      = (CPU_INT08U *)p_log;
+    pos         = p_journal_data->FilePos;
+    cur_sec     = p_journal_data->FileCurSec;
+    cur_sec_pos = p_journal_data->FileCurSecPos;
+   *p_err       = FS_ERR_NONE;
+    while (rem_size != 0u) {
+        if (cur_sec_pos < FS_FAT_JOURNAL_SEC_HDR_SIZE) {        /* Skip sec header (see Note #1).                       */
+            pos         += FS_FAT_JOURNAL_SEC_HDR_SIZE - cur_sec_pos;
+            cur_sec_pos  = FS_FAT_JOURNAL_SEC_HDR_SIZE;
+        }
+                                                                /* --------------------- READ SEC --------------------- */
+                                                                /* Compute next rd chunk size.                          */
+        rd_size = DEF_MIN((p_fat_data->SecSize - cur_sec_pos), rem_size);
+        p_src   = FS_FAT_JournalSecGet(p_vol,
+                                       p_buf,
+                                       cur_sec,
+                                       p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+
+                                                                /* ----------------- COPY TO DEST BUF ----------------- */
+        Mem_Copy((void *) p_dest,
+                 (void *)(p_src + cur_sec_pos),
+                          rd_size);
+
+                                                                /* ----------- UPDATE SEC POS AND REM SIZE ------------ */
+        pos        +=  rd_size;
+        cur_sec_pos = (cur_sec_pos + rd_size) & (p_fat_data->SecSize - 1u);
+        rem_size   -=  rd_size;
+        p_dest     +=  rd_size;
+
+
+                                                                /* ------------------- GET NEXT SEC ------------------- */
+        if (cur_sec_pos == 0u) {                                /* If we crossed sec boundary, find next sec.           */
+            cur_sec = FS_FAT_JournalSecNextGet(p_vol,
+                                               p_buf,
+                                               cur_sec,
+                                               pos,
+                                               p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+        }
+    }
+
+                                                                /* -------------------- UPDATE POS -------------------- */
+    p_journal_data->FilePos       = pos;
+    p_journal_data->FileCurSec    = cur_sec;
+    p_journal_data->FileCurSecPos = cur_sec_pos;
+}
+
+
+/*
+*********************************************************************************************************
+*                                    FS_FAT_JournalRd_INTxxU()
+*
+* Description : Read 16-/32-bit value from journal & increment file position.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_buf   Pointer to temporary buffer.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE     Journal read.
+*
+*                           ---------------RETURNED BY FS_FAT_JournalRd()-------------
+*                           See FS_FAT_JournalRd() for additional return error codes.
+*
+* Return(s)   : 16/32-bit value.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  FS_FAT_JournalRd_INT16U (FS_VOL  *p_vol,
+                                             FS_BUF  *p_buf,
+                                             FS_ERR  *p_err)
+{
+    CPU_INT16U  val;
+    CPU_INT08U  log[2u];
+
+
+    FS_FAT_JournalRd(p_vol,
+                     p_buf,
+                    &log[0],
+                     2u,
+                     p_err);
+
+    val = MEM_VAL_GET_INT16U_LITTLE(&log[0]);
+    return (val);
+}
+
+
+static  CPU_INT32U  FS_FAT_JournalRd_INT32U (FS_VOL  *p_vol,
+                                             FS_BUF  *p_buf,
+                                             FS_ERR  *p_err)
+{
+    CPU_INT32U  val;
+    CPU_INT08U  log[4u];
+
+
+    FS_FAT_JournalRd(p_vol,
+                     p_buf,
+                    &log[0],
+                     4u,
+                     p_err);
+
+    val = MEM_VAL_GET_INT32U_LITTLE(&log[0]);
+    return (val);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_JournalWr()
+*
+* Description : Write log to journal.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_buf   Pointer to temporary buffer.
+*
+*               p_log   Pointer to log buffer.
+*
+*               len     Length of log, in octets.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE                         Log written to journal.
+*                           FS_ERR_VOL_JOURNAL_FULL             Journal full.
+*                           FS_ERR_VOL_JOURNAL_FILE_INVALID     Journal file invalid.
+*
+*                           ------------------RETURNED BY FSBuf_Set()------------------
+*                           See FSBuf_Set() for additional return error codes.
+*
+*                           -----------RETURNED BY FS_FAT_JournalSecNextGet()----------
+*                           See FS_FAT_JournalSecNextGet() for additional return error codes.
+*
+*                           ---------------RETURNED BY FSBuf_MarkDirty()---------------
+*                           See FSBuf_MarkDirty() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Each journal sector starts with a sector header holding the journal position of the
+*                   sector start, which serves as the sector's sequence number.  When the journal wraps
+*                   onto a sector, the sector is re-initialized with a new header & cleared : the logs of
+*                   the previous pass are discarded without being read.
+*
+*               (2) When the journal staging buffer is used, the log is copied into the staging buffer &
+*                   the journal sector is written only when another sector is staged or just before any
+*                   other sector of the volume is written (see 'FS_FAT_JournalStageFlush()').  Logs of
+*                   several operations may thus share a single journal sector write.
+*
+*               (3) The current sector is advanced as soon as a sector is filled, so that 'FileCurSec'
+*                   always holds the sector containing 'FilePos'.
+*
+*               (4) Logs appended since the last checkpoint MUST NOT overwrite the sector holding that
+*                   checkpoint (i.e., the sector preceding the checkpoint position), otherwise replay could
+*                   not find it.  Room is always left for the checkpoint log that will commit them.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_JournalWr (FS_VOL      *p_vol,
+                                FS_BUF      *p_buf,
+                                void        *p_log,
+                                CPU_SIZE_T   len,
+                                FS_ERR      *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+    FS_FAT_FILE_SIZE   pos;
+    FS_FAT_FILE_SIZE   pos_end;
+    FS_FAT_FILE_SIZE   ckpt_sec_pos;
+    CPU_SIZE_T         wr_size;
+    CPU_SIZE_T         rem_size;
+    FS_SEC_SIZE        cur_sec_pos;
+    FS_FAT_SEC_NBR     cur_sec;
+    CPU_BOOLEAN        sec_new;
+    CPU_INT08U        *p_src;
+    CPU_INT08U        *p_dest;
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
+
+                                                                /* -------------- CHK IF WR OUT OF BOUNDS ------------- */
+    ckpt_sec_pos = (p_fat_data->JournalCkptPos - 1u) - ((p_fat_data->JournalCkptPos - 1u) & (p_fat_data->SecSize - 1u));
+    pos_end      = FS_FAT_JournalPosAdv(p_fat_data, p_journal_data->FilePos, len);
+    if ((pos_end - ckpt_sec_pos) > (FS_FAT_JOURNAL_FILE_LEN     -   /* See Note #4.                                 */
+                                    FS_FAT_JOURNAL_LOG_CKPT_SIZE -
+                                    FS_FAT_JOURNAL_SEC_HDR_SIZE)) {
+       *p_err = FS_ERR_VOL_JOURNAL_FULL;
+        return;
+    }
+
+
+    rem_size    = len;
+    p_src       = (CPU_INT08U *)p_log;
+    pos         = p_journal_data->FilePos;
+    cur_sec     = p_journal_data->FileCurSec;
+    cur_sec_pos = p_journal_data->FileCurSecPos;
+   *p_err       = FS_ERR_NONE;
+    while (rem_size != 0u) {
+        sec_new = (cur_sec_pos < FS_FAT_JOURNAL_SEC_HDR_SIZE) ? DEF_YES : DEF_NO;
+
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+        FS_FAT_JournalStageSet(p_vol,                           /* Set staging buf (see Note #2).                       */
+                               cur_sec,
+                              (sec_new == DEF_NO) ? DEF_YES : DEF_NO,
+                               p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+        p_dest = p_fat_data->JournalStageBufPtr;
+#else
+        FSBuf_Set(p_buf,                                        /* Set buf.                                             */
+                  cur_sec,
+                  FS_VOL_SEC_TYPE_FILE,
+                 (sec_new == DEF_NO) ? DEF_YES : DEF_NO,
+                  p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+        p_dest = (CPU_INT08U *)p_buf->DataPtr;
+#endif
+
+        if (sec_new == DEF_YES) {                               /* ------------ INIT SEC HEADER (see Note #1) --------- */
+            Mem_Clr((void *)p_dest, (CPU_SIZE_T)p_fat_data->SecSize);
+            MEM_VAL_SET_INT16U_LITTLE((void *)(p_dest + FS_FAT_JOURNAL_SEC_HDR_MARK_OFFSET), FS_FAT_JOURNAL_MARK_SEC);
+            MEM_VAL_SET_INT32U_LITTLE((void *)(p_dest + FS_FAT_JOURNAL_SEC_HDR_POS_OFFSET),  pos - cur_sec_pos);
+            pos         += FS_FAT_JOURNAL_SEC_HDR_SIZE - cur_sec_pos;
+            cur_sec_pos  = FS_FAT_JOURNAL_SEC_HDR_SIZE;
+        }
+
+                                                                /* ----------------- WR LOG TO JOURNAL ---------------- */
+        wr_size = DEF_MIN((p_fat_data->SecSize - cur_sec_pos), rem_size);
+        Mem_Copy((void *)(p_dest + cur_sec_pos),                /* Copy log into buf.                                   */
+                 (void *) p_src,
+                          wr_size);
+                                                                /* Udpate cur sec pos & rem size.                       */
+        pos        +=  wr_size;
+        cur_sec_pos = (cur_sec_pos + wr_size) & (p_fat_data->SecSize - 1u);
+        rem_size   -=  wr_size;
+        p_src      +=  wr_size;
+
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+        p_fat_data->JournalStageState = FS_BUF_STATE_DIRTY;     /* Mark staging buf as dirty.                           */
+#else
+        FSBuf_MarkDirty(p_buf, p_err);                          /* Mark buf as dirty.                                   */
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+#endif
+
+                                                                /* ------------------- GET NEXT SEC ------------------- */
+        if (cur_sec_pos == 0u) {                                /* If we crossed sec boundary (see Note #3) ...         */
+            cur_sec = FS_FAT_JournalSecNextGet(p_vol,           /* ... get next sec.                                    */
+                                               p_buf,
+                                               cur_sec,
+                                               pos,
+                                               p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+        }
+    }
+
+                                                                /* -------------------- UPDATE POS -------------------- */
+    p_journal_data->FilePos       = pos;
+    p_journal_data->FileCurSec    = cur_sec;
+    p_journal_data->FileCurSecPos = cur_sec_pos;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_JournalCkptWr()
+*
+* Description : Append a checkpoint log to the journal.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_buf   Pointer to temporary buffer.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE    Checkpoint written.
+*
+*                           -----------------RETURNED BY FS_FAT_JournalWr()-----------------
+*                           See FS_FAT_JournalWr() for additional return error codes.
+*
+*                           -------------RETURNED BY FS_FAT_JournalStageFlush()-------------
+*                           See FS_FAT_JournalStageFlush() for additional return error codes.
+*
+*                           --------------------RETURNED BY FSBuf_Flush()-------------------
+*                           See FSBuf_Flush() for additional return error codes.
+*
+*                           ----------------RETURNED BY FSVol_BarrierLocked()---------------
+*                           See FSVol_BarrierLocked() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The buffer may hold a sector modified by the operation being committed, which MUST be
+*                   written before the checkpoint.  Without the staging buffer, this is done when the
+*                   journal sector is set in the buffer.
+*
+*               (2) Room for the checkpoint log was left by the logs it commits (see 'FS_FAT_JournalWr()
+*                   Note #4').
+*
+*               (3) When the journal staging buffer is used, the checkpoint is written at once, so that
+*                   the operation is committed on return.  Otherwise, the caller flushes the buffer.
+*
+*               (4) In ordered data mode, file data written past the end of a file since the last checkpoint
+*                   MUST reach the device before the checkpoint committing the new file size, so that a
+*                   file never exposes stale sectors after a power loss.  A write barrier is issued rather
+*                   than a device sync, & only once per checkpoint, so that the data of all operations of a
+*                   journal transaction is ordered by a single barrier.
+*
+*               (5) The checkpoint commits the cluster allocations of files whose directory entry update is
+*                   pending on the volume commit list (see 'fs_fat_file.c  FS_FAT_EntryCommitIntervalSet()
+*                   Note #3').  Their entries are written first, so that no committed cluster chain is left
+*                   without an entry after a power loss.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_JournalCkptWr (FS_VOL  *p_vol,
+                                    FS_BUF  *p_buf,
+                                    FS_ERR  *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+    FS_FAT_FILE_SIZE   ckpt_pos;
+    CPU_INT08U         log_buf[FS_FAT_JOURNAL_LOG_CKPT_SIZE];
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
+
+#if (FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED)                 /* ------ WR PENDING DIR ENTRIES (see Note #5) ------ */
+    if (p_fat_data->CommitListPtr != DEF_NULL) {
+        FS_FAT_EntryCommitWr(p_vol, p_buf, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+    }
+#endif
+
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+    FSBuf_Flush(p_buf, p_err);                                  /* Wr sec modified by op (see Note #1).                 */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+#endif
+
+#if (FS_FAT_CFG_JOURNAL_ORDERED_EN == DEF_ENABLED)              /* -------------- ORDER DATA (see Note #4) ------------ */
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_DATA_PEND) == DEF_YES) {
+        FSBuf_Flush(p_buf, p_err);                              /* Wr sec modified by op (see Note #1).                 */
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+        FSVol_BarrierLocked(p_vol, p_err);                      /* Data reaches dev before ckpt.                        */
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+        DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_DATA_PEND);
+    }
+#endif
+
+                                                                /* --------------------- FORM LOG --------------------- */
+    MEM_VAL_SET_INT16U_LITTLE((void *)&log_buf[FS_FAT_JOURNAL_CKPT_LOG_ENTER_MARK_OFFSET],     FS_FAT_JOURNAL_MARK_ENTER);
+    MEM_VAL_SET_INT16U_LITTLE((void *)&log_buf[FS_FAT_JOURNAL_CKPT_LOG_SIG_OFFSET],            FS_FAT_JOURNAL_SIG_CKPT);
+    MEM_VAL_SET_INT16U_LITTLE((void *)&log_buf[FS_FAT_JOURNAL_CKPT_LOG_ENTER_END_MARK_OFFSET], FS_FAT_JOURNAL_MARK_ENTER_END);
+
+                                                                /* ----------------- WR LOG TO JOURNAL ---------------- */
+    ckpt_pos                   = p_fat_data->JournalCkptPos;
+    p_fat_data->JournalCkptPos = p_journal_data->FilePos;       /* See Note #2.                                         */
+    FS_FAT_JournalWr(p_vol,
+                     p_buf,
+                    &log_buf[0],
+                     FS_FAT_JOURNAL_LOG_CKPT_SIZE,
+                     p_err);
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+    if (*p_err == FS_ERR_NONE) {
+        FS_FAT_JournalStageFlush(p_vol, p_err);                 /* Wr ckpt (see Note #3).                               */
+    }
+#endif
+    if (*p_err != FS_ERR_NONE) {
+        p_fat_data->JournalCkptPos = ckpt_pos;
+        return;
+    }
+
+    p_fat_data->JournalCkptPos = p_journal_data->FilePos;
+    FS_TRACE_LOG(("FS_FAT_JournalCkptWr(): Journal checkpointed at position %d.\r\n", p_journal_data->FilePos));
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FS_FAT_JournalCkptFlush()
+*
+* Description : Checkpoint the journal, if any log was appended since the last checkpoint, & write the
+*               checkpoint to the device.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE               Journal checkpointed, or nothing to checkpoint.
+*                           FS_ERR_BUF_NONE_AVAIL     No buffer available.
+*
+*                           --------------RETURNED BY FS_FAT_JournalCkptWr()-------------
+*                           See FS_FAT_JournalCkptWr() for additional return error codes.
+*
+*                           -------------------RETURNED BY FSBuf_Flush()-----------------
+*                           See FSBuf_Flush() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The volume lock MUST be held by the caller.
+*
+*               (2) Unlike 'FS_FAT_JournalClrReset()', the checkpoint is never deferred.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_JournalCkptFlush (FS_VOL  *p_vol,
+                                       FS_ERR  *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+    FS_BUF            *p_buf;
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
+
+    if (p_journal_data->FilePos == p_fat_data->JournalCkptPos) {
+       *p_err = FS_ERR_NONE;                                    /* No log since last ckpt.                              */
+        return;
+    }
+
+    p_buf = FSBuf_Get(p_vol);                                   /* Get buf.                                             */
+    if (p_buf == DEF_NULL) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
+
+    FS_FAT_JournalCkptWr(p_vol, p_buf, p_err);                  /* Wr ckpt (see Note #2).                               */
+    if (*p_err != FS_ERR_NONE) {
+        FSBuf_Free(p_buf);
+        return;
+    }
+                                                                /* Flush & free buf.                                    */
+    FSBuf_Flush(p_buf, p_err);
+    FSBuf_Free(p_buf);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+    DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_TX_PEND);
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FS_FAT_JournalClusRangeGet()
+*
+* Description : Get the ranges of contiguous clusters making up a cluster chain.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+*               p_buf       Pointer to temporary buffer.
+*
+*               start_clus  First cluster of the chain.
+*
+*               nbr_clus    Number of clusters in the chain.
+*
+*               p_range     Pointer to buffer that will receive the cluster ranges.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE    Cluster chain followed.
+*
+*                               --------------RETURNED BY p_fat_data->FAT_TypeAPI_Ptr->ClusValRd()-------------
+*                               See p_fat_data->FAT_TypeAPI_Ptr->ClusValRd() for additional return error codes.
+*
+* Return(s)   : Number of cluster ranges, if the chain fits in FS_FAT_JOURNAL_MAX_DEL_RANGE_NBR ranges.
+*               0,                        otherwise.
+*
+* Note(s)     : (1) The chain is followed up to an end of cluster chain or an invalid cluster, like
+*                   'FS_FAT_ClusChainDel()' does.  The chain is not split into ranges if it holds more than
+*                   'nbr_clus' clusters.
+*
+*               (2) Each range is stored as its first cluster followed by its cluster count.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  FS_FAT_JournalClusRangeGet (FS_VOL           *p_vol,
+                                                FS_BUF           *p_buf,
+                                                FS_FAT_CLUS_NBR   start_clus,
+                                                FS_FAT_CLUS_NBR   nbr_clus,
+                                                CPU_INT08U       *p_range,
+                                                FS_ERR           *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   cur_clus;
+    FS_FAT_CLUS_NBR   next_clus;
+    FS_FAT_CLUS_NBR   range_first;
+    FS_FAT_CLUS_NBR   range_cnt;
+    FS_FAT_CLUS_NBR   clus_cnt;
+    CPU_INT16U        nbr_range;
+
+
+    p_fat_data  = (FS_FAT_DATA *)p_vol->DataPtr;
+    nbr_range   =  0u;
+    range_first =  start_clus;
+    range_cnt   =  1u;
+    cur_clus    =  start_clus;
+   *p_err       =  FS_ERR_NONE;
+
+                                                                /* ------------------ FOLLOW CHAIN -------------------- */
+    for (clus_cnt = 1u; clus_cnt <= nbr_clus; clus_cnt++) {
+        next_clus = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol,
+                                                           p_buf,
+                                                           cur_clus,
+                                                           p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (0u);
+        }
+
+        if (FS_FAT_IS_VALID_CLUS(p_fat_data, next_clus) == DEF_NO) {
+            break;                                              /* Chain end reached (see Note #1).                     */
+        }
 
-                                                                /* ------------------- FIND SEC NBR ------------------- */
-    sec_cnt     = FS_UTIL_DIV_PWR2(pos, p_fat_data->SecSizeLog2);
-    cur_sec_cnt = FS_UTIL_DIV_PWR2(p_journal_data->FilePos, p_fat_data->SecSizeLog2);
-    cur_sec     = FS_FAT_CLUS_TO_SEC(p_fat_data, p_journal_data->FileFirstClus);
-
-    if (sec_cnt != cur_sec_cnt) {                              /* If new pos is not in cur sec ...                      */
-        for (sec_ix = 0; sec_ix < sec_cnt; sec_ix++) {         /* ... find new sec nbr ...                              */
-            cur_sec = FS_FAT_SecNextGet(p_vol,
-                                        p_buf,
-                                        cur_sec,
-                                        p_err);
-            if (*p_err != FS_ERR_NONE) {
-                return;
+        if (next_clus == cur_clus + 1u) {                       /* If next clus is contiguous ...                       */
+            range_cnt++;                                        /* ... extend cur range ...                             */
+        } else {                                                /* ... else start new range.                            */
+            if (nbr_range == FS_FAT_JOURNAL_MAX_DEL_RANGE_NBR) {
+                return (0u);
             }
+            MEM_VAL_SET_INT32U_LITTLE((void *)&p_range[FS_FAT_JOURNAL_CLUS_RANGE_FIRST_CLUS_OFFSET], range_first);
+            MEM_VAL_SET_INT32U_LITTLE((void *)&p_range[FS_FAT_JOURNAL_CLUS_RANGE_CLUS_CNT_OFFSET],   range_cnt);
+            p_range     += FS_FAT_JOURNAL_LOG_CLUS_RANGE_SIZE;
+            nbr_range++;
+            range_first  = next_clus;
+            range_cnt    = 1u;
         }
-    } else {
-        cur_sec = p_journal_data->FileCurSec;                   /* ... else do not change sec nbr.                      */
+
+        cur_clus = next_clus;
     }
 
-                                                                /* --------------------- SET POS ---------------------- */
-    p_journal_data->FilePos       =  pos;
-    p_journal_data->FileCurSec    =  cur_sec;
-    p_journal_data->FileCurSecPos = (pos & (p_fat_data->SecSize - 1u));
+    if ((clus_cnt  > nbr_clus) ||                               /* If chain longer than expected (see Note #1) ...      */
+        (nbr_range == FS_FAT_JOURNAL_MAX_DEL_RANGE_NBR)) {      /* ... or no room for last range ...                    */
+        return (0u);                                            /* ... chain cannot be log'd as ranges.                 */
+    }
 
-   *p_err = FS_ERR_NONE;
+    MEM_VAL_SET_INT32U_LITTLE((void *)&p_range[FS_FAT_JOURNAL_CLUS_RANGE_FIRST_CLUS_OFFSET], range_first);
+    MEM_VAL_SET_INT32U_LITTLE((void *)&p_range[FS_FAT_JOURNAL_CLUS_RANGE_CLUS_CNT_OFFSET],   range_cnt);
+    nbr_range++;
+
+    return (nbr_range);
 }
 
+
 /*
 *********************************************************************************************************
-*                                        FS_FAT_JournalRd()
+*                                       FS_FAT_JournalReverseScan()
 *
-* Description : Read log from journal & increment file position.
+* Description : Scan journal backward, looking for given pattern.
 *
-* Argument(s) : p_vol   Pointer to volume.
+* Argument(s) : p_vol           Pointer to volume.
 *
-*               p_buf   Pointer to temporary buffer.
+*               p_buf           Pointer to temporary buffer.
 *
-*               p_log   Pointer to buffer that will receive log data.
+*               start_pos       Position to start scan at.
 *
-*               len     Size of data to be read in octets.
+*               end_pos         Position to end scan at.
 *
-*               p_err   Pointer to variable that will receive the return error code from this function :
+*               pattern         Pattern to look for.
+*
+*               pattern_size    Pattern size in octets.
 *
-*                           FS_ERR_JOURNAL_FULL     Journal full.
-*                           FS_ERR_NONE             Log written to journal.
+*               p_err           Pointer to variable that will receive the return error code from this function :
 *
-*                           ------------------RETURNED BY FSBuf_Set()-----------------
-*                           See FSBuf_Set() for additional return error codes.
+*                                   FS_ERR_NONE                          Pattern found.
+*                                   FS_ERR_VOL_JOURNAL_LOG_INCOMPLETE    Pattern not found.
 *
-*                           --------------RETURNED BY FS_FAT_SecNextGet()-------------
-*                           See FS_FAT_SecNextGet() for additional return error codes.
+*                                   -------------RETURNED BY FS_FAT_JournalPosSet()------------
+*                                   See FS_FAT_JournalPosSet() for additional return error codes.
 *
-* Return(s)   : none.
+*                                   -------------RETURNED BY FS_FAT_JournalSecGet()------------
+*                                   See FS_FAT_JournalSecGet() for additional return error codes.
 *
-* Note(s)     : none.
+* Return(s)   : Start position of first pattern occurence if match occurs. Zero if no match.
+*
+* Note(s)     : (1) Sector headers are skipped (see 'FS_FAT_JournalWr()  Note #1').
+*
+*               (2) Each journal sector is located & read once, upon entering it, then scanned in memory.
 *********************************************************************************************************
 */
 
-static  void  FS_FAT_JournalRd (FS_VOL      *p_vol,
-                                FS_BUF      *p_buf,
-                                void        *p_log,
-                                CPU_SIZE_T   len,
-                                FS_ERR      *p_err)
+static  FS_FAT_FILE_SIZE  FS_FAT_JournalReverseScan (FS_VOL            *p_vol,
+                                                     FS_BUF            *p_buf,
+                                                     FS_FAT_FILE_SIZE   start_pos,
+                                                     FS_FAT_FILE_SIZE   end_pos,
+                                                     CPU_INT08U        *p_pattern,
+                                                     CPU_SIZE_T         pattern_size,
+                                                     FS_ERR            *p_err)
 {
     FS_FAT_DATA       *p_fat_data;
     FS_FAT_FILE_DATA  *p_journal_data;
-    FS_FAT_FILE_SIZE   file_pos_end;
-    CPU_SIZE_T         rd_size;
-    CPU_SIZE_T         rem_size;
-    FS_SEC_SIZE        cur_sec_pos;
-    FS_FAT_SEC_NBR     cur_sec;
+    CPU_INT08U        *p_data;
+    CPU_INT08U        *p_pattern_pos;
+    CPU_INT08U        *p_pattern_start;
+    CPU_INT08U        *p_pattern_end;
+    FS_FAT_FILE_SIZE   cur_pos;
+    FS_FAT_FILE_SIZE   rem_cnt;
+    FS_SEC_SIZE        sec_pos;
 
 
     p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
     p_journal_data =  p_fat_data->JournalDataPtr;
 
-                                                                /* ----------------- CHK IF VALID POS ----------------- */
-    file_pos_end   = p_journal_data->FilePos + len;
-    if (file_pos_end > FS_FAT_JOURNAL_FILE_LEN) {
-        FS_TRACE_DBG(("FS_FAT_JournalRd(): Attempt to rd beyond journal file end.\r\n"));
-       *p_err = FS_ERR_INVALID_ARG;
-        return;
-    }
-
+                                                                /* ----------------- SET PARTTERN POS ----------------- */
+    p_pattern_start = (CPU_INT08U *)p_pattern;
+    p_pattern_end   = p_pattern_start + pattern_size - 1u;
+    p_pattern_pos   = p_pattern_end;
 
-    rem_size    = len;
-    cur_sec     = p_journal_data->FileCurSec;
-    cur_sec_pos = p_journal_data->FileCurSecPos;
-    do {
-                                                                /* --------------------- READ SEC --------------------- */
-                                                                /* Compute next rd chunk size.                          */
-        rd_size = DEF_MIN((p_fat_data->SecSize - cur_sec_pos), rem_size);
-        FSBuf_Set(p_buf,
-                  cur_sec,
-                  FS_VOL_SEC_TYPE_FILE,
-                  DEF_YES,
-                  p_err);
-        if (*p_err != FS_ERR_NONE) {
-            return;
-        }
 
-                                                                /* ----------------- COPY TO DEST BUF ----------------- */
-        Mem_Copy((void *)  p_log,
-                 (void *)((CPU_INT08U *)p_buf->DataPtr + cur_sec_pos),
-                           rd_size);
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if ((start_pos - end_pos) > FS_FAT_JOURNAL_FILE_LEN - 1u) {
+        *p_err = FS_ERR_INVALID_ARG;
+         return (0u);
+    }
+#endif
 
-                                                                /* ----------- UPDATE SEC POS AND REM SIZE ------------ */
-        cur_sec_pos = (cur_sec_pos + rd_size) & (p_fat_data->SecSize - 1u);
-        rem_size -= rd_size;
+    p_data  = DEF_NULL;
+    cur_pos = start_pos + 1u;
+    rem_cnt = start_pos - end_pos + 1u;
+    while (rem_cnt != 0u) {
+                                                                /* ---------------- PEEK AT NEXT OCTET ---------------- */
+        cur_pos--;
+        rem_cnt--;
+        sec_pos = (FS_SEC_SIZE)(cur_pos & (p_fat_data->SecSize - 1u));
+        if (sec_pos < FS_FAT_JOURNAL_SEC_HDR_SIZE) {
+            continue;                                           /* Skip sec header (see Note #1).                       */
+        }
 
+        if ((p_data  == DEF_NULL) ||                            /* If sec entered ...                                   */
+            (sec_pos == p_fat_data->SecSize - 1u)) {
+            FS_FAT_JournalPosSet(p_vol,                         /* ... find it ...                                      */
+                                 p_buf,
+                                 cur_pos,
+                                 p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return (0u);
+            }
 
-                                                                /* ------------------- GET NEXT SEC ------------------- */
-        if ((cur_sec_pos == 0u) && (rem_size != 0u)) {          /* If we crossed sec boundary amd data rem ...          */
-            cur_sec = FS_FAT_SecNextGet(p_vol,                  /* ... find next sec.                                   */
-                                        p_buf,
-                                        cur_sec,
-                                        p_err);
+            p_data = FS_FAT_JournalSecGet(p_vol,                /* ... & rd it (see Note #2).                           */
+                                          p_buf,
+                                          p_journal_data->FileCurSec,
+                                          p_err);
             if (*p_err != FS_ERR_NONE) {
-                return;
+                return (0u);
             }
         }
 
-    } while (rem_size != 0u);
+                                                                /* ------------------- CHK IF MATCH ------------------- */
+        if (p_data[sec_pos] == *p_pattern_pos) {                /* If octet match occurs ...                            */
+            if (p_pattern_pos == p_pattern_start) {             /* ... if pattern match occurs ...                      */
+                return cur_pos;                                 /* ... rtn cur pos OR ...                               */
+            }                                                   /* ... if no pattern match occurs ...                   */
+            p_pattern_pos--;                                    /* ... look for next octet.                             */
+        } else {                                                /* If no octet match occurs ...                         */
+            p_pattern_pos = p_pattern_end;                      /* ... reset cur pattern pos.                           */
+        }
+    }
 
-                                                                /* -------------------- UPDATE POS -------------------- */
-    p_journal_data->FilePos       = file_pos_end;
-    p_journal_data->FileCurSec    = cur_sec;
-    p_journal_data->FileCurSecPos = cur_sec_pos;
+                                                                /* --------------------- NO MATCH --------------------- */
+   *p_err = FS_ERR_VOL_JOURNAL_LOG_INCOMPLETE;
+    return (0u);
 }
 
 
 /*
 *********************************************************************************************************
-*                                    FS_FAT_JournalRd_INTxxU()
+*                                       FS_FAT_JournalTxDefer()
 *
-* Description : Read 16-/32-bit value from journal & increment file position.
+* Description : Check if the journal checkpoint ending a top level operation may be deferred.
 *
 * Argument(s) : p_vol   Pointer to volume.
 *
-*               p_buf   Pointer to temporary buffer.
-*
-*               p_err   Pointer to variable that will receive the return error code from this function :
-*
-*                           FS_ERR_NONE     Journal read.
-*
-*                           ---------------RETURNED BY FS_FAT_JournalRd()-------------
-*                           See FS_FAT_JournalRd() for additional return error codes.
+* Return(s)   : DEF_YES, if the journal checkpoint may be deferred.
+*               DEF_NO,  otherwise.
 *
-* Return(s)   : 16/32-bit value.
+* Note(s)     : (1) At most half of the journal is used by pending operations, so that the logs of the
+*                   next top level operation always fit in the journal.
 *
-* Note(s)     : none.
+*               (2) See 'FS_FAT_JournalTxWindowSet()  Notes #1 & #3'.
 *********************************************************************************************************
 */
 
-static  CPU_INT16U  FS_FAT_JournalRd_INT16U (FS_VOL  *p_vol,
-                                             FS_BUF  *p_buf,
-                                             FS_ERR  *p_err)
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  FS_FAT_JournalTxDefer (FS_VOL  *p_vol)
 {
-    CPU_INT16U  val;
-    CPU_INT08U  log[2u];
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+    FS_FAT_FILE_SIZE   size_max;
+    CLK_TS_SEC         ts;
+    CPU_BOOLEAN        ts_valid;
 
 
-    FS_FAT_JournalRd(p_vol,
-                     p_buf,
-                    &log[0],
-                     2u,
-                     p_err);
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
 
-    val = MEM_VAL_GET_INT16U_LITTLE(&log[0]);
-    return (val);
-}
+    if ((p_fat_data->JournalTxNestCnt  == 0u) &&                /* If no tx begun ...                                   */
+        (p_fat_data->JournalTxInterval == 0u) &&                /* ... & no window set ...                              */
+        (p_fat_data->JournalTxSize     == 0u)) {
+        return (DEF_NO);                                        /* ... checkpoint journal.                              */
+    }
+
+                                                                /* ------------------- CHK TX SIZE -------------------- */
+    size_max = FS_FAT_JOURNAL_FILE_LEN / 2u;                    /* See Note #1.                                         */
+    if ((p_fat_data->JournalTxSize != 0u) &&
+        (p_fat_data->JournalTxSize <  size_max)) {
+        size_max = (FS_FAT_FILE_SIZE)p_fat_data->JournalTxSize;
+    }
+    if ((p_journal_data->FilePos - p_fat_data->JournalCkptPos) >= size_max) {
+        return (DEF_NO);
+    }
 
+    if (p_fat_data->JournalTxNestCnt != 0u) {                   /* Tx begun: checkpoint on commit.                      */
+        return (DEF_YES);
+    }
 
-static  CPU_INT32U  FS_FAT_JournalRd_INT32U (FS_VOL  *p_vol,
-                                             FS_BUF  *p_buf,
-                                             FS_ERR  *p_err)
-{
-    CPU_INT32U  val;
-    CPU_INT08U  log[4u];
+                                                                /* ----------------- CHK TX INTERVAL ------------------ */
+    if (p_fat_data->JournalTxInterval == 0u) {
+        return (DEF_YES);
+    }
 
+    ts_valid = Clk_GetTS(&ts);                                  /* See Note #2.                                         */
+    if (ts_valid == DEF_NO) {
+        return (DEF_NO);
+    }
+                                                                /* If first pending op ...                              */
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_TX_PEND) == DEF_NO) {
+        p_fat_data->JournalTxTS = ts;                           /* ... start window.                                    */
+        return (DEF_YES);
+    }
 
-    FS_FAT_JournalRd(p_vol,
-                     p_buf,
-                    &log[0],
-                     4u,
-                     p_err);
+    if ((ts - p_fat_data->JournalTxTS) >= p_fat_data->JournalTxInterval) {
+        return (DEF_NO);
+    }
 
-    val = MEM_VAL_GET_INT32U_LITTLE(&log[0]);
-    return (val);
+    return (DEF_YES);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                        FS_FAT_JournalWr()
+*                                     FS_FAT_JournalStageRdWr()
 *
-* Description : Write log to journal.
+* Description : Read a journal sector into the staging buffer, or write the staging buffer to a journal sector.
 *
 * Argument(s) : p_vol   Pointer to volume.
 *
-*               p_buf   Pointer to temporary buffer.
+*               sec     Journal sector.
 *
-*               p_log   Pointer to log buffer.
+*               wr      Indicates whether the sector is written or read :
 *
-*               len     Length of log, in octets.
+*                           DEF_YES    Staging buffer written to sector.
+*                           DEF_NO     Sector read into staging buffer.
 *
 *               p_err   Pointer to variable that will receive the return error code from this function :
 *
-*                           FS_ERR_NONE                         Log written to journal.
-*                           FS_ERR_JOURNAL_FULL                 Journal full.
-*                           FS_ERR_VOL_JOURNAL_FILE_INVALID     Journal file invalid.
-*
-*                           ------------------RETURNED BY FSBuf_Set()------------------
-*                           See FSBuf_Set() for additional return error codes.
+*                           FS_ERR_NONE      Journal sector read/written.
+*                           FS_ERR_OS_LOCK   Journal device lock could not be acquired.
 *
-*                           --------------RETURNED BY FS_FAT_SecNextGet()--------------
-*                           See FS_FAT_SecNextGet() for additional return error codes.
+*                           ------RETURNED BY FSVol_RdLockedEx()/FSVol_WrLockedEx()-----
+*                           See FSVol_RdLockedEx()/FSVol_WrLockedEx() for additional return error codes.
 *
-*                           ---------------RETURNED BY FSBuf_MarkDirty()---------------
-*                           See FSBuf_MarkDirty() for additional return error codes.
+*                           -------RETURNED BY FSDev_RdLocked()/FSDev_WrLocked()--------
+*                           See FSDev_RdLocked()/FSDev_WrLocked() for additional return error codes.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) A journal placed on another device is accessed under that device's lock, which is
+*                   acquired while the lock of the volume device is held (see 'FS_FAT_JournalOpenDev()
+*                   Note #2').
 *********************************************************************************************************
 */
 
-static  void  FS_FAT_JournalWr (FS_VOL      *p_vol,
-                                FS_BUF      *p_buf,
-                                void        *p_log,
-                                CPU_SIZE_T   len,
-                                FS_ERR      *p_err)
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+static  void  FS_FAT_JournalStageRdWr (FS_VOL          *p_vol,
+                                       FS_FAT_SEC_NBR   sec,
+                                       CPU_BOOLEAN      wr,
+                                       FS_ERR          *p_err)
 {
-    FS_FAT_DATA       *p_fat_data;
-    FS_FAT_FILE_DATA  *p_journal_data;
-    FS_FAT_FILE_SIZE   file_pos_end;
-    CPU_SIZE_T         wr_size;
-    CPU_SIZE_T         rem_size;
-    FS_SEC_SIZE        cur_sec_pos;
-    FS_FAT_SEC_NBR     cur_sec;
-
-
-    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
-    p_journal_data =  p_fat_data->JournalDataPtr;
-
-                                                                /* -------------- CHK IF WR OUT OF BOUNDS ------------- */
-    file_pos_end   = p_journal_data->FilePos + len;
-    if (file_pos_end > FS_FAT_JOURNAL_FILE_LEN) {
-       *p_err = FS_ERR_VOL_JOURNAL_FULL;
-        return;
-    }
-
-
-    rem_size    = len;
-    cur_sec     = p_journal_data->FileCurSec;
-    cur_sec_pos = p_journal_data->FileCurSecPos;
-    do {
-                                                                /* Compute next rd chunk size.                          */
-        wr_size  = DEF_MIN((p_fat_data->SecSize - cur_sec_pos), rem_size);
+    FS_FAT_DATA  *p_fat_data;
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+    FS_DEV       *p_dev;
+    CPU_BOOLEAN   lock_success;
+#endif
 
-        FSBuf_Set(p_buf,                                        /* Set buf.                                             */
-                  cur_sec,
-                  FS_VOL_SEC_TYPE_FILE,
-                  DEF_YES,
-                  p_err);
-        if (*p_err != FS_ERR_NONE) {
-            return;
-        }
 
-                                                                /* ----------------- WR LOG TO JOURNAL ---------------- */
-                                                                /* Copy log into buf.                                   */
-        Mem_Copy((CPU_INT08U *)p_buf->DataPtr + cur_sec_pos,
-                 (void *)p_log,
-                  wr_size);
-                                                                /* Udpate cur sec pos & rem size.                       */
-        cur_sec_pos = (cur_sec_pos + wr_size) & (p_fat_data->SecSize - 1u);
-        rem_size -= wr_size;
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
 
-        FSBuf_MarkDirty(p_buf, p_err);                          /* Mark buf as dirty.                                   */
-        if (*p_err != FS_ERR_NONE) {
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+    p_dev = p_fat_data->JournalDevPtr;
+    if (p_dev != DEF_NULL) {                                    /* ---------------- JOURNAL ON OTHER DEV -------------- */
+        lock_success = FSDev_Lock(p_dev);                       /* See Note #1.                                         */
+        if (lock_success != DEF_YES) {
+           *p_err = FS_ERR_OS_LOCK;
             return;
         }
-
-                                                                /* ------------------- GET NEXT SEC ------------------- */
-        if ((cur_sec_pos == 0u) && (rem_size > 0)) {            /* If we crossed sec boundary and data rem ...          */
-            cur_sec = FS_FAT_SecNextGet(p_vol,                  /* ... get next sec.                                    */
-                                        p_buf,
-                                        cur_sec,
-                                        p_err);
-            if (*p_err != FS_ERR_NONE) {                        /* No next sec in file ...                              */
-               *p_err = FS_ERR_VOL_JOURNAL_FILE_INVALID;
-                return;
-            }
+        if (wr == DEF_YES) {
+            FSDev_WrLocked(p_dev,
+                           p_fat_data->JournalStageBufPtr,
+                           (FS_SEC_NBR)sec,
+                           1u,
+                           p_err);
+        } else {
+            FSDev_RdLocked(p_dev,
+                           p_fat_data->JournalStageBufPtr,
+                           (FS_SEC_NBR)sec,
+                           1u,
+                           p_err);
         }
+        FSDev_Unlock(p_dev);
+        return;
+    }
+#endif
 
-    } while(rem_size > 0);
-
-                                                                /* -------------------- UPDATE POS -------------------- */
-    p_journal_data->FilePos       = file_pos_end;
-    p_journal_data->FileCurSec    = cur_sec;
-    p_journal_data->FileCurSecPos = cur_sec_pos;
+                                                                /* ------------------ JOURNAL ON VOL ------------------ */
+    if (wr == DEF_YES) {
+        FSVol_WrLockedEx(p_vol,
+                         p_fat_data->JournalStageBufPtr,
+                         sec,
+                         1u,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+    } else {
+        FSVol_RdLockedEx(p_vol,
+                         p_fat_data->JournalStageBufPtr,
+                         sec,
+                         1u,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+    }
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                       FS_FAT_JournalReverseScan()
+*                                      FS_FAT_JournalStageSet()
 *
-* Description : Scan journal backward, looking for given pattern.
+* Description : Set the journal sector held in the staging buffer.
 *
-* Argument(s) : p_vol           Pointer to volume.
+* Argument(s) : p_vol   Pointer to volume.
 *
-*               p_buf           Pointer to temporary buffer.
+*               sec     Journal sector to stage.
 *
-*               start_pos       Position to start scan at.
+*               rd      Indicates whether the sector MUST be read from the device :
 *
-*               pattern         Pattern to look for.
+*                           DEF_YES    Sector read.
+*                           DEF_NO     Sector cleared (see Note #1).
 *
-*               pattern_size    Pattern size in octets.
+*               p_err   Pointer to variable that will receive the return error code from this function :
 *
-*               p_err           Pointer to variable that will receive the return error code from this function :
+*                           FS_ERR_NONE    Journal sector staged.
 *
-*                                   FS_ERR_NONE                          Pattern found.
-*                                   FS_ERR_VOL_JOURNAL_LOG_INCOMPLETE    Pattern not found.
+*                           -----------RETURNED BY FS_FAT_JournalStageFlush()-----------
+*                           See FS_FAT_JournalStageFlush() for additional return error codes.
 *
-*                                   -------------RETURNED BY FS_FAT_JournalPeek()--------------
-*                                   See FS_FAT_JournalPeek() for additional return error codes.
+*                           -----------RETURNED BY FS_FAT_JournalStageRdWr()------------
+*                           See FS_FAT_JournalStageRdWr() for additional return error codes.
 *
-* Return(s)   : Start position of first pattern occurence if match occurs. Zero if no match.
+* Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) A journal sector entered at its start is re-initialized (see 'FS_FAT_JournalWr()
+*                   Note #1') & need not be read.
 *********************************************************************************************************
 */
 
-static  CPU_SIZE_T  FS_FAT_JournalReverseScan (FS_VOL      *p_vol,
-                                               FS_BUF      *p_buf,
-                                               CPU_SIZE_T   start_pos,
-                                               CPU_INT08U  *p_pattern,
-                                               CPU_SIZE_T   pattern_size,
-                                               FS_ERR      *p_err)
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+static  void  FS_FAT_JournalStageSet (FS_VOL          *p_vol,
+                                      FS_FAT_SEC_NBR   sec,
+                                      CPU_BOOLEAN      rd,
+                                      FS_ERR          *p_err)
 {
-    CPU_INT08U   octet_val;
-    CPU_INT08U  *p_pattern_pos;
-    CPU_INT08U  *p_pattern_start;
-    CPU_INT08U  *p_pattern_end;
-    CPU_SIZE_T   cur_pos;
-
-
-                                                                /* ----------------- SET PARTTERN POS ----------------- */
-    p_pattern_start = (CPU_INT08U *)p_pattern;
-    p_pattern_end   = p_pattern_start + pattern_size - 1u;
-    p_pattern_pos   = p_pattern_end;
+    FS_FAT_DATA  *p_fat_data;
 
 
-#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
-    if (start_pos > FS_FAT_JOURNAL_FILE_LEN - 1u) {
-        *p_err = FS_ERR_INVALID_ARG;
-         return (0u);
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    if ((p_fat_data->JournalStageState != FS_BUF_STATE_NONE) &&
+        (p_fat_data->JournalStageSec   == sec)) {               /* If sec already staged ...                            */
+       *p_err = FS_ERR_NONE;                                    /* ... nothing to do.                                   */
+        return;
     }
-#endif
 
-    cur_pos = start_pos + 1u;
-    while (cur_pos != 0u) {
-                                                                /* ---------------- PEEK AT NEXT OCTET ---------------- */
-        cur_pos--;
-        FS_FAT_JournalPosSet(p_vol,                             /* Set pos.                                             */
-                             p_buf,
-                             cur_pos,
-                             p_err);
-        if (*p_err != FS_ERR_NONE) {
-            return (0u);
-        }
+    FS_FAT_JournalStageFlush(p_vol, p_err);                     /* Wr prev staged sec.                                  */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
 
-        FS_FAT_JournalRd(p_vol,                                 /* Rd journal.                                          */
-                         p_buf,
-                         &octet_val,
-                         1u,
-                         p_err);
+    if (rd == DEF_YES) {                                        /* Rd sec ...                                           */
+        FS_FAT_JournalStageRdWr(p_vol,
+                                sec,
+                                DEF_NO,
+                                p_err);
         if (*p_err != FS_ERR_NONE) {
-            return (0u);
-        }
-
-                                                                /* ------------------- CHK IF MATCH ------------------- */
-        if (octet_val == *p_pattern_pos) {                      /* If octet match occurs ...                            */
-            if (p_pattern_pos == p_pattern_start) {             /* ... if pattern match occurs ...                      */
-                return cur_pos;                                 /* ... rtn cur pos OR ...                               */
-            }                                                   /* ... if no pattern match occurs ...                   */
-            p_pattern_pos--;                                    /* ... look for next octet.                             */
-        } else {                                                /* If no octet match occurs ...                         */
-            p_pattern_pos = p_pattern_end;                      /* ... reset cur pattern pos.                           */
+            p_fat_data->JournalStageState = FS_BUF_STATE_NONE;
+            return;
         }
+    } else {                                                    /* ... or clr it (see Note #1).                         */
+        Mem_Clr((void *)p_fat_data->JournalStageBufPtr, (CPU_SIZE_T)p_fat_data->SecSize);
     }
 
-                                                                /* --------------------- NO MATCH --------------------- */
-   *p_err = FS_ERR_VOL_JOURNAL_LOG_INCOMPLETE;
-    return (0u);
+    p_fat_data->JournalStageSec   = sec;
+    p_fat_data->JournalStageState = FS_BUF_STATE_USED;
+   *p_err = FS_ERR_NONE;
 }
+#endif
 
 
 /*
 *********************************************************************************************************
 *                                       FS_FAT_JournalReplay()
 *
-* Description : Replay journal. Revert partially completed top level FAT operations involving cluster
-*               chain allocation and/or directory entry creation/deletion. Top level FAT operations
-*               involving cluster chain deletion will be completed.
+* Description : Replay journal.
 *
 * Argument(s) : p_vol   Pointer to volume.
 *
 *               p_err   Pointer to variable that will receive the return error code from this function :
 *
-*                           FS_ERR_NONE                         Journal replayed.
-*                           FS_ERR_BUF_NONE_AVAIL               No buffer available.
-*
-*
-*                           --------------RETURNED BY FS_FAT_JournalRevertEntryUpdate()---------------
-*                           See FS_FAT_JournalRevertEntryUpdate() for additional return error codes.
-*
-*                           --------------------RETURNED BY FS_FAT_JournalPeek()----------------------
-*                           See FS_FAT_JournalPeek() for additional return error codes.
-*
-*                           -------------------RETURNED BY FS_FAT_JournalSetPos()---------------------
-*                           See FS_FAT_JournalSetPos() for additional return error codes.
+*                           FS_ERR_NONE                     Journal replayed.
+*                           FS_ERR_BUF_NONE_AVAIL           No buffer available.
+*                           FS_ERR_VOL_JOURNAL_CFG_CHNGD    Old-format journal logs discarded (see Note #7).
 *
-*                           ------------------------RETURNED BY FSBuf_Flush()-------------------------
-*                           See FSBuf_Flush() for additional return error codes.
+*                           ---------------------RETURNED BY FS_FAT_JournalSecScan()------------------
+*                           See FS_FAT_JournalSecScan() for additional return error codes.
 *
-*                           ---------------------RETURNED BY FS_FAT_JournalClr()----------------------
-*                           See FS_FAT_JournalClr() for additional return error codes.
+*                           ---------------------RETURNED BY FS_FAT_JournalCkptWr()-------------------
+*                           See FS_FAT_JournalCkptWr() for additional return error codes.
 *
 *                           --------------RETURNED BY FS_FAT_JournalRevertEntryCreate()---------------
 *                           See FS_FAT_JournalRevertEntryCreate() for additional return error codes.
@@ -2350,10 +3990,11 @@ static  CPU_SIZE_T  FS_FAT_JournalReverseScan (FS_VOL      *p_vol,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) If the first 16-bit word read from the journal is not an enter mark, the journal is
-*                   clear or has been partially cleared. This indicates that the last top level FAT operation
-*                   previously performed has been completed. Therefore, no operation needs to be replayed/
-*                   reverted and the journal is cleared.
+* Note(s)     : (1) The journal is scanned backward from its head, the most recently written sector, down
+*                   to the last checkpoint log.  The logs found in between belong to top level operations
+*                   that were not committed & are reverted.  If the last complete log is a checkpoint, no
+*                   operation needs to be replayed/reverted.  Logs preceding the journal tail (see
+*                   'FS_FAT_JournalSecScan()  Note #1') were overwritten & are never parsed.
 *
 *               (2) Since reverting a cluster chain deletion basically involves logging all deleted clusters,
 *                   it is practically impossible to implement without huge performance penalty.
@@ -2365,8 +4006,35 @@ static  CPU_SIZE_T  FS_FAT_JournalReverseScan (FS_VOL      *p_vol,
 *
 *                   (b) Since the journal is replayed backward, the clus chain deletion log is the
 *                       first log to be parsed. Once cluster chain deletion is completed, the containing
-*                       top level operation is also completed (see Note 2a). The journal is then cleared
-*                       and the replay is aborted.
+*                       top level operation is also completed (see Note 2a). The journal is then
+*                       checkpointed and the replay is aborted.
+*
+*               (3) If journal transactions are used, the journal may hold the logs of several top level
+*                   operations.  These are reverted from last to first.  If an operation deleted a cluster
+*                   chain, it is completed (see Note #2b) & the operations preceding it are kept, since
+*                   their modifications were written before its logs.
+*
+*               (4) New logs are appended from the start of the sector following the head, so that the
+*                   head sector, which may end with an incomplete log, is never rewritten.  A checkpoint is
+*                   written only if an operation was replayed/reverted.
+*
+*               (5) A cluster chain deletion logged as cluster ranges is completed in a single pass over the
+*                   logged FAT entries (see 'FS_FAT_JournalReplayClusRangeDel()').  Replay time is then
+*                   bounded by the journal length & the size of the deleted chain, rather than by the size of
+*                   the FAT.  The cost of the last replay is recorded & may be obtained with
+*                   'FS_FAT_JournalReplayInfoGet()'.
+*
+*               (6) Once replayed, a volume found dirty when mounted needs no check & may be marked clean
+*                   again (see 'fs_fat.c  FS_FAT_VolSync()  Note #2').  This assumes the journal was in
+*                   use whenever the volume was modified.
+*
+*               (7) A journal written in the old format, which had no sector headers & was cleared after
+*                   each top level operation, holds pending logs if it starts with an enter mark.  These
+*                   logs, including cluster range deletion logs, can NOT be replayed.  The journal is then
+*                   upgraded by writing a checkpoint at its start, the logs are discarded & the volume
+*                   is flagged as requiring a check.  FS_ERR_VOL_JOURNAL_CFG_CHNGD is returned, so that
+*                   the application may check the volume with 'FS_FAT_VolChk()' before opening the
+*                   journal again.
 *********************************************************************************************************
 */
 
@@ -2376,11 +4044,23 @@ static  void  FS_FAT_JournalReplay (FS_VOL  *p_vol,
     FS_FAT_DATA       *p_fat_data;
     FS_FAT_FILE_DATA  *p_journal_data;
     FS_BUF            *p_buf;
-    CPU_INT16U         mark;
     CPU_INT16U         sig;
+    CPU_INT16U         mark;
     CPU_INT08U         buf[4u];
-    CPU_SIZE_T         journal_pos;
-    CPU_BOOLEAN        clus_chain_deleted;
+    CPU_INT08U        *p_data;
+    FS_FAT_FILE_SIZE   head_pos;
+    FS_FAT_FILE_SIZE   tail_pos;
+    FS_FAT_FILE_SIZE   journal_pos;
+    CPU_BOOLEAN        head_found;
+    CPU_BOOLEAN        replayed;
+    CPU_BOOLEAN        done;
+    CPU_BOOLEAN        ts_valid;
+    CLK_TS_SEC         ts_start;
+    CLK_TS_SEC         ts_end;
+#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
+    FS_CTR             rd_cnt;
+    FS_CTR             wr_cnt;
+#endif
 
 
     p_fat_data     = (FS_FAT_DATA  *)p_vol->DataPtr;
@@ -2388,6 +4068,16 @@ static  void  FS_FAT_JournalReplay (FS_VOL  *p_vol,
 
                                                                 /* ------------------- REPLAY START ------------------- */
     DEF_BIT_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_REPLAY);
+    FS_FAT_ClusChainHintClr(p_vol);                             /* Replay may free clus's directly.                     */
+
+    Mem_Clr((void     *)&p_fat_data->JournalReplayInfo,         /* Start measuring replay cost (see Note #5).           */
+            (CPU_SIZE_T) sizeof(FS_FAT_JOURNAL_REPLAY_INFO));
+    ts_start = 0u;
+    ts_valid = Clk_GetTS(&ts_start);
+#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
+    rd_cnt   = p_vol->StatRdSecCtr;
+    wr_cnt   = p_vol->StatWrSecCtr;
+#endif
 
 
     p_buf = FSBuf_Get(p_vol);                                   /* Get buf.                                             */
@@ -2395,39 +4085,65 @@ static  void  FS_FAT_JournalReplay (FS_VOL  *p_vol,
        *p_err = FS_ERR_BUF_NONE_AVAIL;
         return;
     }
-                                                                /* ---------- CHK IF JOURNAL HAS BEEN CLR'D ----------- */
-    FS_FAT_JournalPeek(p_vol,                                   /* See Note #1.                                         */
-                       p_buf,
-                      &buf[0],
-                       0u,
-                       FS_FAT_JOURNAL_LOG_MARK_SIZE,
-                       p_err);
+    p_journal_data->FilePos       = 0u;                         /* Start at journal file start.                         */
+    p_journal_data->FileCurSec    = FS_FAT_JournalSecFirstGet(p_fat_data);
+    p_journal_data->FileCurSecPos = 0u;
+    p_fat_data->JournalCkptPos    = 0u;
+
+                                                                /* ---------------- FIND JOURNAL HEAD ----------------- */
+    head_found = FS_FAT_JournalSecScan(p_vol,
+                                       p_buf,
+                                      &head_pos,
+                                      &tail_pos,
+                                       p_err);
     if (*p_err != FS_ERR_NONE) {
         FSBuf_Free(p_buf);
         return;
     }
 
-    mark = MEM_VAL_GET_INT16U_LITTLE(&buf[0]);
-    if (mark != FS_FAT_JOURNAL_MARK_ENTER) {                    /* If first enter mark is not found ...                 */
-                                                                /* ... then journal has been (partially) clr'd.         */
-        FS_FAT_JournalClrAllReset(p_vol,                        /* Make sure journal is completely clr'd ...            */
-                                  p_buf,
-                                  p_err);
+    if (head_found == DEF_NO) {                                 /* If no journal sec ever wr'n, nothing to replay ...   */
+        p_data = FS_FAT_JournalSecGet(p_vol,                    /* ... unless old-format logs pending (see Note #7).    */
+                                      p_buf,
+                                      FS_FAT_JournalSecFirstGet(p_fat_data),
+                                      p_err);
         if (*p_err != FS_ERR_NONE) {
+            FSBuf_Free(p_buf);
             return;
         }
-        FSBuf_Flush(p_buf, p_err);
+        mark = MEM_VAL_GET_INT16U_LITTLE(p_data);
+        if (mark == FS_FAT_JOURNAL_MARK_ENTER) {
+            FS_TRACE_INFO(("FS_FAT_JournalReplay(): Old-format journal logs can not be replayed; logs discarded.\r\n"));
+            FS_FAT_JournalCkptWr(p_vol,                         /* Upgrade journal.                                     */
+                                 p_buf,
+                                 p_err);
+            if (*p_err == FS_ERR_NONE) {
+                FSBuf_Flush(p_buf, p_err);
+            }
+            FSBuf_Free(p_buf);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+#if (FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED)
+            p_fat_data->VolChkReqd = DEF_YES;
+#endif
+           *p_err = FS_ERR_VOL_JOURNAL_CFG_CHNGD;
+            DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_REPLAY);
+            return;
+        }
+
         FSBuf_Free(p_buf);
         DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_REPLAY);
-        return;                                                 /* ... and abort replay.                                */
+        return;
     }
 
 
                                                                 /* ----- FIND LAST COMPLETE ENTRY ENTER END MARK ------ */
+    replayed = DEF_NO;
     MEM_VAL_SET_INT16U_LITTLE(&buf[0], FS_FAT_JOURNAL_MARK_ENTER_END);
     journal_pos = FS_FAT_JournalReverseScan(p_vol,
                                             p_buf,
-                                            FS_FAT_JOURNAL_FILE_LEN - 1u,
+                                            head_pos + p_fat_data->SecSize - 1u,
+                                            tail_pos,
                                            &buf[0],
                                             FS_FAT_JOURNAL_LOG_MARK_SIZE,
                                             p_err);
@@ -2437,34 +4153,23 @@ static  void  FS_FAT_JournalReplay (FS_VOL  *p_vol,
         return;
     }
 
-    if (*p_err == FS_ERR_VOL_JOURNAL_LOG_INCOMPLETE) {          /* If no enter end mark is found ...                    */
-                                                                /* ... then journal does not contain a complete entry.  */
-        FS_FAT_JournalClrAllReset(p_vol,                        /* Make sure journal is completely clr'd ...            */
-                                  p_buf,
-                                  p_err);
-        if (*p_err != FS_ERR_NONE) {
-            return;
-        }
-        FSBuf_Flush(p_buf, p_err);
-        FSBuf_Free(p_buf);
-        DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_REPLAY);
-        return;                                                 /* ... and abort replay.                                */
-    }
-
-    clus_chain_deleted = DEF_NO;
-    while ((journal_pos > 0u) &&
-           (clus_chain_deleted == DEF_NO)) {
+                                                                /* If no enter end mark is found ...                    */
+    done = (*p_err == FS_ERR_VOL_JOURNAL_LOG_INCOMPLETE) ? DEF_YES : DEF_NO;
+    while (done == DEF_NO) {                                    /* ... journal does not contain a complete entry.       */
 
                                                                 /* --------------- FIND NEXT LOG ENTRY ---------------- */
         MEM_VAL_SET_INT16U_LITTLE(&buf[0], FS_FAT_JOURNAL_MARK_ENTER);
         journal_pos = FS_FAT_JournalReverseScan(p_vol,
                                                 p_buf,
                                                 journal_pos,
+                                                tail_pos,
                                                &buf[0],
                                                 FS_FAT_JOURNAL_LOG_MARK_SIZE,
                                                 p_err);
-        if ((*p_err != FS_ERR_NONE) &&
-            (*p_err != FS_ERR_VOL_JOURNAL_LOG_INCOMPLETE)) {
+        if (*p_err == FS_ERR_VOL_JOURNAL_LOG_INCOMPLETE) {      /* If journal tail reached ...                          */
+            break;                                              /* ... all logs parsed.                                 */
+        }
+        if (*p_err != FS_ERR_NONE) {
             FSBuf_Free(p_buf);
             return;
         }
@@ -2483,7 +4188,9 @@ static  void  FS_FAT_JournalReplay (FS_VOL  *p_vol,
         FS_FAT_JournalPeek(p_vol,                               /* Enter mark presence already asserted by prev scan ...*/
                            p_buf,
                           &buf[0],
-                           p_journal_data->FilePos + FS_FAT_JOURNAL_LOG_MARK_SIZE,      /* ... so skip enter mark.      */
+                           FS_FAT_JournalPosAdv(p_fat_data,     /* ... so skip enter mark.                              */
+                                                journal_pos,
+                                                FS_FAT_JOURNAL_LOG_MARK_SIZE),
                            FS_FAT_JOURNAL_LOG_SIG_SIZE,
                            p_err);
         if (*p_err != FS_ERR_NONE) {
@@ -2496,29 +4203,50 @@ static  void  FS_FAT_JournalReplay (FS_VOL  *p_vol,
 
                                                                 /* ---------------------- REPLAY ---------------------- */
         switch (sig) {
+            case FS_FAT_JOURNAL_SIG_CKPT:                       /* Last ckpt reached (see Note #1).                     */
+                 done = DEF_YES;
+                 break;
+
             case FS_FAT_JOURNAL_SIG_CLUS_CHAIN_ALLOC:
                  FS_FAT_JournalRevertClusChainAlloc(p_vol,      /* Revert clus chain alloc.                             */
                                                     p_buf,
                                                     p_err);
+                 replayed = DEF_YES;
+                 p_fat_data->JournalReplayInfo.LogCnt++;
                  break;
 
             case FS_FAT_JOURNAL_SIG_CLUS_CHAIN_DEL:
                  FS_FAT_JournalReplayClusChainDel(p_vol,        /* Complete clus chain del (See Note #2a).              */
                                                   p_buf,
                                                   p_err);
-                 clus_chain_deleted = DEF_YES;                  /* Clus chain has been del'd (See Note #2b).            */
+                 replayed = DEF_YES;
+                 p_fat_data->JournalReplayInfo.LogCnt++;
+                 done     = DEF_YES;                            /* Clus chain has been del'd (See Note #2b).            */
+                 break;
+
+            case FS_FAT_JOURNAL_SIG_CLUS_RANGE_DEL:
+                 FS_FAT_JournalReplayClusRangeDel(p_vol,        /* Complete clus range del (See Notes #2a & #5).        */
+                                                  p_buf,
+                                                  p_err);
+                 replayed = DEF_YES;
+                 p_fat_data->JournalReplayInfo.LogCnt++;
+                 done     = DEF_YES;                            /* Clus chain has been del'd (See Note #2b).            */
                  break;
 
             case FS_FAT_JOURNAL_SIG_ENTRY_CREATE:
                  FS_FAT_JournalRevertEntryCreate(p_vol,         /* Revert dir entry creation.                           */
                                                  p_buf,
                                                  p_err);
+                 replayed = DEF_YES;
+                 p_fat_data->JournalReplayInfo.LogCnt++;
                  break;
 
             case FS_FAT_JOURNAL_SIG_ENTRY_UPDATE:
                  FS_FAT_JournalRevertEntryUpdate(p_vol,         /* Revert dir entry update/del.                         */
                                                  p_buf,
                                                  p_err);
+                 replayed = DEF_YES;
+                 p_fat_data->JournalReplayInfo.LogCnt++;
                  break;
 
             default:
@@ -2526,29 +4254,192 @@ static  void  FS_FAT_JournalReplay (FS_VOL  *p_vol,
                 *p_err = FS_ERR_NONE;
                  break;
         }
+        if (*p_err != FS_ERR_NONE) {
+            FSBuf_Free(p_buf);
+            return;
+        }
     }
-    if (*p_err != FS_ERR_NONE) {
-        return;
-    }
 
-                                                                /* -------------------- CLR JOURNAL ------------------- */
-    FS_FAT_JournalClrAllReset(p_vol,
-                              p_buf,
-                              p_err);
+
+                                                                /* ---------------- SET JOURNAL POS ------------------- */
+    FS_FAT_JournalPosSet(p_vol,                                 /* Start new logs in next sec (see Note #4).            */
+                         p_buf,
+                         head_pos + p_fat_data->SecSize,
+                         p_err);
     if (*p_err != FS_ERR_NONE) {
         FSBuf_Free(p_buf);
         return;
     }
+    p_fat_data->JournalCkptPos = p_journal_data->FilePos;
+
+    if (replayed == DEF_YES) {                                  /* ----------------- CHECKPOINT JOURNAL --------------- */
+        FS_FAT_JournalCkptWr(p_vol,
+                             p_buf,
+                             p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSBuf_Free(p_buf);
+            return;
+        }
+    }
 
                                                                 /* ----------------- FLUSH & FREE BUF ----------------- */
     FSBuf_Flush(p_buf, p_err);
     FSBuf_Free(p_buf);
 
+                                                                /* ---------- REPORT REPLAY COST (see Note #5) -------- */
+#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
+    p_fat_data->JournalReplayInfo.SecRdCnt = p_vol->StatRdSecCtr - rd_cnt;
+    p_fat_data->JournalReplayInfo.SecWrCnt = p_vol->StatWrSecCtr - wr_cnt;
+#endif
+    if (ts_valid == DEF_YES) {
+        ts_end   = 0u;
+        ts_valid = Clk_GetTS(&ts_end);
+        if ((ts_valid == DEF_YES) && (ts_end >= ts_start)) {
+            p_fat_data->JournalReplayInfo.Dur_sec = ts_end - ts_start;
+        }
+    }
+    FS_TRACE_INFO(("FS_FAT_JournalReplay(): %u log(s) replayed, %u clus(s) free'd, %u sec(s) rd, %u sec(s) wr'n, %u s.\r\n",
+                   (unsigned int)p_fat_data->JournalReplayInfo.LogCnt,
+                   (unsigned int)p_fat_data->JournalReplayInfo.ClusFreeCnt,
+                   (unsigned int)p_fat_data->JournalReplayInfo.SecRdCnt,
+                   (unsigned int)p_fat_data->JournalReplayInfo.SecWrCnt,
+                   (unsigned int)p_fat_data->JournalReplayInfo.Dur_sec));
+
+#if (FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED)
+    if (*p_err == FS_ERR_NONE) {                                /* Vol consistent (see Note #6).                        */
+        p_fat_data->VolChkReqd = DEF_NO;
+    }
+#endif
+
                                                                 /* ------------------- REPLAY DONE -------------------- */
     DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_REPLAY);
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FS_FAT_JournalSecScan()
+*
+* Description : Scan journal sector headers to find the journal head & tail.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+*               p_buf       Pointer to temporary buffer.
+*
+*               p_head_pos  Pointer to variable that will receive the journal position of the head sector.
+*
+*               p_tail_pos  Pointer to variable that will receive the journal position of the tail sector.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                        Journal sectors scanned.
+*
+*                               --------------RETURNED BY FS_FAT_JournalSecGet()-----------
+*                               See FS_FAT_JournalSecGet() for additional return error codes.
+*
+*                               ------------RETURNED BY FS_FAT_JournalSecNextGet()---------
+*                               See FS_FAT_JournalSecNextGet() for additional return error codes.
+*
+* Return(s)   : DEF_YES, if a journal sector was ever written.
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) The head is the sector holding the highest journal position (see 'FS_FAT_JournalWr()
+*                   Note #1').  The tail is the oldest sector such that it & all sectors up to the head
+*                   were written in the same pass, i.e., hold consecutive journal positions.
+*
+*               (2) A sector header is valid only if the journal position it holds maps to the sector
+*                   itself.  Sectors never written, as well as an old-format journal, hold no valid header.
+*
+*               (3) Journal positions are compared modulo 2^32.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_FAT_JournalSecScan (FS_VOL            *p_vol,
+                                            FS_BUF            *p_buf,
+                                            FS_FAT_FILE_SIZE  *p_head_pos,
+                                            FS_FAT_FILE_SIZE  *p_tail_pos,
+                                            FS_ERR            *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    CPU_INT08U        *p_data;
+    FS_FAT_SEC_NBR     sec;
+    FS_FAT_SEC_NBR     sec_cnt;
+    FS_FAT_SEC_NBR     sec_ix;
+    FS_FAT_SEC_NBR     head_ix;
+    FS_FAT_SEC_NBR     tail_cnt;
+    FS_FAT_SEC_NBR     dist;
+    FS_FAT_FILE_SIZE   head_pos;
+    FS_FAT_FILE_SIZE   pos;
+    CPU_INT16U         mark;
+    CPU_INT08U         pass;
+    CPU_BOOLEAN        head_found;
+    CPU_BOOLEAN        valid;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    sec_cnt    =  FS_UTIL_DIV_PWR2(FS_FAT_JOURNAL_FILE_LEN, p_fat_data->SecSizeLog2);
+
+    head_found = DEF_NO;
+    head_pos   = 0u;
+    head_ix    = 0u;
+    tail_cnt   = sec_cnt;
+                                                                /* Pass 0 finds head, pass 1 finds tail.                */
+    for (pass = 0u; (pass < 2u) && (head_found == DEF_YES || pass == 0u); pass++) {
+        sec = FS_FAT_JournalSecFirstGet(p_fat_data);
+        for (sec_ix = 0u; sec_ix < sec_cnt; sec_ix++) {
+                                                                /* ------------------ RD SEC HEADER ------------------- */
+            p_data = FS_FAT_JournalSecGet(p_vol,
+                                          p_buf,
+                                          sec,
+                                          p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return (DEF_NO);
+            }
+            mark  = MEM_VAL_GET_INT16U_LITTLE(p_data + FS_FAT_JOURNAL_SEC_HDR_MARK_OFFSET);
+            pos   = MEM_VAL_GET_INT32U_LITTLE(p_data + FS_FAT_JOURNAL_SEC_HDR_POS_OFFSET);
+            valid = DEF_NO;                                     /* See Note #2.                                         */
+            if ((mark == FS_FAT_JOURNAL_MARK_SEC) &&
+                ((pos & (FS_FAT_JOURNAL_FILE_LEN - 1u)) == ((FS_FAT_FILE_SIZE)sec_ix << p_fat_data->SecSizeLog2))) {
+                valid = DEF_YES;
+            }
+
+            if (pass == 0u) {                                   /* ------------------- FIND HEAD -------------------- */
+                if ((valid == DEF_YES) &&
+                   ((head_found == DEF_NO) || ((CPU_INT32S)(pos - head_pos) > 0))) {    /* See Note #3.         */
+                    head_found = DEF_YES;
+                    head_pos   = pos;
+                    head_ix    = sec_ix;
+                }
+            } else {                                            /* ------------------- FIND TAIL -------------------- */
+                dist = (head_ix + sec_cnt - sec_ix) & (sec_cnt - 1u);
+                if ((valid == DEF_NO) ||
+                    (pos   != head_pos - ((FS_FAT_FILE_SIZE)dist << p_fat_data->SecSizeLog2))) {
+                    if (dist < tail_cnt) {                      /* Sec not wr'n in head's pass (see Note #1).           */
+                        tail_cnt = dist;
+                    }
+                }
+            }
+
+            if (sec_ix + 1u < sec_cnt) {                        /* Get next sec.                                        */
+                sec = FS_FAT_JournalSecNextGet(p_vol,
+                                               p_buf,
+                                               sec,
+                                              (FS_FAT_FILE_SIZE)(sec_ix + 1u) << p_fat_data->SecSizeLog2,
+                                               p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    return (DEF_NO);
+                }
+            }
+        }
+    }
+
+   *p_head_pos = head_pos;
+   *p_tail_pos = head_pos - ((FS_FAT_FILE_SIZE)(tail_cnt - 1u) << p_fat_data->SecSizeLog2);
+   *p_err      = FS_ERR_NONE;
+    return (head_found);
+}
+
+
 /*
 *********************************************************************************************************
 *                                 FS_FAT_JournalRevertClusChainAlloc()
@@ -2749,13 +4640,14 @@ static  void  FS_FAT_JournalReplayClusChainDel (FS_VOL  *p_vol,
 #endif
 
                                                                 /* ------------ COMPUTE ENTER END MARK POS ------------ */
-    end_mark_pos = p_journal_data->FilePos + nbr_marker *
-                  (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT32 ? 4u : 2u);
+    end_mark_pos = FS_FAT_JournalPosAdv(p_fat_data,
+                                        p_journal_data->FilePos,
+                                        nbr_marker * (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT32 ? 4u : 2u));
 
 
                                                                 /* ---- CHK ENTER END MARK LOCATION (see Note #2) ----- */
 #if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
-    if (end_mark_pos > p_journal_data->FileSize) {
+    if ((end_mark_pos - p_journal_data->FilePos) > FS_FAT_JOURNAL_FILE_LEN) {
        *p_err = FS_ERR_VOL_JOURNAL_LOG_INVALID_ARG;             /* End mark pos is invalid.                             */
         return;
     }
@@ -2779,7 +4671,7 @@ static  void  FS_FAT_JournalReplayClusChainDel (FS_VOL  *p_vol,
 
                                                                 /* ------------- FIND FIRST VALID MARKER -------------- */
    valid_marker_found = DEF_NO;
-   while ((p_journal_data->FilePos < end_mark_pos) &&
+   while (((CPU_INT32S)(end_mark_pos - p_journal_data->FilePos) > 0) &&
           (valid_marker_found == DEF_NO)) {
 
        if (p_fat_data->FAT_Type == FS_FAT_FAT_TYPE_FAT12) {
@@ -2873,11 +4765,196 @@ static  void  FS_FAT_JournalReplayClusChainDel (FS_VOL  *p_vol,
    }
 
    del = (first_clus == start_clus) ? del_first : DEF_YES;      /* ... and del.                                         */
-   (void)FS_FAT_ClusChainDel(p_vol,
-                             p_buf,
-                             first_clus,
-                             del,
-                             p_err);
+   p_fat_data->JournalReplayInfo.ClusFreeCnt += FS_FAT_ClusChainDel(p_vol,
+                                                                    p_buf,
+                                                                    first_clus,
+                                                                    del,
+                                                                    p_err);
+}
+
+
+/*
+*********************************************************************************************************
+*                                  FS_FAT_JournalReplayClusRangeDel()
+*
+* Description : Complete cluster chain deletion based on a cluster range deletion log.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_buf   Pointer to temporary buffer.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE                           Cluster chain deletion completed.
+*                           FS_ERR_VOL_JOURNAL_LOG_INVALID_ARG    Invalid log argument.
+*
+*                           -------------RETURNED BY p_fat_data->FAT_TypeAPI_Ptr->ClusValRd()-------------
+*                           See p_fat_data->FAT_TypeAPI_Ptr->ClusValRd() for additional return error codes.
+*
+*                           -------------RETURNED BY p_fat_data->FAT_TypeAPI_Ptr->ClusValWr()-------------
+*                           See p_fat_data->FAT_TypeAPI_Ptr->ClusValWr() for additional return error codes.
+*
+*                           ---------------------------RETURNED BY FSVol_ReleaseLocked()------------------
+*                           See FSVol_ReleaseLocked() for additional return error codes.
+*
+*                           -----------------------RETURNED BY FS_FAT_JournalRd()--------------------------
+*                           See FS_FAT_JournalRd() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Enter mark & signature are validated by FS_FAT_JournalReplay().  This function is
+*                   called only if the corresponding journal log is complete.
+*
+*               (2) The range count & cluster ranges are always validated, since they bound the log read
+*                   into the local buffer & the FAT entries written.
+*
+*               (3) The deletion is redone over the logged ranges : each FAT entry not yet freed is freed,
+*                   except the start cluster, which is marked as end of cluster chain if it is preserved.
+*                   Entries already holding their final value are left untouched, so the deletion may be
+*                   replayed several times.  Consecutive entries share FAT sectors, which are thus written
+*                   once for many entries, & no cluster chain is followed.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_JournalReplayClusRangeDel (FS_VOL  *p_vol,
+                                                FS_BUF  *p_buf,
+                                                FS_ERR  *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    CPU_INT08U       *p_range;
+    CPU_BOOLEAN       del_first;
+    FS_FAT_CLUS_NBR   start_clus;
+    FS_FAT_CLUS_NBR   first_clus;
+    FS_FAT_CLUS_NBR   clus_cnt;
+    FS_FAT_CLUS_NBR   cur_clus;
+    FS_FAT_CLUS_NBR   fat_entry;
+    FS_FAT_CLUS_NBR   new_fat_entry;
+    CPU_INT16U        nbr_range;
+    CPU_INT16U        range_ix;
+    CPU_INT16U        mark;
+    CPU_SIZE_T        log_size;
+    CPU_INT08U        log[FS_FAT_JOURNAL_LOG_CLUS_RANGE_DEL_MAX_SIZE];
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+                                                                /* ------------------ PARSE LOG ARGS ------------------ */
+    FS_FAT_JournalRd(p_vol,
+                     p_buf,
+                    &log[0],
+                     FS_FAT_JOURNAL_LOG_CLUS_RANGE_DEL_HEADER_SIZE,
+                     p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+                                                                /* Ignore enter mark & sig (see Note #1).               */
+    start_clus = (FS_FAT_CLUS_NBR)MEM_VAL_GET_INT32U_LITTLE((void *)&log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_START_CLUS_OFFSET]);
+    del_first  = (CPU_BOOLEAN    )MEM_VAL_GET_INT08U_LITTLE((void *)&log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_DEL_FIRST_OFFSET]);
+    nbr_range  = (CPU_INT16U     )MEM_VAL_GET_INT16U_LITTLE((void *)&log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_NBR_RANGE_OFFSET]);
+
+                                                                /* ---------- VALIDATE LOG ARGS (see Note #2) --------- */
+    if ((nbr_range == 0u) ||
+        (nbr_range >  FS_FAT_JOURNAL_MAX_DEL_RANGE_NBR)) {
+       *p_err = FS_ERR_VOL_JOURNAL_LOG_INVALID_ARG;
+        return;
+    }
+
+#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
+    if (FS_FAT_IS_VALID_CLUS(p_fat_data, start_clus) == DEF_NO) {
+       *p_err = FS_ERR_VOL_JOURNAL_LOG_INVALID_ARG;
+        return;
+    }
+
+    if ((del_first != DEF_YES) && (del_first != DEF_NO)) {
+       *p_err = FS_ERR_VOL_JOURNAL_LOG_INVALID_ARG;
+        return;
+    }
+#endif
+
+                                                                /* ------------ RD CLUS RANGES & END MARK ------------- */
+    log_size = (CPU_SIZE_T)nbr_range * FS_FAT_JOURNAL_LOG_CLUS_RANGE_SIZE;
+    FS_FAT_JournalRd(p_vol,
+                     p_buf,
+                    &log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_RANGE_START_OFFSET],
+                     log_size + FS_FAT_JOURNAL_LOG_MARK_SIZE,
+                     p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    mark = MEM_VAL_GET_INT16U_LITTLE((void *)&log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_RANGE_START_OFFSET + log_size]);
+    if (mark != FS_FAT_JOURNAL_MARK_ENTER_END) {                /* If no end mark where one is expected ...             */
+       *p_err = FS_ERR_VOL_JOURNAL_LOG_INVALID_ARG;             /* ... rtn err.                                         */
+        return;
+    }
+
+
+                                                                /* --------- REDO DEL OF RANGES (see Note #3) --------- */
+    p_range = &log[FS_FAT_JOURNAL_CLUS_RANGE_DEL_LOG_RANGE_START_OFFSET];
+    for (range_ix = 0u; range_ix < nbr_range; range_ix++) {
+        first_clus = (FS_FAT_CLUS_NBR)MEM_VAL_GET_INT32U_LITTLE((void *)&p_range[FS_FAT_JOURNAL_CLUS_RANGE_FIRST_CLUS_OFFSET]);
+        clus_cnt   = (FS_FAT_CLUS_NBR)MEM_VAL_GET_INT32U_LITTLE((void *)&p_range[FS_FAT_JOURNAL_CLUS_RANGE_CLUS_CNT_OFFSET]);
+        p_range   +=  FS_FAT_JOURNAL_LOG_CLUS_RANGE_SIZE;
+
+        if ((FS_FAT_IS_VALID_CLUS(p_fat_data, first_clus) == DEF_NO) ||
+            (clus_cnt == 0u) ||
+            (clus_cnt >  p_fat_data->MaxClusNbr - first_clus)) {
+           *p_err = FS_ERR_VOL_JOURNAL_LOG_INVALID_ARG;         /* Range exceeds FAT (see Note #2).                     */
+            return;
+        }
+
+        for (cur_clus = first_clus; cur_clus < first_clus + clus_cnt; cur_clus++) {
+            fat_entry = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol,
+                                                               p_buf,
+                                                               cur_clus,
+                                                               p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+
+            if ((cur_clus  == start_clus) &&                    /* If start clus must be preserved ...                  */
+                (del_first == DEF_NO)) {
+                if (fat_entry >= p_fat_data->FAT_TypeAPI_Ptr->ClusEOF) {
+                    continue;                                   /* ... & already mark'd as EOC, nothing to do.          */
+                }
+                new_fat_entry = p_fat_data->FAT_TypeAPI_Ptr->ClusEOF;
+            } else {
+                if (fat_entry == p_fat_data->FAT_TypeAPI_Ptr->ClusFree) {
+                    continue;                                   /* Clus already free'd.                                 */
+                }
+                new_fat_entry = p_fat_data->FAT_TypeAPI_Ptr->ClusFree;
+                if (p_fat_data->QueryInfoValid == DEF_YES) {
+                    p_fat_data->QueryFreeClusCnt++;
+                }
+                FS_CTR_STAT_INC(p_fat_data->StatFreeClusCtr);
+                p_fat_data->JournalReplayInfo.ClusFreeCnt++;
+            }
+
+            p_fat_data->FAT_TypeAPI_Ptr->ClusValWr(p_vol,
+                                                   p_buf,
+                                                   cur_clus,
+                                                   new_fat_entry,
+                                                   p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+        }
+
+        if ((first_clus == start_clus) &&                       /* Release range data secs, except preserved start clus.*/
+            (del_first  == DEF_NO)) {
+            first_clus++;
+            clus_cnt--;
+        }
+        if (clus_cnt != 0u) {
+            FSVol_ReleaseLocked(p_vol,
+                                FS_FAT_CLUS_TO_SEC(p_fat_data, first_clus),
+                                clus_cnt * p_fat_data->ClusSize_sec,
+                                p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+        }
+    }
 }
 
 
@@ -69,6 +69,7 @@
 #include  <cpu.h>
 #include  "../Source/fs_cfg_fs.h"
 #include  "../Source/fs_err.h"
+#include  "fs_fat.h"
 #include  "fs_fat_type.h"
 
 
@@ -109,6 +110,13 @@
 void             FS_FAT_JournalOpen               (CPU_CHAR              *name_vol,     /* Open  journal.               */
                                                    FS_ERR                *p_err);
 
+#if (FS_FAT_CFG_JOURNAL_DEV_EN == DEF_ENABLED)
+void             FS_FAT_JournalOpenDev            (CPU_CHAR              *name_vol,     /* Open  journal on other dev.  */
+                                                   CPU_CHAR              *name_dev,
+                                                   FS_SEC_NBR             start,
+                                                   FS_ERR                *p_err);
+#endif
+
 void             FS_FAT_JournalClose              (CPU_CHAR              *name_vol,     /* Close journal.               */
                                                    FS_ERR                *p_err);
 
@@ -119,6 +127,23 @@ void             FS_FAT_JournalStart              (CPU_CHAR              *name_v
 void             FS_FAT_JournalStop               (CPU_CHAR              *name_vol,     /* Stop  journaling.            */
                                                    FS_ERR                *p_err);
 
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+void             FS_FAT_JournalTxBegin            (CPU_CHAR              *name_vol,     /* Begin  journal tx.           */
+                                                   FS_ERR                *p_err);
+
+void             FS_FAT_JournalTxCommit           (CPU_CHAR              *name_vol,     /* Commit journal tx.           */
+                                                   FS_ERR                *p_err);
+
+void             FS_FAT_JournalTxWindowSet        (CPU_CHAR              *name_vol,     /* Set journal tx window.       */
+                                                   CPU_INT32U             interval_sec,
+                                                   CPU_SIZE_T             size,
+                                                   FS_ERR                *p_err);
+#endif
+
+void             FS_FAT_JournalReplayInfoGet      (CPU_CHAR                    *name_vol, /* Get journal replay info.   */
+                                                   FS_FAT_JOURNAL_REPLAY_INFO  *p_info,
+                                                   FS_ERR                      *p_err);
+
 /*
 *********************************************************************************************************
 *                                    INTERNAL FUNCTION PROTOTYPES
@@ -136,19 +161,21 @@ void             FS_FAT_JournalInit               (FS_VOL                *p_vol,
 void             FS_FAT_JournalExit               (FS_VOL                *p_vol,        /* Exit journal.                */
                                                    FS_ERR                *p_err);
 
-void             FS_FAT_JournalClr                (FS_VOL                *p_vol,        /* Clr  journal.                */
+void             FS_FAT_JournalClrReset           (FS_VOL                *p_vol,        /* Checkpoint journal.          */
                                                    FS_BUF                *p_buf,
-                                                   FS_FAT_FILE_SIZE       start_pos,
-                                                   FS_FAT_FILE_SIZE       len,
                                                    FS_ERR                *p_err);
 
-void             FS_FAT_JournalClrAllReset        (FS_VOL                *p_vol,        /* Clr  journal entirely.       */
-                                                   FS_BUF                *p_buf,
+#if (FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED)
+void             FS_FAT_JournalTxFlush            (FS_VOL                *p_vol,        /* Commit pending journal tx.   */
                                                    FS_ERR                *p_err);
+#endif
 
-void             FS_FAT_JournalClrReset           (FS_VOL                *p_vol,        /* Clr  journal up to cur pos.  */
-                                                   FS_BUF                *p_buf,
+CPU_BOOLEAN      FS_FAT_JournalCkptDue            (FS_VOL                *p_vol);       /* Chk if journal half used.    */
+
+#if (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+void             FS_FAT_JournalStageFlush         (FS_VOL                *p_vol,        /* Wr staged journal sec.       */
                                                    FS_ERR                *p_err);
+#endif
 
                                                                                         /* ------- JOURNAL LOGS ------- */
 void             FS_FAT_JournalEnterClusChainAlloc(FS_VOL                *p_vol,        /* Enter clus chain alloc log.  */
@@ -47,6 +47,7 @@
 #include  "../Source/fs_buf.h"
 #include  "../Source/fs_cfg_fs.h"
 #include  "../Source/fs_unicode.h"
+#include  "../Source/fs_util.h"
 #include  "../Source/fs_vol.h"
 #include  "fs_fat.h"
 #include  "fs_fat_journal.h"
@@ -274,6 +275,15 @@ static  CPU_INT32S         FS_FAT_LFN_StrCmpIgnoreCase_N      (CPU_CHAR
                                                                FS_FAT_LFN_CHAR        *p2_str,
                                                                FS_FILE_NAME_LEN        len_max);
 
+static  FS_FILE_NAME_LEN   FS_FAT_LFN_StrCmpIgnoreCaseASCII_N (CPU_CHAR               *p1_str,
+                                                               FS_FAT_LFN_CHAR        *p2_str,
+                                                               FS_FILE_NAME_LEN        len_max);
+
+#if (FS_CFG_UTF8_EN == DEF_ENABLED)
+static  CPU_SIZE_T         FS_FAT_LFN_CharDecode              (CPU_WCHAR              *p_char,
+                                                               CPU_CHAR               *p_str);
+#endif
+
 #if (FS_FAT_CFG_VOL_CHK_EN == DEF_ENABLED)                                              /* Check dir entries.           */
 static  CPU_INT08U         FS_FAT_LFN_DirEntriesChk           (FS_VOL                 *p_vol,
                                                                FS_BUF                 *p_buf,
@@ -1624,9 +1634,8 @@ static  void  FS_FAT_LFN_Chk (CPU_CHAR          *name,
 
                                                                 /* ------------------- CHK INIT CHAR ------------------ */
 #if (FS_CFG_UTF8_EN == DEF_ENABLED)
-    name_char_len = MB_CharToWC(&name_char,
-                                 name,
-                                 MB_MAX_LEN);
+    name_char_len = FS_FAT_LFN_CharDecode(&name_char,
+                                           name);
 
     if (name_char_len > MB_MAX_LEN) {
         name_char = (FS_FAT_LFN_CHAR)ASCII_CHAR_NULL;
@@ -1670,9 +1679,8 @@ static  void  FS_FAT_LFN_Chk (CPU_CHAR          *name,
 #if (FS_CFG_UTF8_EN == DEF_ENABLED)
         name         += name_char_len;
 
-        name_char_len = MB_CharToWC(&name_char,
-                                     name,
-                                     MB_MAX_LEN);
+        name_char_len = FS_FAT_LFN_CharDecode(&name_char,
+                                               name);
 
         if (name_char_len > MB_MAX_LEN) {
             name_char = (FS_FAT_LFN_CHAR)ASCII_CHAR_NULL;
@@ -2541,9 +2549,8 @@ static  FS_FILE_NAME_LEN  FS_FAT_LFN_SFN_Fmt (CPU_CHAR    *name,
     is_done       =  DEF_NO;
     is_legal      =  DEF_YES;
 #if (FS_CFG_UTF8_EN == DEF_ENABLED)
-    name_char_len = MB_CharToWC( &name_char,
-                                  name,
-                                  MB_MAX_LEN);
+    name_char_len = FS_FAT_LFN_CharDecode(&name_char,
+                                           name);
     if (name_char_len > MB_MAX_LEN) {
         name_char = (CPU_WCHAR)ASCII_CHAR_NULL;
     }
@@ -2598,9 +2605,8 @@ static  FS_FILE_NAME_LEN  FS_FAT_LFN_SFN_Fmt (CPU_CHAR    *name,
             } else {
 #if (FS_CFG_UTF8_EN == DEF_ENABLED)
                 name        +=  name_char_len;
-                name_char_len = MB_CharToWC(&name_char,
-                                             name,
-                                             MB_MAX_LEN);
+                name_char_len = FS_FAT_LFN_CharDecode(&name_char,
+                                                       name);
 
                 if (name_char_len > MB_MAX_LEN) {
                     name_char = (CPU_WCHAR)ASCII_CHAR_NULL;
@@ -2628,9 +2634,8 @@ static  FS_FILE_NAME_LEN  FS_FAT_LFN_SFN_Fmt (CPU_CHAR    *name,
         is_done       = DEF_NO;
         is_legal      = DEF_YES;
 #if (FS_CFG_UTF8_EN  == DEF_ENABLED)
-        name_char_len = MB_CharToWC(&name_char,
-                                     p_period,
-                                     MB_MAX_LEN);
+        name_char_len = FS_FAT_LFN_CharDecode(&name_char,
+                                               p_period);
         if ((name_char_len == (CPU_SIZE_T)-2) ||
             (name_char_len == (CPU_SIZE_T)-1)) {
             name_char = (CPU_WCHAR)ASCII_CHAR_NULL;
@@ -2681,9 +2686,8 @@ static  FS_FILE_NAME_LEN  FS_FAT_LFN_SFN_Fmt (CPU_CHAR    *name,
                 } else {
 #if (FS_CFG_UTF8_EN == DEF_ENABLED)
                     p_period     += name_char_len;
-                    name_char_len = MB_CharToWC(&name_char,
-                                                 p_period,
-                                                 MB_MAX_LEN);
+                    name_char_len = FS_FAT_LFN_CharDecode(&name_char,
+                                                           p_period);
 
                     if ((name_char_len == (CPU_SIZE_T)-2) ||
                         (name_char_len == (CPU_SIZE_T)-1)) {
@@ -3184,7 +3188,12 @@ static  FS_FILE_NAME_LEN  FS_FAT_LFN_StrLen_N (FS_FAT_LFN_CHAR   *p_str,
 *
 *               Positive value, if 'p1_str' is greater than 'p2_str'.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The leading run of ASCII characters common to both strings is compared word-at-a-time
+*                   (see 'FS_FAT_LFN_StrCmpIgnoreCaseASCII_N()').  The remainder of the strings, if any,
+*                   is compared character per character, falling back to the case folding table for
+*                   non-ASCII characters.
+*
+*               (2) Both strings MUST be readable for 'len_max' characters.
 *********************************************************************************************************
 */
 
@@ -3200,10 +3209,17 @@ static  CPU_INT32S  FS_FAT_LFN_StrCmpIgnoreCase_N (CPU_CHAR          *p1_str,
     CPU_SIZE_T  char_len;
 
 
-    cmp_len  = 0u;
-    char_len = MB_CharToWC(&char1,
-                            p1_str,
-                            MB_MAX_LEN);
+    cmp_len  = FS_FAT_LFN_StrCmpIgnoreCaseASCII_N(p1_str,       /* Cmp leading ASCII chars (see Note #1).               */
+                                                  p2_str,
+                                                  len_max);
+    if (cmp_len == len_max) {
+        return ((CPU_INT32S)0);
+    }
+    p1_str  += cmp_len;                                         /* ASCII chars are single-octet in UTF-8.               */
+    p2_str  += cmp_len;
+
+    char_len = FS_FAT_LFN_CharDecode(&char1,
+                                      p1_str);
     if (char_len <= MB_MAX_LEN) {
         char1 = WC_CharToCasefold(char1);
     }
@@ -3219,9 +3235,8 @@ static  CPU_INT32S  FS_FAT_LFN_StrCmpIgnoreCase_N (CPU_CHAR          *p1_str,
         p2_str++;
         cmp_len++;
 
-        char_len = MB_CharToWC(&char1,
-                                p1_str,
-                                MB_MAX_LEN);
+        char_len = FS_FAT_LFN_CharDecode(&char1,
+                                          p1_str);
         if (char_len <= MB_MAX_LEN) {
             char1 = WC_CharToCasefold(char1);
         }
@@ -3251,15 +3266,136 @@ static  CPU_INT32S  FS_FAT_LFN_StrCmpIgnoreCase_N (CPU_CHAR          *p1_str,
 
     return (cmp_val);
 #else
-    CPU_INT16S  cmp_val;
+    CPU_INT16S        cmp_val;
+    FS_FILE_NAME_LEN  cmp_len;
+
 
+    cmp_len = FS_FAT_LFN_StrCmpIgnoreCaseASCII_N(p1_str,        /* Cmp leading ASCII chars (see Note #1).               */
+                                                 p2_str,
+                                                 len_max);
+    if (cmp_len == len_max) {
+        return ((CPU_INT32S)0);
+    }
 
-    cmp_val = Str_CmpIgnoreCase_N(p1_str, p2_str, (CPU_SIZE_T)len_max);
+    cmp_val = Str_CmpIgnoreCase_N(p1_str  + cmp_len,
+                                  p2_str  + cmp_len,
+                                  (CPU_SIZE_T)(len_max - cmp_len));
     return ((CPU_INT32S)cmp_val);
 #endif
 }
 
 
+/*
+*********************************************************************************************************
+*                                FS_FAT_LFN_StrCmpIgnoreCaseASCII_N()
+*
+* Description : Compare the leading ASCII characters of two strings word-at-a-time, ignoring case.
+*
+* Argument(s) : p1_str      Pointer to first  string.
+*
+*               p2_str      Pointer to second string (possibly a wide-character string).
+*
+*               len_max     Maximum number of characters to compare.
+*
+* Return(s)   : Number of leading characters known to be identical, ignoring case; always a multiple of
+*               the CPU word size, or 'len_max'.
+*
+* Note(s)     : (1) Characters are packed into a 'CPU_DATA' word, one character per octet lane, then
+*                   compared with 'FS_UTIL_WORD_TO_LOWER()'.  Packing is done octet per octet, so neither
+*                   string needs to be aligned.  Each character is checked as it is packed & packing stops
+*                   at the first NULL character, so no character is read past the terminating NULL
+*                   character of either string.
+*
+*               (2) The comparison stops at the first word holding a non-ASCII character, a NULL character
+*                   or a mismatch.  The caller MUST compare the remaining characters, starting at the
+*                   returned offset, to get the exact comparison result.
+*
+*               (3) Since 'p1_str' holds ASCII characters up to the returned offset, that offset is both a
+*                   character count & an octet count in 'p1_str', even if 'p1_str' is a UTF-8 string.
+*********************************************************************************************************
+*/
+
+static  FS_FILE_NAME_LEN  FS_FAT_LFN_StrCmpIgnoreCaseASCII_N (CPU_CHAR          *p1_str,
+                                                              FS_FAT_LFN_CHAR   *p2_str,
+                                                              FS_FILE_NAME_LEN   len_max)
+{
+    CPU_INT32U        char1;
+    CPU_INT32U        char2;
+    FS_FILE_NAME_LEN  cmp_len;
+    CPU_SIZE_T        ix;
+    CPU_DATA          word1;
+    CPU_DATA          word2;
+
+
+    cmp_len = 0u;
+    while ((FS_FILE_NAME_LEN)(len_max - cmp_len) >= FS_UTIL_WORD_NBR_OCTETS) {
+        word1 = 0u;
+        word2 = 0u;
+        for (ix = 0u; ix < FS_UTIL_WORD_NBR_OCTETS; ix++) {     /* Pack chars in word (see Note #1).                    */
+            char1 = (CPU_INT32U)(CPU_INT08U)p1_str[ix];
+            char2 = (CPU_INT32U)p2_str[ix];
+            if ((char1 == (CPU_INT32U)ASCII_CHAR_NULL)   ||     /* NULL or non-ASCII char found (see Note #2).          */
+                (char2 == (CPU_INT32U)ASCII_CHAR_NULL)   ||
+                (char1 >  (CPU_INT32U)ASCII_CHAR_DELETE) ||
+                (char2 >  (CPU_INT32U)ASCII_CHAR_DELETE)) {
+                return (cmp_len);
+            }
+            word1 = (word1 << DEF_OCTET_NBR_BITS) | (CPU_DATA)char1;
+            word2 = (word2 << DEF_OCTET_NBR_BITS) | (CPU_DATA)char2;
+        }
+
+        if (FS_UTIL_WORD_TO_LOWER(word1) != FS_UTIL_WORD_TO_LOWER(word2)) {
+            return (cmp_len);                                   /* Mismatch found.                                      */
+        }
+
+        p1_str  += FS_UTIL_WORD_NBR_OCTETS;
+        p2_str  += FS_UTIL_WORD_NBR_OCTETS;
+        cmp_len += FS_UTIL_WORD_NBR_OCTETS;
+    }
+
+    return (cmp_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_LFN_CharDecode()
+*
+* Description : Decode next character of a UTF-8 file name.
+*
+* Argument(s) : p_char      Pointer to variable that will receive the decoded character.
+*
+*               p_str       Pointer to UTF-8 string.
+*
+* Return(s)   : Number of octets consumed, as returned by 'MB_CharToWC()'.
+*
+* Note(s)     : (1) File names are predominantly ASCII; single-octet characters are decoded directly & only
+*                   multi-octet sequences are decoded & validated by 'MB_CharToWC()'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_UTF8_EN == DEF_ENABLED)
+static  CPU_SIZE_T  FS_FAT_LFN_CharDecode (CPU_WCHAR  *p_char,
+                                           CPU_CHAR   *p_str)
+{
+    CPU_SIZE_T  char_len;
+
+
+    if ((CPU_INT08U)*p_str <= (CPU_INT08U)ASCII_CHAR_DELETE) {  /* Decode ASCII char (see Note #1).                     */
+       *p_char = (CPU_WCHAR)*p_str;
+        if (*p_str == (CPU_CHAR)ASCII_CHAR_NULL) {
+            return (0u);
+        }
+        return (1u);
+    }
+
+    char_len = MB_CharToWC(p_char,
+                           p_str,
+                           MB_MAX_LEN);
+    return (char_len);
+}
+#endif
+
 /*
 *********************************************************************************************************
 *                                     FS_FAT_LFN_DirEntriesChk()
@@ -130,9 +130,11 @@ void  FS_OS_Init (FS_ERR  *p_err)
 *********************************************************************************************************
 *                                            FS_OS_Lock()
 *
-* Description : Acquire mutually exclusive access to file system suite.
+* Description : Acquire mutually exclusive access to a file system module.
 *
-* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+* Argument(s) : lock_id     Lock ID (see 'fs_dev.h  FILE SYSTEM LOCK DEFINES').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
 *                               FS_ERR_NONE       File system access     acquired.
@@ -147,8 +149,11 @@ void  FS_OS_Init (FS_ERR  *p_err)
 *********************************************************************************************************
 */
 
-void  FS_OS_Lock (FS_ERR  *p_err)
+void  FS_OS_Lock (FS_ID    lock_id,
+                  FS_ERR  *p_err)
 {
+    (void)lock_id;
+
    *p_err = FS_ERR_NONE;
 }
 
@@ -157,9 +162,9 @@ void  FS_OS_Lock (FS_ERR  *p_err)
 *********************************************************************************************************
 *                                           FS_OS_Unlock()
 *
-* Description : Release mutually exclusive access to file system suite.
+* Description : Release mutually exclusive access to a file system module.
 *
-* Argument(s) : none.
+* Argument(s) : lock_id     Lock ID (see 'fs_dev.h  FILE SYSTEM LOCK DEFINES').
 *
 * Return(s)   : none.
 *
@@ -170,9 +175,9 @@ void  FS_OS_Lock (FS_ERR  *p_err)
 *********************************************************************************************************
 */
 
-void  FS_OS_Unlock (void)
+void  FS_OS_Unlock (FS_ID  lock_id)
 {
-
+    (void)lock_id;
 }
 
 
@@ -568,6 +573,120 @@ void  FS_OS_DevAccessUnlock (FS_ID  dev_id)
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FS_OS_DevSharedLock()
+*
+* Description : Acquire shared access to file system device.
+*
+* Argument(s) : dev_id      Index of the device.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       File system device shared access     acquired.
+*                               FS_ERR_OS_LOCK    File system device shared access NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device access MUST be acquired--i.e. MUST wait for access; do NOT timeout.
+*
+*               (2) The first task to acquire shared access acquires the device lock on behalf of every
+*                   task holding shared access; the last task to release shared access releases it.
+*                   Tasks holding shared access MUST serialize device I/O with 'FS_OS_DevIO_Lock()'.
+*
+*               (3) When both the access lock & shared access are required the access lock MUST be
+*                   acquired first.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevSharedLock (FS_ID    dev_id,
+                           FS_ERR  *p_err)
+{
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_OS_DevSharedUnlock()
+*
+* Description : Release shared access to file system device.
+*
+* Argument(s) : dev_id      Index of the device.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device access MUST be released--i.e. MUST unlock access without failure.
+*
+*               (2) See 'FS_OS_DevSharedLock()  Note #2'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevSharedUnlock (FS_ID  dev_id)
+{
+
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FS_OS_DevIO_Lock()
+*
+* Description : Acquire mutually exclusive access to device I/O.
+*
+* Argument(s) : dev_id      Index of the semaphore to acquire.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       Device I/O access     acquired.
+*                               FS_ERR_OS_LOCK    Device I/O access NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device I/O access MUST be acquired--i.e. MUST wait for access; do NOT timeout.
+*
+*               (2) Serializes device (& volume cache) accesses of tasks holding shared access to the
+*                   device (see 'FS_OS_DevSharedLock()  Note #2').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevIO_Lock (FS_ID    dev_id,
+                        FS_ERR  *p_err)
+{
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_OS_DevIO_Unlock()
+*
+* Description : Release mutually exclusive access to device I/O.
+*
+* Argument(s) : dev_id      Index of the semaphore to release.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device I/O access MUST be released--i.e. MUST unlock access without failure.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevIO_Unlock (FS_ID  dev_id)
+{
+
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
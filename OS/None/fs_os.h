@@ -111,6 +111,11 @@ CPU_BOOLEAN  FS_OS_SemPost  (FS_OS_SEM  *p_sem);
 #error  "                       [MUST be DEF_DISABLED]              "
 #endif
 
+#if     (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+#error  "FS_CFG_FILE_ASYNC_EN   illegally #define'd in 'fs_cfg.h'   "
+#error  "                       [MUST be DEF_DISABLED]              "
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -107,7 +107,7 @@
 
 void  FS_OS_Init (FS_ERR  *p_err)
 {
-   /* #### Initialize one FS lock. */
+   /* #### Initialize FS_OS_LOCK_CNT FS locks. */
 
    *p_err = FS_ERR_NONE;
 }
@@ -117,9 +117,11 @@ void  FS_OS_Init (FS_ERR  *p_err)
 *********************************************************************************************************
 *                                            FS_OS_Lock()
 *
-* Description : Acquire mutually exclusive access to file system suite.
+* Description : Acquire mutually exclusive access to a file system module.
 *
-* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+* Argument(s) : lock_id     Lock ID (see 'fs_dev.h  FILE SYSTEM LOCK DEFINES').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
 *                               FS_ERR_NONE       File system access     acquired.
@@ -134,9 +136,10 @@ void  FS_OS_Init (FS_ERR  *p_err)
 *********************************************************************************************************
 */
 
-void  FS_OS_Lock (FS_ERR  *p_err)
+void  FS_OS_Lock (FS_ID    lock_id,
+                  FS_ERR  *p_err)
 {
-    /* #### Block until FS lock is acquired. */
+    /* #### Block until FS lock 'lock_id' is acquired. */
 
    *p_err = FS_ERR_NONE;
 }
@@ -146,9 +149,9 @@ void  FS_OS_Lock (FS_ERR  *p_err)
 *********************************************************************************************************
 *                                           FS_OS_Unlock()
 *
-* Description : Release mutually exclusive access to file system suite.
+* Description : Release mutually exclusive access to a file system module.
 *
-* Argument(s) : none.
+* Argument(s) : lock_id     Lock ID (see 'fs_dev.h  FILE SYSTEM LOCK DEFINES').
 *
 * Return(s)   : none.
 *
@@ -159,9 +162,9 @@ void  FS_OS_Lock (FS_ERR  *p_err)
 *********************************************************************************************************
 */
 
-void  FS_OS_Unlock (void)
+void  FS_OS_Unlock (FS_ID  lock_id)
 {
-   (void)OSSemPost(FS_OS_LockSemPtr);                           /* Release file system access.                          */
+    /* #### Release FS lock 'lock_id'. */
 }
 
 
@@ -495,6 +498,125 @@ void  FS_OS_DevAccessUnlock (FS_ID  dev_id)
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FS_OS_DevSharedLock()
+*
+* Description : Acquire shared access to file system device.
+*
+* Argument(s) : dev_id      Index of the device.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       File system device shared access     acquired.
+*                               FS_ERR_OS_LOCK    File system device shared access NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device access MUST be acquired--i.e. MUST wait for access; do NOT timeout.
+*
+*               (2) The first task to acquire shared access acquires the device lock on behalf of every
+*                   task holding shared access; the last task to release shared access releases it.
+*                   Tasks holding shared access MUST serialize device I/O with 'FS_OS_DevIO_Lock()'.
+*
+*               (3) When both the access lock & shared access are required the access lock MUST be
+*                   acquired first.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevSharedLock (FS_ID    dev_id,
+                           FS_ERR  *p_err)
+{
+    /* #### Block until shared access to device 'dev_id' is acquired (see Note #2). */
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_OS_DevSharedUnlock()
+*
+* Description : Release shared access to file system device.
+*
+* Argument(s) : dev_id      Index of the device.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device access MUST be released--i.e. MUST unlock access without failure.
+*
+*               (2) See 'FS_OS_DevSharedLock()  Note #2'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevSharedUnlock (FS_ID  dev_id)
+{
+    /* #### Release shared access to device 'dev_id' (see Note #2). */
+
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FS_OS_DevIO_Lock()
+*
+* Description : Acquire mutually exclusive access to device I/O.
+*
+* Argument(s) : dev_id      Index of the semaphore to acquire.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       Device I/O access     acquired.
+*                               FS_ERR_OS_LOCK    Device I/O access NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device I/O access MUST be acquired--i.e. MUST wait for access; do NOT timeout.
+*
+*               (2) Serializes device (& volume cache) accesses of tasks holding shared access to the
+*                   device (see 'FS_OS_DevSharedLock()  Note #2').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevIO_Lock (FS_ID    dev_id,
+                        FS_ERR  *p_err)
+{
+    /* #### Block until device I/O lock 'dev_id' is acquired. */
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_OS_DevIO_Unlock()
+*
+* Description : Release mutually exclusive access to device I/O.
+*
+* Argument(s) : dev_id      Index of the semaphore to release.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device I/O access MUST be released--i.e. MUST unlock access without failure.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevIO_Unlock (FS_ID  dev_id)
+{
+
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -623,3 +745,204 @@ CPU_BOOLEAN  FS_OS_FileUnlock (FS_ID  file_id)
 }
 #endif
 
+
+/*
+*********************************************************************************************************
+*                                        FS_OS_FileAsyncInit()
+*
+* Description : Create asynchronous file request objects & worker tasks.
+*
+* Argument(s) : req_cnt     Number of requests.
+*
+*               task_cnt    Number of worker tasks to create.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE             Objects & tasks created.
+*                               FS_ERR_MEM_ALLOC        Memory could not be allocated.
+*                               FS_ERR_OS_INIT_LOCK     Semaphore NOT successfully created.
+*                               FS_ERR_OS_INIT_TASK     Worker task NOT successfully created.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncInit (FS_QTY   req_cnt,
+                           FS_QTY   task_cnt,
+                           FS_ERR  *p_err)
+{
+   /* #### Create req queue sem (cnt = req_cnt), rdy sem (cnt = 0) & one sem per req (cnt = 0).  */
+   /* #### Create task_cnt worker tasks, each calling FSFile_AsyncTaskHandler().               */
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FS_OS_FileAsyncQueuePend()
+*
+* Description : Wait for a free asynchronous file request.
+*
+* Argument(s) : timeout     If non-zero, timeout period (in milliseconds).
+*                           If zero,     wait forever.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE          Free request reserved.
+*                               FS_ERR_OS_TIMEOUT    No request freed before timeout.
+*                               FS_ERR_OS_LOCK       Semaphore NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncQueuePend (CPU_INT32U   timeout,
+                                FS_ERR      *p_err)
+{
+   /* #### Pend on req queue sem.  */
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FS_OS_FileAsyncQueuePost()
+*
+* Description : Signal a free asynchronous file request.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncQueuePost (void)
+{
+   /* #### Post req queue sem.  */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncTaskPend()
+*
+* Description : Wait for a file with asynchronous requests to service.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       Ready file signaled.
+*                               FS_ERR_OS_LOCK    Semaphore NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Worker tasks wait forever.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncTaskPend (FS_ERR  *p_err)
+{
+   /* #### Pend on rdy sem.  */
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncTaskPost()
+*
+* Description : Signal a file with asynchronous requests to service.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncTaskPost (void)
+{
+   /* #### Post rdy sem.  */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncReqPend()
+*
+* Description : Wait for an asynchronous file request to complete.
+*
+* Argument(s) : req_id      Index of the request.
+*
+*               timeout     If non-zero, timeout period (in milliseconds).
+*                           If zero,     wait forever.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE          Request completed.
+*                               FS_ERR_OS_TIMEOUT    Request NOT completed before timeout.
+*                               FS_ERR_OS_LOCK       Semaphore NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncReqPend (FS_ID        req_id,
+                              CPU_INT32U   timeout,
+                              FS_ERR      *p_err)
+{
+   /* #### Pend on req sem.  */
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncReqPost()
+*
+* Description : Signal the completion of an asynchronous file request.
+*
+* Argument(s) : req_id      Index of the request.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncReqPost (FS_ID  req_id)
+{
+   /* #### Post req sem.  */
+}
+#endif
+
+
@@ -93,11 +93,17 @@
 */
 
                                                                 /* ---------------------- LOCKS ----------------------- */
-static  OS_EVENT    *FS_OS_LockSemPtr;
+static  OS_EVENT    *FS_OS_LockSemTbl[FS_OS_LOCK_CNT];
 
 static  OS_EVENT   **FS_OS_DevLockSemTbl;
 static  OS_EVENT   **FS_OS_DevAccessLockSemTbl;
 
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+static  OS_EVENT   **FS_OS_DevSharedLockSemTbl;
+static  FS_CTR      *FS_OS_DevSharedCntTbl;
+static  OS_EVENT   **FS_OS_DevIO_LockSemTbl;
+#endif
+
 #if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
 static  OS_EVENT   **FS_OS_FileLockSemTbl;
 static  OS_TCB     **FS_OS_FileLockTaskID_Tbl;
@@ -105,6 +111,13 @@ static  FS_CTR      *FS_OS_FileLockCntTbl;
 #endif
 
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)                       /* ----------------- ASYNC FILE REQ'S ----------------- */
+static  OS_EVENT    *FS_OS_FileAsyncQueueSemPtr;
+static  OS_EVENT    *FS_OS_FileAsyncTaskSemPtr;
+static  OS_EVENT   **FS_OS_FileAsyncReqSemTbl;
+#endif
+
+
 #if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
 static  CPU_INT08U   FS_OS_RegIdWorkingDir;
 #endif
@@ -115,6 +128,10 @@ static  CPU_INT08U   FS_OS_RegIdWorkingDir;
 *********************************************************************************************************
 */
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  void  FS_OS_FileAsyncTask(void  *p_arg);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -147,23 +164,26 @@ void  FS_OS_Init (FS_ERR  *p_err)
 #if (OS_EVENT_NAME_EN > 0u || FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
     INT8U  os_err;
 #endif
+    FS_ID  lock_id;
 
 
-    FS_OS_LockSemPtr = OSSemCreate(1u);                         /* Create file system lock.                             */
-    if (FS_OS_LockSemPtr == (OS_EVENT *)0) {
-       *p_err = FS_ERR_OS_INIT_LOCK;
-        return;
-    }
+    for (lock_id = 0u; lock_id < FS_OS_LOCK_CNT; lock_id++) {
+        FS_OS_LockSemTbl[lock_id] = OSSemCreate(1u);            /* Create file system lock.                             */
+        if (FS_OS_LockSemTbl[lock_id] == (OS_EVENT *)0) {
+           *p_err = FS_ERR_OS_INIT_LOCK;
+            return;
+        }
 
 #if (OS_EVENT_NAME_EN > 0u)
-    OSEventNameSet(          FS_OS_LockSemPtr,
-                   (INT8U *) FS_LOCK_NAME,
-                            &os_err);
-    if (os_err != OS_ERR_NONE) {
-       *p_err = FS_ERR_OS_INIT_LOCK_NAME;
-        return;
-    }
+        OSEventNameSet(          FS_OS_LockSemTbl[lock_id],
+                       (INT8U *) FS_LOCK_NAME,
+                                &os_err);
+        if (os_err != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_LOCK_NAME;
+            return;
+        }
 #endif
+    }
 
 
 #if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
@@ -183,9 +203,11 @@ void  FS_OS_Init (FS_ERR  *p_err)
 *********************************************************************************************************
 *                                            FS_OS_Lock()
 *
-* Description : Acquire mutually exclusive access to file system suite.
+* Description : Acquire mutually exclusive access to a file system module.
 *
-* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+* Argument(s) : lock_id     Lock ID (see 'fs_dev.h  FILE SYSTEM LOCK DEFINES').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
 *                               FS_ERR_NONE       File system access     acquired.
@@ -200,12 +222,13 @@ void  FS_OS_Init (FS_ERR  *p_err)
 *********************************************************************************************************
 */
 
-void  FS_OS_Lock (FS_ERR  *p_err)
+void  FS_OS_Lock (FS_ID    lock_id,
+                  FS_ERR  *p_err)
 {
     INT8U  os_err;
 
 
-    OSSemPend( FS_OS_LockSemPtr,                                /* Acquire file system access ...                       */
+    OSSemPend( FS_OS_LockSemTbl[lock_id],                       /* Acquire file system access ...                       */
                0u,                                              /* ... without timeout (see Note #1).                   */
               &os_err);
 
@@ -232,9 +255,9 @@ void  FS_OS_Lock (FS_ERR  *p_err)
 *********************************************************************************************************
 *                                           FS_OS_Unlock()
 *
-* Description : Release mutually exclusive access to file system suite.
+* Description : Release mutually exclusive access to a file system module.
 *
-* Argument(s) : none.
+* Argument(s) : lock_id     Lock ID (see 'fs_dev.h  FILE SYSTEM LOCK DEFINES').
 *
 * Return(s)   : none.
 *
@@ -245,9 +268,9 @@ void  FS_OS_Lock (FS_ERR  *p_err)
 *********************************************************************************************************
 */
 
-void  FS_OS_Unlock (void)
+void  FS_OS_Unlock (FS_ID  lock_id)
 {
-   (void)OSSemPost(FS_OS_LockSemPtr);                           /* Release file system access.                          */
+   (void)OSSemPost(FS_OS_LockSemTbl[lock_id]);                  /* Release file system access.                          */
 }
 
 
@@ -658,6 +681,70 @@ void  FS_OS_DevInit (FS_QTY   dev_cnt,
 #endif
     }
 
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+                                                                /* ------------ CREATE DEVICE SHARED LOCKS ------------ */
+    FS_OS_DevSharedLockSemTbl = (OS_EVENT **)Mem_HeapAlloc( sizeof(OS_EVENT *) * (CPU_SIZE_T)dev_cnt,
+                                                            sizeof(CPU_DATA),
+                                                           &octets_reqd,
+                                                           &lib_err);
+    if (FS_OS_DevSharedLockSemTbl == DEF_NULL) {
+        FS_TRACE_INFO(("FS_OS_DevInit(): Could not alloc mem for dev shared locks: %d octets required.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    FS_OS_DevIO_LockSemTbl = (OS_EVENT **)Mem_HeapAlloc( sizeof(OS_EVENT *) * (CPU_SIZE_T)dev_cnt,
+                                                         sizeof(CPU_DATA),
+                                                        &octets_reqd,
+                                                        &lib_err);
+    if (FS_OS_DevIO_LockSemTbl == DEF_NULL) {
+        FS_TRACE_INFO(("FS_OS_DevInit(): Could not alloc mem for dev I/O locks: %d octets required.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    FS_OS_DevSharedCntTbl = (FS_CTR *)Mem_HeapAlloc( sizeof(FS_CTR) * (CPU_SIZE_T)dev_cnt,
+                                                     sizeof(FS_CTR),
+                                                    &octets_reqd,
+                                                    &lib_err);
+    if (FS_OS_DevSharedCntTbl == DEF_NULL) {
+        FS_TRACE_INFO(("FS_OS_DevInit(): Could not alloc mem for dev shared locks: %d octets required.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    for (ix = 0u; ix < dev_cnt; ix++) {
+        FS_OS_DevSharedCntTbl[ix]     = 0u;
+        FS_OS_DevSharedLockSemTbl[ix] = OSSemCreate(1u);        /* Create device shared lock.                           */
+        FS_OS_DevIO_LockSemTbl[ix]    = OSSemCreate(1u);        /* Create device I/O lock.                              */
+
+        if ((FS_OS_DevSharedLockSemTbl[ix] == DEF_NULL) ||
+            (FS_OS_DevIO_LockSemTbl[ix]    == DEF_NULL)) {
+           *p_err = FS_ERR_OS_INIT_LOCK;
+            return;
+        }
+
+#if (OS_EVENT_NAME_EN > 0u)
+        OSEventNameSet(          FS_OS_DevSharedLockSemTbl[ix],
+                       (INT8U *) FS_DEV_SHARED_LOCK_NAME,
+                                &os_err);
+        if (os_err != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_LOCK_NAME;
+            return;
+        }
+
+        OSEventNameSet(          FS_OS_DevIO_LockSemTbl[ix],
+                       (INT8U *) FS_DEV_IO_LOCK_NAME,
+                                &os_err);
+        if (os_err != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_LOCK_NAME;
+            return;
+        }
+#endif
+    }
+#endif
+
    *p_err = FS_ERR_NONE;
 }
 
@@ -825,6 +912,178 @@ void  FS_OS_DevAccessUnlock (FS_ID  dev_id)
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FS_OS_DevSharedLock()
+*
+* Description : Acquire shared access to file system device.
+*
+* Argument(s) : dev_id      Index of the device.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       File system device shared access     acquired.
+*                               FS_ERR_OS_LOCK    File system device shared access NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device access MUST be acquired--i.e. MUST wait for access; do NOT timeout.
+*
+*               (2) The first task to acquire shared access acquires the device lock on behalf of every
+*                   task holding shared access; the last task to release shared access releases it.
+*                   Tasks holding shared access MUST serialize device I/O with 'FS_OS_DevIO_Lock()'.
+*
+*               (3) When both the access lock & shared access are required the access lock MUST be
+*                   acquired first.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevSharedLock (FS_ID    dev_id,
+                           FS_ERR  *p_err)
+{
+    INT8U  os_err;
+
+
+    OSSemPend( FS_OS_DevSharedLockSemTbl[dev_id],               /* Acquire shared cnt access (see Note #1).             */
+               0u,
+              &os_err);
+    if (os_err != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_DevSharedLock(): Lock failed for dev %d.\r\n", dev_id));
+       *p_err = FS_ERR_OS_LOCK;
+        return;
+    }
+
+   *p_err = FS_ERR_NONE;
+    if (FS_OS_DevSharedCntTbl[dev_id] == 0u) {                  /* First sharer acquires dev lock (see Note #2).        */
+        FS_OS_DevLock(dev_id, p_err);
+    }
+    if (*p_err == FS_ERR_NONE) {
+        FS_OS_DevSharedCntTbl[dev_id]++;
+    }
+
+    (void)OSSemPost(FS_OS_DevSharedLockSemTbl[dev_id]);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_OS_DevSharedUnlock()
+*
+* Description : Release shared access to file system device.
+*
+* Argument(s) : dev_id      Index of the device.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device access MUST be released--i.e. MUST unlock access without failure.
+*
+*               (2) See 'FS_OS_DevSharedLock()  Note #2'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevSharedUnlock (FS_ID  dev_id)
+{
+    INT8U  os_err;
+
+
+    OSSemPend( FS_OS_DevSharedLockSemTbl[dev_id],               /* Acquire shared cnt access (see Note #1).             */
+               0u,
+              &os_err);
+    if (os_err != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_DevSharedUnlock(): Unlock failed for dev %d.\r\n", dev_id));
+        return;
+    }
+
+    FS_OS_DevSharedCntTbl[dev_id]--;
+    if (FS_OS_DevSharedCntTbl[dev_id] == 0u) {                  /* Last sharer releases dev lock (see Note #2).         */
+        FS_OS_DevUnlock(dev_id);
+    }
+
+    (void)OSSemPost(FS_OS_DevSharedLockSemTbl[dev_id]);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FS_OS_DevIO_Lock()
+*
+* Description : Acquire mutually exclusive access to device I/O.
+*
+* Argument(s) : dev_id      Index of the semaphore to acquire.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       Device I/O access     acquired.
+*                               FS_ERR_OS_LOCK    Device I/O access NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device I/O access MUST be acquired--i.e. MUST wait for access; do NOT timeout.
+*
+*               (2) Serializes device (& volume cache) accesses of tasks holding shared access to the
+*                   device (see 'FS_OS_DevSharedLock()  Note #2').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevIO_Lock (FS_ID    dev_id,
+                        FS_ERR  *p_err)
+{
+    INT8U  os_err;
+
+
+    OSSemPend( FS_OS_DevIO_LockSemTbl[dev_id],                  /* Acquire device I/O access without timeout.           */
+               0u,
+              &os_err);
+
+    switch (os_err) {
+        case OS_ERR_NONE:
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+        case OS_ERR_PEVENT_NULL:
+        case OS_ERR_EVENT_TYPE:
+        case OS_ERR_PEND_ISR:
+        case OS_ERR_PEND_ABORT:
+        case OS_ERR_TIMEOUT:
+        default:
+             FS_TRACE_DBG(("FS_OS_DevIO_Lock(): Lock failed for dev %d.\r\n", dev_id));
+            *p_err = FS_ERR_OS_LOCK;
+             break;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_OS_DevIO_Unlock()
+*
+* Description : Release mutually exclusive access to device I/O.
+*
+* Argument(s) : dev_id      Index of the semaphore to release.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device I/O access MUST be released--i.e. MUST unlock access without failure.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevIO_Unlock (FS_ID  dev_id)
+{
+    (void)OSSemPost(FS_OS_DevIO_LockSemTbl[dev_id]);            /* Release device I/O access.                           */
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -1110,3 +1369,429 @@ CPU_BOOLEAN  FS_OS_FileUnlock (FS_ID  file_id)
     return (DEF_NO);
 }
 #endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_OS_FileAsyncInit()
+*
+* Description : Create asynchronous file request objects & worker tasks.
+*
+* Argument(s) : req_cnt     Number of requests.
+*
+*               task_cnt    Number of worker tasks to create.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                 Objects & tasks created.
+*                               FS_ERR_MEM_ALLOC            Memory could not be allocated.
+*                               FS_ERR_OS_INIT_LOCK         Semaphore NOT successfully created.
+*                               FS_ERR_OS_INIT_LOCK_NAME    Semaphore name NOT successfully set.
+*                               FS_ERR_OS_INIT_TASK         Worker task NOT successfully created.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The worker tasks are created with the priority & stack size configured in 'fs_os.h'.
+*
+*               (2) uC/OS-II requires unique task priorities; see 'fs_os.h  FILE ASYNC REQUEST TASK
+*                   CONFIGURATION  Note #3'.
+
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncInit (FS_QTY   req_cnt,
+                           FS_QTY   task_cnt,
+                           FS_ERR  *p_err)
+{
+    INT8U        os_err;
+    FS_QTY       ix;
+    LIB_ERR      lib_err;
+    CPU_SIZE_T   octets_reqd;
+    OS_STK      *p_stk;
+
+
+                                                                /* ------------------ CREATE REQ SEMS ----------------- */
+    FS_OS_FileAsyncQueueSemPtr = OSSemCreate((INT16U)req_cnt);  /* One unit per free req.                               */
+    if (FS_OS_FileAsyncQueueSemPtr == DEF_NULL) {
+       *p_err = FS_ERR_OS_INIT_LOCK;
+        return;
+    }
+
+    FS_OS_FileAsyncTaskSemPtr = OSSemCreate(0u);                /* One unit per rdy file.                               */
+    if (FS_OS_FileAsyncTaskSemPtr == DEF_NULL) {
+       *p_err = FS_ERR_OS_INIT_LOCK;
+        return;
+    }
+
+#if (OS_EVENT_NAME_EN > 0u)
+    OSEventNameSet(          FS_OS_FileAsyncQueueSemPtr,
+                   (INT8U *) FS_FILE_ASYNC_QUEUE_NAME,
+                            &os_err);
+    if (os_err != OS_ERR_NONE) {
+       *p_err = FS_ERR_OS_INIT_LOCK_NAME;
+        return;
+    }
+
+    OSEventNameSet(          FS_OS_FileAsyncTaskSemPtr,
+                   (INT8U *) FS_FILE_ASYNC_RDY_NAME,
+                            &os_err);
+    if (os_err != OS_ERR_NONE) {
+       *p_err = FS_ERR_OS_INIT_LOCK_NAME;
+        return;
+    }
+#endif
+
+    FS_OS_FileAsyncReqSemTbl = (OS_EVENT **)Mem_HeapAlloc( sizeof(OS_EVENT *) * (CPU_SIZE_T)req_cnt,
+                                                           sizeof(CPU_DATA),
+                                                          &octets_reqd,
+                                                          &lib_err);
+    if (FS_OS_FileAsyncReqSemTbl == DEF_NULL) {
+        FS_TRACE_INFO(("FS_OS_FileAsyncInit(): Could not alloc mem for async req sems: %d octets required.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    for (ix = 0u; ix < req_cnt; ix++) {
+        FS_OS_FileAsyncReqSemTbl[ix] = OSSemCreate(0u);
+        if (FS_OS_FileAsyncReqSemTbl[ix] == DEF_NULL) {
+           *p_err = FS_ERR_OS_INIT_LOCK;
+            return;
+        }
+
+#if (OS_EVENT_NAME_EN > 0u)
+        OSEventNameSet(          FS_OS_FileAsyncReqSemTbl[ix],
+                       (INT8U *) FS_FILE_ASYNC_REQ_NAME,
+                                &os_err);
+        if (os_err != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_LOCK_NAME;
+            return;
+        }
+#endif
+    }
+
+
+
+                                                                /* ---------------- CREATE WORKER TASKS --------------- */
+    for (ix = 0u; ix < task_cnt; ix++) {
+        p_stk = (OS_STK *)Mem_HeapAlloc( sizeof(OS_STK) * (CPU_SIZE_T)FS_OS_CFG_FILE_ASYNC_TASK_STK_SIZE,
+                                         sizeof(OS_STK),
+                                        &octets_reqd,
+                                        &lib_err);
+        if (p_stk == DEF_NULL) {
+            FS_TRACE_INFO(("FS_OS_FileAsyncInit(): Could not alloc mem for async task stk: %d octets required.\r\n", octets_reqd));
+           *p_err = FS_ERR_MEM_ALLOC;
+            return;
+        }
+
+                                                                /* Create worker task (see Note #2).                    */
+        os_err = OSTaskCreateExt(          FS_OS_FileAsyncTask,
+                                 (void *)  0,
+#if (OS_STK_GROWTH == 1u)
+                                          &p_stk[FS_OS_CFG_FILE_ASYNC_TASK_STK_SIZE - 1u],
+#else
+                                          &p_stk[0],
+#endif
+                                 (INT8U )( FS_OS_CFG_FILE_ASYNC_TASK_PRIO + ix),
+                                 (INT16U)( FS_OS_CFG_FILE_ASYNC_TASK_PRIO + ix),
+#if (OS_STK_GROWTH == 1u)
+                                          &p_stk[0],
+#else
+                                          &p_stk[FS_OS_CFG_FILE_ASYNC_TASK_STK_SIZE - 1u],
+#endif
+                                 (INT32U)  FS_OS_CFG_FILE_ASYNC_TASK_STK_SIZE,
+                                 (void *)  0,
+                                 (INT16U) (OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR));
+        if (os_err != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_TASK;
+            return;
+        }
+
+#if (OS_TASK_NAME_EN > 0u)
+        OSTaskNameSet((INT8U  ) (FS_OS_CFG_FILE_ASYNC_TASK_PRIO + ix),
+                      (INT8U *)  FS_FILE_ASYNC_TASK_NAME,
+                                &os_err);
+#endif
+    }
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FS_OS_FileAsyncQueuePend()
+*
+* Description : Wait for a free asynchronous file request.
+*
+* Argument(s) : timeout     If non-zero, timeout period (in milliseconds).
+*                           If zero,     wait forever.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE          Free request reserved.
+*                               FS_ERR_OS_TIMEOUT    No request freed before timeout.
+*                               FS_ERR_OS_LOCK       Semaphore NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncQueuePend (CPU_INT32U   timeout,
+                                FS_ERR      *p_err)
+{
+    CPU_INT32U  timeout_ticks;
+    INT8U       os_err;
+
+
+    timeout_ticks = (timeout * OS_TICKS_PER_SEC + (DEF_TIME_NBR_mS_PER_SEC - 1u)) / DEF_TIME_NBR_mS_PER_SEC;
+
+    OSSemPend(FS_OS_FileAsyncQueueSemPtr, (INT32U)timeout_ticks, &os_err);
+
+    switch (os_err) {
+        case OS_ERR_NONE:
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+        case OS_ERR_TIMEOUT:
+            *p_err = FS_ERR_OS_TIMEOUT;
+             break;
+
+
+        case OS_ERR_PEND_ABORT:
+        case OS_ERR_EVENT_TYPE:
+        case OS_ERR_PEND_ISR:
+        case OS_ERR_PEVENT_NULL:
+        case OS_ERR_PEND_LOCKED:
+        default:
+             FS_TRACE_DBG(("FS_OS_FileAsyncQueuePend(): Pend failed.\r\n"));
+            *p_err = FS_ERR_OS_LOCK;
+             break;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FS_OS_FileAsyncQueuePost()
+*
+* Description : Signal a free asynchronous file request.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncQueuePost (void)
+{
+    INT8U  os_err;
+
+
+    os_err = OSSemPost(FS_OS_FileAsyncQueueSemPtr);
+
+    if (os_err != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_FileAsyncQueuePost(): Post failed.\r\n"));
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncTaskPend()
+*
+* Description : Wait for a file with asynchronous requests to service.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       Ready file signaled.
+*                               FS_ERR_OS_LOCK    Semaphore NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Worker tasks wait forever.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncTaskPend (FS_ERR  *p_err)
+{
+    INT8U  os_err;
+
+
+    OSSemPend(FS_OS_FileAsyncTaskSemPtr, 0u, &os_err);         /* See Note #1.                                         */
+
+    if (os_err != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_FileAsyncTaskPend(): Pend failed.\r\n"));
+       *p_err = FS_ERR_OS_LOCK;
+        return;
+    }
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncTaskPost()
+*
+* Description : Signal a file with asynchronous requests to service.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncTaskPost (void)
+{
+    INT8U  os_err;
+
+
+    os_err = OSSemPost(FS_OS_FileAsyncTaskSemPtr);
+
+    if (os_err != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_FileAsyncTaskPost(): Post failed.\r\n"));
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncReqPend()
+*
+* Description : Wait for an asynchronous file request to complete.
+*
+* Argument(s) : req_id      Index of the request.
+*
+*               timeout     If non-zero, timeout period (in milliseconds).
+*                           If zero,     wait forever.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE          Request completed.
+*                               FS_ERR_OS_TIMEOUT    Request NOT completed before timeout.
+*                               FS_ERR_OS_LOCK       Semaphore NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncReqPend (FS_ID        req_id,
+                              CPU_INT32U   timeout,
+                              FS_ERR      *p_err)
+{
+    CPU_INT32U  timeout_ticks;
+    INT8U       os_err;
+
+
+    timeout_ticks = (timeout * OS_TICKS_PER_SEC + (DEF_TIME_NBR_mS_PER_SEC - 1u)) / DEF_TIME_NBR_mS_PER_SEC;
+
+    OSSemPend(FS_OS_FileAsyncReqSemTbl[req_id], (INT32U)timeout_ticks, &os_err);
+
+    switch (os_err) {
+        case OS_ERR_NONE:
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+        case OS_ERR_TIMEOUT:
+            *p_err = FS_ERR_OS_TIMEOUT;
+             break;
+
+
+        case OS_ERR_PEND_ABORT:
+        case OS_ERR_EVENT_TYPE:
+        case OS_ERR_PEND_ISR:
+        case OS_ERR_PEVENT_NULL:
+        case OS_ERR_PEND_LOCKED:
+        default:
+             FS_TRACE_DBG(("FS_OS_FileAsyncReqPend(): Pend failed for req %d.\r\n", req_id));
+            *p_err = FS_ERR_OS_LOCK;
+             break;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncReqPost()
+*
+* Description : Signal the completion of an asynchronous file request.
+*
+* Argument(s) : req_id      Index of the request.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncReqPost (FS_ID  req_id)
+{
+    INT8U  os_err;
+
+
+    os_err = OSSemPost(FS_OS_FileAsyncReqSemTbl[req_id]);
+
+    if (os_err != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_FileAsyncReqPost(): Post failed for req %d.\r\n", req_id));
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        FS_OS_FileAsyncTask()
+*
+* Description : Asynchronous file request worker task.
+*
+* Argument(s) : p_arg       Pointer to task argument (unused).
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) 'FSFile_AsyncTaskHandler()' never returns.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  void  FS_OS_FileAsyncTask (void  *p_arg)
+{
+    (void)p_arg;
+
+    FSFile_AsyncTaskHandler();                                  /* See Note #1.                                         */
+}
+#endif
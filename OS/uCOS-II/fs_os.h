@@ -89,10 +89,42 @@
 */
 
                                                                 /* -------------------- OBJ NAMES --------------------- */
-#define  FS_LOCK_NAME                       "FS Global Lock"
+#define  FS_LOCK_NAME                       "FS Lock"
 #define  FS_DEV_LOCK_NAME                   "FS Device Lock"
 #define  FS_DEV_ACCESS_LOCK_NAME            "FS Device Access Lock"
+#define  FS_DEV_SHARED_LOCK_NAME            "FS Device Shared Lock"
+#define  FS_DEV_IO_LOCK_NAME                "FS Device I/O Lock"
 #define  FS_FILE_LOCK_NAME                  "FS File Lock"
+#define  FS_FILE_ASYNC_QUEUE_NAME           "FS File Async Queue"
+#define  FS_FILE_ASYNC_RDY_NAME             "FS File Async Rdy"
+#define  FS_FILE_ASYNC_REQ_NAME             "FS File Async Req"
+
+                                                                /* -------------------- TASK NAMES -------------------- */
+#define  FS_FILE_ASYNC_TASK_NAME            "FS File Async Task"
+
+
+/*
+*********************************************************************************************************
+*                                FILE ASYNC REQUEST TASK CONFIGURATION
+*
+* Note(s) : (1) The asynchronous file request worker tasks are created only if FS_CFG_FILE_ASYNC_EN is
+*               DEF_ENABLED.  Their priority & stack size may be overridden in 'app_cfg.h' or on the
+*               compiler command line.
+*
+*           (2) The stack size is specified in number of OS_STK elements.
+*
+*           (3) uC/OS-II requires unique task priorities; worker task #n is created at priority
+*               FS_OS_CFG_FILE_ASYNC_TASK_PRIO + n.  The range of priorities MUST be free.
+*********************************************************************************************************
+*/
+
+#ifndef  FS_OS_CFG_FILE_ASYNC_TASK_PRIO
+#define  FS_OS_CFG_FILE_ASYNC_TASK_PRIO                  10u
+#endif
+
+#ifndef  FS_OS_CFG_FILE_ASYNC_TASK_STK_SIZE
+#define  FS_OS_CFG_FILE_ASYNC_TASK_STK_SIZE             512u    /* See Note #2.                                         */
+#endif
 
 
 /*
@@ -88,11 +88,17 @@
 */
 
                                                                 /* ---------------------- LOCKS ----------------------- */
-static  OS_SEM     FS_OS_LockSem;
+static  OS_SEM     FS_OS_LockSemTbl[FS_OS_LOCK_CNT];
 
 static  OS_SEM   **FS_OS_DevLockSemTbl;
 static  OS_SEM   **FS_OS_DevAccessLockSemTbl;
 
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+static  OS_SEM   **FS_OS_DevSharedLockSemTbl;
+static  FS_CTR    *FS_OS_DevSharedCntTbl;
+static  OS_SEM   **FS_OS_DevIO_LockSemTbl;
+#endif
+
 #if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
 static  OS_SEM   **FS_OS_FileLockSemTbl;
 static  OS_TCB   **FS_OS_FileLockTaskID_Tbl;
@@ -100,6 +106,14 @@ static  FS_CTR    *FS_OS_FileLockCntTbl;
 #endif
 
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)                       /* ----------------- ASYNC FILE REQ'S ----------------- */
+static  OS_SEM     FS_OS_FileAsyncQueueSem;
+static  OS_SEM     FS_OS_FileAsyncTaskSem;
+static  OS_SEM    *FS_OS_FileAsyncReqSemTbl;
+static  OS_TCB    *FS_OS_FileAsyncTaskTCB_Tbl;
+#endif
+
+
 #if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
 static  OS_REG_ID  FS_OS_RegIdWorkingDir;
 #endif
@@ -110,6 +124,10 @@ static  OS_REG_ID  FS_OS_RegIdWorkingDir;
 *********************************************************************************************************
 */
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  void  FS_OS_FileAsyncTask(void  *p_arg);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -140,16 +158,19 @@ static  OS_REG_ID  FS_OS_RegIdWorkingDir;
 void  FS_OS_Init (FS_ERR  *p_err)
 {
     OS_ERR  err_os;
+    FS_ID   lock_id;
 
 
-    OSSemCreate(            &FS_OS_LockSem,
-                (CPU_CHAR *) FS_LOCK_NAME,
-                (OS_SEM_CTR) 1u,
-                            &err_os);
+    for (lock_id = 0u; lock_id < FS_OS_LOCK_CNT; lock_id++) {   /* Create file system locks.                            */
+        OSSemCreate(            &FS_OS_LockSemTbl[lock_id],
+                    (CPU_CHAR *) FS_LOCK_NAME,
+                    (OS_SEM_CTR) 1u,
+                                &err_os);
 
-    if (err_os != OS_ERR_NONE) {
-       *p_err = FS_ERR_OS_INIT_LOCK;
-        return;
+        if (err_os != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_LOCK;
+            return;
+        }
     }
 
 
@@ -170,9 +191,11 @@ void  FS_OS_Init (FS_ERR  *p_err)
 *********************************************************************************************************
 *                                            FS_OS_Lock()
 *
-* Description : Acquire mutually exclusive access to file system suite.
+* Description : Acquire mutually exclusive access to a file system module.
 *
-* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+* Argument(s) : lock_id     Lock ID (see 'fs_dev.h  FILE SYSTEM LOCK DEFINES').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
 *                               FS_ERR_NONE       File system access     acquired.
@@ -187,12 +210,13 @@ void  FS_OS_Init (FS_ERR  *p_err)
 *********************************************************************************************************
 */
 
-void  FS_OS_Lock (FS_ERR  *p_err)
+void  FS_OS_Lock (FS_ID    lock_id,
+                  FS_ERR  *p_err)
 {
     OS_ERR  err_os;
 
 
-    OSSemPend(          &FS_OS_LockSem,                         /* Acquire file system access ...                       */
+    OSSemPend(          &FS_OS_LockSemTbl[lock_id],             /* Acquire file system access ...                       */
               (OS_TICK)  0u,                                    /* ... without timeout (see Note #1).                   */
               (OS_OPT)   OS_OPT_PEND_BLOCKING,
               (CPU_TS *) 0,
@@ -224,9 +248,9 @@ void  FS_OS_Lock (FS_ERR  *p_err)
 *********************************************************************************************************
 *                                           FS_OS_Unlock()
 *
-* Description : Release mutually exclusive access to file system suite.
+* Description : Release mutually exclusive access to a file system module.
 *
-* Argument(s) : none.
+* Argument(s) : lock_id     Lock ID (see 'fs_dev.h  FILE SYSTEM LOCK DEFINES').
 *
 * Return(s)   : none.
 *
@@ -237,12 +261,12 @@ void  FS_OS_Lock (FS_ERR  *p_err)
 *********************************************************************************************************
 */
 
-void  FS_OS_Unlock (void)
+void  FS_OS_Unlock (FS_ID  lock_id)
 {
     OS_ERR  err_os;
 
 
-    OSSemPost(         &FS_OS_LockSem,                          /* Release file system access.                          */
+    OSSemPost(         &FS_OS_LockSemTbl[lock_id],              /* Release file system access.                          */
               (OS_OPT) (OS_OPT_POST_FIFO | OS_OPT_POST_1),
                        &err_os);
 
@@ -677,6 +701,77 @@ void  FS_OS_DevInit (FS_QTY   dev_cnt,
         }
     }
 
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+                                                                /* ------------ CREATE DEVICE SHARED LOCKS ------------ */
+    FS_OS_DevSharedLockSemTbl = (OS_SEM **)Mem_HeapAlloc((CPU_SIZE_T) (sizeof(OS_SEM *) * dev_cnt),
+                                                         (CPU_SIZE_T)  sizeof(CPU_DATA),
+                                                                      &octets_reqd,
+                                                                      &err_lib);
+    if (FS_OS_DevSharedLockSemTbl == DEF_NULL) {
+        FS_TRACE_INFO(("FS_OS_DevInit(): Could not alloc mem for dev shared locks: %d octets required.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    FS_OS_DevIO_LockSemTbl = (OS_SEM **)Mem_HeapAlloc((CPU_SIZE_T) (sizeof(OS_SEM *) * dev_cnt),
+                                                      (CPU_SIZE_T)  sizeof(CPU_DATA),
+                                                                   &octets_reqd,
+                                                                   &err_lib);
+    if (FS_OS_DevIO_LockSemTbl == DEF_NULL) {
+        FS_TRACE_INFO(("FS_OS_DevInit(): Could not alloc mem for dev I/O locks: %d octets required.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    FS_OS_DevSharedCntTbl = (FS_CTR *)Mem_HeapAlloc((CPU_SIZE_T) (sizeof(FS_CTR) * dev_cnt),
+                                                    (CPU_SIZE_T)  sizeof(FS_CTR),
+                                                                 &octets_reqd,
+                                                                 &err_lib);
+    if (FS_OS_DevSharedCntTbl == DEF_NULL) {
+        FS_TRACE_INFO(("FS_OS_DevInit(): Could not alloc mem for dev shared locks: %d octets required.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    for (ix = 0u; ix < dev_cnt; ix++) {
+        FS_OS_DevSharedCntTbl[ix]     = 0u;
+
+        FS_OS_DevSharedLockSemTbl[ix] = (OS_SEM *)Mem_HeapAlloc((CPU_SIZE_T)  sizeof(OS_SEM),
+                                                                (CPU_SIZE_T)  sizeof(CPU_DATA),
+                                                                             &octets_reqd,
+                                                                             &err_lib);
+        FS_OS_DevIO_LockSemTbl[ix]    = (OS_SEM *)Mem_HeapAlloc((CPU_SIZE_T)  sizeof(OS_SEM),
+                                                                (CPU_SIZE_T)  sizeof(CPU_DATA),
+                                                                             &octets_reqd,
+                                                                             &err_lib);
+        if ((FS_OS_DevSharedLockSemTbl[ix] == DEF_NULL) ||
+            (FS_OS_DevIO_LockSemTbl[ix]    == DEF_NULL)) {
+            FS_TRACE_INFO(("FS_OS_DevInit(): Could not alloc mem for dev shared locks: %d octets required.\r\n", octets_reqd));
+           *p_err = FS_ERR_MEM_ALLOC;
+            return;
+        }
+
+        OSSemCreate(             FS_OS_DevSharedLockSemTbl[ix],
+                    (CPU_CHAR *) FS_DEV_SHARED_LOCK_NAME,
+                    (OS_SEM_CTR) 1u,
+                                &err_os);
+        if (err_os != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_LOCK;
+            return;
+        }
+
+        OSSemCreate(             FS_OS_DevIO_LockSemTbl[ix],
+                    (CPU_CHAR *) FS_DEV_IO_LOCK_NAME,
+                    (OS_SEM_CTR) 1u,
+                                &err_os);
+        if (err_os != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_LOCK;
+            return;
+        }
+    }
+#endif
+
    *p_err = FS_ERR_NONE;
 }
 
@@ -890,6 +985,200 @@ void  FS_OS_DevAccessUnlock (FS_ID  dev_id)
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FS_OS_DevSharedLock()
+*
+* Description : Acquire shared access to file system device.
+*
+* Argument(s) : dev_id      Index of the device.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       File system device shared access     acquired.
+*                               FS_ERR_OS_LOCK    File system device shared access NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device access MUST be acquired--i.e. MUST wait for access; do NOT timeout.
+*
+*               (2) The first task to acquire shared access acquires the device lock on behalf of every
+*                   task holding shared access; the last task to release shared access releases it.
+*                   Tasks holding shared access MUST serialize device I/O with 'FS_OS_DevIO_Lock()'.
+*
+*               (3) When both the access lock & shared access are required the access lock MUST be
+*                   acquired first.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevSharedLock (FS_ID    dev_id,
+                           FS_ERR  *p_err)
+{
+    OS_ERR  err_os;
+
+
+    OSSemPend(           FS_OS_DevSharedLockSemTbl[dev_id],     /* Acquire shared cnt access (see Note #1).             */
+              (OS_TICK)  0u,
+              (OS_OPT)   OS_OPT_PEND_BLOCKING,
+              (CPU_TS *) 0,
+                        &err_os);
+    if (err_os != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_DevSharedLock(): Lock failed for dev %d.\r\n", dev_id));
+       *p_err = FS_ERR_OS_LOCK;
+        return;
+    }
+
+   *p_err = FS_ERR_NONE;
+    if (FS_OS_DevSharedCntTbl[dev_id] == 0u) {                  /* First sharer acquires dev lock (see Note #2).        */
+        FS_OS_DevLock(dev_id, p_err);
+    }
+    if (*p_err == FS_ERR_NONE) {
+        FS_OS_DevSharedCntTbl[dev_id]++;
+    }
+
+    OSSemPost(          FS_OS_DevSharedLockSemTbl[dev_id],
+              (OS_OPT) (OS_OPT_POST_FIFO | OS_OPT_POST_1),
+                       &err_os);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_OS_DevSharedUnlock()
+*
+* Description : Release shared access to file system device.
+*
+* Argument(s) : dev_id      Index of the device.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device access MUST be released--i.e. MUST unlock access without failure.
+*
+*               (2) See 'FS_OS_DevSharedLock()  Note #2'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevSharedUnlock (FS_ID  dev_id)
+{
+    OS_ERR  err_os;
+
+
+    OSSemPend(           FS_OS_DevSharedLockSemTbl[dev_id],     /* Acquire shared cnt access (see Note #1).             */
+              (OS_TICK)  0u,
+              (OS_OPT)   OS_OPT_PEND_BLOCKING,
+              (CPU_TS *) 0,
+                        &err_os);
+    if (err_os != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_DevSharedUnlock(): Unlock failed for dev %d.\r\n", dev_id));
+        return;
+    }
+
+    FS_OS_DevSharedCntTbl[dev_id]--;
+    if (FS_OS_DevSharedCntTbl[dev_id] == 0u) {                  /* Last sharer releases dev lock (see Note #2).         */
+        FS_OS_DevUnlock(dev_id);
+    }
+
+    OSSemPost(          FS_OS_DevSharedLockSemTbl[dev_id],
+              (OS_OPT) (OS_OPT_POST_FIFO | OS_OPT_POST_1),
+                       &err_os);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FS_OS_DevIO_Lock()
+*
+* Description : Acquire mutually exclusive access to device I/O.
+*
+* Argument(s) : dev_id      Index of the semaphore to acquire.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       Device I/O access     acquired.
+*                               FS_ERR_OS_LOCK    Device I/O access NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device I/O access MUST be acquired--i.e. MUST wait for access; do NOT timeout.
+*
+*               (2) Serializes device (& volume cache) accesses of tasks holding shared access to the
+*                   device (see 'FS_OS_DevSharedLock()  Note #2').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevIO_Lock (FS_ID    dev_id,
+                        FS_ERR  *p_err)
+{
+    OS_ERR  err_os;
+
+
+    OSSemPend(           FS_OS_DevIO_LockSemTbl[dev_id],        /* Acquire device I/O access without timeout.           */
+              (OS_TICK)  0u,
+              (OS_OPT)   OS_OPT_PEND_BLOCKING,
+              (CPU_TS *) 0,
+                        &err_os);
+
+    switch (err_os) {
+        case OS_ERR_NONE:
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+        case OS_ERR_OBJ_DEL:
+        case OS_ERR_OBJ_PTR_NULL:
+        case OS_ERR_OBJ_TYPE:
+        case OS_ERR_PEND_ABORT:
+        case OS_ERR_PEND_ISR:
+        case OS_ERR_PEND_WOULD_BLOCK:
+        case OS_ERR_SCHED_LOCKED:
+        case OS_ERR_TIMEOUT:
+        default:
+             FS_TRACE_DBG(("FS_OS_DevIO_Lock(): Lock failed for dev %d.\r\n", dev_id));
+            *p_err = FS_ERR_OS_LOCK;
+             break;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_OS_DevIO_Unlock()
+*
+* Description : Release mutually exclusive access to device I/O.
+*
+* Argument(s) : dev_id      Index of the semaphore to release.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Device I/O access MUST be released--i.e. MUST unlock access without failure.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FS_OS_DevIO_Unlock (FS_ID  dev_id)
+{
+    OS_ERR  err_os;
+
+
+    OSSemPost(          FS_OS_DevIO_LockSemTbl[dev_id],         /* Release device I/O access.                           */
+              (OS_OPT) (OS_OPT_POST_FIFO | OS_OPT_POST_1),
+                       &err_os);
+
+    if (err_os != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_DevIO_Unlock(): Unlock failed for dev %d.\r\n", dev_id));
+    }
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -1218,3 +1507,427 @@ CPU_BOOLEAN  FS_OS_FileUnlock (FS_ID  file_id)
     return (DEF_NO);
 }
 #endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_OS_FileAsyncInit()
+*
+* Description : Create asynchronous file request objects & worker tasks.
+*
+* Argument(s) : req_cnt     Number of requests.
+*
+*               task_cnt    Number of worker tasks to create.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE             Objects & tasks created.
+*                               FS_ERR_MEM_ALLOC        Memory could not be allocated.
+*                               FS_ERR_OS_INIT_LOCK     Semaphore NOT successfully created.
+*                               FS_ERR_OS_INIT_TASK     Worker task NOT successfully created.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The worker tasks are created with the priority & stack size configured in 'fs_os.h'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncInit (FS_QTY   req_cnt,
+                           FS_QTY   task_cnt,
+                           FS_ERR  *p_err)
+{
+    OS_ERR      err_os;
+    FS_QTY      ix;
+    LIB_ERR     err_lib;
+    CPU_SIZE_T  octets_reqd;
+    CPU_STK    *p_stk;
+
+
+                                                                /* ------------------ CREATE REQ SEMS ----------------- */
+    OSSemCreate(            &FS_OS_FileAsyncQueueSem,           /* One unit per free req.                               */
+                (CPU_CHAR *) FS_FILE_ASYNC_QUEUE_NAME,
+                (OS_SEM_CTR) req_cnt,
+                            &err_os);
+    if (err_os != OS_ERR_NONE) {
+       *p_err = FS_ERR_OS_INIT_LOCK;
+        return;
+    }
+
+    OSSemCreate(            &FS_OS_FileAsyncTaskSem,            /* One unit per rdy file.                               */
+                (CPU_CHAR *) FS_FILE_ASYNC_RDY_NAME,
+                (OS_SEM_CTR) 0u,
+                            &err_os);
+    if (err_os != OS_ERR_NONE) {
+       *p_err = FS_ERR_OS_INIT_LOCK;
+        return;
+    }
+
+    FS_OS_FileAsyncReqSemTbl = (OS_SEM *)Mem_HeapAlloc((CPU_SIZE_T) (sizeof(OS_SEM) * req_cnt),
+                                                       (CPU_SIZE_T)  sizeof(CPU_DATA),
+                                                                    &octets_reqd,
+                                                                    &err_lib);
+    if (FS_OS_FileAsyncReqSemTbl == (OS_SEM *)0) {
+        FS_TRACE_INFO(("FS_OS_FileAsyncInit(): Could not alloc mem for async req sems: %d octets required.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    for (ix = 0u; ix < req_cnt; ix++) {
+        OSSemCreate(            &FS_OS_FileAsyncReqSemTbl[ix],
+                    (CPU_CHAR *) FS_FILE_ASYNC_REQ_NAME,
+                    (OS_SEM_CTR) 0u,
+                                &err_os);
+        if (err_os != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_LOCK;
+            return;
+        }
+    }
+
+
+
+                                                                /* ---------------- CREATE WORKER TASKS --------------- */
+    FS_OS_FileAsyncTaskTCB_Tbl = (OS_TCB *)Mem_HeapAlloc((CPU_SIZE_T) (sizeof(OS_TCB) * task_cnt),
+                                                         (CPU_SIZE_T)  sizeof(CPU_DATA),
+                                                                      &octets_reqd,
+                                                                      &err_lib);
+    if (FS_OS_FileAsyncTaskTCB_Tbl == (OS_TCB *)0) {
+        FS_TRACE_INFO(("FS_OS_FileAsyncInit(): Could not alloc mem for async tasks: %d octets required.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+
+    for (ix = 0u; ix < task_cnt; ix++) {
+        p_stk = (CPU_STK *)Mem_HeapAlloc((CPU_SIZE_T) (sizeof(CPU_STK) * FS_OS_CFG_FILE_ASYNC_TASK_STK_SIZE),
+                                         (CPU_SIZE_T)  sizeof(CPU_STK),
+                                                      &octets_reqd,
+                                                      &err_lib);
+        if (p_stk == (CPU_STK *)0) {
+            FS_TRACE_INFO(("FS_OS_FileAsyncInit(): Could not alloc mem for async task stk: %d octets required.\r\n", octets_reqd));
+           *p_err = FS_ERR_MEM_ALLOC;
+            return;
+        }
+
+                                                                /* Create worker task (see Note #1).                    */
+        OSTaskCreate(             &FS_OS_FileAsyncTaskTCB_Tbl[ix],
+                     (CPU_CHAR  *) FS_FILE_ASYNC_TASK_NAME,
+                                   FS_OS_FileAsyncTask,
+                     (void      *) 0,
+                     (OS_PRIO    ) FS_OS_CFG_FILE_ASYNC_TASK_PRIO,
+                                   p_stk,
+                     (CPU_STK_SIZE)(FS_OS_CFG_FILE_ASYNC_TASK_STK_SIZE / 10u),
+                     (CPU_STK_SIZE) FS_OS_CFG_FILE_ASYNC_TASK_STK_SIZE,
+                     (OS_MSG_QTY ) 0u,
+                     (OS_TICK    ) 0u,
+                     (void      *) 0,
+                     (OS_OPT     )(OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR),
+                                  &err_os);
+        if (err_os != OS_ERR_NONE) {
+           *p_err = FS_ERR_OS_INIT_TASK;
+            return;
+        }
+    }
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FS_OS_FileAsyncQueuePend()
+*
+* Description : Wait for a free asynchronous file request.
+*
+* Argument(s) : timeout     If non-zero, timeout period (in milliseconds).
+*                           If zero,     wait forever.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE          Free request reserved.
+*                               FS_ERR_OS_TIMEOUT    No request freed before timeout.
+*                               FS_ERR_OS_LOCK       Semaphore NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncQueuePend (CPU_INT32U   timeout,
+                                FS_ERR      *p_err)
+{
+    OS_TICK  timeout_ticks;
+    OS_ERR   err_os;
+
+
+    timeout_ticks = (timeout * OSCfg_TickRate_Hz + (DEF_TIME_NBR_mS_PER_SEC - 1u)) / DEF_TIME_NBR_mS_PER_SEC;
+
+    OSSemPend(          &FS_OS_FileAsyncQueueSem,
+                         timeout_ticks,
+              (OS_OPT)   OS_OPT_PEND_BLOCKING,
+              (CPU_TS *) 0,
+                        &err_os);
+
+    switch (err_os) {
+        case OS_ERR_NONE:
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+        case OS_ERR_TIMEOUT:
+            *p_err = FS_ERR_OS_TIMEOUT;
+             break;
+
+
+        case OS_ERR_OBJ_DEL:
+        case OS_ERR_OBJ_PTR_NULL:
+        case OS_ERR_OBJ_TYPE:
+        case OS_ERR_PEND_ABORT:
+        case OS_ERR_PEND_ISR:
+        case OS_ERR_PEND_WOULD_BLOCK:
+        case OS_ERR_SCHED_LOCKED:
+        default:
+             FS_TRACE_DBG(("FS_OS_FileAsyncQueuePend(): Pend failed.\r\n"));
+            *p_err = FS_ERR_OS_LOCK;
+             break;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FS_OS_FileAsyncQueuePost()
+*
+* Description : Signal a free asynchronous file request.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncQueuePost (void)
+{
+    OS_ERR  err_os;
+
+
+    OSSemPost(         &FS_OS_FileAsyncQueueSem,
+              (OS_OPT) (OS_OPT_POST_FIFO | OS_OPT_POST_1),
+                       &err_os);
+
+    if (err_os != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_FileAsyncQueuePost(): Post failed.\r\n"));
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncTaskPend()
+*
+* Description : Wait for a file with asynchronous requests to service.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE       Ready file signaled.
+*                               FS_ERR_OS_LOCK    Semaphore NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Worker tasks wait forever.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncTaskPend (FS_ERR  *p_err)
+{
+    OS_ERR  err_os;
+
+
+    OSSemPend(          &FS_OS_FileAsyncTaskSem,
+              (OS_TICK)  0u,                                    /* See Note #1.                                         */
+              (OS_OPT)   OS_OPT_PEND_BLOCKING,
+              (CPU_TS *) 0,
+                        &err_os);
+
+    if (err_os != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_FileAsyncTaskPend(): Pend failed.\r\n"));
+       *p_err = FS_ERR_OS_LOCK;
+        return;
+    }
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncTaskPost()
+*
+* Description : Signal a file with asynchronous requests to service.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncTaskPost (void)
+{
+    OS_ERR  err_os;
+
+
+    OSSemPost(         &FS_OS_FileAsyncTaskSem,
+              (OS_OPT) (OS_OPT_POST_FIFO | OS_OPT_POST_1),
+                       &err_os);
+
+    if (err_os != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_FileAsyncTaskPost(): Post failed.\r\n"));
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncReqPend()
+*
+* Description : Wait for an asynchronous file request to complete.
+*
+* Argument(s) : req_id      Index of the request.
+*
+*               timeout     If non-zero, timeout period (in milliseconds).
+*                           If zero,     wait forever.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE          Request completed.
+*                               FS_ERR_OS_TIMEOUT    Request NOT completed before timeout.
+*                               FS_ERR_OS_LOCK       Semaphore NOT acquired.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncReqPend (FS_ID        req_id,
+                              CPU_INT32U   timeout,
+                              FS_ERR      *p_err)
+{
+    OS_TICK  timeout_ticks;
+    OS_ERR   err_os;
+
+
+    timeout_ticks = (timeout * OSCfg_TickRate_Hz + (DEF_TIME_NBR_mS_PER_SEC - 1u)) / DEF_TIME_NBR_mS_PER_SEC;
+
+    OSSemPend(          &FS_OS_FileAsyncReqSemTbl[req_id],
+                         timeout_ticks,
+              (OS_OPT)   OS_OPT_PEND_BLOCKING,
+              (CPU_TS *) 0,
+                        &err_os);
+
+    switch (err_os) {
+        case OS_ERR_NONE:
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+        case OS_ERR_TIMEOUT:
+            *p_err = FS_ERR_OS_TIMEOUT;
+             break;
+
+
+        case OS_ERR_OBJ_DEL:
+        case OS_ERR_OBJ_PTR_NULL:
+        case OS_ERR_OBJ_TYPE:
+        case OS_ERR_PEND_ABORT:
+        case OS_ERR_PEND_ISR:
+        case OS_ERR_PEND_WOULD_BLOCK:
+        case OS_ERR_SCHED_LOCKED:
+        default:
+             FS_TRACE_DBG(("FS_OS_FileAsyncReqPend(): Pend failed for req %d.\r\n", req_id));
+            *p_err = FS_ERR_OS_LOCK;
+             break;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_OS_FileAsyncReqPost()
+*
+* Description : Signal the completion of an asynchronous file request.
+*
+* Argument(s) : req_id      Index of the request.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FS_OS_FileAsyncReqPost (FS_ID  req_id)
+{
+    OS_ERR  err_os;
+
+
+    OSSemPost(         &FS_OS_FileAsyncReqSemTbl[req_id],
+              (OS_OPT) (OS_OPT_POST_FIFO | OS_OPT_POST_1),
+                       &err_os);
+
+    if (err_os != OS_ERR_NONE) {
+        FS_TRACE_DBG(("FS_OS_FileAsyncReqPost(): Post failed for req %d.\r\n", req_id));
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        FS_OS_FileAsyncTask()
+*
+* Description : Asynchronous file request worker task.
+*
+* Argument(s) : p_arg       Pointer to task argument (unused).
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) 'FSFile_AsyncTaskHandler()' never returns.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  void  FS_OS_FileAsyncTask (void  *p_arg)
+{
+    (void)p_arg;
+
+    FSFile_AsyncTaskHandler();                                  /* See Note #1.                                         */
+}
+#endif
@@ -195,6 +195,13 @@ FS_ERR  FS_Init (FS_CFG  *p_fs_cfg)
         return (FS_ERR_INVALID_CFG);
     }
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    if ((p_fs_cfg->AsyncReqCnt  < 1u) ||
+        (p_fs_cfg->AsyncTaskCnt < 1u)) {
+        return (FS_ERR_INVALID_CFG);
+    }
+#endif
+
     FS_MaxSecSize = p_fs_cfg->MaxSecSize;
 
 
@@ -216,6 +223,14 @@ FS_ERR  FS_Init (FS_CFG  *p_fs_cfg)
         return (err);
     }
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    FSFile_AsyncModuleInit(p_fs_cfg->AsyncReqCnt,
+                           p_fs_cfg->AsyncTaskCnt, &err);
+    if (err != FS_ERR_NONE) {
+        return (err);
+    }
+#endif
+
 #ifdef FS_DIR_MODULE_PRESENT
     FSDir_ModuleInit(p_fs_cfg->DirCnt,     &err);
     if (err != FS_ERR_NONE) {
@@ -187,6 +187,17 @@
 *
 *               (g) 'MaxSecSize' is the maximum sector size, in octets.  It MUST be 512, 1024, 2048 or
 *                    4096.  No device with a sector size larger than 'MaxSecSize' can be opened.
+*
+*               (h) 'AsyncReqCnt' is the maximum number of asynchronous file requests that can be pending
+*                    simultaneously.  It MUST be between 1 & FS_QTY_NBR_MAX, inclusive.  Once every request
+*                    is pending, submitting a new request waits until one is freed.
+*
+*               (i) 'AsyncTaskCnt' is the number of worker tasks servicing asynchronous file requests.  It
+*                    MUST be between 1 & FS_QTY_NBR_MAX, inclusive.  Requests on different files are
+*                    serviced by up to 'AsyncTaskCnt' tasks in parallel.
+*
+*               (j) 'AsyncReqCnt' & 'AsyncTaskCnt' are only present if asynchronous file requests are
+*                    enabled (see 'fs_cfg.h  FILE SYSTEM CONFIGURATION  Note #15').
 *********************************************************************************************************
 */
 
@@ -198,6 +209,10 @@ typedef  struct  fs_cfg {
     FS_QTY       BufCnt;                                        /* Max nbr buffers     that can be used simultaneously. */
     FS_QTY       DevDrvCnt;                                     /* Max nbr device drivers that can be added.            */
     FS_SEC_SIZE  MaxSecSize;                                    /* Max sec size.                                        */
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    FS_QTY       AsyncReqCnt;                                   /* Max nbr async file req's   that can be pending.      */
+    FS_QTY       AsyncTaskCnt;                                  /* Nbr of async file req worker tasks.                  */
+#endif
 } FS_CFG;
 
 
@@ -1642,6 +1642,214 @@ fs_size_t  fs_fwrite (const  void  *p_src,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                             fs_pread()
+*
+* Description : Read from a file at a given offset.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               size        Number of octets to read.
+*
+*               offset      Offset from the beginning of the file of the first octet to read.
+*
+* Return(s)   : Number of bytes read, if no error.
+*               -1,                   otherwise.
+*
+* Note(s)     : (1) IEEE Std 1003.1, 2004 Edition, Section 'pread() : DESCRIPTION' states that "the
+*                  'pread()' function shall be equivalent to 'read()', except that it shall read from a
+*                   given position in the file without changing the file pointer".
+*
+*               (2) The file position indicator, the end-of-file & error indicators & the file buffer
+*                   are not affected.  Several tasks may read the same file concurrently (see
+*                  'FSFile_RdAt()  Note #2').
+*
+*               (3) The file MUST have been opened in read or update (read/write) mode.
+*********************************************************************************************************
+*/
+
+fs_ssize_t  fs_pread (FS_FILE    *p_file,
+                      void       *p_dest,
+                      fs_size_t   size,
+                      fs_off_t    offset)
+{
+    CPU_SIZE_T  size_rd;
+    FS_ERR      err;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_file == (FS_FILE *)0) {                               /* Validate pointer to file                             */
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+    if (p_dest == (void *)0) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+#endif
+    if (size > (fs_size_t)DEF_INT_32S_MAX_VAL) {                /* Rtn err if size ovf's rtn val.                       */
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+
+    size_rd = FSFile_RdAt(               p_file,
+                                         p_dest,
+                          (CPU_SIZE_T  ) size,
+                          (FS_FILE_SIZE) offset,
+                                        &err);
+
+    if (err != FS_ERR_NONE) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+
+    return ((fs_ssize_t)size_rd);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             fs_pwrite()
+*
+* Description : Write to a file at a given offset.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_src       Pointer to source buffer.
+*
+*               size        Number of octets to write.
+*
+*               offset      Offset from the beginning of the file of the first octet to write.
+*
+* Return(s)   : Number of bytes written, if no error.
+*               -1,                      otherwise.
+*
+* Note(s)     : (1) IEEE Std 1003.1, 2004 Edition, Section 'pwrite() : DESCRIPTION' states that "the
+*                  'pwrite()' function shall be equivalent to 'write()', except that it writes into a
+*                   given position without changing the file pointer".
+*
+*               (2) If the file was opened in append mode, the data is written at the end of the file,
+*                   regardless of 'offset'.
+*
+*               (3) The file MUST have been opened in write or update (read/write) mode.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+fs_ssize_t  fs_pwrite (       FS_FILE    *p_file,
+                       const  void       *p_src,
+                              fs_size_t   size,
+                              fs_off_t    offset)
+{
+    CPU_SIZE_T  size_wr;
+    FS_ERR      err;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_file == (FS_FILE *)0) {                               /* Validate pointer to file                             */
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+    if (p_src == (const void *)0) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+#endif
+    if (size > (fs_size_t)DEF_INT_32S_MAX_VAL) {                /* Rtn err if size ovf's rtn val.                       */
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+
+    size_wr = FSFile_WrAt(               p_file,
+                          (void       *) p_src,
+                          (CPU_SIZE_T  ) size,
+                          (FS_FILE_SIZE) offset,
+                                        &err);
+
+    if (err != FS_ERR_NONE) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+
+    return ((fs_ssize_t)size_wr);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                             fs_readv()
+*
+* Description : Read from a file into several buffers.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_iov       Pointer to array of I/O vectors.
+*
+*               iovcnt      Number of I/O vectors.
+*
+* Return(s)   : Number of bytes read, if no error.
+*               -1,                   otherwise.
+*
+* Note(s)     : (1) IEEE Std 1003.1, 2004 Edition, Section 'readv() : DESCRIPTION' states that :
+*
+*                   (a) "The 'readv()' function shall be equivalent to 'read()', except ... that 'readv()'
+*                        shall place the input data into the 'iovcnt' buffers specified by the members of
+*                        the 'iov' array".
+*
+*                   (b) "Each 'iovec' entry specifies the base address and length of an area in memory
+*                        where data should be placed.  The 'readv()' function shall always fill an area
+*                        completely before proceeding to the next."
+*
+*               (2) IEEE Std 1003.1, 2004 Edition, Section 'readv() : ERRORS' states that the function
+*                   shall fail if "the sum of the 'iov_len' values in the 'iov' array overflowed an
+*                  'ssize_t'" or if "the 'iovcnt' argument was less than or equal to 0".
+*
+*               (3) The vector is read with a single call to 'FSFile_RdV()' (see 'fs_api.h  I/O VECTOR
+*                   DATA TYPE  Note #1').
+*********************************************************************************************************
+*/
+
+fs_ssize_t  fs_readv (       FS_FILE           *p_file,
+                      const  struct  fs_iovec  *p_iov,
+                             int                iovcnt)
+{
+    CPU_SIZE_T  size_tot;
+    CPU_SIZE_T  size_rd;
+    int         iov_ix;
+    FS_ERR      err;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_file == (FS_FILE *)0) {                               /* Validate pointer to file                             */
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+    if (p_iov == (const struct fs_iovec *)0) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+#endif
+    if ((iovcnt <= 0) ||                                        /* See Note #2.                                         */
+        (iovcnt >  (int)DEF_INT_16U_MAX_VAL)) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+
+    size_tot = 0u;
+    for (iov_ix = 0; iov_ix < iovcnt; iov_ix++) {
+        if (p_iov[iov_ix].iov_len > (CPU_SIZE_T)DEF_INT_32S_MAX_VAL - size_tot) {
+            return ((fs_ssize_t)FS_STDIO_ERR);
+        }
+        size_tot += p_iov[iov_ix].iov_len;
+    }
+
+    size_rd = FSFile_RdV(               p_file,                 /* See Note #3.                                         */
+                         (FS_FILE_IOV *)p_iov,
+                         (FS_QTY      )iovcnt,
+                                       &err);
+
+    if ((err     != FS_ERR_NONE) &&
+        (size_rd == 0u)) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+
+    return ((fs_ssize_t)size_rd);
+}
+
+
 /*
 *********************************************************************************************************
 *                                             fs_rewind()
@@ -1806,6 +2014,86 @@ int  fs_setvbuf (FS_FILE    *p_file,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                             fs_writev()
+*
+* Description : Write to a file from several buffers.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_iov       Pointer to array of I/O vectors.
+*
+*               iovcnt      Number of I/O vectors.
+*
+* Return(s)   : Number of bytes written, if no error.
+*               -1,                      otherwise.
+*
+* Note(s)     : (1) IEEE Std 1003.1, 2004 Edition, Section 'writev() : DESCRIPTION' states that :
+*
+*                   (a) "The 'writev()' function shall be equivalent to 'write()', except ... that
+*                       'writev()' shall gather output data from the 'iovcnt' buffers specified by the
+*                        members of the 'iov' array".
+*
+*                   (b) "The 'writev()' function shall always write a complete area before proceeding
+*                        to the next."
+*
+*               (2) See 'fs_readv()  Note #2'.
+*
+*               (3) The vector is written with a single call to 'FSFile_WrV()', so the file is locked &
+*                   clusters are allocated once for the whole request (see 'fs_api.h  I/O VECTOR DATA
+*                   TYPE  Note #1').
+*
+*               (4) The file MUST have been opened in write or update (read/write) mode.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+fs_ssize_t  fs_writev (       FS_FILE           *p_file,
+                       const  struct  fs_iovec  *p_iov,
+                              int                iovcnt)
+{
+    CPU_SIZE_T  size_tot;
+    CPU_SIZE_T  size_wr;
+    int         iov_ix;
+    FS_ERR      err;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_file == (FS_FILE *)0) {                               /* Validate pointer to file                             */
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+    if (p_iov == (const struct fs_iovec *)0) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+#endif
+    if ((iovcnt <= 0) ||                                        /* See Note #2.                                         */
+        (iovcnt >  (int)DEF_INT_16U_MAX_VAL)) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+
+    size_tot = 0u;
+    for (iov_ix = 0; iov_ix < iovcnt; iov_ix++) {
+        if (p_iov[iov_ix].iov_len > (CPU_SIZE_T)DEF_INT_32S_MAX_VAL - size_tot) {
+            return ((fs_ssize_t)FS_STDIO_ERR);
+        }
+        size_tot += p_iov[iov_ix].iov_len;
+    }
+
+    size_wr = FSFile_WrV(               p_file,                 /* See Note #3.                                         */
+                         (FS_FILE_IOV *)p_iov,
+                         (FS_QTY      )iovcnt,
+                                       &err);
+
+    if (err != FS_ERR_NONE) {
+        return ((fs_ssize_t)FS_STDIO_ERR);
+    }
+
+    return ((fs_ssize_t)size_wr);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -229,6 +229,9 @@
 *
 *               (a) size_t is "Used for sizes of objects" and, additionally, that it "shall be an
 *                   unsigned integer type".
+*
+*               (c) ssize_t is "Used for a count of bytes or an error indication" and, additionally,
+*                   that it "shall be [a] signed integer [type]".
 *********************************************************************************************************
 */
 
@@ -238,6 +241,8 @@ typedef  CPU_INT32U  fs_off_t;
 
 typedef  CPU_SIZE_T  fs_size_t;
 
+typedef  CPU_INT32S  fs_ssize_t;
+
 typedef  CPU_INT32U  fs_dev_t;
 
 typedef  CPU_INT32U  fs_ino_t;
@@ -277,6 +282,20 @@ struct  fs_stat {
     fs_blkcnt_t   st_blocks;                                    /* Number of blocks allocated for file.                 */
 };
 
+/*
+*********************************************************************************************************
+*                                        I/O VECTOR DATA TYPE
+*
+* Note(s) : (1) 'struct fs_iovec' MUST have the same layout as 'FS_FILE_IOV' so that an array of I/O
+*               vectors can be passed to the file layer unchanged.
+*********************************************************************************************************
+*/
+
+struct  fs_iovec {
+    void         *iov_base;                                     /* Base address of a memory region for I/O.             */
+    fs_size_t     iov_len;                                      /* Size of the memory pointed to by iov_base.           */
+};
+
 /*
 *********************************************************************************************************
 *                                           TIME DATA TYPE
@@ -364,7 +383,9 @@ struct  fs_tm {
 *                   (1) chdir()
 *                   (2) ftruncate()
 *                   (3) getcwd()
-*                   (4) rmdir()
+*                   (4) pread()
+*                   (5) pwrite()
+*                   (6) rmdir()
 *
 *               (b) The original function name, besides the prefixed 'fs_', is preserved.
 *
@@ -374,6 +395,21 @@ struct  fs_tm {
 *                   (1) 'int'     --> 'FS_FILE *'. (file descriptor)
 *                   (2) 'off_t'   --> 'fs_off_t'.
 *                   (3) 'size_t'  --> 'fs_size_t'.
+*                   (4) 'ssize_t' --> 'fs_ssize_t'.
+*
+*           (6) (a) Equivalents of the POSIX 'sys/uio.h' functions are provided :
+*
+*                   (1) readv()
+*                   (2) writev()
+*
+*               (b) The original function name, besides the prefixed 'fs_', is preserved.
+*
+*               (c) The types of arguments & return values were transformed for the file system suite
+*                   environment :
+*
+*                   (1) 'int'           --> 'FS_FILE *'. (file descriptor)
+*                   (2) 'struct iovec'  --> 'struct fs_iovec'.
+*                   (3) 'ssize_t'       --> 'fs_ssize_t'.
 *********************************************************************************************************
 */
 
@@ -473,6 +509,22 @@ fs_size_t       fs_fwrite      (const  void                *p_src,          /* W
                                        FS_FILE             *p_file);
 #endif
 
+fs_ssize_t      fs_pread       (       FS_FILE             *p_file,         /* Read from a file at a given offset.      */
+                                       void                *p_dest,
+                                       fs_size_t            size,
+                                       fs_off_t             offset);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+fs_ssize_t      fs_pwrite      (       FS_FILE             *p_file,         /* Write to a file at a given offset.       */
+                                const  void                *p_src,
+                                       fs_size_t            size,
+                                       fs_off_t             offset);
+#endif
+
+fs_ssize_t      fs_readv       (       FS_FILE             *p_file,         /* Read from a file into several buffers.   */
+                                const  struct  fs_iovec    *p_iov,
+                                       int                  iovcnt);
+
 void            fs_rewind      (       FS_FILE             *p_file);        /* Reset file position indicator of a file. */
 
 #if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
@@ -485,6 +537,12 @@ int             fs_setvbuf     (       FS_FILE             *p_file,         /* A
                                        fs_size_t            size);
 #endif
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+fs_ssize_t      fs_writev      (       FS_FILE             *p_file,         /* Write to a file from several buffers.    */
+                                const  struct  fs_iovec    *p_iov,
+                                       int                  iovcnt);
+#endif
+
 
                                                                             /* ------------ TIME FUNCTIONS ------------ */
 char           *fs_asctime_r   (const  struct  fs_tm       *p_time,         /* Convert date/time to string.             */
@@ -213,6 +213,25 @@
 #define  FS_FAT_JOURNAL_MODULE_PRESENT
 #endif
 #endif
+
+#ifdef   FS_FAT_JOURNAL_MODULE_PRESENT
+#if     (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED)
+#define  FS_FAT_JOURNAL_STAGE_MODULE_PRESENT
+#endif
+#endif
+
+#ifdef   FS_FAT_JOURNAL_STAGE_MODULE_PRESENT
+#define  FS_SYS_VOL_WR_PREP_PRESENT
+#endif
+
+#ifdef   FS_FAT_CFG_VOL_DIRTY_EN
+#if    ((FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED) && \
+        (FS_CFG_RD_ONLY_EN       == DEF_DISABLED))
+#ifndef  FS_SYS_VOL_WR_PREP_PRESENT
+#define  FS_SYS_VOL_WR_PREP_PRESENT
+#endif
+#endif
+#endif
 #endif
 
 
@@ -446,6 +465,41 @@
 #endif
 
 
+
+                                                                /* ------------- FS_CFG_VOL_LOCK_SHARED_EN ------------ */
+#ifndef  FS_CFG_VOL_LOCK_SHARED_EN
+#error  "FS_CFG_VOL_LOCK_SHARED_EN                    not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be DEF_DISABLED]                          "
+#error  "                                       [     || DEF_ENABLED ]                          "
+
+#elif  ((FS_CFG_VOL_LOCK_SHARED_EN != DEF_ENABLED) && \
+        (FS_CFG_VOL_LOCK_SHARED_EN != DEF_DISABLED))
+#error  "FS_CFG_VOL_LOCK_SHARED_EN              illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be DEF_DISABLED]                          "
+#error  "                                       [     || DEF_ENABLED ]                          "
+
+#elif  ((FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED) && \
+        (FS_CFG_FILE_LOCK_EN       != DEF_ENABLED))
+#error  "FS_CFG_VOL_LOCK_SHARED_EN              illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be DEF_DISABLED if                        "
+#error  "                                        FS_CFG_FILE_LOCK_EN is DEF_DISABLED]           "
+#endif
+
+
+                                                                /* --------------- FS_CFG_FILE_ASYNC_EN --------------- */
+#ifndef  FS_CFG_FILE_ASYNC_EN
+#error  "FS_CFG_FILE_ASYNC_EN                         not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be DEF_DISABLED]                          "
+#error  "                                       [     || DEF_ENABLED ]                          "
+
+#elif  ((FS_CFG_FILE_ASYNC_EN != DEF_ENABLED) && \
+        (FS_CFG_FILE_ASYNC_EN != DEF_DISABLED))
+#error  "FS_CFG_FILE_ASYNC_EN                   illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be DEF_DISABLED]                          "
+#error  "                                       [     || DEF_ENABLED ]                          "
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                FILE SYSTEM FAT CONFIGURATION ERRORS
@@ -542,6 +596,146 @@
 #error  "                                       [MUST be  DEF_DISABLED]                         "
 #endif
 
+
+                                                                /* ------------ FS_FAT_CFG_ENTRY_COMMIT_EN ------------ */
+#ifndef  FS_FAT_CFG_ENTRY_COMMIT_EN
+#error  "FS_FAT_CFG_ENTRY_COMMIT_EN                   not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+
+#elif  ((FS_FAT_CFG_ENTRY_COMMIT_EN != DEF_DISABLED) && \
+        (FS_FAT_CFG_ENTRY_COMMIT_EN != DEF_ENABLED ))
+#error  "FS_FAT_CFG_ENTRY_COMMIT_EN             illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+#endif
+
+#if    ((FS_FAT_CFG_ENTRY_COMMIT_EN == DEF_ENABLED) && \
+        (FS_CFG_RD_ONLY_EN          == DEF_ENABLED))
+#error  "INVALID FS FAT CONFIG                                      in  'fs_cfg.h'              "
+#error  "Entry commit is useless when FS_CFG_RD_ONLY_EN is DEF_ENABLED. FS_FAT_CFG_ENTRY_COMMIT_EN"
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#endif
+
+
+                                                                /* ------------- FS_FAT_CFG_JOURNAL_TX_EN ------------- */
+#ifndef  FS_FAT_CFG_JOURNAL_TX_EN
+#error  "FS_FAT_CFG_JOURNAL_TX_EN                     not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+
+#elif  ((FS_FAT_CFG_JOURNAL_TX_EN != DEF_DISABLED) && \
+        (FS_FAT_CFG_JOURNAL_TX_EN != DEF_ENABLED ))
+#error  "FS_FAT_CFG_JOURNAL_TX_EN               illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+#endif
+
+#if    ((FS_FAT_CFG_JOURNAL_TX_EN == DEF_ENABLED) && \
+        (FS_FAT_CFG_JOURNAL_EN    == DEF_DISABLED))
+#error  "INVALID FS FAT CONFIG                                      in  'fs_cfg.h'              "
+#error  "Journal tx is useless when FS_FAT_CFG_JOURNAL_EN is DEF_DISABLED. FS_FAT_CFG_JOURNAL_TX_EN"
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#endif
+
+
+                                                                /* ------------ FS_FAT_CFG_JOURNAL_STAGE_EN ----------- */
+#ifndef  FS_FAT_CFG_JOURNAL_STAGE_EN
+#error  "FS_FAT_CFG_JOURNAL_STAGE_EN                  not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+
+#elif  ((FS_FAT_CFG_JOURNAL_STAGE_EN != DEF_DISABLED) && \
+        (FS_FAT_CFG_JOURNAL_STAGE_EN != DEF_ENABLED ))
+#error  "FS_FAT_CFG_JOURNAL_STAGE_EN            illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+#endif
+
+#if    ((FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_ENABLED) && \
+        (FS_FAT_CFG_JOURNAL_EN       == DEF_DISABLED))
+#error  "INVALID FS FAT CONFIG                                      in  'fs_cfg.h'              "
+#error  "Staging buf is useless when FS_FAT_CFG_JOURNAL_EN is DEF_DISABLED. FS_FAT_CFG_JOURNAL_STAGE_EN"
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#endif
+
+
+                                                                /* ------------- FS_FAT_CFG_JOURNAL_DEV_EN ------------ */
+#ifndef  FS_FAT_CFG_JOURNAL_DEV_EN
+#error  "FS_FAT_CFG_JOURNAL_DEV_EN                    not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+
+#elif  ((FS_FAT_CFG_JOURNAL_DEV_EN != DEF_DISABLED) && \
+        (FS_FAT_CFG_JOURNAL_DEV_EN != DEF_ENABLED ))
+#error  "FS_FAT_CFG_JOURNAL_DEV_EN              illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+#endif
+
+#if    ((FS_FAT_CFG_JOURNAL_DEV_EN   == DEF_ENABLED) && \
+        (FS_FAT_CFG_JOURNAL_STAGE_EN == DEF_DISABLED))
+#error  "INVALID FS FAT CONFIG                                      in  'fs_cfg.h'              "
+#error  "Journal dev requires the staging buf.  FS_FAT_CFG_JOURNAL_DEV_EN                         "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#endif
+
+
+                                                                /* ----------- FS_FAT_CFG_JOURNAL_ORDERED_EN ---------- */
+#ifndef  FS_FAT_CFG_JOURNAL_ORDERED_EN
+#error  "FS_FAT_CFG_JOURNAL_ORDERED_EN                not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+
+#elif  ((FS_FAT_CFG_JOURNAL_ORDERED_EN != DEF_DISABLED) && \
+        (FS_FAT_CFG_JOURNAL_ORDERED_EN != DEF_ENABLED ))
+#error  "FS_FAT_CFG_JOURNAL_ORDERED_EN          illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+#endif
+
+#if    ((FS_FAT_CFG_JOURNAL_ORDERED_EN == DEF_ENABLED) && \
+        (FS_FAT_CFG_JOURNAL_EN         == DEF_DISABLED))
+#error  "INVALID FS FAT CONFIG                                      in  'fs_cfg.h'              "
+#error  "Ordered data is useless when FS_FAT_CFG_JOURNAL_EN is DEF_DISABLED. FS_FAT_CFG_JOURNAL_ORDERED_EN"
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#endif
+
+
+                                                                /* -------------- FS_FAT_CFG_VOL_DIRTY_EN ------------- */
+#ifndef  FS_FAT_CFG_VOL_DIRTY_EN
+#error  "FS_FAT_CFG_VOL_DIRTY_EN                      not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+
+#elif  ((FS_FAT_CFG_VOL_DIRTY_EN != DEF_DISABLED) && \
+        (FS_FAT_CFG_VOL_DIRTY_EN != DEF_ENABLED ))
+#error  "FS_FAT_CFG_VOL_DIRTY_EN                illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+#endif
+
+
+                                                                /* ------------ FS_FAT_CFG_SEC_CLR_BUF_SIZE ----------- */
+#ifndef  FS_FAT_CFG_SEC_CLR_BUF_SIZE
+#error  "FS_FAT_CFG_SEC_CLR_BUF_SIZE                  not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  >= 0]                                 "
+#endif
+
+
+                                                                /* -------------- FS_FAT_CFG_FMT_ALIGN_EN ------------- */
+#ifndef  FS_FAT_CFG_FMT_ALIGN_EN
+#error  "FS_FAT_CFG_FMT_ALIGN_EN                      not #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+
+#elif  ((FS_FAT_CFG_FMT_ALIGN_EN != DEF_DISABLED) && \
+        (FS_FAT_CFG_FMT_ALIGN_EN != DEF_ENABLED ))
+#error  "FS_FAT_CFG_FMT_ALIGN_EN                illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  DEF_DISABLED]                         "
+#error  "                                       [     ||  DEF_ENABLED ]                         "
+#endif
+
 #endif
 /*
 *********************************************************************************************************
@@ -49,6 +49,7 @@
 #include  "fs_buf.h"
 #include  "fs_dev.h"
 #include  "fs_partition.h"
+#include  "fs_util.h"
 
 
 /*
@@ -93,6 +94,7 @@ static  FS_DEV      **FSDev_Tbl;                                /* Tbl of dev.
 
 static  FS_QTY        FSDev_DevCntMax;                          /* Maximum number of open devices.                      */
 static  FS_QTY        FSDev_Cnt;
+static  FS_CTR        FSDev_OpenSeq;                            /* Last dev open seq nbr.                               */
 
 
 /*
@@ -119,6 +121,9 @@ static  FS_DEV_API  *FS_DevDrvFind  (const  CPU_CHAR  *name_dev);   /* Find devi
 static  void         FSDev_HandleErr(       FS_DEV    *p_dev,   /* Handle error from device access.                     */
                                             FS_ERR     err);
 
+static  CPU_BOOLEAN  FSDev_LockChk  (       FS_DEV    *p_dev,   /* Acquire device lock & validate device.               */
+                                            FS_ERR    *p_err);
+
 
                                                                 /* ------------------- NAME PARSING ------------------- */
 static  CPU_CHAR    *FSDev_NameParse(       CPU_CHAR  *name_full,   /* Extract name & unit number of device.            */
@@ -198,7 +203,7 @@ void  FS_DevDrvAdd (FS_DEV_API  *p_dev_drv,
 
 
                                                                 /* ----------------- ACQUIRE FS LOCK ------------------ */
-    FS_OS_Lock(p_err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DEV, p_err);
     if (*p_err != FS_ERR_NONE) {
         return;
     }
@@ -208,7 +213,7 @@ void  FS_DevDrvAdd (FS_DEV_API  *p_dev_drv,
                                                                 /* -------------------- TEST NAME --------------------- */
     name_dev = p_dev_drv->NameGet();                            /* Get dev drv name (see Note #1).                      */
     if (name_dev == (CPU_CHAR *)0) {                            /* Rtn if name is NULL ptr.                             */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
        *p_err = FS_ERR_DEV_DRV_INVALID_NAME;
         return;
     }
@@ -216,28 +221,28 @@ void  FS_DevDrvAdd (FS_DEV_API  *p_dev_drv,
     str_len = Str_Len_N(name_dev, FS_CFG_MAX_DEV_DRV_NAME_LEN + 1u);
     if ((str_len <                          1u) ||              /* Rtn if name is empty str (see Note #1d) ...          */
         (str_len > FS_CFG_MAX_DEV_DRV_NAME_LEN)) {              /* ... or name is too long  (see Note #1c).             */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
        *p_err = FS_ERR_DEV_DRV_INVALID_NAME;
         return;
     }
 
     p_colon = Str_Char_N(name_dev, FS_CFG_MAX_DEV_DRV_NAME_LEN, FS_CHAR_DEV_SEP);
     if (p_colon != (CPU_CHAR *)0) {                             /* Rtn if name contains ':' (see Note #1b).             */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
        *p_err = FS_ERR_DEV_DRV_INVALID_NAME;
         return;
     }
 
     p_colon = Str_Char_N(name_dev, FS_CFG_MAX_DEV_DRV_NAME_LEN, FS_CHAR_PATH_SEP_ALT);
     if (p_colon != (CPU_CHAR *)0) {                             /* Rtn if name contains '/' (see Note #1b).             */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
        *p_err = FS_ERR_DEV_DRV_INVALID_NAME;
         return;
     }
 
     p_colon = Str_Char_N(name_dev, FS_CFG_MAX_DEV_DRV_NAME_LEN, FS_CHAR_PATH_SEP);
     if (p_colon != (CPU_CHAR *)0) {                             /* Rtn if name contains '\' (see Note #1b).             */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
        *p_err = FS_ERR_DEV_DRV_INVALID_NAME;
         return;
     }
@@ -246,7 +251,7 @@ void  FS_DevDrvAdd (FS_DEV_API  *p_dev_drv,
                                                                 /* ------------------ TEST DUP NAME ------------------- */
     p_dev_drv_dup = FS_DevDrvFind(name_dev);                    /* Chk if name dup'd (see Note #1a).                    */
     if (p_dev_drv_dup != (FS_DEV_API *)0) {
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
        *p_err = FS_ERR_DEV_DRV_ALREADY_ADDED;
         return;
     }
@@ -258,7 +263,7 @@ void  FS_DevDrvAdd (FS_DEV_API  *p_dev_drv,
         }
     }
     if (ix >= FS_DevDrvCntMax) {
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
         FS_TRACE_INFO(("FS_DevDrvAdd(): Could not alloc drv from pool. Opened driver limit reached.\r\n"));
        *p_err = FS_ERR_DEV_DRV_NONE_AVAIL;
         return;
@@ -268,7 +273,7 @@ void  FS_DevDrvAdd (FS_DEV_API  *p_dev_drv,
                                                                 /* ---------------- INIT & ADD TO TBL ----------------- */
     p_dev_drv->Init(p_err);                                     /* Init dev drv (see Note #2).                          */
     if (*p_err != FS_ERR_NONE) {
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
         return;
     }
     FS_DevDrvTbl[ix] = p_dev_drv;                                /* Add name to tbl.                                     */
@@ -276,7 +281,7 @@ void  FS_DevDrvAdd (FS_DEV_API  *p_dev_drv,
 
 
                                                                 /* ----------------- RELEASE FS LOCK ------------------ */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
 
    *p_err = FS_ERR_NONE;
 }
@@ -456,6 +461,81 @@ FS_PARTITION_NBR  FSDev_GetNbrPartitions (CPU_CHAR  *name_dev,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                          FSDev_HandleGet()
+*
+* Description : Get handle of a device.
+*
+* Argument(s) : name_dev    Device name.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE            Device handle gotten.
+*                               FS_ERR_NAME_NULL       Argument 'name_dev' passed a NULL pointer.
+*                               FS_ERR_DEV_NOT_OPEN    Device is not open.
+*                               FS_ERR_OS_LOCK         OS Lock NOT acquired.
+*
+* Return(s)   : Handle of the device, if NO errors.
+*               Invalid handle,       otherwise.
+*
+* Note(s)     : (1) The device name is resolved once.  The returned handle may then be passed to the
+*                   '...ByHandle()' functions, which get the device from its entry in the device table
+*                   instead of comparing its name with the name of every open device.
+*
+*               (2) Each device object is stamped with a new open sequence number when it is allocated.
+*                   The handle holds both the device ID & that sequence number, so that a handle to a
+*                   closed device is rejected even if its device table entry was reused since.  The open
+*                   sequence number 0 is never assigned, so the handle returned on error is never valid.
+*********************************************************************************************************
+*/
+
+FS_DEV_HANDLE  FSDev_HandleGet (CPU_CHAR  *name_dev,
+                                FS_ERR    *p_err)
+{
+    FS_DEV_HANDLE   dev_handle;
+    FS_DEV         *p_dev;
+
+
+    dev_handle.DevID      = 0u;                                 /* Invalid handle (see Note #2).                        */
+    dev_handle.DevOpenSeq = 0u;
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(dev_handle);
+    }
+    if (name_dev == (CPU_CHAR *)0) {                            /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return (dev_handle);
+    }
+#endif
+
+                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
+    FS_OS_Lock(FS_OS_LOCK_ID_DEV, p_err);
+    if (*p_err != FS_ERR_NONE) {
+       *p_err = FS_ERR_OS_LOCK;
+        return (dev_handle);
+    }
+
+                                                                /* --------------------- FIND DEV --------------------- */
+    p_dev = FSDev_ObjFind(name_dev);
+    if (p_dev == (FS_DEV *)0) {                                 /* Rtn err if dev not found.                            */
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
+       *p_err = FS_ERR_DEV_NOT_OPEN;
+        return (dev_handle);
+    }
+
+    dev_handle.DevID      = p_dev->ID;
+    dev_handle.DevOpenSeq = p_dev->OpenSeq;
+
+                                                                /* ------------------ RELEASE FS LOCK ----------------- */
+    FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
+
+   *p_err = FS_ERR_NONE;
+    return (dev_handle);
+}
+
+
 /*
 *********************************************************************************************************
 *                                           FSDev_IO_Ctrl()
@@ -719,14 +799,14 @@ void  FSDev_Open (CPU_CHAR  *name_dev,
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(p_err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DEV, p_err);
     if (*p_err != FS_ERR_NONE) {
          return;
     }
 
     p_dev = FSDev_ObjFind(name_dev);
     if (p_dev != (FS_DEV *)0) {                                 /* If dev already open ...                              */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
 
         if (p_dev->State == FS_DEV_STATE_LOW_FMT_VALID) {       /* Chk if dev has been low level fmt'd.                 */
            *p_err = FS_ERR_DEV_ALREADY_OPEN;
@@ -741,7 +821,7 @@ void  FSDev_Open (CPU_CHAR  *name_dev,
                                                                 /* ------------------- FIND DEV DRV ------------------- */
     p_dev_drv = FS_DevDrvFind(&name_dev_copy[0]);
     if (p_dev_drv == (FS_DEV_API *)0) {                         /* If dev drv NOT found (see Note #1a4) ...             */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
        *p_err = FS_ERR_DEV_INVALID_NAME;                        /* ... rtn err.                                         */
         return;
     }
@@ -751,7 +831,7 @@ void  FSDev_Open (CPU_CHAR  *name_dev,
                                                                 /* ------------------- ALLOCATE DEV ------------------- */
     p_dev = FSDev_ObjGet();                                     /* Get dev.                                             */
     if (p_dev == (FS_DEV *)0) {
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
        *p_err = FS_ERR_DEV_NONE_AVAIL;
         return;
     }
@@ -761,7 +841,8 @@ void  FSDev_Open (CPU_CHAR  *name_dev,
     p_dev->State             = FS_DEV_STATE_OPENING;
     p_dev->RefCnt            = 1u;
     (void)Str_Copy_N(&p_dev->Name[0], name_dev, FS_CFG_MAX_DEV_NAME_LEN);
-    FS_OS_Unlock();
+    p_dev->NameHash          = FSUtil_StrHash_N(&p_dev->Name[0], FS_CFG_MAX_DEV_NAME_LEN);
+    FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
 
 
 
@@ -1239,10 +1320,11 @@ void  FSDev_Query (CPU_CHAR     *name_dev,
             return;
         }
 
-        p_info->State   = p_dev->State;
-        p_info->Fixed   = p_dev->Fixed;
-        p_info->Size    = 0u;
-        p_info->SecSize = 0u;
+        p_info->State     = p_dev->State;
+        p_info->Fixed     = p_dev->Fixed;
+        p_info->Size      = 0u;
+        p_info->SecSize   = 0u;
+        p_info->AlignSize = 0u;
     }
 
     FSDev_ReleaseUnlock(p_dev);
@@ -1332,6 +1414,88 @@ void  FSDev_Rd (CPU_CHAR    *name_dev,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSDev_RdByHandle()
+*
+* Description : Read data from device sector(s).
+*
+* Argument(s) : dev_handle  Handle of the device (see 'FSDev_HandleGet()').
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               start       Start sector of read.
+*               -----       Argument checked in 'FSDev_RdLocked()'.
+*
+*               cnt         Number of sectors to read.
+*               ---         Argument checked in 'FSDev_RdLocked()'.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                    Sector(s) read.
+*                               FS_ERR_NULL_PTR                Argument 'p_dest' passed a NULL pointer.
+*                               FS_ERR_DEV_NOT_OPEN            Device is not open, or handle is invalid.
+*
+*                                                              ------- RETURNED BY FSDev_LockChk() ------
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
+*
+*                                                              ------ RETURNED BY FSDev_RdLocked() ------
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector start or count invalid.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FSDev_Rd()  Note(s)'.
+*********************************************************************************************************
+*/
+
+void  FSDev_RdByHandle (FS_DEV_HANDLE   dev_handle,
+                        void           *p_dest,
+                        FS_SEC_NBR      start,
+                        FS_SEC_QTY      cnt,
+                        FS_ERR         *p_err)
+{
+    FS_DEV       *p_dev;
+    CPU_BOOLEAN   lock_ok;
+
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (p_dest == (void *)0) {                                  /* Validate dest ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+
+
+                                                                /* ----------------- ACQUIRE DEV LOCK ----------------- */
+    p_dev = FSDev_AcquireByHandle(dev_handle);
+    if (p_dev == (FS_DEV *)0) {                                 /* Rtn err if dev not found.                            */
+       *p_err = FS_ERR_DEV_NOT_OPEN;
+        return;
+    }
+
+    lock_ok = FSDev_LockChk(p_dev, p_err);
+    if (lock_ok != DEF_OK) {
+        return;
+    }
+
+
+
+                                                                /* ---------------------- RD DEV ---------------------- */
+    FSDev_RdLocked(p_dev, p_dest, start, cnt, p_err);
+
+                                                                /* ----------------- RELEASE DEV LOCK ----------------- */
+    FSDev_ReleaseUnlock(p_dev);
+}
+
+
 /*
 *********************************************************************************************************
 *                                             FSDev_Refresh()
@@ -1592,6 +1756,88 @@ void  FSDev_Wr (CPU_CHAR    *name_dev,
 
 
 
+                                                                /* ---------------------- WR DEV ---------------------- */
+    FSDev_WrLocked(p_dev, p_src, start, cnt, p_err);
+
+                                                                /* ----------------- RELEASE DEV LOCK ----------------- */
+    FSDev_ReleaseUnlock(p_dev);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FSDev_WrByHandle()
+*
+* Description : Write data to device sector(s).
+*
+* Argument(s) : dev_handle  Handle of the device (see 'FSDev_HandleGet()').
+*
+*               p_src       Pointer to source buffer.
+*
+*               start       Start sector of write.
+*               -----       Argument checked in 'FSDev_WrLocked()'.
+*
+*               cnt         Number of sectors to write.
+*               ---         Argument checked in 'FSDev_WrLocked()'.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                    Sector(s) written.
+*                               FS_ERR_NULL_PTR                Argument 'p_src' passed a NULL pointer.
+*                               FS_ERR_DEV_NOT_OPEN            Device is not open, or handle is invalid.
+*
+*                                                              ------- RETURNED BY FSDev_LockChk() ------
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
+*
+*                                                              ------ RETURNED BY FSDev_WrLocked() ------
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector start or count invalid.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FSDev_Wr()  Note(s)'.
+*********************************************************************************************************
+*/
+
+void  FSDev_WrByHandle (FS_DEV_HANDLE   dev_handle,
+                        void           *p_src,
+                        FS_SEC_NBR      start,
+                        FS_SEC_QTY      cnt,
+                        FS_ERR         *p_err)
+{
+    FS_DEV       *p_dev;
+    CPU_BOOLEAN   lock_ok;
+
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (p_src == (void *)0) {                                   /* Validate src ptr.                                    */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+
+
+                                                                /* ----------------- ACQUIRE DEV LOCK ----------------- */
+    p_dev = FSDev_AcquireByHandle(dev_handle);
+    if (p_dev == (FS_DEV *)0) {                                 /* Rtn err if dev not found.                            */
+       *p_err = FS_ERR_DEV_NOT_OPEN;
+        return;
+    }
+
+    lock_ok = FSDev_LockChk(p_dev, p_err);
+    if (lock_ok != DEF_OK) {
+        return;
+    }
+
+
+
                                                                 /* ---------------------- WR DEV ---------------------- */
     FSDev_WrLocked(p_dev, p_src, start, cnt, p_err);
 
@@ -1815,7 +2061,7 @@ FS_QTY  FSDev_GetDevCnt (void)
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DEV, &err);
     if (err != FS_ERR_NONE) {
         return (0u);
     }
@@ -1828,7 +2074,7 @@ FS_QTY  FSDev_GetDevCnt (void)
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
 
     return (dev_cnt);
 }
@@ -1896,7 +2142,7 @@ void  FSDev_GetDevName (FS_QTY     dev_nbr,
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DEV, &err);
     if (err != FS_ERR_NONE) {
         return;
     }
@@ -1919,7 +2165,7 @@ void  FSDev_GetDevName (FS_QTY     dev_nbr,
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
 }
 
 
@@ -1976,6 +2222,7 @@ void  FSDev_ModuleInit (FS_QTY   dev_cnt,
 
     FSDev_DevCntMax = 0u;
     FSDev_Cnt       = 0u;
+    FSDev_OpenSeq   = 0u;
 
                                                                 /* ---------------- PERFORM FS/OS INIT ---------------- */
     FS_OS_Init(p_err);                                          /* See 'FS_Init()  Note #4'.                            */
@@ -2067,7 +2314,7 @@ FS_DEV  *FSDev_AcquireLockChk (CPU_CHAR  *name_dev,
                                FS_ERR    *p_err)
 {
     FS_DEV       *p_dev;
-    CPU_BOOLEAN   lock_success;
+    CPU_BOOLEAN   lock_ok;
 
 
                                                                 /* ----------------- ACQUIRE DEV LOCK ----------------- */
@@ -2077,83 +2324,88 @@ FS_DEV  *FSDev_AcquireLockChk (CPU_CHAR  *name_dev,
         return ((FS_DEV *)0);
     }
 
-    lock_success = FSDev_Lock(p_dev);
-    if (lock_success != DEF_YES) {
-        FSDev_Release(p_dev);
-       *p_err = FS_ERR_OS_LOCK;
+    lock_ok = FSDev_LockChk(p_dev, p_err);                      /* Acquire dev lock & validate dev.                     */
+    if (lock_ok != DEF_OK) {
         return ((FS_DEV *)0);
     }
 
+    return (p_dev);
+}
 
 
-                                                                /* ------------------- VALIDATE DEV ------------------- */
-    if (p_dev->State == FS_DEV_STATE_OPEN) {                    /* Dev not present ...                                  */
-       (void)FSDev_RefreshLocked(p_dev, p_err);                 /* ... try to reopen dev.                               */
-        if (*p_err != FS_ERR_NONE) {
-            FSDev_ReleaseUnlock(p_dev);
-            return DEF_NULL;
-        }
-    }
+/*
+*********************************************************************************************************
+*                                           FSDev_Acquire()
+*
+* Description : Acquire device reference.
+*
+* Argument(s) : name_dev    Device name.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : Pointer to a device, if found.
+*               Pointer to NULL,     otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
 
-    switch (p_dev->State) {
-        case FS_DEV_STATE_OPEN:                                 /* Dev not present.                                     */
-            *p_err = FS_ERR_DEV_NOT_PRESENT;
-             break;
+FS_DEV  *FSDev_Acquire (CPU_CHAR  *name_dev)
+{
+    FS_DEV  *p_dev;
+    FS_ERR   err;
 
 
-        case FS_DEV_STATE_PRESENT:                              /* Dev not low fmt'd: app MUST fmt dev.                 */
-            *p_err = FS_ERR_DEV_INVALID_LOW_FMT;
-             break;
+                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
+    FS_OS_Lock(FS_OS_LOCK_ID_DEV, &err);
+    if (err != FS_ERR_NONE) {
+        return ((FS_DEV *)0);
+    }
 
 
-        case FS_DEV_STATE_LOW_FMT_VALID:                        /* Dev present.                                         */
-             break;
 
+                                                                /* --------------------- FIND DEV --------------------- */
+    p_dev = FSDev_ObjFind(name_dev);                            /* Find dev.                                            */
 
-        case FS_DEV_STATE_CLOSED:                               /* Dev closed, closing or opening: app MUST wait.       */
-        case FS_DEV_STATE_CLOSING:
-        case FS_DEV_STATE_OPENING:
-        default:
-            *p_err = FS_ERR_DEV_NOT_OPEN;
-             break;
+    if (p_dev == (FS_DEV *)0) {                                 /* Rtn NULL if dev not found.                           */
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
+        return ((FS_DEV *)0);
     }
 
-    if (p_dev->State != FS_DEV_STATE_LOW_FMT_VALID) {           /* If still not present & low fmt'd ...                 */
-        FSDev_ReleaseUnlock(p_dev);
-        return ((FS_DEV *)0);                                   /* ... rtn.                                             */
-    }
+    p_dev->RefCnt++;
 
 
-                                                                /* ------------------------ RTN ----------------------- */
-   *p_err = FS_ERR_NONE;
+
+                                                                /* ------------------ RELEASE FS LOCK ----------------- */
+    FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
+
     return (p_dev);
 }
 
 
 /*
 *********************************************************************************************************
-*                                           FSDev_Acquire()
+*                                       FSDev_AcquireByHandle()
 *
-* Description : Acquire device reference.
+* Description : Acquire device reference from a device handle.
 *
-* Argument(s) : name_dev    Device name.
-*               ----------  Argument validated by caller.
+* Argument(s) : dev_handle  Handle of the device (see 'FSDev_HandleGet()').
 *
 * Return(s)   : Pointer to a device, if found.
 *               Pointer to NULL,     otherwise.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The device is looked up by its ID; it is found only if it is still the device that was
+*                   open when the handle was gotten (see 'FSDev_HandleGet()  Note #2').
 *********************************************************************************************************
 */
 
-FS_DEV  *FSDev_Acquire (CPU_CHAR  *name_dev)
+FS_DEV  *FSDev_AcquireByHandle (FS_DEV_HANDLE  dev_handle)
 {
     FS_DEV  *p_dev;
     FS_ERR   err;
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DEV, &err);
     if (err != FS_ERR_NONE) {
         return ((FS_DEV *)0);
     }
@@ -2161,10 +2413,18 @@ FS_DEV  *FSDev_Acquire (CPU_CHAR  *name_dev)
 
 
                                                                 /* --------------------- FIND DEV --------------------- */
-    p_dev = FSDev_ObjFind(name_dev);                            /* Find dev.                                            */
+    p_dev = DEF_NULL;
+    if (dev_handle.DevID < FSDev_DevCntMax) {                   /* Find dev by ID (see Note #1).                        */
+        p_dev = FSDev_Tbl[dev_handle.DevID];
+        if (p_dev != DEF_NULL) {
+            if (p_dev->OpenSeq != dev_handle.DevOpenSeq) {      /* Rtn NULL if dev closed since handle was gotten.      */
+                p_dev = DEF_NULL;
+            }
+        }
+    }
 
     if (p_dev == (FS_DEV *)0) {                                 /* Rtn NULL if dev not found.                           */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
         return ((FS_DEV *)0);
     }
 
@@ -2173,12 +2433,11 @@ FS_DEV  *FSDev_Acquire (CPU_CHAR  *name_dev)
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
 
     return (p_dev);
 }
 
-
 /*
 *********************************************************************************************************
 *                                        FSDev_ReleaseUnlock()
@@ -2223,7 +2482,7 @@ void  FSDev_Release (FS_DEV  *p_dev)
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DEV, &err);
     if (err != FS_ERR_NONE) {
         return;
     }
@@ -2243,7 +2502,7 @@ void  FSDev_Release (FS_DEV  *p_dev)
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DEV);
 }
 
 
@@ -2300,6 +2559,256 @@ void  FSDev_Unlock (FS_DEV  *p_dev)
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FSDev_AddrGetLocked()
+*
+* Description : Get memory address of a device sector.
+*
+* Argument(s) : p_dev       Pointer to device.
+*               ----------  Argument validated by caller.
+*
+*               start       Sector number.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Address obtained.
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector number invalid.
+*
+*                                                              ----- RETURNED BY DEV DRV's IO_Ctrl() ----
+*                               FS_ERR_DEV_INVALID_IO_CTRL     Device data is NOT memory-mapped.
+*
+* Return(s)   : Pointer to first octet of sector, if NO errors.
+*               Pointer to NULL,                  otherwise.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the device & hold the device lock.
+*
+*               (2) A device driver supporting FS_DEV_IO_CTRL_ADDR_GET returns the address of the first
+*                   octet of sector 0; the sectors MUST be stored consecutively in memory from that
+*                   address & remain at that address while the device is open.
+*********************************************************************************************************
+*/
+
+void  *FSDev_AddrGetLocked (FS_DEV      *p_dev,
+                            FS_SEC_NBR   start,
+                            FS_ERR      *p_err)
+{
+    void  *p_addr;
+
+
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+    if (start >= p_dev->Size) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_NBR;
+        return ((void *)0);
+    }
+
+
+
+                                                                /* ------------------- GET DEV ADDR ------------------- */
+    p_addr = (void *)0;
+    p_dev->DevDrvPtr->IO_Ctrl(         p_dev,                   /* See Note #2.                                         */
+                                       FS_DEV_IO_CTRL_ADDR_GET,
+                              (void *)&p_addr,
+                                       p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return ((void *)0);
+    }
+    if (p_addr == (void *)0) {
+       *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+        return ((void *)0);
+    }
+
+    p_addr = (void *)((CPU_INT08U *)p_addr + ((CPU_SIZE_T)start * (CPU_SIZE_T)p_dev->SecSize));
+
+    return (p_addr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FSDev_AlignGetLocked()
+*
+* Description : Get the erase block or allocation unit size of a device.
+*
+* Argument(s) : p_dev       Pointer to device.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Size obtained.
+*
+*                                                              ----- RETURNED BY DEV DRV's IO_Ctrl() ----
+*                               FS_ERR_DEV_INVALID_IO_CTRL     Size NOT reported by device driver.
+*
+* Return(s)   : Erase block or allocation unit size, in sectors, if NO errors.
+*
+*               0,                                                    otherwise.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the device & hold the device lock.
+*
+*               (2) Writes that fill whole erase blocks or allocation units avoid read-modify-write cycles
+*                   inside the medium; a file system may align its structures to that size.
+*********************************************************************************************************
+*/
+
+FS_SEC_QTY  FSDev_AlignGetLocked (FS_DEV  *p_dev,
+                                  FS_ERR  *p_err)
+{
+    FS_SEC_QTY  align_size;
+
+
+    align_size = 0u;
+    p_dev->DevDrvPtr->IO_Ctrl(         p_dev,                   /* See Note #2.                                         */
+                                       FS_DEV_IO_CTRL_ALIGN_GET,
+                              (void *)&align_size,
+                                       p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+    return (align_size);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FSDev_BarrierLocked()
+*
+* Description : Issue a write barrier, so that sectors written before the barrier reach the device medium
+*               before any sector written after it.
+*
+* Argument(s) : p_dev       Pointer to device.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Barrier issued.
+*
+*                                                              ----- RETURNED BY DEV DRV's IO_Ctrl() ----
+*                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the device & hold the device lock.
+*
+*               (2) A barrier only orders writes; unlike a sync, it need not wait for the device to be in
+*                   a state from which it could be remounted.  A driver that does not support
+*                   FS_DEV_IO_CTRL_BARRIER is synchronized instead.  A driver that supports neither
+*                   operation completes each write before returning, so its writes are already ordered.
+*
+*               (3) Device state change will result from device I/O, not present or timeout error.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSDev_BarrierLocked (FS_DEV  *p_dev,
+                           FS_ERR  *p_err)
+{
+    p_dev->DevDrvPtr->IO_Ctrl(p_dev,                            /* Issue barrier (see Note #2).                         */
+                              FS_DEV_IO_CTRL_BARRIER,
+                              DEF_NULL,
+                              p_err);
+
+    if (*p_err == FS_ERR_DEV_INVALID_IO_CTRL) {                 /* Barrier unsupported: sync dev.                       */
+        p_dev->DevDrvPtr->IO_Ctrl(p_dev,
+                                  FS_DEV_IO_CTRL_SYNC,
+                                  DEF_NULL,
+                                  p_err);
+    }
+
+    if (*p_err == FS_ERR_DEV_INVALID_IO_CTRL) {                 /* Sync unsupported: wr's already ordered.              */
+       *p_err =  FS_ERR_NONE;
+    }
+
+    FSDev_HandleErr(p_dev, *p_err);                             /* See Note #3.                                         */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FSDev_DiscardLocked()
+*
+* Description : Discard the data of device sector(s), so that they read back as zeros.
+*
+* Argument(s) : p_dev       Pointer to device.
+*               ----------  Argument validated by caller.
+*
+*               start       Start sector of discard.
+*
+*               cnt         Number of sectors to discard.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Device sector(s) discarded.
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector start or count invalid.
+*
+*                                                              ----- RETURNED BY DEV DRV's IO_Ctrl() ----
+*                               FS_ERR_DEV_INVALID_IO_CTRL     Discard not supported (see Note #2).
+*                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the device & hold the device lock.
+*
+*               (2) A driver supports FS_DEV_IO_CTRL_SEC_DISCARD only if discarded sectors are guaranteed
+*                   to read back as zeros, e.g., after an erase whose erased state reads as zeros.  Unlike
+*                   'FSDev_ReleaseLocked()', an unsupported discard is reported, so that the caller may
+*                   write zeros instead.
+*
+*               (3) Device state change will result from device I/O, not present or timeout error.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSDev_DiscardLocked (FS_DEV      *p_dev,
+                           FS_SEC_NBR   start,
+                           FS_SEC_QTY   cnt,
+                           FS_ERR      *p_err)
+{
+    FS_DEV_SEC_RANGE  range;
+
+
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+    if (cnt == 0u) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    if (start > p_dev->Size) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_NBR;
+        return;
+    }
+
+    if (start + cnt > p_dev->Size) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_NBR;
+        return;
+    }
+
+
+                                                                /* ------------------- DISCARD SECS ------------------- */
+    range.Start = start;
+    range.Cnt   = cnt;
+    p_dev->DevDrvPtr->IO_Ctrl(         p_dev,                   /* See Note #2.                                         */
+                                       FS_DEV_IO_CTRL_SEC_DISCARD,
+                              (void *)&range,
+                                       p_err);
+
+    FSDev_HandleErr(p_dev, *p_err);                             /* See Note #3.                                         */
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FSDev_QueryLocked()
@@ -2328,6 +2837,8 @@ void  FSDev_Unlock (FS_DEV  *p_dev)
 * Note(s)     : (1) The function caller MUST have acquired a reference to the device & hold the device lock.
 *
 *               (2) Device state change will result from device I/O, not present or timeout error.
+*
+*               (3) The erase block or allocation unit size is 0 if the device driver does not report it.
 *********************************************************************************************************
 */
 
@@ -2335,11 +2846,19 @@ void  FSDev_QueryLocked (FS_DEV       *p_dev,
                          FS_DEV_INFO  *p_info,
                          FS_ERR       *p_err)
 {
+    FS_ERR  align_err;
+
+
                                                                 /* ------------------- GET DEV INFO ------------------- */
     p_dev->DevDrvPtr->Query(p_dev,                              /* Get dev info.                                        */
                             p_info,
                             p_err);
 
+    p_info->AlignSize = 0u;
+    if (*p_err == FS_ERR_NONE) {                                /* Get erase blk/alloc unit size (see Note #3).         */
+        p_info->AlignSize = FSDev_AlignGetLocked(p_dev, &align_err);
+    }
+
 
 
                                                                 /* -------------------- HANDLE ERR -------------------- */
@@ -2947,7 +3466,7 @@ void  FSDev_VolRemove (FS_DEV  *p_dev,
 *
 * Return(s)   : Pointer to device driver.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_DEV'.
 *********************************************************************************************************
 */
 
@@ -3044,6 +3563,91 @@ static  void  FSDev_HandleErr (FS_DEV  *p_dev,
 }
 
 
+/*
+*********************************************************************************************************
+*                                           FSDev_LockChk()
+*
+* Description : Acquire device lock & validate device.
+*
+* Argument(s) : p_dev       Pointer to device.
+*               -----       Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Device present & lock acquired.
+*                               FS_ERR_DEV_NOT_OPEN           Device is not open.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_OS_LOCK                OS Lock NOT acquired.
+*
+* Return(s)   : DEF_OK,   if device lock acquired & device present.
+*               DEF_FAIL, otherwise.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the device.  If the device lock
+*                   cannot be acquired or the device is not present, that reference is released.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FSDev_LockChk (FS_DEV  *p_dev,
+                                    FS_ERR  *p_err)
+{
+    CPU_BOOLEAN  lock_success;
+
+
+                                                                /* ----------------- ACQUIRE DEV LOCK ----------------- */
+    lock_success = FSDev_Lock(p_dev);
+    if (lock_success != DEF_YES) {
+        FSDev_Release(p_dev);
+       *p_err = FS_ERR_OS_LOCK;
+        return (DEF_FAIL);
+    }
+
+
+
+                                                                /* ------------------- VALIDATE DEV ------------------- */
+    if (p_dev->State == FS_DEV_STATE_OPEN) {                    /* Dev not present ...                                  */
+       (void)FSDev_RefreshLocked(p_dev, p_err);                 /* ... try to reopen dev.                               */
+        if (*p_err != FS_ERR_NONE) {
+            FSDev_ReleaseUnlock(p_dev);
+            return (DEF_FAIL);
+        }
+    }
+
+    switch (p_dev->State) {
+        case FS_DEV_STATE_OPEN:                                 /* Dev not present.                                     */
+            *p_err = FS_ERR_DEV_NOT_PRESENT;
+             break;
+
+
+        case FS_DEV_STATE_PRESENT:                              /* Dev not low fmt'd: app MUST fmt dev.                 */
+            *p_err = FS_ERR_DEV_INVALID_LOW_FMT;
+             break;
+
+
+        case FS_DEV_STATE_LOW_FMT_VALID:                        /* Dev present.                                         */
+             break;
+
+
+        case FS_DEV_STATE_CLOSED:                               /* Dev closed, closing or opening: app MUST wait.       */
+        case FS_DEV_STATE_CLOSING:
+        case FS_DEV_STATE_OPENING:
+        default:
+            *p_err = FS_ERR_DEV_NOT_OPEN;
+             break;
+    }
+
+    if (p_dev->State != FS_DEV_STATE_LOW_FMT_VALID) {           /* If still not present & low fmt'd ...                 */
+        FSDev_ReleaseUnlock(p_dev);
+        return (DEF_FAIL);                                      /* ... rtn.                                             */
+    }
+
+
+
+   *p_err = FS_ERR_NONE;
+    return (DEF_OK);
+}
+
 /*
 *********************************************************************************************************
 *                                            FSDev_ObjClr()
@@ -3055,13 +3659,14 @@ static  void  FSDev_HandleErr (FS_DEV  *p_dev,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_DEV'.
 *********************************************************************************************************
 */
 
 static  void  FSDev_ObjClr (FS_DEV  *p_dev)
 {
     p_dev->ID           =  0u;
+    p_dev->OpenSeq      =  0u;
     p_dev->State        =  FS_DEV_STATE_CLOSED;
     p_dev->RefCnt       =  0u;
     p_dev->RefreshCnt   =  0u;
@@ -3069,6 +3674,7 @@ static  void  FSDev_ObjClr (FS_DEV  *p_dev)
     Mem_Set((void       *)&p_dev->Name[0],
             (CPU_INT08U  ) ASCII_CHAR_NULL,
             (CPU_SIZE_T  )(FS_CFG_MAX_DEV_NAME_LEN + 1u));
+    p_dev->NameHash     =  0u;
 
     p_dev->UnitNbr      =  0u;
     p_dev->Size         =  0u;
@@ -3098,25 +3704,32 @@ static  void  FSDev_ObjClr (FS_DEV  *p_dev)
 * Return(s)   : Pointer to a device, if found.
 *               Pointer to NULL,     otherwise.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_DEV'.
+*
+*               (2) The names of devices whose name hash differs from the hash of 'name_dev' are not
+*                   compared (see 'FSUtil_StrHash_N()  Note #2').
 *********************************************************************************************************
 */
 
 static  FS_DEV  *FSDev_ObjFind (CPU_CHAR  *name_dev)
 {
     CPU_INT16S   cmp;
+    CPU_INT32U   name_hash;
     FS_DEV      *p_dev;
     FS_QTY       dev_ix;
 
 
-    p_dev = DEF_NULL;
+    p_dev     = DEF_NULL;
+    name_hash = FSUtil_StrHash_N(name_dev, FS_CFG_MAX_DEV_NAME_LEN);
 
     for (dev_ix = 0u; dev_ix < FSDev_DevCntMax; dev_ix++) {
         if (FSDev_Tbl[dev_ix]!= DEF_NULL) {
-            cmp = Str_Cmp_N(name_dev, FSDev_Tbl[dev_ix]->Name, FS_CFG_MAX_DEV_NAME_LEN);
-            if (cmp == 0) {
-                p_dev = FSDev_Tbl[dev_ix];
-                break;
+            if (FSDev_Tbl[dev_ix]->NameHash == name_hash) {     /* Cmp names if hashes match (see Note #2).             */
+                cmp = Str_Cmp_N(name_dev, FSDev_Tbl[dev_ix]->Name, FS_CFG_MAX_DEV_NAME_LEN);
+                if (cmp == 0) {
+                    p_dev = FSDev_Tbl[dev_ix];
+                    break;
+                }
             }
         }
     }
@@ -3136,7 +3749,7 @@ static  FS_DEV  *FSDev_ObjFind (CPU_CHAR  *name_dev)
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_DEV'.
 *********************************************************************************************************
 */
 
@@ -3175,7 +3788,7 @@ static  void  FSDev_ObjFree (FS_DEV  *p_dev)
 * Return(s)   : Pointer to a device, if NO errors.
 *               Pointer to NULL,     otherwise.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_DEV'.
 *********************************************************************************************************
 */
 
@@ -3212,6 +3825,12 @@ static  FS_DEV  *FSDev_ObjGet (void)
 
     p_dev->ID = dev_ix;
 
+    FSDev_OpenSeq++;                                            /* Stamp dev with new open seq nbr ...                  */
+    if (FSDev_OpenSeq == 0u) {                                  /* ... never 0 (see 'FSDev_HandleGet()  Note #2').      */
+        FSDev_OpenSeq = 1u;
+    }
+    p_dev->OpenSeq = FSDev_OpenSeq;
+
     return (p_dev);
 
 exit_fail:
@@ -80,6 +80,35 @@
 #define  FS_DEV_STATE_PRESENT                              4u   /* Dev present.                                         */
 #define  FS_DEV_STATE_LOW_FMT_VALID                        5u   /* Dev low fmt valid.                                   */
 
+/*
+*********************************************************************************************************
+*                                        FILE SYSTEM LOCK DEFINES
+*
+* Note(s) : (1) Each lock protects the object table & object pools of one module, including the pools of the
+*               file system driver data attached to the module's objects :
+*
+*               (a) FS_OS_LOCK_ID_DEV  : device & device driver tables.
+*               (b) FS_OS_LOCK_ID_VOL  : volume table, volume & journal data of the file system driver.
+*               (c) FS_OS_LOCK_ID_DIR  : directory table & directory data of the file system driver.
+*               (d) FS_OS_LOCK_ID_FILE : file table & hash table, file data of the file system driver &
+*                                        asynchronous file requests.
+*
+*           (2) Locks MUST be acquired in increasing ID order.  A file system lock is only ever held for a
+*               short update of the module's tables; no device access is performed & no device lock
+*               ('FS_OS_DevLock()', etc.) is acquired while it is held, so device locks always come first.
+*
+*           (3) Working directories are kept in task-local storage & in a pool protected by critical
+*               sections; they require no file system lock.
+*********************************************************************************************************
+*/
+
+#define  FS_OS_LOCK_ID_DEV                                 0u   /* Dev & dev drv tbls.                                  */
+#define  FS_OS_LOCK_ID_VOL                                 1u   /* Vol tbl & vol data pools.                            */
+#define  FS_OS_LOCK_ID_DIR                                 2u   /* Dir tbl & dir data pool.                             */
+#define  FS_OS_LOCK_ID_FILE                                3u   /* File tbl, file data pool & async file req's.         */
+
+#define  FS_OS_LOCK_CNT                                    4u   /* Nbr of file system locks.                            */
+
 /*
 *********************************************************************************************************
 *                                     DEVICE I/O CONTROL DEFINES
@@ -104,6 +133,10 @@
 #define  FS_DEV_IO_CTRL_WR_SEC                            15u   /* Write physical dev sector.                           */
 #define  FS_DEV_IO_CTRL_SYNC                              16u   /* Sync dev.                                            */
 #define  FS_DEV_IO_CTRL_CHIP_ERASE                        17u   /* Erase all data on phy dev.                           */
+#define  FS_DEV_IO_CTRL_ADDR_GET                          18u   /* Get mem addr of dev data.                            */
+#define  FS_DEV_IO_CTRL_BARRIER                           19u   /* Order prior wr's before following wr's.              */
+#define  FS_DEV_IO_CTRL_SEC_DISCARD                       20u   /* Discard secs; discarded secs rd back as zeros.       */
+#define  FS_DEV_IO_CTRL_ALIGN_GET                         21u   /* Get erase blk/alloc unit size (in secs).             */
 
                                                                 /* ------------ SD-DRIVER SPECIFIC OPTIONS ------------ */
 #define  FS_DEV_IO_CTRL_SD_QUERY                          64u   /* Get info about SD/MMC card.                          */
@@ -128,11 +161,13 @@
 
 struct  fs_dev {
     FS_ID          ID;                                          /* Dev ID.                                              */
+    FS_CTR         OpenSeq;                                     /* Open seq nbr (see 'FSDev_HandleGet()  Note #2').     */
     FS_STATE       State;                                       /* State.                                               */
     FS_CTR         RefCnt;                                      /* Ref cnts.                                            */
     FS_CTR         RefreshCnt;                                  /* Refresh cnts.                                        */
 
     CPU_CHAR       Name[FS_CFG_MAX_DEV_NAME_LEN + 1u];          /* Dev name.                                            */
+    CPU_INT32U     NameHash;                                    /* Hash of dev name.                                    */
     FS_QTY         UnitNbr;                                     /* Dev unit nbr.                                        */
     FS_SEC_QTY     Size;                                        /* Size of dev (in secs).                               */
     FS_SEC_SIZE    SecSize;                                     /* Size of dev sec.                                     */
@@ -153,6 +188,9 @@ struct  fs_dev {
 /*
 *********************************************************************************************************
 *                                        DEVICE INFO DATA TYPE
+*
+* Note(s) : (1) 'AlignSize' is the size of the erase block or allocation unit of the medium, obtained
+*               with FS_DEV_IO_CTRL_ALIGN_GET; it is 0 if the device driver does not report it.
 *********************************************************************************************************
 */
 
@@ -161,9 +199,38 @@ typedef  struct  fs_dev_info {
     FS_SEC_QTY    Size;                                         /* Size of dev (in secs).                               */
     FS_SEC_SIZE   SecSize;                                      /* Size of dev sec.                                     */
     CPU_BOOLEAN   Fixed;                                        /* Indicates whether device is fixed or removable.      */
+    FS_SEC_QTY    AlignSize;                                    /* Erase blk/alloc unit size (in secs) (see Note #1).   */
 } FS_DEV_INFO;
 
 
+/*
+*********************************************************************************************************
+*                                       DEVICE HANDLE DATA TYPE
+*
+* Note(s) : (1) A device handle is obtained with 'FSDev_HandleGet()' (see 'FSDev_HandleGet()  Note #1').
+*********************************************************************************************************
+*/
+
+struct  fs_dev_handle {
+    FS_ID         DevID;                                        /* Dev ID.                                              */
+    FS_CTR        DevOpenSeq;                                   /* Dev open seq nbr.                                    */
+};
+
+
+/*
+*********************************************************************************************************
+*                                    DEVICE SECTOR RANGE DATA TYPE
+*
+* Note(s) : (1) A sector range is passed to the device driver with FS_DEV_IO_CTRL_SEC_DISCARD.
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_dev_sec_range {
+    FS_SEC_NBR    Start;                                        /* First sec of range.                                  */
+    FS_SEC_QTY    Cnt;                                          /* Nbr of secs in range.                                */
+} FS_DEV_SEC_RANGE;
+
+
 /*
 *********************************************************************************************************
 *                                     DEVICE DRIVER API DATA TYPE
@@ -268,6 +335,9 @@ FS_PARTITION_NBR   FSDev_GetNbrPartitions   (CPU_CHAR            *name_dev,    /
                                              FS_ERR              *p_err);
 #endif
 
+FS_DEV_HANDLE      FSDev_HandleGet          (CPU_CHAR            *name_dev,    /* Get handle of a device.                  */
+                                             FS_ERR              *p_err);
+
 void               FSDev_IO_Ctrl            (CPU_CHAR            *name_dev,    /* Perform device I/O control operation.    */
                                              CPU_INT08U           opt,
                                              void                *p_data,
@@ -306,6 +376,12 @@ void               FSDev_Rd                 (CPU_CHAR            *name_dev,    /
                                              FS_SEC_QTY           cnt,
                                              FS_ERR              *p_err);
 
+void               FSDev_RdByHandle         (FS_DEV_HANDLE        dev_handle,  /* Read data from device sector(s).         */
+                                             void                *p_dest,
+                                             FS_SEC_NBR           start,
+                                             FS_SEC_QTY           cnt,
+                                             FS_ERR              *p_err);
+
 CPU_BOOLEAN        FSDev_Refresh            (CPU_CHAR            *name_dev,    /* Refresh device.                          */
                                              FS_ERR              *p_err);
 
@@ -318,6 +394,12 @@ void               FSDev_Wr                 (CPU_CHAR            *name_dev,    /
                                              FS_SEC_NBR           start,
                                              FS_SEC_QTY           cnt,
                                              FS_ERR              *p_err);
+
+void               FSDev_WrByHandle         (FS_DEV_HANDLE        dev_handle,  /* Write data to device sector(s).          */
+                                             void                *p_src,
+                                             FS_SEC_NBR           start,
+                                             FS_SEC_QTY           cnt,
+                                             FS_ERR              *p_err);
 #endif
 
 void               FSDev_Invalidate         (CPU_CHAR            *name_dev,    /* Invalidate opened volumes and files.     */
@@ -362,6 +444,8 @@ FS_DEV            *FSDev_AcquireLockChk  (CPU_CHAR            *name_dev,    /* A
 
 FS_DEV            *FSDev_Acquire         (CPU_CHAR            *name_dev);   /* Acquire device reference.                */
 
+FS_DEV            *FSDev_AcquireByHandle (FS_DEV_HANDLE        dev_handle); /* Acquire device reference.                */
+
 void               FSDev_Release         (FS_DEV              *p_dev);      /* Release device reference.                */
 
 void               FSDev_ReleaseUnlock   (FS_DEV              *p_dev);      /* Release device reference & lock.         */
@@ -379,6 +463,23 @@ void               FSDev_VolRemove       (FS_DEV              *p_dev,       /* R
 
 
                                                                             /* ------------- LOCKED ACCESS ------------ */
+void              *FSDev_AddrGetLocked   (FS_DEV              *p_dev,       /* Get mem addr of device sector.           */
+                                          FS_SEC_NBR           start,
+                                          FS_ERR              *p_err);
+
+FS_SEC_QTY         FSDev_AlignGetLocked  (FS_DEV              *p_dev,       /* Get device erase blk/alloc unit size.    */
+                                          FS_ERR              *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void               FSDev_BarrierLocked   (FS_DEV              *p_dev,       /* Order device writes.                     */
+                                          FS_ERR              *p_err);
+
+void               FSDev_DiscardLocked   (FS_DEV              *p_dev,       /* Discard device sector(s).                */
+                                          FS_SEC_NBR           start,
+                                          FS_SEC_QTY           cnt,
+                                          FS_ERR              *p_err);
+#endif
+
 void               FSDev_QueryLocked     (FS_DEV              *p_dev,       /* Get information about a device.          */
                                           FS_DEV_INFO         *p_info,
                                           FS_ERR              *p_err);
@@ -419,9 +520,10 @@ void               FSDev_WrLocked        (FS_DEV              *p_dev,       /* W
 
 void               FS_OS_Init            (FS_ERR              *p_err);      /* Create file system objects.                        */
 
-void               FS_OS_Lock            (FS_ERR              *p_err);      /* Acquire access to file system.                     */
+void               FS_OS_Lock            (FS_ID                lock_id,     /* Acquire access to file system module.              */
+                                          FS_ERR              *p_err);
 
-void               FS_OS_Unlock          (void);                            /* Release access to file system.                     */
+void               FS_OS_Unlock          (FS_ID                lock_id);    /* Release access to file system module.              */
 
 
 void               FS_OS_DevInit         (FS_QTY               dev_cnt,     /* Create file system device objects.                 */
@@ -438,6 +540,18 @@ void               FS_OS_DevLock         (FS_ID                dev_id,      /* A
 
 void               FS_OS_DevUnlock       (FS_ID                dev_id);     /* Release access to file system device.              */
 
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void               FS_OS_DevSharedLock   (FS_ID                dev_id,      /* Acquire shared access to file system device.       */
+                                          FS_ERR              *p_err);
+
+void               FS_OS_DevSharedUnlock (FS_ID                dev_id);     /* Release shared access to file system device.       */
+
+void               FS_OS_DevIO_Lock      (FS_ID                dev_id,      /* Acquire access to device I/O.                      */
+                                          FS_ERR              *p_err);
+
+void               FS_OS_DevIO_Unlock    (FS_ID                dev_id);     /* Release access to device I/O.                      */
+#endif
+
 void               FS_OS_Dly_ms          (CPU_INT16U           ms);         /* Delay for specified time, in ms.                   */
 
 
@@ -314,7 +314,7 @@ CPU_BOOLEAN  FSDir_IsOpen(CPU_CHAR  *name_full,
 
 
                                                                 /* ------------- CMP TO EVERY DIR IN POOL ------------- */
-    FS_OS_Lock(p_err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DIR, p_err);
     if (*p_err != FS_ERR_NONE) {
         return (DEF_NO);
     }
@@ -343,7 +343,7 @@ CPU_BOOLEAN  FSDir_IsOpen(CPU_CHAR  *name_full,
         ix++;
     }
 
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DIR);
 
 
    *p_err   = FS_ERR_NONE;
@@ -416,7 +416,7 @@ FS_DIR  *FSDir_Open  (CPU_CHAR  *name_full,
 
 
                                                                 /* ------------------- GET FREE DIR ------------------- */
-    FS_OS_Lock(p_err);                                          /* Acquire FS lock.                                     */
+    FS_OS_Lock(FS_OS_LOCK_ID_DIR, p_err);                       /* Acquire FS lock.                                     */
     if (*p_err != FS_ERR_NONE) {
         return ((FS_DIR *)0);
     }
@@ -424,7 +424,7 @@ FS_DIR  *FSDir_Open  (CPU_CHAR  *name_full,
     p_dir = FSDir_ObjGet();                                     /* Alloc dir.                                           */
     if (p_dir == (FS_DIR *)0) {
        *p_err = FS_ERR_DIR_NONE_AVAIL;
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DIR);
         return ((FS_DIR *)0);
     }
 
@@ -432,7 +432,7 @@ FS_DIR  *FSDir_Open  (CPU_CHAR  *name_full,
     p_dir->State  =  FS_DIR_STATE_OPENING;
     p_dir->VolPtr = (FS_VOL *)0;
 
-    FS_OS_Unlock();                                             /* Release FS lock.                                     */
+    FS_OS_Unlock(FS_OS_LOCK_ID_DIR);                            /* Release FS lock.                                     */
 
 
 
@@ -615,7 +615,7 @@ FS_QTY  FSDir_GetDirCnt (void)
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DIR, &err);
     if (err != FS_ERR_NONE) {
         return (0u);
     }
@@ -628,7 +628,7 @@ FS_QTY  FSDir_GetDirCnt (void)
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DIR);
 
     return (dir_cnt);
 }
@@ -752,6 +752,66 @@ void  FSDir_ModuleInit (FS_QTY   dir_cnt,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSDir_IsOpenAt()
+*
+* Description : Test if the directory starting at a given cluster is open.
+*
+* Argument(s) : p_vol           Pointer to volume.
+*               -----           Argument validated by caller.
+*
+*               dir_first_clus  First cluster of the directory.
+*
+* Return(s)   : DEF_NO,  if dir is NOT open.
+*
+*               DEF_YES, if dir is     open.
+*
+* Note(s)     : (1) Used by the file system driver to check directories found while walking a directory
+*                   tree, for which the first cluster is already known (see 'FSDir_IsOpen()').
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FSDir_IsOpenAt (FS_VOL      *p_vol,
+                             CPU_INT32U   dir_first_clus)
+{
+    FS_DIR             *p_dir;
+    FS_FAT_FILE_DATA   *p_fat_file_data;
+    FS_QTY              ix;
+    CPU_BOOLEAN         dir_open;
+    FS_ERR              err;
+
+
+    FS_OS_Lock(FS_OS_LOCK_ID_DIR, &err);
+    if (err != FS_ERR_NONE) {
+        return (DEF_YES);
+    }
+
+    dir_open = DEF_NO;
+    ix       = 0u;
+    while ((ix       <  FSDir_DirCntMax) &&
+           (dir_open == DEF_NO)) {
+        p_dir = FSDir_Tbl[ix];
+
+        if (p_dir != DEF_NULL) {
+            if (p_dir->VolPtr == p_vol) {
+                p_fat_file_data = (FS_FAT_FILE_DATA *)p_dir->DataPtr;
+                                                                /* Cmp 1st cluster address                              */
+                if (p_fat_file_data->FileFirstClus == (FS_FAT_CLUS_NBR)dir_first_clus) {
+                    dir_open = DEF_YES;
+                }
+            }
+        }
+
+        ix++;
+    }
+
+    FS_OS_Unlock(FS_OS_LOCK_ID_DIR);
+
+    return (dir_open);
+}
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -854,7 +914,7 @@ static  FS_DIR  *FSDir_Acquire (FS_DIR  *p_dir)
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DIR, &err);
     if (err != FS_ERR_NONE) {
         return ((FS_DIR *)0);
     }
@@ -863,7 +923,7 @@ static  FS_DIR  *FSDir_Acquire (FS_DIR  *p_dir)
 
                                                                 /* -------------------- INC REF CNT ------------------- */
     if (p_dir->RefCnt == 0u) {                                  /* Rtn NULL if dir not ref'd.                           */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_DIR);
         return ((FS_DIR *)0);
     }
 
@@ -872,7 +932,7 @@ static  FS_DIR  *FSDir_Acquire (FS_DIR  *p_dir)
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DIR);
 
     return (p_dir);
 }
@@ -925,7 +985,7 @@ static  void  FSDir_Release (FS_DIR  *p_dir)
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_DIR, &err);
     if (err != FS_ERR_NONE) {
         return;
     }
@@ -943,7 +1003,7 @@ static  void  FSDir_Release (FS_DIR  *p_dir)
         FS_TRACE_DBG(("FSDir_Release(): Release cnt dec'd to zero.\r\n"));
     }
 
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_DIR);
 
 
 
@@ -1016,7 +1076,7 @@ static  void  FSDir_Unlock (FS_DIR  *p_dir)
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_DIR'.
 *********************************************************************************************************
 */
 
@@ -1048,7 +1108,7 @@ static  void  FSDir_ObjClr (FS_DIR  *p_dir)
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_DIR'.
 *********************************************************************************************************
 */
 
@@ -1095,7 +1155,7 @@ static  void  FSDir_ObjFree (FS_DIR  *p_dir)
 * Return(s)   : Pointer to a directory, if NO errors.
 *               Pointer to NULL,        otherwise.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_DIR'.
 *********************************************************************************************************
 */
 
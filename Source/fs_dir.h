@@ -188,6 +188,9 @@ FS_QTY   FSDir_GetDirCntMax(void);                              /* Get maximum p
 void     FSDir_ModuleInit  (FS_QTY         dir_cnt,             /* Initialize directory module.                         */
                             FS_ERR        *p_err);
 
+CPU_BOOLEAN  FSDir_IsOpenAt(FS_VOL        *p_vol,               /* Test if dir at 1st clus is open.                     */
+                            CPU_INT32U     dir_first_clus);
+
 
 /*
 *********************************************************************************************************
@@ -110,6 +110,9 @@ static  void      FSEntry_CreateHandler   (CPU_CHAR       *name_full,       /* C
 static  void      FSEntry_DelHandler      (CPU_CHAR       *name_full,       /* Delete a file or directory.              */
                                            FS_FLAGS        entry_type,
                                            FS_ERR         *p_err);
+
+static  void      FSEntry_DelTreeHandler  (CPU_CHAR       *name_full,       /* Delete a file or directory tree.         */
+                                           FS_ERR         *p_err);
 #endif
 
 static  void      FSEntry_QueryHandler    (CPU_CHAR       *name_full,       /* Get info about a file or directory.      */
@@ -309,6 +312,9 @@ void  FSEntry_AttribSet (CPU_CHAR  *name_full,
 *               (2) If 'excl' is DEF_NO, 'name_full_dest' must either not exist or be an existing file;
 *                   it may not be an existing directory.  If 'excl' is DEF_YES, 'name_full_dest' must
 *                   not exist.
+*
+*               (3) The file is copied by 'FSEntry_CopyEx()' through a single sector buffer taken from
+*                   the buffer pool.  Use 'FSEntry_CopyEx()' with a larger buffer to copy large files.
 *********************************************************************************************************
 */
 
@@ -318,14 +324,111 @@ void  FSEntry_Copy (CPU_CHAR     *name_full_src,
                     CPU_BOOLEAN   excl,
                     FS_ERR       *p_err)
 {
-    FS_BUF       *p_buf;
-    CPU_BOOLEAN   done;
-    FS_ERR        err;
-    FS_FILE      *p_file_dest;
-    FS_FILE      *p_file_src;
-    CPU_SIZE_T    file_rd_len;
-    FS_FLAGS      mode;
-    CPU_BOOLEAN   no_err;
+    FSEntry_CopyEx(name_full_src,                               /* Copy through buf pool (see Note #3).                 */
+                   name_full_dest,
+                   excl,
+                   DEF_NULL,
+                   0u,
+                   p_err);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          FSEntry_CopyEx()
+*
+* Description : Copy a file through a caller-supplied buffer.
+*
+* Argument(s) : name_full_src   Name of the source      file.
+*
+*               name_full_dest  Name of the destination file.
+*
+*               excl            Indicates whether creation of new entry should be exclusive :
+*
+*                                   DEF_YES, if the entry will be copied ONLY if 'name_full_dest' does
+*                                                not exist.
+*                                   DEF_NO,  if the entry will be copied even if 'name_full_dest' does
+*                                                exist.
+*
+*               p_buf           Pointer to buffer used to move the file data, or NULL (see Note #3).
+*
+*               buf_size        Size of buffer, in octets.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE                      File copied successfully.
+*                                   FS_ERR_NAME_NULL                 Argument 'name_full_src'/'name_full_dest'
+*                                                                        passed a NULL pointer.
+*                                   FS_ERR_BUF_NONE_AVAIL            Buffer not available.
+*
+*                                                                    --------- RETURNED BY FSFile_Open() --------
+*                                                                    -------- RETURNED BY FSFile_Query() --------
+*                                                                    ------- RETURNED BY FSFile_Prealloc() ------
+*                                                                    --------- RETURNED BY FSFile_Rd() ----------
+*                                                                    --------- RETURNED BY FSFile_Wr() ----------
+*                                   FS_ERR_DEV                       Device access error.
+*                                   FS_ERR_DEV_FULL                  Device is full (no space could be allocated).
+*                                   FS_ERR_ENTRY_EXISTS              File system entry exists.
+*                                   FS_ERR_ENTRY_NOT_FILE            File system entry NOT a file.
+*                                   FS_ERR_ENTRY_NOT_FOUND           File system entry NOT found.
+*                                   FS_ERR_ENTRY_PARENT_NOT_FOUND    Entry parent NOT found.
+*                                   FS_ERR_ENTRY_PARENT_NOT_DIR      Entry parent NOT a directory.
+*                                   FS_ERR_ENTRY_RD_ONLY             File system entry marked read-only.
+*                                   FS_ERR_NAME_INVALID              Invalid file name or path.
+*                                   FS_ERR_VOL_NOT_OPEN              Volume was not open.
+*                                   FS_ERR_VOL_NOT_MOUNTED           Volume was not mounted.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FSEntry_Copy()  Notes #1 & #2'.
+*
+*               (2) Storage for the whole destination file is reserved with 'FSFile_Prealloc()' before any
+*                   data is copied, so the destination is laid out contiguously as long as the free space
+*                   on the volume is, & no cluster is allocated while the data is written.
+*
+*               (3) The data is moved in chunks that are a whole number of sectors.  Full sectors are
+*                   transferred directly between the device & the buffer, so each chunk is read & written
+*                   with as few device accesses as the source & destination layout allow.
+*
+*                   (a) If 'p_buf' is NULL, or if the buffer is smaller than one sector, a sector buffer
+*                       is taken from the buffer pool & the file is copied one sector at a time.
+*
+*                   (b) If asynchronous file requests are enabled & the buffer holds at least two
+*                       sectors, the buffer is split in two halves.  The next chunk is read into one half
+*                       by an asynchronous request while the current chunk is written from the other,
+*                       which overlaps the accesses when the files lie on different volumes.
+*
+*               (4) If the copy fails after the destination file was opened, the destination file is
+*                   deleted rather than left partially copied.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSEntry_CopyEx (CPU_CHAR     *name_full_src,
+                      CPU_CHAR     *name_full_dest,
+                      CPU_BOOLEAN   excl,
+                      void         *p_buf,
+                      CPU_SIZE_T    buf_size,
+                      FS_ERR       *p_err)
+{
+    FS_BUF              *p_fs_buf;
+    CPU_INT08U          *p_chunk;
+    CPU_INT08U          *p_chunk_next;
+    CPU_INT08U          *p_chunk_tmp;
+    CPU_SIZE_T           chunk_size;
+    CPU_SIZE_T           sec_size;
+    CPU_SIZE_T           rd_len;
+    CPU_SIZE_T           rd_len_next;
+    FS_ENTRY_INFO        info;
+    FS_ERR               err;
+    FS_ERR               err_rd;
+    FS_FILE             *p_file_dest;
+    FS_FILE             *p_file_src;
+    FS_FLAGS             mode;
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    FS_FILE_ASYNC_REQ   *p_req;
+#endif
 
 
 #if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
@@ -343,7 +446,7 @@ void  FSEntry_Copy (CPU_CHAR     *name_full_src,
 #endif
 
 
-                                                                /* --------------------- COPY FILE -------------------- */
+                                                                /* --------------------- OPEN FILES ------------------- */
                                                                 /* Open src file.                                       */
     p_file_src = FSFile_Open(name_full_src, FS_FILE_ACCESS_MODE_RD, p_err);
     if (p_file_src == DEF_NULL) {
@@ -354,6 +457,12 @@ void  FSEntry_Copy (CPU_CHAR     *name_full_src,
         }
     }
 
+    FSFile_Query(p_file_src, &info, p_err);                     /* Get src file size.                                   */
+    if (*p_err != FS_ERR_NONE) {
+        FSFile_Close(p_file_src, &err);
+        return;
+    }
+
     if (excl == DEF_YES) {
         mode =  FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_CREATE | FS_FILE_ACCESS_MODE_EXCL;
     } else {
@@ -365,42 +474,119 @@ void  FSEntry_Copy (CPU_CHAR     *name_full_src,
         return;
     }
 
-    p_buf = FSBuf_Get(DEF_NULL);
-    if (p_buf == DEF_NULL) {
-        FSFile_Close(p_file_src, &err);
-        FSFile_Close(p_file_dest, &err);
-       *p_err = FS_ERR_BUF_NONE_AVAIL;
-        return;
+
+                                                                /* -------------------- SET UP BUF -------------------- */
+    p_fs_buf     = DEF_NULL;
+    p_chunk      = (CPU_INT08U *)p_buf;
+    sec_size     = FS_MaxSecSizeGet();
+    chunk_size   = buf_size - (buf_size % sec_size);            /* Whole nbr of sec's (see Note #3).                    */
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    if (chunk_size >= (2u * sec_size)) {                        /* Split buf in two halves (see Note #3b).              */
+        chunk_size  /= 2u;
+        chunk_size  -= chunk_size % sec_size;
+    }
+#endif
+
+    if ((p_chunk    == DEF_NULL) ||
+        (chunk_size == 0u)) {                                   /* Use buf from pool (see Note #3a).                    */
+        p_fs_buf = FSBuf_Get(DEF_NULL);
+        if (p_fs_buf == DEF_NULL) {
+            FSFile_Close(p_file_src,  &err);
+            FSFile_Close(p_file_dest, &err);
+            FSEntry_Del(name_full_dest, FS_ENTRY_TYPE_FILE, &err);
+           *p_err = FS_ERR_BUF_NONE_AVAIL;
+            return;
+        }
+        p_chunk      = (CPU_INT08U *)p_fs_buf->DataPtr;
+        p_chunk_next =  p_chunk;
+        chunk_size   =  p_fs_buf->Size;
+
+    } else {
+        p_chunk_next = p_chunk;
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+        if (buf_size >= (2u * chunk_size)) {
+            p_chunk_next = p_chunk + chunk_size;
+        }
+#endif
     }
 
-                                                                /* Copy file.                                           */
-    done = DEF_NO;
-    do {
-        file_rd_len = FSFile_Rd(p_file_src,
-                                p_buf->DataPtr,
-                                p_buf->Size,
-                                p_err);
 
-        no_err = (*p_err == FS_ERR_NONE);
+                                                                /* --------------------- COPY FILE -------------------- */
+    FSFile_Prealloc(p_file_dest, info.Size, p_err);             /* Reserve dest storage (see Note #2).                  */
 
-        if ((file_rd_len > 0u) && no_err) {
-           (void)FSFile_Wr(p_file_dest,
-                           p_buf->DataPtr,
-                           file_rd_len,
+    rd_len = 0u;
+    if (*p_err == FS_ERR_NONE) {
+        rd_len = FSFile_Rd(p_file_src,                          /* Rd first chunk.                                      */
+                           p_chunk,
+                           chunk_size,
                            p_err);
+    }
 
-            if ((file_rd_len != p_buf->Size) || (*p_err != FS_ERR_NONE)) {
-                done = DEF_YES;
-            }
+    while ((*p_err == FS_ERR_NONE) &&
+           (rd_len >  0u)) {
+        rd_len_next = 0u;
+        err_rd      = FS_ERR_NONE;
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+        p_req = DEF_NULL;
+        if ((rd_len       == chunk_size) &&                     /* If more data may follow & buf is split ...           */
+            (p_chunk_next != p_chunk)) {
+            p_req = FSFile_AsyncRd(p_file_src,                  /* ... rd next chunk while cur is wr'n (see Note #3b).  */
+                                   p_chunk_next,
+                                   chunk_size,
+                                   DEF_NULL,
+                                   DEF_NULL,
+                                   0u,
+                                  &err_rd);
+        }
+#endif
 
-        } else {
-            done = DEF_YES;
+       (void)FSFile_Wr(p_file_dest,                             /* Wr cur chunk.                                        */
+                       p_chunk,
+                       rd_len,
+                       p_err);
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+        if (p_req != DEF_NULL) {                                /* Wait for next chunk.                                 */
+            rd_len_next = FSFile_AsyncWait(p_req, 0u, &err_rd);
         }
-    } while (done == DEF_NO);
+#endif
 
+        if ((rd_len       == chunk_size) &&                     /* If more data may follow & buf is NOT split ...       */
+            (p_chunk_next == p_chunk)    &&
+            (*p_err       == FS_ERR_NONE)) {
+            rd_len_next = FSFile_Rd(p_file_src,                 /* ... rd next chunk once cur is wr'n.                  */
+                                    p_chunk_next,
+                                    chunk_size,
+                                   &err_rd);
+        }
+
+        if (*p_err == FS_ERR_NONE) {
+           *p_err = err_rd;
+        }
+
+        p_chunk_tmp  = p_chunk;                                 /* Swap buf halves.                                     */
+        p_chunk      = p_chunk_next;
+        p_chunk_next = p_chunk_tmp;
+        rd_len       = rd_len_next;
+    }
+
+
+                                                                /* -------------------- CLOSE FILES ------------------- */
     FSFile_Close(p_file_src, &err);
     FSFile_Close(p_file_dest, &err);
-    FSBuf_Free  (p_buf);
+    if ((*p_err == FS_ERR_NONE) &&
+        (err    != FS_ERR_NONE)) {
+       *p_err = err;
+    }
+
+    if (*p_err != FS_ERR_NONE) {                                /* Del partial copy (see Note #4).                      */
+        FSEntry_Del(name_full_dest, FS_ENTRY_TYPE_FILE, &err);
+    }
+
+    if (p_fs_buf != DEF_NULL) {
+        FSBuf_Free(p_fs_buf);
+    }
 }
 #endif
 
@@ -632,6 +818,104 @@ void  FSEntry_Del (CPU_CHAR     *name_full,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                          FSEntry_DelTree()
+*
+* Description : Delete a file, or a directory & every file & directory in its tree.
+*
+* Argument(s) : name_full   Name of the entry.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                     Entry deleted successfully.
+*                               FS_ERR_NAME_NULL                Argument 'name_full' passed a NULL pointer.
+*                               FS_ERR_ENTRY_ROOT_DIR           File system entry is a root directory (see Note #2).
+*                               FS_ERR_VOL_INVALID_OP           Invalid operation on volume.
+*                               FS_ERR_ENTRY_OPEN               Open entry cannot be deleted.
+*
+*                                                                ------ RETURNED BY FSFile_IsOpen() -------
+*                                                                ----------- AND BY FSDir_IsOpen() --------
+*                               FS_ERR_BUF_NONE_AVAIL           No buffer available.
+*                               FS_ERR_NAME_INVALID             Invalid name or path.
+*                               FS_ERR_VOL_INVALID_SEC_NBR      Invalid sector number found in directory
+*
+*                                                                --- RETURNED BY FSEntry_NameParseChk() ---
+*                               FS_ERR_NAME_INVALID              Entry name specified invalid OR volume
+*                                                                    could not be found.
+*                               FS_ERR_NAME_PATH_TOO_LONG        Entry name specified too long.
+*                               FS_ERR_VOL_NOT_OPEN              Volume was not open.
+*                               FS_ERR_VOL_NOT_MOUNTED           Volume was not mounted.
+*
+*                                                                ---- RETURNED BY FSSys_EntryDelTree() ----
+*                               FS_ERR_BUF_NONE_AVAIL            Buffer not available.
+*                               FS_ERR_DEV                       Device access error.
+*                               FS_ERR_ENTRY_CORRUPT             File system entry is corrupt.
+*                               FS_ERR_ENTRY_NOT_FOUND           File system entry NOT found.
+*                               FS_ERR_ENTRY_OPEN                Open entry found in tree.
+*                               FS_ERR_ENTRY_PARENT_NOT_FOUND    Entry parent NOT found.
+*                               FS_ERR_ENTRY_PARENT_NOT_DIR      Entry parent NOT a directory.
+*                               FS_ERR_NAME_INVALID              Invalid file name or path.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The tree is walked & deleted in a single pass under the volume lock, rather than by
+*                   reading each directory & deleting each entry through 'FSEntry_Del()'.  Directory
+*                   sectors & FAT sectors are rewritten once per pass rather than once per entry.
+*
+*               (2) The root directory cannot be deleted.
+*
+*               (3) Read-only entries in the tree are deleted, as by 'FSEntry_Del()'.
+*
+*               (4) If an open file or directory is found in the tree, the deletion stops & returns
+*                   FS_ERR_ENTRY_OPEN; the entries already deleted are not restored.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSEntry_DelTree (CPU_CHAR  *name_full,
+                       FS_ERR    *p_err)
+{
+    CPU_CHAR  *name_full_temp;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE PTR ------------------- */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_full == (CPU_CHAR *)0) {                           /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+#endif
+
+
+
+                                                                /* ------------------ FORM FULL PATH ------------------ */
+#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
+    name_full_temp = FS_WorkingDirPathForm(name_full, p_err);   /* Try to form path.                                    */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+#else
+    name_full_temp = name_full;
+#endif
+
+
+
+                                                                /* ------------------- DEL ENTRY TREE ----------------- */
+    FSEntry_DelTreeHandler(name_full_temp,
+                           p_err);
+
+#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
+    if (name_full_temp != name_full) {
+        FS_WorkingDirObjFree(name_full_temp);
+    }
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                           FSEntry_Query()
@@ -1327,6 +1611,91 @@ static  void  FSEntry_DelHandler (CPU_CHAR  *name_full,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                      FSEntry_DelTreeHandler()
+*
+* Description : Delete a file, or a directory & every file & directory in its tree.
+*
+* Argument(s) : name_full       Name of the entry.
+*               ---------       Argument validated by caller.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               -----           Argument validated by caller.
+*
+*                               See 'FSEntry_DelTree()'.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Open entries within the tree are detected by the file system driver while it walks
+*                   the tree.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSEntry_DelTreeHandler (CPU_CHAR  *name_full,
+                                      FS_ERR    *p_err)
+{
+    CPU_CHAR     *name_entry;
+    FS_VOL       *p_vol;
+    FS_FLAGS      mode;
+    CPU_BOOLEAN   entry_open;
+
+
+                                                                /* --------------- VERIFY IF ENTRY OPEN --------------- */
+    entry_open = FSFile_IsOpen(name_full, &mode, p_err);
+    if (*p_err == FS_ERR_ENTRY_NOT_FILE) {                      /* Entry is a dir.                                      */
+       *p_err = FS_ERR_NONE;
+    }
+#ifdef   FS_DIR_MODULE_PRESENT
+    if (entry_open == DEF_NO) {
+        entry_open = FSDir_IsOpen(name_full, p_err);
+    }
+#endif
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+    if (entry_open == DEF_YES) {
+       *p_err = FS_ERR_ENTRY_OPEN;
+        return;
+    }
+
+                                                                /* ---------------------- GET VOL --------------------- */
+    name_entry = FSEntry_NameParseChk(name_full,
+                                     &p_vol,
+                                      p_err);
+    if (( p_vol      == (FS_VOL   *)0) ||                       /* Rtn err if no vol found ...                          */
+        ( name_entry == (CPU_CHAR *)0) ||                       /*                         ... or if name illegal ...   */
+        (*p_err      !=  FS_ERR_NONE)) {                        /*                         ... or if there is an error. */
+        return;
+    }
+
+                                                                /* Chk vol mode.                                        */
+    if (DEF_BIT_IS_CLR(p_vol->AccessMode, FS_VOL_ACCESS_MODE_WR)== DEF_YES) {
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_VOL_INVALID_OP;
+        return;
+    }
+
+
+                                                                /* ------------------- DEL ENTRY TREE ----------------- */
+    if (name_entry[0] == (CPU_CHAR)ASCII_CHAR_NULL) {           /* Rtn err if entry specifies root dir.                 */
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_ENTRY_ROOT_DIR;
+        return;
+    }
+
+    FSSys_EntryDelTree(p_vol,                                   /* See Note #1.                                         */
+                       name_entry,
+                       p_err);
+
+
+                                                                /* ----------------- RELEASE VOL & RTN ---------------- */
+    FSVol_ReleaseUnlock(p_vol);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                       FSEntry_QueryHandler()
@@ -156,6 +156,13 @@ void      FSEntry_Copy     (CPU_CHAR       *name_full_src,      /* Copy a file.
                             CPU_BOOLEAN     excl,
                             FS_ERR         *p_err);
 
+void      FSEntry_CopyEx   (CPU_CHAR       *name_full_src,      /* Copy a file through a caller-supplied buf.           */
+                            CPU_CHAR       *name_full_dest,
+                            CPU_BOOLEAN     excl,
+                            void           *p_buf,
+                            CPU_SIZE_T      buf_size,
+                            FS_ERR         *p_err);
+
 void      FSEntry_Create   (CPU_CHAR       *name_full,          /* Create a file or directory.                          */
                             FS_FLAGS        entry_type,
                             CPU_BOOLEAN     excl,
@@ -164,6 +171,9 @@ void      FSEntry_Create   (CPU_CHAR       *name_full,          /* Create a file
 void      FSEntry_Del      (CPU_CHAR       *name_full,          /* Delete a file or directory.                          */
                             FS_FLAGS        entry_type,
                             FS_ERR         *p_err);
+
+void      FSEntry_DelTree  (CPU_CHAR       *name_full,          /* Delete a file or directory tree.                     */
+                            FS_ERR         *p_err);
 #endif
 
 void      FSEntry_Query    (CPU_CHAR       *name_full,          /* Get information about a file or directory.           */
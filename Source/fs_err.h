@@ -368,9 +368,11 @@ typedef enum fs_err {
 
     FS_ERR_OS_LOCK                              =  1501u,
     FS_ERR_OS_LOCK_TIMEOUT                      =  1502u,
+    FS_ERR_OS_TIMEOUT                           =  1503u,
     FS_ERR_OS_INIT                              =  1510u,
     FS_ERR_OS_INIT_LOCK                         =  1511u,
-    FS_ERR_OS_INIT_LOCK_NAME                    =  1512u
+    FS_ERR_OS_INIT_LOCK_NAME                    =  1512u,
+    FS_ERR_OS_INIT_TASK                         =  1513u
 
 } FS_ERR;
 
@@ -45,6 +45,7 @@
 #include  <lib_mem.h>
 #include  "fs.h"
 #include  "fs_buf.h"
+#include  "fs_cache.h"
 #include  "fs_dev.h"
 #include  "fs_file.h"
 #include  "fs_sys.h"
@@ -95,6 +96,16 @@ FS_STATIC  FS_FILE   **FSFile_Tbl;                              /* Tbl of files.
 FS_STATIC  FS_QTY      FSFile_FileCntMax;                       /* Maximum number of open files.                        */
 FS_STATIC  FS_QTY      FSFile_Cnt;
 
+FS_STATIC  FS_FILE   **FSFile_HashTbl;                          /* Hash tbl of open files (see 'FSFile_HashIxGet()').   */
+FS_STATIC  FS_QTY      FSFile_HashTblSize;                      /* Nbr of hash tbl buckets (power of 2).                */
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+FS_STATIC  FS_FILE_ASYNC_REQ  *FSFile_AsyncReqTbl;              /* Tbl of async req's.                                  */
+FS_STATIC  FS_FILE_ASYNC_REQ  *FSFile_AsyncReqFreePtr;          /* Ptr to head of free async req list.                  */
+FS_STATIC  FS_FILE            *FSFile_AsyncRdyHeadPtr;          /* Ptr to head of async rdy file list.                  */
+FS_STATIC  FS_FILE            *FSFile_AsyncRdyTailPtr;          /* Ptr to tail of async rdy file list.                  */
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -118,6 +129,26 @@ static  CPU_SIZE_T   FSFile_BufWr             (FS_FILE       *p_file,       /* W
                                                CPU_SIZE_T     size,
                                                FS_ERR        *p_err);
 #endif
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  void         FSFile_BufStreamWait     (FS_FILE       *p_file,       /* Wait for stream buffer flush.            */
+                                               FS_ERR        *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  CPU_SIZE_T   FSFile_BufStreamWr       (FS_FILE       *p_file,       /* Write to a file (through stream buffer). */
+                                               void          *p_src,
+                                               CPU_SIZE_T     size,
+                                               FS_ERR        *p_err);
+#endif
+#endif
+#endif
+
+
+                                                                            /* -------------- FILE DATA --------------- */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void          FSFile_SizeExtend       (FS_FILE       *p_file,       /* Extend a file with zeros.                */
+                                               FS_FILE_SIZE   size,
+                                               FS_ERR        *p_err);
 #endif
 
 
@@ -125,13 +156,25 @@ static  CPU_SIZE_T   FSFile_BufWr             (FS_FILE       *p_file,       /* W
 static  FS_FILE      *FSFile_AcquireLockChk   (FS_FILE       *p_file,       /* Acquire file reference & lock.           */
                                                FS_ERR        *p_err);
 
+static  FS_FILE      *FSFile_AcquireLockChkEx (FS_FILE       *p_file,       /* Acquire file reference & lock.           */
+                                               CPU_BOOLEAN    lock_shared,
+                                               FS_ERR        *p_err);
+
+static  FS_FILE      *FSFile_AcquireVolLockChk(FS_FILE       *p_file,       /* Acquire file reference & vol lock.       */
+                                               CPU_BOOLEAN   *p_lock_shared,
+                                               FS_ERR        *p_err);
+
 static  FS_FILE      *FSFile_Acquire          (FS_FILE       *p_file);      /* Acquire file reference.                  */
 
 static  void          FSFile_ReleaseUnlock    (FS_FILE       *p_file);      /* Release file reference & lock.           */
 
+static  void          FSFile_ReleaseVolUnlock (FS_FILE       *p_file,       /* Release file reference & vol lock.       */
+                                               CPU_BOOLEAN    lock_shared);
+
 static  void          FSFile_Release          (FS_FILE       *p_file);      /* Release file reference.                  */
 
-static  CPU_BOOLEAN   FSFile_Lock             (FS_FILE       *p_file);      /* Acquire file lock.                       */
+static  CPU_BOOLEAN   FSFile_Lock             (FS_FILE       *p_file,       /* Acquire file lock.                       */
+                                               CPU_BOOLEAN    lock_shared);
 
 static  void          FSFile_Unlock           (FS_FILE       *p_file);      /* Release file lock.                       */
 
@@ -154,11 +197,71 @@ static  void          FSFile_ObjFree          (FS_FILE       *p_file);      /* F
 static  FS_FILE      *FSFile_ObjGet           (FS_ERR        *p_err);       /* Allocate a file object.                  */
 
 
+                                                                            /* ----------- OPEN FILE INDEX ------------ */
+static  FS_QTY        FSFile_HashIxGet        (FS_VOL        *p_vol,        /* Get hash tbl ix of dir entry loc.        */
+                                               FS_SEC_NBR     dir_sec,
+                                               FS_SEC_SIZE    dir_sec_pos);
+
+static  void          FSFile_HashAdd          (FS_FILE       *p_file,       /* Add    file to   open file hash tbl.     */
+                                               FS_ERR        *p_err);
+
+static  void          FSFile_HashRemove       (FS_FILE       *p_file,       /* Remove file from open file hash tbl.     */
+                                               FS_ERR        *p_err);
+
+
+                                                                            /* ------------ ASYNC REQUESTS ------------ */
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  FS_FILE_ASYNC_REQ  *FSFile_AsyncSubmit (FS_FILE              *p_file,  /* Submit async req.                     */
+                                               CPU_INT08U            op,
+                                               void                 *p_buf,
+                                               CPU_SIZE_T            size,
+                                               FS_FILE_ASYNC_CALLBACK callback,
+                                               void                 *p_callback_arg,
+                                               CPU_INT32U            timeout,
+                                               FS_ERR               *p_err);
+
+static  FS_FILE_ASYNC_REQ  *FSFile_AsyncReqAlloc(CPU_INT32U           timeout, /* Alloc async req.                      */
+                                               FS_ERR              *p_err);
+
+static  CPU_BOOLEAN   FSFile_AsyncReqAdd      (FS_FILE            *p_file,  /* Queue async req on file.                */
+                                               FS_FILE_ASYNC_REQ  *p_req);
+
+static  void          FSFile_AsyncReqExec     (FS_FILE_ASYNC_REQ  *p_req);   /* Service async req.                      */
+
+static  void          FSFile_AsyncReqFree     (FS_FILE_ASYNC_REQ  *p_req);   /* Free async req.                         */
+
+static  void          FSFile_AsyncRdyAdd      (FS_FILE            *p_file);  /* Add file to async rdy list.             */
+#endif
+
+
+                                                                            /* ------------------ OPEN ---------------- */
+static  FS_FILE      *FSFile_OpenHandler      (CPU_CHAR      *name_full,    /* Open a file.                             */
+                                               FS_VOL_HANDLE *p_vol_handle,
+                                               FS_FLAGS       mode,
+                                               FS_ERR        *p_err);
+
+static  CPU_BOOLEAN   FSFile_IsOpenLocked     (FS_VOL        *p_vol,        /* Test if file is open on locked volume.   */
+                                               CPU_CHAR      *name_file,
+                                               FS_FLAGS      *p_mode,
+                                               FS_ERR        *p_err);
+
+
                                                                             /* ------------- NAME PARSING ------------- */
 static  CPU_CHAR     *FSFile_NameParseChk     (CPU_CHAR      *name_full,    /* Parse full file name & get volume ptr.   */
                                                FS_VOL       **pp_vol,
                                                FS_ERR        *p_err);
 
+static  CPU_CHAR     *FSFile_NameHandleChk    (CPU_CHAR      *name_file,    /* Chk file name & get volume ptr.          */
+                                               FS_VOL_HANDLE  vol_handle,
+                                               FS_VOL       **pp_vol,
+                                               FS_ERR        *p_err);
+
+static  CPU_CHAR     *FSFile_NameChk          (CPU_CHAR      *name_entry,   /* Chk entry name len's.                    */
+                                               FS_ERR        *p_err);
+
+static  CPU_BOOLEAN   FSFile_VolLockChk       (FS_VOL        *p_vol,        /* Acquire vol lock & chk vol is mounted.   */
+                                               FS_ERR        *p_err);
+
 
 /*
 *********************************************************************************************************
@@ -167,6 +270,409 @@ static  CPU_CHAR     *FSFile_NameParseChk     (CPU_CHAR      *name_full,    /* P
 */
 
 
+/*
+*********************************************************************************************************
+*                                         FSFile_AsyncClose()
+*
+* Description : Submit an asynchronous close of a file.
+*
+* Argument(s) : p_file          Pointer to a file.
+*
+*               callback        Completion callback, or NULL if the request will be reaped with
+*                               'FSFile_AsyncWait()'.
+*
+*               p_callback_arg  Argument passed to 'callback'.
+*
+*               timeout         If non-zero, maximum time to wait for a free request (in milliseconds).
+*                               If zero,     wait forever.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE             Request submitted.
+*                                   FS_ERR_NULL_PTR         Argument 'p_file' passed a NULL pointer.
+*
+*                                                           ------- RETURNED BY FSFile_AsyncSubmit() --------
+*                                   FS_ERR_FILE_NOT_OPEN    File NOT open.
+*                                   FS_ERR_FILE_INVALID_OP  File buffer is in stream mode.
+*                                   FS_ERR_OS_TIMEOUT       No request freed before timeout.
+*
+* Return(s)   : Pointer to request, if NO errors & 'callback' is NULL.
+*               Pointer to NULL,    otherwise.
+*
+* Note(s)     : (1) See 'FSFile_AsyncRd()  Notes #1-#4'.
+*
+*               (2) The file is closed as by 'FSFile_Close()' once every request previously submitted on
+*                   it has been serviced.  Requests submitted on the file afterwards fail with
+*                   FS_ERR_FILE_NOT_OPEN.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+FS_FILE_ASYNC_REQ  *FSFile_AsyncClose (FS_FILE                 *p_file,
+                                       FS_FILE_ASYNC_CALLBACK   callback,
+                                       void                    *p_callback_arg,
+                                       CPU_INT32U               timeout,
+                                       FS_ERR                  *p_err)
+{
+    FS_FILE_ASYNC_REQ  *p_req;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION((FS_FILE_ASYNC_REQ *)0);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return ((FS_FILE_ASYNC_REQ *)0);
+    }
+#endif
+
+    p_req = FSFile_AsyncSubmit(p_file,
+                               FS_FILE_ASYNC_OP_CLOSE,
+                               DEF_NULL,
+                               0u,
+                               callback,
+                               p_callback_arg,
+                               timeout,
+                               p_err);
+
+    return (p_req);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FSFile_AsyncFlush()
+*
+* Description : Submit an asynchronous flush of a file's buffer.
+*
+* Argument(s) : p_file          Pointer to a file.
+*
+*               callback        Completion callback, or NULL if the request will be reaped with
+*                               'FSFile_AsyncWait()'.
+*
+*               p_callback_arg  Argument passed to 'callback'.
+*
+*               timeout         If non-zero, maximum time to wait for a free request (in milliseconds).
+*                               If zero,     wait forever.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE             Request submitted.
+*                                   FS_ERR_NULL_PTR         Argument 'p_file' passed a NULL pointer.
+*
+*                                                           ------- RETURNED BY FSFile_AsyncSubmit() --------
+*                                   FS_ERR_FILE_NOT_OPEN    File NOT open.
+*                                   FS_ERR_FILE_INVALID_OP  File buffer is in stream mode.
+*                                   FS_ERR_OS_TIMEOUT       No request freed before timeout.
+*
+* Return(s)   : Pointer to request, if NO errors & 'callback' is NULL.
+*               Pointer to NULL,    otherwise.
+*
+* Note(s)     : (1) See 'FSFile_AsyncRd()  Notes #1-#4'.
+*
+*               (2) The file buffer is flushed as by 'FSFile_BufFlush()'.  If file buffers are disabled,
+*                   the request completes without accessing the file.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+FS_FILE_ASYNC_REQ  *FSFile_AsyncFlush (FS_FILE                 *p_file,
+                                       FS_FILE_ASYNC_CALLBACK   callback,
+                                       void                    *p_callback_arg,
+                                       CPU_INT32U               timeout,
+                                       FS_ERR                  *p_err)
+{
+    FS_FILE_ASYNC_REQ  *p_req;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION((FS_FILE_ASYNC_REQ *)0);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return ((FS_FILE_ASYNC_REQ *)0);
+    }
+#endif
+
+    p_req = FSFile_AsyncSubmit(p_file,
+                               FS_FILE_ASYNC_OP_FLUSH,
+                               DEF_NULL,
+                               0u,
+                               callback,
+                               p_callback_arg,
+                               timeout,
+                               p_err);
+
+    return (p_req);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          FSFile_AsyncRd()
+*
+* Description : Submit an asynchronous read from a file.
+*
+* Argument(s) : p_file          Pointer to a file.
+*
+*               p_dest          Pointer to destination buffer.
+*
+*               size            Number of octets to read.
+*
+*               callback        Completion callback, or NULL if the request will be reaped with
+*                               'FSFile_AsyncWait()'.
+*
+*               p_callback_arg  Argument passed to 'callback'.
+*
+*               timeout         If non-zero, maximum time to wait for a free request (in milliseconds).
+*                               If zero,     wait forever.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE             Request submitted.
+*                                   FS_ERR_NULL_PTR         Argument 'p_file'/'p_dest' passed a NULL pointer.
+*
+*                                                           ------- RETURNED BY FSFile_AsyncSubmit() --------
+*                                   FS_ERR_FILE_NOT_OPEN    File NOT open.
+*                                   FS_ERR_FILE_INVALID_OP  File buffer is in stream mode.
+*                                   FS_ERR_OS_TIMEOUT       No request freed before timeout.
+*
+* Return(s)   : Pointer to request, if NO errors & 'callback' is NULL.
+*               Pointer to NULL,    otherwise.
+*
+* Note(s)     : (1) Requests submitted on a file are serviced one at a time, in submission order, by one of
+*                   the worker tasks.  Requests on different files may be serviced in parallel.
+*
+*                   (a) Each request operates on the file position left by the previous request, exactly
+*                       as if the file functions had been called in submission order.
+*
+*                   (b) Calls made directly on the file while requests are pending are NOT ordered with
+*                       respect to these requests.
+*
+*                   (c) If file locking is enabled, a file locked by a task with 'FSFile_LockGet()' is
+*                       NOT serviced until that task releases the lock.
+*
+*               (2) If every request is pending, the caller waits for a request to be freed, for at most
+*                   'timeout' milliseconds.
+*
+*               (3) (a) If 'callback' is NOT NULL, it is called from the worker task once the request has
+*                       been serviced, & the request is then freed.  NULL is returned.
+*
+*                   (b) Otherwise, the request MUST be reaped with 'FSFile_AsyncWait()'.
+*
+*               (4) The buffer MUST NOT be accessed by the application until the request has completed.
+*
+*               (5) The data is read as by 'FSFile_Rd()'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+FS_FILE_ASYNC_REQ  *FSFile_AsyncRd (FS_FILE                 *p_file,
+                                    void                    *p_dest,
+                                    CPU_SIZE_T               size,
+                                    FS_FILE_ASYNC_CALLBACK   callback,
+                                    void                    *p_callback_arg,
+                                    CPU_INT32U               timeout,
+                                    FS_ERR                  *p_err)
+{
+    FS_FILE_ASYNC_REQ  *p_req;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION((FS_FILE_ASYNC_REQ *)0);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return ((FS_FILE_ASYNC_REQ *)0);
+    }
+    if (p_dest == (void *)0) {                                  /* Validate dest ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return ((FS_FILE_ASYNC_REQ *)0);
+    }
+#endif
+
+    p_req = FSFile_AsyncSubmit(p_file,
+                               FS_FILE_ASYNC_OP_RD,
+                               p_dest,
+                               size,
+                               callback,
+                               p_callback_arg,
+                               timeout,
+                               p_err);
+
+    return (p_req);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FSFile_AsyncWait()
+*
+* Description : Wait for an asynchronous request to complete & free it.
+*
+* Argument(s) : p_req       Pointer to request returned when the request was submitted.
+*
+*               timeout     If non-zero, maximum time to wait (in milliseconds).
+*                           If zero,     wait forever.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NULL_PTR         Argument 'p_req' passed a NULL pointer.
+*                               FS_ERR_INVALID_ARG      Request NOT pending, or completed through a callback.
+*                               FS_ERR_OS_TIMEOUT       Request NOT completed before timeout.
+*                               FS_ERR_OS_LOCK          OS lock NOT acquired.
+*
+*                                                       ----------- RETURNED BY FILE OPERATION -----------
+*                               FS_ERR_NONE             Request completed without error.
+*                               ...                     Error returned by the file operation.
+*
+* Return(s)   : Number of octets read or written, if request completed.
+*               0,                                otherwise.
+*
+* Note(s)     : (1) If the request completes, it is freed & MUST NOT be accessed anymore.  If the wait
+*                   times out, the request remains pending & may be waited for again.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+CPU_SIZE_T  FSFile_AsyncWait (FS_FILE_ASYNC_REQ  *p_req,
+                              CPU_INT32U          timeout,
+                              FS_ERR             *p_err)
+{
+    CPU_SIZE_T   size;
+    FS_ERR       err;
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
+    CPU_BOOLEAN  valid;
+#endif
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(0u);
+    }
+    if (p_req == (FS_FILE_ASYNC_REQ *)0) {                      /* Validate req ptr.                                    */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+                                                                /* Validate req state.                                  */
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+    valid = ((p_req->State        != FS_FILE_ASYNC_REQ_STATE_FREE) &&
+             (p_req->CallbackFnct == (FS_FILE_ASYNC_CALLBACK)0)) ? DEF_YES : DEF_NO;
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+
+    if (valid == DEF_NO) {
+       *p_err = FS_ERR_INVALID_ARG;
+        return (0u);
+    }
+#endif
+
+                                                                /* ---------------- WAIT FOR COMPLETION --------------- */
+    FS_OS_FileAsyncReqPend(p_req->ID, timeout, p_err);
+    if (*p_err != FS_ERR_NONE) {                                /* Req still pending (see Note #1).                     */
+        return (0u);
+    }
+
+    size = p_req->SizeDone;
+    err  = p_req->Err;
+
+    FSFile_AsyncReqFree(p_req);
+
+   *p_err = err;
+    return (size);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          FSFile_AsyncWr()
+*
+* Description : Submit an asynchronous write to a file.
+*
+* Argument(s) : p_file          Pointer to a file.
+*
+*               p_src           Pointer to source buffer.
+*
+*               size            Number of octets to write.
+*
+*               callback        Completion callback, or NULL if the request will be reaped with
+*                               'FSFile_AsyncWait()'.
+*
+*               p_callback_arg  Argument passed to 'callback'.
+*
+*               timeout         If non-zero, maximum time to wait for a free request (in milliseconds).
+*                               If zero,     wait forever.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE             Request submitted.
+*                                   FS_ERR_NULL_PTR         Argument 'p_file'/'p_src' passed a NULL pointer.
+*
+*                                                           ------- RETURNED BY FSFile_AsyncSubmit() --------
+*                                   FS_ERR_FILE_NOT_OPEN    File NOT open.
+*                                   FS_ERR_FILE_INVALID_OP  File buffer is in stream mode.
+*                                   FS_ERR_OS_TIMEOUT       No request freed before timeout.
+*
+* Return(s)   : Pointer to request, if NO errors & 'callback' is NULL.
+*               Pointer to NULL,    otherwise.
+*
+* Note(s)     : (1) See 'FSFile_AsyncRd()  Notes #1-#4'.
+*
+*               (2) The data is written as by 'FSFile_Wr()'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+#if (FS_CFG_RD_ONLY_EN    == DEF_DISABLED)
+FS_FILE_ASYNC_REQ  *FSFile_AsyncWr (FS_FILE                 *p_file,
+                                    void                    *p_src,
+                                    CPU_SIZE_T               size,
+                                    FS_FILE_ASYNC_CALLBACK   callback,
+                                    void                    *p_callback_arg,
+                                    CPU_INT32U               timeout,
+                                    FS_ERR                  *p_err)
+{
+    FS_FILE_ASYNC_REQ  *p_req;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION((FS_FILE_ASYNC_REQ *)0);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return ((FS_FILE_ASYNC_REQ *)0);
+    }
+    if (p_src == (void *)0) {                                   /* Validate src ptr.                                    */
+       *p_err = FS_ERR_NULL_PTR;
+        return ((FS_FILE_ASYNC_REQ *)0);
+    }
+#endif
+
+    p_req = FSFile_AsyncSubmit(p_file,
+                               FS_FILE_ASYNC_OP_WR,
+                               p_src,
+                               size,
+                               callback,
+                               p_callback_arg,
+                               timeout,
+                               p_err);
+
+    return (p_req);
+}
+#endif
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FSFile_BufAssign()
@@ -179,9 +685,11 @@ static  CPU_CHAR     *FSFile_NameParseChk     (CPU_CHAR      *name_full,    /* P
 *
 *               mode        Buffer mode :
 *
-*                               FS_FILE_BUF_MODE_RD       Data buffered for reads.
-*                               FS_FILE_BUF_MODE_WR       Data buffered for writes.
-*                               FS_FILE_BUF_MODE_RD_WR    Data buffered for reads & writes.
+*                               FS_FILE_BUF_MODE_RD           Data buffered for reads.
+*                               FS_FILE_BUF_MODE_WR           Data buffered for writes.
+*                               FS_FILE_BUF_MODE_RD_WR        Data buffered for reads & writes.
+*                               FS_FILE_BUF_MODE_WR_STREAM    Data buffered for writes & flushed in
+*                                                                 background (see Note #5).
 *
 *               size        Size of buffer, in octets.
 *
@@ -213,6 +721,16 @@ static  CPU_CHAR     *FSFile_NameParseChk     (CPU_CHAR      *name_full,    /* P
 *                   re-opened.
 *
 *               (4) Upon power loss, any data stored in file buffers will be lost.
+*
+*               (5) Stream mode is available only if asynchronous file requests are enabled (see
+*                  'FSFile_AsyncModuleInit()').
+*
+*                   (a) The buffer is split into two halves, each rounded DOWN to a multiple of the cluster
+*                       size of the volume, or to a multiple of the sector size if a half is smaller than
+*                       one cluster.  'size' MUST be more than or equal to the size of two sectors.
+*
+*                   (b) While one half is written to the file by a worker task, the other half is filled.
+*                       See 'FSFile_BufStreamWr()  Note(s)'.
 *********************************************************************************************************
 */
 
@@ -226,7 +744,11 @@ void  FSFile_BufAssign (FS_FILE     *p_file,
     FS_FLAGS    access_mode;
     FS_STATE    buf_status;
     CPU_SIZE_T  sec_size;
+    CPU_SIZE_T  size_min;
     CPU_SIZE_T  size_rem;
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    CPU_SIZE_T  align_size;
+#endif
 
 
 #if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
@@ -247,11 +769,18 @@ void  FSFile_BufAssign (FS_FILE     *p_file,
     }
     if ((mode != FS_FILE_BUF_MODE_RD) &&                        /* Validate cache mode.                                 */
         (mode != FS_FILE_BUF_MODE_WR) &&
-        (mode != FS_FILE_BUF_MODE_RD_WR)) {
+        (mode != FS_FILE_BUF_MODE_RD_WR) &&
+        (mode != FS_FILE_BUF_MODE_WR_STREAM)) {
+       *p_err = FS_ERR_FILE_INVALID_BUF_MODE;
+        return;
+    }
+#if (FS_CFG_FILE_ASYNC_EN == DEF_DISABLED)
+    if (mode == FS_FILE_BUF_MODE_WR_STREAM) {                   /* Validate stream mode (see Note #5).                  */
        *p_err = FS_ERR_FILE_INVALID_BUF_MODE;
         return;
     }
 #endif
+#endif
 
 
 
@@ -265,15 +794,20 @@ void  FSFile_BufAssign (FS_FILE     *p_file,
 
                                                                 /* ------------------- VALIDATE BUF ------------------- */
     sec_size = (CPU_SIZE_T)p_file->BufSecSize;
-    if (size < sec_size) {                                      /* Rtn err if size is less than sec size.               */
+    size_min =  sec_size;
+    if (mode == FS_FILE_BUF_MODE_WR_STREAM) {                   /* Stream buf holds two halves (see Note #5a).          */
+        size_min *= 2u;
+    }
+    if (size < size_min) {                                      /* Rtn err if size is less than min size.               */
        *p_err = FS_ERR_FILE_INVALID_BUF_SIZE;
         FSFile_ReleaseUnlock(p_file);
         return;
     }
 
     access_mode = p_file->AccessMode;                           /* If buf mode does not match access mode ... rtn err.  */
-    if (((mode == FS_FILE_BUF_MODE_RD) && (DEF_BIT_IS_SET(access_mode, FS_FILE_ACCESS_MODE_RD) == DEF_NO)) ||
-        ((mode == FS_FILE_BUF_MODE_WR) && (DEF_BIT_IS_SET(access_mode, FS_FILE_ACCESS_MODE_WR) == DEF_NO))) {
+    if (((mode == FS_FILE_BUF_MODE_RD)        && (DEF_BIT_IS_SET(access_mode, FS_FILE_ACCESS_MODE_RD) == DEF_NO)) ||
+        ((mode == FS_FILE_BUF_MODE_WR)        && (DEF_BIT_IS_SET(access_mode, FS_FILE_ACCESS_MODE_WR) == DEF_NO)) ||
+        ((mode == FS_FILE_BUF_MODE_WR_STREAM) && (DEF_BIT_IS_SET(access_mode, FS_FILE_ACCESS_MODE_WR) == DEF_NO))) {
        *p_err = FS_ERR_FILE_INVALID_BUF_MODE;
         FSFile_ReleaseUnlock(p_file);
         return;
@@ -292,8 +826,23 @@ void  FSFile_BufAssign (FS_FILE     *p_file,
                                                                 /* Rnd size DOWN to nearest sec size mult (see Note #2).*/
     size_rem           = size % sec_size;
     size              -= size_rem;
-    p_file->BufMode    = mode;
-    p_file->BufStatus  = FS_FILE_BUF_STATUS_EMPTY;
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    if (mode == FS_FILE_BUF_MODE_WR_STREAM) {                   /* Split buf in two halves (see Note #5a).              */
+        size      /= 2u;
+        align_size = (CPU_SIZE_T)FSSys_VolClusSizeGet(p_file->VolPtr);
+        if ((align_size == 0u) || (align_size > size)) {
+            align_size = sec_size;
+        }
+        size      -= size % align_size;
+
+        p_file->BufAltPtr    = (void *)((CPU_INT08U *)p_buf + size);
+        p_file->BufAlignSize =  align_size;
+    }
+#endif
+
+    p_file->BufMode    = mode;
+    p_file->BufStatus  = FS_FILE_BUF_STATUS_EMPTY;
     p_file->BufStart   = 0u;
     p_file->BufMaxPos  = 0u;
     p_file->BufSize    = size;
@@ -426,6 +975,9 @@ void  FSFile_BufFlush (FS_FILE  *p_file,
 *                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
 *                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
 *
+*                                                       ------------ RETURNED BY FS_OS_Lock() -----------
+*                               FS_ERR_OS_LOCK          OS lock NOT acquired.
+*
 * Return(s)   : none.
 *
 * Note(s)     : (1) After a file is closed, the application must desist from accessing its file pointer.
@@ -437,6 +989,12 @@ void  FSFile_BufFlush (FS_FILE  *p_file,
 *
 *                   (b) Any buffer assigned with 'FSFile_BufAssign()' shall no longer be accessed by the
 *                       file system & may be re-used by the application.
+*
+*                   (c) Any pending flush of a stream buffer completes before the file lock is acquired;
+*                       the asynchronous request reserved for such flushes is then freed.
+*
+*               (3) If the file can NOT be removed from the open file hash table, it is NOT closed, so
+*                   that no freed file is left in the table.  The close may be retried.
 *********************************************************************************************************
 */
 
@@ -464,8 +1022,21 @@ void  FSFile_Close (FS_FILE  *p_file,
                                                                 /* -------------------- CLOSE FILE -------------------- */
 #if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)                         /* Flush file buf (see Note #2a).                       */
     FSFile_BufEmpty(p_file, p_err);
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    if (p_file->BufFlushReqPtr != (FS_FILE_ASYNC_REQ *)0) {     /* Free stream buf flush req (see Note #2c).            */
+        FSFile_AsyncReqFree(p_file->BufFlushReqPtr);
+        p_file->BufFlushReqPtr = (FS_FILE_ASYNC_REQ *)0;
+    }
+#endif
 #endif
 
+    FSFile_HashRemove(p_file, p_err);                           /* Unlink file from open file hash tbl (see Note #3).   */
+    if (*p_err != FS_ERR_NONE) {
+        FSFile_ReleaseUnlock(p_file);
+        return;
+    }
+
     FSSys_FileClose(p_file, p_err);
 
     FSVol_FileRemove(p_file->VolPtr, p_file);                   /* Unlink file from vol file list.                      */
@@ -522,7 +1093,7 @@ void  FSFile_ClrErr (FS_FILE  *p_file,
 #endif
 
                                                                 /* ----------------- ACQUIRE FILE LOCK ---------------- */
-    (void)FSFile_AcquireLockChk(p_file, p_err);
+    (void)FSFile_AcquireLockChkEx(p_file, DEF_YES, p_err);
     if (*p_err != FS_ERR_NONE) {
          return;
     }
@@ -590,7 +1161,7 @@ CPU_BOOLEAN  FSFile_IsEOF (FS_FILE  *p_file,
 #endif
 
                                                                 /* ----------------- ACQUIRE FILE LOCK ---------------- */
-    (void)FSFile_AcquireLockChk(p_file, p_err);
+    (void)FSFile_AcquireLockChkEx(p_file, DEF_YES, p_err);
     if (*p_err != FS_ERR_NONE) {
         return (DEF_NO);
     }
@@ -650,7 +1221,7 @@ CPU_BOOLEAN  FSFile_IsErr (FS_FILE  *p_file,
 #endif
 
                                                                 /* ----------------- ACQUIRE FILE LOCK ---------------- */
-    (void)FSFile_AcquireLockChk(p_file, p_err);
+    (void)FSFile_AcquireLockChkEx(p_file, DEF_YES, p_err);
     if (*p_err != FS_ERR_NONE) {
         return (DEF_NO);
     }
@@ -700,7 +1271,7 @@ CPU_BOOLEAN  FSFile_IsErr (FS_FILE  *p_file,
 *
 *               DEF_YES, if file is     open.
 *
-* Note(s)     : none.
+* Note(s)     : (1) See 'FSFile_IsOpenLocked()  Note(s)'.
 *********************************************************************************************************
 */
 
@@ -708,15 +1279,9 @@ CPU_BOOLEAN  FSFile_IsOpen(CPU_CHAR  *name_full,
                            FS_FLAGS  *p_mode,
                            FS_ERR    *p_err)
 {
-    FS_FILE            *p_file;
-    FS_QTY              max_ix;
-    CPU_INT32U          ix;
-    FS_FAT_FILE_DATA    disk_file_fat_data;
-    FS_FAT_FILE_DATA   *p_fat_file_data;
-    FS_VOL             *p_open_vol;
-    FS_VOL             *p_disk_vol;
-    CPU_CHAR           *file_name;
-    CPU_BOOLEAN         file_open;
+    FS_VOL       *p_disk_vol;
+    CPU_CHAR     *file_name;
+    CPU_BOOLEAN   file_open;
 
 
 #if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
@@ -747,76 +1312,14 @@ CPU_BOOLEAN  FSFile_IsOpen(CPU_CHAR  *name_full,
         return (DEF_NO);
     }
 
-                                                                /* Get fat data from disk.                              */
-    FS_FAT_LowEntryFind(p_disk_vol, &disk_file_fat_data, file_name, FS_FAT_MODE_FILE | FS_FAT_MODE_RD, p_err);
-
+    file_open = FSFile_IsOpenLocked(p_disk_vol,
+                                    file_name,
+                                    p_mode,
+                                    p_err);
 
     FSVol_Unlock(p_disk_vol);
     FSVol_Release(p_disk_vol);
 
-    switch (*p_err) {
-        case FS_ERR_NONE:
-             break;
-
-
-        case FS_ERR_ENTRY_NOT_FOUND:                            /* Entry do not exist. Cannot be open.                  */
-        case FS_ERR_ENTRY_PARENT_NOT_FOUND:
-        case FS_ERR_ENTRY_PARENT_NOT_DIR:
-            *p_err = FS_ERR_NONE;
-             return (DEF_NO);
-
-
-        case FS_ERR_NAME_INVALID:
-        case FS_ERR_VOL_INVALID_SEC_NBR:
-        case FS_ERR_BUF_NONE_AVAIL:
-        case FS_ERR_ENTRY_NOT_FILE:
-        default:
-             return (DEF_NO);
-    }
-
-
-                                                                /* ------------- CMP TO EVERY FILE IN POOL ------------ */
-    FS_OS_Lock(p_err);
-    if (*p_err != FS_ERR_NONE) {
-        return (DEF_NO);
-    }
-
-    max_ix = FSFile_FileCntMax;
-
-    file_open = DEF_NO;
-    ix        = 0u;
-    while ((ix < max_ix) &&
-           (file_open == DEF_NO)) {
-        p_file = FSFile_Tbl[ix];
-
-        if (p_file != DEF_NULL) {
-            p_open_vol = p_file->VolPtr;
-                                                                /* Cmp vol ptr.                                         */
-            if (p_open_vol == p_disk_vol) {
-                p_fat_file_data         = (FS_FAT_FILE_DATA *)p_file->DataPtr;
-
-                                                                /* If dir entry has same loc, file is open.             */
-                if (p_fat_file_data->DirEndSecPos == disk_file_fat_data.DirEndSecPos) {
-                    if (p_fat_file_data->DirEndSec == disk_file_fat_data.DirEndSec) {
-                        if (p_fat_file_data->DirStartSecPos == disk_file_fat_data.DirStartSecPos) {
-                            if (p_fat_file_data->DirStartSec == disk_file_fat_data.DirStartSec) {
-                               *p_mode = p_file->AccessMode;
-                                file_open = DEF_YES;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-
-        ix++;
-    }
-
-    FS_OS_Unlock();
-
-
-   *p_err   = FS_ERR_NONE;
-
     return (file_open);
 }
 
@@ -1026,6 +1529,147 @@ void  FSFile_LockSet (FS_FILE  *p_file,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                            FSFile_Map()
+*
+* Description : Get direct memory addresses of file data.
+*
+* Argument(s) : p_file          Pointer to a file.
+*
+*               pos             File position of first octet to map.
+*
+*               p_extent_tbl    Pointer to table that will receive the extents (see Note #2).
+*
+*               extent_cnt      Number of entries in 'p_extent_tbl'.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE                   File mapped.
+*                                   FS_ERR_NULL_PTR               Argument 'p_file'/'p_extent_tbl' passed a NULL
+*                                                                     pointer.
+*                                   FS_ERR_FILE_INVALID_OP        Invalid operation on file (see Note #5).
+*
+*                                                                 --- RETURNED BY FSFile_AcquireLockChk() ---
+*                                   FS_ERR_DEV_CHNGD              Device has changed.
+*                                   FS_ERR_FILE_NOT_OPEN          File NOT open.
+*
+*                                                                 ------- RETURNED BY FSSys_FileMap() -------
+*                                   FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                                   FS_ERR_DEV                    Device access error.
+*                                   FS_ERR_DEV_INVALID_IO_CTRL    Device data is NOT memory-mapped.
+*                                   FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
+*
+* Return(s)   : Number of extents obtained, if no error.
+*               0,                          otherwise.
+*
+* Note(s)     : (1) Only devices whose data is held in addressable memory support mapping; the RAM disk
+*                   does (see 'FSDev_AddrGetLocked()  Note #2').  Data is then read in place, without
+*                   being copied through a file system buffer.
+*
+*               (2) Each extent is a range of file data stored contiguously in memory.  The extents are
+*                   returned in file order, from 'pos' up to the end of the file.  If more extents are
+*                   needed than 'extent_cnt', 'FSFile_Map()' may be called again with 'pos' set to the
+*                   end of the last extent obtained.  No extent is returned if 'pos' is at or past the
+*                   end of the file.
+*
+*               (3) Data held in the file buffer or in the volume cache is written to the device before
+*                   the file is mapped.
+*
+*               (4) The extents remain valid only until the file is written, truncated or deleted, or the
+*                   volume is closed.  The data MUST NOT be modified through the extents, since writes
+*                   would bypass the volume cache & journal.
+*
+*               (5) The file MUST have been opened in read or update (read/write) mode.
+*********************************************************************************************************
+*/
+
+FS_QTY  FSFile_Map (FS_FILE         *p_file,
+                    FS_FILE_SIZE     pos,
+                    FS_FILE_EXTENT  *p_extent_tbl,
+                    FS_QTY           extent_cnt,
+                    FS_ERR          *p_err)
+{
+    FS_QTY   cnt;
+#ifdef FS_CACHE_MODULE_PRESENT
+    FS_VOL  *p_vol;
+#endif
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(0u);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    if (p_extent_tbl == (FS_FILE_EXTENT *)0) {                  /* Validate extent tbl ptr.                             */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+#endif
+
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChk(p_file, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+                                                                /* Chk file mode (see Note #5).                         */
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_RD) == DEF_YES) {
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return (0u);
+    }
+
+    if (extent_cnt == 0u) {                                     /* Rtn 0 extents.                                       */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+
+
+                                                                /* ------------- FLUSH FILE DATA (Note #3) ------------ */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+#if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {  /* Wr buf data to file.                                 */
+        FSFile_BufEmpty(p_file, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSFile_ReleaseUnlock(p_file);
+            return (0u);
+        }
+    }
+#endif
+#endif
+
+#ifdef FS_CACHE_MODULE_PRESENT
+    p_vol = p_file->VolPtr;
+    if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {         /* Wr cached secs to dev.                               */
+        p_vol->CacheAPI_Ptr->Flush(p_vol, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSFile_ReleaseUnlock(p_file);
+            return (0u);
+        }
+    }
+#endif
+
+
+                                                                /* --------------------- MAP FILE --------------------- */
+    cnt = FSSys_FileMap(p_file,
+                        pos,
+                        p_extent_tbl,
+                        extent_cnt,
+                        p_err);
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+    return (cnt);
+}
+
+
 /*
 *********************************************************************************************************
 *                                            FSFile_Open()
@@ -1074,6 +1718,9 @@ void  FSFile_LockSet (FS_FILE  *p_file,
 *                               FS_ERR_ENTRY_RD_ONLY               File system entry marked read-only.
 *                               FS_ERR_NAME_INVALID                Invalid file name or path.
 *
+*                                                                  -------- RETURNED BY FS_OS_Lock() -------
+*                               FS_ERR_OS_LOCK                     OS lock NOT acquired.
+*
 * Return(s)   : Pointer to a file, if NO errors.
 *               Pointer to NULL,   otherwise.
 *
@@ -1118,899 +1765,3093 @@ FS_FILE  *FSFile_Open (CPU_CHAR  *name_full,
                        FS_FLAGS   mode,
                        FS_ERR    *p_err)
 {
-    CPU_CHAR       *name_file;
-    CPU_CHAR       *name_full_temp;
-    FS_FILE        *p_file;
-    FS_VOL         *p_vol;
-    FS_ERR          err;
-    FS_ENTRY_INFO   file_info;
-#if (FS_CFG_CONCURRENT_ENTRIES_ACCESS_EN == DEF_DISABLED)
-    CPU_BOOLEAN     file_open;
-    CPU_BOOLEAN     is_write_mode;
-    FS_FLAGS        open_mode;
-#endif
+    FS_FILE  *p_file;
+
+
+    p_file = FSFile_OpenHandler(name_full,
+                                (FS_VOL_HANDLE *)0,
+                                mode,
+                                p_err);
+
+    return (p_file);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FSFile_OpenByHandle()
+*
+* Description : Open a file on a volume given by handle.
+*
+* Argument(s) : vol_handle  Handle of the volume (see 'FSVol_HandleGet()').
+*
+*               name_file   Name of the file, from the root directory of the volume (see Note #2).
+*
+*               mode        File access mode (see 'FSFile_Open()').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                        File opened successfully.
+*                               FS_ERR_NAME_NULL                   Argument 'name_file' passed a NULL pointer.
+*                               FS_ERR_FILE_NONE_AVAIL             No file available.
+*                               FS_ERR_FILE_INVALID_ACCESS_MODE    Access mode is specified invalid.
+*                               FS_ERR_NAME_INVALID                Entry name lacks an initial path separator
+*                                                                      character.
+*                               FS_ERR_NAME_PATH_TOO_LONG          Entry path is too long.
+*                               FS_ERR_VOL_NOT_OPEN                Volume not opened, or handle is invalid.
+*                               FS_ERR_VOL_NOT_MOUNTED             Volume not mounted.
+*
+*                                                                  ------ RETURNED BY FSSys_FileOpen() -----
+*                               See 'FSFile_Open()'.
+*
+* Return(s)   : Pointer to a file, if NO errors.
+*               Pointer to NULL,   otherwise.
+*
+* Note(s)     : (1) See 'FSFile_Open()  Note(s)'.
+*
+*               (2) The volume is found from its handle, without parsing a volume name from the file name
+*                   or comparing it with the name of every open volume.  'name_file' MUST start with a path
+*                   separator character & is NOT prefixed with the working directory.
+*********************************************************************************************************
+*/
+
+FS_FILE  *FSFile_OpenByHandle (FS_VOL_HANDLE   vol_handle,
+                               CPU_CHAR       *name_file,
+                               FS_FLAGS        mode,
+                               FS_ERR         *p_err)
+{
+    FS_FILE  *p_file;
+
+
+    p_file = FSFile_OpenHandler( name_file,
+                                &vol_handle,
+                                 mode,
+                                 p_err);
+
+    return (p_file);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            FSFile_PosGet()
+*
+* Description : Get file position indicator.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE             File position gotten successfully.
+*                               FS_ERR_NULL_PTR         Argument 'p_file' passed a NULL pointer.
+*                               FS_ERR_INVALID_TYPE     Argument 'p_file's TYPE is invalid or unknown.
+*                               FS_ERR_FILE_ERR         File has error (see Note #3).
+*
+*                                                       ------ RETURNED BY FSFile_AcquireLockChk() ------
+*                               FS_ERR_DEV_CHNGD        Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
+*
+* Return(s)   : The current file position, if no errors (see Note #1).
+*               0,                         otherwise.
+*
+* Note(s)     : (1) The file position returned is measured in bytes from the beginning of the file.
+*
+*               (2) See 'fs_ftell()  Note(s)'.
+*
+*               (3) If an error occurred in the previous file access, the error indicator must be
+*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*********************************************************************************************************
+*/
+
+FS_FILE_SIZE  FSFile_PosGet (FS_FILE  *p_file,
+                             FS_ERR   *p_err)
+{
+    FS_FILE_SIZE  pos;
 
 
 #if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
     if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
-        CPU_SW_EXCEPTION((FS_FILE *)0);
+        CPU_SW_EXCEPTION(0u);
     }
-
-#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)                          /* Rd-only mode                                         */
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
-       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-        return ((FS_FILE *) 0);
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
     }
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_CREATE) == DEF_YES) {
-       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-        return ((FS_FILE *) 0);
+#endif
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChkEx(p_file, DEF_YES, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
     }
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_EXCL) == DEF_YES) {
-       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-        return ((FS_FILE *) 0);
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #3).                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return (0u);
     }
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
-       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-        return ((FS_FILE *) 0);
+
+
+
+                                                                /* ---------------------- GET POS --------------------- */
+    pos = p_file->Pos;
+
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+    return (pos);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            FSFile_PosSet()
+*
+* Description : Set file position indicator.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               offset      Offset from the file position specified by 'origin'.
+*
+*               origin      Reference position for offset :
+*
+*                               FS_FILE_ORIGIN_START    Offset is from the beginning of the file.
+*                               FS_FILE_ORIGIN_CUR      Offset is from current file position.
+*                               FS_FILE_ORIGIN_END      Offset is from the end       of the file.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File position set successfully.
+*                               FS_ERR_NULL_PTR               Argument 'p_file' passed a NULL pointer.
+*                               FS_ERR_INVALID_TYPE           Argument 'p_file's TYPE is invalid or
+*                                                                 unknown.
+*                               FS_ERR_FILE_ERR               File has error (see Note #5).
+*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file (see Note #2b).
+*                               FS_ERR_FILE_INVALID_ORIGIN    Invalid origin specified.
+*                               FS_ERR_FILE_INVALID_OFFSET    Invalid offset specified.
+*
+*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
+*
+*                                                             ------ RETURNED BY FSFile_BufEmpty() ------
+*                                                             ------ RETURNED BY FSSys_PosSet() ---------
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_DEV_FULL               Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT          File system entry is corrupt.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) (a) If a read or write error occurs, the error indicator is set.
+*
+*                   (b) The new file position, measured in bytes from the beginning of the file is
+*                       obtained by adding 'offset' to...
+*
+*                       (1) ...0 (the beginning of the file) if 'origin' is FS_FILE_ORIGIN_START,
+*
+*                       (2) ...the current file position     if 'origin' is FS_FILE_ORIGIN_CUR.
+*
+*                       (3) ...the file size                 if 'origin' is FS_FILE_ORIGIN_END.
+*
+*                   (c) The end-of-file indicator is cleared.
+*
+*               (2) If the file position indicator is set beyond the file's current data...
+*
+*                   (a) ...& data is later written to that point, reads from the gap will read 0.
+*
+*                   (b) ...the file MUST be opened in write or read/write mode.
+*
+*               (3) See also 'fs_fseek()  Note(s)'.
+*
+*               (4) If an error occurred in the previous file access, the error indicator must be
+*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*********************************************************************************************************
+*/
+
+void  FSFile_PosSet (FS_FILE         *p_file,
+                     FS_FILE_OFFSET   offset,
+                     FS_STATE         origin,
+                     FS_ERR          *p_err)
+{
+    FS_FILE_OFFSET   chk_pos;
+    FS_FILE_SIZE     start_pos;
+    FS_FILE_SIZE     set_pos;
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
     }
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_TRUNCATE) == DEF_YES) {
-       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-        return ((FS_FILE *) 0);
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
+    if (origin != FS_FILE_ORIGIN_START) {                       /* Validate origin.                                     */
+        if (origin != FS_FILE_ORIGIN_CUR) {
+            if (origin != FS_FILE_ORIGIN_END) {
+               *p_err = FS_ERR_FILE_INVALID_ORIGIN;
+                return;
+            }
+        }
     }
 #endif
 
-    if (name_full == (CPU_CHAR *)0) {                           /* Validate name ptr.                                   */
-       *p_err = FS_ERR_NAME_NULL;
-        return ((FS_FILE *)0);
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+   (void)FSFile_AcquireLockChkEx(p_file, DEF_YES, p_err);
+    if (*p_err != FS_ERR_NONE) {
+         return;
     }
-                                                                /* Validate mode (see Note #2b).                        */
-    if (DEF_BIT_IS_CLR(mode, FS_FILE_ACCESS_MODE_RD | FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
-       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-        return ((FS_FILE *)0);
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #5).                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return;
     }
-                                                                /* See Note #2a1.                                       */
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_TRUNCATE) == DEF_YES) {
-        if (DEF_BIT_IS_CLR(mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
-           *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-            return ((FS_FILE *)0);
+
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {         /* Blk buf assignment.                                  */
+        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
+    }
+                                                                /* Flush buf before pos set.                            */
+    if ((p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) ||
+        (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR)) {
+        FSFile_BufEmpty(p_file, p_err);
+
+        if (*p_err != FS_ERR_NONE) {                            /* Rtn if rd/wr err (see Note #1a).                     */
+            p_file->FlagErr = DEF_YES;
+            p_file->FlagEOF = DEF_NO;
+            FSFile_ReleaseUnlock(p_file);
+            return;
         }
     }
-                                                                /* See Note #2a2.                                       */
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_EXCL) == DEF_YES) {
-        if (DEF_BIT_IS_CLR(mode, FS_FILE_ACCESS_MODE_CREATE) == DEF_YES) {
-           *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-            return ((FS_FILE *)0);
+#endif
+
+
+                                                                /* ------------------- CALC NEW POS ------------------- */
+    if ((offset == 0) && (origin == FS_FILE_ORIGIN_CUR)) {      /* If 0 offset from cur       ...                       */
+        p_file->IO_State = FS_FILE_IO_STATE_NONE;
+        p_file->FlagEOF  = DEF_NO;                              /* ... clr EOF (see Note #1b) ...                       */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_NONE;
+        return;                                                 /* ... & rtn.                                           */
+    }
+
+    switch (origin) {                                           /* Start (ref) pos for offset (see Note #1b) : ...      */
+        case FS_FILE_ORIGIN_CUR:                                /* ... current file pos                        ...      */
+             start_pos = p_file->Pos;
+             break;
+
+        case FS_FILE_ORIGIN_END:                                /* ... EOF                                     ...      */
+             start_pos = p_file->Size;
+             break;
+
+        case FS_FILE_ORIGIN_START:                              /* ... start of file.                                   */
+        default:
+             start_pos = 0u;
+             break;
+
+    }
+
+    if (offset < 0) {                                           /* Neg offset ... chk for neg ovf.                      */
+        if (offset == FS_FILE_OFFSET_MIN) {
+            if ((FS_FILE_SIZE)FS_FILE_OFFSET_MAX + 1u > start_pos) {
+               *p_err = FS_ERR_FILE_INVALID_OFFSET;
+                FSFile_ReleaseUnlock(p_file);
+                return;
+            }
+        } else {
+            chk_pos = (FS_FILE_OFFSET)start_pos + offset;
+            if (chk_pos < 0) {
+               *p_err = FS_ERR_FILE_INVALID_OFFSET;
+                FSFile_ReleaseUnlock(p_file);
+                return;
+            }
+        }
+    } else {
+        if (offset > 0) {                                       /* Pos offset ... chk for pos ovf.                      */
+            if (FS_FILE_SIZE_MAX - (FS_FILE_SIZE)offset < start_pos) {
+               *p_err = FS_ERR_FILE_INVALID_OFFSET;
+                FSFile_ReleaseUnlock(p_file);
+                return;
+            }
+                                                                /* Chk file mode (see Note #2b).                        */
+            if ((FS_FILE_SIZE)offset + start_pos > p_file->Size) {
+                if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+                   *p_err = FS_ERR_FILE_INVALID_OFFSET;
+                    FSFile_ReleaseUnlock(p_file);
+                    return;
+                }
+            }
         }
     }
-                                                                /* See Note #2a3.                                       */
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
-        if (DEF_BIT_IS_CLR(mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
-           *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-            return ((FS_FILE *)0);
+
+    set_pos = start_pos + offset;                               /* Calc pos to set.                                     */
+
+
+    if (set_pos > p_file->Size) {                               /* If pos past file data ...                            */
+#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)
+       *p_err = FS_ERR_FILE_INVALID_OFFSET;
+        FSFile_ReleaseUnlock(p_file);
+        return;
+#else
+                                                                /* ... there is no need to chk file mode because ...    */
+                                                                /* ... it has already been chk'd (see Note #2b).        */
+        FSFile_SizeExtend(p_file, set_pos, p_err);              /* Fill empty area with '\0' (see Note #2a).            */
+        if (*p_err != FS_ERR_NONE) {
+            FSFile_ReleaseUnlock(p_file);
+            return;
         }
+#endif
     }
-                                                                /* See Note #2a4.                                       */
-    if ((mode & (FS_FILE_ACCESS_MODE_RD       | FS_FILE_ACCESS_MODE_WR     | FS_FILE_ACCESS_MODE_APPEND |
-                 FS_FILE_ACCESS_MODE_TRUNCATE | FS_FILE_ACCESS_MODE_CREATE | FS_FILE_ACCESS_MODE_EXCL   |
-                 FS_FILE_ACCESS_MODE_CACHED                                                             )) != mode) {
-       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-        return ((FS_FILE *)0);
+
+    FSSys_FilePosSet(p_file, set_pos, p_err);
+
+    if (*p_err != FS_ERR_NONE) {
+        p_file->FlagErr = DEF_YES;                              /* Set err indicator (see Note #1a).                    */
+    } else {
+        p_file->FlagEOF = DEF_NO;                               /* Clr EOF (see Note #1b).                              */
+        p_file->Pos     = set_pos;
+    }
+
+    p_file->IO_State = FS_FILE_IO_STATE_NONE;
+
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           FSFile_Prealloc()
+*
+* Description : Reserve storage for a file ahead of the writes that will use it.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               size        Number of octets of file data to reserve storage for, from the start of the file.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE             Storage reserved successfully.
+*                               FS_ERR_NULL_PTR         Argument 'p_file' passed a NULL pointer.
+*                               FS_ERR_INVALID_TYPE     Argument 'p_file's TYPE is invalid or unknown.
+*                               FS_ERR_FILE_ERR         File has error (see Note #3).
+*                               FS_ERR_FILE_INVALID_OP  Invalid operation on file.
+*
+*                                                       ------ RETURNED BY FSFile_AcquireLockChk() ------
+*                               FS_ERR_DEV_CHNGD        Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
+*
+*                                                       --------- RETURNED BY FSFile_BufEmpty() ---------
+*                                                       -------- RETURNED BY FSSys_FilePrealloc() -------
+*                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
+*                               FS_ERR_DEV              Device access error.
+*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The file MUST be opened in write or read/write mode.
+*
+*               (2) The file size & the file position are NOT changed.  Storage is allocated in a single
+*                   run, so a file that is then written sequentially (e.g., the destination of a copy)
+*                   is laid out contiguously as long as the free space on the volume is.
+*
+*               (3) If an error occurred in the previous file access, the error indicator must be
+*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSFile_Prealloc (FS_FILE       *p_file,
+                       FS_FILE_SIZE   size,
+                       FS_ERR        *p_err)
+{
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChk(p_file, p_err);
+    if (*p_err != FS_ERR_NONE) {
+         return;
+    }
+                                                                /* Chk file mode (see Note #1).                         */
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return;
+    }
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #3).                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return;
+    }
+
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    if (p_file->BufStatus != FS_FILE_BUF_STATUS_NONE) {         /* Empty buf.                                           */
+        FSFile_BufEmpty(p_file, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSFile_ReleaseUnlock(p_file);
+            return;
+        }
+    }
+#endif
+
+
+
+                                                                /* ------------------ PREALLOC FILE ------------------- */
+    FSSys_FilePrealloc(p_file, size, p_err);                    /* See Note #2.                                         */
+
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                             FSFile_Query()
+*
+* Description : Get information about a file.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_info      Pointer to structure that will receive the file information.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE             File information obtained successfully.
+*                               FS_ERR_NULL_PTR         Argument 'p_file'/'p_info' passed a NULL pointer.
+*                               FS_ERR_INVALID_TYPE     Argument 'p_file's TYPE is invalid or
+*                                                           unknown.
+*
+*                                                       ------ RETURNED BY FSFile_AcquireLockChk() ------
+*                               FS_ERR_DEV_CHNGD        Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
+*
+*                                                       --------- RETURNED BY FSSys_FileQuery() ---------
+*                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
+*                               FS_ERR_DEV              Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) If data is stored in the file buffer waiting to be written to the storage medium,
+*                   the actual file size may need to be adjusted to account for that buffered data.
+*********************************************************************************************************
+*/
+
+void  FSFile_Query (FS_FILE        *p_file,
+                    FS_ENTRY_INFO  *p_info,
+                    FS_ERR         *p_err)
+
+{
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
+    if (p_info == (FS_ENTRY_INFO *)0) {                         /* Validate file info ptr.                              */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChkEx(p_file, DEF_YES, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+                                                                /* --------------------- GET INFO --------------------- */
+    FSSys_FileQuery(p_file, p_info, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        FSFile_ReleaseUnlock(p_file);
+        return;
+    }
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {  /* See Note #1.                                         */
+        p_info->Size = p_file->Size;
+
+
+    }
+#endif
+
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+}
+
+
+/*
+*********************************************************************************************************
+*                                              FSFile_Rd()
+*
+* Description : Read from a file.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               size        Number of octets to read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File read successfully.
+*                               FS_ERR_NULL_PTR               Argument 'p_file'/'p_dest' passed a NULL pointer.
+*                               FS_ERR_INVALID_TYPE           Argument 'p_file's TYPE is invalid or unknown.
+*                               FS_ERR_FILE_ERR               File has error (see Note #5).
+*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file (see Note #3).
+*                               FS_ERR_FILE_INVALID_OP_SEQ    Invalid operation sequence on file (see Note #2).
+*
+*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
+*
+*                                                             -------- RETURNED BY FSSys_FileRd() -------
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
+*
+* Return(s)   : Number of bytes read, if no error.
+*               0,                    otherwise.
+*
+* Note(s)     : (1) If 'size' is zero, then the file is unchanged & zero is returned.
+*
+*               (2) If the last operation is output (write), then a call to 'FSFile_BufFlush()' or
+*                  'FSFile_PosSet()' MUST occur before input (read) can be performed.  See 'fs_fopen()
+*                   Note #1e'.
+*
+*                   (a) This check of the buffer status is redundant; the buffer should NEVER be non-
+*                       empty with write data without the file being in the I/O write state.
+*
+*               (3) The file MUST have been opened in read or update (read/write) mode.
+*
+*               (4) See 'fs_fread()  Note(s)'.
+*
+*               (5) If an error occurred in the previous file access, the error indicator must be
+*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FSFile_Rd (FS_FILE     *p_file,
+                       void        *p_dest,
+                       CPU_SIZE_T   size,
+                       FS_ERR      *p_err)
+{
+    CPU_SIZE_T  size_rd;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(0u);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    if (p_dest == (void *)0) {                                  /* Validate dest ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+#endif
+
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChkEx(p_file, DEF_YES, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+                                                                /* Chk file mode (see Note #3).                         */
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_RD) == DEF_YES) {
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return (0u);
+    }
+
+    if (p_file->IO_State == FS_FILE_IO_STATE_WR) {              /* Chk state (see Note #2).                             */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
+        return (0u);
+    }
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #5).                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return (0u);
+    }
+
+    if (size == 0u) {                                           /* Rtn 0 bytes rd (see Note #1).                        */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+#if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {  /* Chk buf status (see Note #2a).                       */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
+        return (0u);
+    }
+#endif
+                                                                /* Read from buf.                                       */
+    if (DEF_BIT_IS_SET(p_file->BufMode, FS_FILE_BUF_MODE_RD) == DEF_YES) {
+        size_rd = FSFile_BufRd(p_file,
+                               p_dest,
+                               size,
+                               p_err);
+
+        if (size_rd != 0u) {                                    /* If data rd, set I/O state.                           */
+            p_file->IO_State = FS_FILE_IO_STATE_RD;
+        }
+
+        FSFile_ReleaseUnlock(p_file);
+        return (size_rd);
+    }
+
+                                                                /* Blk buf assignment.                                  */
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {
+        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
+    }
+#endif
+
+
+
+                                                                /* ---------------------- RD FILE --------------------- */
+    size_rd = FSSys_FileRd(p_file,
+                           p_dest,
+                           size,
+                           p_err);
+
+    p_file->Pos += size_rd;
+
+
+                                                                /* ----------------- UPDATE FILE FLAGS ---------------- */
+    switch (*p_err) {
+        case FS_ERR_BUF_NONE_AVAIL:
+             break;
+
+        case FS_ERR_NONE:
+             if (size_rd != 0u) {
+                 p_file->IO_State = FS_FILE_IO_STATE_RD;
+             }
+             if (size_rd != size) {
+                 p_file->FlagEOF = DEF_YES;
+             } else {
+                 p_file->FlagEOF = DEF_NO;
+             }
+             break;
+
+        default:                                                /* Update err flag.                                     */
+             p_file->FlagEOF = DEF_NO;
+             p_file->FlagErr = DEF_YES;
+             break;
+    }
+
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+    return (size_rd);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             FSFile_RdAt()
+*
+* Description : Read from a file at a given position, without changing the file position.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               size        Number of octets to read.
+*
+*               pos         File position of first octet to read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File read successfully.
+*                               FS_ERR_NULL_PTR               Argument 'p_file'/'p_dest' passed a NULL pointer.
+*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file (see Notes #3 & #5).
+*                               FS_ERR_OS_LOCK                Volume lock NOT acquired.
+*
+*                                                             - RETURNED BY FSFile_AcquireVolLockChk() -
+*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
+*
+*                                                             ------- RETURNED BY FSSys_FileRdAt() ------
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
+*
+* Return(s)   : Number of bytes read, if no error.
+*               0,                    otherwise.
+*
+* Note(s)     : (1) The file position, the end-of-file & error indicators, the I/O state & the file
+*                   buffer are neither used nor modified.  Fewer than 'size' octets are read only if
+*                   the end of the file is reached.
+*
+*               (2) Task ownership of the file (see 'FSFile_LockGet()') is NOT acquired.  If the file was
+*                   opened without write access, the volume lock is acquired in shared mode, so that
+*                   positional reads of the same file by several tasks proceed concurrently.  See
+*                  'FSFile_AcquireVolLockChk()  Note #1'.
+*
+*               (3) The file MUST have been opened in read or update (read/write) mode.
+*
+*               (4) If the file was opened with write access, data held in the file buffer is written
+*                   to the file before the read.
+*
+*               (5) A file whose buffer is in stream mode CANNOT be read with this function, since its
+*                   buffer may be filled without the volume lock.  See 'FSFile_BufStreamWr()  Note #2'.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FSFile_RdAt (FS_FILE       *p_file,
+                         void          *p_dest,
+                         CPU_SIZE_T     size,
+                         FS_FILE_SIZE   pos,
+                         FS_ERR        *p_err)
+{
+    CPU_BOOLEAN  lock_shared;
+    CPU_SIZE_T   size_rd;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(0u);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    if (p_dest == (void *)0) {                                  /* Validate dest ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+#endif
+
+
+                                                                /* ------------------ ACQUIRE VOL LOCK ---------------- */
+    lock_shared = DEF_YES;                                      /* See Note #2.                                         */
+    (void)FSFile_AcquireVolLockChk(p_file, &lock_shared, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+                                                                /* Chk file mode (see Note #3).                         */
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_RD) == DEF_YES) {
+        FSFile_ReleaseVolUnlock(p_file, lock_shared);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return (0u);
+    }
+
+#if (FS_CFG_FILE_BUF_EN   == DEF_ENABLED)
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    if (DEF_BIT_IS_SET(p_file->BufMode, FS_FILE_BUF_MODE_STREAM) == DEF_YES) {
+        FSFile_ReleaseVolUnlock(p_file, lock_shared);           /* Chk buf mode (see Note #5).                          */
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return (0u);
+    }
+#endif
+#endif
+
+    if (size == 0u) {                                           /* Rtn 0 bytes rd.                                      */
+        FSFile_ReleaseVolUnlock(p_file, lock_shared);
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+#if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {  /* Wr buf data to file (see Note #4).                   */
+        FSFile_BufEmpty(p_file, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSFile_ReleaseVolUnlock(p_file, lock_shared);
+            return (0u);
+        }
+    }
+#endif
+#endif
+
+
+                                                                /* ---------------------- RD FILE --------------------- */
+    size_rd = FSSys_FileRdAt(p_file,
+                             p_dest,
+                             size,
+                             pos,
+                             p_err);
+
+
+                                                                /* ------------------ RELEASE VOL LOCK ---------------- */
+    FSFile_ReleaseVolUnlock(p_file, lock_shared);
+    return (size_rd);
+}
+
+
+/*
+*********************************************************************************************************
+*                                              FSFile_RdV()
+*
+* Description : Read from a file into several buffers.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_iov       Pointer to array of I/O vectors describing destination buffers.
+*
+*               iov_cnt     Number of I/O vectors.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File read successfully.
+*                               FS_ERR_NULL_PTR               Argument 'p_file'/'p_iov' passed a NULL pointer,
+*                                                                 OR I/O vector buffer is a NULL pointer.
+*                               FS_ERR_INVALID_ARG            Total size of I/O vectors overflows.
+*                               FS_ERR_INVALID_TYPE           Argument 'p_file's TYPE is invalid or unknown.
+*                               FS_ERR_FILE_ERR               File has error.
+*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file.
+*                               FS_ERR_FILE_INVALID_OP_SEQ    Invalid operation sequence on file.
+*
+*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
+*
+*                                                             ------- RETURNED BY FSSys_FileRdV() -------
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
+*
+* Return(s)   : Number of bytes read, if no error.
+*               0,                    otherwise.
+*
+* Note(s)     : (1) The buffers are filled in array order, exactly as if 'FSFile_Rd()' were called once
+*                   for each buffer, but the file is locked only once & the file system driver reads the
+*                   whole request in a single pass.  See also 'FSFile_Rd()  Note(s)'.
+*
+*               (2) The total size of the I/O vectors MUST be representable as a CPU_SIZE_T.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FSFile_RdV (FS_FILE      *p_file,
+                        FS_FILE_IOV  *p_iov,
+                        FS_QTY        iov_cnt,
+                        FS_ERR       *p_err)
+{
+    CPU_SIZE_T  size;
+    CPU_SIZE_T  size_rd;
+    FS_QTY      iov_ix;
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    CPU_SIZE_T  size_rd_iov;
+#endif
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(0u);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    if ((p_iov   == (FS_FILE_IOV *)0) &&                        /* Validate I/O vector ptr.                             */
+        (iov_cnt != 0u)) {
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    for (iov_ix = 0u; iov_ix < iov_cnt; iov_ix++) {             /* Validate I/O vector bufs.                            */
+        if ((p_iov[iov_ix].BufPtr == (void *)0) &&
+            (p_iov[iov_ix].Size   != 0u)) {
+           *p_err = FS_ERR_NULL_PTR;
+            return (0u);
+        }
+    }
+#endif
+
+    size = 0u;                                                  /* Calc total size (see Note #2).                       */
+    for (iov_ix = 0u; iov_ix < iov_cnt; iov_ix++) {
+        if (p_iov[iov_ix].Size > DEF_GET_U_MAX_VAL(size) - size) {
+           *p_err = FS_ERR_INVALID_ARG;
+            return (0u);
+        }
+        size += p_iov[iov_ix].Size;
+    }
+
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChkEx(p_file, DEF_YES, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+                                                                /* Chk file mode.                                       */
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_RD) == DEF_YES) {
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return (0u);
+    }
+
+    if (p_file->IO_State == FS_FILE_IO_STATE_WR) {              /* Chk state.                                           */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
+        return (0u);
+    }
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err.                                    */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return (0u);
+    }
+
+    if (size == 0u) {                                           /* Rtn 0 bytes rd.                                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+#if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {  /* Chk buf status.                                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
+        return (0u);
+    }
+#endif
+                                                                /* Read from buf, one I/O vector at a time.             */
+    if (DEF_BIT_IS_SET(p_file->BufMode, FS_FILE_BUF_MODE_RD) == DEF_YES) {
+        size_rd = 0u;
+       *p_err   = FS_ERR_NONE;
+        for (iov_ix = 0u; iov_ix < iov_cnt; iov_ix++) {
+            if (p_iov[iov_ix].Size == 0u) {
+                continue;
+            }
+            size_rd_iov = FSFile_BufRd(p_file,
+                                       p_iov[iov_ix].BufPtr,
+                                       p_iov[iov_ix].Size,
+                                       p_err);
+            size_rd    += size_rd_iov;
+            if ((*p_err      != FS_ERR_NONE) ||                 /* Stop on err or EOF.                                  */
+                (size_rd_iov != p_iov[iov_ix].Size)) {
+                break;
+            }
+        }
+
+        if (size_rd != 0u) {                                    /* If data rd, set I/O state.                           */
+            p_file->IO_State = FS_FILE_IO_STATE_RD;
+        }
+
+        FSFile_ReleaseUnlock(p_file);
+        return (size_rd);
+    }
+
+                                                                /* Blk buf assignment.                                  */
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {
+        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
+    }
+#endif
+
+
+
+                                                                /* ---------------------- RD FILE --------------------- */
+    size_rd = FSSys_FileRdV(p_file,
+                            p_iov,
+                            iov_cnt,
+                            p_err);
+
+    p_file->Pos += size_rd;
+
+
+                                                                /* ----------------- UPDATE FILE FLAGS ---------------- */
+    switch (*p_err) {
+        case FS_ERR_BUF_NONE_AVAIL:
+             break;
+
+        case FS_ERR_NONE:
+             if (size_rd != 0u) {
+                 p_file->IO_State = FS_FILE_IO_STATE_RD;
+             }
+             if (size_rd != size) {
+                 p_file->FlagEOF = DEF_YES;
+             } else {
+                 p_file->FlagEOF = DEF_NO;
+             }
+             break;
+
+        default:                                                /* Update err flag.                                     */
+             p_file->FlagEOF = DEF_NO;
+             p_file->FlagErr = DEF_YES;
+             break;
+    }
+
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+    return (size_rd);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FSFile_Truncate()
+*
+* Description : Truncate a file.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               size        Size of file after truncation.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE             File truncated successfully.
+*                               FS_ERR_NULL_PTR         Argument 'p_file' passed a NULL pointer.
+*                               FS_ERR_INVALID_TYPE     Argument 'p_file's TYPE is invalid or unknown.
+*                               FS_ERR_FILE_ERR         File has error (see Note #5).
+*                               FS_ERR_FILE_INVALID_OP  Invalid operation on file.
+*
+*                                                       ------ RETURNED BY FSFile_AcquireLockChk() ------
+*                               FS_ERR_DEV_CHNGD        Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
+*
+*                                                       --------- RETURNED BY FSFile_BufEmpty() ---------
+*                                                       --------- RETURNED BY FSSys_Truncate() ----------
+*                                                       --------- RETURNED BY FSSys_PosSet() ------------
+*                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
+*                               FS_ERR_DEV              Device access error.
+*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The file MUST be opened in write or read/write mode.
+*
+*               (2) If 'FSFile_Truncate()' succeeds, the size of the file shall be equal to 'size':
+*
+*                   (a) If the size of the file was previously greater than 'size', the extra data shall
+*                       no longer be available.
+*
+*                   (b) If the file previously was smaller than this 'size', the size of the file shall
+*                       be increased.
+*
+*               (3) If the file position indicator before the call to 'FSFile_Truncate()' lay in the
+*                   extra data destroyed by the function, then the file position will be set to the
+*                   end-of-file.
+*
+*               (4) See 'fs_ftruncate()  Note(s)'.
+*
+*               (5) If an error occurred in the previous file access, the error indicator must be
+*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSFile_Truncate (FS_FILE       *p_file,
+                       FS_FILE_SIZE   size,
+                       FS_ERR        *p_err)
+{
+    CPU_INT32U       fill_size;
+    CPU_INT32U       wr_size;
+    CPU_INT32U       buf_size;
+    FS_BUF          *p_buf;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChk(p_file, p_err);
+    if (*p_err != FS_ERR_NONE) {
+         return;
+    }
+                                                                /* Chk file mode (see Note #1).                         */
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return;
+    }
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #5).                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return;
+    }
+
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+                                                                /* Blk buf assignment.                                  */
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {
+        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
+
+
+                                                                /* Empty buf.                                           */
+    } else {
+        FSFile_BufEmpty(p_file, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSFile_ReleaseUnlock(p_file);
+            return;
+        }
+    }
+#endif
+
+
+
+                                                                /* ------------------- TRUNCATE FILE ------------------ */
+    if (size == p_file->Size) {                                 /* If no chng in size ...                               */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_NONE;                                    /* ... nothing to do.                                   */
+        return;
+    }
+
+    if (size > p_file->Size) {                                  /* Check if the file must be truncated or extended.     */
+                                                                /* Extension needed ... */
+                                                                /* ... fill empty area with '\0'                        */
+        fill_size = size - p_file->Size;
+                                                                /* Alloc buf filled with '\0'                           */
+        p_buf = FSBuf_Get(p_file->VolPtr);
+        if (p_buf == (FS_BUF *)0) {
+           *p_err = FS_ERR_BUF_NONE_AVAIL;
+            FSFile_ReleaseUnlock(p_file);
+            return;
+        }
+        buf_size = p_buf->Size;
+
+        Mem_Set ((void *)      p_buf->DataPtr,
+                 (CPU_INT08U)  ASCII_CHAR_NULL,
+                 (CPU_SIZE_T)  buf_size);
+                                                                /* Set pos after last valid data                        */
+        FSSys_FilePosSet(p_file, p_file->Size, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSFile_ReleaseUnlock(p_file);
+            FSBuf_Free(p_buf);
+            return;
+        }
+
+                                                                /* Write '\0' to file                                   */
+
+                                                                /* Wr rem of sec.                                       */
+        wr_size = p_file->VolPtr->SecSize - (p_file->Pos % p_file->VolPtr->SecSize);
+        if (fill_size < wr_size) {                              /* Limit wr to tot size.                                */
+            wr_size = fill_size;
+        }
+
+        while (fill_size > 0u) {
+            FSSys_FileWr (p_file,
+                          p_buf->DataPtr,
+                          wr_size,
+                          p_err);
+            if (*p_err != FS_ERR_NONE) {
+                FSFile_ReleaseUnlock(p_file);
+                FSBuf_Free(p_buf);
+                return;
+            }
+            fill_size    -= wr_size;
+            p_file->Size += wr_size;
+
+            if (fill_size > buf_size) {                         /* Limit wr to buf size.                                */
+                wr_size = buf_size;
+            } else {
+                wr_size = fill_size;
+            }
+        }
+
+        FSSys_FilePosSet(p_file, p_file->Pos, p_err);           /* Restore the original position.                       */
+        if (*p_err != FS_ERR_NONE) {
+            FSFile_ReleaseUnlock(p_file);
+            FSBuf_Free(p_buf);
+            return;
+        }
+
+        FSBuf_Free(p_buf);
+
+    } else {
+        FSSys_FileTruncate(p_file,                              /* Truncate file.                                       */
+                           size,
+                           p_err);
+    }
+
+    if (*p_err != FS_ERR_NONE) {
+        p_file->FlagEOF = DEF_NO;
+        p_file->FlagErr = DEF_YES;
+        FSFile_ReleaseUnlock(p_file);
+        return;
+    }
+
+    if (size < p_file->Pos) {
+        p_file->Pos = size;                                     /* Set file pos to new EOF (see Note #3).               */
+    }
+
+    p_file->Size    =  size;
+    p_file->FlagEOF =  DEF_NO;
+    p_file->FlagErr = (*p_err != FS_ERR_NONE) ? DEF_YES : DEF_NO;
+
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                              FSFile_Wr()
+*
+* Description : Write to a file.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_src       Pointer to source buffer.
+*
+*               size        Number of octets to write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File written successfully.
+*                               FS_ERR_NULL_PTR               Argument 'p_file'/'p_src' passed a NULL pointer.
+*                               FS_ERR_INVALID_TYPE           Argument 'p_file's TYPE is invalid or
+*                                                                 unknown.
+*                               FS_ERR_FILE_ERR               File has error (see Note #6).
+*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file (see Note #3).
+*                               FS_ERR_FILE_INVALID_OP_SEQ    Invalid operation sequence on file (see Note #2).
+*                               FS_ERR_FILE_OVF               File size/position would be overflowed if
+*                                                                 write were executed (see Note #4).
+*
+*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
+*
+*                                                             -------- RETURNED BY FSSys_FileWr() -------
+*                                                             -------- RETURNED BY FSSys_PosSet() -------
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_DEV_FULL               Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT          File system entry is corrupt.
+*
+* Return(s)   : Number of octets written, if no error (see Notes #1a & #1b).
+*               0,                        otherwise.
+*
+* Note(s)     : (1) If 'size' is zero, then the file is unchanged & zero is returned.
+*
+*               (2) If the last operation is input (read), then a call to 'FSFile_PosSet()' MUST occur
+*                   before output (write) can be performed, unless the end-of-file was encountered.  See
+*                  'fs_fopen()  Note #1e'.
+*
+*                   (a) If data is in the read buffer, the buffer MUST be emptied before the write.
+*
+*               (3) The file MUST have been opened in write or update (read/write) mode.
+*
+*               (4) If the file was opened in append mode, all writes are forced to the EOF.
+*
+*                   (a) This is only necessary if the file buffer is non-empty; if the file buffer
+*                       contains data, then all writes are automatically at the EOF (since the file
+*                       position was set to the EOF before the first write to the buffer).
+*
+*               (5) Overflow of the file position MUST be checked.  If the write would result in overflow,
+*                   no data shall be written & an error shall be returned.
+*
+*               (6) If an error occurred in the previous file access, the error indicator must be
+*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*
+*               (7) If the file buffer is in stream mode, the data is written through the stream buffer
+*                   without acquiring the volume lock.  See 'FSFile_BufStreamWr()  Note(s)'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T  FSFile_Wr (FS_FILE     *p_file,
+                       void        *p_src,
+                       CPU_SIZE_T   size,
+                       FS_ERR      *p_err)
+{
+    FS_FILE_SIZE  pos;
+    CPU_SIZE_T    size_wr;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(0u);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    if (p_src == (void *)0) {                                   /* Validate src ptr.                                    */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+#endif
+
+#if (FS_CFG_FILE_BUF_EN   == DEF_ENABLED)
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    if (DEF_BIT_IS_SET(p_file->BufMode, FS_FILE_BUF_MODE_STREAM) == DEF_YES) {
+        size_wr = FSFile_BufStreamWr(p_file,                    /* Wr through stream buf (see Note #7).                 */
+                                     p_src,
+                                     size,
+                                     p_err);
+        return (size_wr);
+    }
+#endif
+#endif
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChk(p_file, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+                                                                /* Chk file mode (see Note #3).                         */
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return (0u);
+    }
+
+    if (p_file->IO_State == FS_FILE_IO_STATE_RD) {              /* Chk for wr state (see Note #2) ...                   */
+        if (p_file->FlagEOF == DEF_NO) {                        /* ... or EOF exceeded            ...                   */
+            if (p_file->Pos != p_file->Size) {                  /* ... or EOF met.                                      */
+                FSFile_ReleaseUnlock(p_file);
+               *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
+                return (0u);
+            }
+        }
+    }
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #6).                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return (0u);
+    }
+
+    if (size == 0u) {                                           /* Rtn 0 bytes wr (see Note #1).                        */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+
+    p_file->FlagEOF = DEF_NO;                                   /* Clr EOF.                                             */
+
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) {  /* Chk buf status (see Note #2a).                       */
+        FSFile_BufEmpty(p_file, p_err);
+
+        if (*p_err != FS_ERR_NONE) {                            /* Rtn if rd/wr err.                                    */
+            p_file->FlagErr = DEF_YES;
+            FSFile_ReleaseUnlock(p_file);
+            return (0u);
+        }
+    }
+
+                                                                /* Wr to buf.                                           */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    if (DEF_BIT_IS_SET(p_file->BufMode, FS_FILE_BUF_MODE_WR) == DEF_YES) {
+        if (p_file->BufStatus == FS_FILE_BUF_STATUS_EMPTY) {
+            if (DEF_BIT_IS_SET(p_file->AccessMode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
+                if (p_file->Pos != p_file->Size) {                  /* If pos NOT at EOF ...                            */
+                    FSSys_FilePosSet(p_file, p_file->Size, p_err);  /* ... set pos to EOF (see Note #4a).               */
+
+                    if (*p_err != FS_ERR_NONE) {
+                        p_file->FlagErr = DEF_YES;
+                        FSFile_ReleaseUnlock(p_file);
+                        return (0u);
+                    }
+
+                    p_file->Pos = p_file->Size;
+                }
+            }
+        }
+
+        size_wr = FSFile_BufWr(p_file,
+                               p_src,
+                               size,
+                               p_err);
+
+        if (*p_err != FS_ERR_NONE ) {
+            p_file->FlagErr = DEF_NO;
+            FSFile_ReleaseUnlock(p_file);
+            return (0u);
+        }
+
+        if (size_wr != 0u) {                                    /* Set I/O state.                                       */
+            p_file->IO_State = FS_FILE_IO_STATE_WR;
+        }
+
+        FSFile_ReleaseUnlock(p_file);
+        return (size_wr);
+    }
+#endif
+
+                                                                /* Blk buf assignment.                                  */
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {
+        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
+    }
+#endif
+
+
+                                                                /* ------------------- SET FILE POS ------------------- */
+                                                                /* See Note #4.                                         */
+    if (DEF_BIT_IS_SET(p_file->AccessMode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
+        if (p_file->Pos != p_file->Size) {                      /* If pos NOT at EOF ...                                */
+            FSSys_FilePosSet(p_file, p_file->Size, p_err);      /* ... set pos to EOF.                                  */
+
+            if (*p_err != FS_ERR_NONE) {
+                p_file->FlagErr = DEF_YES;
+                FSFile_ReleaseUnlock(p_file);
+                return (0u);
+            }
+
+            p_file->Pos = p_file->Size;
+        }
+    }
+
+
+
+                                                                /* ---------------------- WR FILE --------------------- */
+    pos = p_file->Pos;                                          /* See Note #5.                                         */
+    if (FS_FILE_SIZE_MAX - (FS_FILE_SIZE)size < pos) {          /* Rtn err & 0 bytes wr'n if wr will ovf max file size. */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_OVF;
+        return (0u);
+    }
+
+    size_wr = FSSys_FileWr(p_file,                              /* Wr to file.                                          */
+                           p_src,
+                           size,
+                           p_err);
+
+    if (*p_err != FS_ERR_NONE ) {
+        p_file->FlagErr = DEF_YES;
+        FSFile_ReleaseUnlock(p_file);
+        return (0u);
+    }
+
+    p_file->IO_State = FS_FILE_IO_STATE_WR;
+    p_file->Pos += size_wr;
+    if (p_file->Size < p_file->Pos) {
+        p_file->Size = p_file->Pos;
+    }
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+    return (size_wr);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                             FSFile_WrAt()
+*
+* Description : Write to a file at a given position, without changing the file position.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_src       Pointer to source buffer.
+*
+*               size        Number of octets to write.
+*
+*               pos         File position of first octet to write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File written successfully.
+*                               FS_ERR_NULL_PTR               Argument 'p_file'/'p_src' passed a NULL pointer.
+*                               FS_ERR_FILE_ERR               File has error (see Note #5).
+*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file (see Note #2).
+*                               FS_ERR_FILE_OVF               File size would be overflowed if write were
+*                                                                 executed.
+*
+*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
+*
+*                                                             ------- RETURNED BY FSSys_FileWrAt() ------
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_DEV_FULL               Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT          File system entry is corrupt.
+*
+* Return(s)   : Number of octets written, if no error.
+*               0,                        otherwise.
+*
+* Note(s)     : (1) The file position & I/O state are NOT modified.  The file buffer is emptied before
+*                   the write.
+*
+*               (2) The file MUST have been opened in write or update (read/write) mode.
+*
+*               (3) If the file was opened in append mode, the data is written at the EOF, regardless
+*                   of 'pos'.
+*
+*               (4) If 'pos' is past the end of the file, the gap is filled with zeros.
+*
+*               (5) If an error occurred in a previous file access, the error indicator must be cleared
+*                   (with 'FSFile_ClrErr()') before another write will be allowed.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T  FSFile_WrAt (FS_FILE       *p_file,
+                         void          *p_src,
+                         CPU_SIZE_T     size,
+                         FS_FILE_SIZE   pos,
+                         FS_ERR        *p_err)
+{
+    CPU_SIZE_T  size_wr;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(0u);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    if (p_src == (void *)0) {                                   /* Validate src ptr.                                    */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+#endif
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChk(p_file, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+                                                                /* Chk file mode (see Note #2).                         */
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return (0u);
+    }
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #5).                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return (0u);
+    }
+
+    if (size == 0u) {                                           /* Rtn 0 bytes wr.                                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    FSFile_BufEmpty(p_file, p_err);                             /* See Note #1.                                         */
+    if (*p_err != FS_ERR_NONE) {
+        FSFile_ReleaseUnlock(p_file);
+        return (0u);
+    }
+#endif
+
+
+                                                                /* ------------------- CALC WR POS -------------------- */
+    if (DEF_BIT_IS_SET(p_file->AccessMode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
+        pos = p_file->Size;                                     /* See Note #3.                                         */
+    }
+
+    if (FS_FILE_SIZE_MAX - (FS_FILE_SIZE)size < pos) {          /* Rtn err & 0 bytes wr'n if wr will ovf max file size. */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_OVF;
+        return (0u);
+    }
+
+
+
+                                                                /* ---------------------- WR FILE --------------------- */
+    if (pos > p_file->Size) {                                   /* If pos past EOF (see Note #4) ...                    */
+        FSFile_SizeExtend(p_file, pos, p_err);                  /* ... fill gap with '\0' ...                           */
+        if (*p_err == FS_ERR_NONE) {
+            size_wr = FSSys_FileWr(p_file,                      /* ... wr data at new EOF ...                           */
+                                   p_src,
+                                   size,
+                                   p_err);
+        } else {
+            size_wr = 0u;
+        }
+        if (*p_err == FS_ERR_NONE) {
+            FSSys_FilePosSet(p_file, p_file->Pos, p_err);       /* ... & restore file pos.                              */
+        }
+
+    } else {
+        size_wr = FSSys_FileWrAt(p_file,
+                                 p_src,
+                                 size,
+                                 pos,
+                                 p_err);
+    }
+
+    if (*p_err != FS_ERR_NONE) {
+        p_file->FlagErr = DEF_YES;
+        FSFile_ReleaseUnlock(p_file);
+        return (0u);
+    }
+
+    if (p_file->Size < pos + size_wr) {
+        p_file->Size = pos + size_wr;
+    }
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+    return (size_wr);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                              FSFile_WrV()
+*
+* Description : Write to a file from several buffers.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_iov       Pointer to array of I/O vectors describing source buffers.
+*
+*               iov_cnt     Number of I/O vectors.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File written successfully.
+*                               FS_ERR_NULL_PTR               Argument 'p_file'/'p_iov' passed a NULL pointer,
+*                                                                 OR I/O vector buffer is a NULL pointer.
+*                               FS_ERR_INVALID_ARG            Total size of I/O vectors overflows.
+*                               FS_ERR_INVALID_TYPE           Argument 'p_file's TYPE is invalid or
+*                                                                 unknown.
+*                               FS_ERR_FILE_ERR               File has error.
+*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file.
+*                               FS_ERR_FILE_INVALID_OP_SEQ    Invalid operation sequence on file.
+*                               FS_ERR_FILE_OVF               File size/position would be overflowed if
+*                                                                 write were executed.
+*
+*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
+*
+*                                                             ------- RETURNED BY FSSys_FileWrV() -------
+*                                                             -------- RETURNED BY FSSys_PosSet() -------
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_DEV_FULL               Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT          File system entry is corrupt.
+*
+* Return(s)   : Number of octets written, if no error.
+*               0,                        otherwise.
+*
+* Note(s)     : (1) The buffers are written in array order, exactly as if 'FSFile_Wr()' were called once
+*                   for each buffer, but the file is locked only once, clusters are allocated for the
+*                   whole request at once & the file system driver writes it in a single pass.  See also
+*                  'FSFile_Wr()  Note(s)'.
+*
+*               (2) The total size of the I/O vectors MUST be representable as a CPU_SIZE_T.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T  FSFile_WrV (FS_FILE      *p_file,
+                        FS_FILE_IOV  *p_iov,
+                        FS_QTY        iov_cnt,
+                        FS_ERR       *p_err)
+{
+    FS_FILE_SIZE  pos;
+    CPU_SIZE_T    size;
+    CPU_SIZE_T    size_wr;
+    FS_QTY        iov_ix;
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    CPU_SIZE_T    size_wr_iov;
+#endif
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(0u);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    if ((p_iov   == (FS_FILE_IOV *)0) &&                        /* Validate I/O vector ptr.                             */
+        (iov_cnt != 0u)) {
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    for (iov_ix = 0u; iov_ix < iov_cnt; iov_ix++) {             /* Validate I/O vector bufs.                            */
+        if ((p_iov[iov_ix].BufPtr == (void *)0) &&
+            (p_iov[iov_ix].Size   != 0u)) {
+           *p_err = FS_ERR_NULL_PTR;
+            return (0u);
+        }
+    }
+#endif
+
+    size = 0u;                                                  /* Calc total size (see Note #2).                       */
+    for (iov_ix = 0u; iov_ix < iov_cnt; iov_ix++) {
+        if (p_iov[iov_ix].Size > DEF_GET_U_MAX_VAL(size) - size) {
+           *p_err = FS_ERR_INVALID_ARG;
+            return (0u);
+        }
+        size += p_iov[iov_ix].Size;
+    }
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChk(p_file, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+                                                                /* Chk file mode.                                       */
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return (0u);
+    }
+
+    if (p_file->IO_State == FS_FILE_IO_STATE_RD) {              /* Chk for wr state ...                                 */
+        if (p_file->FlagEOF == DEF_NO) {                        /* ... or EOF exceeded            ...                   */
+            if (p_file->Pos != p_file->Size) {                  /* ... or EOF met.                                      */
+                FSFile_ReleaseUnlock(p_file);
+               *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
+                return (0u);
+            }
+        }
+    }
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err.                                    */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return (0u);
+    }
+
+    if (size == 0u) {                                           /* Rtn 0 bytes wr.                                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+
+    p_file->FlagEOF = DEF_NO;                                   /* Clr EOF.                                             */
+
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) {  /* Chk buf status.                                      */
+        FSFile_BufEmpty(p_file, p_err);
+
+        if (*p_err != FS_ERR_NONE) {                            /* Rtn if rd/wr err.                                    */
+            p_file->FlagErr = DEF_YES;
+            FSFile_ReleaseUnlock(p_file);
+            return (0u);
+        }
+    }
+
+                                                                /* Wr to buf, one I/O vector at a time.                 */
+    if (DEF_BIT_IS_SET(p_file->BufMode, FS_FILE_BUF_MODE_WR) == DEF_YES) {
+        if (p_file->BufStatus == FS_FILE_BUF_STATUS_EMPTY) {
+            if (DEF_BIT_IS_SET(p_file->AccessMode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
+                if (p_file->Pos != p_file->Size) {                  /* If pos NOT at EOF ...                            */
+                    FSSys_FilePosSet(p_file, p_file->Size, p_err);  /* ... set pos to EOF.                              */
+
+                    if (*p_err != FS_ERR_NONE) {
+                        p_file->FlagErr = DEF_YES;
+                        FSFile_ReleaseUnlock(p_file);
+                        return (0u);
+                    }
+
+                    p_file->Pos = p_file->Size;
+                }
+            }
+        }
+
+        size_wr = 0u;
+        for (iov_ix = 0u; iov_ix < iov_cnt; iov_ix++) {
+            if (p_iov[iov_ix].Size == 0u) {
+                continue;
+            }
+            size_wr_iov = FSFile_BufWr(p_file,
+                                       p_iov[iov_ix].BufPtr,
+                                       p_iov[iov_ix].Size,
+                                       p_err);
+            if (*p_err != FS_ERR_NONE) {
+                FSFile_ReleaseUnlock(p_file);
+                return (0u);
+            }
+            size_wr += size_wr_iov;
+        }
+
+        if (size_wr != 0u) {                                    /* Set I/O state.                                       */
+            p_file->IO_State = FS_FILE_IO_STATE_WR;
+        }
+
+        FSFile_ReleaseUnlock(p_file);
+        return (size_wr);
+    }
+
+                                                                /* Blk buf assignment.                                  */
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {
+        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
+    }
+#endif
+
+
+                                                                /* ------------------- SET FILE POS ------------------- */
+    if (DEF_BIT_IS_SET(p_file->AccessMode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
+        if (p_file->Pos != p_file->Size) {                      /* If pos NOT at EOF ...                                */
+            FSSys_FilePosSet(p_file, p_file->Size, p_err);      /* ... set pos to EOF.                                  */
+
+            if (*p_err != FS_ERR_NONE) {
+                p_file->FlagErr = DEF_YES;
+                FSFile_ReleaseUnlock(p_file);
+                return (0u);
+            }
+
+            p_file->Pos = p_file->Size;
+        }
+    }
+
+
+
+                                                                /* ---------------------- WR FILE --------------------- */
+    pos = p_file->Pos;
+    if (FS_FILE_SIZE_MAX - (FS_FILE_SIZE)size < pos) {          /* Rtn err & 0 bytes wr'n if wr will ovf max file size. */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_OVF;
+        return (0u);
+    }
+
+    size_wr = FSSys_FileWrV(p_file,                             /* Wr to file.                                          */
+                            p_iov,
+                            iov_cnt,
+                            p_err);
+
+    if (*p_err != FS_ERR_NONE ) {
+        p_file->FlagErr = DEF_YES;
+        FSFile_ReleaseUnlock(p_file);
+        return (0u);
+    }
+
+    p_file->IO_State = FS_FILE_IO_STATE_WR;
+    p_file->Pos += size_wr;
+    if (p_file->Size < p_file->Pos) {
+        p_file->Size = p_file->Pos;
+    }
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+    return (size_wr);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                      FILE MANAGEMENT FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         FSFile_GetFileCnt()
+*
+* Description : Get the number of open files.
+*
+* Argument(s) : none.
+*
+* Return(s)   : The number of open files.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+FS_QTY  FSFile_GetFileCnt (void)
+{
+    FS_QTY  file_cnt;
+    FS_ERR  err;
+
+
+                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, &err);
+    if (err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+
+
+                                                                /* ------------------- GET FILE CNT ------------------- */
+    file_cnt = FSFile_Cnt;
+
+
+
+                                                                /* ------------------ RELEASE FS LOCK ----------------- */
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+
+    return (file_cnt);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FSFile_GetFileCntMax()
+*
+* Description : Get the maximum possible number of open files.
+*
+* Argument(s) : none.
+*
+* Return(s)   : The maximum number of open files.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+FS_QTY  FSFile_GetFileCntMax (void)
+{
+    FS_QTY  file_cnt_max;
+
+
+                                                                /* ----------------- GET FILE CNT MAX ----------------- */
+    file_cnt_max = FSFile_FileCntMax;
+
+    return (file_cnt_max);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         INTERNAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         FSFile_ModuleInit()
+*
+* Description : Initialize File System File Management module.
+*
+* Argument(s) : file_cnt    Number of files to allocate.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE         Module initialized.
+*                               FS_ERR_MEM_ALLOC    Memory could not be allocated.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  FSFile_ModuleInit (FS_QTY   file_cnt,
+                         FS_ERR  *p_err)
+{
+    CPU_SIZE_T  octets_reqd;
+    LIB_ERR     pool_err;
+    FS_QTY      hash_tbl_size;
+
+
+#if (FS_CFG_TRIAL_EN == DEF_ENABLED)                            /* Trial limitation: max 1 file.                        */
+    if (file_cnt > FS_TRIAL_MAX_FILE_CNT) {
+       *p_err = FS_ERR_INVALID_CFG;
+        return;
     }
 #endif
 
-#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
-       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-        return ((FS_FILE *)0);
-    }
+    FSFile_FileCntMax = 0u;
+    FSFile_Cnt        = 0u;
 
-    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
-       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
-        return ((FS_FILE *)0);
+#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)                        /* -------------- PERFORM FS/OS FILE INIT ------------- */
+    FS_OS_FileInit(file_cnt, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
     }
 #endif
 
-                                                                /* ------------------- GET FREE FILE ------------------ */
-    FS_OS_Lock(p_err);                                          /* Acquire FS lock.                                     */
-    if (*p_err != FS_ERR_NONE) {
-        return ((FS_FILE *)0);
+
+
+                                                                /* ------------------ INIT FILE POOL ------------------ */
+    Mem_PoolCreate(&FSFile_Pool,
+                    DEF_NULL,
+                    0,
+                    file_cnt,
+                    sizeof(FS_FILE),
+                    sizeof(CPU_ALIGN),
+                   &octets_reqd,
+                   &pool_err);
+
+    if (pool_err != LIB_MEM_ERR_NONE) {
+        *p_err  = FS_ERR_MEM_ALLOC;
+        FS_TRACE_INFO(("FSFile_ModuleInit(): Could not alloc mem for files: %d octets required.\r\n", octets_reqd));
+        return;
     }
 
-    p_file = FSFile_ObjGet(p_err);                              /* Alloc file.                                          */
-    if (*p_err != FS_ERR_NONE) {
-       *p_err = FS_ERR_FILE_NONE_AVAIL;
-        FS_OS_Unlock();
-        return ((FS_FILE *)0);
+    FSFile_Tbl = (FS_FILE **)Mem_HeapAlloc(file_cnt * sizeof(FS_FILE *),
+                                           sizeof(CPU_ALIGN),
+                                          &octets_reqd,
+                                          &pool_err);
+    if (pool_err != LIB_MEM_ERR_NONE) {
+       *p_err  = FS_ERR_MEM_ALLOC;
+        FS_TRACE_INFO(("FSFile_ModuleInit(): Could not alloc mem for files: %d octets required.\r\n", octets_reqd));
+        return;
     }
 
-    p_file->AccessMode =  mode;
-    p_file->RefCnt     =  1u;
-    p_file->State      =  FS_FILE_STATE_OPENING;
-    p_file->VolPtr     = (FS_VOL *)0;
+    Mem_Clr(FSFile_Tbl, file_cnt * sizeof(FS_FILE *));
 
-    FS_OS_Unlock();                                             /* Release FS lock.                                     */
+                                                                /* --------------- INIT OPEN FILE HASH TBL ------------ */
+    hash_tbl_size = 1u;                                         /* Nbr of buckets is smallest power of 2 >= file cnt.   */
+    while (hash_tbl_size < file_cnt) {
+        hash_tbl_size <<= 1u;
+    }
 
-#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
-    (void)FSFile_LockGetHandler(p_file);
-#endif
+    FSFile_HashTbl = (FS_FILE **)Mem_HeapAlloc(hash_tbl_size * sizeof(FS_FILE *),
+                                               sizeof(CPU_ALIGN),
+                                              &octets_reqd,
+                                              &pool_err);
+    if (pool_err != LIB_MEM_ERR_NONE) {
+       *p_err  = FS_ERR_MEM_ALLOC;
+        FS_TRACE_INFO(("FSFile_ModuleInit(): Could not alloc mem for file hash tbl: %d octets required.\r\n", octets_reqd));
+        return;
+    }
 
+    Mem_Clr(FSFile_HashTbl, hash_tbl_size * sizeof(FS_FILE *));
 
+    FSFile_HashTblSize = hash_tbl_size;
+    FSFile_FileCntMax  = file_cnt;
 
-                                                                /* ------------------ FORM FULL PATH ------------------ */
-#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
-    name_full_temp = FS_WorkingDirPathForm(name_full, p_err);   /* Try to form path.                                    */
-    if (*p_err != FS_ERR_NONE) {
-#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
-        (void)FSFile_LockSetHandler(p_file);
-#endif
-        FSFile_Release(p_file);
-        return ((FS_FILE *)0);
-    }
-#else
-    name_full_temp = name_full;
-#endif
+   *p_err = FS_ERR_NONE;
+}
 
 
-                                                                /* ---------- VERIFY IF FILE OPEN IN WR MODE ---------- */
-#if (FS_CFG_CONCURRENT_ENTRIES_ACCESS_EN == DEF_DISABLED)
-    file_open = FSFile_IsOpen(name_full_temp, &open_mode, p_err);
+/*
+*********************************************************************************************************
+*                                         FSFile_ModeParse()
+*
+* Description : Parse mode string.
+*
+* Argument(s) : str_mode        Access mode of the file.
+*               --------        Argument validated by caller.
+*
+*               str_len         Length of the mode string.
+*
+* Return(s)   : Mode identifier, if mode string invalid.
+*               0, otherwise.
+*
+* Note(s)     : (1) See 'FSFile_Open()  Note #2' for a description of mode string interpretation.
+*********************************************************************************************************
+*/
+FS_FLAGS  FSFile_ModeParse (CPU_CHAR    *str_mode,
+                            CPU_SIZE_T   str_len)
+{
+    FS_FLAGS     mode;
+    CPU_BOOLEAN  b_present;
+    CPU_BOOLEAN  plus_present;
 
-    if (*p_err != FS_ERR_NONE) {
 
-#if (FS_CFG_FILE_LOCK_EN ==   DEF_ENABLED)
-        (void)FSFile_LockSetHandler(p_file);
-#endif
-        FSFile_Release(p_file);                                 /* ... release file ref.                                */
-#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
-        if (name_full_temp != name_full) {
-            FS_WorkingDirObjFree(name_full_temp);
-        }
-#endif
+                                                                /* -------------------- PARSE MODE -------------------- */
+    switch (*str_mode) {                                        /* Interpret first letter: rd, wr, append.              */
+        case ASCII_CHAR_LATIN_LOWER_R:
+             mode = FS_FILE_ACCESS_MODE_RD;
+             break;
 
-            return ((FS_FILE *)0);
+        case ASCII_CHAR_LATIN_LOWER_W:
+             mode = FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_TRUNCATE | FS_FILE_ACCESS_MODE_CREATE;
+             break;
+
+        case ASCII_CHAR_LATIN_LOWER_A:
+             mode = FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_CREATE   | FS_FILE_ACCESS_MODE_APPEND;
+             break;
+
+        default:
+             return (FS_FILE_ACCESS_MODE_NONE);
     }
+    str_mode++;
+    str_len--;
 
 
-    if (file_open == DEF_YES) {
-                                                                /* If file is already open ...                          */
-                                                                /*                         ... or going to be open ...  */
-                                                                /*                         ... in write mode ...        */
-        is_write_mode = ((open_mode & FS_FILE_ALL_WR_ACCESS_MODE) != 0u);
-        is_write_mode = ((mode      & FS_FILE_ALL_WR_ACCESS_MODE) != 0u) || is_write_mode;
+                                                                /* Interpret remaining str: "", "+", "b", "b+", "+b".   */
+    b_present    = DEF_NO;
+    plus_present = DEF_NO;
 
-        if (is_write_mode == DEF_YES) {
+    while (str_len > 0u) {
+        if (*str_mode == (CPU_CHAR)ASCII_CHAR_PLUS_SIGN) {
 
-#if (FS_CFG_FILE_LOCK_EN ==   DEF_ENABLED)
-            (void)FSFile_LockSetHandler(p_file);
-#endif
-            FSFile_Release(p_file);                             /* ... release file ref.                                */
-#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
-            if (name_full_temp != name_full) {
-                FS_WorkingDirObjFree(name_full_temp);
+            if (plus_present == DEF_YES) {
+                mode  = FS_FILE_ACCESS_MODE_NONE;               /* Invalid mode.                                        */
+                return (mode);
             }
-#endif
+            mode |= FS_FILE_ACCESS_MODE_RD | FS_FILE_ACCESS_MODE_WR;
+            plus_present = DEF_YES;
+
+        } else if (*str_mode == (CPU_CHAR)ASCII_CHAR_LATIN_LOWER_B) {
+
+            if (b_present == DEF_YES) {
+                mode  = FS_FILE_ACCESS_MODE_NONE;               /* Invalid mode.                                        */
+                return (mode);
+            }
+            b_present = DEF_YES;
+
+        } else {
+
+            mode  = FS_FILE_ACCESS_MODE_NONE;                   /* Invalid mode.                                        */
+            return(mode);
 
-           *p_err = FS_ERR_FILE_ALREADY_OPEN;
-            return ((FS_FILE *)0);
         }
+        str_mode++;
+        str_len--;
     }
-#endif
 
+    return (mode);
+}
 
-                                                                /* ------------------ ACQUIRE VOL REF ----------------- */
-    name_file = FSFile_NameParseChk( name_full_temp,
-                                    &p_vol,
-                                     p_err);
 
+/*
+*********************************************************************************************************
+*                                          FSFile_IsOpenAt()
+*
+* Description : Test if the file whose directory entry is at a given location is open.
+*
+* Argument(s) : p_vol           Pointer to volume.
+*               -----           Argument validated by caller.
+*
+*               dir_sec         Sector  containing the file's last directory entry.
+*
+*               dir_sec_pos     Position of the file's last directory entry in sector.
+*
+* Return(s)   : DEF_NO,  if file is NOT open.
+*
+*               DEF_YES, if file is     open.
+*
+* Note(s)     : (1) Used by the file system driver to check entries found while walking a directory tree,
+*                   for which the directory entry location is already known (see 'FSFile_IsOpen()').
+*********************************************************************************************************
+*/
 
-    if ((p_vol     == (FS_VOL   *)0) ||                         /* If no vol found                           ...        */
-        (name_file == (CPU_CHAR *)0)) {                         /* ... or file name not parsed (see Note #4) ...        */
-#if (FS_CFG_FILE_LOCK_EN ==   DEF_ENABLED)
-        (void)FSFile_LockSetHandler(p_file);
-#endif
-        FSFile_Release(p_file);                                 /* ... release file ref.                                */
-#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
-        if (name_full_temp != name_full) {
-            FS_WorkingDirObjFree(name_full_temp);
+CPU_BOOLEAN  FSFile_IsOpenAt (FS_VOL       *p_vol,
+                              FS_SEC_NBR    dir_sec,
+                              FS_SEC_SIZE   dir_sec_pos)
+{
+    FS_FILE            *p_file;
+    FS_FAT_FILE_DATA   *p_fat_file_data;
+    FS_QTY              hash_ix;
+    CPU_BOOLEAN         file_open;
+    FS_ERR              err;
+
+
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, &err);
+    if (err != FS_ERR_NONE) {
+        return (DEF_YES);
+    }
+
+    hash_ix   = FSFile_HashIxGet(p_vol, dir_sec, dir_sec_pos);
+    p_file    = FSFile_HashTbl[hash_ix];
+    file_open = DEF_NO;
+    while ((p_file    != DEF_NULL) &&
+           (file_open == DEF_NO)) {
+        if (p_file->VolPtr == p_vol) {
+            p_fat_file_data = (FS_FAT_FILE_DATA *)p_file->DataPtr;
+                                                                /* If dir entry has same loc, file is open.             */
+            if ((p_fat_file_data->DirEndSec    == dir_sec) &&
+                (p_fat_file_data->DirEndSecPos == dir_sec_pos)) {
+                file_open = DEF_YES;
+            }
         }
-#endif
-        return ((FS_FILE *)0);
+
+        p_file = p_file->HashNextPtr;
+    }
+
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+
+    return (file_open);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FSFile_AsyncModuleInit()
+*
+* Description : Initialize asynchronous file requests & create worker tasks.
+*
+* Argument(s) : req_cnt     Number of requests to allocate.
+*
+*               task_cnt    Number of worker tasks to create.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE         Requests initialized.
+*                               FS_ERR_MEM_ALLOC    Memory could not be allocated.
+*
+*                                                   ----- RETURNED BY FS_OS_FileAsyncInit() -----
+*                               FS_ERR_OS_INIT      OS objects NOT successfully initialized.
+*                               FS_ERR_OS_INIT_TASK Worker task NOT successfully created.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The request lists are initialized before the worker tasks are created, since these may
+*                   start servicing requests immediately.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FSFile_AsyncModuleInit (FS_QTY   req_cnt,
+                              FS_QTY   task_cnt,
+                              FS_ERR  *p_err)
+{
+    FS_FILE_ASYNC_REQ  *p_req;
+    CPU_SIZE_T          octets_reqd;
+    LIB_ERR             pool_err;
+    FS_QTY              req_ix;
+
+
+                                                                /* ------------------- ALLOC REQ TBL ------------------ */
+    FSFile_AsyncReqTbl = (FS_FILE_ASYNC_REQ *)Mem_HeapAlloc(req_cnt * sizeof(FS_FILE_ASYNC_REQ),
+                                                            sizeof(CPU_ALIGN),
+                                                           &octets_reqd,
+                                                           &pool_err);
+    if (pool_err != LIB_MEM_ERR_NONE) {
+       *p_err  = FS_ERR_MEM_ALLOC;
+        FS_TRACE_INFO(("FSFile_AsyncModuleInit(): Could not alloc mem for async req's: %d octets required.\r\n", octets_reqd));
+        return;
     }
 
+                                                                /* ------------------ INIT REQ LISTS ------------------ */
+    FSFile_AsyncReqFreePtr = (FS_FILE_ASYNC_REQ *)0;
+    req_ix                 =  req_cnt;
+    while (req_ix > 0u) {                                       /* Chain req's in free list, lowest ID first.           */
+        req_ix--;
+        p_req               = &FSFile_AsyncReqTbl[req_ix];
+        p_req->ID           = (FS_ID)req_ix;
+        p_req->State        =  FS_FILE_ASYNC_REQ_STATE_FREE;
+        p_req->Op           =  FS_FILE_ASYNC_OP_NONE;
+        p_req->FilePtr      = (FS_FILE *)0;
+        p_req->BufPtr       = (void    *)0;
+        p_req->Size         =  0u;
+        p_req->SizeDone     =  0u;
+        p_req->Err          =  FS_ERR_NONE;
+        p_req->CallbackFnct = (FS_FILE_ASYNC_CALLBACK)0;
+        p_req->CallbackArg  = (void *)0;
+        p_req->NextPtr      =  FSFile_AsyncReqFreePtr;
+        FSFile_AsyncReqFreePtr = p_req;
+    }
+
+    FSFile_AsyncRdyHeadPtr = (FS_FILE *)0;
+    FSFile_AsyncRdyTailPtr = (FS_FILE *)0;
+
+                                                                /* ---------- CREATE OS OBJS & WORKER TASKS ----------- */
+    FS_OS_FileAsyncInit(req_cnt, task_cnt, p_err);              /* See Note #1.                                         */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FSFile_AsyncTaskHandler()
+*
+* Description : Service asynchronous file requests.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) This function is called by each worker task created by 'FS_OS_FileAsyncInit()'; it
+*                   MUST NOT return.
+*
+*               (2) A file is in the ready list while it has queued requests & none of its requests is
+*                   being serviced, so that a file's requests are serviced one at a time, in order.  The
+*                   ready-task signal is posted once for each file added to the ready list.
+*
+*               (3) The completion of a request is signaled before the file's next request may start, so
+*                   that completion callbacks of a file are called in submission order.
+*
+*               (4) The file reference acquired when the request was submitted is released last, since
+*                   the file object may be freed when a close request completes.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void  FSFile_AsyncTaskHandler (void)
+{
+    FS_FILE                 *p_file;
+    FS_FILE_ASYNC_REQ       *p_req;
+    FS_FILE_ASYNC_CALLBACK   callback;
+    CPU_BOOLEAN              post;
+    FS_ERR                   err;
 
 
-                                                                /* --------------------- OPEN FILE -------------------- */
-    p_file->VolPtr = p_vol;
+    while (DEF_ON) {                                            /* See Note #1.                                         */
+        FS_OS_FileAsyncTaskPend(&err);                          /* Wait for rdy file.                                   */
+        if (err != FS_ERR_NONE) {
+            continue;
+        }
 
-    if (name_file[0] == (CPU_CHAR)ASCII_CHAR_NULL) {            /* Rtn err if entry specifies root dir.                 */
-        p_file->State = FS_FILE_STATE_CLOSING;
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_ENTRY_ROOT_DIR;
-        return ((FS_FILE *)0);
-    }
+                                                                /* ------------------- GET NEXT REQ ------------------- */
+        FS_OS_Lock(FS_OS_LOCK_ID_FILE, &err);
+        if (err != FS_ERR_NONE) {
+            FS_OS_FileAsyncTaskPost();                          /* Leave rdy file for next attempt.                     */
+            continue;
+        }
 
-                                                                /* Chk vol mode.                                        */
-    if ((DEF_BIT_IS_CLR(p_vol->AccessMode, FS_VOL_ACCESS_MODE_WR)  == DEF_YES) &&
-        (DEF_BIT_IS_SET(mode,              FS_FILE_ACCESS_MODE_WR) == DEF_YES)) {
-        p_file->State = FS_FILE_STATE_CLOSING;
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_VOL_INVALID_OP;
-        return ((FS_FILE *)0);
-    }
+        p_file                 = FSFile_AsyncRdyHeadPtr;        /* Remove first rdy file (see Note #2) ...              */
+        FSFile_AsyncRdyHeadPtr = p_file->AsyncNextPtr;
+        if (FSFile_AsyncRdyHeadPtr == (FS_FILE *)0) {
+            FSFile_AsyncRdyTailPtr  = (FS_FILE *)0;
+        }
+        p_file->AsyncNextPtr   = (FS_FILE *)0;
 
-    FSSys_FileOpen(p_file,                                      /* Open file.                                           */
-                   name_file,
-                   p_err);
-#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
-    if (name_full_temp != name_full) {
-        FS_WorkingDirObjFree(name_full_temp);
-    }
-#endif
-    if (*p_err != FS_ERR_NONE) {
-         p_file->State = FS_FILE_STATE_CLOSING;
-         FSFile_ReleaseUnlock(p_file);
-         return ((FS_FILE *)0);
-    }
+        p_req                   = p_file->AsyncReqHeadPtr;      /* ... & its oldest req.                                */
+        p_file->AsyncReqHeadPtr = p_req->NextPtr;
+        if (p_file->AsyncReqHeadPtr == (FS_FILE_ASYNC_REQ *)0) {
+            p_file->AsyncReqTailPtr  = (FS_FILE_ASYNC_REQ *)0;
+        }
+        p_req->NextPtr          = (FS_FILE_ASYNC_REQ *)0;
+        p_req->State            =  FS_FILE_ASYNC_REQ_STATE_ACTIVE;
 
-    p_file->State      = FS_FILE_STATE_OPEN;
-    p_file->RefreshCnt = p_vol->RefreshCnt;
-    FSVol_FileAdd(p_vol, p_file);                               /* Link file to vol file list.                          */
+        FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
 
-    FSSys_FileQuery(p_file, &file_info, p_err);
-    if (*p_err != FS_ERR_NONE) {
-         FSSys_FileClose(p_file, &err);
-         p_file->State = FS_FILE_STATE_CLOSING;
-         FSFile_ReleaseUnlock(p_file);
-         return ((FS_FILE *)0);
-    }
 
-    p_file->Size = file_info.Size;
-    p_file->FlagEOF = DEF_NO;
-    p_file->Pos = 0u;                                           /* Set init file pos indicator to 0 (see Note #3).      */
+                                                                /* --------------------- EXEC REQ --------------------- */
+        FSFile_AsyncReqExec(p_req);
 
 
-#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
-    p_file->BufSecSize = p_vol->SecSize;
-#endif
+                                                                /* ------------------- COMPLETE REQ ------------------- */
+        callback = p_req->CallbackFnct;                         /* See Note #3.                                         */
+        if (callback != (FS_FILE_ASYNC_CALLBACK)0) {
+            callback(p_file, p_req->CallbackArg, p_req->SizeDone, p_req->Err);
+            FSFile_AsyncReqFree(p_req);
+        } else {
+            p_req->State = FS_FILE_ASYNC_REQ_STATE_DONE;
+            FS_OS_FileAsyncReqPost(p_req->ID);                  /* Req may be freed by waiting task from here on.       */
+        }
 
 
-                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
-    FSFile_Unlock(p_file);                                      /* Keep init ref.                                       */
+                                                                /* ------------------ RESCHEDULE FILE ----------------- */
+        post = DEF_NO;
+        FS_OS_Lock(FS_OS_LOCK_ID_FILE, &err);
+        if (err == FS_ERR_NONE) {
+            if (p_file->AsyncReqHeadPtr != (FS_FILE_ASYNC_REQ *)0) {
+                FSFile_AsyncRdyAdd(p_file);                     /* File has more req's: back to end of rdy list.        */
+                post = DEF_YES;
+            } else {
+                p_file->AsyncSched = DEF_NO;
+            }
+            FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+        }
 
-    return (p_file);
+        if (post == DEF_YES) {
+            FS_OS_FileAsyncTaskPost();
+        }
+
+        FSFile_Release(p_file);                                 /* Release file ref acquired on submit (see Note #4).   */
+    }
 }
+#endif
 
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
 
 /*
 *********************************************************************************************************
-*                                            FSFile_PosGet()
+*                                        FSFile_AsyncSubmit()
 *
-* Description : Get file position indicator.
+* Description : Submit an asynchronous file request.
 *
-* Argument(s) : p_file      Pointer to a file.
+* Argument(s) : p_file          Pointer to file.
+*               ----------      Argument validated by caller.
 *
-*               p_err       Pointer to variable that will receive the return error code from this function :
+*               op              Request operation :
 *
-*                               FS_ERR_NONE             File position gotten successfully.
-*                               FS_ERR_NULL_PTR         Argument 'p_file' passed a NULL pointer.
-*                               FS_ERR_INVALID_TYPE     Argument 'p_file's TYPE is invalid or unknown.
-*                               FS_ERR_FILE_ERR         File has error (see Note #3).
+*                                   FS_FILE_ASYNC_OP_RD       Read from file.
+*                                   FS_FILE_ASYNC_OP_WR       Write to  file.
+*                                   FS_FILE_ASYNC_OP_FLUSH    Flush file buffer.
+*                                   FS_FILE_ASYNC_OP_CLOSE    Close file.
 *
-*                                                       ------ RETURNED BY FSFile_AcquireLockChk() ------
-*                               FS_ERR_DEV_CHNGD        Device has changed.
-*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
+*               p_buf           Pointer to read/write buffer.
 *
-* Return(s)   : The current file position, if no errors (see Note #1).
-*               0,                         otherwise.
+*               size            Number of octets to read/write.
 *
-* Note(s)     : (1) The file position returned is measured in bytes from the beginning of the file.
+*               callback        Completion callback, or NULL.
 *
-*               (2) See 'fs_ftell()  Note(s)'.
+*               p_callback_arg  Argument passed to 'callback'.
 *
-*               (3) If an error occurred in the previous file access, the error indicator must be
-*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*               timeout         If non-zero, maximum time to wait for a free request (in milliseconds).
+*                               If zero,     wait forever.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               ----------      Argument validated by caller.
+*
+*                                   FS_ERR_NONE             Request submitted.
+*                                   FS_ERR_FILE_NOT_OPEN    File NOT open.
+*                                   FS_ERR_FILE_INVALID_OP  File buffer is in stream mode (see Note #2).
+*                                   FS_ERR_OS_LOCK          OS lock NOT acquired.
+*
+*                                                           ----- RETURNED BY FSFile_AsyncReqAlloc() -----
+*                                   FS_ERR_OS_TIMEOUT       No request freed before timeout.
+*
+* Return(s)   : Pointer to request, if NO errors & 'callback' is NULL.
+*               Pointer to NULL,    otherwise.
+*
+* Note(s)     : (1) A file reference is held by each pending request, so that the file object is NOT freed
+*                   before its last request has been serviced.
+*
+*               (2) The flushes of a stream buffer are queued on the file itself (see 'FSFile_BufStreamWr()
+*                   Note #3'); a request serviced ahead of a flush could wait for it forever.
+*
+*               (3) A request submitted with a callback may be freed by a worker task as soon as the file
+*                   system lock is released, so its pointer is NOT returned.
 *********************************************************************************************************
 */
 
-FS_FILE_SIZE  FSFile_PosGet (FS_FILE  *p_file,
-                             FS_ERR   *p_err)
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  FS_FILE_ASYNC_REQ  *FSFile_AsyncSubmit (FS_FILE                 *p_file,
+                                                CPU_INT08U               op,
+                                                void                    *p_buf,
+                                                CPU_SIZE_T               size,
+                                                FS_FILE_ASYNC_CALLBACK   callback,
+                                                void                    *p_callback_arg,
+                                                CPU_INT32U               timeout,
+                                                FS_ERR                  *p_err)
 {
-    FS_FILE_SIZE  pos;
+    FS_FILE_ASYNC_REQ  *p_req;
+    FS_FILE_ASYNC_REQ  *p_req_rtn;
+    CPU_BOOLEAN         post;
 
 
-#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
-    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
-        CPU_SW_EXCEPTION(0u);
+                                                                /* ----------------- ACQUIRE FILE REF ----------------- */
+    if (FSFile_Acquire(p_file) == (FS_FILE *)0) {               /* See Note #1.                                         */
+       *p_err = FS_ERR_FILE_NOT_OPEN;
+        return ((FS_FILE_ASYNC_REQ *)0);
     }
-    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
-       *p_err = FS_ERR_NULL_PTR;
-        return (0u);
+
+                                                                /* ----------------- WAIT FOR FREE REQ ---------------- */
+    p_req = FSFile_AsyncReqAlloc(timeout, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        FSFile_Release(p_file);
+        return ((FS_FILE_ASYNC_REQ *)0);
     }
-#endif
 
-                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
-    (void)FSFile_AcquireLockChk(p_file, p_err);
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, p_err);
     if (*p_err != FS_ERR_NONE) {
-        return (0u);
+        FSFile_AsyncReqFree(p_req);
+        FSFile_Release(p_file);
+        return ((FS_FILE_ASYNC_REQ *)0);
     }
 
-    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #3).                      */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_ERR;
-        return (0u);
+    if (p_file->State != FS_FILE_STATE_OPEN) {                  /* Rtn err if file closed.                              */
+        FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+        FSFile_AsyncReqFree(p_req);
+        FSFile_Release(p_file);
+       *p_err = FS_ERR_FILE_NOT_OPEN;
+        return ((FS_FILE_ASYNC_REQ *)0);
     }
 
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    if (DEF_BIT_IS_SET(p_file->BufMode, FS_FILE_BUF_MODE_STREAM) == DEF_YES) {
+        FS_OS_Unlock(FS_OS_LOCK_ID_FILE);                       /* Rtn err if file has stream buf (see Note #2).        */
+        FSFile_AsyncReqFree(p_req);
+        FSFile_Release(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return ((FS_FILE_ASYNC_REQ *)0);
+    }
+#endif
 
 
-                                                                /* ---------------------- GET POS --------------------- */
-    pos = p_file->Pos;
+                                                                /* ---------------------- INIT REQ -------------------- */
+    p_req->State           = FS_FILE_ASYNC_REQ_STATE_QUEUED;
+    p_req->Op              = op;
+    p_req->FilePtr         = p_file;
+    p_req->BufPtr          = p_buf;
+    p_req->Size            = size;
+    p_req->SizeDone        = 0u;
+    p_req->Err             = FS_ERR_NONE;
+    p_req->CallbackFnct    = callback;
+    p_req->CallbackArg     = p_callback_arg;
+    p_req->NextPtr         = (FS_FILE_ASYNC_REQ *)0;
 
 
+                                                                /* -------------------- QUEUE REQ --------------------- */
+    post = FSFile_AsyncReqAdd(p_file, p_req);
 
-                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
-    FSFile_ReleaseUnlock(p_file);
-    return (pos);
+    if (callback == (FS_FILE_ASYNC_CALLBACK)0) {                /* See Note #3.                                         */
+        p_req_rtn = p_req;
+    } else {
+        p_req_rtn = (FS_FILE_ASYNC_REQ *)0;
+    }
+
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+
+    if (post == DEF_YES) {
+        FS_OS_FileAsyncTaskPost();
+    }
+
+   *p_err = FS_ERR_NONE;
+    return (p_req_rtn);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                            FSFile_PosSet()
-*
-* Description : Set file position indicator.
-*
-* Argument(s) : p_file      Pointer to a file.
-*
-*               offset      Offset from the file position specified by 'origin'.
+*                                        FSFile_AsyncReqAlloc()
 *
-*               origin      Reference position for offset :
+* Description : Allocate an asynchronous file request.
 *
-*                               FS_FILE_ORIGIN_START    Offset is from the beginning of the file.
-*                               FS_FILE_ORIGIN_CUR      Offset is from current file position.
-*                               FS_FILE_ORIGIN_END      Offset is from the end       of the file.
+* Argument(s) : timeout     If non-zero, maximum time to wait for a free request (in milliseconds).
+*                           If zero,     wait forever.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
 *
-*                               FS_ERR_NONE                   File position set successfully.
-*                               FS_ERR_NULL_PTR               Argument 'p_file' passed a NULL pointer.
-*                               FS_ERR_INVALID_TYPE           Argument 'p_file's TYPE is invalid or
-*                                                                 unknown.
-*                               FS_ERR_FILE_ERR               File has error (see Note #5).
-*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file (see Note #2b).
-*                               FS_ERR_FILE_INVALID_ORIGIN    Invalid origin specified.
-*                               FS_ERR_FILE_INVALID_OFFSET    Invalid offset specified.
-*
-*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
-*                               FS_ERR_DEV_CHNGD              Device has changed.
-*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
-*
-*                                                             ------ RETURNED BY FSFile_BufEmpty() ------
-*                                                             ------ RETURNED BY FSSys_PosSet() ---------
-*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
-*                               FS_ERR_DEV                    Device access error.
-*                               FS_ERR_DEV_FULL               Device is full (no space could be allocated).
-*                               FS_ERR_ENTRY_CORRUPT          File system entry is corrupt.
-*
-* Return(s)   : none.
-*
-* Note(s)     : (1) (a) If a read or write error occurs, the error indicator is set.
-*
-*                   (b) The new file position, measured in bytes from the beginning of the file is
-*                       obtained by adding 'offset' to...
+*                               FS_ERR_NONE          Request allocated.
+*                               FS_ERR_OS_TIMEOUT    No request freed before timeout.
+*                               FS_ERR_OS_LOCK       OS lock NOT acquired.
 *
-*                       (1) ...0 (the beginning of the file) if 'origin' is FS_FILE_ORIGIN_START,
+* Return(s)   : Pointer to request, if NO errors.
+*               Pointer to NULL,    otherwise.
 *
-*                       (2) ...the current file position     if 'origin' is FS_FILE_ORIGIN_CUR.
+* Note(s)     : (1) The request count semaphore guarantees that the free list is NOT empty.
 *
-*                       (3) ...the file size                 if 'origin' is FS_FILE_ORIGIN_END.
+*               (2) The request MUST be returned to the free list with 'FSFile_AsyncReqFree()'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  FS_FILE_ASYNC_REQ  *FSFile_AsyncReqAlloc (CPU_INT32U   timeout,
+                                                  FS_ERR      *p_err)
+{
+    FS_FILE_ASYNC_REQ  *p_req;
+
+
+    FS_OS_FileAsyncQueuePend(timeout, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return ((FS_FILE_ASYNC_REQ *)0);
+    }
+
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        FS_OS_FileAsyncQueuePost();
+        return ((FS_FILE_ASYNC_REQ *)0);
+    }
+
+    p_req                  = FSFile_AsyncReqFreePtr;            /* See Note #1.                                         */
+    FSFile_AsyncReqFreePtr = p_req->NextPtr;
+    p_req->NextPtr         = (FS_FILE_ASYNC_REQ *)0;
+
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+
+    return (p_req);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FSFile_AsyncReqAdd()
 *
-*                   (c) The end-of-file indicator is cleared.
+* Description : Queue an asynchronous file request on a file.
 *
-*               (2) If the file position indicator is set beyond the file's current data...
+* Argument(s) : p_file      Pointer to file.
+*               ----------  Argument validated by caller.
 *
-*                   (a) ...& data is later written to that point, reads from the gap will read 0.
+*               p_req       Pointer to request.
+*               ----------  Argument validated by caller.
 *
-*                   (b) ...the file MUST be opened in write or read/write mode.
+* Return(s)   : DEF_YES, if the file was added to the ready list & a worker task MUST be signaled.
+*               DEF_NO,  otherwise.
 *
-*               (3) See also 'fs_fseek()  Note(s)'.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_FILE'.
 *
-*               (4) If an error occurred in the previous file access, the error indicator must be
-*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*               (2) The worker tasks are signaled with 'FS_OS_FileAsyncTaskPost()' once the file system
+*                   lock has been released.
 *********************************************************************************************************
 */
 
-void  FSFile_PosSet (FS_FILE         *p_file,
-                     FS_FILE_OFFSET   offset,
-                     FS_STATE         origin,
-                     FS_ERR          *p_err)
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  FSFile_AsyncReqAdd (FS_FILE            *p_file,
+                                         FS_FILE_ASYNC_REQ  *p_req)
 {
-    FS_FILE_OFFSET   chk_pos;
-    FS_FILE_SIZE     start_pos;
-    FS_FILE_SIZE     set_pos;
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-    CPU_INT32U       fill_size;
-    CPU_INT32U       wr_size;
-    CPU_INT32U       buf_size;
-    FS_BUF          *p_buf;
-#endif
+    CPU_BOOLEAN  post;
 
-#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
-    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
-        CPU_SW_EXCEPTION(;);
-    }
-    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
-       *p_err = FS_ERR_NULL_PTR;
-        return;
+
+    if (p_file->AsyncReqTailPtr == (FS_FILE_ASYNC_REQ *)0) {    /* Append req to file's req list.                       */
+        p_file->AsyncReqHeadPtr           = p_req;
+    } else {
+        p_file->AsyncReqTailPtr->NextPtr  = p_req;
     }
-    if (origin != FS_FILE_ORIGIN_START) {                       /* Validate origin.                                     */
-        if (origin != FS_FILE_ORIGIN_CUR) {
-            if (origin != FS_FILE_ORIGIN_END) {
-               *p_err = FS_ERR_FILE_INVALID_ORIGIN;
-                return;
-            }
-        }
+    p_file->AsyncReqTailPtr = p_req;
+
+    post = DEF_NO;
+    if (p_file->AsyncSched == DEF_NO) {                         /* Add file to rdy list, unless already sched'd ...     */
+        p_file->AsyncSched = DEF_YES;                           /* ... (see 'FSFile_AsyncTaskHandler()  Note #2').      */
+        FSFile_AsyncRdyAdd(p_file);
+        post = DEF_YES;
     }
+
+    return (post);
+}
 #endif
 
-                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
-   (void)FSFile_AcquireLockChk(p_file, p_err);
-    if (*p_err != FS_ERR_NONE) {
-         return;
-    }
 
-    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #5).                      */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_ERR;
-        return;
-    }
+/*
+*********************************************************************************************************
+*                                        FSFile_AsyncReqExec()
+*
+* Description : Service an asynchronous file request.
+*
+* Argument(s) : p_req       Pointer to request.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The request is serviced through the file API, which acquires the file & volume locks
+*                   as for any caller.
+*
+*               (2) A stream buffer half is written through the system driver with only the volume lock
+*                   held, since the task that submitted the flush may hold the file lock while it fills
+*                   the other half.  See 'FSFile_BufStreamWr()  Note #2'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  void  FSFile_AsyncReqExec (FS_FILE_ASYNC_REQ  *p_req)
+{
+    FS_FILE      *p_file;
+    CPU_SIZE_T    size;
+#if ((FS_CFG_FILE_BUF_EN == DEF_ENABLED) && (FS_CFG_RD_ONLY_EN == DEF_DISABLED))
+    CPU_BOOLEAN   lock_shared;
+#endif
+    FS_ERR        err;
+
 
+    p_file = p_req->FilePtr;
+    size   = 0u;
 
+    switch (p_req->Op) {                                        /* See Note #1.                                         */
+        case FS_FILE_ASYNC_OP_RD:
+             size = FSFile_Rd(p_file, p_req->BufPtr, p_req->Size, &err);
+             break;
 
-                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
-#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {         /* Blk buf assignment.                                  */
-        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
-    }
-                                                                /* Flush buf before pos set.                            */
-    if ((p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) ||
-        (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR)) {
-        FSFile_BufEmpty(p_file, p_err);
 
-        if (*p_err != FS_ERR_NONE) {                            /* Rtn if rd/wr err (see Note #1a).                     */
-            p_file->FlagErr = DEF_YES;
-            p_file->FlagEOF = DEF_NO;
-            FSFile_ReleaseUnlock(p_file);
-            return;
-        }
-    }
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+        case FS_FILE_ASYNC_OP_WR:
+             size = FSFile_Wr(p_file, p_req->BufPtr, p_req->Size, &err);
+             break;
 #endif
 
 
-                                                                /* ------------------- CALC NEW POS ------------------- */
-    if ((offset == 0) && (origin == FS_FILE_ORIGIN_CUR)) {      /* If 0 offset from cur       ...                       */
-        p_file->IO_State = FS_FILE_IO_STATE_NONE;
-        p_file->FlagEOF  = DEF_NO;                              /* ... clr EOF (see Note #1b) ...                       */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_NONE;
-        return;                                                 /* ... & rtn.                                           */
-    }
-
-    switch (origin) {                                           /* Start (ref) pos for offset (see Note #1b) : ...      */
-        case FS_FILE_ORIGIN_CUR:                                /* ... current file pos                        ...      */
-             start_pos = p_file->Pos;
+        case FS_FILE_ASYNC_OP_FLUSH:
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+             FSFile_BufFlush(p_file, &err);
+#else
+             err = FS_ERR_NONE;                                 /* No file buf to flush.                                */
+#endif
              break;
 
-        case FS_FILE_ORIGIN_END:                                /* ... EOF                                     ...      */
-             start_pos = p_file->Size;
+
+        case FS_FILE_ASYNC_OP_CLOSE:
+             FSFile_Close(p_file, &err);
              break;
 
-        case FS_FILE_ORIGIN_START:                              /* ... start of file.                                   */
-        default:
-             start_pos = 0u;
+
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+#if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
+        case FS_FILE_ASYNC_OP_BUF_WR:                           /* See Note #2.                                         */
+             lock_shared = DEF_NO;
+             (void)FSFile_AcquireVolLockChk(p_file, &lock_shared, &err);
+             if (err == FS_ERR_NONE) {
+                 size = FSSys_FileWr(p_file, p_req->BufPtr, p_req->Size, &err);
+                 FSFile_ReleaseVolUnlock(p_file, lock_shared);
+             }
              break;
+#endif
+#endif
 
-    }
 
-    if (offset < 0) {                                           /* Neg offset ... chk for neg ovf.                      */
-        if (offset == FS_FILE_OFFSET_MIN) {
-            if ((FS_FILE_SIZE)FS_FILE_OFFSET_MAX + 1u > start_pos) {
-               *p_err = FS_ERR_FILE_INVALID_OFFSET;
-                FSFile_ReleaseUnlock(p_file);
-                return;
-            }
-        } else {
-            chk_pos = (FS_FILE_OFFSET)start_pos + offset;
-            if (chk_pos < 0) {
-               *p_err = FS_ERR_FILE_INVALID_OFFSET;
-                FSFile_ReleaseUnlock(p_file);
-                return;
-            }
-        }
-    } else {
-        if (offset > 0) {                                       /* Pos offset ... chk for pos ovf.                      */
-            if (FS_FILE_SIZE_MAX - (FS_FILE_SIZE)offset < start_pos) {
-               *p_err = FS_ERR_FILE_INVALID_OFFSET;
-                FSFile_ReleaseUnlock(p_file);
-                return;
-            }
-                                                                /* Chk file mode (see Note #2b).                        */
-            if ((FS_FILE_SIZE)offset + start_pos > p_file->Size) {
-                if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
-                   *p_err = FS_ERR_FILE_INVALID_OFFSET;
-                    FSFile_ReleaseUnlock(p_file);
-                    return;
-                }
-            }
-        }
+        default:
+             err = FS_ERR_INVALID_ARG;
+             break;
     }
 
-    set_pos = start_pos + offset;                               /* Calc pos to set.                                     */
+    p_req->SizeDone = size;
+    p_req->Err      = err;
+}
+#endif
 
 
-    if (set_pos > p_file->Size) {                               /* If pos past file data ...                            */
-#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)
-       *p_err = FS_ERR_FILE_INVALID_OFFSET;
-        FSFile_ReleaseUnlock(p_file);
-        return;
-#else
-                                                                /* ... there is no need to chk file mode because ...    */
-                                                                /* ... it has already been chk'd (see Note #2b).        */
+/*
+*********************************************************************************************************
+*                                        FSFile_AsyncReqFree()
+*
+* Description : Free an asynchronous file request.
+*
+* Argument(s) : p_req       Pointer to request.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) A task waiting for a free request in 'FSFile_AsyncSubmit()' is signaled.
+*********************************************************************************************************
+*/
 
-                                                                /* Fill empty area with '\0'                            */
-        fill_size = set_pos - p_file->Size;
-                                                                /* Alloc buf filled with '\0'                           */
-        p_buf = FSBuf_Get(p_file->VolPtr);
-        if (p_buf == (FS_BUF *)0) {
-           *p_err = FS_ERR_BUF_NONE_AVAIL;
-            FSFile_ReleaseUnlock(p_file);
-            return;
-        }
-        buf_size = p_buf->Size;
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  void  FSFile_AsyncReqFree (FS_FILE_ASYNC_REQ  *p_req)
+{
+    FS_ERR  err;
 
-        Mem_Set ((void *)      p_buf->DataPtr,
-                 (CPU_INT08U)  ASCII_CHAR_NULL,
-                 (CPU_SIZE_T)  buf_size);
-                                                                /* Set pos after last valid data                        */
-        FSSys_FilePosSet(p_file, p_file->Size, p_err);
-        if (*p_err != FS_ERR_NONE) {
-            FSFile_ReleaseUnlock(p_file);
-            FSBuf_Free(p_buf);
-            return;
-        }
 
-                                                                /* Write '\0' to file                                   */
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, &err);
+    if (err != FS_ERR_NONE) {
+        return;
+    }
 
-                                                                /* Wr rem of sec.                                       */
-        wr_size = p_file->VolPtr->SecSize - (p_file->Pos % p_file->VolPtr->SecSize);
-        if (fill_size < wr_size) {                              /* Limit wr to tot size.                                */
-            wr_size = fill_size;
-        }
+    p_req->State           =  FS_FILE_ASYNC_REQ_STATE_FREE;
+    p_req->Op              =  FS_FILE_ASYNC_OP_NONE;
+    p_req->FilePtr         = (FS_FILE *)0;
+    p_req->BufPtr          = (void    *)0;
+    p_req->CallbackFnct    = (FS_FILE_ASYNC_CALLBACK)0;
+    p_req->CallbackArg     = (void *)0;
+    p_req->NextPtr         =  FSFile_AsyncReqFreePtr;
+    FSFile_AsyncReqFreePtr =  p_req;
 
-        while (fill_size > 0u) {
-            FSSys_FileWr (p_file,
-                          p_buf->DataPtr,
-                          wr_size,
-                          p_err);
-            if (*p_err != FS_ERR_NONE) {
-                FSFile_ReleaseUnlock(p_file);
-                FSBuf_Free(p_buf);
-                return;
-            }
-            fill_size    -= wr_size;
-            p_file->Size += wr_size;
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
 
-            if (fill_size > buf_size) {                         /* Limit wr to buf size.                                */
-                wr_size = buf_size;
-            } else {
-                wr_size = fill_size;
-            }
-        }
-        FSBuf_Free(p_buf);
+    FS_OS_FileAsyncQueuePost();                                 /* See Note #1.                                         */
+}
 #endif
-    }
 
-    FSSys_FilePosSet(p_file, set_pos, p_err);
 
-    if (*p_err != FS_ERR_NONE) {
-        p_file->FlagErr = DEF_YES;                              /* Set err indicator (see Note #1a).                    */
+/*
+*********************************************************************************************************
+*                                        FSFile_AsyncRdyAdd()
+*
+* Description : Add a file to the end of the asynchronous request ready list.
+*
+* Argument(s) : p_file      Pointer to file.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_FILE'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  void  FSFile_AsyncRdyAdd (FS_FILE  *p_file)
+{
+    p_file->AsyncNextPtr = (FS_FILE *)0;
+    if (FSFile_AsyncRdyTailPtr == (FS_FILE *)0) {
+        FSFile_AsyncRdyHeadPtr               = p_file;
     } else {
-        p_file->FlagEOF = DEF_NO;                               /* Clr EOF (see Note #1b).                              */
-        p_file->Pos     = set_pos;
+        FSFile_AsyncRdyTailPtr->AsyncNextPtr = p_file;
     }
-
-    p_file->IO_State = FS_FILE_IO_STATE_NONE;
-
-
-
-                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
-    FSFile_ReleaseUnlock(p_file);
+    FSFile_AsyncRdyTailPtr = p_file;
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                             FSFile_Query()
+*                                            FSFile_BufEmpty()
 *
-* Description : Get information about a file.
+* Description : Empty a file's buffer.
 *
 * Argument(s) : p_file      Pointer to a file.
-*
-*               p_info      Pointer to structure that will receive the file information.
+*               ------      Argument validated by 'FSFile_Rd()'.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
 *
-*                               FS_ERR_NONE             File information obtained successfully.
-*                               FS_ERR_NULL_PTR         Argument 'p_file'/'p_info' passed a NULL pointer.
-*                               FS_ERR_INVALID_TYPE     Argument 'p_file's TYPE is invalid or
-*                                                           unknown.
-*
-*                                                       ------ RETURNED BY FSFile_AcquireLockChk() ------
-*                               FS_ERR_DEV_CHNGD        Device has changed.
-*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
+*                               FS_ERR_NONE             File buffer flushed successfully.
 *
-*                                                       --------- RETURNED BY FSSys_FileQuery() ---------
+*                                                       ----------- RETURNED BY FSSys_FileWr() ----------
 *                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
 *                               FS_ERR_DEV              Device access error.
+*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) If data is stored in the file buffer waiting to be written to the storage medium,
-*                   the actual file size may need to be adjusted to account for that buffered data.
+* Note(s)     : (1) If valid read data exists in the file buffer, the underlying file position might not
+*                   correctly reflect the apparent file position to the application, since the maximum
+*                   file position reflected in the buffered data may exceed the location last read by
+*                   the application.
 *********************************************************************************************************
 */
 
-void  FSFile_Query (FS_FILE        *p_file,
-                    FS_ENTRY_INFO  *p_info,
-                    FS_ERR         *p_err)
-
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+static  void  FSFile_BufEmpty (FS_FILE  *p_file,
+                               FS_ERR   *p_err)
 {
-#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
-    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
-        CPU_SW_EXCEPTION(;);
-    }
-    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
-       *p_err = FS_ERR_NULL_PTR;
-        return;
-    }
-    if (p_info == (FS_ENTRY_INFO *)0) {                         /* Validate file info ptr.                              */
-       *p_err = FS_ERR_NULL_PTR;
-        return;
-    }
-#endif
-
-                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
-    (void)FSFile_AcquireLockChk(p_file, p_err);
-    if (*p_err != FS_ERR_NONE) {
-        return;
-    }
+    FS_FILE_SIZE  pos_offset;
 
-                                                                /* --------------------- GET INFO --------------------- */
-    FSSys_FileQuery(p_file, p_info, p_err);
-    if (*p_err != FS_ERR_NONE) {
-        FSFile_ReleaseUnlock(p_file);
-        return;
-    }
 
+    *p_err = FS_ERR_NONE;
 
-                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
-#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {  /* See Note #1.                                         */
-        p_info->Size = p_file->Size;
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {
+       (void)FSSys_FileWr(p_file,
+                          p_file->BufPtr,
+                          p_file->BufMaxPos,
+                          p_err);
 
+        p_file->BufStart  = 0u;
+        p_file->BufMaxPos = 0u;
+        p_file->BufStatus = FS_FILE_BUF_STATUS_EMPTY;
 
+#if (FS_CFG_DBG_MEM_CLR_EN == DEF_ENABLED)
+        Mem_Clr(p_file->BufPtr, p_file->BufSize);               /* Clr buf.                                             */
+#endif
     }
 #endif
 
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) {
+                                                                /* Calc pos offset (see Note #1) ...                    */
+        pos_offset = (FS_FILE_SIZE)p_file->BufMaxPos;
+        if (pos_offset != 0u) {
+            FSSys_FilePosSet(p_file, p_file->Pos, p_err);       /* ... correct file pos.                                */
+        }
+
+        p_file->BufStart  = 0u;
+        p_file->BufMaxPos = 0u;
+        p_file->BufStatus = FS_FILE_BUF_STATUS_EMPTY;
 
+#if (FS_CFG_DBG_MEM_CLR_EN == DEF_ENABLED)
+        Mem_Clr(p_file->BufPtr, p_file->BufSize);               /* Clr buf.                                             */
+#endif
+    }
 
-                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
-    FSFile_ReleaseUnlock(p_file);
+    if (*p_err != FS_ERR_NONE) {
+        p_file->FlagErr = DEF_YES;
+    }
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                              FSFile_Rd()
+*                                             FSFile_BufRd()
 *
-* Description : Read from a file.
+* Description : Read from a file (through file buffer).
 *
 * Argument(s) : p_file      Pointer to a file.
+*               ----------  Argument validated by caller.
 *
-*               p_dest      Pointer to destination buffer.
+*               p_dest      Pointer to buffer that will hold data read by this file.
+*               ----------  Argument validated by caller.
 *
 *               size        Number of octets to read.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
 *
-*                               FS_ERR_NONE                   File read successfully.
-*                               FS_ERR_NULL_PTR               Argument 'p_file'/'p_dest' passed a NULL pointer.
-*                               FS_ERR_INVALID_TYPE           Argument 'p_file's TYPE is invalid or unknown.
-*                               FS_ERR_FILE_ERR               File has error (see Note #5).
-*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file (see Note #3).
-*                               FS_ERR_FILE_INVALID_OP_SEQ    Invalid operation sequence on file (see Note #2).
-*
-*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
-*                               FS_ERR_DEV_CHNGD              Device has changed.
-*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
-*
-*                                                             -------- RETURNED BY FSSys_FileRd() -------
-*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
-*                               FS_ERR_DEV                    Device access error.
-*                               FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
-*
-* Return(s)   : Number of bytes read, if no error.
-*               0,                    otherwise.
-*
-* Note(s)     : (1) If 'size' is zero, then the file is unchanged & zero is returned.
+*                               FS_ERR_NONE              File read successfully.
 *
-*               (2) If the last operation is output (write), then a call to 'FSFile_BufFlush()' or
-*                  'FSFile_PosSet()' MUST occur before input (read) can be performed.  See 'fs_fopen()
-*                   Note #1e'.
+*                                                        ---------- RETURNED BY FSSys_FileRd() ----------
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*                               FS_ERR_ENTRY_CORRUPT     File system entry corrupt.
 *
-*                   (a) This check of the buffer status is redundant; the buffer should NEVER be non-
-*                       empty with write data without the file being in the I/O write state.
+* Return(s)   : Number of octets read.
 *
-*               (3) The file MUST have been opened in read or update (read/write) mode.
+* Note(s)     : (1) (a) Data is first copied from the buffer, up to the length of the request OR the
+*                       amount stored in the buffer (whichever is less).
 *
-*               (4) See 'fs_fread()  Note(s)'.
+*                   (b) (1) Any large remaining read (longer than the file buffer) is satisfied by
+*                           reading directly into the destination buffer.
 *
-*               (5) If an error occurred in the previous file access, the error indicator must be
-*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*                       (2) Otherwise, the buffer is then filled (if possible) and data copied into the
+*                           user buffer, up to the length of the remaining request OR the amount stored
+*                           in the buffer (whichever is less).
 *********************************************************************************************************
 */
 
-CPU_SIZE_T  FSFile_Rd (FS_FILE     *p_file,
-                       void        *p_dest,
-                       CPU_SIZE_T   size,
-                       FS_ERR      *p_err)
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+static  CPU_SIZE_T  FSFile_BufRd (FS_FILE     *p_file,
+                                  void        *p_dest,
+                                  CPU_SIZE_T   size,
+                                  FS_ERR      *p_err)
 {
-    CPU_SIZE_T  size_rd;
+    CPU_SIZE_T   buf_pos;
+    CPU_SIZE_T   buf_rem;
+    CPU_SIZE_T   size_rd;
+    CPU_SIZE_T   size_rem;
+    CPU_INT08U  *p_src;
 
 
-#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
-    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
-        CPU_SW_EXCEPTION(0u);
-    }
-    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
-       *p_err = FS_ERR_NULL_PTR;
-        return (0u);
-    }
-    if (p_dest == (void *)0) {                                  /* Validate dest ptr.                                   */
-       *p_err = FS_ERR_NULL_PTR;
-        return (0u);
-    }
-#endif
+                                                                /* Init *p_err                                          */
+   *p_err = FS_ERR_BUF_NONE_AVAIL;
 
+                                                                /* ---------- RD FROM FILE BUF INTO USER BUF ---------- */
+    size_rem = size;
 
-                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
-    (void)FSFile_AcquireLockChk(p_file, p_err);
-    if (*p_err != FS_ERR_NONE) {
-        return (0u);
-    }
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) {  /* See Note #1a.                                        */
+        buf_pos      = (CPU_SIZE_T)(p_file->Pos - p_file->BufStart);
 
-                                                                /* Chk file mode (see Note #3).                         */
-    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_RD) == DEF_YES) {
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_INVALID_OP;
-        return (0u);
-    }
+        buf_rem      =  p_file->BufMaxPos - buf_pos;            /* Calc octets rem in buf ...                           */
+        size_rd      =  DEF_MIN(buf_rem, size_rem);             /*                        ... calc size rd from buf.    */
+        p_src        = (CPU_INT08U *)p_file->BufPtr + buf_pos;
+        Mem_Copy(p_dest, (void *)p_src, size_rd);               /* Copy from file buf to user buf.                      */
 
-    if (p_file->IO_State == FS_FILE_IO_STATE_WR) {              /* Chk state (see Note #2).                             */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
-        return (0u);
-    }
+        p_file->Pos +=  size_rd;                                /* Adj file pos ...                                     */
+        size_rem    -=  size_rd;                                /*              ... adj rd rem ...                      */
+        p_dest       = (CPU_INT08U *)p_dest + size_rd;          /*                             ... adj dest buf.        */
 
-    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #5).                      */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_ERR;
-        return (0u);
-    }
+        if (buf_rem == size_rd) {                               /* All buf'd data rd ...                                */
+            p_file->BufStart  = 0u;
+            p_file->BufMaxPos = 0u;
+            p_file->BufStatus = FS_FILE_BUF_STATUS_EMPTY;       /* ... buf is now empty.                                */
+
+        } else {                                                /* More data in buf than rem'd ...                      */
+            p_file->BufStatus = FS_FILE_BUF_STATUS_NONEMPTY_RD; /* ... buf is still not empty.                          */
+        }
 
-    if (size == 0u) {                                           /* Rtn 0 bytes rd (see Note #1).                        */
-        FSFile_ReleaseUnlock(p_file);
        *p_err = FS_ERR_NONE;
-        return (0u);
     }
 
 
 
-                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
-#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
-#if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {  /* Chk buf status (see Note #2a).                       */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
-        return (0u);
-    }
-#endif
-                                                                /* Read from buf.                                       */
-    if (DEF_BIT_IS_SET(p_file->BufMode, FS_FILE_BUF_MODE_RD) == DEF_YES) {
-        size_rd = FSFile_BufRd(p_file,
-                               p_dest,
-                               size,
-                               p_err);
 
-        if (size_rd != 0u) {                                    /* If data rd, set I/O state.                           */
-            p_file->IO_State = FS_FILE_IO_STATE_RD;
-        }
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_EMPTY) {
+        if (size_rem >= p_file->BufSize) {                      /* ------------ RD FROM FILE INTO USER BUF ------------ */
+            size_rd = FSSys_FileRd(p_file,                      /* Rd into user buf (see Note #1b1).                    */
+                                   p_dest,
+                                   size_rem,
+                                   p_err);
+            p_file->Pos += size_rd;                             /* Adj file pos ...                                     */
+            size_rem    -= size_rd;                             /*              ... adj rd rem.                         */
 
-        FSFile_ReleaseUnlock(p_file);
-        return (size_rd);
-    }
 
-                                                                /* Blk buf assignment.                                  */
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {
-        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
-    }
-#endif
 
 
+        } else {                                                /* ------------ RD FROM FILE INTO FILE BUF ------------ */
+            size_rd = FSSys_FileRd(p_file,                      /* Rd full file buf (see Note #1b2).                    */
+                                   p_file->BufPtr,
+                                   p_file->BufSize,
+                                   p_err);
+
+            if (size_rd != 0u) {
+                buf_rem          = size_rd;                     /* Calc octets rem in buf ...                           */
+                size_rd          = DEF_MIN(size_rd, size_rem);  /*                        ... calc size rd from buf.    */
+                Mem_Copy(p_dest, p_file->BufPtr, size_rd);      /* Copy data to user buf.                               */
 
-                                                                /* ---------------------- RD FILE --------------------- */
-    size_rd = FSSys_FileRd(p_file,
-                           p_dest,
-                           size,
-                           p_err);
+                p_file->BufStart = p_file->Pos;                 /* Save file pos at buf start.                          */
+                p_file->Pos     += size_rd;                     /* Adj file pos ...                                     */
+                size_rem        -= size_rd;                     /*              ... adj rd rem.                         */
 
-    p_file->Pos += size_rd;
+                if (buf_rem  == size_rd) {                      /* All buf'd data rd ...                                */
+                    p_file->BufStart   =  0u;
+                    p_file->BufMaxPos  =  0u;
+                    p_file->BufStatus  =  FS_FILE_BUF_STATUS_EMPTY;               /* ... buf is still empty.            */
 
+                } else {                                        /* More data rd into buf than rem'd ...                 */
+                                                                /* ... buf is no longer empty.                          */
+                    p_file->BufMaxPos  =  buf_rem;
+                    p_file->BufStatus  =  FS_FILE_BUF_STATUS_NONEMPTY_RD;
+                }
+            }
+        }
+    }
 
-                                                                /* ----------------- UPDATE FILE FLAGS ---------------- */
-    switch (*p_err) {
-        case FS_ERR_BUF_NONE_AVAIL:
-             break;
 
-        case FS_ERR_NONE:
-             if (size_rd != 0u) {
-                 p_file->IO_State = FS_FILE_IO_STATE_RD;
-             }
-             if (size_rd != size) {
-                 p_file->FlagEOF = DEF_YES;
-             } else {
-                 p_file->FlagEOF = DEF_NO;
-             }
-             break;
 
-        default:                                                /* Update err flag.                                     */
-             p_file->FlagEOF = DEF_NO;
-             p_file->FlagErr = DEF_YES;
-             break;
-    }
+                                                                /* ------------------- ASSIGN & RTN ------------------- */
+    if (*p_err == FS_ERR_NONE) {
+         if (size_rem > 0u) {                                   /* If less data rd than rem ...                         */
+            p_file->FlagEOF = DEF_YES;                          /* ... file at EOF.                                     */
 
+         } else {                                               /* If all  data rd that rem'd ...                       */
+            p_file->FlagEOF = DEF_NO;                           /* ... file NOT at EOF.                                 */
+           *p_err = FS_ERR_NONE;
+         }
 
+    } else {
+        p_file->FlagEOF = DEF_NO;
+        p_file->FlagErr = DEF_YES;
+    }
 
-                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
-    FSFile_ReleaseUnlock(p_file);
-    return (size_rd);
+    return (size - size_rem);
 }
+#endif
+
 
 
 /*
 *********************************************************************************************************
-*                                          FSFile_Truncate()
+*                                             FSFile_BufWr()
 *
-* Description : Truncate a file.
+* Description : Write to a file (through file buffer).
 *
 * Argument(s) : p_file      Pointer to a file.
+*               ----------  Argument validated by caller.
 *
-*               size        Size of file after truncation.
+*               p_src       Pointer to buffer that contains data to write in this file.
+*               ----------  Argument validated by caller.
 *
-*               p_err       Pointer to variable that will receive the return error code from this function :
+*               size        Number of octets to write.
 *
-*                               FS_ERR_NONE             File truncated successfully.
-*                               FS_ERR_NULL_PTR         Argument 'p_file' passed a NULL pointer.
-*                               FS_ERR_INVALID_TYPE     Argument 'p_file's TYPE is invalid or unknown.
-*                               FS_ERR_FILE_ERR         File has error (see Note #5).
-*                               FS_ERR_FILE_INVALID_OP  Invalid operation on file.
+*               p_err       Pointer to variable that will receive the return error code from this
+*                           function :
+*               ----------  Argument validated by caller.
 *
-*                                                       ------ RETURNED BY FSFile_AcquireLockChk() ------
-*                               FS_ERR_DEV_CHNGD        Device has changed.
-*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
+*                               FS_ERR_NONE             File written successfully.
 *
-*                                                       --------- RETURNED BY FSFile_BufEmpty() ---------
-*                                                       --------- RETURNED BY FSSys_Truncate() ----------
-*                                                       --------- RETURNED BY FSSys_PosSet() ------------
+*                                                       ----------- RETURNED BY FSSys_FileWr() ----------
 *                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
 *                               FS_ERR_DEV              Device access error.
 *                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
@@ -2018,1517 +4859,1784 @@ CPU_SIZE_T  FSFile_Rd (FS_FILE     *p_file,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The file MUST be opened in write or read/write mode.
-*
-*               (2) If 'FSFile_Truncate()' succeeds, the size of the file shall be equal to 'size':
-*
-*                   (a) If the size of the file was previously greater than 'size', the extra data shall
-*                       no longer be available.
-*
-*                   (b) If the file previously was smaller than this 'size', the size of the file shall
-*                       be increased.
-*
-*               (3) If the file position indicator before the call to 'FSFile_Truncate()' lay in the
-*                   extra data destroyed by the function, then the file position will be set to the
-*                   end-of-file.
-*
-*               (4) See 'fs_ftruncate()  Note(s)'.
-*
-*               (5) If an error occurred in the previous file access, the error indicator must be
-*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+* Note(s)     : none.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-void  FSFile_Truncate (FS_FILE       *p_file,
-                       FS_FILE_SIZE   size,
-                       FS_ERR        *p_err)
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+#if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
+static  CPU_SIZE_T  FSFile_BufWr (FS_FILE     *p_file,
+                                  void        *p_src,
+                                  CPU_SIZE_T   size,
+                                  FS_ERR      *p_err)
 {
-    CPU_INT32U       fill_size;
-    CPU_INT32U       wr_size;
-    CPU_INT32U       buf_size;
-    FS_BUF          *p_buf;
+    CPU_INT08U    *p_buf;
+    CPU_SIZE_T     buf_rem;
+    CPU_SIZE_T     size_wr;
+    CPU_SIZE_T     size_rem;
 
 
-#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
-    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
-        CPU_SW_EXCEPTION(;);
-    }
-    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
-       *p_err = FS_ERR_NULL_PTR;
-        return;
-    }
-#endif
+                                                                /* ----------------- WR TO END OF BUF ----------------- */
+    size_rem = size;
+    buf_rem  = p_file->BufSize - p_file->BufMaxPos;             /* Calc octets empty in buf ...                         */
+    size_wr  = DEF_MIN(buf_rem, size_rem);                      /*                          ... calc size wr to buf.    */
+    if (size_wr > 0u) {
+        if (p_file->BufStatus == FS_FILE_BUF_STATUS_EMPTY) {
+            p_file->BufStart = p_file->Pos;                 /* Save file pos at buf start.                          */
+        }
 
-                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
-    (void)FSFile_AcquireLockChk(p_file, p_err);
-    if (*p_err != FS_ERR_NONE) {
-         return;
-    }
-                                                                /* Chk file mode (see Note #1).                         */
-    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_INVALID_OP;
-        return;
-    }
+        p_buf    = (CPU_INT08U *)p_file->BufPtr + p_file->BufMaxPos;
+        Mem_Copy((void *)p_buf, p_src, size_wr);                /* Copy from user buf to file buf.                      */
 
-    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #5).                      */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_ERR;
-        return;
-    }
 
+        p_file->Pos       +=  size_wr;                          /* Adj file pos ...                                     */
+        size_rem          -=  size_wr;                          /*              ... adj wr rem ...                      */
+        p_src              = (CPU_INT08U *)p_src + size_wr;     /*                             ... adj src buf.         */
 
+        p_file->BufMaxPos +=  size_wr;                          /* Save max pos wr in buf.                              */
+        p_file->BufStatus  =  FS_FILE_BUF_STATUS_NONEMPTY_WR;
+       *p_err = FS_ERR_NONE;
+    }
 
-                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
-#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
-                                                                /* Blk buf assignment.                                  */
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {
-        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
 
 
-                                                                /* Empty buf.                                           */
-    } else {
-        FSFile_BufEmpty(p_file, p_err);
+    if (p_file->BufMaxPos == p_file->BufSize) {                 /* ------------------- DUMP TO FILE ------------------- */
+        FSSys_FileWr(p_file,                                    /* Wr buf to file ...                                   */
+                     p_file->BufPtr,
+                     p_file->BufSize,
+                     p_err);
         if (*p_err != FS_ERR_NONE) {
-            FSFile_ReleaseUnlock(p_file);
-            return;
+            p_file->FlagErr = DEF_YES;
+            return (size - size_rem);
         }
-    }
-#endif
 
+        p_file->BufStart  = 0u;                                 /* ... buf now empty.                                   */
+        p_file->BufMaxPos = 0u;
+        p_file->BufStatus = FS_FILE_BUF_STATUS_EMPTY;
+       *p_err = FS_ERR_NONE;
 
 
-                                                                /* ------------------- TRUNCATE FILE ------------------ */
-    if (size == p_file->Size) {                                 /* If no chng in size ...                               */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_NONE;                                    /* ... nothing to do.                                   */
-        return;
-    }
-
-    if (size > p_file->Size) {                                  /* Check if the file must be truncated or extended.     */
-                                                                /* Extension needed ... */
-                                                                /* ... fill empty area with '\0'                        */
-        fill_size = size - p_file->Size;
-                                                                /* Alloc buf filled with '\0'                           */
-        p_buf = FSBuf_Get(p_file->VolPtr);
-        if (p_buf == (FS_BUF *)0) {
-           *p_err = FS_ERR_BUF_NONE_AVAIL;
-            FSFile_ReleaseUnlock(p_file);
-            return;
-        }
-        buf_size = p_buf->Size;
-
-        Mem_Set ((void *)      p_buf->DataPtr,
-                 (CPU_INT08U)  ASCII_CHAR_NULL,
-                 (CPU_SIZE_T)  buf_size);
-                                                                /* Set pos after last valid data                        */
-        FSSys_FilePosSet(p_file, p_file->Size, p_err);
-        if (*p_err != FS_ERR_NONE) {
-            FSFile_ReleaseUnlock(p_file);
-            FSBuf_Free(p_buf);
-            return;
-        }
 
-                                                                /* Write '\0' to file                                   */
+        if (size_rem >= p_file->BufSize) {                      /* ------------------ HANDLE LARGE WR ----------------- */
+            size_wr = FSSys_FileWr(p_file,                      /* Wr data to file.                                     */
+                                   p_src,
+                                   size_rem,
+                                   p_err);
+            p_file->Pos    +=  size_wr;                         /* Adj file pos ...                                     */
+            size_rem       -=  size_wr;                         /*              ... adj wr rem.                         */
 
-                                                                /* Wr rem of sec.                                       */
-        wr_size = p_file->VolPtr->SecSize - (p_file->Pos % p_file->VolPtr->SecSize);
-        if (fill_size < wr_size) {                              /* Limit wr to tot size.                                */
-            wr_size = fill_size;
-        }
+            p_file->FlagErr = (*p_err != FS_ERR_NONE) ? DEF_YES : DEF_NO;
 
-        while (fill_size > 0u) {
-            FSSys_FileWr (p_file,
-                          p_buf->DataPtr,
-                          wr_size,
-                          p_err);
             if (*p_err != FS_ERR_NONE) {
-                FSFile_ReleaseUnlock(p_file);
-                FSBuf_Free(p_buf);
-                return;
+                p_file->FlagErr = DEF_YES;
             }
-            fill_size    -= wr_size;
-            p_file->Size += wr_size;
 
-            if (fill_size > buf_size) {                         /* Limit wr to buf size.                                */
-                wr_size = buf_size;
-            } else {
-                wr_size = fill_size;
+
+
+        } else {
+            if (size_rem > 0u) {                                /* -------------- WR REM TO START OF BUF -------------- */
+                size_wr            = size_rem;
+                Mem_Copy(p_file->BufPtr, p_src, size_rem);      /* Copy from user buf to file buf.                      */
+
+                p_file->BufStart   = p_file->Pos;               /* Save file pos at buf start.                          */
+
+                p_file->Pos       += size_wr;                   /* Adj file pos ...                                     */
+                size_rem          -= size_wr;                   /*              ... adj wr rem.                         */
+
+                p_file->BufMaxPos  = size_wr;                   /* Save max wr pos in buf.                              */
+                p_file->BufStatus  = FS_FILE_BUF_STATUS_NONEMPTY_WR;
+               *p_err = FS_ERR_NONE;
             }
         }
+    }
 
-        FSSys_FilePosSet(p_file, p_file->Pos, p_err);           /* Restore the original position.                       */
-        if (*p_err != FS_ERR_NONE) {
-            FSFile_ReleaseUnlock(p_file);
-            FSBuf_Free(p_buf);
-            return;
-        }
 
-        FSBuf_Free(p_buf);
 
-    } else {
-        FSSys_FileTruncate(p_file,                              /* Truncate file.                                       */
-                           size,
-                           p_err);
+                                                                /* ------------------- ASSIGN & RTN ------------------- */
+    if (p_file->Size < p_file->Pos) {                           /* Chng file size.                                      */
+        p_file->Size = p_file->Pos;
+    }
+    return (size - size_rem);
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FSFile_BufStreamWait()
+*
+* Description : Wait for the pending flush of a stream buffer half, if any.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE             No flush pending, or flush completed.
+*
+*                                                       ------ RETURNED BY FS_OS_FileAsyncReqPend() -----
+*                               FS_ERR_OS_LOCK          Semaphore NOT acquired.
+*
+*                                                       ----------- RETURNED BY FSSys_FileWr() ----------
+*                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
+*                               FS_ERR_DEV              Device access error.
+*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST hold the file lock (if file locks are enabled) but NOT the
+*                   volume lock.
+*
+*               (2) If the flush failed, the error indicator is set.  If the wait itself failed, the flush
+*                   is still pending.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_BUF_EN   == DEF_ENABLED)
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+static  void  FSFile_BufStreamWait (FS_FILE  *p_file,
+                                    FS_ERR   *p_err)
+{
+    FS_FILE_ASYNC_REQ  *p_req;
+
+
+    if (p_file->BufFlushPend == DEF_NO) {                       /* Rtn if no flush pending.                             */
+       *p_err = FS_ERR_NONE;
+        return;
     }
 
+    p_req = p_file->BufFlushReqPtr;
+    FS_OS_FileAsyncReqPend(p_req->ID, 0u, p_err);               /* Wait for worker task to complete flush.              */
     if (*p_err != FS_ERR_NONE) {
-        p_file->FlagEOF = DEF_NO;
-        p_file->FlagErr = DEF_YES;
-        FSFile_ReleaseUnlock(p_file);
         return;
     }
 
-    if (size < p_file->Pos) {
-        p_file->Pos = size;                                     /* Set file pos to new EOF (see Note #3).               */
+    p_file->BufFlushPend = DEF_NO;
+   *p_err = p_req->Err;
+    if (*p_err != FS_ERR_NONE) {                                /* See Note #2.                                         */
+        p_file->FlagErr = DEF_YES;
     }
-
-    p_file->Size    =  size;
-    p_file->FlagEOF =  DEF_NO;
-    p_file->FlagErr = (*p_err != FS_ERR_NONE) ? DEF_YES : DEF_NO;
-
-
-
-                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
-    FSFile_ReleaseUnlock(p_file);
 }
 #endif
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                              FSFile_Wr()
+*                                         FSFile_BufStreamWr()
 *
-* Description : Write to a file.
+* Description : Write to a file (through stream buffer).
 *
 * Argument(s) : p_file      Pointer to a file.
+*               ----------  Argument validated by caller.
 *
-*               p_src       Pointer to source buffer.
+*               p_src       Pointer to buffer that contains data to write in this file.
+*               ----------  Argument validated by caller.
 *
 *               size        Number of octets to write.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
 *
 *                               FS_ERR_NONE                   File written successfully.
-*                               FS_ERR_NULL_PTR               Argument 'p_file'/'p_src' passed a NULL pointer.
-*                               FS_ERR_INVALID_TYPE           Argument 'p_file's TYPE is invalid or
-*                                                                 unknown.
-*                               FS_ERR_FILE_ERR               File has error (see Note #6).
-*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file (see Note #3).
-*                               FS_ERR_FILE_INVALID_OP_SEQ    Invalid operation sequence on file (see Note #2).
-*                               FS_ERR_FILE_OVF               File size/position would be overflowed if
-*                                                                 write were executed (see Note #4).
-*
-*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
-*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_FILE_ERR               File has error.
+*                               FS_ERR_FILE_INVALID_OP_SEQ    Invalid operation sequence on file.
 *                               FS_ERR_FILE_NOT_OPEN          File NOT open.
+*                               FS_ERR_FILE_OVF               File size/position would be overflowed if
+*                                                                 write were executed.
+*                               FS_ERR_OS_LOCK                File lock NOT acquired.
 *
-*                                                             -------- RETURNED BY FSSys_FileWr() -------
-*                                                             -------- RETURNED BY FSSys_PosSet() -------
+*                                                             ---- RETURNED BY FSFile_BufStreamWait() ---
+*                                                             ----- RETURNED BY FSSys_FilePosSet() ------
 *                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
 *                               FS_ERR_DEV                    Device access error.
 *                               FS_ERR_DEV_FULL               Device is full (no space could be allocated).
 *                               FS_ERR_ENTRY_CORRUPT          File system entry is corrupt.
 *
-* Return(s)   : Number of octets written, if no error (see Notes #1a & #1b).
-*               0,                        otherwise.
-*
-* Note(s)     : (1) If 'size' is zero, then the file is unchanged & zero is returned.
-*
-*               (2) If the last operation is input (read), then a call to 'FSFile_PosSet()' MUST occur
-*                   before output (write) can be performed, unless the end-of-file was encountered.  See
-*                  'fs_fopen()  Note #1e'.
+*                                                             ---- RETURNED BY FSFile_AsyncReqAlloc() ---
+*                               FS_ERR_OS_LOCK                OS lock NOT acquired.
 *
-*                   (a) If data is in the read buffer, the buffer MUST be emptied before the write.
+* Return(s)   : Number of octets written, if no error.
+*               0,                        otherwise.
 *
-*               (3) The file MUST have been opened in write or update (read/write) mode.
+* Note(s)     : (1) The checks performed are those of 'FSFile_Wr()'.  See 'FSFile_Wr()  Note(s)'.
 *
-*               (4) If the file was opened in append mode, all writes are forced to the EOF.
+*               (2) Only the file reference & the file lock (if file locks are enabled) are acquired, so
+*                   that data may be copied into one buffer half while the other half is written to the
+*                   device.  If file locks are NOT enabled, a file in stream mode MUST NOT be accessed by
+*                   several tasks at once.
 *
-*                   (a) This is only necessary if the file buffer is non-empty; if the file buffer
-*                       contains data, then all writes are automatically at the EOF (since the file
-*                       position was set to the EOF before the first write to the buffer).
+*               (3) When a buffer half is full, the previous flush is waited for & a flush of the full half
+*                   is queued on the file, to be serviced by a worker task (see 'FSFile_AsyncReqExec()
+*                   Note #2').  At most one flush is pending at a time.  The asynchronous request used is
+*                   allocated at the first flush & reserved for the file until it is closed.
 *
-*               (5) Overflow of the file position MUST be checked.  If the write would result in overflow,
-*                   no data shall be written & an error shall be returned.
+*               (4) The first half filled after the file position is set is limited so that it ends on an
+*                   alignment boundary.  Every following flush starts on a cluster (or sector) boundary &
+*                   covers whole clusters (or sectors), so that the device is written with aligned
+*                   multi-sector writes.
 *
-*               (6) If an error occurred in the previous file access, the error indicator must be
-*                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*               (5) Data larger than a buffer half is copied through the buffer halves rather than written
+*                   directly, so that every device write remains aligned.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-CPU_SIZE_T  FSFile_Wr (FS_FILE     *p_file,
-                       void        *p_src,
-                       CPU_SIZE_T   size,
-                       FS_ERR      *p_err)
+#if (FS_CFG_FILE_BUF_EN   == DEF_ENABLED)
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+#if (FS_CFG_RD_ONLY_EN    == DEF_DISABLED)
+static  CPU_SIZE_T  FSFile_BufStreamWr (FS_FILE     *p_file,
+                                        void        *p_src,
+                                        CPU_SIZE_T   size,
+                                        FS_ERR      *p_err)
 {
-    FS_FILE_SIZE  pos;
-    CPU_SIZE_T    size_wr;
+    FS_FILE_ASYNC_REQ  *p_req;
+    void               *p_buf_full;
+    CPU_INT08U         *p_buf;
+    CPU_SIZE_T          buf_lim;
+    CPU_SIZE_T          buf_rem;
+    CPU_SIZE_T          size_wr;
+    CPU_SIZE_T          size_rem;
+    CPU_BOOLEAN         locked;
+    CPU_BOOLEAN         post;
 
 
-#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
-    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
-        CPU_SW_EXCEPTION(0u);
-    }
-    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
-       *p_err = FS_ERR_NULL_PTR;
-        return (0u);
-    }
-    if (p_src == (void *)0) {                                   /* Validate src ptr.                                    */
-       *p_err = FS_ERR_NULL_PTR;
-        return (0u);
-    }
-#endif
-
                                                                 /* ----------------- ACQUIRE FILE LOCK ---------------- */
-    (void)FSFile_AcquireLockChk(p_file, p_err);
-    if (*p_err != FS_ERR_NONE) {
-        return (0u);
-    }
-
-                                                                /* Chk file mode (see Note #3).                         */
-    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_INVALID_OP;
-        return (0u);
-    }
-
-    if (p_file->IO_State == FS_FILE_IO_STATE_RD) {              /* Chk for wr state (see Note #2) ...                   */
-        if (p_file->FlagEOF == DEF_NO) {                        /* ... or EOF exceeded            ...                   */
-            if (p_file->Pos != p_file->Size) {                  /* ... or EOF met.                                      */
-                FSFile_ReleaseUnlock(p_file);
-               *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
-                return (0u);
-            }
-        }
-    }
-
-    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err (see Note #6).                      */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_ERR;
+    if (FSFile_Acquire(p_file) == (FS_FILE *)0) {               /* Acquire file ref.                                    */
+       *p_err = FS_ERR_FILE_NOT_OPEN;
         return (0u);
     }
 
-    if (size == 0u) {                                           /* Rtn 0 bytes wr (see Note #1).                        */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_NONE;
+#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
+    locked = FSFile_LockGetHandler(p_file);                     /* Acquire file lock only (see Note #2).                */
+#else
+    locked = DEF_YES;
+#endif
+    if (locked != DEF_YES) {
+        FSFile_Release(p_file);
+       *p_err = FS_ERR_OS_LOCK;
         return (0u);
     }
 
-    p_file->FlagEOF = DEF_NO;                                   /* Clr EOF.                                             */
-
 
 
-                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
-#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) {  /* Chk buf status (see Note #2a).                       */
-        FSFile_BufEmpty(p_file, p_err);
+                                                                /* ------------------- VALIDATE FILE ------------------ */
+   *p_err    = FS_ERR_NONE;                                     /* See Note #1.                                         */
+    size_rem = size;
+    if (p_file->State != FS_FILE_STATE_OPEN) {
+       *p_err = FS_ERR_FILE_NOT_OPEN;
 
-        if (*p_err != FS_ERR_NONE) {                            /* Rtn if rd/wr err.                                    */
-            p_file->FlagErr = DEF_YES;
-            FSFile_ReleaseUnlock(p_file);
-            return (0u);
-        }
-    }
+    } else if ((p_file->IO_State == FS_FILE_IO_STATE_RD) &&
+               (p_file->FlagEOF  == DEF_NO)              &&
+               (p_file->Pos      != p_file->Size)) {
+       *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
 
-                                                                /* Wr to buf.                                           */
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-    if (DEF_BIT_IS_SET(p_file->BufMode, FS_FILE_BUF_MODE_WR) == DEF_YES) {
-        if (p_file->BufStatus == FS_FILE_BUF_STATUS_EMPTY) {
-            if (DEF_BIT_IS_SET(p_file->AccessMode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
-                if (p_file->Pos != p_file->Size) {                  /* If pos NOT at EOF ...                            */
-                    FSSys_FilePosSet(p_file, p_file->Size, p_err);  /* ... set pos to EOF (see Note #4a).               */
+    } else if (p_file->FlagErr == DEF_YES) {
+       *p_err = FS_ERR_FILE_ERR;
 
-                    if (*p_err != FS_ERR_NONE) {
-                        p_file->FlagErr = DEF_YES;
-                        FSFile_ReleaseUnlock(p_file);
-                        return (0u);
-                    }
+    } else if (FS_FILE_SIZE_MAX - (FS_FILE_SIZE)size < p_file->Pos) {
+       *p_err = FS_ERR_FILE_OVF;
 
-                    p_file->Pos = p_file->Size;
+    } else if (size > 0u) {
+        p_file->FlagEOF = DEF_NO;                               /* Clr EOF.                                             */
+
+        if ((p_file->BufStatus == FS_FILE_BUF_STATUS_EMPTY) &&  /* Set pos to EOF in append mode.                       */
+            (DEF_BIT_IS_SET(p_file->AccessMode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) &&
+            (p_file->Pos != p_file->Size)) {
+            FSFile_BufStreamWait(p_file, p_err);
+            if (*p_err == FS_ERR_NONE) {
+                locked = FSVol_Lock(p_file->VolPtr);
+                if (locked == DEF_YES) {
+                    FSSys_FilePosSet(p_file, p_file->Size, p_err);
+                    FSVol_Unlock(p_file->VolPtr);
+                } else {
+                   *p_err = FS_ERR_OS_LOCK;
                 }
             }
+            if (*p_err == FS_ERR_NONE) {
+                p_file->Pos = p_file->Size;
+            } else {
+                p_file->FlagErr = DEF_YES;
+            }
         }
+    } else {
+        ;                                                       /* Rtn 0 bytes wr.                                      */
+    }
 
-        size_wr = FSFile_BufWr(p_file,
-                               p_src,
-                               size,
-                               p_err);
 
-        if (*p_err != FS_ERR_NONE ) {
-            p_file->FlagErr = DEF_NO;
-            FSFile_ReleaseUnlock(p_file);
-            return (0u);
-        }
 
-        if (size_wr != 0u) {                                    /* Set I/O state.                                       */
-            p_file->IO_State = FS_FILE_IO_STATE_WR;
+                                                                /* ----------------- WR TO STREAM BUF ----------------- */
+    while ((*p_err == FS_ERR_NONE) && (size_rem > 0u)) {
+        if (p_file->BufStatus == FS_FILE_BUF_STATUS_EMPTY) {
+            p_file->BufStart  = p_file->Pos;                    /* Save file pos at buf start.                          */
+            p_file->BufMaxPos = 0u;
+        }
+                                                                /* Calc size of half up to next boundary (see Note #4). */
+        buf_lim = p_file->BufSize - (CPU_SIZE_T)(p_file->BufStart % (FS_FILE_SIZE)p_file->BufAlignSize);
+        buf_rem = (buf_lim > p_file->BufMaxPos) ? (buf_lim - p_file->BufMaxPos) : 0u;
+        size_wr = DEF_MIN(buf_rem, size_rem);
+        if (size_wr > 0u) {
+            p_buf = (CPU_INT08U *)p_file->BufPtr + p_file->BufMaxPos;
+            Mem_Copy((void *)p_buf, p_src, size_wr);            /* Copy from user buf to file buf.                      */
+
+            p_file->Pos       +=  size_wr;                      /* Adj file pos ...                                     */
+            size_rem          -=  size_wr;                      /*              ... adj wr rem ...                      */
+            p_src              = (CPU_INT08U *)p_src + size_wr; /*                             ... adj src buf.         */
+
+            p_file->BufMaxPos +=  size_wr;
+            p_file->BufStatus  =  FS_FILE_BUF_STATUS_NONEMPTY_WR;
         }
 
-        FSFile_ReleaseUnlock(p_file);
-        return (size_wr);
-    }
-#endif
-
-                                                                /* Blk buf assignment.                                  */
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {
-        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
-    }
-#endif
-
+        if (p_file->BufMaxPos >= buf_lim) {                     /* Flush full half (see Note #3).                       */
+            FSFile_BufStreamWait(p_file, p_err);                /* Wait for prev flush.                                 */
+            if (*p_err != FS_ERR_NONE) {
+                p_file->FlagErr = DEF_YES;
+                break;
+            }
 
-                                                                /* ------------------- SET FILE POS ------------------- */
-                                                                /* See Note #4.                                         */
-    if (DEF_BIT_IS_SET(p_file->AccessMode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
-        if (p_file->Pos != p_file->Size) {                      /* If pos NOT at EOF ...                                */
-            FSSys_FilePosSet(p_file, p_file->Size, p_err);      /* ... set pos to EOF.                                  */
+            if (p_file->BufFlushReqPtr == (FS_FILE_ASYNC_REQ *)0) {
+                p_file->BufFlushReqPtr = FSFile_AsyncReqAlloc(0u, p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    p_file->FlagErr = DEF_YES;
+                    break;
+                }
+            }
 
+            (void)FSFile_Acquire(p_file);                       /* Acquire file ref for req (see 'FSFile_AsyncSubmit()  */
+                                                                /* Note #1').                                           */
+            FS_OS_Lock(FS_OS_LOCK_ID_FILE, p_err);
             if (*p_err != FS_ERR_NONE) {
+                FSFile_Release(p_file);
                 p_file->FlagErr = DEF_YES;
-                FSFile_ReleaseUnlock(p_file);
-                return (0u);
+                break;
             }
 
-            p_file->Pos = p_file->Size;
+            p_req               = p_file->BufFlushReqPtr;
+            p_req->State        = FS_FILE_ASYNC_REQ_STATE_QUEUED;
+            p_req->Op           = FS_FILE_ASYNC_OP_BUF_WR;
+            p_req->FilePtr      = p_file;
+            p_req->BufPtr       = p_file->BufPtr;
+            p_req->Size         = p_file->BufMaxPos;
+            p_req->SizeDone     = 0u;
+            p_req->Err          = FS_ERR_NONE;
+            p_req->CallbackFnct = (FS_FILE_ASYNC_CALLBACK)0;
+            p_req->CallbackArg  = (void *)0;
+            p_req->NextPtr      = (FS_FILE_ASYNC_REQ *)0;
+
+            post = FSFile_AsyncReqAdd(p_file, p_req);
+            FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+
+            if (post == DEF_YES) {
+                FS_OS_FileAsyncTaskPost();
+            }
+            p_file->BufFlushPend = DEF_YES;
+
+            p_buf_full        = p_file->BufPtr;                 /* Swap buf halves.                                     */
+            p_file->BufPtr    = p_file->BufAltPtr;
+            p_file->BufAltPtr = p_buf_full;
+            p_file->BufStart  = p_file->Pos;
+            p_file->BufMaxPos = 0u;
+            p_file->BufStatus = FS_FILE_BUF_STATUS_EMPTY;
         }
     }
 
 
 
-                                                                /* ---------------------- WR FILE --------------------- */
-    pos = p_file->Pos;                                          /* See Note #5.                                         */
-    if (FS_FILE_SIZE_MAX - (FS_FILE_SIZE)size < pos) {          /* Rtn err & 0 bytes wr'n if wr will ovf max file size. */
-        FSFile_ReleaseUnlock(p_file);
-       *p_err = FS_ERR_FILE_OVF;
-        return (0u);
+                                                                /* ------------------- ASSIGN & RTN ------------------- */
+    if (p_file->Size < p_file->Pos) {                           /* Chng file size.                                      */
+        p_file->Size = p_file->Pos;
+    }
+    if (size_rem != size) {                                     /* Set I/O state.                                       */
+        p_file->IO_State = FS_FILE_IO_STATE_WR;
     }
 
-    size_wr = FSSys_FileWr(p_file,                              /* Wr to file.                                          */
-                           p_src,
-                           size,
-                           p_err);
+#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
+    (void)FSFile_LockSetHandler(p_file);
+#endif
+    FSFile_Release(p_file);
 
-    if (*p_err != FS_ERR_NONE ) {
-        p_file->FlagErr = DEF_YES;
-        FSFile_ReleaseUnlock(p_file);
+    if (*p_err != FS_ERR_NONE) {
         return (0u);
     }
-
-    p_file->IO_State = FS_FILE_IO_STATE_WR;
-    p_file->Pos += size_wr;
-    if (p_file->Size < p_file->Pos) {
-        p_file->Size = p_file->Pos;
-    }
-
-                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
-    FSFile_ReleaseUnlock(p_file);
-    return (size_wr);
+    return (size);
 }
 #endif
+#endif
+#endif
 
 
 /*
 *********************************************************************************************************
-*********************************************************************************************************
-*                                      FILE MANAGEMENT FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
-
-/*
-*********************************************************************************************************
-*                                         FSFile_GetFileCnt()
+*                                         FSFile_SizeExtend()
 *
-* Description : Get the number of open files.
+* Description : Extend a file with zeros.
 *
-* Argument(s) : none.
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
 *
-* Return(s)   : The number of open files.
+*               size        Size of file after extension.
 *
-* Note(s)     : none.
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE              File extended.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*
+*                                                        ----- RETURNED BY FSSys_FileWr() -----
+*                                                        ---- RETURNED BY FSSys_FilePosSet() --
+*                               FS_ERR_DEV               Device access error.
+*                               FS_ERR_DEV_FULL          Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT     File system entry is corrupt.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) 'size' MUST be greater than the file size.  The file's buffer MUST be empty.
+*
+*               (2) The system driver file position is left at the new end of file; 'p_file->Pos' is NOT
+*                   updated, so the caller MUST set the position afterwards.
 *********************************************************************************************************
 */
 
-FS_QTY  FSFile_GetFileCnt (void)
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSFile_SizeExtend (FS_FILE       *p_file,
+                                 FS_FILE_SIZE   size,
+                                 FS_ERR        *p_err)
 {
-    FS_QTY  file_cnt;
-    FS_ERR  err;
+    CPU_INT32U   fill_size;
+    CPU_INT32U   wr_size;
+    CPU_INT32U   buf_size;
+    FS_BUF      *p_buf;
 
 
-                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
-    if (err != FS_ERR_NONE) {
-        return (0u);
+                                                                /* Fill empty area with '\0'                            */
+    fill_size = size - p_file->Size;
+                                                                /* Alloc buf filled with '\0'                           */
+    p_buf = FSBuf_Get(p_file->VolPtr);
+    if (p_buf == (FS_BUF *)0) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
     }
+    buf_size = p_buf->Size;
 
+    Mem_Set ((void *)      p_buf->DataPtr,
+             (CPU_INT08U)  ASCII_CHAR_NULL,
+             (CPU_SIZE_T)  buf_size);
+                                                                /* Set pos after last valid data                        */
+    FSSys_FilePosSet(p_file, p_file->Size, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        FSBuf_Free(p_buf);
+        return;
+    }
 
+                                                                /* Write '\0' to file                                   */
 
-                                                                /* ------------------- GET FILE CNT ------------------- */
-    file_cnt = FSFile_Cnt;
-
-
+                                                                /* Wr rem of sec.                                       */
+    wr_size = p_file->VolPtr->SecSize - (p_file->Size % p_file->VolPtr->SecSize);
+    if (fill_size < wr_size) {                                  /* Limit wr to tot size.                                */
+        wr_size = fill_size;
+    }
 
-                                                                /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    while (fill_size > 0u) {
+        FSSys_FileWr (p_file,
+                      p_buf->DataPtr,
+                      wr_size,
+                      p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSBuf_Free(p_buf);
+            return;
+        }
+        fill_size    -= wr_size;
+        p_file->Size += wr_size;
 
-    return (file_cnt);
+        if (fill_size > buf_size) {                             /* Limit wr to buf size.                                */
+            wr_size = buf_size;
+        } else {
+            wr_size = fill_size;
+        }
+    }
+    FSBuf_Free(p_buf);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                       FSFile_GetFileCntMax()
+*                                       FSFile_AcquireLockChk()
 *
-* Description : Get the maximum possible number of open files.
+* Description : Acquire file reference & lock.
 *
-* Argument(s) : none.
+* Argument(s) : p_file      Pointer to file.
+*               ----------  Argument validated by caller.
 *
-* Return(s)   : The maximum number of open files.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE             File reference & lock acquired.
+*                               FS_ERR_DEV_CHNGD        Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
+*
+* Return(s)   : Pointer to a file, if found.
+*               Pointer to NULL,   otherwise.
 *
 * Note(s)     : none.
 *********************************************************************************************************
 */
 
-FS_QTY  FSFile_GetFileCntMax (void)
+static  FS_FILE  *FSFile_AcquireLockChk (FS_FILE      *p_file,
+                                         FS_ERR       *p_err)
 {
-    FS_QTY  file_cnt_max;
-
+    p_file = FSFile_AcquireLockChkEx(p_file, DEF_NO, p_err);
 
-                                                                /* ----------------- GET FILE CNT MAX ----------------- */
-    file_cnt_max = FSFile_FileCntMax;
-
-    return (file_cnt_max);
+    return (p_file);
 }
 
 
 /*
 *********************************************************************************************************
-*********************************************************************************************************
-*                                         INTERNAL FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
-
-/*
-*********************************************************************************************************
-*                                         FSFile_ModuleInit()
+*                                      FSFile_AcquireLockChkEx()
 *
-* Description : Initialize File System File Management module.
+* Description : Acquire file reference & lock, optionally holding the volume lock in shared mode.
 *
-* Argument(s) : file_cnt    Number of files to allocate.
+* Argument(s) : p_file      Pointer to file.
+*               ----------  Argument validated by caller.
+*
+*               lock_shared Indicates whether the volume lock may be acquired in shared mode :
+*
+*                               DEF_YES, if caller only reads from file (see 'FSFile_Lock()  Note #1').
+*                               DEF_NO,  otherwise.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
-*                               FS_ERR_NONE         Module initialized.
-*                               FS_ERR_MEM_ALLOC    Memory could not be allocated.
+*                               FS_ERR_NONE             File reference & lock acquired.
+*                               FS_ERR_DEV_CHNGD        Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
 *
-* Return(s)   : none.
+* Return(s)   : Pointer to a file, if found.
+*               Pointer to NULL,   otherwise.
 *
 * Note(s)     : none.
 *********************************************************************************************************
 */
 
-void  FSFile_ModuleInit (FS_QTY   file_cnt,
-                         FS_ERR  *p_err)
+static  FS_FILE  *FSFile_AcquireLockChkEx (FS_FILE      *p_file,
+                                           CPU_BOOLEAN   lock_shared,
+                                           FS_ERR       *p_err)
 {
-    CPU_SIZE_T  octets_reqd;
-    LIB_ERR     pool_err;
-
+    CPU_BOOLEAN  lock_success;
 
-#if (FS_CFG_TRIAL_EN == DEF_ENABLED)                            /* Trial limitation: max 1 file.                        */
-    if (file_cnt > FS_TRIAL_MAX_FILE_CNT) {
-       *p_err = FS_ERR_INVALID_CFG;
-        return;
-    }
-#endif
 
-    FSFile_FileCntMax = 0u;
-    FSFile_Cnt        = 0u;
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    p_file = FSFile_Acquire(p_file);                            /* Acquire file ref.                                    */
 
-#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)                        /* -------------- PERFORM FS/OS FILE INIT ------------- */
-    FS_OS_FileInit(file_cnt, p_err);
-    if (*p_err != FS_ERR_NONE) {
-        return;
+    if (p_file == (FS_FILE *)0) {                               /* Rtn err if file not found.                           */
+       *p_err = FS_ERR_FILE_NOT_OPEN;
+        return ((FS_FILE *)0);
     }
-#endif
 
-
-
-                                                                /* ------------------ INIT FILE POOL ------------------ */
-    Mem_PoolCreate(&FSFile_Pool,
-                    DEF_NULL,
-                    0,
-                    file_cnt,
-                    sizeof(FS_FILE),
-                    sizeof(CPU_ALIGN),
-                   &octets_reqd,
-                   &pool_err);
-
-    if (pool_err != LIB_MEM_ERR_NONE) {
-        *p_err  = FS_ERR_MEM_ALLOC;
-        FS_TRACE_INFO(("FSFile_ModuleInit(): Could not alloc mem for files: %d octets required.\r\n", octets_reqd));
-        return;
+    lock_success = FSFile_Lock(p_file, lock_shared);
+    if (lock_success != DEF_YES) {
+       *p_err = FS_ERR_OS_LOCK;
+        return ((FS_FILE *)0);
     }
 
-    FSFile_Tbl = (FS_FILE **)Mem_HeapAlloc(file_cnt * sizeof(FS_FILE *),
-                                           sizeof(CPU_ALIGN),
-                                          &octets_reqd,
-                                          &pool_err);
-    if (pool_err != LIB_MEM_ERR_NONE) {
-       *p_err  = FS_ERR_MEM_ALLOC;
-        FS_TRACE_INFO(("FSFile_ModuleInit(): Could not alloc mem for files: %d octets required.\r\n", octets_reqd));
-        return;
-    }
 
-    Mem_Clr(FSFile_Tbl, file_cnt * sizeof(FS_FILE *));
+                                                                /* ------------------- VALIDATE FILE ------------------ */
+    switch (p_file->State) {
+        case FS_FILE_STATE_OPEN:
+            *p_err = FS_ERR_NONE;
+             return (p_file);
 
-    FSFile_FileCntMax = file_cnt;
 
-   *p_err = FS_ERR_NONE;
+        case FS_FILE_STATE_CLOSED:                              /* Rtn NULL if file not open.                           */
+        case FS_FILE_STATE_CLOSING:
+        case FS_FILE_STATE_OPENING:
+        default:
+            *p_err = FS_ERR_FILE_NOT_OPEN;
+             FSFile_ReleaseUnlock(p_file);
+             return ((FS_FILE *)0);
+    }
 }
 
 
 /*
 *********************************************************************************************************
-*                                         FSFile_ModeParse()
+*                                      FSFile_AcquireVolLockChk()
 *
-* Description : Parse mode string.
+* Description : Acquire file reference & volume lock, without acquiring task ownership of the file.
 *
-* Argument(s) : str_mode        Access mode of the file.
-*               --------        Argument validated by caller.
+* Argument(s) : p_file          Pointer to file.
+*               ------          Argument validated by caller.
 *
-*               str_len         Length of the mode string.
+*               p_lock_shared   Pointer to variable that :
+*               -------------   Argument validated by caller.
 *
-* Return(s)   : Mode identifier, if mode string invalid.
-*               0, otherwise.
+*                                   (a) holds DEF_YES if the volume lock may be acquired in shared mode;
+*                                   (b) will receive DEF_YES if the volume lock was acquired in shared mode.
 *
-* Note(s)     : (1) See 'FSFile_Open()  Note #2' for a description of mode string interpretation.
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               -----           Argument validated by caller.
+*
+*                                   FS_ERR_NONE             File reference & lock acquired.
+*                                   FS_ERR_FILE_NOT_OPEN    File NOT open.
+*                                   FS_ERR_OS_LOCK          Volume lock NOT acquired.
+*
+* Return(s)   : Pointer to a file, if found.
+*               Pointer to NULL,   otherwise.
+*
+* Note(s)     : (1) Positional operations do not use the file position, so they need not be serialized
+*                   with other accesses to the same file.  The lock mode is returned to the caller rather
+*                   than stored in the file, since several positional reads may hold the volume lock in
+*                   shared mode through the same file at once.  See also 'FSFile_Lock()  Note #1'.
+*
+*               (2) The lock MUST be released with 'FSFile_ReleaseVolUnlock()'.
 *********************************************************************************************************
 */
-FS_FLAGS  FSFile_ModeParse (CPU_CHAR    *str_mode,
-                            CPU_SIZE_T   str_len)
-{
-    FS_FLAGS     mode;
-    CPU_BOOLEAN  b_present;
-    CPU_BOOLEAN  plus_present;
-
 
-                                                                /* -------------------- PARSE MODE -------------------- */
-    switch (*str_mode) {                                        /* Interpret first letter: rd, wr, append.              */
-        case ASCII_CHAR_LATIN_LOWER_R:
-             mode = FS_FILE_ACCESS_MODE_RD;
-             break;
+static  FS_FILE  *FSFile_AcquireVolLockChk (FS_FILE      *p_file,
+                                            CPU_BOOLEAN  *p_lock_shared,
+                                            FS_ERR       *p_err)
+{
+    CPU_BOOLEAN  locked;
 
-        case ASCII_CHAR_LATIN_LOWER_W:
-             mode = FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_TRUNCATE | FS_FILE_ACCESS_MODE_CREATE;
-             break;
 
-        case ASCII_CHAR_LATIN_LOWER_A:
-             mode = FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_CREATE   | FS_FILE_ACCESS_MODE_APPEND;
-             break;
+    p_file = FSFile_Acquire(p_file);                            /* Acquire file ref.                                    */
 
-        default:
-             return (FS_FILE_ACCESS_MODE_NONE);
+    if (p_file == (FS_FILE *)0) {                               /* Rtn err if file not found.                           */
+       *p_err = FS_ERR_FILE_NOT_OPEN;
+        return ((FS_FILE *)0);
     }
-    str_mode++;
-    str_len--;
-
-
-                                                                /* Interpret remaining str: "", "+", "b", "b+", "+b".   */
-    b_present    = DEF_NO;
-    plus_present = DEF_NO;
-
-    while (str_len > 0u) {
-        if (*str_mode == (CPU_CHAR)ASCII_CHAR_PLUS_SIGN) {
-
-            if (plus_present == DEF_YES) {
-                mode  = FS_FILE_ACCESS_MODE_NONE;               /* Invalid mode.                                        */
-                return (mode);
-            }
-            mode |= FS_FILE_ACCESS_MODE_RD | FS_FILE_ACCESS_MODE_WR;
-            plus_present = DEF_YES;
 
-        } else if (*str_mode == (CPU_CHAR)ASCII_CHAR_LATIN_LOWER_B) {
-
-            if (b_present == DEF_YES) {
-                mode  = FS_FILE_ACCESS_MODE_NONE;               /* Invalid mode.                                        */
-                return (mode);
-            }
-            b_present = DEF_YES;
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+    if ((*p_lock_shared == DEF_YES) &&                          /* Shared lock for rd-only access (see Note #1).        */
+        (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES)) {
+        locked = FSVol_LockShared(p_file->VolPtr);
+    } else {
+       *p_lock_shared = DEF_NO;
+        locked = FSVol_Lock(p_file->VolPtr);
+    }
+#else
+   *p_lock_shared = DEF_NO;
+    locked = FSVol_Lock(p_file->VolPtr);
+#endif
 
-        } else {
+    if (locked != DEF_YES) {
+        FSFile_Release(p_file);
+       *p_err = FS_ERR_OS_LOCK;
+        return ((FS_FILE *)0);
+    }
 
-            mode  = FS_FILE_ACCESS_MODE_NONE;                   /* Invalid mode.                                        */
-            return(mode);
 
-        }
-        str_mode++;
-        str_len--;
+                                                                /* ------------------- VALIDATE FILE ------------------ */
+    if (p_file->State != FS_FILE_STATE_OPEN) {                  /* Rtn NULL if file not open.                           */
+        FSFile_ReleaseVolUnlock(p_file, *p_lock_shared);
+       *p_err = FS_ERR_FILE_NOT_OPEN;
+        return ((FS_FILE *)0);
     }
 
-    return (mode);
+   *p_err = FS_ERR_NONE;
+    return (p_file);
 }
 
-/*
-*********************************************************************************************************
-*********************************************************************************************************
-*                                             LOCAL FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
 
 /*
 *********************************************************************************************************
-*                                            FSFile_BufEmpty()
-*
-* Description : Empty a file's buffer.
-*
-* Argument(s) : p_file      Pointer to a file.
-*               ------      Argument validated by 'FSFile_Rd()'.
-*
-*               p_err       Pointer to variable that will receive the return error code from this function :
-*               ----------  Argument validated by caller.
-*
-*                               FS_ERR_NONE             File buffer flushed successfully.
+*                                          FSFile_Acquire()
 *
-*                                                       ----------- RETURNED BY FSSys_FileWr() ----------
-*                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
-*                               FS_ERR_DEV              Device access error.
-*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
-*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+* Description : Acquire file reference.
 *
-* Return(s)   : none.
+* Argument(s) : p_file      Pointer to file.
 *
-* Note(s)     : (1) If valid read data exists in the file buffer, the underlying file position might not
-*                   correctly reflect the apparent file position to the application, since the maximum
-*                   file position reflected in the buffered data may exceed the location last read by
-*                   the application.
+* Return(s)   : Pointer to a file, if available.
+*               Pointer to NULL,   otherwise.
+*
+* Note(s)     : none.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
-static  void  FSFile_BufEmpty (FS_FILE  *p_file,
-                               FS_ERR   *p_err)
+static  FS_FILE  *FSFile_Acquire (FS_FILE  *p_file)
 {
-    FS_FILE_SIZE  pos_offset;
+    FS_ERR  err;
 
 
-    *p_err = FS_ERR_NONE;
+                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, &err);
+    if (err != FS_ERR_NONE) {
+        return ((FS_FILE *)0);
+    }
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {
-       (void)FSSys_FileWr(p_file,
-                          p_file->BufPtr,
-                          p_file->BufMaxPos,
-                          p_err);
 
-        p_file->BufStart  = 0u;
-        p_file->BufMaxPos = 0u;
-        p_file->BufStatus = FS_FILE_BUF_STATUS_EMPTY;
 
-#if (FS_CFG_DBG_MEM_CLR_EN == DEF_ENABLED)
-        Mem_Clr(p_file->BufPtr, p_file->BufSize);               /* Clr buf.                                             */
-#endif
+                                                                /* -------------------- INC REF CNT ------------------- */
+    if (p_file->RefCnt == 0u) {                                 /* Rtn NULL if file not ref'd.                          */
+        FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+        return ((FS_FILE *)0);
     }
-#endif
 
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) {
-                                                                /* Calc pos offset (see Note #1) ...                    */
-        pos_offset = (FS_FILE_SIZE)p_file->BufMaxPos;
-        if (pos_offset != 0u) {
-            FSSys_FilePosSet(p_file, p_file->Pos, p_err);       /* ... correct file pos.                                */
-        }
+    p_file->RefCnt++;
 
-        p_file->BufStart  = 0u;
-        p_file->BufMaxPos = 0u;
-        p_file->BufStatus = FS_FILE_BUF_STATUS_EMPTY;
 
-#if (FS_CFG_DBG_MEM_CLR_EN == DEF_ENABLED)
-        Mem_Clr(p_file->BufPtr, p_file->BufSize);               /* Clr buf.                                             */
-#endif
-    }
 
-    if (*p_err != FS_ERR_NONE) {
-        p_file->FlagErr = DEF_YES;
-    }
+                                                                /* ------------------ RELEASE FS LOCK ----------------- */
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+
+    return (p_file);
 }
-#endif
 
 
 /*
 *********************************************************************************************************
-*                                             FSFile_BufRd()
-*
-* Description : Read from a file (through file buffer).
-*
-* Argument(s) : p_file      Pointer to a file.
-*               ----------  Argument validated by caller.
+*                                       FSFile_ReleaseUnlock()
 *
-*               p_dest      Pointer to buffer that will hold data read by this file.
-*               ----------  Argument validated by caller.
+* Description : Release file reference & lock.
 *
-*               size        Number of octets to read.
+* Argument(s) : p_file      Pointer to file.
+*               ------      Argument validated by caller.
 *
-*               p_err       Pointer to variable that will receive the return error code from this function :
-*               ----------  Argument validated by caller.
+* Return(s)   : none.
 *
-*                               FS_ERR_NONE              File read successfully.
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSFile_ReleaseUnlock (FS_FILE  *p_file)
+{
+    FSFile_Unlock(p_file);
+    FSFile_Release(p_file);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FSFile_ReleaseVolUnlock()
 *
-*                                                        ---------- RETURNED BY FSSys_FileRd() ----------
-*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
-*                               FS_ERR_DEV               Device access error.
-*                               FS_ERR_ENTRY_CORRUPT     File system entry corrupt.
+* Description : Release file reference & volume lock acquired with 'FSFile_AcquireVolLockChk()'.
 *
-* Return(s)   : Number of octets read.
+* Argument(s) : p_file          Pointer to file.
+*               ------          Argument validated by caller.
 *
-* Note(s)     : (1) (a) Data is first copied from the buffer, up to the length of the request OR the
-*                       amount stored in the buffer (whichever is less).
+*               lock_shared     Indicates whether the volume lock is held in shared mode.
 *
-*                   (b) (1) Any large remaining read (longer than the file buffer) is satisfied by
-*                           reading directly into the destination buffer.
+* Return(s)   : none.
 *
-*                       (2) Otherwise, the buffer is then filled (if possible) and data copied into the
-*                           user buffer, up to the length of the remaining request OR the amount stored
-*                           in the buffer (whichever is less).
+* Note(s)     : none.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
-static  CPU_SIZE_T  FSFile_BufRd (FS_FILE     *p_file,
-                                  void        *p_dest,
-                                  CPU_SIZE_T   size,
-                                  FS_ERR      *p_err)
+static  void  FSFile_ReleaseVolUnlock (FS_FILE      *p_file,
+                                       CPU_BOOLEAN   lock_shared)
 {
-    CPU_SIZE_T   buf_pos;
-    CPU_SIZE_T   buf_rem;
-    CPU_SIZE_T   size_rd;
-    CPU_SIZE_T   size_rem;
-    CPU_INT08U  *p_src;
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+    if (lock_shared == DEF_YES) {
+        FSVol_UnlockShared(p_file->VolPtr);
+    } else {
+        FSVol_Unlock(p_file->VolPtr);
+    }
+#else
+    (void)lock_shared;
+    FSVol_Unlock(p_file->VolPtr);
+#endif
 
+    FSFile_Release(p_file);
+}
 
-                                                                /* Init *p_err                                          */
-   *p_err = FS_ERR_BUF_NONE_AVAIL;
 
-                                                                /* ---------- RD FROM FILE BUF INTO USER BUF ---------- */
-    size_rem = size;
+/*
+*********************************************************************************************************
+*                                           FSFile_Release()
+*
+* Description : Release file reference.
+*
+* Argument(s) : p_file      Pointer to file.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) A volume reference might have been acquired in 'FSFile_NameParseChk()'; the volume
+*                   reference would NOT have been acquired if the named volume did not exist or existed
+*                   but was not mounted.
+*********************************************************************************************************
+*/
 
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) {  /* See Note #1a.                                        */
-        buf_pos      = (CPU_SIZE_T)(p_file->Pos - p_file->BufStart);
+static  void  FSFile_Release (FS_FILE  *p_file)
+{
+    FS_ERR   err;
+    FS_CTR   ref_cnt;
+    FS_VOL  *p_vol;
 
-        buf_rem      =  p_file->BufMaxPos - buf_pos;            /* Calc octets rem in buf ...                           */
-        size_rd      =  DEF_MIN(buf_rem, size_rem);             /*                        ... calc size rd from buf.    */
-        p_src        = (CPU_INT08U *)p_file->BufPtr + buf_pos;
-        Mem_Copy(p_dest, (void *)p_src, size_rd);               /* Copy from file buf to user buf.                      */
 
-        p_file->Pos +=  size_rd;                                /* Adj file pos ...                                     */
-        size_rem    -=  size_rd;                                /*              ... adj rd rem ...                      */
-        p_dest       = (CPU_INT08U *)p_dest + size_rd;          /*                             ... adj dest buf.        */
+                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, &err);
+    if (err != FS_ERR_NONE) {
+        return;
+    }
 
-        if (buf_rem == size_rd) {                               /* All buf'd data rd ...                                */
-            p_file->BufStart  = 0u;
-            p_file->BufMaxPos = 0u;
-            p_file->BufStatus = FS_FILE_BUF_STATUS_EMPTY;       /* ... buf is now empty.                                */
 
-        } else {                                                /* More data in buf than rem'd ...                      */
-            p_file->BufStatus = FS_FILE_BUF_STATUS_NONEMPTY_RD; /* ... buf is still not empty.                          */
-        }
 
-       *p_err = FS_ERR_NONE;
+                                                                /* -------------------- DEC REF CNT ------------------- */
+    ref_cnt = p_file->RefCnt;
+    if (ref_cnt == 1u) {
+        p_vol = p_file->VolPtr;
+        FSFile_ObjFree(p_file);
+    } else if (ref_cnt > 0u) {
+        p_file->RefCnt = ref_cnt - 1u;
+    } else {
+        FS_TRACE_DBG(("FSFile_Release(): Release cnt dec'd to zero.\r\n"));
     }
 
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
 
 
 
-    if (p_file->BufStatus == FS_FILE_BUF_STATUS_EMPTY) {
-        if (size_rem >= p_file->BufSize) {                      /* ------------ RD FROM FILE INTO USER BUF ------------ */
-            size_rd = FSSys_FileRd(p_file,                      /* Rd into user buf (see Note #1b1).                    */
-                                   p_dest,
-                                   size_rem,
-                                   p_err);
-            p_file->Pos += size_rd;                             /* Adj file pos ...                                     */
-            size_rem    -= size_rd;                             /*              ... adj rd rem.                         */
-
+                                                                /* -------------------- RELEASE VOL ------------------- */
+    if (ref_cnt == 1u) {
+        if (p_vol != (FS_VOL *)0) {
+            FSVol_Release(p_vol);                               /* Release vol (see Note #1).                           */
+        }
+    }
+}
 
 
+/*
+*********************************************************************************************************
+*                                            FSFile_Lock()
+*
+* Description : Acquire file lock.
+*
+* Argument(s) : p_file      Pointer to file.
+*               ----------  Argument validated by caller.
+*
+*               lock_shared Indicates whether the volume lock may be acquired in shared mode (see Note #1) :
+*
+*                               DEF_YES, if caller only reads from file.
+*                               DEF_NO,  otherwise.
+*
+* Return(s)   : DEF_YES, if file lock     acquired.
+*               DEF_NO,  if file lock NOT acquired.
+*
+* Note(s)     : (1) If shared volume locking is enabled, the volume lock is acquired in shared mode for
+*                   read-only operations on files opened without write access.  Such operations only
+*                   modify the state of the file itself, which is protected by the file lock, so several
+*                   files on the same volume may be read concurrently.
+*
+*               (2) A pending flush of a stream buffer MUST complete before the volume lock is acquired,
+*                   since the worker task writing the buffer needs the volume lock.  The file buffer & the
+*                   system driver file position are then as if the data had been written synchronously.
+*********************************************************************************************************
+*/
 
-        } else {                                                /* ------------ RD FROM FILE INTO FILE BUF ------------ */
-            size_rd = FSSys_FileRd(p_file,                      /* Rd full file buf (see Note #1b2).                    */
-                                   p_file->BufPtr,
-                                   p_file->BufSize,
-                                   p_err);
+static  CPU_BOOLEAN  FSFile_Lock (FS_FILE      *p_file,
+                                  CPU_BOOLEAN   lock_shared)
+{
+    CPU_BOOLEAN  locked;
+#if (FS_CFG_FILE_BUF_EN   == DEF_ENABLED)
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    FS_ERR       err;
+#endif
+#endif
 
-            if (size_rd != 0u) {
-                buf_rem          = size_rd;                     /* Calc octets rem in buf ...                           */
-                size_rd          = DEF_MIN(size_rd, size_rem);  /*                        ... calc size rd from buf.    */
-                Mem_Copy(p_dest, p_file->BufPtr, size_rd);      /* Copy data to user buf.                               */
 
-                p_file->BufStart = p_file->Pos;                 /* Save file pos at buf start.                          */
-                p_file->Pos     += size_rd;                     /* Adj file pos ...                                     */
-                size_rem        -= size_rd;                     /*              ... adj rd rem.                         */
+#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
+    locked = FSFile_LockGetHandler(p_file);
 
-                if (buf_rem  == size_rd) {                      /* All buf'd data rd ...                                */
-                    p_file->BufStart   =  0u;
-                    p_file->BufMaxPos  =  0u;
-                    p_file->BufStatus  =  FS_FILE_BUF_STATUS_EMPTY;               /* ... buf is still empty.            */
+    if (locked == DEF_NO) {
+        return (DEF_NO);
+    }
+#endif
 
-                } else {                                        /* More data rd into buf than rem'd ...                 */
-                                                                /* ... buf is no longer empty.                          */
-                    p_file->BufMaxPos  =  buf_rem;
-                    p_file->BufStatus  =  FS_FILE_BUF_STATUS_NONEMPTY_RD;
-                }
-            }
+#if (FS_CFG_FILE_BUF_EN   == DEF_ENABLED)
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    FSFile_BufStreamWait(p_file, &err);                         /* Wait for stream buf flush (see Note #2).             */
+    if (p_file->BufFlushPend == DEF_YES) {
+#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
+        (void)FSFile_LockSetHandler(p_file);
+#endif
+        return (DEF_NO);
+    }
+#endif
+#endif
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+    if ((lock_shared == DEF_YES) &&                             /* Shared lock for rd-only access (see Note #1).        */
+        (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_WR) == DEF_YES)) {
+        locked = FSVol_LockShared(p_file->VolPtr);
+        if (locked == DEF_YES) {
+            p_file->VolLockShared = DEF_YES;
         }
+        return (locked);
     }
+#else
+    (void)lock_shared;
+#endif
 
+    locked = FSVol_Lock(p_file->VolPtr);
 
+    return (locked);
+}
 
-                                                                /* ------------------- ASSIGN & RTN ------------------- */
-    if (*p_err == FS_ERR_NONE) {
-         if (size_rem > 0u) {                                   /* If less data rd than rem ...                         */
-            p_file->FlagEOF = DEF_YES;                          /* ... file at EOF.                                     */
-
-         } else {                                               /* If all  data rd that rem'd ...                       */
-            p_file->FlagEOF = DEF_NO;                           /* ... file NOT at EOF.                                 */
-           *p_err = FS_ERR_NONE;
-         }
 
+/*
+*********************************************************************************************************
+*                                           FSFile_Unlock()
+*
+* Description : Release file lock.
+*
+* Argument(s) : p_file      Pointer to file.
+*               ------      Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSFile_Unlock (FS_FILE  *p_file)
+{
+                                                                /* ----------------- RELEASE VOL LOCK ----------------- */
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+    if (p_file->VolLockShared == DEF_YES) {
+        p_file->VolLockShared = DEF_NO;
+        FSVol_UnlockShared(p_file->VolPtr);
     } else {
-        p_file->FlagEOF = DEF_NO;
-        p_file->FlagErr = DEF_YES;
+        FSVol_Unlock(p_file->VolPtr);
     }
-
-    return (size - size_rem);
-}
+#else
+    FSVol_Unlock(p_file->VolPtr);
 #endif
 
+#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
+    (void)FSFile_LockSetHandler(p_file);
+#endif
+}
 
 
 /*
 *********************************************************************************************************
-*                                             FSFile_BufWr()
-*
-* Description : Write to a file (through file buffer).
+*                                     FSFile_LockAcceptHandler()
 *
-* Argument(s) : p_file      Pointer to a file.
-*               ----------  Argument validated by caller.
+* Description : Acquire file lock (if avail).
 *
-*               p_src       Pointer to buffer that contains data to write in this file.
+* Argument(s) : p_file      Pointer to file.
 *               ----------  Argument validated by caller.
 *
-*               size        Number of octets to write.
+* Return(s)   : DEF_YES, if file lock     acquired.
+*               DEF_NO,  if file lock NOT acquired.
 *
-*               p_err       Pointer to variable that will receive the return error code from this
-*                           function :
-*               ----------  Argument validated by caller.
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  FSFile_LockAcceptHandler (FS_FILE  *p_file)
+{
+    FS_ERR       err;
+    CPU_BOOLEAN  locked;
+
+
+    FS_OS_FileAccept(p_file->ID, &err);                         /* Acquire file lock.                                   */
+    locked = (err == FS_ERR_NONE) ? DEF_YES : DEF_NO;
+
+    return (locked);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FSFile_LockGetHandler()
 *
-*                               FS_ERR_NONE             File written successfully.
+* Description : Acquire file lock.
 *
-*                                                       ----------- RETURNED BY FSSys_FileWr() ----------
-*                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
-*                               FS_ERR_DEV              Device access error.
-*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
-*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+* Argument(s) : p_file      Pointer to file.
+*               ----------  Argument validated by caller.
 *
-* Return(s)   : none.
+* Return(s)   : DEF_YES, if file lock     acquired.
+*               DEF_NO,  if file lock NOT acquired.
 *
 * Note(s)     : none.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
-#if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
-static  CPU_SIZE_T  FSFile_BufWr (FS_FILE     *p_file,
-                                  void        *p_src,
-                                  CPU_SIZE_T   size,
-                                  FS_ERR      *p_err)
+#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  FSFile_LockGetHandler (FS_FILE  *p_file)
 {
-    CPU_INT08U    *p_buf;
-    CPU_SIZE_T     buf_rem;
-    CPU_SIZE_T     size_wr;
-    CPU_SIZE_T     size_rem;
+    FS_ERR       err;
+    CPU_BOOLEAN  locked;
 
 
-                                                                /* ----------------- WR TO END OF BUF ----------------- */
-    size_rem = size;
-    buf_rem  = p_file->BufSize - p_file->BufMaxPos;             /* Calc octets empty in buf ...                         */
-    size_wr  = DEF_MIN(buf_rem, size_rem);                      /*                          ... calc size wr to buf.    */
-    if (size_wr > 0u) {
-        if (p_file->BufStatus == FS_FILE_BUF_STATUS_EMPTY) {
-            p_file->BufStart = p_file->Pos;                 /* Save file pos at buf start.                          */
-        }
+    FS_OS_FileLock(p_file->ID, &err);                           /* Acquire file lock.                                   */
+    locked = (err == FS_ERR_NONE) ? DEF_YES : DEF_NO;
 
-        p_buf    = (CPU_INT08U *)p_file->BufPtr + p_file->BufMaxPos;
-        Mem_Copy((void *)p_buf, p_src, size_wr);                /* Copy from user buf to file buf.                      */
+    return (locked);
+}
+#endif
 
 
-        p_file->Pos       +=  size_wr;                          /* Adj file pos ...                                     */
-        size_rem          -=  size_wr;                          /*              ... adj wr rem ...                      */
-        p_src              = (CPU_INT08U *)p_src + size_wr;     /*                             ... adj src buf.         */
+/*
+*********************************************************************************************************
+*                                       FSFile_LockSetHandler()
+*
+* Description : Release file lock.
+*
+* Argument(s) : p_file      Pointer to file.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : DEF_YES, if file lock     released.
+*               DEF_NO,  if file lock NOT released.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
 
-        p_file->BufMaxPos +=  size_wr;                          /* Save max pos wr in buf.                              */
-        p_file->BufStatus  =  FS_FILE_BUF_STATUS_NONEMPTY_WR;
-       *p_err = FS_ERR_NONE;
-    }
+#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  FSFile_LockSetHandler (FS_FILE  *p_file)
+{
+    CPU_BOOLEAN  unlocked;
 
 
+    unlocked = FS_OS_FileUnlock(p_file->ID);
 
-    if (p_file->BufMaxPos == p_file->BufSize) {                 /* ------------------- DUMP TO FILE ------------------- */
-        FSSys_FileWr(p_file,                                    /* Wr buf to file ...                                   */
-                     p_file->BufPtr,
-                     p_file->BufSize,
-                     p_err);
-        if (*p_err != FS_ERR_NONE) {
-            p_file->FlagErr = DEF_YES;
-            return (size - size_rem);
-        }
+    return (unlocked);
+}
+#endif
 
-        p_file->BufStart  = 0u;                                 /* ... buf now empty.                                   */
-        p_file->BufMaxPos = 0u;
-        p_file->BufStatus = FS_FILE_BUF_STATUS_EMPTY;
-       *p_err = FS_ERR_NONE;
 
+/*
+*********************************************************************************************************
+*                                           FSFile_ObjClr()
+*
+* Description : Clear a file object.
+*
+* Argument(s) : p_file      Pointer to file.
+*               ------      Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_FILE'.
+*********************************************************************************************************
+*/
 
+static  void  FSFile_ObjClr (FS_FILE  *p_file)
+{
+    p_file->ID           =  0u;
+    p_file->State        =  FS_FILE_STATE_CLOSED;
+    p_file->RefCnt       =  0u;
+    p_file->RefreshCnt   =  0u;
 
-        if (size_rem >= p_file->BufSize) {                      /* ------------------ HANDLE LARGE WR ----------------- */
-            size_wr = FSSys_FileWr(p_file,                      /* Wr data to file.                                     */
-                                   p_src,
-                                   size_rem,
-                                   p_err);
-            p_file->Pos    +=  size_wr;                         /* Adj file pos ...                                     */
-            size_rem       -=  size_wr;                         /*              ... adj wr rem.                         */
+    p_file->AccessMode   =  FS_FILE_ACCESS_MODE_NONE;
+    p_file->FlagErr      =  DEF_NO;
+    p_file->FlagEOF      =  DEF_NO;
+    p_file->IO_State     =  FS_FILE_IO_STATE_NONE;
+    p_file->Size         =  0u;
+    p_file->Pos          =  0u;
 
-            p_file->FlagErr = (*p_err != FS_ERR_NONE) ? DEF_YES : DEF_NO;
+#if (FS_CFG_FILE_BUF_EN  == DEF_ENABLED)
+    p_file->BufStart     =  0u;
+    p_file->BufMaxPos    =  0u;
+    p_file->BufSize      =  0u;
+    p_file->BufMode      =  FS_FILE_BUF_MODE_NONE;
+    p_file->BufStatus    =  FS_FILE_BUF_STATUS_NONE;
+    p_file->BufPtr       = (void *)0;
+    p_file->BufSecSize   =  0u;
+#endif
 
-            if (*p_err != FS_ERR_NONE) {
-                p_file->FlagErr = DEF_YES;
-            }
+    p_file->VolPtr       = (FS_VOL  *)0;
+    p_file->DataPtr      = (void    *)0;
+    p_file->HashNextPtr  = (FS_FILE *)0;
 
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+    p_file->VolLockShared =  DEF_NO;
+#endif
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    p_file->AsyncReqHeadPtr = (FS_FILE_ASYNC_REQ *)0;
+    p_file->AsyncReqTailPtr = (FS_FILE_ASYNC_REQ *)0;
+    p_file->AsyncNextPtr    = (FS_FILE *)0;
+    p_file->AsyncSched      =  DEF_NO;
 
-        } else {
-            if (size_rem > 0u) {                                /* -------------- WR REM TO START OF BUF -------------- */
-                size_wr            = size_rem;
-                Mem_Copy(p_file->BufPtr, p_src, size_rem);      /* Copy from user buf to file buf.                      */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    p_file->BufAltPtr       = (void *)0;
+    p_file->BufAlignSize    =  0u;
+    p_file->BufFlushReqPtr  = (FS_FILE_ASYNC_REQ *)0;
+    p_file->BufFlushPend    =  DEF_NO;
+#endif
+#endif
 
-                p_file->BufStart   = p_file->Pos;               /* Save file pos at buf start.                          */
+#if (FS_CFG_CTR_STAT_EN  == DEF_ENABLED)
+    p_file->StatRdCtr    =  0u;
+    p_file->StatWrCtr    =  0u;
+#endif
+}
 
-                p_file->Pos       += size_wr;                   /* Adj file pos ...                                     */
-                size_rem          -= size_wr;                   /*              ... adj wr rem.                         */
 
-                p_file->BufMaxPos  = size_wr;                   /* Save max wr pos in buf.                              */
-                p_file->BufStatus  = FS_FILE_BUF_STATUS_NONEMPTY_WR;
-               *p_err = FS_ERR_NONE;
-            }
-        }
-    }
+/*
+*********************************************************************************************************
+*                                          FSFile_ObjFree()
+*
+* Description : Free a file object.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_FILE'.
+*********************************************************************************************************
+*/
 
+static  void  FSFile_ObjFree (FS_FILE  *p_file)
+{
+    LIB_ERR  pool_err;
 
 
-                                                                /* ------------------- ASSIGN & RTN ------------------- */
-    if (p_file->Size < p_file->Pos) {                           /* Chng file size.                                      */
-        p_file->Size = p_file->Pos;
+#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+        FS_TRACE_INFO(("FSFile_ObjFree(): File pointer is invalid.\r\n"));
+        return;
     }
-    return (size - size_rem);
-}
 #endif
+
+    FSFile_Tbl[p_file->ID] = DEF_NULL;
+
+#if (FS_CFG_DBG_MEM_CLR_EN == DEF_ENABLED)
+    FSFile_ObjClr(p_file);
+#endif
+
+    Mem_PoolBlkFree(        &FSFile_Pool,
+                    (void *) p_file,
+                            &pool_err);
+
+#if (FS_TRACE_LEVEL >= TRACE_LEVEL_INFO)
+    if (pool_err != LIB_MEM_ERR_NONE) {
+        FS_TRACE_INFO(("FSFile_ObjFree(): Could not free file to pool.\r\n"));
+        return;
+    }
 #endif
 
+    FSFile_Cnt--;
+}
+
 
 /*
 *********************************************************************************************************
-*                                       FSFile_AcquireLockChk()
-*
-* Description : Acquire file reference & lock.
-*
-* Argument(s) : p_file      Pointer to file.
-*               ----------  Argument validated by caller.
+*                                           FSFile_ObjGet()
 *
+* Description : Allocate a file object.
 *
-*               p_err       Pointer to variable that will receive the return error code from this function :
-*               ----------  Argument validated by caller.
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
 *
-*                               FS_ERR_NONE             File reference & lock acquired.
-*                               FS_ERR_DEV_CHNGD        Device has changed.
-*                               FS_ERR_FILE_NOT_OPEN    File NOT open.
+*                               FS_ERR_NONE                     File object successfully returned.
+*                               FS_ERR_NULL_PTR                 FSFile_Pool is a NULL pointer.
+*                               FS_ERR_POOL_EMPTY               NO blocks available in pool.
+*                               FS_ERR_POOL_INVALID_BLK_IX      Invalid pool block index.
+*                               FS_ERR_POOL_INVALID_BLK_ADDR    Block not found in used pool pointers.
 *
-* Return(s)   : Pointer to a file, if found.
+* Return(s)   : Pointer to a file, if NO errors.
 *               Pointer to NULL,   otherwise.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_FILE'.
 *********************************************************************************************************
 */
 
-static  FS_FILE  *FSFile_AcquireLockChk (FS_FILE      *p_file,
-                                         FS_ERR       *p_err)
+static  FS_FILE  *FSFile_ObjGet (FS_ERR *p_err)
 {
-    CPU_BOOLEAN  lock_success;
+    FS_FILE  *p_file;
+    LIB_ERR   pool_err;
+    FS_QTY    file_ix;
 
 
-                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
-    p_file = FSFile_Acquire(p_file);                            /* Acquire file ref.                                    */
 
-    if (p_file == (FS_FILE *)0) {                               /* Rtn err if file not found.                           */
-       *p_err = FS_ERR_FILE_NOT_OPEN;
+    for (file_ix = 0u; file_ix < FSFile_FileCntMax; file_ix++) {
+        if (FSFile_Tbl[file_ix] == DEF_NULL) {
+            break;
+        }
+    }
+    if (file_ix >= FSFile_FileCntMax) {
+        FS_TRACE_INFO(("FSFile_ObjGet(): Could not alloc file from pool. Opened file limit reached.\r\n"));
+       *p_err = FS_ERR_MEM_ALLOC;
         return ((FS_FILE *)0);
     }
 
-    lock_success = FSFile_Lock(p_file);
-    if (lock_success != DEF_YES) {
-       *p_err = FS_ERR_OS_LOCK;
+    p_file = (FS_FILE *)Mem_PoolBlkGet(&FSFile_Pool,
+                                        sizeof(FS_FILE),
+                                       &pool_err);
+    if (pool_err != LIB_MEM_ERR_NONE) {
+        FS_TRACE_INFO(("FSFile_ObjGet(): Could not alloc file from pool. Opened file limit reached.\r\n"));
+       *p_err = FS_ERR_MEM_ALLOC;
         return ((FS_FILE *)0);
     }
 
+    FSFile_Tbl[file_ix] = p_file;
 
-                                                                /* ------------------- VALIDATE FILE ------------------ */
-    switch (p_file->State) {
-        case FS_FILE_STATE_OPEN:
-            *p_err = FS_ERR_NONE;
-             return (p_file);
+    FSFile_Cnt++;
 
+    FSFile_ObjClr(p_file);
 
-        case FS_FILE_STATE_CLOSED:                              /* Rtn NULL if file not open.                           */
-        case FS_FILE_STATE_CLOSING:
-        case FS_FILE_STATE_OPENING:
-        default:
-            *p_err = FS_ERR_FILE_NOT_OPEN;
-             FSFile_ReleaseUnlock(p_file);
-             return ((FS_FILE *)0);
-    }
+    p_file->ID = file_ix;
+
+    return (p_file);
 }
 
 
 /*
 *********************************************************************************************************
-*                                          FSFile_Acquire()
+*                                         FSFile_HashIxGet()
 *
-* Description : Acquire file reference.
+* Description : Get open file hash table index of a directory entry location.
 *
-* Argument(s) : p_file      Pointer to file.
+* Argument(s) : p_vol           Pointer to volume.
+*               -----           Argument validated by caller.
 *
-* Return(s)   : Pointer to a file, if available.
-*               Pointer to NULL,   otherwise.
+*               dir_sec         Sector  containing the file's last directory entry.
 *
-* Note(s)     : none.
+*               dir_sec_pos     Position of the file's last directory entry in sector.
+*
+* Return(s)   : Hash table index.
+*
+* Note(s)     : (1) Open files are indexed by their volume & by the location of their last (short file
+*                   name) directory entry, which uniquely identifies an entry on a volume.
+*
+*               (2) The hash table size is a power of 2, so the index is masked from the hash.
 *********************************************************************************************************
 */
 
-static  FS_FILE  *FSFile_Acquire (FS_FILE  *p_file)
+static  FS_QTY  FSFile_HashIxGet (FS_VOL       *p_vol,
+                                  FS_SEC_NBR    dir_sec,
+                                  FS_SEC_SIZE   dir_sec_pos)
 {
-    FS_ERR  err;
-
-
-                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
-    if (err != FS_ERR_NONE) {
-        return ((FS_FILE *)0);
-    }
-
-
-
-                                                                /* -------------------- INC REF CNT ------------------- */
-    if (p_file->RefCnt == 0u) {                                 /* Rtn NULL if file not ref'd.                          */
-        FS_OS_Unlock();
-        return ((FS_FILE *)0);
-    }
-
-    p_file->RefCnt++;
-
+    CPU_INT32U  hash;
+    FS_QTY      hash_ix;
 
 
-                                                                /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+                                                                /* Hash dir entry loc (see Note #1).                    */
+    hash    = (CPU_INT32U)((CPU_ADDR)p_vol / sizeof(CPU_ALIGN));
+    hash    = (hash * 31u) + (CPU_INT32U)dir_sec;
+    hash    = (hash * 31u) + (CPU_INT32U)(dir_sec_pos / FS_FAT_SIZE_DIR_ENTRY);
+    hash   ^=  hash >> 16u;
+    hash_ix = (FS_QTY)(hash & (FSFile_HashTblSize - 1u));       /* See Note #2.                                         */
 
-    return (p_file);
+    return (hash_ix);
 }
 
 
 /*
 *********************************************************************************************************
-*                                       FSFile_ReleaseUnlock()
+*                                          FSFile_HashAdd()
 *
-* Description : Release file reference & lock.
+* Description : Add file to open file hash table.
 *
 * Argument(s) : p_file      Pointer to file.
 *               ------      Argument validated by caller.
 *
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE             File added.
+*
+*                                                       ------------ RETURNED BY FS_OS_Lock() -----------
+*                               FS_ERR_OS_LOCK          OS lock NOT acquired.
+*
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The file MUST have been opened by the file system driver, so that its directory entry
+*                   location is known.
 *********************************************************************************************************
 */
 
-static  void  FSFile_ReleaseUnlock (FS_FILE  *p_file)
+static  void  FSFile_HashAdd (FS_FILE  *p_file,
+                             FS_ERR   *p_err)
 {
-    FSFile_Unlock(p_file);
-    FSFile_Release(p_file);
+    FS_FAT_FILE_DATA  *p_fat_file_data;
+    FS_QTY             hash_ix;
+
+
+    p_fat_file_data = (FS_FAT_FILE_DATA *)p_file->DataPtr;
+    hash_ix         =  FSFile_HashIxGet(p_file->VolPtr,
+                                        p_fat_file_data->DirEndSec,
+                                        p_fat_file_data->DirEndSecPos);
+
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, p_err);                      /* Acquire FS lock.                                     */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    p_file->HashNextPtr     = FSFile_HashTbl[hash_ix];          /* Insert file at head of bucket.                       */
+    FSFile_HashTbl[hash_ix] = p_file;
+
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);                           /* Release FS lock.                                     */
 }
 
 
 /*
 *********************************************************************************************************
-*                                           FSFile_Release()
+*                                         FSFile_HashRemove()
 *
-* Description : Release file reference.
+* Description : Remove file from open file hash table.
 *
 * Argument(s) : p_file      Pointer to file.
-*               ----------  Argument validated by caller.
+*               ------      Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE             File removed.
+*
+*                                                       ------------ RETURNED BY FS_OS_Lock() -----------
+*                               FS_ERR_OS_LOCK          OS lock NOT acquired.
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) A volume reference might have been acquired in 'FSFile_NameParseChk()'; the volume
-*                   reference would NOT have been acquired if the named volume did not exist or existed
-*                   but was not mounted.
+* Note(s)     : (1) The file MUST be removed before it is closed by the file system driver, since its
+*                   directory entry location is needed to find its bucket.
 *********************************************************************************************************
 */
 
-static  void  FSFile_Release (FS_FILE  *p_file)
+static  void  FSFile_HashRemove (FS_FILE  *p_file,
+                                FS_ERR   *p_err)
 {
-    FS_ERR   err;
-    FS_CTR   ref_cnt;
-    FS_VOL  *p_vol;
+    FS_FAT_FILE_DATA   *p_fat_file_data;
+    FS_FILE           **pp_file;
+    FS_QTY              hash_ix;
 
 
-                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
-    if (err != FS_ERR_NONE) {
+    p_fat_file_data = (FS_FAT_FILE_DATA *)p_file->DataPtr;
+    hash_ix         =  FSFile_HashIxGet(p_file->VolPtr,
+                                        p_fat_file_data->DirEndSec,
+                                        p_fat_file_data->DirEndSecPos);
+
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, p_err);                      /* Acquire FS lock.                                     */
+    if (*p_err != FS_ERR_NONE) {
         return;
     }
 
-
-
-                                                                /* -------------------- DEC REF CNT ------------------- */
-    ref_cnt = p_file->RefCnt;
-    if (ref_cnt == 1u) {
-        p_vol = p_file->VolPtr;
-        FSFile_ObjFree(p_file);
-    } else if (ref_cnt > 0u) {
-        p_file->RefCnt = ref_cnt - 1u;
-    } else {
-        FS_TRACE_DBG(("FSFile_Release(): Release cnt dec'd to zero.\r\n"));
+    pp_file = &FSFile_HashTbl[hash_ix];                         /* Unlink file from bucket.                             */
+    while ((*pp_file != (FS_FILE *)0) &&
+           (*pp_file != p_file)) {
+        pp_file = &(*pp_file)->HashNextPtr;
     }
-
-    FS_OS_Unlock();
-
-
-
-                                                                /* -------------------- RELEASE VOL ------------------- */
-    if (ref_cnt == 1u) {
-        if (p_vol != (FS_VOL *)0) {
-            FSVol_Release(p_vol);                               /* Release vol (see Note #1).                           */
-        }
+    if (*pp_file == p_file) {
+       *pp_file = p_file->HashNextPtr;
     }
+    p_file->HashNextPtr = (FS_FILE *)0;
+
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);                           /* Release FS lock.                                     */
 }
 
 
 /*
 *********************************************************************************************************
-*                                            FSFile_Lock()
+*                                        FSFile_OpenHandler()
 *
-* Description : Acquire file lock.
+* Description : Open a file.
 *
-* Argument(s) : p_file      Pointer to file.
-*               ----------  Argument validated by caller.
+* Argument(s) : name_full       Name of the file.
 *
-* Return(s)   : none.
+*               p_vol_handle    Pointer to handle of the volume on which the file is opened, or NULL if
+*                               the volume is given by 'name_full' (see 'FSFile_OpenByHandle()  Note #2').
 *
-* Note(s)     : none.
+*               mode            File access mode (see 'FSFile_Open()').
+*
+*               p_err           Pointer to variable that will receive the return error code from this function
+*                               (see 'FSFile_Open()').
+*
+* Return(s)   : Pointer to a file, if NO errors.
+*               Pointer to NULL,   otherwise.
+*
+* Note(s)     : (1) Notes referenced in this function are the notes of 'FSFile_Open()'.
+*
+*               (2) The check for an open file is performed on the volume acquired to open the file, so
+*                   that the volume is only looked up once.
 *********************************************************************************************************
 */
 
-static  CPU_BOOLEAN  FSFile_Lock (FS_FILE  *p_file)
+static  FS_FILE  *FSFile_OpenHandler (CPU_CHAR       *name_full,
+                                      FS_VOL_HANDLE  *p_vol_handle,
+                                      FS_FLAGS        mode,
+                                      FS_ERR         *p_err)
 {
-    CPU_BOOLEAN  locked;
+    CPU_CHAR       *name_file;
+    CPU_CHAR       *name_full_temp;
+    FS_FILE        *p_file;
+    FS_VOL         *p_vol;
+    FS_ERR          err;
+    FS_ENTRY_INFO   file_info;
+#if (FS_CFG_CONCURRENT_ENTRIES_ACCESS_EN == DEF_DISABLED)
+    CPU_BOOLEAN     file_open;
+    CPU_BOOLEAN     is_write_mode;
+    FS_FLAGS        open_mode;
+#endif
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION((FS_FILE *)0);
+    }
+
+#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)                          /* Rd-only mode                                         */
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+        return ((FS_FILE *) 0);
+    }
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_CREATE) == DEF_YES) {
+       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+        return ((FS_FILE *) 0);
+    }
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_EXCL) == DEF_YES) {
+       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+        return ((FS_FILE *) 0);
+    }
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
+       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+        return ((FS_FILE *) 0);
+    }
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_TRUNCATE) == DEF_YES) {
+       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+        return ((FS_FILE *) 0);
+    }
+#endif
 
+    if (name_full == (CPU_CHAR *)0) {                           /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return ((FS_FILE *)0);
+    }
+                                                                /* Validate mode (see Note #2b).                        */
+    if (DEF_BIT_IS_CLR(mode, FS_FILE_ACCESS_MODE_RD | FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+        return ((FS_FILE *)0);
+    }
+                                                                /* See Note #2a1.                                       */
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_TRUNCATE) == DEF_YES) {
+        if (DEF_BIT_IS_CLR(mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+           *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+            return ((FS_FILE *)0);
+        }
+    }
+                                                                /* See Note #2a2.                                       */
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_EXCL) == DEF_YES) {
+        if (DEF_BIT_IS_CLR(mode, FS_FILE_ACCESS_MODE_CREATE) == DEF_YES) {
+           *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+            return ((FS_FILE *)0);
+        }
+    }
+                                                                /* See Note #2a3.                                       */
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
+        if (DEF_BIT_IS_CLR(mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+           *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+            return ((FS_FILE *)0);
+        }
+    }
+                                                                /* See Note #2a4.                                       */
+    if ((mode & (FS_FILE_ACCESS_MODE_RD       | FS_FILE_ACCESS_MODE_WR     | FS_FILE_ACCESS_MODE_APPEND |
+                 FS_FILE_ACCESS_MODE_TRUNCATE | FS_FILE_ACCESS_MODE_CREATE | FS_FILE_ACCESS_MODE_EXCL   |
+                 FS_FILE_ACCESS_MODE_CACHED                                                             )) != mode) {
+       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+        return ((FS_FILE *)0);
+    }
+#endif
 
-#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
-    locked = FSFile_LockGetHandler(p_file);
+#if (FS_CFG_RD_ONLY_EN == DEF_ENABLED)
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_APPEND) == DEF_YES) {
+       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+        return ((FS_FILE *)0);
+    }
 
-    if (locked == DEF_NO) {
-        return (DEF_NO);
+    if (DEF_BIT_IS_SET(mode, FS_FILE_ACCESS_MODE_WR) == DEF_YES) {
+       *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
+        return ((FS_FILE *)0);
     }
 #endif
-                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
-    locked = FSVol_Lock(p_file->VolPtr);
 
-    return (locked);
-}
+                                                                /* ------------------- GET FREE FILE ------------------ */
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, p_err);                      /* Acquire FS lock.                                     */
+    if (*p_err != FS_ERR_NONE) {
+        return ((FS_FILE *)0);
+    }
 
+    p_file = FSFile_ObjGet(p_err);                              /* Alloc file.                                          */
+    if (*p_err != FS_ERR_NONE) {
+       *p_err = FS_ERR_FILE_NONE_AVAIL;
+        FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
+        return ((FS_FILE *)0);
+    }
 
-/*
-*********************************************************************************************************
-*                                           FSFile_Unlock()
-*
-* Description : Release file lock.
-*
-* Argument(s) : p_file      Pointer to file.
-*               ------      Argument validated by caller.
-*
-* Return(s)   : none.
-*
-* Note(s)     : none.
-*********************************************************************************************************
-*/
+    p_file->AccessMode =  mode;
+    p_file->RefCnt     =  1u;
+    p_file->State      =  FS_FILE_STATE_OPENING;
+    p_file->VolPtr     = (FS_VOL *)0;
 
-static  void  FSFile_Unlock (FS_FILE  *p_file)
-{
-                                                                /* ----------------- RELEASE VOL LOCK ----------------- */
-    FSVol_Unlock(p_file->VolPtr);
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);                           /* Release FS lock.                                     */
 
 #if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
-    (void)FSFile_LockSetHandler(p_file);
+    (void)FSFile_LockGetHandler(p_file);
 #endif
-}
 
 
-/*
-*********************************************************************************************************
-*                                     FSFile_LockAcceptHandler()
-*
-* Description : Acquire file lock (if avail).
-*
-* Argument(s) : p_file      Pointer to file.
-*               ----------  Argument validated by caller.
-*
-* Return(s)   : DEF_YES, if file lock     acquired.
-*               DEF_NO,  if file lock NOT acquired.
-*
-* Note(s)     : none.
-*********************************************************************************************************
-*/
 
+                                                                /* ------------------ FORM FULL PATH ------------------ */
+    name_full_temp = name_full;
+#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
+    if (p_vol_handle == (FS_VOL_HANDLE *)0) {                   /* See 'FSFile_OpenByHandle()  Note #2'.               */
+        name_full_temp = FS_WorkingDirPathForm(name_full, p_err);
+        if (*p_err != FS_ERR_NONE) {
 #if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
-static  CPU_BOOLEAN  FSFile_LockAcceptHandler (FS_FILE  *p_file)
-{
-    FS_ERR       err;
-    CPU_BOOLEAN  locked;
+            (void)FSFile_LockSetHandler(p_file);
+#endif
+            FSFile_Release(p_file);
+            return ((FS_FILE *)0);
+        }
+    }
+#endif
 
 
-    FS_OS_FileAccept(p_file->ID, &err);                         /* Acquire file lock.                                   */
-    locked = (err == FS_ERR_NONE) ? DEF_YES : DEF_NO;
+                                                                /* ------------------ ACQUIRE VOL REF ----------------- */
+    if (p_vol_handle == (FS_VOL_HANDLE *)0) {
+        name_file = FSFile_NameParseChk( name_full_temp,
+                                        &p_vol,
+                                         p_err);
+    } else {
+        name_file = FSFile_NameHandleChk( name_full_temp,
+                                         *p_vol_handle,
+                                         &p_vol,
+                                          p_err);
+    }
 
-    return (locked);
-}
+    if ((p_vol     == (FS_VOL   *)0) ||                         /* If no vol found                           ...        */
+        (name_file == (CPU_CHAR *)0)) {                         /* ... or file name not parsed (see Note #4) ...        */
+#if (FS_CFG_FILE_LOCK_EN ==   DEF_ENABLED)
+        (void)FSFile_LockSetHandler(p_file);
+#endif
+        FSFile_Release(p_file);                                 /* ... release file ref.                                */
+#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
+        if (name_full_temp != name_full) {
+            FS_WorkingDirObjFree(name_full_temp);
+        }
 #endif
+        return ((FS_FILE *)0);
+    }
 
 
-/*
-*********************************************************************************************************
-*                                       FSFile_LockGetHandler()
-*
-* Description : Acquire file lock.
-*
-* Argument(s) : p_file      Pointer to file.
-*               ----------  Argument validated by caller.
-*
-* Return(s)   : DEF_YES, if file lock     acquired.
-*               DEF_NO,  if file lock NOT acquired.
-*
-* Note(s)     : none.
-*********************************************************************************************************
-*/
 
-#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
-static  CPU_BOOLEAN  FSFile_LockGetHandler (FS_FILE  *p_file)
-{
-    FS_ERR       err;
-    CPU_BOOLEAN  locked;
+                                                                /* --------------------- OPEN FILE -------------------- */
+    p_file->VolPtr = p_vol;
 
+    if (name_file[0] == (CPU_CHAR)ASCII_CHAR_NULL) {            /* Rtn err if entry specifies root dir.                 */
+        p_file->State = FS_FILE_STATE_CLOSING;
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_ENTRY_ROOT_DIR;
+        return ((FS_FILE *)0);
+    }
 
-    FS_OS_FileLock(p_file->ID, &err);                           /* Acquire file lock.                                   */
-    locked = (err == FS_ERR_NONE) ? DEF_YES : DEF_NO;
+                                                                /* Chk vol mode.                                        */
+    if ((DEF_BIT_IS_CLR(p_vol->AccessMode, FS_VOL_ACCESS_MODE_WR)  == DEF_YES) &&
+        (DEF_BIT_IS_SET(mode,              FS_FILE_ACCESS_MODE_WR) == DEF_YES)) {
+        p_file->State = FS_FILE_STATE_CLOSING;
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_VOL_INVALID_OP;
+        return ((FS_FILE *)0);
+    }
 
-    return (locked);
-}
+                                                                /* ---------- VERIFY IF FILE OPEN IN WR MODE ---------- */
+#if (FS_CFG_CONCURRENT_ENTRIES_ACCESS_EN == DEF_DISABLED)
+    file_open = FSFile_IsOpenLocked(p_vol,
+                                    name_file,
+                                   &open_mode,
+                                    p_err);
+    if (*p_err != FS_ERR_NONE) {
+        p_file->State = FS_FILE_STATE_CLOSING;
+        FSFile_ReleaseUnlock(p_file);
+#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
+        if (name_full_temp != name_full) {
+            FS_WorkingDirObjFree(name_full_temp);
+        }
 #endif
+        return ((FS_FILE *)0);
+    }
 
+    if (file_open == DEF_YES) {
+                                                                /* If file is already open ...                          */
+                                                                /*                         ... or going to be open ...  */
+                                                                /*                         ... in write mode ...        */
+        is_write_mode = ((open_mode & FS_FILE_ALL_WR_ACCESS_MODE) != 0u);
+        is_write_mode = ((mode      & FS_FILE_ALL_WR_ACCESS_MODE) != 0u) || is_write_mode;
 
-/*
-*********************************************************************************************************
-*                                       FSFile_LockSetHandler()
-*
-* Description : Release file lock.
-*
-* Argument(s) : p_file      Pointer to file.
-*               ----------  Argument validated by caller.
-*
-* Return(s)   : DEF_YES, if file lock     released.
-*               DEF_NO,  if file lock NOT released.
-*
-* Note(s)     : none.
-*********************************************************************************************************
-*/
-
-#if (FS_CFG_FILE_LOCK_EN == DEF_ENABLED)
-static  CPU_BOOLEAN  FSFile_LockSetHandler (FS_FILE  *p_file)
-{
-    CPU_BOOLEAN  unlocked;
-
-
-    unlocked = FS_OS_FileUnlock(p_file->ID);
-
-    return (unlocked);
-}
+        if (is_write_mode == DEF_YES) {
+            p_file->State = FS_FILE_STATE_CLOSING;
+            FSFile_ReleaseUnlock(p_file);                       /* ... release file ref.                                */
+#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
+            if (name_full_temp != name_full) {
+                FS_WorkingDirObjFree(name_full_temp);
+            }
+#endif
+           *p_err = FS_ERR_FILE_ALREADY_OPEN;
+            return ((FS_FILE *)0);
+        }
+    }
 #endif
 
+    FSSys_FileOpen(p_file,                                      /* Open file.                                           */
+                   name_file,
+                   p_err);
+#if (FS_CFG_WORKING_DIR_EN == DEF_ENABLED)
+    if (name_full_temp != name_full) {
+        FS_WorkingDirObjFree(name_full_temp);
+    }
+#endif
+    if (*p_err != FS_ERR_NONE) {
+         p_file->State = FS_FILE_STATE_CLOSING;
+         FSFile_ReleaseUnlock(p_file);
+         return ((FS_FILE *)0);
+    }
 
-/*
-*********************************************************************************************************
-*                                           FSFile_ObjClr()
-*
-* Description : Clear a file object.
-*
-* Argument(s) : p_file      Pointer to file.
-*               ------      Argument validated by caller.
-*
-* Return(s)   : none.
-*
-* Note(s)     : (1) The function caller MUST hold the file system lock.
-*********************************************************************************************************
-*/
+    p_file->State      = FS_FILE_STATE_OPEN;
+    p_file->RefreshCnt = p_vol->RefreshCnt;
+    FSVol_FileAdd(p_vol, p_file);                               /* Link file to vol file list.                          */
 
-static  void  FSFile_ObjClr (FS_FILE  *p_file)
-{
-    p_file->ID           =  0u;
-    p_file->State        =  FS_FILE_STATE_CLOSED;
-    p_file->RefCnt       =  0u;
-    p_file->RefreshCnt   =  0u;
+    FSSys_FileQuery(p_file, &file_info, p_err);
+    if (*p_err != FS_ERR_NONE) {
+         FSSys_FileClose(p_file, &err);
+         p_file->State = FS_FILE_STATE_CLOSING;
+         FSFile_ReleaseUnlock(p_file);
+         return ((FS_FILE *)0);
+    }
 
-    p_file->AccessMode   =  FS_FILE_ACCESS_MODE_NONE;
-    p_file->FlagErr      =  DEF_NO;
-    p_file->FlagEOF      =  DEF_NO;
-    p_file->IO_State     =  FS_FILE_IO_STATE_NONE;
-    p_file->Size         =  0u;
-    p_file->Pos          =  0u;
+    FSFile_HashAdd(p_file, p_err);                              /* Link file to open file hash tbl.                     */
+    if (*p_err != FS_ERR_NONE) {                                /* Fail open if file not linked in hash tbl.            */
+         FSSys_FileClose(p_file, &err);
+         FSVol_FileRemove(p_vol, p_file);
+         p_file->State = FS_FILE_STATE_CLOSING;
+         FSFile_ReleaseUnlock(p_file);
+         return ((FS_FILE *)0);
+    }
 
-#if (FS_CFG_FILE_BUF_EN  == DEF_ENABLED)
-    p_file->BufStart     =  0u;
-    p_file->BufMaxPos    =  0u;
-    p_file->BufSize      =  0u;
-    p_file->BufMode      =  FS_FILE_BUF_MODE_NONE;
-    p_file->BufStatus    =  FS_FILE_BUF_STATUS_NONE;
-    p_file->BufPtr       = (void *)0;
-    p_file->BufSecSize   =  0u;
-#endif
+    p_file->Size = file_info.Size;
+    p_file->FlagEOF = DEF_NO;
+    p_file->Pos = 0u;                                           /* Set init file pos indicator to 0 (see Note #3).      */
 
-    p_file->VolPtr       = (FS_VOL *)0;
-    p_file->DataPtr      = (void   *)0;
 
-#if (FS_CFG_CTR_STAT_EN  == DEF_ENABLED)
-    p_file->StatRdCtr    =  0u;
-    p_file->StatWrCtr    =  0u;
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    p_file->BufSecSize = p_vol->SecSize;
 #endif
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_Unlock(p_file);                                      /* Keep init ref.                                       */
+
+    return (p_file);
 }
 
 
 /*
 *********************************************************************************************************
-*                                          FSFile_ObjFree()
+*                                        FSFile_IsOpenLocked()
 *
-* Description : Free a file object.
+* Description : Test if file is open, on a locked volume.
 *
-* Argument(s) : p_file      Pointer to a file.
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
 *
-* Return(s)   : none.
+*               name_file   Name of the file, relative to the root directory of the volume.
+*               ----------  Argument validated by caller.
+*
+*               p_mode      Pointer to variable that will receive the file access mode (see 'FSFile_IsOpen()').
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code (see 'FSFile_IsOpen()').
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : DEF_NO,  if file is NOT open.
+*
+*               DEF_YES, if file is     open.
+*
+* Note(s)     : (1) Only the open files whose directory entry location hashes to the same bucket as the
+*                   file's are compared (see 'FSFile_HashIxGet()').
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+*               (2) The function caller MUST hold a reference to the volume & the volume lock.
 *********************************************************************************************************
 */
 
-static  void  FSFile_ObjFree (FS_FILE  *p_file)
+static  CPU_BOOLEAN  FSFile_IsOpenLocked (FS_VOL    *p_vol,
+                                          CPU_CHAR  *name_file,
+                                          FS_FLAGS  *p_mode,
+                                          FS_ERR    *p_err)
 {
-    LIB_ERR  pool_err;
-
+    FS_FILE            *p_file;
+    FS_QTY              hash_ix;
+    FS_FAT_FILE_DATA    disk_file_fat_data;
+    FS_FAT_FILE_DATA   *p_fat_file_data;
+    FS_VOL             *p_open_vol;
+    CPU_BOOLEAN         file_open;
 
-#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
-    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
-        FS_TRACE_INFO(("FSFile_ObjFree(): File pointer is invalid.\r\n"));
-        return;
-    }
-#endif
 
-    FSFile_Tbl[p_file->ID] = DEF_NULL;
+   *p_mode = FS_FILE_ACCESS_MODE_NONE;
 
-#if (FS_CFG_DBG_MEM_CLR_EN == DEF_ENABLED)
-    FSFile_ObjClr(p_file);
-#endif
+                                                                /* Get fat data from disk.                              */
+    FS_FAT_LowEntryFind(p_vol, &disk_file_fat_data, name_file, FS_FAT_MODE_FILE | FS_FAT_MODE_RD, p_err);
 
-    Mem_PoolBlkFree(        &FSFile_Pool,
-                    (void *) p_file,
-                            &pool_err);
+    switch (*p_err) {
+        case FS_ERR_NONE:
+             break;
 
-#if (FS_TRACE_LEVEL >= TRACE_LEVEL_INFO)
-    if (pool_err != LIB_MEM_ERR_NONE) {
-        FS_TRACE_INFO(("FSFile_ObjFree(): Could not free file to pool.\r\n"));
-        return;
-    }
-#endif
 
-    FSFile_Cnt--;
-}
+        case FS_ERR_ENTRY_NOT_FOUND:                            /* Entry do not exist. Cannot be open.                  */
+        case FS_ERR_ENTRY_PARENT_NOT_FOUND:
+        case FS_ERR_ENTRY_PARENT_NOT_DIR:
+            *p_err = FS_ERR_NONE;
+             return (DEF_NO);
 
 
-/*
-*********************************************************************************************************
-*                                           FSFile_ObjGet()
-*
-* Description : Allocate a file object.
-*
-* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
-*               -----       Argument validated by caller.
-*
-*                               FS_ERR_NONE                     File object successfully returned.
-*                               FS_ERR_NULL_PTR                 FSFile_Pool is a NULL pointer.
-*                               FS_ERR_POOL_EMPTY               NO blocks available in pool.
-*                               FS_ERR_POOL_INVALID_BLK_IX      Invalid pool block index.
-*                               FS_ERR_POOL_INVALID_BLK_ADDR    Block not found in used pool pointers.
-*
-* Return(s)   : Pointer to a file, if NO errors.
-*               Pointer to NULL,   otherwise.
-*
-* Note(s)     : (1) The function caller MUST hold the file system lock.
-*********************************************************************************************************
-*/
+        case FS_ERR_NAME_INVALID:
+        case FS_ERR_VOL_INVALID_SEC_NBR:
+        case FS_ERR_BUF_NONE_AVAIL:
+        case FS_ERR_ENTRY_NOT_FILE:
+        default:
+             return (DEF_NO);
+    }
 
-static  FS_FILE  *FSFile_ObjGet (FS_ERR *p_err)
-{
-    FS_FILE  *p_file;
-    LIB_ERR   pool_err;
-    FS_QTY    file_ix;
 
+                                                                /* --------- CMP TO FILES IN HASH TBL BUCKET ---------- */
+    FS_OS_Lock(FS_OS_LOCK_ID_FILE, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (DEF_NO);
+    }
 
+    hash_ix   = FSFile_HashIxGet(p_vol,                         /* See Note #1.                                         */
+                                 disk_file_fat_data.DirEndSec,
+                                 disk_file_fat_data.DirEndSecPos);
+    p_file    = FSFile_HashTbl[hash_ix];
+    file_open = DEF_NO;
+    while ((p_file    != DEF_NULL) &&
+           (file_open == DEF_NO)) {
+        p_open_vol = p_file->VolPtr;
+                                                                /* Cmp vol ptr.                                         */
+        if (p_open_vol == p_vol) {
+            p_fat_file_data         = (FS_FAT_FILE_DATA *)p_file->DataPtr;
 
-    for (file_ix = 0u; file_ix < FSFile_FileCntMax; file_ix++) {
-        if (FSFile_Tbl[file_ix] == DEF_NULL) {
-            break;
+                                                                /* If dir entry has same loc, file is open.             */
+            if (p_fat_file_data->DirEndSecPos == disk_file_fat_data.DirEndSecPos) {
+                if (p_fat_file_data->DirEndSec == disk_file_fat_data.DirEndSec) {
+                    if (p_fat_file_data->DirStartSecPos == disk_file_fat_data.DirStartSecPos) {
+                        if (p_fat_file_data->DirStartSec == disk_file_fat_data.DirStartSec) {
+                           *p_mode = p_file->AccessMode;
+                            file_open = DEF_YES;
+                        }
+                    }
+                }
+            }
         }
-    }
-    if (file_ix >= FSFile_FileCntMax) {
-        FS_TRACE_INFO(("FSFile_ObjGet(): Could not alloc file from pool. Opened file limit reached.\r\n"));
-       *p_err = FS_ERR_MEM_ALLOC;
-        return ((FS_FILE *)0);
-    }
 
-    p_file = (FS_FILE *)Mem_PoolBlkGet(&FSFile_Pool,
-                                        sizeof(FS_FILE),
-                                       &pool_err);
-    if (pool_err != LIB_MEM_ERR_NONE) {
-        FS_TRACE_INFO(("FSFile_ObjGet(): Could not alloc file from pool. Opened file limit reached.\r\n"));
-       *p_err = FS_ERR_MEM_ALLOC;
-        return ((FS_FILE *)0);
+        p_file = p_file->HashNextPtr;
     }
 
-    FSFile_Tbl[file_ix] = p_file;
-
-    FSFile_Cnt++;
+    FS_OS_Unlock(FS_OS_LOCK_ID_FILE);
 
-    FSFile_ObjClr(p_file);
 
-    p_file->ID = file_ix;
+   *p_err   = FS_ERR_NONE;
 
-    return (p_file);
+    return (file_open);
 }
 
 
@@ -3570,13 +6678,10 @@ static  CPU_CHAR  *FSFile_NameParseChk (CPU_CHAR   *name_full,
                                         FS_VOL    **pp_vol,
                                         FS_ERR     *p_err)
 {
-    CPU_SIZE_T   name_entry_len;
-    CPU_SIZE_T   file_name_len;
     CPU_CHAR    *name_entry;
-    CPU_CHAR    *file_name;
     FS_VOL      *p_vol_temp;
     CPU_CHAR     name_vol_temp[FS_CFG_MAX_VOL_NAME_LEN + 1u];
-    CPU_BOOLEAN  vol_lock_ok;
+    CPU_BOOLEAN  vol_ok;
 
 
    *pp_vol     = (FS_VOL *)0;
@@ -3593,6 +6698,127 @@ static  CPU_CHAR  *FSFile_NameParseChk (CPU_CHAR   *name_full,
         return ((CPU_CHAR *)0);                                 /* ... rtn NULL vol & file name.                        */
     }
 
+    name_entry = FSFile_NameChk(name_entry, p_err);             /* Chk entry name.                                      */
+    if (name_entry == (CPU_CHAR *)0) {
+        return ((CPU_CHAR *)0);
+    }
+
+                                                                /* Acquire ref to vol (see Note #2).                    */
+    p_vol_temp = (name_vol_temp[0] == (CPU_CHAR)ASCII_CHAR_NULL) ? FSVol_AcquireDflt()
+                                                                 : FSVol_Acquire(name_vol_temp, p_err);
+
+    if (p_vol_temp == (FS_VOL *)0) {                            /* Rtn err if vol not found.                            */
+       *p_err = FS_ERR_VOL_NOT_OPEN;
+        return ((CPU_CHAR *)0);
+    }
+
+    vol_ok = FSFile_VolLockChk(p_vol_temp, p_err);              /* Lock vol & chk vol is mounted.                       */
+    if (vol_ok != DEF_OK) {
+        return ((CPU_CHAR *)0);
+    }
+
+   *pp_vol = p_vol_temp;
+   *p_err  = FS_ERR_NONE;
+    return (name_entry);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FSFile_NameHandleChk()
+*
+* Description : Check file name & get volume pointer from volume handle.
+*
+* Argument(s) : name_file   Name of the file, from the root directory of the volume.
+*               ----------  Argument validated by caller.
+*
+*               vol_handle  Handle of the volume.
+*
+*               pp_vol      Pointer to volume pointer which will hold pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NAME_INVALID          Entry name lacks an initial path separator
+*                                                                character.
+*                               FS_ERR_NAME_PATH_TOO_LONG    Entry name is too long.
+*                               FS_ERR_VOL_NOT_OPEN          Volume not opened, or handle is invalid.
+*                               FS_ERR_VOL_NOT_MOUNTED       Volume not mounted.
+*                               FS_ERR_OS_LOCK               OS Lock NOT acquired.
+*
+* Return(s)   : Pointer to start of entry name.
+*
+* Note(s)     : (1) See 'FSFile_NameParseChk()  Note(s)'.
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR  *FSFile_NameHandleChk (CPU_CHAR        *name_file,
+                                         FS_VOL_HANDLE    vol_handle,
+                                         FS_VOL         **pp_vol,
+                                         FS_ERR          *p_err)
+{
+    CPU_CHAR     *name_entry;
+    FS_VOL       *p_vol_temp;
+    CPU_BOOLEAN   vol_ok;
+
+
+   *pp_vol     = (FS_VOL *)0;
+    name_entry =  FSFile_NameChk(name_file, p_err);             /* Chk entry name.                                      */
+    if (name_entry == (CPU_CHAR *)0) {
+        return ((CPU_CHAR *)0);
+    }
+
+    p_vol_temp = FSVol_AcquireByHandle(vol_handle, p_err);      /* Acquire ref to vol.                                  */
+    if (p_vol_temp == (FS_VOL *)0) {                            /* Rtn err if vol not found.                            */
+       *p_err = FS_ERR_VOL_NOT_OPEN;
+        return ((CPU_CHAR *)0);
+    }
+
+    vol_ok = FSFile_VolLockChk(p_vol_temp, p_err);              /* Lock vol & chk vol is mounted.                       */
+    if (vol_ok != DEF_OK) {
+        return ((CPU_CHAR *)0);
+    }
+
+   *pp_vol = p_vol_temp;
+   *p_err  = FS_ERR_NONE;
+    return (name_entry);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FSFile_NameChk()
+*
+* Description : Check entry name.
+*
+* Argument(s) : name_entry  Entry name, starting with the initial path separator character.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                  Entry name valid.
+*                               FS_ERR_NAME_INVALID          Entry name lacks an initial path separator
+*                                                                character.
+*                               FS_ERR_NAME_PATH_TOO_LONG    Entry path is too long.
+*                               FS_ERR_NAME_BASE_TOO_LONG    Entry base name is too long.
+*
+* Return(s)   : Pointer to entry name, after the initial path separator character, if NO errors.
+*               Pointer to NULL,                                                   otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR  *FSFile_NameChk (CPU_CHAR  *name_entry,
+                                   FS_ERR    *p_err)
+{
+    CPU_SIZE_T   name_entry_len;
+    CPU_SIZE_T   file_name_len;
+    CPU_CHAR    *file_name;
+
+
     if (*name_entry != FS_CHAR_PATH_SEP) {                      /* Require init path sep char.                          */
         *p_err =  FS_ERR_NAME_INVALID;
          return ((CPU_CHAR *)0);
@@ -3617,30 +6843,57 @@ static  CPU_CHAR  *FSFile_NameParseChk (CPU_CHAR   *name_full,
         return ((CPU_CHAR *)0);
     }
 
-                                                                /* Acquire ref to vol (see Note #2).                    */
-    p_vol_temp = (name_vol_temp[0] == (CPU_CHAR)ASCII_CHAR_NULL) ? FSVol_AcquireDflt()
-                                                                 : FSVol_Acquire(name_vol_temp, p_err);
+   *p_err = FS_ERR_NONE;
+    return (name_entry);
+}
 
-    if (p_vol_temp == (FS_VOL *)0) {                            /* Rtn err if vol not found.                            */
-       *p_err = FS_ERR_VOL_NOT_OPEN;
-        return ((CPU_CHAR *)0);
-    }
 
-    vol_lock_ok = FSVol_Lock(p_vol_temp);                       /* Lock vol.                                            */
+/*
+*********************************************************************************************************
+*                                         FSFile_VolLockChk()
+*
+* Description : Acquire volume lock & check that volume is mounted.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                  Volume lock acquired & volume mounted.
+*                               FS_ERR_VOL_NOT_OPEN          Volume not opened.
+*                               FS_ERR_VOL_NOT_MOUNTED       Volume not mounted.
+*                               FS_ERR_OS_LOCK               OS Lock NOT acquired.
+*
+* Return(s)   : DEF_OK,   if volume lock acquired & volume mounted.
+*               DEF_FAIL, otherwise.
+*
+* Note(s)     : (1) The function caller MUST hold a reference to the volume.  That reference is released
+*                   if the volume lock cannot be acquired or the volume is not mounted.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FSFile_VolLockChk (FS_VOL  *p_vol,
+                                        FS_ERR  *p_err)
+{
+    CPU_BOOLEAN  vol_lock_ok;
+
+
+    vol_lock_ok = FSVol_Lock(p_vol);                            /* Lock vol.                                            */
     if (vol_lock_ok == DEF_NO) {
        *p_err = FS_ERR_OS_LOCK;
-        FSVol_Release(p_vol_temp);
-        return ((CPU_CHAR *)0);
+        FSVol_Release(p_vol);
+        return (DEF_FAIL);
     }
 
-    (void)FSVol_RefreshLocked(p_vol_temp, p_err);               /* Refresh vol.                                         */
+    (void)FSVol_RefreshLocked(p_vol, p_err);                    /* Refresh vol.                                         */
 
-    switch (p_vol_temp->State) {
+    switch (p_vol->State) {
         case FS_VOL_STATE_OPEN:                                 /* Rtn err if vol is not mounted.                       */
         case FS_VOL_STATE_PRESENT:
             *p_err = FS_ERR_VOL_NOT_MOUNTED;
-             FSVol_ReleaseUnlock(p_vol_temp);
-             return ((CPU_CHAR *)0);
+             FSVol_ReleaseUnlock(p_vol);
+             return (DEF_FAIL);
 
 
         case FS_VOL_STATE_MOUNTED:
@@ -3652,11 +6905,10 @@ static  CPU_CHAR  *FSFile_NameParseChk (CPU_CHAR   *name_full,
         case FS_VOL_STATE_OPENING:                              /* Rtn err if vol is not open.                          */
         default:
             *p_err = FS_ERR_VOL_NOT_OPEN;
-             FSVol_ReleaseUnlock(p_vol_temp);
-             return ((CPU_CHAR *)0);
+             FSVol_ReleaseUnlock(p_vol);
+             return (DEF_FAIL);
     }
 
-   *pp_vol = p_vol_temp;
-   *p_err  = FS_ERR_NONE;
-    return (name_entry);
+   *p_err = FS_ERR_NONE;
+    return (DEF_OK);
 }
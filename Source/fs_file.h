@@ -133,6 +133,9 @@
                                                                 /* Data buffered for BOTH reads & writes.               */
 #define  FS_FILE_BUF_MODE_RD_WR                 (DEF_BIT_00 | DEF_BIT_01)
 #define  FS_FILE_BUF_MODE_SEC_ALIGNED            DEF_BIT_02     /* Force buffer align on sec boundaries.                */
+#define  FS_FILE_BUF_MODE_STREAM                 DEF_BIT_03     /* Buffer halves flushed by worker task.                */
+                                                                /* Data buffered for writes & flushed in background.    */
+#define  FS_FILE_BUF_MODE_WR_STREAM             (DEF_BIT_01 | DEF_BIT_03)
 
 /*
 *********************************************************************************************************
@@ -146,6 +149,30 @@
 #define  FS_FILE_BUF_STATUS_NONEMPTY_RD                   4u    /* Buffer has been    assigned & contains rd data.      */
 #define  FS_FILE_BUF_STATUS_NONEMPTY_WR                   5u    /* Buffer has been    assigned & contains data to wr.   */
 
+/*
+*********************************************************************************************************
+*                                   FILE ASYNC REQUEST OP DEFINES
+*********************************************************************************************************
+*/
+
+#define  FS_FILE_ASYNC_OP_NONE                             0u   /* No op.                                               */
+#define  FS_FILE_ASYNC_OP_RD                               1u   /* Read from file.                                      */
+#define  FS_FILE_ASYNC_OP_WR                               2u   /* Write to  file.                                      */
+#define  FS_FILE_ASYNC_OP_FLUSH                            3u   /* Flush file buf.                                      */
+#define  FS_FILE_ASYNC_OP_CLOSE                            4u   /* Close file.                                          */
+#define  FS_FILE_ASYNC_OP_BUF_WR                           5u   /* Wr stream buf half to file.                          */
+
+/*
+*********************************************************************************************************
+*                                 FILE ASYNC REQUEST STATE DEFINES
+*********************************************************************************************************
+*/
+
+#define  FS_FILE_ASYNC_REQ_STATE_FREE                      0u   /* Req free.                                            */
+#define  FS_FILE_ASYNC_REQ_STATE_QUEUED                    1u   /* Req queued on file.                                  */
+#define  FS_FILE_ASYNC_REQ_STATE_ACTIVE                    2u   /* Req being serviced by worker task.                   */
+#define  FS_FILE_ASYNC_REQ_STATE_DONE                      3u   /* Req complete, waiting to be reaped.                  */
+
 
 /*
 *********************************************************************************************************
@@ -193,6 +220,25 @@ struct  fs_file {
 
     FS_VOL         *VolPtr;                                     /* Ptr to mounted vol containing the file.              */
     void           *DataPtr;                                    /* Ptr to data specific for a file system driver.       */
+    FS_FILE        *HashNextPtr;                                /* Ptr to next file in open file hash tbl bucket.       */
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+    CPU_BOOLEAN     VolLockShared;                              /* Vol lock held in shared mode.                        */
+#endif
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+    FS_FILE_ASYNC_REQ  *AsyncReqHeadPtr;                        /* Ptr to head of file's pending async req list.        */
+    FS_FILE_ASYNC_REQ  *AsyncReqTailPtr;                        /* Ptr to tail of file's pending async req list.        */
+    FS_FILE            *AsyncNextPtr;                           /* Ptr to next file in async rdy list.                  */
+    CPU_BOOLEAN         AsyncSched;                             /* File in async rdy list or being serviced.            */
+
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+    void               *BufAltPtr;                              /* Ptr to stream buf half being flushed.                */
+    CPU_SIZE_T          BufAlignSize;                           /* Stream buf flush alignment (in octets).              */
+    FS_FILE_ASYNC_REQ  *BufFlushReqPtr;                         /* Ptr to async req reserved for stream buf flushes.    */
+    CPU_BOOLEAN         BufFlushPend;                           /* Stream buf flush pending.                            */
+#endif
+#endif
 
 #if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
     FS_CTR          StatRdCtr;                                  /* Nbr rds.                                             */
@@ -201,6 +247,74 @@ struct  fs_file {
 };
 
 
+/*
+*********************************************************************************************************
+*                                      FILE I/O VECTOR DATA TYPE
+*
+* Note(s) : (1) An array of I/O vectors describes the buffers of a vectored read or write, which are
+*               filled or drained in order as if they formed one contiguous buffer.
+*********************************************************************************************************
+*/
+
+struct  fs_file_iov {
+    void           *BufPtr;                                     /* Ptr to buf.                                          */
+    CPU_SIZE_T      Size;                                       /* Size of buf (in octets).                             */
+};
+
+
+/*
+*********************************************************************************************************
+*                                        FILE EXTENT DATA TYPE
+*
+* Note(s) : (1) A file extent describes a range of file data stored contiguously in memory, as returned
+*               by 'FSFile_Map()'.
+*********************************************************************************************************
+*/
+
+struct  fs_file_extent {
+    FS_FILE_SIZE    Pos;                                        /* File pos of first octet.                             */
+    void           *AddrPtr;                                    /* Mem addr of first octet.                             */
+    CPU_SIZE_T      Size;                                       /* Size of extent (in octets).                          */
+};
+
+
+/*
+*********************************************************************************************************
+*                                  FILE ASYNC REQUEST DATA TYPES
+*
+* Note(s) : (1) An async request completion callback is called from a worker task once the request has
+*               been serviced :
+*
+*               (a) 'p_file'          is the file the request was submitted on.  After a close request,
+*                                     the file MUST NOT be accessed.
+*               (b) 'p_callback_arg'  is the argument passed when the request was submitted.
+*               (c) 'size'            is the number of octets read or written.
+*               (d) 'err'             is the error code returned by the file operation.
+*
+*           (2) A request submitted without a callback MUST be reaped with 'FSFile_AsyncWait()'.
+*********************************************************************************************************
+*/
+
+typedef  void  (*FS_FILE_ASYNC_CALLBACK)(FS_FILE     *p_file,
+                                          void        *p_callback_arg,
+                                          CPU_SIZE_T   size,
+                                          FS_ERR       err);
+
+struct  fs_file_async_req {
+    FS_ID                    ID;                                /* Req ID cfg'd @ init.                                 */
+    FS_STATE                 State;                             /* Req state.                                           */
+    CPU_INT08U               Op;                                /* Req op.                                              */
+    FS_FILE                 *FilePtr;                           /* Ptr to file.                                         */
+    void                    *BufPtr;                            /* Ptr to rd/wr buf.                                    */
+    CPU_SIZE_T               Size;                              /* Size to rd/wr (in octets).                           */
+    CPU_SIZE_T               SizeDone;                          /* Size rd/wr'n  (in octets).                           */
+    FS_ERR                   Err;                               /* Err rtn'd by file op.                                */
+    FS_FILE_ASYNC_CALLBACK   CallbackFnct;                      /* Completion callback (see Note #1).                   */
+    void                    *CallbackArg;                       /* Completion callback arg.                             */
+    FS_FILE_ASYNC_REQ       *NextPtr;                           /* Ptr to next req in file or free list.                */
+};
+
+
 /*
 *********************************************************************************************************
 *                                          GLOBAL VARIABLES
@@ -214,6 +328,42 @@ struct  fs_file {
 *********************************************************************************************************
 */
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+FS_FILE_ASYNC_REQ  *FSFile_AsyncClose  (FS_FILE                 *p_file,            /* Submit async close.              */
+                                        FS_FILE_ASYNC_CALLBACK   callback,
+                                        void                    *p_callback_arg,
+                                        CPU_INT32U               timeout,
+                                        FS_ERR                  *p_err);
+
+FS_FILE_ASYNC_REQ  *FSFile_AsyncFlush  (FS_FILE                 *p_file,            /* Submit async buf flush.          */
+                                        FS_FILE_ASYNC_CALLBACK   callback,
+                                        void                    *p_callback_arg,
+                                        CPU_INT32U               timeout,
+                                        FS_ERR                  *p_err);
+
+FS_FILE_ASYNC_REQ  *FSFile_AsyncRd     (FS_FILE                 *p_file,            /* Submit async rd.                 */
+                                        void                    *p_dest,
+                                        CPU_SIZE_T               size,
+                                        FS_FILE_ASYNC_CALLBACK   callback,
+                                        void                    *p_callback_arg,
+                                        CPU_INT32U               timeout,
+                                        FS_ERR                  *p_err);
+
+CPU_SIZE_T          FSFile_AsyncWait   (FS_FILE_ASYNC_REQ       *p_req,             /* Wait for async req.              */
+                                        CPU_INT32U               timeout,
+                                        FS_ERR                  *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+FS_FILE_ASYNC_REQ  *FSFile_AsyncWr     (FS_FILE                 *p_file,            /* Submit async wr.                 */
+                                        void                    *p_src,
+                                        CPU_SIZE_T               size,
+                                        FS_FILE_ASYNC_CALLBACK   callback,
+                                        void                    *p_callback_arg,
+                                        CPU_INT32U               timeout,
+                                        FS_ERR                  *p_err);
+#endif
+#endif
+
 #if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
 void           FSFile_BufAssign    (FS_FILE         *p_file,    /* Assign buffer to a file.                             */
                                     void            *p_buf,
@@ -252,10 +402,21 @@ void           FSFile_LockSet      (FS_FILE         *p_file,    /* Release task
                                     FS_ERR          *p_err);
 #endif
 
+FS_QTY         FSFile_Map          (FS_FILE         *p_file,    /* Get direct mem addr's of file data.                  */
+                                    FS_FILE_SIZE     pos,
+                                    FS_FILE_EXTENT  *p_extent_tbl,
+                                    FS_QTY           extent_cnt,
+                                    FS_ERR          *p_err);
+
 FS_FILE       *FSFile_Open         (CPU_CHAR        *name_full, /* Open a file.                                         */
                                     FS_FLAGS         mode,
                                     FS_ERR          *p_err);
 
+FS_FILE       *FSFile_OpenByHandle (FS_VOL_HANDLE    vol_handle,/* Open a file on a volume given by handle.             */
+                                    CPU_CHAR        *name_file,
+                                    FS_FLAGS         mode,
+                                    FS_ERR          *p_err);
+
 FS_FILE_SIZE   FSFile_PosGet       (FS_FILE         *p_file,    /* Get file position indicator.                         */
                                     FS_ERR          *p_err);
 
@@ -264,6 +425,12 @@ void           FSFile_PosSet       (FS_FILE         *p_file,    /* Set file posi
                                     FS_STATE         origin,
                                     FS_ERR          *p_err);
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void           FSFile_Prealloc     (FS_FILE         *p_file,    /* Reserve storage for a file.                          */
+                                    FS_FILE_SIZE     size,
+                                    FS_ERR          *p_err);
+#endif
+
 void           FSFile_Query        (FS_FILE         *p_file,    /* Get information about a file.                        */
                                     FS_ENTRY_INFO   *p_info,
                                     FS_ERR          *p_err);
@@ -273,6 +440,17 @@ CPU_SIZE_T     FSFile_Rd           (FS_FILE         *p_file,    /* Read from a f
                                     CPU_SIZE_T       size,
                                     FS_ERR          *p_err);
 
+CPU_SIZE_T     FSFile_RdAt         (FS_FILE         *p_file,    /* Read from a file at a given position.                */
+                                    void            *p_dest,
+                                    CPU_SIZE_T       size,
+                                    FS_FILE_SIZE     pos,
+                                    FS_ERR          *p_err);
+
+CPU_SIZE_T     FSFile_RdV          (FS_FILE         *p_file,    /* Read from a file into several buffers.               */
+                                    FS_FILE_IOV     *p_iov,
+                                    FS_QTY           iov_cnt,
+                                    FS_ERR          *p_err);
+
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
 void           FSFile_Truncate     (FS_FILE         *p_file,    /* Truncate a file.                                     */
                                     FS_FILE_SIZE     size,
@@ -286,6 +464,21 @@ CPU_SIZE_T     FSFile_Wr           (FS_FILE         *p_file,    /* Write to a fi
                                     FS_ERR          *p_err);
 #endif
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T     FSFile_WrAt         (FS_FILE         *p_file,    /* Write to a file at a given position.                 */
+                                    void            *p_src,
+                                    CPU_SIZE_T       size,
+                                    FS_FILE_SIZE     pos,
+                                    FS_ERR          *p_err);
+#endif
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T     FSFile_WrV          (FS_FILE         *p_file,    /* Write to a file from several buffers.                */
+                                    FS_FILE_IOV     *p_iov,
+                                    FS_QTY           iov_cnt,
+                                    FS_ERR          *p_err);
+#endif
+
 /*
 *********************************************************************************************************
 *                                   MANAGEMENT FUNCTION PROTOTYPES
@@ -308,6 +501,18 @@ void           FSFile_ModuleInit   (FS_QTY           file_cnt,  /* Initialize fi
 FS_FLAGS       FSFile_ModeParse    (CPU_CHAR        *str_mode,  /* Parse mode string.                                   */
                                     CPU_SIZE_T       str_len);
 
+CPU_BOOLEAN    FSFile_IsOpenAt     (FS_VOL          *p_vol,     /* Test if file at dir entry loc is open.               */
+                                    FS_SEC_NBR       dir_sec,
+                                    FS_SEC_SIZE      dir_sec_pos);
+
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void           FSFile_AsyncModuleInit (FS_QTY        req_cnt,   /* Initialize async file req's.                         */
+                                       FS_QTY        task_cnt,
+                                       FS_ERR       *p_err);
+
+void           FSFile_AsyncTaskHandler(void);                   /* Service async file req's.                            */
+#endif
+
 /*
 *********************************************************************************************************
 *                                         FUNCTION PROTOTYPES
@@ -328,6 +533,27 @@ void           FS_OS_FileLock      (FS_ID            file_id,   /* Acquire acces
 CPU_BOOLEAN    FS_OS_FileUnlock    (FS_ID            file_id);  /* Release access to file system file.                  */
 #endif
 
+#if (FS_CFG_FILE_ASYNC_EN == DEF_ENABLED)
+void           FS_OS_FileAsyncInit      (FS_QTY       req_cnt,    /* Create async req objects & worker tasks.           */
+                                         FS_QTY       task_cnt,
+                                         FS_ERR      *p_err);
+
+void           FS_OS_FileAsyncQueuePend (CPU_INT32U   timeout,    /* Wait for free async req.                           */
+                                         FS_ERR      *p_err);
+
+void           FS_OS_FileAsyncQueuePost (void);                   /* Signal free async req.                             */
+
+void           FS_OS_FileAsyncTaskPend  (FS_ERR      *p_err);     /* Wait for rdy async req.                            */
+
+void           FS_OS_FileAsyncTaskPost  (void);                   /* Signal rdy async req.                              */
+
+void           FS_OS_FileAsyncReqPend   (FS_ID        req_id,     /* Wait for async req completion.                     */
+                                         CPU_INT32U   timeout,
+                                         FS_ERR      *p_err);
+
+void           FS_OS_FileAsyncReqPost   (FS_ID        req_id);    /* Signal async req completion.                       */
+#endif
+
 
 /*
 *********************************************************************************************************
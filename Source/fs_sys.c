@@ -59,6 +59,7 @@
 #include  "../FAT/fs_fat_dir.h"
 #include  "../FAT/fs_fat_entry.h"
 #include  "../FAT/fs_fat_file.h"
+#include  "../FAT/fs_fat_journal.h"
 
 
 /*
@@ -178,6 +179,30 @@ void  FSSys_VolClose (FS_VOL  *p_vol)
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FSSys_VolClusSizeGet()
+*
+* Description : Get size of the allocation unit of the file system on a volume.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+* Return(s)   : Allocation unit size, in octets.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+FS_SEC_SIZE  FSSys_VolClusSizeGet (FS_VOL  *p_vol)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    return (FS_FAT_VolClusSizeGet(p_vol));
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+
+
 /*
 *********************************************************************************************************
 *                                           FSSys_VolFmt()
@@ -367,6 +392,73 @@ void  FSSys_VolQuery (FS_VOL       *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSSys_VolWrPrep()
+*
+* Description : Prepare a volume for a sector write.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+*               p_src       Pointer to source buffer, or DEF_NULL if no data is given (see Note #3).
+*
+*               start       Start sector of write.
+*
+*               cnt         Number of sectors to write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE    Volume ready for write.
+*
+*                               ---------- RETURNED BY FS_FAT_JournalStageFlush() ----------
+*                               See FS_FAT_JournalStageFlush() for additional return error codes.
+*
+*                               ------------- RETURNED BY FS_FAT_VolDirtySet() -------------
+*                               See FS_FAT_VolDirtySet() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Journal logs gathered in the staging buffer MUST reach the device before the
+*                   sectors they protect (see 'fs_fat_journal.c  FS_FAT_JournalWr()  Note #1').
+*
+*               (2) The volume MUST be marked dirty before it is first modified (see 'fs_fat.c
+*                   FS_FAT_VolDirtySet()  Note #1').
+*
+*               (3) Before the volume cache is flushed, no sector is given; cached sectors were prepared
+*                   when written to the cache.  When sectors are discarded, the range is given without a
+*                   source buffer.
+*********************************************************************************************************
+*/
+
+#ifdef  FS_SYS_VOL_WR_PREP_PRESENT
+void  FSSys_VolWrPrep (FS_VOL      *p_vol,
+                       void        *p_src,
+                       FS_SEC_NBR   start,
+                       FS_SEC_QTY   cnt,
+                       FS_ERR      *p_err)
+{
+#ifdef  FS_FAT_JOURNAL_STAGE_MODULE_PRESENT
+    FS_FAT_JournalStageFlush(p_vol, p_err);                     /* Wr staged journal sec (see Note #1).                 */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+#endif
+
+#if ((FS_FAT_CFG_VOL_DIRTY_EN == DEF_ENABLED) && (FS_CFG_RD_ONLY_EN == DEF_DISABLED))
+    FS_FAT_VolDirtySet(p_vol,                                   /* Mark vol dirty (see Note #2).                        */
+                       p_src,
+                       start,
+                       cnt,
+                       p_err);
+#else
+    (void)p_src;
+    (void)start;
+    (void)cnt;
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -405,6 +497,53 @@ void  FSSys_FileClose  (FS_FILE  *p_file,
 }
 
 
+/*
+*********************************************************************************************************
+*                                           FSSys_FileMap()
+*
+* Description : Get direct memory addresses of file data.
+*
+* Argument(s) : p_file          Pointer to a file.
+*               ------          Argument validated by caller.
+*
+*               pos             File position of first octet to map.
+*
+*               p_extent_tbl    Pointer to table that will receive the extents.
+*               ------------    Argument validated by caller.
+*
+*               extent_cnt      Number of entries in 'p_extent_tbl'.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE                   File mapped.
+*                                   FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                                   FS_ERR_DEV                    Device access error.
+*                                   FS_ERR_DEV_INVALID_IO_CTRL    Device data is NOT memory-mapped.
+*                                   FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
+*
+* Return(s)   : Number of extents obtained.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+FS_QTY  FSSys_FileMap (FS_FILE         *p_file,
+                       FS_FILE_SIZE     pos,
+                       FS_FILE_EXTENT  *p_extent_tbl,
+                       FS_QTY           extent_cnt,
+                       FS_ERR          *p_err)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    FS_QTY  cnt;
+
+    cnt = FS_FAT_FileMap(p_file, pos, p_extent_tbl, extent_cnt, p_err);
+    return (cnt);
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+
+
 /*
 *********************************************************************************************************
 *                                          FSSys_FileOpen()
@@ -488,6 +627,45 @@ void  FSSys_FilePosSet (FS_FILE       *p_file,
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FSSys_FilePrealloc()
+*
+* Description : Allocate clusters to a file ahead of the writes that will use them.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               size        Number of octets the file's cluster chain must be able to hold.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              Clusters allocated successfully.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*                               FS_ERR_DEV_FULL          Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT     File system entry is corrupt.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSSys_FilePrealloc (FS_FILE       *p_file,
+                          FS_FILE_SIZE   size,
+                          FS_ERR        *p_err)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    FS_FAT_FilePrealloc(p_file, size, p_err);
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                          FSSys_FileQuery()
@@ -568,6 +746,97 @@ CPU_SIZE_T  FSSys_FileRd (FS_FILE     *p_file,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSSys_FileRdAt()
+*
+* Description : Read from a file at a given position, without changing the file position.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_dest      Pointer to destination buffer.
+*               ------      Argument validated by caller.
+*
+*               size        Number of octets to read.
+*
+*               pos         File position of first octet to read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              File read successful.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*                               FS_ERR_ENTRY_CORRUPT     File system entry corrupt.
+*
+* Return(s)   : Number of bytes read, if file read successful.
+*               0,                    otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FSSys_FileRdAt (FS_FILE       *p_file,
+                            void          *p_dest,
+                            CPU_SIZE_T     size,
+                            FS_FILE_SIZE   pos,
+                            FS_ERR        *p_err)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    CPU_SIZE_T  size_rd;
+
+    size_rd = FS_FAT_FileRdAt(p_file, p_dest, size, pos, p_err);
+    return (size_rd);
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                           FSSys_FileRdV()
+*
+* Description : Read from a file into several buffers.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_iov       Pointer to array of I/O vectors describing destination buffers.
+*               -----       Argument validated by caller.
+*
+*               iov_cnt     Number of I/O vectors.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              File read successful.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*                               FS_ERR_ENTRY_CORRUPT     File system entry corrupt.
+*
+* Return(s)   : Number of bytes read, if file read successful.
+*               0,                    otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FSSys_FileRdV (FS_FILE      *p_file,
+                           FS_FILE_IOV  *p_iov,
+                           FS_QTY        iov_cnt,
+                           FS_ERR       *p_err)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    CPU_SIZE_T  size_rd;
+
+    size_rd = FS_FAT_FileRdV(p_file, p_iov, iov_cnt, p_err);
+    return (size_rd);
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+
+
 /*
 *********************************************************************************************************
 *                                        FSSys_FileTruncate()
@@ -653,6 +922,102 @@ CPU_SIZE_T  FSSys_FileWr (FS_FILE     *p_file,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                          FSSys_FileWrAt()
+*
+* Description : Write to a file at a given position, without changing the file position.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_src       Pointer to source buffer.
+*               -----       Argument validated by caller.
+*
+*               size        Number of octets to write.
+*
+*               pos         File position of first octet to write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE             File written successful.
+*                               FS_ERR_BUF_NONE_AVAIL   No buffer available.
+*                               FS_ERR_DEV              Device access error.
+*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+*
+* Return(s)   : Number of bytes written, if file write successful.
+*               0,                       otherwise.
+*
+* Note(s)     : (1) 'pos' MUST NOT be greater than the file size.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T  FSSys_FileWrAt (FS_FILE       *p_file,
+                            void          *p_src,
+                            CPU_SIZE_T     size,
+                            FS_FILE_SIZE   pos,
+                            FS_ERR        *p_err)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    CPU_SIZE_T  size_wr;
+
+    size_wr = FS_FAT_FileWrAt(p_file, p_src, size, pos, p_err);
+    return (size_wr);
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           FSSys_FileWrV()
+*
+* Description : Write to a file from several buffers.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_iov       Pointer to array of I/O vectors describing source buffers.
+*               -----       Argument validated by caller.
+*
+*               iov_cnt     Number of I/O vectors.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE             File written successful.
+*                               FS_ERR_DEV              Device access error.
+*                               FS_ERR_DEV_FULL         Device is full (no space could be allocated).
+*                               FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+*
+* Return(s)   : Number of bytes written, if file write successful.
+*               0,                       otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+CPU_SIZE_T  FSSys_FileWrV (FS_FILE      *p_file,
+                           FS_FILE_IOV  *p_iov,
+                           FS_QTY        iov_cnt,
+                           FS_ERR       *p_err)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    CPU_SIZE_T  size_wr;
+
+    size_wr = FS_FAT_FileWrV(p_file, p_iov, iov_cnt, p_err);
+    return (size_wr);
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -921,6 +1286,48 @@ void  FSSys_EntryDel (FS_VOL       *p_vol,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                        FSSys_EntryDelTree()
+*
+* Description : Delete a file, or a directory & every entry in its tree.
+*
+* Argument(s) : p_vol       Pointer to volume on which the entry resides.
+*
+*               name_entry  Name of the entry.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                      Entry deleted successfully.
+*                               FS_ERR_BUF_NONE_AVAIL            Buffer not available.
+*                               FS_ERR_DEV                       Device access error.
+*                               FS_ERR_ENTRY_CORRUPT             File system entry is corrupt.
+*                               FS_ERR_ENTRY_NOT_FOUND           File system entry NOT found.
+*                               FS_ERR_ENTRY_OPEN                Open entry found in tree.
+*                               FS_ERR_ENTRY_PARENT_NOT_FOUND    Entry parent NOT found.
+*                               FS_ERR_ENTRY_PARENT_NOT_DIR      Entry parent NOT a directory.
+*                               FS_ERR_NAME_INVALID              Invalid file name or path.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSSys_EntryDelTree (FS_VOL       *p_vol,
+                          CPU_CHAR     *name_entry,
+                          FS_ERR       *p_err)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    FS_FAT_EntryDelTree(p_vol, name_entry, p_err);
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FSSys_EntryQuery()
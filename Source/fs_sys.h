@@ -125,6 +125,8 @@ void        FSSys_ModuleInit    (FS_QTY          vol_cnt,       /* Initialize sy
                                                                 /* ----------------- VOLUME FUNCTIONS ----------------- */
 void        FSSys_VolClose      (FS_VOL         *p_vol);        /* Close a volume.                                      */
 
+FS_SEC_SIZE FSSys_VolClusSizeGet(FS_VOL         *p_vol);        /* Get volume allocation unit size.                     */
+
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
 void        FSSys_VolFmt        (FS_VOL         *p_vol,         /* Create a volume.                                     */
                                  void           *p_sys_cfg,
@@ -151,11 +153,25 @@ void        FSSys_VolQuery      (FS_VOL         *p_vol,         /* Get info abou
                                  FS_SYS_INFO    *p_info,
                                  FS_ERR         *p_err);
 
+#ifdef  FS_SYS_VOL_WR_PREP_PRESENT
+void        FSSys_VolWrPrep     (FS_VOL         *p_vol,         /* Prepare a volume for a sector write.                 */
+                                 void           *p_src,
+                                 FS_SEC_NBR      start,
+                                 FS_SEC_QTY      cnt,
+                                 FS_ERR         *p_err);
+#endif
+
 
                                                                 /* ------------------ FILE FUNCTIONS ------------------ */
 void        FSSys_FileClose     (FS_FILE        *p_file,        /* Close a file.                                        */
                                  FS_ERR         *p_err);
 
+FS_QTY      FSSys_FileMap       (FS_FILE        *p_file,        /* Get direct mem addr's of file data.                  */
+                                 FS_FILE_SIZE    pos,
+                                 FS_FILE_EXTENT *p_extent_tbl,
+                                 FS_QTY          extent_cnt,
+                                 FS_ERR         *p_err);
+
 void        FSSys_FileOpen      (FS_FILE        *p_file,        /* Open a file.                                         */
                                  CPU_CHAR       *name_file,
                                  FS_ERR         *p_err);
@@ -164,6 +180,12 @@ void        FSSys_FilePosSet    (FS_FILE        *p_file,        /* Set file posi
                                  FS_FILE_SIZE    pos_new,
                                  FS_ERR         *p_err);
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void        FSSys_FilePrealloc  (FS_FILE        *p_file,        /* Alloc clus's to a file ahead of wr's.                */
+                                 FS_FILE_SIZE    size,
+                                 FS_ERR         *p_err);
+#endif
+
 void        FSSys_FileQuery     (FS_FILE        *p_file,        /* Get info about file.                                 */
                                  FS_ENTRY_INFO  *p_info,
                                  FS_ERR         *p_err);
@@ -173,6 +195,17 @@ CPU_SIZE_T  FSSys_FileRd        (FS_FILE        *p_file,        /* Read from a f
                                  CPU_SIZE_T      size,
                                  FS_ERR         *p_err);
 
+CPU_SIZE_T  FSSys_FileRdAt      (FS_FILE        *p_file,        /* Read from a file at a given position.                */
+                                 void           *p_dest,
+                                 CPU_SIZE_T      size,
+                                 FS_FILE_SIZE    pos,
+                                 FS_ERR         *p_err);
+
+CPU_SIZE_T  FSSys_FileRdV       (FS_FILE        *p_file,        /* Read from a file into several buffers.               */
+                                 FS_FILE_IOV    *p_iov,
+                                 FS_QTY          iov_cnt,
+                                 FS_ERR         *p_err);
+
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
 void        FSSys_FileTruncate  (FS_FILE        *p_file,        /* Truncate a file.                                     */
                                  FS_FILE_SIZE    size,
@@ -184,6 +217,17 @@ CPU_SIZE_T  FSSys_FileWr        (FS_FILE        *p_file,        /* Write to a fi
                                  void           *p_src,
                                  CPU_SIZE_T      size,
                                  FS_ERR         *p_err);
+
+CPU_SIZE_T  FSSys_FileWrAt      (FS_FILE        *p_file,        /* Write to a file at a given position.                 */
+                                 void           *p_src,
+                                 CPU_SIZE_T      size,
+                                 FS_FILE_SIZE    pos,
+                                 FS_ERR         *p_err);
+
+CPU_SIZE_T  FSSys_FileWrV       (FS_FILE        *p_file,        /* Write to a file from several buffers.                */
+                                 FS_FILE_IOV    *p_iov,
+                                 FS_QTY          iov_cnt,
+                                 FS_ERR         *p_err);
 #endif
 
 #ifdef FS_DIR_MODULE_PRESENT
@@ -216,6 +260,10 @@ void        FSSys_EntryDel      (FS_VOL         *p_vol,         /* Delete a file
                                  CPU_CHAR       *name_entry,
                                  FS_FLAGS        entry_type,
                                  FS_ERR         *p_err);
+
+void        FSSys_EntryDelTree  (FS_VOL         *p_vol,         /* Delete a file or directory tree.                     */
+                                 CPU_CHAR       *name_entry,
+                                 FS_ERR         *p_err);
 #endif
 
 void        FSSys_EntryQuery    (FS_VOL         *p_vol,         /* Delete a file or directory.                          */
@@ -91,12 +91,20 @@ typedef  struct  fs_dev              FS_DEV;
 
 typedef  struct  fs_dev_api          FS_DEV_API;
 
+typedef  struct  fs_dev_handle       FS_DEV_HANDLE;
+
 typedef  struct  fs_dir              FS_DIR;
 
 typedef  struct  fs_entry_info       FS_ENTRY_INFO;
 
 typedef  struct  fs_file             FS_FILE;
 
+typedef  struct  fs_file_async_req   FS_FILE_ASYNC_REQ;
+
+typedef  struct  fs_file_extent      FS_FILE_EXTENT;
+
+typedef  struct  fs_file_iov         FS_FILE_IOV;
+
 typedef  struct  fs_partition_entry  FS_PARTITION_ENTRY;
 
 typedef  struct  fs_sys_info         FS_SYS_INFO;
@@ -105,6 +113,8 @@ typedef  struct  fs_vol              FS_VOL;
 
 typedef  struct  fs_vol_cache_api    FS_VOL_CACHE_API;
 
+typedef  struct  fs_vol_handle       FS_VOL_HANDLE;
+
 
 /*
 *********************************************************************************************************
@@ -53,6 +53,7 @@
 #include  <lib_ascii.h>
 #include  "fs.h"
 #include  "fs_unicode.h"
+#include  "fs_util.h"
 
 
 /*
@@ -286,6 +287,14 @@ static  const  WC_SRCH_TBL_ENTRY  *WC_SrchTbl(const  WC_SRCH_TBL_ENTRY  *ptbl,
                                               CPU_SIZE_T                 tbl_len,
                                               CPU_WCHAR                  c_key);
 
+static  CPU_SIZE_T                  MB_StrToWC_ASCII(CPU_WCHAR                 *pdest,
+                                                     CPU_CHAR                  *psrc,
+                                                     CPU_SIZE_T                 len_max);
+
+static  CPU_SIZE_T                  WC_StrToMB_ASCII(CPU_CHAR                  *pdest,
+                                                     CPU_WCHAR                 *psrc,
+                                                     CPU_SIZE_T                 len_max);
+
 
 /*
 *********************************************************************************************************
@@ -1107,6 +1116,17 @@ CPU_INT32S  WC_StrCmpIgnoreCase (CPU_WCHAR  *p1_str,
 *
 *               (5) In analogy to 'Str_CmpIgnoreCase_N()', the return value is calculated from the value
 *                   of the character(s) from the strings, case-folded.
+*
+*               (6) (a) Runs of ASCII characters are compared word-at-a-time : the characters are packed
+*                       into a 'CPU_DATA' word, one character per octet, & case-folded with
+*                       'FS_UTIL_WORD_TO_LOWER()'.  As soon as a non-ASCII character, a NULL character or a
+*                       mismatch is found in a word, the comparison resumes character per character from
+*                       the start of that word, so that the return value is identical to the one of the
+*                       character per character comparison.
+*
+*                   (b) Each character is checked as it is packed & packing stops at the first NULL
+*                       character, so that no character is read past the terminating NULL character of
+*                       either string.
 *********************************************************************************************************
 */
 
@@ -1120,6 +1140,10 @@ CPU_INT32S  WC_StrCmpIgnoreCase_N (CPU_WCHAR   *p1_str,
     CPU_WCHAR    char2;
     CPU_INT32S   cmp_val;
     CPU_SIZE_T   cmp_len;
+    CPU_BOOLEAN  cmp_word;
+    CPU_SIZE_T   ix;
+    CPU_DATA     word1;
+    CPU_DATA     word2;
 
 
     if (len_max == 0u) {                                        /* If cmp len equals zero, rtn 0      (see Note #3d1).  */
@@ -1141,13 +1165,51 @@ CPU_INT32S  WC_StrCmpIgnoreCase_N (CPU_WCHAR   *p1_str,
     }
 
 
+    cmp_len  = 0u;
+    cmp_word = DEF_YES;
+    while ((cmp_word             == DEF_YES) &&                 /* Cmp ASCII chars word-at-a-time (see Note #6a).       */
+           ((len_max - cmp_len)  >= FS_UTIL_WORD_NBR_OCTETS)) {
+        word1 = 0u;
+        word2 = 0u;
+        ix    = 0u;
+        while ((cmp_word == DEF_YES) &&                         /* Pack chars in word (see Note #6b).                   */
+               (ix       <  FS_UTIL_WORD_NBR_OCTETS)) {
+            char1 = p1_str[ix];
+            char2 = p2_str[ix];
+            if ((char1 == (CPU_WCHAR)ASCII_CHAR_NULL)   ||
+                (char2 == (CPU_WCHAR)ASCII_CHAR_NULL)   ||
+                (char1 >  (CPU_WCHAR)ASCII_CHAR_DELETE) ||
+                (char2 >  (CPU_WCHAR)ASCII_CHAR_DELETE)) {
+                cmp_word = DEF_NO;                              /* NULL or non-ASCII char : cmp per char.               */
+            } else {
+                word1 = (word1 << DEF_OCTET_NBR_BITS) | (CPU_DATA)char1;
+                word2 = (word2 << DEF_OCTET_NBR_BITS) | (CPU_DATA)char2;
+                ix++;
+            }
+        }
+
+        if ((cmp_word                     == DEF_YES) &&
+            (FS_UTIL_WORD_TO_LOWER(word1) != FS_UTIL_WORD_TO_LOWER(word2))) {
+            cmp_word = DEF_NO;                                  /* Mismatch : cmp per char.                             */
+        }
+
+        if (cmp_word == DEF_YES) {
+            p1_str  += FS_UTIL_WORD_NBR_OCTETS;
+            p2_str  += FS_UTIL_WORD_NBR_OCTETS;
+            cmp_len += FS_UTIL_WORD_NBR_OCTETS;
+        }
+    }
+
+    if (cmp_len == len_max) {                                   /* If strs identical for len nbr of chars, rtn 0.       */
+        return ((CPU_INT32S)0);
+    }
+
     p1_str_next = p1_str;
     p2_str_next = p2_str;
     p1_str_next++;
     p2_str_next++;
     char1       = WC_CharToCasefold(*p1_str);
     char2       = WC_CharToCasefold(*p2_str);
-    cmp_len     = 0u;
     while (( char1       ==  char2)          &&                 /* Cmp strs until non-matching chars (see Note #3c) ... */
            (*p1_str      != (CPU_WCHAR   )0) &&                 /* ... or NULL chars                 (see Note #3b) ... */
            ( p1_str_next != (CPU_WCHAR  *)0) &&                 /* ... or NULL ptr(s) found          (see Note #3a2)    */
@@ -2647,7 +2709,7 @@ CPU_SIZE_T  MB_CharToWC (CPU_WCHAR   *pc_dest,
     c_src_byte1 = (CPU_INT08U)*pc_src;                          /* Get 1st UTF-8 char.                                  */
     pc_src++;
 
-    if (c_src_byte1 > 0xF5u) {                                  /* Validate 1st byte (see Note #2b1B, 2b1D).            */
+    if (c_src_byte1 >= 0xF5u) {                                 /* Validate 1st byte (see Note #2b1B, 2b1D).            */
         return ((CPU_SIZE_T)-1);
     }
 
@@ -2887,6 +2949,9 @@ CPU_SIZE_T  MB_CharLen (CPU_CHAR    *pc,
 *                       (1) 'len_max' number of characters does NOT include the terminating NULL character.
 *                       (2) Pointer to address past the last wide character converted stored in indirect
 *                           source string pointer.
+*
+*               (3) Runs of ASCII characters are converted word-at-a-time (see 'WC_StrToMB_ASCII()').  Other
+*                   characters are converted & validated one at a time by 'WC_CharToMB()'.
 *********************************************************************************************************
 */
 
@@ -2897,6 +2962,7 @@ CPU_SIZE_T  WC_StrToMB (CPU_CHAR     *pdest,
     CPU_WCHAR   *psrc;
     CPU_SIZE_T   len_rem;
     CPU_SIZE_T   len_char;
+    CPU_SIZE_T   len_ascii;
 
 
                                                                 /* Rtn NULL if str ptr(s) NULL      (see Note #2a).     */
@@ -2918,16 +2984,31 @@ CPU_SIZE_T  WC_StrToMB (CPU_CHAR     *pdest,
     }
 
 
-    len_rem  = len_max;
-    len_char = WC_CharToMB( pdest,
-                           *psrc);
+    len_ascii = WC_StrToMB_ASCII(pdest,                         /* Convert leading ASCII chars (see Note #3).           */
+                                 psrc,
+                                 len_max);
+    len_rem   = len_max - len_ascii;
+    pdest    += len_ascii;
+    psrc     += len_ascii;
+    len_char  = WC_CharToMB( pdest,
+                            *psrc);
 
     while ((len_char <= MB_MAX_LEN) &&                          /* Convert str until conversion err (see Note #2b) ...  */
            (len_char != 0u)         &&                          /* ... or NULL wide char found      (see Note #2c) ...  */
            (len_rem  >= MB_MAX_LEN)) {                          /* ... or max nbr bytes stored.     (see Note #2d).     */
         len_rem -= len_char;
         pdest   += len_char;
-        psrc++;
+        if (*psrc > (CPU_WCHAR)ASCII_CHAR_DELETE) {             /* After non-ASCII char, convert next ASCII run.        */
+            psrc++;
+            len_ascii = WC_StrToMB_ASCII(pdest,
+                                         psrc,
+                                         len_rem);
+            len_rem  -= len_ascii;
+            pdest    += len_ascii;
+            psrc     += len_ascii;
+        } else {
+            psrc++;
+        }
 
         if (len_rem >= MB_MAX_LEN) {
             len_char = WC_CharToMB( pdest,
@@ -3015,6 +3096,9 @@ CPU_SIZE_T  WC_StrToMB (CPU_CHAR     *pdest,
 *                       (1) 'len_max' number of characters does NOT include the terminating NULL character.
 *                       (2) Pointer to address past the last wide character converted stored in indirect
 *                           source string pointer.
+*
+*               (3) Runs of ASCII characters are converted word-at-a-time (see 'MB_StrToWC_ASCII()').  Other
+*                   characters are decoded & validated one at a time by 'MB_CharToWC()'.
 *********************************************************************************************************
 */
 
@@ -3025,6 +3109,7 @@ CPU_SIZE_T  MB_StrToWC (CPU_WCHAR    *pdest,
     CPU_CHAR    *psrc;
     CPU_SIZE_T   len_copy;
     CPU_SIZE_T   len_char;
+    CPU_SIZE_T   len_ascii;
     CPU_WCHAR    src_char;
 
 
@@ -3047,10 +3132,14 @@ CPU_SIZE_T  MB_StrToWC (CPU_WCHAR    *pdest,
     }
 
 
+    len_copy = MB_StrToWC_ASCII(pdest,                          /* Convert leading ASCII chars (see Note #3).           */
+                                psrc,
+                                len_max);
+    pdest   += len_copy;
+    psrc    += len_copy;
     len_char = MB_CharToWC(&src_char,
                             psrc,
                             MB_MAX_LEN);
-    len_copy = 0u;
 
     while ((len_char <= MB_MAX_LEN) &&                          /* Convert str until conversion err (see Note #2b) ...  */
            (len_char != 0u)         &&                          /* ... or NULL char found           (see Note #2c) ...  */
@@ -3060,6 +3149,15 @@ CPU_SIZE_T  MB_StrToWC (CPU_WCHAR    *pdest,
         pdest++;
         len_copy++;
 
+        if (len_char > 1u) {                                    /* After non-ASCII char, convert next ASCII run.        */
+            len_ascii = MB_StrToWC_ASCII(pdest,
+                                         psrc,
+                                         len_max - len_copy);
+            pdest    += len_ascii;
+            psrc     += len_ascii;
+            len_copy += len_ascii;
+        }
+
         len_char = MB_CharToWC(&src_char,
                                 psrc,
                                 MB_MAX_LEN);
@@ -3167,3 +3265,122 @@ static  const  WC_SRCH_TBL_ENTRY  *WC_SrchTbl (const  WC_SRCH_TBL_ENTRY  *ptbl,
     ptbl_entry = &ptbl[ix_mid];                             /*lint !e771 Suppress "'ix_mid' conceivably not init'd".*/
     return  (ptbl_entry);
 }
+
+
+/*
+*********************************************************************************************************
+*                                         MB_StrToWC_ASCII()
+*
+* Description : Convert leading run of ASCII characters of a multi-byte character string to wide characters,
+*               word-at-a-time.
+*
+* Argument(s) : pdest       Pointer to buffer that will receive the wide-character string.
+*
+*               psrc        Pointer to multi-byte character string to convert.
+*
+*               len_max     Maximum number of characters to store in 'pdest'.
+*
+* Return(s)   : Number of characters converted (& of octets consumed from 'psrc').
+*
+* Note(s)     : (1) Octets are packed into a 'CPU_DATA' word one at a time, so 'psrc' needs not be aligned
+*                   & is never accessed through a 'CPU_DATA' pointer.  Each octet is checked as it is packed;
+*                   the conversion stops at the first word holding a non-ASCII or NULL character, which
+*                   MUST then be converted by the caller.
+*
+*               (2) Packing stops at the terminating NULL character, so no octet past the end of the string
+*                   is accessed.
+*
+*               (3) No terminating NULL character is stored.
+*********************************************************************************************************
+*/
+
+static  CPU_SIZE_T  MB_StrToWC_ASCII (CPU_WCHAR   *pdest,
+                                      CPU_CHAR    *psrc,
+                                      CPU_SIZE_T   len_max)
+{
+    CPU_SIZE_T   len_copy;
+    CPU_SIZE_T   ix;
+    CPU_INT08U   src_byte;
+    CPU_DATA     src_word;
+
+
+    len_copy = 0u;
+    while ((len_max - len_copy) >= FS_UTIL_WORD_NBR_OCTETS) {   /* Convert words of ASCII chars (see Note #1).          */
+        src_word = 0u;
+        for (ix = 0u; ix < FS_UTIL_WORD_NBR_OCTETS; ix++) {     /* Pack octets in word (see Note #2).                   */
+            src_byte = (CPU_INT08U)psrc[ix];
+            if ((src_byte == (CPU_INT08U)ASCII_CHAR_NULL) ||
+                (src_byte >  (CPU_INT08U)ASCII_CHAR_DELETE)) {
+                return (len_copy);
+            }
+            src_word = (src_word << DEF_OCTET_NBR_BITS) | (CPU_DATA)src_byte;
+        }
+        for (ix = FS_UTIL_WORD_NBR_OCTETS; ix > 0u; ix--) {     /* Store chars from word.                               */
+            pdest[ix - 1u] = (CPU_WCHAR)(src_word & DEF_OCTET_MASK);
+            src_word     >>= DEF_OCTET_NBR_BITS;
+        }
+        pdest    += FS_UTIL_WORD_NBR_OCTETS;
+        psrc     += FS_UTIL_WORD_NBR_OCTETS;
+        len_copy += FS_UTIL_WORD_NBR_OCTETS;
+    }
+
+    return (len_copy);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         WC_StrToMB_ASCII()
+*
+* Description : Convert leading run of ASCII characters of a wide-character string to multi-byte characters,
+*               word-at-a-time.
+*
+* Argument(s) : pdest       Pointer to buffer that will receive the multi-byte character string.
+*
+*               psrc        Pointer to wide-character string to convert.
+*
+*               len_max     Maximum number of bytes to store in 'pdest' (see Note #2).
+*
+* Return(s)   : Number of characters converted (& of octets stored in 'pdest').
+*
+* Note(s)     : (1) Characters are converted in blocks of 'FS_UTIL_WORD_NBR_OCTETS' characters, each checked
+*                   before the next is read, so that no character past the terminating NULL character is
+*                   accessed.  The conversion stops at the first block holding a non-ASCII or NULL character;
+*                   remaining characters MUST then be converted by the caller.
+*
+*               (2) At least 'MB_MAX_LEN' bytes are left in the destination buffer after the conversion, so
+*                   that 'WC_StrToMB()' still stores the same number of characters as if all characters had
+*                   been converted by 'WC_CharToMB()' (see 'WC_StrToMB()  Note #2d').
+*
+*               (3) No terminating NULL character is stored.
+*********************************************************************************************************
+*/
+
+static  CPU_SIZE_T  WC_StrToMB_ASCII (CPU_CHAR    *pdest,
+                                      CPU_WCHAR   *psrc,
+                                      CPU_SIZE_T   len_max)
+{
+    CPU_SIZE_T   len_copy;
+    CPU_SIZE_T   ix;
+    CPU_WCHAR    src_char;
+
+
+    len_copy = 0u;
+    while ((len_max - len_copy) >= (FS_UTIL_WORD_NBR_OCTETS + MB_MAX_LEN)) {
+        for (ix = 0u; ix < FS_UTIL_WORD_NBR_OCTETS; ix++) {     /* Chk blk of chars (see Note #1).                      */
+            src_char = psrc[ix];
+            if ((src_char == (CPU_WCHAR)ASCII_CHAR_NULL) ||
+                (src_char >  (CPU_WCHAR)ASCII_CHAR_DELETE)) {
+                return (len_copy);
+            }
+        }
+        for (ix = 0u; ix < FS_UTIL_WORD_NBR_OCTETS; ix++) {
+            pdest[ix] = (CPU_CHAR)psrc[ix];
+        }
+        pdest    += FS_UTIL_WORD_NBR_OCTETS;
+        psrc     += FS_UTIL_WORD_NBR_OCTETS;
+        len_copy += FS_UTIL_WORD_NBR_OCTETS;
+    }
+
+    return (len_copy);
+}
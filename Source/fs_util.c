@@ -492,6 +492,46 @@ void  FSUtil_MapBitClr (CPU_INT08U  *p_bitmap,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSUtil_StrHash_N()
+*
+* Description : Calculate hash of a string, up to a maximum number of characters.
+*
+* Argument(s) : p_str       Pointer to string.
+*
+*               len_max     Maximum number of characters to hash.
+*
+* Return(s)   : Hash of string.
+*
+* Note(s)     : (1) The 32-bit FNV-1a hash is used.
+*
+*               (2) Strings that compare equal with 'Str_Cmp_N()' for 'len_max' characters have the same
+*                   hash, so the hash may be compared before the strings to reject non-matching names.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  FSUtil_StrHash_N (CPU_CHAR    *p_str,
+                              CPU_SIZE_T   len_max)
+{
+    CPU_INT32U  hash;
+    CPU_SIZE_T  len;
+
+
+    hash = 2166136261u;                                         /* FNV offset basis (see Note #1).                      */
+    len  = 0u;
+    while ((len    <  len_max) &&
+           (*p_str != (CPU_CHAR)ASCII_CHAR_NULL)) {
+        hash ^= (CPU_INT32U)(CPU_INT08U)*p_str;
+        hash *= 16777619u;                                      /* FNV prime.                                           */
+        p_str++;
+        len++;
+    }
+
+    return (hash);
+}
+
+
 /*
 *********************************************************************************************************
 *                                        FSUtil_ModuleDataGet()
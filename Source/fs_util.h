@@ -264,6 +264,91 @@
                                                                 } while (0)
 
 
+/*
+*********************************************************************************************************
+*                                   WORD-AT-A-TIME ASCII MACRO'S
+*
+* Note(s) : (1) These macros operate on several ASCII characters packed in a single CPU data word
+*               ('CPU_DATA'), one character per octet lane.  Name comparisons can thus be performed on
+*               4 (32-bit CPU) or 8 (64-bit CPU) characters at once, without any table look-up.
+*
+*           (2) The octet lane constants are computed from the size of 'CPU_DATA' :
+*
+*                   FS_UTIL_WORD_OCTETS_01 = 0x0101...01
+*                   FS_UTIL_WORD_OCTETS_80 = 0x8080...80
+*
+*           (3) Results are ONLY valid if every octet lane holds an ASCII character (i.e., is less than
+*               0x80).  See 'FS_UTIL_WORD_IS_ASCII()'.
+*********************************************************************************************************
+*/
+
+#define  FS_UTIL_WORD_NBR_OCTETS                    (sizeof(CPU_DATA))
+
+#define  FS_UTIL_WORD_OCTETS_01                     ((CPU_DATA)(~(CPU_DATA)0u) / (CPU_DATA)DEF_INT_08U_MAX_VAL)
+#define  FS_UTIL_WORD_OCTETS_80                     (FS_UTIL_WORD_OCTETS_01 * (CPU_DATA)0x80u)
+
+
+/*
+*********************************************************************************************************
+*                                       FS_UTIL_WORD_IS_ASCII()
+*
+* Description : Determine whether all octets of a word are ASCII characters.
+*
+* Argument(s) : word        Word of packed octets.
+*
+* Return(s)   : DEF_YES, if all octets are less than 0x80.
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#define  FS_UTIL_WORD_IS_ASCII(word)              ((((word) & FS_UTIL_WORD_OCTETS_80) == 0u) ? DEF_YES : DEF_NO)
+
+
+/*
+*********************************************************************************************************
+*                                       FS_UTIL_WORD_HAS_NULL()
+*
+* Description : Determine whether any octet of a word of ASCII characters is NULL.
+*
+* Argument(s) : word        Word of packed ASCII octets (see Note #1).
+*
+* Return(s)   : DEF_YES, if at least one octet is 0x00.
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) Only valid for words of ASCII octets (see 'WORD-AT-A-TIME ASCII MACRO'S  Note #3').
+*                   Subtracting 1 from each lane then borrows into bit 7 of a lane iff that lane is zero.
+*********************************************************************************************************
+*/
+
+#define  FS_UTIL_WORD_HAS_NULL(word)              (((((word) - FS_UTIL_WORD_OCTETS_01) & ~(word) & FS_UTIL_WORD_OCTETS_80) != 0u) ? DEF_YES : DEF_NO)
+
+
+/*
+*********************************************************************************************************
+*                                       FS_UTIL_WORD_TO_LOWER()
+*
+* Description : Convert all upper-case ASCII characters of a word to lower case.
+*
+* Argument(s) : word        Word of packed ASCII octets (see Note #1).
+*
+* Return(s)   : Word with each octet in the range 'A'-'Z' converted to 'a'-'z'.
+*
+* Note(s)     : (1) Only valid for words of ASCII octets (see 'WORD-AT-A-TIME ASCII MACRO'S  Note #3').
+*
+*               (2) Adding (0x80 - 'A') = 0x3F to a lane sets its bit 7 iff the lane is >= 'A'; adding
+*                   (0x7F - 'Z') = 0x25 sets its bit 7 iff the lane is > 'Z'.  No carry can propagate
+*                   between lanes since all lanes are less than 0x80.  Lanes in range 'A'-'Z' thus keep
+*                   bit 7 set in the mask, which is shifted down to bit 5 (0x20) & OR'd into the word.
+*********************************************************************************************************
+*/
+
+#define  FS_UTIL_WORD_TO_LOWER(word)                ((word) | ((((word) + (FS_UTIL_WORD_OCTETS_01 * (CPU_DATA)0x3Fu)) & \
+                                                               ~((word) + (FS_UTIL_WORD_OCTETS_01 * (CPU_DATA)0x25u)) & \
+                                                                 FS_UTIL_WORD_OCTETS_80) >> 2u))
+
+
 /*
 *********************************************************************************************************
 *                                         FUNCTION PROTOTYPES
@@ -292,6 +377,9 @@ void         FSUtil_MapBitSet         (CPU_INT08U  *p_bitmap,       /* Set speci
 void         FSUtil_MapBitClr         (CPU_INT08U  *p_bitmap,       /* Clr specified bit in bitmap.                     */
                                        CPU_SIZE_T   offset_bit);
 
+CPU_INT32U   FSUtil_StrHash_N         (CPU_CHAR    *p_str,          /* Calculate hash of str.                           */
+                                       CPU_SIZE_T   len_max);
+
 void        *FSUtil_ModuleDataGet     (CPU_SIZE_T    data_size,     /* Allocate module data.                            */
                                        void        **pp_data_head,
                                        FS_ERR       *p_err);
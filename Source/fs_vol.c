@@ -49,6 +49,7 @@
 #include  "fs_partition.h"
 #include  "fs_sys.h"
 #include  "fs_type.h"
+#include  "fs_util.h"
 #include  "fs_vol.h"
 
 
@@ -91,6 +92,7 @@ FS_STATIC  FS_VOL    **FSVol_Tbl;                               /* Tbl of vol.
 
 FS_STATIC  FS_QTY      FSVol_Cnt;                               /* Current number of open volumes.                      */
 FS_STATIC  FS_QTY      FSVol_VolCntMax;                         /* Maximum number of open volumes.                      */
+FS_STATIC  FS_CTR      FSVol_OpenSeq;                           /* Last vol open seq nbr.                               */
 
 
 /*
@@ -642,6 +644,81 @@ void  FSVol_Fmt (CPU_CHAR  *name_vol,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                          FSVol_HandleGet()
+*
+* Description : Get handle of a volume.
+*
+* Argument(s) : name_vol    Volume name.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE            Volume handle gotten.
+*                               FS_ERR_NAME_NULL       Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_VOL_NOT_OPEN    Volume is not open.
+*                               FS_ERR_OS_LOCK         OS Lock NOT acquired.
+*
+* Return(s)   : Handle of the volume, if NO errors.
+*               Invalid handle,       otherwise.
+*
+* Note(s)     : (1) The volume name is resolved once.  The returned handle may then be passed to the
+*                   '...ByHandle()' functions (e.g., 'FSFile_OpenByHandle()'), which get the volume from
+*                   its entry in the volume table instead of comparing its name with the name of every
+*                   open volume.
+*
+*               (2) Each volume object is stamped with a new open sequence number when it is allocated.
+*                   The handle holds both the volume ID & that sequence number, so that a handle to a
+*                   closed volume is rejected even if its volume table entry was reused since.  The open
+*                   sequence number 0 is never assigned, so the handle returned on error is never valid.
+*********************************************************************************************************
+*/
+
+FS_VOL_HANDLE  FSVol_HandleGet (CPU_CHAR  *name_vol,
+                                FS_ERR    *p_err)
+{
+    FS_VOL_HANDLE   vol_handle;
+    FS_VOL         *p_vol;
+
+
+    vol_handle.VolID      = 0u;                                 /* Invalid handle (see Note #2).                        */
+    vol_handle.VolOpenSeq = 0u;
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(vol_handle);
+    }
+    if (name_vol == (CPU_CHAR *)0) {                            /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return (vol_handle);
+    }
+#endif
+
+                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);
+    if (*p_err != FS_ERR_NONE) {
+       *p_err = FS_ERR_OS_LOCK;
+        return (vol_handle);
+    }
+
+                                                                /* --------------------- FIND VOL --------------------- */
+    p_vol = FSVol_ObjFind(name_vol, p_err);
+    if (p_vol == (FS_VOL *)0) {                                 /* Rtn err if vol not found.                            */
+        FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
+       *p_err = FS_ERR_VOL_NOT_OPEN;
+        return (vol_handle);
+    }
+
+    vol_handle.VolID      = p_vol->ID;
+    vol_handle.VolOpenSeq = p_vol->OpenSeq;
+
+                                                                /* ------------------ RELEASE FS LOCK ----------------- */
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
+
+   *p_err = FS_ERR_NONE;
+    return (vol_handle);
+}
+
 /*
 *********************************************************************************************************
 *                                          FSVol_IsMounted()
@@ -1012,7 +1089,7 @@ void  FSVol_Open (CPU_CHAR          *name_vol,
 
 
                                                                 /* ------------------ INIT VOL STRUCT ----------------- */
-    FS_OS_Lock(p_err);                                          /* Acquire FS lock.                                     */
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);                       /* Acquire FS lock.                                     */
     if (*p_err != FS_ERR_NONE) {
         FSDev_Release(p_dev);
         return;
@@ -1022,7 +1099,7 @@ void  FSVol_Open (CPU_CHAR          *name_vol,
                              p_dev,
                              partition_nbr);
     if (p_vol != (FS_VOL *)0) {
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
         FSDev_Release(p_dev);
        *p_err = FS_ERR_VOL_ALREADY_OPEN;
         return;
@@ -1030,7 +1107,7 @@ void  FSVol_Open (CPU_CHAR          *name_vol,
 
     p_vol = FSVol_ObjGet();                                     /* Alloc vol.                                           */
     if (p_vol == (FS_VOL *)0) {
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
         FSDev_Release(p_dev);
        *p_err = FS_ERR_VOL_NONE_AVAIL;
         return;
@@ -1042,8 +1119,9 @@ void  FSVol_Open (CPU_CHAR          *name_vol,
     p_vol->DevPtr       = p_dev;
     p_vol->RefCnt       = 1u;
     Str_Copy_N(p_vol->Name, name_vol_copy, FS_CFG_MAX_VOL_NAME_LEN);
+    p_vol->NameHash     = FSUtil_StrHash_N(p_vol->Name, FS_CFG_MAX_VOL_NAME_LEN);
 
-    FS_OS_Unlock();                                             /* Release FS lock.                                     */
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);                            /* Release FS lock.                                     */
 
 
 
@@ -1570,7 +1648,7 @@ FS_QTY  FSVol_GetVolCnt (void)
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, &err);
     if (err != FS_ERR_NONE) {
         return (0u);
     }
@@ -1583,7 +1661,7 @@ FS_QTY  FSVol_GetVolCnt (void)
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
 
     return (vol_cnt);
 }
@@ -1666,7 +1744,7 @@ void  FSVol_GetVolName (FS_QTY     vol_nbr,
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(p_err);
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);
     if (*p_err != FS_ERR_NONE) {
         return;
     }
@@ -1687,7 +1765,7 @@ void  FSVol_GetVolName (FS_QTY     vol_nbr,
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
 }
 
 
@@ -1738,7 +1816,7 @@ void  FSVol_GetDfltVolName (CPU_CHAR  *name_vol,
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(p_err);
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);
     if (*p_err != FS_ERR_NONE) {
         return;
     }
@@ -1756,7 +1834,7 @@ void  FSVol_GetDfltVolName (CPU_CHAR  *name_vol,
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
 }
 
 
@@ -1808,7 +1886,7 @@ CPU_BOOLEAN  FSVol_IsDflt (CPU_CHAR  *name_vol,
 
    *p_err = FS_ERR_NONE;
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(p_err);
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);
     if (*p_err != FS_ERR_NONE) {
         return (DEF_NO);
     }
@@ -1832,7 +1910,7 @@ CPU_BOOLEAN  FSVol_IsDflt (CPU_CHAR  *name_vol,
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
 
     return (dflt);
 }
@@ -1882,6 +1960,7 @@ void  FSVol_ModuleInit (FS_QTY   vol_cnt,
 
     FSVol_VolCntMax = 0u;
     FSVol_Cnt       = 0u;
+    FSVol_OpenSeq   = 0u;
 
 
                                                                 /* ------------------- INIT VOL POOL ------------------ */
@@ -2037,7 +2116,7 @@ FS_VOL  *FSVol_Acquire (CPU_CHAR  *name_vol,
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(p_err);
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);
     if (*p_err != FS_ERR_NONE) {
        *p_err = FS_ERR_OS_LOCK;
         return ((FS_VOL *)0);
@@ -2049,7 +2128,7 @@ FS_VOL  *FSVol_Acquire (CPU_CHAR  *name_vol,
     p_vol = FSVol_ObjFind(name_vol, p_err);                     /* Find vol.                                            */
 
     if (p_vol == (FS_VOL *)0) {                                 /* Rtn NULL if vol not found.                           */
-        FS_OS_Unlock();
+        FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
        *p_err = FS_ERR_VOL_NOT_MOUNTED;
         return ((FS_VOL *)0);
     }
@@ -2059,12 +2138,78 @@ FS_VOL  *FSVol_Acquire (CPU_CHAR  *name_vol,
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
 
     return (p_vol);
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FSVol_AcquireByHandle()
+*
+* Description : Acquire volume reference from a volume handle.
+*
+* Argument(s) : vol_handle  Handle of the volume (see 'FSVol_HandleGet()').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE               Volume reference acquired.
+*                               FS_ERR_VOL_NOT_OPEN       Volume is not open, or handle is invalid.
+*                               FS_ERR_OS_LOCK            OS Lock NOT acquired.
+*
+* Return(s)   : Pointer to a volume, if found.
+*               Pointer to NULL,     otherwise.
+*
+* Note(s)     : (1) The volume is looked up by its ID; it is found only if it is still the volume that was
+*                   open when the handle was gotten (see 'FSVol_HandleGet()  Note #2').
+*********************************************************************************************************
+*/
+
+FS_VOL  *FSVol_AcquireByHandle (FS_VOL_HANDLE   vol_handle,
+                                FS_ERR         *p_err)
+{
+    FS_VOL  *p_vol;
+
+
+                                                                /* ------------------ ACQUIRE FS LOCK ----------------- */
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, p_err);
+    if (*p_err != FS_ERR_NONE) {
+       *p_err = FS_ERR_OS_LOCK;
+        return ((FS_VOL *)0);
+    }
+
+
+
+                                                                /* --------------------- FIND VOL --------------------- */
+    p_vol = DEF_NULL;
+    if (vol_handle.VolID < FSVol_VolCntMax) {                   /* Find vol by ID (see Note #1).                        */
+        p_vol = FSVol_Tbl[vol_handle.VolID];
+        if (p_vol != DEF_NULL) {
+            if (p_vol->OpenSeq != vol_handle.VolOpenSeq) {      /* Rtn NULL if vol closed since handle was gotten.      */
+                p_vol = DEF_NULL;
+            }
+        }
+    }
+
+    if (p_vol == (FS_VOL *)0) {                                 /* Rtn NULL if vol not found.                           */
+        FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
+       *p_err = FS_ERR_VOL_NOT_OPEN;
+        return ((FS_VOL *)0);
+    }
+
+    p_vol->RefCnt++;
+
+
+
+                                                                /* ------------------ RELEASE FS LOCK ----------------- */
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
+
+   *p_err = FS_ERR_NONE;
+    return (p_vol);
+}
+
 /*
 *********************************************************************************************************
 *                                         FSVol_AcquireDflt()
@@ -2088,7 +2233,7 @@ FS_VOL  *FSVol_AcquireDflt (void)
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, &err);
     if (err != FS_ERR_NONE) {
         return ((FS_VOL *)0);
     }
@@ -2111,7 +2256,7 @@ FS_VOL  *FSVol_AcquireDflt (void)
 
 
                                                                 /* ------------------ RELEASE FS LOCK ----------------- */
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
 
     return (p_vol);
 }
@@ -2162,7 +2307,7 @@ void  FSVol_Release (FS_VOL  *p_vol)
 
 
                                                                 /* ------------------ ACQUIRE FS LOCK ----------------- */
-    FS_OS_Lock(&err);
+    FS_OS_Lock(FS_OS_LOCK_ID_VOL, &err);
     if (err != FS_ERR_NONE) {
         return;
     }
@@ -2180,7 +2325,7 @@ void  FSVol_Release (FS_VOL  *p_vol)
         FS_TRACE_DBG(("FSVol_Release(): Release cnt dec'd to zero.\r\n"));
     }
 
-    FS_OS_Unlock();
+    FS_OS_Unlock(FS_OS_LOCK_ID_VOL);
 
 
 
@@ -2253,6 +2398,78 @@ void  FSVol_Unlock (FS_VOL  *p_vol)
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSVol_LockShared()
+*
+* Description : Acquire volume lock in shared mode.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+* Return(s)   : DEF_YES, if volume lock     acquired.
+*               DEF_NO,  if volume lock NOT acquired.
+*
+* Note(s)     : (1) Any number of tasks may hold the volume lock in shared mode at once, but no task may
+*                   hold it exclusively (see 'FSVol_Lock()') meanwhile.  Holders of a shared lock MUST NOT
+*                   modify volume or file system state other than that of an object they have locked;
+*                   device accesses among them are serialized within 'FSVol_RdLocked()' &
+*                   'FSVol_RdLockedEx()'.
+*
+*               (2) The device access lock is only held while the shared lock is acquired, so that a task
+*                   waiting for an exclusive lock blocks new shared holders & is not starved.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+CPU_BOOLEAN  FSVol_LockShared (FS_VOL  *p_vol)
+{
+    FS_ERR  err;
+
+                                                                /* -------------- ACQUIRE DEV ACCESS LOCK ------------- */
+    FS_OS_DevAccessLock(p_vol->DevPtr->ID, 0u, &err);
+    if (err != FS_ERR_NONE) {
+        return (DEF_NO);
+    }
+
+                                                                /* ------------- ACQUIRE DEV SHARED LOCK -------------- */
+    FS_OS_DevSharedLock(p_vol->DevPtr->ID, &err);
+
+    FS_OS_DevAccessUnlock(p_vol->DevPtr->ID);                   /* See Note #2.                                         */
+
+    if (err != FS_ERR_NONE) {
+        return (DEF_NO);
+    }
+
+    return (DEF_YES);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FSVol_UnlockShared()
+*
+* Description : Release volume lock acquired in shared mode.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+void  FSVol_UnlockShared (FS_VOL  *p_vol)
+{
+                                                                /* ------------- RELEASE DEV SHARED LOCK -------------- */
+    FS_OS_DevSharedUnlock(p_vol->DevPtr->ID);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FSVol_OpenLocked()
@@ -2377,6 +2594,208 @@ static  void  FSVol_OpenLocked (FS_VOL  *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FSVol_AddrGetLocked()
+*
+* Description : Get memory address of a volume sector.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+*               start       Sector number.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Address obtained.
+*                               FS_ERR_VOL_INVALID_SEC_NBR    Sector number invalid.
+*
+*                                                             ---- RETURNED BY FSDev_AddrGetLocked() ----
+*                               FS_ERR_DEV_INVALID_IO_CTRL    Device data is NOT memory-mapped.
+*                               FS_ERR_DEV_INVALID_SEC_NBR    Sector number invalid.
+*
+* Return(s)   : Pointer to first octet of sector, if NO errors.
+*               Pointer to NULL,                  otherwise.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the volume & hold the device lock.
+*
+*               (2) The memory holds the data last written to the device; sectors held dirty in the
+*                   volume cache are NOT reflected until the cache is flushed.
+*********************************************************************************************************
+*/
+
+void  *FSVol_AddrGetLocked (FS_VOL      *p_vol,
+                            FS_SEC_NBR   start,
+                            FS_ERR      *p_err)
+{
+    void  *p_addr;
+
+
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+    if (start >= p_vol->PartitionSize) {                        /* Validate start.                                      */
+       *p_err = FS_ERR_VOL_INVALID_SEC_NBR;
+        return ((void *)0);
+    }
+
+    start += p_vol->PartitionStart;
+
+
+                                                                /* ------------------- GET DEV ADDR ------------------- */
+    p_addr = FSDev_AddrGetLocked(p_vol->DevPtr,
+                                 start,
+                                 p_err);
+
+    return (p_addr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FSVol_BarrierLocked()
+*
+* Description : Issue a write barrier on a volume, so that sectors written before the barrier reach the
+*               device medium before any sector written after it.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Barrier issued.
+*
+*                                                             ---- RETURNED BY FSDev_BarrierLocked() ----
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the volume & hold the device lock.
+*
+*               (2) Sectors held dirty in the volume cache were written before the barrier, so the cache
+*                   is flushed first.  Like any other volume write, the flush is preceded by the data the
+*                   file system driver holds (see 'FSVol_WrLockedEx()  Note #2').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSVol_BarrierLocked (FS_VOL  *p_vol,
+                           FS_ERR  *p_err)
+{
+                                                                /* -------------- CHECK VOLUME VALIDITY --------------- */
+    if (p_vol->RefreshCnt != p_vol->DevPtr->RefreshCnt) {       /* Volume is invalid following a device change...       */
+       *p_err = FS_ERR_DEV_CHNGD;                               /* cannot continue, return with error.                  */
+        return;
+    }
+
+#ifdef FS_CACHE_MODULE_PRESENT                                  /* -------------- FLUSH CACHE (see Note #2) ----------- */
+    if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {
+#ifdef FS_SYS_VOL_WR_PREP_PRESENT
+        FSSys_VolWrPrep(p_vol, DEF_NULL, 0u, 0u, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+#endif
+        p_vol->CacheAPI_Ptr->Flush(p_vol, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+    }
+#endif
+
+                                                                /* ------------------- ORDER DEV WRS ------------------ */
+    FSDev_BarrierLocked(p_vol->DevPtr, p_err);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FSVol_DiscardLocked()
+*
+* Description : Discard the data of volume sector(s), so that they read back as zeros.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+*               start       Start sector of discard.
+*
+*               cnt         Number of sectors to discard.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Sector(s) discarded.
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_VOL_INVALID_SEC_NBR    Sector start or count invalid.
+*
+*                                                             ---- RETURNED BY FSDev_DiscardLocked() ----
+*                               FS_ERR_DEV_INVALID_IO_CTRL    Discard not supported by device (see Note #2).
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the volume & hold the device lock.
+*
+*               (2) If the device cannot discard sectors, the caller should write zeros instead.
+*
+*               (3) Cached copies of the sectors are dropped, even if dirty, since their data is discarded.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSVol_DiscardLocked (FS_VOL      *p_vol,
+                           FS_SEC_NBR   start,
+                           FS_SEC_QTY   cnt,
+                           FS_ERR      *p_err)
+{
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+    if (start + cnt > p_vol->PartitionSize) {                   /* Validate start & cnt.                                */
+       *p_err = FS_ERR_VOL_INVALID_SEC_NBR;
+        return;
+    }
+
+                                                                /* -------------- CHECK VOLUME VALIDITY --------------- */
+    if (p_vol->RefreshCnt != p_vol->DevPtr->RefreshCnt) {       /* Volume is invalid following a device change...       */
+       *p_err = FS_ERR_DEV_CHNGD;                               /* cannot continue, return with error.                  */
+        return;
+    }
+
+#ifdef FS_SYS_VOL_WR_PREP_PRESENT                               /* ------------------- ORDER WR'S -------------------- */
+    FSSys_VolWrPrep(p_vol, DEF_NULL, start, cnt, p_err);        /* Prepare vol for wr.                                  */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+#endif
+
+#ifdef FS_CACHE_MODULE_PRESENT                                  /* ------------- DROP CACHED SECS (see Note #3) ------- */
+    if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {
+        p_vol->CacheAPI_Ptr->Release(p_vol,
+                                     start,
+                                     cnt,
+                                     p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+    }
+#endif
+
+                                                                /* ------------------- DISCARD SECS ------------------- */
+    start += p_vol->PartitionStart;
+    FSDev_DiscardLocked(p_vol->DevPtr,
+                        start,
+                        cnt,
+                        p_err);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                          FSVol_RdLocked()
@@ -2436,6 +2855,12 @@ void  FSVol_RdLocked (FS_VOL      *p_vol,
 
     start += p_vol->PartitionStart;
 
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)                  /* Serialize dev access among shared lock holders.      */
+    FS_OS_DevIO_Lock(p_dev->ID, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+#endif
 
                                                                 /* ---------------------- RD DEV ---------------------- */
     FSDev_RdLocked(p_dev,
@@ -2448,6 +2873,10 @@ void  FSVol_RdLocked (FS_VOL      *p_vol,
 
                                                                 /* ----------------- UPDATE VOL STATS ----------------- */
     FS_CTR_STAT_ADD(p_vol->StatRdSecCtr, (FS_CTR)cnt);
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+    FS_OS_DevIO_Unlock(p_dev->ID);
+#endif
 }
 
 
@@ -2515,6 +2944,14 @@ void  FSVol_RdLockedEx (FS_VOL      *p_vol,
     }
 
 
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)                  /* Serialize dev & cache access among shared holders.   */
+    FS_OS_DevIO_Lock(p_vol->DevPtr->ID, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+#endif
+
+
 #ifdef FS_CACHE_MODULE_PRESENT                                  /* ------------------ RD CACHED DATA ------------------ */
     if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {
         p_vol->CacheAPI_Ptr->Rd(p_vol,
@@ -2524,6 +2961,9 @@ void  FSVol_RdLockedEx (FS_VOL      *p_vol,
                                 sec_type,
                                 p_err);
         FS_CTR_STAT_ADD(p_vol->StatRdSecCtr, (FS_CTR)cnt);
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+        FS_OS_DevIO_Unlock(p_vol->DevPtr->ID);
+#endif
         return;
     }
 #endif
@@ -2542,6 +2982,10 @@ void  FSVol_RdLockedEx (FS_VOL      *p_vol,
 
                                                                 /* ----------------- UPDATE VOL STATS ----------------- */
     FS_CTR_STAT_ADD(p_vol->StatRdSecCtr, (FS_CTR)cnt);
+
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+    FS_OS_DevIO_Unlock(p_vol->DevPtr->ID);
+#endif
 }
 
 
@@ -2829,6 +3273,10 @@ void  FSVol_WrLocked (FS_VOL      *p_vol,
 * Return(s)   : none.
 *
 * Note(s)     : (1) The function caller MUST have acquired a reference to the volume & hold the device lock.
+*
+*               (2) The file system driver may hold data that MUST be written before any other sector of
+*                   the volume, or may need to mark the volume as in use before it is first modified (see
+*                   'fs_sys.c  FSSys_VolWrPrep()  Notes #1 & #2').
 *********************************************************************************************************
 */
 
@@ -2861,6 +3309,13 @@ void  FSVol_WrLockedEx (FS_VOL      *p_vol,
         return;
     }
 
+#ifdef FS_SYS_VOL_WR_PREP_PRESENT                               /* ------------------- ORDER WR'S -------------------- */
+    FSSys_VolWrPrep(p_vol, p_src, start, cnt, p_err);           /* Prepare vol for wr (see Note #2).                    */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+#endif
+
 
 #ifdef FS_CACHE_MODULE_PRESENT                                  /* ----------------- WR THROUGH CACHE ----------------- */
     if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {
@@ -3028,12 +3483,14 @@ void  FSVol_FileRemove (FS_VOL   *p_vol,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_VOL'.
 *********************************************************************************************************
 */
 
 static  void  FSVol_ObjClr (FS_VOL  *p_vol)
 {
+    p_vol->ID             =  0u;
+    p_vol->OpenSeq        =  0u;
     p_vol->State          =  FS_VOL_STATE_CLOSED;
     p_vol->RefCnt         =  0u;
     p_vol->RefreshCnt     =  0u;
@@ -3043,6 +3500,7 @@ static  void  FSVol_ObjClr (FS_VOL  *p_vol)
     Mem_Set((void       *)&p_vol->Name[0],
             (CPU_INT08U  ) ASCII_CHAR_NULL,
             (CPU_SIZE_T  )(FS_CFG_MAX_VOL_NAME_LEN + 1u));
+    p_vol->NameHash       =  0u;
 
     p_vol->PartitionNbr   =  0u;
     p_vol->PartitionStart =  0u;
@@ -3084,7 +3542,10 @@ static  void  FSVol_ObjClr (FS_VOL  *p_vol)
 * Return(s)   : Pointer to a volume, if found.
 *               Pointer to NULL,     otherwise.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_VOL'.
+*
+*               (2) The names of volumes whose name hash differs from the hash of 'name_vol' are not
+*                   compared (see 'FSUtil_StrHash_N()  Note #2').
 *********************************************************************************************************
 */
 
@@ -3093,18 +3554,22 @@ static  FS_VOL  *FSVol_ObjFind (CPU_CHAR  *name_vol,
 {
     FS_QTY       ix;
     CPU_INT16S   cmp;
+    CPU_INT32U   name_hash;
     FS_VOL      *p_vol;
 
 
     (void)p_err;
     p_vol      = DEF_NULL;
+    name_hash  = FSUtil_StrHash_N(name_vol, FS_CFG_MAX_VOL_NAME_LEN);
 
     for (ix = 0u; ix < FSVol_VolCntMax; ix++) {
         if (FSVol_Tbl[ix] != DEF_NULL) {
-            cmp = Str_Cmp_N(name_vol, FSVol_Tbl[ix]->Name, FS_CFG_MAX_VOL_NAME_LEN);
-            if (cmp == 0) {
-                p_vol = FSVol_Tbl[ix];
-                break;
+            if (FSVol_Tbl[ix]->NameHash == name_hash) {         /* Cmp names if hashes match (see Note #2).             */
+                cmp = Str_Cmp_N(name_vol, FSVol_Tbl[ix]->Name, FS_CFG_MAX_VOL_NAME_LEN);
+                if (cmp == 0) {
+                    p_vol = FSVol_Tbl[ix];
+                    break;
+                }
             }
         }
     }
@@ -3124,7 +3589,10 @@ static  FS_VOL  *FSVol_ObjFind (CPU_CHAR  *name_vol,
 * Return(s)   : Pointer to a volume, if found.
 *               Pointer to NULL,     otherwise.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_VOL'.
+*
+*               (2) The names of volumes whose name hash differs from the hash of 'name_vol' are not
+*                   compared (see 'FSUtil_StrHash_N()  Note #2').
 *********************************************************************************************************
 */
 
@@ -3134,14 +3602,19 @@ static  FS_VOL  *FSVol_ObjFindEx (CPU_CHAR          *name_vol,
 {
     FS_QTY       vol_ix;
     CPU_INT16S   cmp;
+    CPU_INT32U   name_hash;
     FS_VOL      *p_vol;
 
 
     p_vol      = DEF_NULL;
+    name_hash  = FSUtil_StrHash_N(name_vol, FS_CFG_MAX_VOL_NAME_LEN);
 
     for (vol_ix = 0u; vol_ix < FSVol_VolCntMax; vol_ix++) {
         if (FSVol_Tbl[vol_ix] != DEF_NULL) {
-            cmp = Str_Cmp_N(name_vol, FSVol_Tbl[vol_ix]->Name, FS_CFG_MAX_VOL_NAME_LEN);
+            cmp = 1;
+            if (FSVol_Tbl[vol_ix]->NameHash == name_hash) {     /* Cmp names if hashes match (see Note #2).             */
+                cmp = Str_Cmp_N(name_vol, FSVol_Tbl[vol_ix]->Name, FS_CFG_MAX_VOL_NAME_LEN);
+            }
             if ((cmp == 0)) {                                   /* Cmp names.                                           */
                 p_vol = FSVol_Tbl[vol_ix];
                 return (p_vol);
@@ -3171,7 +3644,7 @@ static  FS_VOL  *FSVol_ObjFindEx (CPU_CHAR          *name_vol,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_VOL'.
 *********************************************************************************************************
 */
 
@@ -3218,7 +3691,7 @@ static  void  FSVol_ObjFree (FS_VOL  *p_vol)
 * Return(s)   : Pointer to a volume, if NO errors.
 *               Pointer to NULL,     otherwise.
 *
-* Note(s)     : (1) The function caller MUST hold the file system lock.
+* Note(s)     : (1) The function caller MUST hold the file system lock 'FS_OS_LOCK_ID_VOL'.
 *********************************************************************************************************
 */
 
@@ -3255,6 +3728,14 @@ static  FS_VOL  *FSVol_ObjGet (void)
 
     FSVol_ObjClr(p_vol);
 
+    p_vol->ID = vol_ix;
+
+    FSVol_OpenSeq++;                                            /* Stamp vol with new open seq nbr ...                  */
+    if (FSVol_OpenSeq == 0u) {                                  /* ... never 0 (see 'FSVol_HandleGet()  Note #2').      */
+        FSVol_OpenSeq = 1u;
+    }
+    p_vol->OpenSeq = FSVol_OpenSeq;
+
 
     return (p_vol);
 }
@@ -133,12 +133,15 @@
 */
 
 struct  fs_vol {
+    FS_ID              ID;                                      /* Vol ID.                                              */
+    FS_CTR             OpenSeq;                                 /* Open seq nbr (see 'FSVol_HandleGet()  Note #2').     */
     FS_STATE           State;                                   /* State.                                               */
     FS_CTR             RefCnt;                                  /* Ref cnts.                                            */
     FS_CTR             RefreshCnt;                              /* Refresh cnts.                                        */
 
     FS_FLAGS           AccessMode;                              /* Access mode.                                         */
     CPU_CHAR           Name[FS_CFG_MAX_VOL_NAME_LEN + 1u];      /* Vol name.                                            */
+    CPU_INT32U         NameHash;                                /* Hash of vol name.                                    */
     FS_PARTITION_NBR   PartitionNbr;                            /* Partition nbr.                                       */
     FS_SEC_NBR         PartitionStart;                          /* Partition start sec.                                 */
     FS_SEC_QTY         PartitionSize;                           /* Partition size (in sec's).                           */
@@ -162,6 +165,20 @@ struct  fs_vol {
 };
 
 
+/*
+*********************************************************************************************************
+*                                       VOLUME HANDLE DATA TYPE
+*
+* Note(s) : (1) A volume handle is obtained with 'FSVol_HandleGet()' (see 'FSVol_HandleGet()  Note #1').
+*********************************************************************************************************
+*/
+
+struct  fs_vol_handle {
+    FS_ID              VolID;                                   /* Vol ID.                                              */
+    FS_CTR             VolOpenSeq;                              /* Vol open seq nbr.                                    */
+};
+
+
 /*
 *********************************************************************************************************
 *                                        VOLUME INFO DATA TYPE
@@ -220,6 +237,9 @@ void          FSVol_Fmt            (CPU_CHAR          *name_vol,    /* Format a
                                     FS_ERR            *p_err);
 #endif
 
+FS_VOL_HANDLE FSVol_HandleGet      (CPU_CHAR          *name_vol,    /* Get handle of a volume.                          */
+                                    FS_ERR            *p_err);
+
 CPU_BOOLEAN   FSVol_IsMounted      (CPU_CHAR          *name_vol);   /* Determine whether a volume is mounted.           */
 
 void          FSVol_LabelGet       (CPU_CHAR          *name_vol,    /* Get volume label.                                */
@@ -298,6 +318,9 @@ FS_VOL       *FSVol_AcquireLockChk (CPU_CHAR          *name_vol,    /* Acquire v
 FS_VOL       *FSVol_Acquire        (CPU_CHAR          *name_vol,    /* Acquire volume reference.                        */
                                     FS_ERR            *p_err);
 
+FS_VOL       *FSVol_AcquireByHandle(FS_VOL_HANDLE      vol_handle,  /* Acquire volume reference.                        */
+                                    FS_ERR            *p_err);
+
 FS_VOL       *FSVol_AcquireDflt    (void);                          /* Acquire default volume reference.                */
 
 void          FSVol_Release        (FS_VOL            *p_vol);      /* Release volume reference.                        */
@@ -308,6 +331,12 @@ CPU_BOOLEAN   FSVol_Lock           (FS_VOL            *p_vol);      /* Acquire v
 
 void          FSVol_Unlock         (FS_VOL            *p_vol);      /* Release volume lock.                             */
 
+#if (FS_CFG_VOL_LOCK_SHARED_EN == DEF_ENABLED)
+CPU_BOOLEAN   FSVol_LockShared     (FS_VOL            *p_vol);      /* Acquire volume lock in shared mode.              */
+
+void          FSVol_UnlockShared   (FS_VOL            *p_vol);      /* Release shared volume lock.                      */
+#endif
+
 
                                                                     /* ----------------- REGISTRATION ----------------- */
 #ifdef FS_DIR_MODULE_PRESENT
@@ -326,6 +355,20 @@ void          FSVol_FileRemove     (FS_VOL            *p_vol,        /* Remove f
 
 
                                                                     /* ----------------- LOCKED ACCESS ---------------- */
+void         *FSVol_AddrGetLocked  (FS_VOL            *p_vol,       /* Get mem addr of volume sector.                   */
+                                    FS_SEC_NBR         start,
+                                    FS_ERR            *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void          FSVol_BarrierLocked  (FS_VOL            *p_vol,       /* Order volume writes.                             */
+                                    FS_ERR            *p_err);
+
+void          FSVol_DiscardLocked  (FS_VOL            *p_vol,       /* Discard volume sector(s).                        */
+                                    FS_SEC_NBR         start,
+                                    FS_SEC_QTY         cnt,
+                                    FS_ERR            *p_err);
+#endif
+
 void          FSVol_RdLocked       (FS_VOL            *p_vol,       /* Read data from volume sector(s).                 */
                                     void              *p_dest,
                                     FS_SEC_NBR         start,